@@ -0,0 +1,401 @@
+#include <saucer/smartview.hpp>
+
+#include <print>
+#include <format>
+#include <thread>
+
+#include <span>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <string>
+#include <variant>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include <charconv>
+#include <algorithm>
+#include <filesystem>
+#include <unordered_map>
+
+#if defined(SAUCER_QT)
+static constexpr auto backend = "qt";
+#elif defined(SAUCER_WEBKITGTK)
+static constexpr auto backend = "webkitgtk";
+#elif defined(SAUCER_WEBVIEW2)
+static constexpr auto backend = "webview2";
+#elif defined(SAUCER_WEBKIT)
+static constexpr auto backend = "webkit";
+#else
+static constexpr auto backend = "unknown";
+#endif
+
+static constexpr std::size_t iterations  = 1000;
+static constexpr std::size_t concurrency = 1000;
+
+static constexpr std::size_t min_resource = 1024;
+static constexpr std::size_t max_resource = 64 * 1024 * 1024;
+static constexpr std::size_t chunk_size   = 64 * 1024;
+
+static constexpr auto page = R"html(<!DOCTYPE html><html><body></body></html>)html";
+
+struct percentiles
+{
+    double p50;
+    double p99;
+};
+
+static percentiles summarize(std::vector<double> samples)
+{
+    if (samples.empty())
+    {
+        return {};
+    }
+
+    std::ranges::sort(samples);
+
+    auto at = [&samples](double q)
+    {
+        return samples[static_cast<std::size_t>(q * static_cast<double>(samples.size() - 1))];
+    };
+
+    return {.p50 = at(0.5), .p99 = at(0.99)};
+}
+
+struct transfer
+{
+    double ttfb;
+    double total;
+};
+
+static std::span<const std::uint8_t> blob(std::size_t size)
+{
+    static const auto data = std::vector<std::uint8_t>(max_resource, 'x');
+    return std::span{data}.first(std::min(size, data.size()));
+}
+
+static std::size_t requested_size(const saucer::scheme::request &req)
+{
+    const auto name = req.url().path().filename().string();
+
+    std::size_t rtn{};
+    std::from_chars(name.data(), name.data() + name.size(), rtn);
+
+    return rtn;
+}
+
+static void handle_stream(const saucer::scheme::request &req, saucer::scheme::stream_writer writer)
+{
+    auto size = requested_size(req);
+
+    auto stream = [size, writer = std::move(writer)]() mutable
+    {
+        writer.start({.mime = "application/octet-stream", .headers = {{"Access-Control-Allow-Origin", "*"}}});
+
+        for (auto offset = 0uz; size > offset; offset += chunk_size)
+        {
+            const auto status = writer.write(saucer::stash::view(blob(size).subspan(offset).first(std::min(chunk_size, size - offset))));
+
+            if (status == saucer::scheme::write_status::closed)
+            {
+                return;
+            }
+
+            if (status == saucer::scheme::write_status::saturated)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        writer.finish();
+    };
+
+    std::thread{std::move(stream)}.detach();
+}
+
+static std::vector<double> call_latency(saucer::smartview &webview)
+{
+    static constexpr auto code = R"js(
+        (async () => {{
+            const samples = [];
+
+            for (let i = 0; i < {}; i++)
+            {{
+                const start = performance.now();
+                await saucer.exposed.noop();
+                samples.push(performance.now() - start);
+            }}
+
+            return samples;
+        }})()
+    )js";
+
+    return webview.evaluate<std::vector<double>>(code, iterations).get().value_or(std::vector<double>{});
+}
+
+static double call_throughput(saucer::smartview &webview)
+{
+    static constexpr auto code = R"js(
+        (async () => {{
+            const start = performance.now();
+            await Promise.all(Array.from({{ length: {} }}, () => saucer.exposed.noop()));
+            return performance.now() - start;
+        }})()
+    )js";
+
+    const auto elapsed = webview.evaluate<double>(code, concurrency).get().value_or(0);
+
+    if (elapsed <= 0)
+    {
+        return 0;
+    }
+
+    return static_cast<double>(concurrency) / (elapsed / 1000.0);
+}
+
+static std::vector<double> evaluate_latency(saucer::smartview &webview)
+{
+    std::vector<double> rtn;
+    rtn.reserve(iterations);
+
+    for (auto i = 0uz; iterations > i; i++)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        std::ignore      = webview.evaluate<int>("1").get();
+        const auto end   = std::chrono::steady_clock::now();
+
+        rtn.emplace_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    return rtn;
+}
+
+static double payload_latency(saucer::smartview &webview, std::size_t size)
+{
+    static constexpr auto code = R"js(
+        (async () => {{
+            const payload = "x".repeat({});
+            const start   = performance.now();
+
+            const result  = await saucer.exposed.echo(payload);
+            const elapsed = performance.now() - start;
+
+            return result.length === payload.length ? elapsed : -1;
+        }})()
+    )js";
+
+    const auto repetitions = size >= 1'000'000 ? 5uz : 25uz;
+
+    std::vector<double> samples;
+    samples.reserve(repetitions);
+
+    for (auto i = 0uz; repetitions > i; i++)
+    {
+        samples.emplace_back(webview.evaluate<double>(code, size).get().value_or(-1));
+    }
+
+    return summarize(std::move(samples)).p50;
+}
+
+static double serialize_latency()
+{
+    static constexpr auto repetitions = 100'000uz;
+
+    const auto text   = std::string(64, 'x');
+    const auto values = std::vector<int>(16, 1);
+
+    std::size_t written{0};
+    const auto start = std::chrono::steady_clock::now();
+
+    for (auto i = 0uz; repetitions > i; i++)
+    {
+        written += saucer::default_serializer::serialize(saucer::make_args(static_cast<int>(i), text, values)).size();
+    }
+
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    return written > 0 ? elapsed / static_cast<double>(repetitions) : 0;
+}
+
+template <typename T>
+static double dispatch_latency(T &&callable, std::string_view message)
+{
+    static constexpr auto repetitions = 100'000uz;
+
+    const auto serializer = saucer::default_serializer{};
+    auto converted        = saucer::default_serializer::convert(std::forward<T>(callable));
+
+    std::vector<std::unique_ptr<saucer::function_data>> messages;
+    messages.reserve(repetitions);
+
+    for (auto i = 0uz; repetitions > i; i++)
+    {
+        auto parsed = serializer.parse(message);
+        messages.emplace_back(std::move(std::get<std::unique_ptr<saucer::function_data>>(parsed)));
+    }
+
+    std::size_t settled{0};
+
+    auto settle = [&settled](std::string)
+    {
+        settled++;
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (auto &data : messages)
+    {
+        converted(std::move(data), {settle, settle});
+    }
+
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    return settled == repetitions ? elapsed / static_cast<double>(repetitions) : 0;
+}
+
+static transfer fetch_latency(saucer::smartview &webview, const std::string &url)
+{
+    static constexpr auto code = R"js(
+        (async () => {{
+            const start    = performance.now();
+            const response = await fetch({}, {{ cache: "no-store" }});
+            const reader   = response.body.getReader();
+
+            let first = -1;
+
+            while (true)
+            {{
+                const {{ done }} = await reader.read();
+
+                if (done)
+                {{
+                    break;
+                }}
+
+                if (first < 0)
+                {{
+                    first = performance.now() - start;
+                }}
+            }}
+
+            return [first, performance.now() - start];
+        }})()
+    )js";
+
+    std::vector<double> ttfb, total;
+
+    for (auto i = 0uz; 5 > i; i++)
+    {
+        const auto sample = webview.evaluate<std::array<double, 2>>(code, url).get().value_or(std::array<double, 2>{-1, -1});
+
+        ttfb.emplace_back(sample[0]);
+        total.emplace_back(sample[1]);
+    }
+
+    return {.ttfb = summarize(std::move(ttfb)).p50, .total = summarize(std::move(total)).p50};
+}
+
+static std::string schemes(saucer::smartview &webview)
+{
+    static constexpr auto sources = std::array{
+        std::pair{"embed", "/blob/{}"},
+        std::pair{"scheme", "bench://host/{}"},
+        std::pair{"stream", "stream://host/{}"},
+    };
+
+    std::string rtn;
+
+    for (const auto &[source, pattern] : sources)
+    {
+        for (auto size = min_resource; size <= max_resource; size *= 4)
+        {
+            const auto [ttfb, total] = fetch_latency(webview, std::vformat(pattern, std::make_format_args(size)));
+            const auto throughput    = total > 0 ? (static_cast<double>(size) / (1024.0 * 1024.0)) / (total / 1000.0) : 0;
+
+            rtn += std::format(R"({}{{"source":"{}","bytes":{},"ttfb_ms":{},"total_ms":{},"mb_per_s":{}}})", rtn.empty() ? "" : ",", source,
+                               size, ttfb, total, throughput);
+        }
+    }
+
+    return rtn;
+}
+
+static void run(saucer::application *app, saucer::smartview &webview)
+{
+    std::ignore = webview.evaluate<int>("1").get();
+
+    const auto calls      = summarize(call_latency(webview));
+    const auto throughput = call_throughput(webview);
+    const auto evaluation = summarize(evaluate_latency(webview));
+    const auto serialize  = serialize_latency();
+
+    const auto zero_args = dispatch_latency([] {}, R"({"saucer:call":true,"id":1,"name":"noop","params":[]})");
+    const auto five_args = dispatch_latency([](int, double, std::string, bool, std::vector<int>) {},
+                                            R"({"saucer:call":true,"id":1,"name":"five","params":[1,2.5,"text",true,[1,2,3]]})");
+
+    std::string payloads;
+
+    for (auto size = 10uz; size <= 10'000'000; size *= 10)
+    {
+        payloads += std::format(R"({}{{"bytes":{},"p50_ms":{}}})", payloads.empty() ? "" : ",", size, payload_latency(webview, size));
+    }
+
+    const auto resources = schemes(webview);
+
+    std::println(R"({{"backend":"{}","serializer":"{}","call":{{"p50_ms":{},"p99_ms":{},"per_second":{}}},)"
+                 R"("evaluate":{{"p50_ms":{},"p99_ms":{}}},"serialize":{{"ns_per_call":{}}},"dispatch":{{"zero_args_ns":{},"five_args_ns":{}}},)"
+                 R"("payload":[{}],"resources":[{}]}})",
+                 backend, SAUCER_BENCHMARK_SERIALIZER, calls.p50, calls.p99, throughput, evaluation.p50, evaluation.p99, serialize,
+                 zero_args, five_args, payloads, resources);
+
+    app->quit();
+}
+
+coco::stray start(saucer::application *app)
+{
+    auto window  = saucer::window::create(app).value();
+    auto webview = saucer::smartview::create({.window = window}).value();
+
+    webview.expose("noop", [] {});
+    webview.expose("echo", [](std::string value) { return value; });
+
+    auto embedded = std::unordered_map<std::filesystem::path, saucer::embedded_file>{
+        {"index.html", {.content = saucer::stash::view_str(page), .mime = "text/html"}},
+    };
+
+    for (auto size = min_resource; size <= max_resource; size *= 4)
+    {
+        auto file = saucer::embedded_file{.content = saucer::stash::view(blob(size)), .mime = "application/octet-stream"};
+        embedded.emplace(std::format("blob/{}", size), std::move(file));
+    }
+
+    auto handle_scheme = [](const saucer::scheme::request &req)
+    {
+        return saucer::scheme::response{
+            .data    = saucer::stash::view(blob(requested_size(req))),
+            .mime    = "application/octet-stream",
+            .headers = {{"Access-Control-Allow-Origin", "*"}},
+        };
+    };
+
+    webview.handle_scheme("bench", handle_scheme);
+    webview.handle_stream_scheme("stream", handle_stream);
+
+    webview.embed(std::move(embedded));
+    webview.serve("index.html");
+
+    window->show();
+
+    auto runner = std::jthread{[app, &webview] { run(app, webview); }};
+
+    co_await app->finish();
+}
+
+int main()
+{
+    saucer::webview::register_scheme("bench");
+    saucer::webview::register_scheme("stream");
+
+    return saucer::application::create({.id = "benchmarks"})->run(start);
+}
@@ -0,0 +1,83 @@
+#include <saucer/smartview.hpp>
+
+#include <print>
+#include <format>
+
+#include <chrono>
+#include <vector>
+#include <string>
+#include <variant>
+#include <iterator>
+#include <cstddef>
+#include <algorithm>
+#include <string_view>
+
+static constexpr std::size_t iterations = 100000;
+static constexpr std::size_t passes     = 10;
+
+struct sample
+{
+    std::string_view kind;
+    std::string message;
+};
+
+// The messages are JSON, as sent by the bridge, so only the JSON serializers are meaningfully measured
+static std::vector<sample> samples()
+{
+    std::string items;
+
+    for (auto i = 0; 16 > i; i++)
+    {
+        std::format_to(std::back_inserter(items), R"({}{{"id":{},"name":"item-{}","values":[{},{},{}]}})", i ? "," : "", i, i, i, i / 2.0,
+                       i * 2);
+    }
+
+    return {
+        {"call", R"({"saucer:call":true,"id":1,"name":"noop","params":[]})"},
+        {"call_large", std::format(R"({{"saucer:call":true,"id":2,"name":"items","params":[[{}]]}})", items)},
+        {"resolve", R"({"saucer:resolve":true,"id":3,"exception":false,"result":"Hello World"})"},
+        {"resolve_large", std::format(R"({{"saucer:resolve":true,"id":4,"exception":false,"result":[{}]}})", items)},
+        {"foreign", R"("dom_loaded")"},
+        {"internal", R"({"saucer:surfaces":true,"entries":[{"name":"video","bounds":[0,0,640,480]}]})"},
+    };
+}
+
+int main()
+{
+    const auto serializer = saucer::default_serializer{};
+
+    std::println(R"({{"serializer":"{}","iterations":{},"results":[)", SAUCER_BENCHMARK_SERIALIZER, iterations);
+
+    const auto messages = samples();
+
+    for (auto it = messages.begin(); it != messages.end(); ++it)
+    {
+        std::vector<double> timings;
+        auto parsed = false;
+
+        for (auto pass = 0uz; passes > pass; pass++)
+        {
+            const auto start = std::chrono::steady_clock::now();
+
+            for (auto i = 0uz; iterations > i; i++)
+            {
+                auto result = serializer.parse(it->message);
+                parsed      = !std::holds_alternative<std::monostate>(result);
+            }
+
+            const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+            timings.emplace_back(elapsed.count() / static_cast<double>(iterations));
+        }
+
+        std::ranges::sort(timings);
+
+        const auto *separator = std::next(it) == messages.end() ? "" : ",";
+
+        std::println(R"(  {{"kind":"{}","bytes":{},"parsed":{},"min_ns":{:.1f},"median_ns":{:.1f}}}{})", it->kind, it->message.size(),
+                     parsed, timings.front(), timings[timings.size() / 2], separator);
+    }
+
+    std::println("]}}");
+
+    return 0;
+}
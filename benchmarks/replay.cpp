@@ -0,0 +1,160 @@
+#include <saucer/replay.hpp>
+#include <saucer/smartview.hpp>
+
+#include <print>
+#include <format>
+#include <thread>
+
+#include <span>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <numeric>
+#include <cstddef>
+#include <charconv>
+#include <algorithm>
+#include <filesystem>
+#include <string_view>
+
+static constexpr std::size_t iterations = 2000;
+static constexpr auto page              = R"html(<!DOCTYPE html><html><body></body></html>)html";
+
+struct item
+{
+    int id;
+    std::string name;
+    std::vector<double> values;
+};
+
+// Both the live webview and the replay expose the same handlers, so recordings taken with one can be fed to the other
+template <typename T>
+static void expose(T &target)
+{
+    target.expose("noop", [] {});
+    target.expose("echo", [](std::string value) { return value; });
+    target.expose("sum", [](const std::vector<int> &values) { return std::accumulate(values.begin(), values.end(), 0ll); });
+    target.expose("items", [](std::vector<item> items) { return items.size(); });
+}
+
+static void record(saucer::application *app, saucer::smartview &webview)
+{
+    static constexpr auto code = R"js(
+        (async () => {{
+            const items = Array.from({{ length: 16 }}, (_, id) => ({{ id, name: `item-${{id}}`, values: [id, id / 2, id * 2] }}));
+
+            for (let i = 0; i < {}; i++)
+            {{
+                await Promise.all([
+                    saucer.exposed.noop(),
+                    saucer.exposed.echo("x".repeat(i % 512)),
+                    saucer.exposed.sum(Array.from({{ length: i % 64 }}, (_, j) => j)),
+                    saucer.exposed.items(items.slice(0, i % 16)),
+                ]);
+            }}
+
+            return true;
+        }})()
+    )js";
+
+    std::ignore = webview.evaluate<int>("1").get();
+    std::ignore = webview.evaluate<bool>(code, iterations).get();
+
+    webview.set_ipc_recorder({});
+    app->quit();
+}
+
+static int capture(const std::filesystem::path &path)
+{
+    auto recorder = saucer::recording::writer(path);
+
+    if (!recorder.has_value())
+    {
+        std::println(stderr, "Failed to open {}: {}", path.string(), recorder.error().message());
+        return 1;
+    }
+
+    auto start = [recorder = std::move(*recorder)](saucer::application *app) -> coco::stray
+    {
+        auto window  = saucer::window::create(app).value();
+        auto webview = saucer::smartview::create({.window = window}).value();
+
+        expose(webview);
+
+        webview.set_ipc_recorder(recorder);
+        webview.embed({{"index.html", {.content = saucer::stash::view_str(page), .mime = "text/html"}}});
+        webview.serve("index.html");
+
+        auto runner = std::jthread{[app, &webview] { record(app, webview); }};
+        co_await app->finish();
+    };
+
+    return saucer::application::create({.id = "benchmarks-replay"})->run(start);
+}
+
+static int replay(const std::filesystem::path &path, std::size_t passes)
+{
+    auto records = saucer::recording::read(path);
+
+    if (!records.has_value())
+    {
+        std::println(stderr, "Failed to read {}: {}", path.string(), records.error().message());
+        return 1;
+    }
+
+    auto harness = saucer::replay{};
+    expose(harness);
+
+    auto as_ms = [](auto duration)
+    {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    };
+
+    std::vector<double> parse;
+    std::vector<double> handler;
+
+    auto stats = saucer::replay_stats{};
+
+    for (auto i = 0uz; passes > i; i++)
+    {
+        stats = harness.run(*records);
+
+        parse.emplace_back(as_ms(stats.parse));
+        handler.emplace_back(as_ms(stats.handler));
+    }
+
+    std::ranges::sort(parse);
+    std::ranges::sort(handler);
+
+    std::println(R"({{"serializer":"{}","records":{},"calls":{},"skipped":{},"resolved":{},"rejected":{},)"
+                 R"("parse":{{"min_ms":{},"median_ms":{}}},"handler":{{"min_ms":{},"median_ms":{}}}}})",
+                 SAUCER_BENCHMARK_SERIALIZER, records->size(), stats.calls, stats.skipped, stats.resolved, stats.rejected, parse.front(),
+                 parse[parse.size() / 2], handler.front(), handler[handler.size() / 2]);
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    const auto args = std::span{argv, static_cast<std::size_t>(argc)}.subspan(1);
+
+    if (args.size() == 2 && std::string_view{args[0]} == "--record")
+    {
+        return capture(args[1]);
+    }
+
+    if (args.empty() || args.size() > 2)
+    {
+        std::println(stderr, "Usage: {0} --record <file> | {0} <file> [passes]", argv[0]);
+        return 1;
+    }
+
+    auto passes = 10uz;
+
+    if (args.size() == 2)
+    {
+        const auto value = std::string_view{args[1]};
+        std::from_chars(value.data(), value.data() + value.size(), passes);
+    }
+
+    return replay(args[0], std::max(passes, 1uz));
+}
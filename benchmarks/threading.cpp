@@ -0,0 +1,153 @@
+#include <saucer/app.hpp>
+
+#include <new>
+#include <print>
+#include <format>
+#include <thread>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstddef>
+#include <utility>
+
+#if defined(SAUCER_QT)
+static constexpr auto backend = "qt";
+#elif defined(SAUCER_WEBKITGTK)
+static constexpr auto backend = "gtk";
+#elif defined(SAUCER_WEBVIEW2)
+static constexpr auto backend = "win32";
+#elif defined(SAUCER_WEBKIT)
+static constexpr auto backend = "cocoa";
+#else
+static constexpr auto backend = "unknown";
+#endif
+
+static constexpr std::size_t iterations = 100'000;
+
+static std::atomic_size_t allocations{0};
+
+void *operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (auto *rtn = std::malloc(size == 0 ? 1 : size); rtn)
+    {
+        return rtn;
+    }
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+struct sample
+{
+    double ns_per_call;
+    double allocs_per_call;
+};
+
+template <typename T>
+static sample measure(std::size_t count, T &&body)
+{
+    const auto before = allocations.load(std::memory_order_relaxed);
+    const auto start  = std::chrono::steady_clock::now();
+
+    std::forward<T>(body)();
+
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    const auto allocs  = allocations.load(std::memory_order_relaxed) - before;
+
+    return {
+        .ns_per_call     = elapsed / static_cast<double>(count),
+        .allocs_per_call = static_cast<double>(allocs) / static_cast<double>(count),
+    };
+}
+
+static sample same_thread(saucer::application *app)
+{
+    auto body = [app]
+    {
+        return measure(iterations,
+                       [app]
+                       {
+                           for (auto i = 0uz; iterations > i; i++)
+                           {
+                               std::ignore = app->invoke([](std::size_t value) { return value; }, i);
+                           }
+                       });
+    };
+
+    return app->invoke(body);
+}
+
+static sample cross_thread(saucer::application *app)
+{
+    return measure(iterations,
+                   [app]
+                   {
+                       for (auto i = 0uz; iterations > i; i++)
+                       {
+                           std::ignore = app->invoke([](std::size_t value) { return value; }, i);
+                       }
+                   });
+}
+
+template <typename T>
+static sample throughput(saucer::application *app, T &&submit)
+{
+    std::atomic_size_t executed{0};
+
+    return measure(iterations,
+                   [&]
+                   {
+                       for (auto i = 0uz; iterations > i; i++)
+                       {
+                           submit(app, [&executed] { executed.fetch_add(1, std::memory_order_release); });
+                       }
+
+                       while (executed.load(std::memory_order_acquire) < iterations)
+                       {
+                           std::this_thread::yield();
+                       }
+                   });
+}
+
+static void run(saucer::application *app)
+{
+    const auto same  = same_thread(app);
+    const auto cross = cross_thread(app);
+
+    const auto post     = throughput(app, [](auto *target, auto callback) { target->post(std::move(callback)); });
+    const auto dispatch = throughput(app, [](auto *target, auto callback) { target->dispatch(std::move(callback)); });
+
+    auto format = [](const sample &value)
+    {
+        return std::format(R"({{"ns_per_call":{},"allocs_per_call":{},"per_second":{}}})", value.ns_per_call, value.allocs_per_call,
+                           value.ns_per_call > 0 ? 1e9 / value.ns_per_call : 0);
+    };
+
+    std::println(R"({{"backend":"{}","invoke":{{"same_thread":{},"cross_thread":{}}},"post":{},"dispatch":{}}})", backend, format(same),
+                 format(cross), format(post), format(dispatch));
+
+    app->quit();
+}
+
+coco::stray start(saucer::application *app)
+{
+    auto runner = std::jthread{[app] { run(app); }};
+    co_await app->finish();
+}
+
+int main()
+{
+    return saucer::application::create({.id = "benchmarks-threading"})->run(start);
+}
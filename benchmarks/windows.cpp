@@ -0,0 +1,423 @@
+#include <saucer/smartview.hpp>
+#include <saucer/asset_store.hpp>
+#include <saucer/webview_pool.hpp>
+
+#include <print>
+#include <format>
+#include <thread>
+
+#include <span>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <optional>
+#include <algorithm>
+#include <filesystem>
+#include <string_view>
+#include <unordered_map>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#else
+#include <fstream>
+#include <unistd.h>
+#endif
+
+#if defined(SAUCER_QT)
+static constexpr auto backend = "qt";
+#elif defined(SAUCER_WEBKITGTK)
+static constexpr auto backend = "webkitgtk";
+#elif defined(SAUCER_WEBVIEW2)
+static constexpr auto backend = "webview2";
+#elif defined(SAUCER_WEBKIT)
+static constexpr auto backend = "webkit";
+#else
+static constexpr auto backend = "unknown";
+#endif
+
+static constexpr std::size_t max_windows = 32;
+static constexpr std::size_t iterations  = 200;
+
+static constexpr auto settle = std::chrono::seconds(2);
+static constexpr auto page   = R"html(<!DOCTYPE html><html><body></body></html>)html";
+
+struct config
+{
+    bool session{false};
+    bool store{false};
+    bool prewarm{false};
+    bool pool{false};
+    bool async{false};
+};
+
+struct percentiles
+{
+    double p50;
+    double p99;
+};
+
+struct instance
+{
+    std::shared_ptr<saucer::window> window;
+    std::unique_ptr<saucer::smartview> webview;
+};
+
+static percentiles summarize(std::vector<double> samples)
+{
+    if (samples.empty())
+    {
+        return {};
+    }
+
+    std::ranges::sort(samples);
+
+    auto at = [&samples](double q)
+    {
+        return samples[static_cast<std::size_t>(q * static_cast<double>(samples.size() - 1))];
+    };
+
+    return {.p50 = at(0.5), .p99 = at(0.99)};
+}
+
+static double since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static std::size_t host_memory()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters{};
+
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return 0;
+    }
+
+    return counters.WorkingSetSize;
+#elif defined(__APPLE__)
+    mach_task_basic_info_data_t info{};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+    {
+        return 0;
+    }
+
+    return info.resident_size;
+#else
+    std::size_t pages{}, resident{};
+
+    if (!(std::ifstream{"/proc/self/statm"} >> pages >> resident))
+    {
+        return 0;
+    }
+
+    return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+class bench
+{
+    saucer::application *m_app;
+    config m_config;
+
+  private:
+    saucer::asset_store m_store;
+    std::optional<saucer::basic_webview_pool<saucer::smartview>> m_pool;
+
+  public:
+    bench(saucer::application *app, config cfg) : m_app(app), m_config(cfg)
+    {
+        m_store.embed({{"index.html", {.content = saucer::stash::view_str(page), .mime = "text/html"}}});
+
+        if (!m_config.pool)
+        {
+            return;
+        }
+
+        m_pool.emplace(app, max_windows, [this](std::shared_ptr<saucer::window> window) { return options(std::move(window)); });
+        m_app->invoke([this] { m_pool->fill(); });
+    }
+
+  private:
+    [[nodiscard]] saucer::webview::options options(std::shared_ptr<saucer::window> window) const
+    {
+        auto rtn = saucer::webview::options{.window = std::move(window)};
+
+        if (m_config.session)
+        {
+            rtn.session = "bench";
+        }
+
+        return rtn;
+    }
+
+    void prepare(saucer::smartview &webview) const
+    {
+        webview.expose("noop", [] {});
+
+        if (m_config.store)
+        {
+            webview.mount(m_store);
+        }
+        else
+        {
+            webview.embed({{"index.html", {.content = saucer::stash::view_str(page), .mime = "text/html"}}});
+        }
+
+        webview.serve("index.html");
+    }
+
+  private:
+    std::optional<instance> acquire()
+    {
+        auto entry = m_app->invoke([this] { return m_pool->acquire(); });
+
+        if (!entry.has_value())
+        {
+            return std::nullopt;
+        }
+
+        return instance{std::move(entry->window), std::make_unique<saucer::smartview>(std::move(entry->webview))};
+    }
+
+    std::optional<instance> create()
+    {
+        if (m_pool.has_value())
+        {
+            return acquire();
+        }
+
+        auto window = saucer::window::create(m_app);
+
+        if (!window.has_value())
+        {
+            return std::nullopt;
+        }
+
+        auto webview = saucer::smartview::create(options(*window));
+
+        if (!webview.has_value())
+        {
+            return std::nullopt;
+        }
+
+        return instance{std::move(*window), std::make_unique<saucer::smartview>(std::move(*webview))};
+    }
+
+    // All creations are started at once, the UI thread interleaves them
+    std::vector<std::optional<instance>> create_async(std::size_t count, std::vector<double> &timings)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector<coco::future<saucer::result<std::shared_ptr<saucer::window>>>> windows;
+
+        for (auto i = 0uz; count > i; i++)
+        {
+            windows.emplace_back(saucer::window::create_async(m_app));
+        }
+
+        std::vector<std::shared_ptr<saucer::window>> created;
+        std::vector<coco::future<saucer::result<saucer::smartview>>> webviews;
+
+        for (auto &future : windows)
+        {
+            auto window = future.get();
+
+            if (!window.has_value())
+            {
+                continue;
+            }
+
+            created.emplace_back(*window);
+            webviews.emplace_back(saucer::smartview::create_async(options(*window)));
+        }
+
+        std::vector<std::optional<instance>> rtn;
+
+        for (auto i = 0uz; webviews.size() > i; i++)
+        {
+            auto webview = webviews[i].get();
+
+            if (!webview.has_value())
+            {
+                rtn.emplace_back(std::nullopt);
+                continue;
+            }
+
+            timings.emplace_back(since(start));
+            rtn.emplace_back(instance{std::move(created[i]), std::make_unique<saucer::smartview>(std::move(*webview))});
+        }
+
+        return rtn;
+    }
+
+  private:
+    static std::vector<double> call_latency(std::vector<instance> &instances)
+    {
+        static constexpr auto code = R"js(
+            (async () => {{
+                const samples = [];
+
+                for (let i = 0; i < {}; i++)
+                {{
+                    const start = performance.now();
+                    await saucer.exposed.noop();
+                    samples.push(performance.now() - start);
+                }}
+
+                return samples;
+            }})()
+        )js";
+
+        using future = decltype(std::declval<saucer::smartview &>().evaluate<std::vector<double>>(code, iterations));
+
+        std::vector<future> pending;
+
+        for (auto &[window, webview] : instances)
+        {
+            pending.emplace_back(webview->evaluate<std::vector<double>>(code, iterations));
+        }
+
+        std::vector<double> rtn;
+
+        for (auto &future : pending)
+        {
+            auto samples = future.get().value_or(std::vector<double>{});
+            rtn.insert(rtn.end(), samples.begin(), samples.end());
+        }
+
+        return rtn;
+    }
+
+    static std::size_t engine_memory(std::vector<instance> &instances)
+    {
+        // Engines report the process tree backing a webview, which windows sharing an environment (or session) share as well
+        std::size_t rtn{0};
+
+        for (auto &[window, webview] : instances)
+        {
+            rtn = std::max(rtn, webview->memory_stats().get().engine.value_or(0));
+        }
+
+        return rtn;
+    }
+
+  public:
+    std::string step(std::size_t count)
+    {
+        std::vector<double> creation;
+        std::vector<instance> instances;
+
+        std::vector<std::optional<instance>> created;
+
+        if (m_config.async && !m_pool.has_value())
+        {
+            created = create_async(count, creation);
+        }
+        else
+        {
+            for (auto i = 0uz; count > i; i++)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                created.emplace_back(create());
+                creation.emplace_back(since(start));
+            }
+        }
+
+        for (auto &entry : created)
+        {
+            if (!entry.has_value())
+            {
+                continue;
+            }
+
+            prepare(*entry->webview);
+            entry->window->show();
+
+            instances.emplace_back(std::move(*entry));
+        }
+
+        for (auto &[window, webview] : instances)
+        {
+            std::ignore = webview->evaluate<int>("1").get();
+        }
+
+        std::this_thread::sleep_for(settle);
+
+        const auto host   = host_memory();
+        const auto engine = engine_memory(instances);
+        const auto calls  = summarize(call_latency(instances));
+        const auto create = summarize(creation);
+
+        auto rtn = std::format(R"({{"windows":{},"created":{},"create":{{"p50_ms":{},"p99_ms":{}}},"host_bytes":{},"engine_bytes":{},)"
+                               R"("call":{{"p50_ms":{},"p99_ms":{}}}}})",
+                               count, instances.size(), create.p50, create.p99, host, engine, calls.p50, calls.p99);
+
+        for (auto &[window, webview] : instances)
+        {
+            webview->destroy().get();
+            window->destroy().get();
+        }
+
+        if (m_pool.has_value())
+        {
+            m_app->invoke([this] { m_pool->fill(); });
+        }
+
+        return rtn;
+    }
+};
+
+static void run(saucer::application *app, config cfg)
+{
+    auto runner = bench{app, cfg};
+    std::string steps;
+
+    for (auto count = 1uz; count <= max_windows; count *= 2)
+    {
+        steps += std::format("{}{}", steps.empty() ? "" : ",", runner.step(count));
+    }
+
+    std::println(R"({{"backend":"{}","session":{},"store":{},"prewarm":{},"pool":{},"async":{},"steps":[{}]}})", backend, cfg.session,
+                 cfg.store, cfg.prewarm, cfg.pool, cfg.async, steps);
+
+    app->quit();
+}
+
+int main(int argc, char **argv)
+{
+    auto cfg = config{};
+
+    for (const auto arg : std::span{argv, static_cast<std::size_t>(argc)}.subspan(1))
+    {
+        const auto flag = std::string_view{arg};
+
+        cfg.session |= flag == "--session";
+        cfg.store |= flag == "--store";
+        cfg.prewarm |= flag == "--prewarm";
+        cfg.pool |= flag == "--pool";
+        cfg.async |= flag == "--async";
+    }
+
+    auto start = [cfg](saucer::application *app) -> coco::stray
+    {
+        auto runner = std::jthread{[app, cfg] { run(app, cfg); }};
+        co_await app->finish();
+    };
+
+    return saucer::application::create({
+                                           .id                         = "benchmarks-windows",
+                                           .quit_on_last_window_closed = false,
+                                           .prewarm_engine             = cfg.prewarm,
+                                       })
+        ->run(start);
+}
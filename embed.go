@@ -10,6 +10,7 @@ import "embed"
 //go:embed cmake/toolchain/*.hpp
 //go:embed include/saucer/*.hpp
 //go:embed include/saucer/*.inl
+//go:embed include/saucer/*.h
 //go:embed include/saucer/error/*.hpp
 //go:embed include/saucer/error/*.inl
 //go:embed include/saucer/modules/*.hpp
@@ -18,8 +19,12 @@ import "embed"
 //go:embed include/saucer/serializers/*.inl
 //go:embed include/saucer/serializers/format/*.hpp
 //go:embed include/saucer/serializers/format/*.inl
+//go:embed include/saucer/serializers/beve/*.hpp
+//go:embed include/saucer/serializers/beve/*.inl
 //go:embed include/saucer/serializers/glaze/*.hpp
 //go:embed include/saucer/serializers/glaze/*.inl
+//go:embed include/saucer/serializers/ondemand/*.hpp
+//go:embed include/saucer/serializers/ondemand/*.inl
 //go:embed include/saucer/serializers/rflpp/*.hpp
 //go:embed include/saucer/serializers/rflpp/*.inl
 //go:embed include/saucer/stash/*.hpp
@@ -0,0 +1,126 @@
+#include <saucer/smartview.hpp>
+#include <saucer/modules/pdf.hpp>
+
+#include <print>
+#include <format>
+#include <thread>
+
+#include <deque>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <optional>
+#include <filesystem>
+
+static constexpr auto jobs = 1000uz;
+
+static constexpr auto invoice = R"html(
+<!DOCTYPE html>
+<html>
+    <body>
+        <h1>Invoice #{0}</h1>
+        <p>This invoice was rendered by one of {1} pooled webviews.</p>
+    </body>
+</html>
+)html";
+
+namespace fs = std::filesystem;
+
+struct job
+{
+    std::string html;
+    fs::path output;
+};
+
+struct worker
+{
+    std::shared_ptr<saucer::window> window;
+    std::unique_ptr<saucer::smartview> webview;
+    std::unique_ptr<saucer::modules::pdf> pdf;
+
+  public:
+    std::optional<job> current;
+};
+
+coco::stray start(saucer::application *app)
+{
+    const auto count  = std::max(1u, std::thread::hardware_concurrency());
+    const auto output = fs::temp_directory_path() / "saucer-farm";
+
+    fs::create_directories(output);
+
+    std::deque<job> queue;
+
+    for (auto i = 0uz; jobs > i; i++)
+    {
+        queue.emplace_back(std::format(invoice, i, count), output / std::format("invoice-{}.pdf", i));
+    }
+
+    std::vector<std::unique_ptr<worker>> workers;
+
+    auto done        = 0uz;
+    const auto begin = std::chrono::steady_clock::now();
+
+    auto next = [&](worker &worker)
+    {
+        worker.current.reset();
+
+        if (!queue.empty())
+        {
+            worker.current.emplace(std::move(queue.front()));
+            queue.pop_front();
+
+            worker.webview->set_html(worker.current->html);
+
+            return;
+        }
+
+        if (done < jobs)
+        {
+            return;
+        }
+
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        std::println("rendered {} documents with {} webviews in {:.2f}s ({:.1f} per second)", done, count, elapsed, done / elapsed);
+
+        app->quit();
+    };
+
+    for (auto i = 0u; count > i; i++)
+    {
+        auto &worker = *workers.emplace_back(std::make_unique<struct worker>());
+
+        worker.window  = saucer::window::create(app).value();
+        worker.webview = std::make_unique<saucer::smartview>(saucer::smartview::create({.window = worker.window, .offscreen = true}).value());
+        worker.pdf     = std::make_unique<saucer::modules::pdf>(*worker.webview);
+
+        worker.webview->on<saucer::webview::event::load>(
+            [&](auto state)
+            {
+                if (state != saucer::state::finished || !worker.current)
+                {
+                    return;
+                }
+
+                worker.pdf->save({.file = worker.current->output});
+                done++;
+
+                next(worker);
+            });
+
+        worker.window->show();
+    }
+
+    for (auto &worker : workers)
+    {
+        next(*worker);
+    }
+
+    co_await app->finish();
+}
+
+int main()
+{
+    return saucer::application::create({.id = "example"})->run(start);
+}
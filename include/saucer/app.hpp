@@ -1,12 +1,19 @@
 #pragma once
 
+#include "poll.hpp"
+#include "trace.hpp"
+#include "metrics.hpp"
+
 #include "modules/module.hpp"
+#include "utils/task.hpp"
 #include "utils/required.hpp"
 
 #include "error/error.hpp"
 
+#include <chrono>
 #include <vector>
 #include <compare>
+#include <cstdint>
 #include <optional>
 #include <functional>
 
@@ -20,12 +27,52 @@
 
 namespace saucer
 {
+    enum class thread_priority : std::uint8_t
+    {
+        lowest,
+        low,
+        normal,
+        high,
+    };
+
+    struct thread_options
+    {
+        // Only honored by worker pools
+        std::optional<std::size_t> count;
+
+      public:
+        // A bit per logical CPU, ignored on macOS where threads can not be pinned
+        std::optional<std::uint64_t> affinity;
+        std::optional<thread_priority> priority;
+    };
+
     enum class policy : std::uint8_t
     {
         allow,
         block,
     };
 
+    enum class priority : std::uint8_t
+    {
+        interactive,
+        normal,
+        background,
+    };
+
+    enum class timer_precision : std::uint8_t
+    {
+        precise,
+        coarse,
+        very_coarse,
+    };
+
+    enum class memory_pressure : std::uint8_t
+    {
+        normal,
+        warning,
+        critical,
+    };
+
     struct position
     {
         int x;
@@ -64,18 +111,25 @@ namespace saucer
         struct options;
 
       private:
-        using post_callback_t = std::move_only_function<void()>;
-        using callback_t      = std::move_only_function<coco::stray(application *)>;
+        using post_callback_t  = task;
+        using timer_callback_t = std::move_only_function<void()>;
+        using callback_t       = std::move_only_function<coco::stray(application *)>;
 
       public:
         enum class event : std::uint8_t
         {
+            screens_changed,
+            memory,
             quit,
+            instance,
         };
 
       public:
-        using events = ereignis::manager<          //
-            ereignis::event<event::quit, policy()> //
+        using events = ereignis::manager<                                           //
+            ereignis::event<event::screens_changed, void()>,                        //
+            ereignis::event<event::memory, void(memory_pressure)>,                  //
+            ereignis::event<event::quit, policy()>,                                 //
+            ereignis::event<event::instance, void(const std::vector<std::string> &)> //
             >;
 
       private:
@@ -103,12 +157,31 @@ namespace saucer
         [[nodiscard]] std::vector<screen> screens() const;
 
       public:
-        void post(post_callback_t) const;
+        [[sc::thread_safe]] [[nodiscard]] std::size_t pending() const;
+        [[sc::thread_safe]] [[nodiscard]] saucer::metrics metrics() const;
+
+      public:
+        void post(post_callback_t, priority = priority::normal, std::source_location = std::source_location::current()) const;
+
+      public:
+        [[sc::thread_safe]] void submit(post_callback_t, priority = priority::normal) const;
+        [[sc::thread_safe]] [[nodiscard]] std::size_t concurrency() const;
+
+      public:
+        [[sc::thread_safe]] std::size_t schedule(std::chrono::milliseconds, timer_callback_t, timer_precision = timer_precision::precise);
+        [[sc::thread_safe]] std::size_t every(std::chrono::milliseconds, timer_callback_t, timer_precision = timer_precision::coarse);
+
+      public:
+        [[sc::thread_safe]] void cancel(std::size_t id);
 
       public:
         int run(callback_t);
         coco::future<void> finish();
 
+      public:
+        [[nodiscard]] poll_set prepare();
+        bool process(const poll_set &);
+
       public:
         void quit();
 
@@ -116,9 +189,18 @@ namespace saucer
         void operator&() = delete;
 
       public:
-        template <typename Callback, typename... Ts>
+        template <priority Priority = priority::normal, typename Callback, typename... Ts>
         [[sc::thread_safe]] auto invoke(Callback &&, Ts &&...) const;
 
+        template <priority Priority = priority::normal, typename Callback, typename... Ts>
+        [[sc::thread_safe]] auto invoke_async(Callback &&, Ts &&...) const;
+
+        template <priority Priority = priority::normal, typename Callback, typename... Ts>
+        [[sc::thread_safe]] void dispatch(Callback &&, Ts &&...) const;
+
+      public:
+        [[sc::thread_safe]] [[nodiscard]] auto schedule() const;
+
       public:
         template <event Event>
         [[sc::thread_safe]] auto on(events::event<Event>::listener);
@@ -145,6 +227,25 @@ namespace saucer
 
       public:
         bool quit_on_last_window_closed{true};
+        bool prewarm_engine{false};
+
+      public:
+        // Later launches with the same `id` forward their arguments to the running instance (`event::instance`), `create` then
+        // fails with `contract_error::instance_forwarded` and the caller is expected to exit
+        bool single_instance{false};
+
+      public:
+        // Worker pools run `launch::pool` handlers, strands and decoding, helpers are the timer and drain threads saucer spawns
+        thread_options workers;
+        thread_options helpers;
+
+      public:
+        trace_callback trace;
+
+      public:
+        // UI-thread tasks running longer than the budget are reported, measuring only starts once a callback is set
+        std::chrono::milliseconds task_budget{50};
+        long_task_callback long_tasks;
     };
 } // namespace saucer
 
@@ -2,10 +2,24 @@
 
 #include "app.hpp"
 
+#include <mutex>
+#include <condition_variable>
+
+#include <utility>
+#include <variant>
+#include <optional>
+#include <exception>
+
+#include <future>
+#include <coroutine>
+
 namespace saucer
 {
     namespace detail
     {
+        template <typename T>
+        consteval std::source_location origin();
+
         template <typename T>
         struct safe_delete;
 
@@ -14,6 +28,12 @@ namespace saucer
 
         template <typename T, typename... Ts>
         auto make_safe(application *app, Ts &&...);
+
+        template <typename T>
+        class invoke_state;
+
+        template <typename T>
+        class invoke_handle;
     } // namespace detail
 
     template <typename T>
@@ -25,6 +45,13 @@ namespace saucer
         void operator()(T *ptr) const;
     };
 
+    template <typename T>
+    consteval std::source_location detail::origin()
+    {
+        // The function name of this location spells out `T`, which is the closest to a name anonymous callbacks have
+        return std::source_location::current();
+    }
+
     template <typename T>
     void detail::safe_delete<T>::operator()(T *ptr) const
     {
@@ -42,14 +69,145 @@ namespace saucer
         return safe_ptr<T>(new T{std::forward<Ts>(args)...}, safe_delete<T>(app));
     }
 
-    template <typename Callback, typename... Ts>
+    template <typename T>
+    class detail::invoke_state
+    {
+        using stored = std::conditional_t<std::is_reference_v<T>, std::add_pointer_t<T>, T>;
+
+      private:
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+
+      private:
+        bool m_ready{false};
+        std::exception_ptr m_exception;
+        std::optional<std::conditional_t<std::is_void_v<T>, std::monostate, stored>> m_value;
+
+      private:
+        void finish()
+        {
+            std::lock_guard guard{m_mutex};
+            m_ready = true;
+            m_condition.notify_one();
+        }
+
+      public:
+        template <typename Callback>
+        void run(Callback &&callback) noexcept
+        {
+#if defined(__cpp_exceptions) && !defined(SAUCER_NO_EXCEPTIONS)
+            try
+#endif
+            {
+                if constexpr (std::is_void_v<T>)
+                {
+                    std::invoke(std::forward<Callback>(callback));
+                }
+                else if constexpr (std::is_reference_v<T>)
+                {
+                    m_value.emplace(std::addressof(std::invoke(std::forward<Callback>(callback))));
+                }
+                else
+                {
+                    m_value.emplace(std::invoke(std::forward<Callback>(callback)));
+                }
+            }
+#if defined(__cpp_exceptions) && !defined(SAUCER_NO_EXCEPTIONS)
+            catch (...)
+            {
+                m_exception = std::current_exception();
+            }
+#endif
+
+            finish();
+        }
+
+        void abandon() noexcept
+        {
+#if defined(__cpp_exceptions) && !defined(SAUCER_NO_EXCEPTIONS)
+            m_exception = std::make_exception_ptr(std::future_error{std::future_errc::broken_promise});
+#else
+            std::terminate();
+#endif
+            finish();
+        }
+
+      public:
+        T get()
+        {
+            std::unique_lock guard{m_mutex};
+            m_condition.wait(guard, [this] { return m_ready; });
+
+            if (m_exception)
+            {
+                std::rethrow_exception(m_exception);
+            }
+
+            if constexpr (std::is_reference_v<T>)
+            {
+                return static_cast<T>(**m_value);
+            }
+            else if constexpr (!std::is_void_v<T>)
+            {
+                return std::move(*m_value);
+            }
+        }
+    };
+
+    template <typename T>
+    class detail::invoke_handle
+    {
+        invoke_state<T> *m_state;
+
+      public:
+        invoke_handle(invoke_state<T> *state) : m_state(state) {}
+        invoke_handle(invoke_handle &&other) noexcept : m_state(std::exchange(other.m_state, nullptr)) {}
+
+      public:
+        ~invoke_handle()
+        {
+            if (!m_state)
+            {
+                return;
+            }
+
+            m_state->abandon();
+        }
+
+      public:
+        template <typename Callback>
+        void operator()(Callback &&callback)
+        {
+            std::exchange(m_state, nullptr)->run(std::forward<Callback>(callback));
+        }
+    };
+
+    template <priority Priority, typename Callback, typename... Ts>
     auto application::invoke(Callback &&callback, Ts &&...args) const
     {
+        using result = std::invoke_result_t<Callback, Ts...>;
+
         if (thread_safe())
         {
             return std::invoke(std::forward<Callback>(callback), std::forward<Ts>(args)...);
         }
 
+        // The caller blocks until completion, so both the state and the arguments can safely stay on its stack
+        auto state = detail::invoke_state<result>{};
+
+        auto task_callback = [handle = detail::invoke_handle{&state}, &callback, &args...]() mutable
+        {
+            handle([&]() -> result { return std::invoke(std::forward<Callback>(callback), std::forward<Ts>(args)...); });
+        };
+
+        post(std::move(task_callback), Priority, detail::origin<std::remove_cvref_t<Callback>>());
+
+        return state.get();
+    }
+
+    template <priority Priority, typename Callback, typename... Ts>
+    auto application::invoke_async(Callback &&callback, Ts &&...args) const
+    {
         auto task_callback = [callback = std::forward<Callback>(callback), ... args = std::forward<Ts>(args)]() mutable
         {
             return std::invoke(std::forward<Callback>(callback), std::forward<Ts>(args)...);
@@ -58,9 +216,57 @@ namespace saucer
         auto task   = std::packaged_task{std::move(task_callback)};
         auto future = task.get_future();
 
-        post([task = std::move(task)]() mutable { task(); });
+        if (thread_safe())
+        {
+            task();
+            return future;
+        }
+
+        post([task = std::move(task)]() mutable { task(); }, Priority, detail::origin<std::remove_cvref_t<Callback>>());
+
+        return future;
+    }
+
+    template <priority Priority, typename Callback, typename... Ts>
+    void application::dispatch(Callback &&callback, Ts &&...args) const
+    {
+        if (thread_safe())
+        {
+            std::invoke(std::forward<Callback>(callback), std::forward<Ts>(args)...);
+            return;
+        }
+
+        auto task = [callback = std::forward<Callback>(callback), ... args = std::forward<Ts>(args)]() mutable
+        {
+            std::invoke(std::move(callback), std::move(args)...);
+        };
+
+        post(std::move(task), Priority, detail::origin<std::remove_cvref_t<Callback>>());
+    }
+
+    inline auto application::schedule() const
+    {
+        struct awaitable
+        {
+            const application *app;
+
+          public:
+            [[nodiscard]] bool await_ready() const
+            {
+                return app->thread_safe();
+            }
+
+          public:
+            void await_suspend(std::coroutine_handle<> handle) const
+            {
+                app->post([handle] { handle.resume(); });
+            }
+
+          public:
+            void await_resume() const {}
+        };
 
-        return future.get();
+        return awaitable{this};
     }
 
     template <application::event Event>
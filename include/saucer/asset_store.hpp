@@ -0,0 +1,41 @@
+#pragma once
+
+#include "webview.hpp"
+
+#include <memory>
+#include <cstddef>
+#include <filesystem>
+#include <unordered_map>
+
+namespace saucer
+{
+    struct asset_store
+    {
+        struct impl;
+
+      private:
+        using embedded_files = std::unordered_map<fs::path, embedded_file>;
+
+      private:
+        std::shared_ptr<impl> m_impl;
+
+      public:
+        asset_store();
+
+      public:
+        void embed(embedded_files);
+
+      public:
+        void unembed();
+        void unembed(const fs::path &);
+
+      public:
+        [[nodiscard]] std::size_t size() const;
+
+      public:
+        [[nodiscard]] impl *native() const;
+
+      public:
+        bool operator==(const asset_store &) const = default;
+    };
+} // namespace saucer
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * A plain C layer over the hot paths of a webview, meant for foreign-language hosts (e.g. Go through cgo).
+ * All data is passed as pointer + length and callbacks receive whole batches, so a loop iteration crosses the boundary at most once.
+ * Borrowed slices are only valid for the duration of the call they are passed to.
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    typedef struct saucer_webview saucer_webview;
+
+    typedef struct
+    {
+        const char *data;
+        size_t size;
+    } saucer_slice;
+
+    typedef struct
+    {
+        uint64_t id;
+        bool resolved;
+        saucer_slice value; /* A JavaScript expression, usually serialized JSON */
+    } saucer_reply;
+
+    typedef struct
+    {
+        saucer_slice name;
+        saucer_slice value;
+    } saucer_header;
+
+    typedef struct
+    {
+        uint64_t id;
+        saucer_slice url;
+        saucer_slice method;
+        saucer_slice body;
+    } saucer_scheme_request;
+
+    typedef struct
+    {
+        uint64_t id;
+        int32_t status;
+        saucer_slice mime;
+        saucer_slice data;
+
+        const saucer_header *headers;
+        size_t header_count;
+
+        /* When set, `data` is not copied but kept alive until saucer calls `release(context)`, possibly on another thread */
+        void (*release)(void *context);
+        void *context;
+    } saucer_scheme_response;
+
+    typedef void (*saucer_message_batch)(void *user, const saucer_slice *messages, size_t count);
+    typedef void (*saucer_scheme_batch)(void *user, const saucer_scheme_request *requests, size_t count);
+
+    /* Messages the page sends through `saucer.internal.message` that no other handler claimed, delivered on the UI thread */
+    void saucer_webview_on_messages(saucer_webview *, saucer_message_batch, void *user);
+
+    /* Settles pending `saucer.internal.rpc` promises, all replies are handed to the page in a single script */
+    void saucer_webview_settle(saucer_webview *, const saucer_reply *replies, size_t count);
+
+    /* The scripts are joined and executed at once */
+    void saucer_webview_execute(saucer_webview *, const saucer_slice *scripts, size_t count);
+
+    /* Requests are answered later (from any thread) through `saucer_scheme_respond` or `saucer_scheme_fail` using their id */
+    void saucer_webview_handle_scheme(saucer_webview *, saucer_slice name, saucer_scheme_batch, void *user);
+    void saucer_webview_remove_scheme(saucer_webview *, saucer_slice name);
+
+    void saucer_scheme_respond(saucer_webview *, const saucer_scheme_response *responses, size_t count);
+    void saucer_scheme_fail(saucer_webview *, uint64_t id, int32_t error);
+
+    /* Detaches all handlers and fails scheme requests that were not answered yet, the webview itself is owned by the C++ side */
+    void saucer_webview_release(saucer_webview *);
+
+#ifdef __cplusplus
+}
+
+namespace saucer
+{
+    struct webview;
+} // namespace saucer
+
+[[nodiscard]] saucer_webview *saucer_webview_wrap(saucer::webview &);
+#endif
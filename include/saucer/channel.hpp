@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+namespace saucer
+{
+    enum class channel_status : std::uint8_t
+    {
+        written,
+        saturated,
+        closed,
+    };
+
+    template <typename T, typename E = std::string_view>
+    struct channel
+    {
+        std::function<channel_status(T)> push;
+        std::function<void(E)> reject;
+        std::function<void()> close;
+    };
+} // namespace saucer
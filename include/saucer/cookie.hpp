@@ -0,0 +1,38 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+
+#include <string>
+
+namespace saucer
+{
+    struct cookie
+    {
+        std::string name;
+        std::string value;
+
+      public:
+        std::string domain;
+        std::string path{"/"};
+
+      public:
+        // Session cookies are kept until the engine shuts down
+        std::optional<std::chrono::system_clock::time_point> expires;
+
+      public:
+        bool secure{false};
+        bool http_only{false};
+    };
+
+    struct site_data
+    {
+        bool cookies{true};
+        bool storage{true};
+        bool cache{true};
+
+      public:
+        // Restricts clearing to a single origin, e.g. `https://example.com`
+        std::optional<std::string> origin;
+    };
+} // namespace saucer
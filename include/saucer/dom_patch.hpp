@@ -0,0 +1,59 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <optional>
+
+#include <string>
+
+namespace saucer
+{
+    // Operations address the children of the target element by index and are applied in order, so later indices see earlier changes
+    class dom_patch
+    {
+      public:
+        enum class kind : std::uint8_t
+        {
+            html,
+            insert,
+            replace,
+            remove,
+            text,
+            attribute,
+        };
+
+      public:
+        struct operation
+        {
+            kind type;
+            std::size_t index{0};
+            std::size_t count{1};
+
+          public:
+            std::string name{};
+            std::optional<std::string> value{};
+        };
+
+      private:
+        std::string m_target;
+        std::vector<operation> m_operations;
+
+      public:
+        dom_patch(std::string target);
+
+      public:
+        dom_patch &html(std::string);
+        dom_patch &insert(std::size_t index, std::string html);
+        dom_patch &replace(std::size_t index, std::string html);
+        dom_patch &remove(std::size_t index, std::size_t count = 1);
+
+      public:
+        dom_patch &text(std::size_t index, std::string);
+        dom_patch &attribute(std::size_t index, std::string name, std::optional<std::string> value);
+
+      public:
+        [[nodiscard]] bool empty() const;
+        [[nodiscard]] const std::string &target() const;
+        [[nodiscard]] const std::vector<operation> &operations() const;
+    };
+} // namespace saucer
@@ -56,8 +56,9 @@ namespace saucer
 
     enum class contract_error : std::uint8_t
     {
-        instance_exists  = 1,
-        required_invalid = 2,
+        instance_exists    = 1,
+        required_invalid   = 2,
+        instance_forwarded = 3,
     };
 
     template <typename T = void>
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "scheme.hpp"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace saucer::scheme
+{
+    class event_stream
+    {
+        struct impl;
+
+      public:
+        struct event;
+        struct options;
+
+      public:
+        enum class overflow : std::uint8_t
+        {
+            drop,
+            disconnect,
+        };
+
+      private:
+        std::shared_ptr<impl> m_impl;
+
+      public:
+        event_stream(options);
+
+      public:
+        void operator()(request, stream_writer) const;
+
+      public:
+        void publish(const event &) const;
+        void close() const;
+
+      public:
+        [[nodiscard]] std::size_t clients() const;
+        [[nodiscard]] std::size_t dropped() const;
+    };
+
+    struct event_stream::event
+    {
+        std::string data;
+        std::string type;
+        std::string id;
+    };
+
+    struct event_stream::options
+    {
+        std::size_t backlog{64};
+        overflow policy{overflow::drop};
+
+      public:
+        std::chrono::milliseconds heartbeat{std::chrono::seconds(15)};
+        std::optional<std::chrono::milliseconds> retry{std::chrono::seconds(3)};
+    };
+} // namespace saucer::scheme
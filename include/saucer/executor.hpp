@@ -1,7 +1,13 @@
 #pragma once
 
+#include <memory>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <concepts>
 #include <functional>
 #include <string_view>
+#include <type_traits>
 
 namespace saucer
 {
@@ -21,12 +27,96 @@ namespace saucer
 
         template <typename R, typename T>
         using fn_with_arg_t = fn_with_arg<R, T>::type;
+
+        // Move-only so captures need not be copyable, yet callable through `const &` like the `std::function` it replaces
+
+        template <typename Signature>
+        class callback;
+
+        template <typename R, typename... Ts>
+        class callback<R(Ts...)>
+        {
+            using function = std::move_only_function<R(Ts...)>;
+
+          private:
+            mutable function m_function;
+
+          public:
+            callback() = default;
+
+          public:
+            template <typename T>
+                requires(not std::same_as<std::remove_cvref_t<T>, callback> and std::constructible_from<function, T>)
+            callback(T &&func) : m_function(std::forward<T>(func)) // NOLINT(*-explicit-constructor)
+            {
+            }
+
+          public:
+            [[nodiscard]] explicit operator bool() const noexcept
+            {
+                return static_cast<bool>(m_function);
+            }
+
+          public:
+            R operator()(Ts... args) const
+            {
+                return m_function(std::forward<Ts>(args)...);
+            }
+        };
     } // namespace detail
 
     template <typename T, typename E = std::string_view>
     struct executor
     {
-        std::function<detail::fn_with_arg_t<void, T>> resolve;
-        std::function<detail::fn_with_arg_t<void, E>> reject;
+        detail::callback<detail::fn_with_arg_t<void, T>> resolve;
+        detail::callback<detail::fn_with_arg_t<void, E>> reject;
+
+      public:
+        std::shared_ptr<const std::atomic_bool> token{};
+
+      public:
+        [[nodiscard]] bool cancelled() const
+        {
+            return token && token->load(std::memory_order_relaxed);
+        }
+
+      public:
+        template <std::size_t I>
+        [[nodiscard]] auto &get() &
+        {
+            if constexpr (I == 0)
+            {
+                return resolve;
+            }
+            else
+            {
+                return reject;
+            }
+        }
+
+        template <std::size_t I>
+        [[nodiscard]] const auto &get() const &
+        {
+            return const_cast<executor *>(this)->get<I>();
+        }
+
+        template <std::size_t I>
+        [[nodiscard]] auto &&get() &&
+        {
+            return std::move(get<I>());
+        }
     };
 } // namespace saucer
+
+// The token is an implementation detail of cancellation, structured bindings keep decomposing into `[resolve, reject]`
+
+template <typename T, typename E>
+struct std::tuple_size<saucer::executor<T, E>> : std::integral_constant<std::size_t, 2>
+{
+};
+
+template <std::size_t I, typename T, typename E>
+struct std::tuple_element<I, saucer::executor<T, E>>
+{
+    using type = std::remove_reference_t<decltype(std::declval<saucer::executor<T, E> &>().template get<I>())>;
+};
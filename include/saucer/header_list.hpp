@@ -0,0 +1,111 @@
+#pragma once
+
+#include "utils/cstring.hpp"
+
+#include <array>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <variant>
+#include <concepts>
+#include <string_view>
+#include <type_traits>
+#include <initializer_list>
+
+namespace saucer::scheme
+{
+    class header_text
+    {
+        std::variant<std::string_view, std::string> m_value;
+
+      public:
+        header_text() noexcept;
+
+      public:
+        // Only arrays with static storage (i.e. literals) can be viewed, anything else has to be copied through `std::string`
+        template <std::size_t N>
+        consteval header_text(const char (&)[N]) noexcept; // NOLINT(*-explicit-constructor)
+
+        template <typename T>
+            requires(not std::same_as<std::remove_cvref_t<T>, header_text> and std::constructible_from<std::string, T>)
+        header_text(T &&); // NOLINT(*-explicit-constructor)
+
+      public:
+        [[nodiscard]] bool owned() const noexcept;
+
+      public:
+        [[nodiscard]] std::size_t size() const noexcept;
+        [[nodiscard]] const char *c_str() const noexcept;
+
+      public:
+        [[nodiscard]] cstring_view view() const noexcept;
+        operator std::string_view() const noexcept; // NOLINT(*-explicit-constructor)
+
+      public:
+        [[nodiscard]] bool operator==(std::string_view) const noexcept;
+    };
+
+    struct header_field
+    {
+        header_text name;
+        header_text value;
+    };
+
+    class header_list
+    {
+        static constexpr auto inline_capacity = 8uz;
+
+      public:
+        using value_type     = header_field;
+        using iterator       = header_field *;
+        using const_iterator = const header_field *;
+
+      private:
+        std::size_t m_size{0};
+        std::array<header_field, inline_capacity> m_inline;
+        std::vector<header_field> m_spilled;
+
+      public:
+        header_list();
+        header_list(std::initializer_list<header_field>);
+
+      public:
+        header_list(const header_list &);
+        header_list(header_list &&) noexcept;
+
+      public:
+        header_list &operator=(const header_list &);
+        header_list &operator=(header_list &&) noexcept;
+
+      public:
+        ~header_list();
+
+      private:
+        [[nodiscard]] header_field *data() noexcept;
+        [[nodiscard]] const header_field *data() const noexcept;
+
+      private:
+        void push(header_field);
+
+      public:
+        [[nodiscard]] bool empty() const noexcept;
+        [[nodiscard]] std::size_t size() const noexcept;
+
+      public:
+        [[nodiscard]] iterator begin() noexcept;
+        [[nodiscard]] iterator end() noexcept;
+
+      public:
+        [[nodiscard]] const_iterator begin() const noexcept;
+        [[nodiscard]] const_iterator end() const noexcept;
+
+      public:
+        [[nodiscard]] const_iterator find(std::string_view name) const noexcept;
+
+      public:
+        bool emplace(header_text name, header_text value);
+        void insert_or_assign(header_text name, header_text value);
+    };
+} // namespace saucer::scheme
+
+#include "header_list.inl"
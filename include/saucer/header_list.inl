@@ -0,0 +1,20 @@
+#pragma once
+
+#include "header_list.hpp"
+
+#include <utility>
+
+namespace saucer::scheme
+{
+    // Measuring the literal reads it, which only compiles for arrays that are usable in constant expressions
+    template <std::size_t N>
+    consteval header_text::header_text(const char (&literal)[N]) noexcept : m_value(std::string_view{literal})
+    {
+    }
+
+    template <typename T>
+        requires(not std::same_as<std::remove_cvref_t<T>, header_text> and std::constructible_from<std::string, T>)
+    header_text::header_text(T &&value) : m_value(std::string{std::forward<T>(value)})
+    {
+    }
+} // namespace saucer::scheme
@@ -6,8 +6,12 @@
 #include "stash/stash.hpp"
 
 #include <memory>
+#include <cstddef>
+#include <optional>
 #include <filesystem>
 
+#include <coco/promise/promise.hpp>
+
 namespace saucer
 {
     namespace fs = std::filesystem;
@@ -48,5 +52,12 @@ namespace saucer
       public:
         [[nodiscard]] static result<icon> from(const stash &ico);
         [[nodiscard]] static result<icon> from(const fs::path &file);
+
+      public:
+        [[nodiscard]] static result<icon> from(const stash &ico, std::size_t size);
+
+      public:
+        [[nodiscard]] static coco::future<result<icon>> load(const stash &ico, std::optional<std::size_t> size = std::nullopt);
+        [[nodiscard]] static coco::future<result<icon>> load(fs::path file);
     };
 } // namespace saucer
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <optional>
+
+#include <string>
+
+namespace saucer
+{
+    struct histogram
+    {
+        static constexpr auto bounds = std::array{0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0, 25.0, 50.0, 100.0, 250.0, 500.0, 1000.0};
+
+      public:
+        std::array<std::uint64_t, bounds.size() + 1> buckets;
+
+      public:
+        std::uint64_t count;
+        double sum;
+    };
+
+    struct metrics
+    {
+        std::size_t queued;
+        std::size_t pending_evaluations;
+
+      public:
+        std::uint64_t exposed_calls;
+        histogram call_latency;
+
+      public:
+        std::uint64_t scheme_requests;
+        std::uint64_t scheme_bytes;
+        std::size_t stream_writers;
+    };
+
+    struct memory_usage
+    {
+        std::optional<std::size_t> engine;
+        std::optional<std::size_t> heap;
+    };
+
+    // All times are in milliseconds, relative to the start of the navigation
+    struct resource_timing
+    {
+        std::string name;
+        std::string type;
+
+      public:
+        double start;
+        double duration;
+        std::uint64_t size;
+    };
+
+    struct load_timing
+    {
+        double dns;
+        double connect;
+        double ttfb;
+        double dom_content_loaded;
+        double load;
+
+      public:
+        std::vector<resource_timing> resources;
+    };
+} // namespace saucer
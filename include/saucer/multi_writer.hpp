@@ -0,0 +1,31 @@
+#pragma once
+
+#include "scheme.hpp"
+
+#include <memory>
+#include <cstddef>
+
+namespace saucer::scheme
+{
+    class multi_writer
+    {
+        struct impl;
+
+      private:
+        std::shared_ptr<impl> m_impl;
+
+      public:
+        multi_writer(stream_writer, const stream_response &);
+
+      public:
+        [[nodiscard]] std::size_t reserve(std::size_t count = 1) const;
+
+      public:
+        write_status write(stash data) const;
+        write_status write(std::size_t sequence, stash data) const;
+
+      public:
+        void finish() const;
+        void reject(error err) const;
+    };
+} // namespace saucer::scheme
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "scheme.hpp"
+
+#include <memory>
+#include <cstddef>
+
+namespace saucer::scheme
+{
+    class pipeline
+    {
+        struct impl;
+
+      private:
+        std::unique_ptr<impl> m_impl;
+
+      public:
+        pipeline(stream_writer, const stream_response &, std::size_t depth = 8);
+
+      public:
+        pipeline(pipeline &&) noexcept;
+
+      public:
+        ~pipeline();
+
+      public:
+        bool push(stash data);
+        write_status try_push(stash data);
+
+      public:
+        void finish();
+        void reject(error err);
+    };
+} // namespace saucer::scheme
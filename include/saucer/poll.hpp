@@ -0,0 +1,30 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <optional>
+
+namespace saucer
+{
+    struct poll_handle
+    {
+        // A file descriptor on GLib, a `HANDLE` on Windows
+        std::intptr_t handle;
+
+      public:
+        // Uses the same bits as `poll(2)`, the caller fills in `revents` before processing
+        std::uint16_t events;
+        std::uint16_t revents;
+    };
+
+    struct poll_set
+    {
+        std::vector<poll_handle> handles;
+        std::optional<std::chrono::milliseconds> timeout;
+
+      public:
+        // Set on Win32, where the thread's message queue has to be waited on as well (`MsgWaitForMultipleObjectsEx`)
+        bool messages{false};
+    };
+} // namespace saucer
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "app.hpp"
+#include "scheme.hpp"
+#include "smartview.hpp"
+#include "error/error.hpp"
+
+#include "config.hpp"
+#include "serializers/serializer.hpp"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <functional>
+#include <filesystem>
+
+#include <coco/promise/promise.hpp>
+
+namespace saucer::remote
+{
+    namespace fs = std::filesystem;
+
+    // Scheme requests are copied into the coordinating process as a whole, including their body
+    struct request
+    {
+        std::string url;
+        std::string method;
+        std::map<std::string, std::string> headers;
+
+      public:
+        std::string body;
+    };
+
+    using resolver = std::function<void(const request &, scheme::executor)>;
+
+    struct options
+    {
+        fs::path executable;
+        std::vector<std::string> arguments;
+
+      public:
+        // Per direction, a single message (e.g. a scheme response) has to fit into it
+        std::size_t capacity{8 * 1024 * 1024};
+    };
+
+    class host_base
+    {
+        struct impl;
+
+      protected:
+        std::shared_ptr<impl> m_impl;
+
+      protected:
+        host_base(application *, std::unique_ptr<serializer_core>);
+
+      public:
+        host_base(host_base &&) noexcept;
+
+      public:
+        // Closes the connection without waiting for the child, one that does not exit on its own within a few seconds is killed
+        ~host_base();
+
+      protected:
+        [[nodiscard]] result<void> launch(const options &);
+        void add_function(std::string, serializer_core::function &&);
+
+      public:
+        [[sc::thread_safe]] [[nodiscard]] bool running() const;
+
+      public:
+        // `view` refers to the index returned by `child::attach` in the hosted process, scripts for unknown views are dropped
+        [[sc::thread_safe]] void execute(std::size_t view, std::string code);
+        [[sc::thread_safe]] [[nodiscard]] coco::future<result<std::string>> evaluate_raw(std::size_t view, std::string code);
+
+      public:
+        // The child still has to register the scheme itself, see `webview::register_scheme`
+        [[sc::thread_safe]] void handle_scheme(std::size_t view, const std::string &name, resolver handler);
+
+      public:
+        // Invoked on the main thread with the exit code of the child, pending evaluations are rejected beforehand
+        [[sc::thread_safe]] void on_exit(std::function<void(int)> callback);
+    };
+
+    // Spawns a process hosting a group of webviews, calls to functions the child does not expose itself end up here.
+    // Both processes have to use the same serializer, handlers are always invoked on the main thread of the coordinator.
+    template <Serializer Serializer>
+    class basic_host : public host_base
+    {
+        basic_host(application *);
+
+      public:
+        basic_host(basic_host &&) noexcept;
+
+      public:
+        [[nodiscard]] static result<basic_host> spawn(application *, const options &);
+
+      public:
+        template <typename T>
+        [[sc::thread_safe]] void expose(std::string name, T &&func);
+    };
+
+    using host = basic_host<default_serializer>;
+
+    class child
+    {
+        struct impl;
+
+      private:
+        std::shared_ptr<impl> m_impl;
+
+      private:
+        child();
+
+      public:
+        ~child();
+
+      public:
+        // Returns nothing unless the process was spawned by a host, the application quits once the host goes away
+        [[nodiscard]] static std::unique_ptr<child> connect(application *);
+
+      public:
+        // Forwards calls to functions that are not exposed on the webview, which has to outlive the connection
+        [[sc::thread_safe]] std::size_t attach(smartview_base &);
+    };
+} // namespace saucer::remote
+
+#include "remote.inl"
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "remote.hpp"
+
+#include <utility>
+
+namespace saucer::remote
+{
+    template <Serializer Serializer>
+    basic_host<Serializer>::basic_host(application *parent) : host_base(parent, std::make_unique<Serializer>())
+    {
+    }
+
+    template <Serializer Serializer>
+    basic_host<Serializer>::basic_host(basic_host &&other) noexcept = default;
+
+    template <Serializer Serializer>
+    result<basic_host<Serializer>> basic_host<Serializer>::spawn(application *parent, const options &opts)
+    {
+        auto rtn = basic_host{parent};
+
+        if (auto launched = rtn.launch(opts); !launched.has_value())
+        {
+            return err(launched);
+        }
+
+        return rtn;
+    }
+
+    template <Serializer Serializer>
+    template <typename T>
+    void basic_host<Serializer>::expose(std::string name, T &&func)
+    {
+        static_assert(!traits::producer<T>::valid, "Producers stream their results and can not be forwarded");
+        add_function(std::move(name), Serializer::convert(std::forward<T>(func)));
+    }
+} // namespace saucer::remote
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "trace.hpp"
+#include "error/error.hpp"
+
+#include "config.hpp"
+#include "serializers/serializer.hpp"
+
+#include <span>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <filesystem>
+#include <unordered_map>
+
+namespace saucer
+{
+    namespace fs = std::filesystem;
+
+    namespace recording
+    {
+        // Records are stored as `<offset in ns> <size>\n<message>\n`, the recorder may be called from any thread
+        [[nodiscard]] result<ipc_recorder> writer(const fs::path &);
+        [[nodiscard]] result<std::vector<ipc_record>> read(const fs::path &);
+    } // namespace recording
+
+    struct replay_stats
+    {
+        std::size_t calls{0};
+        std::size_t skipped{0};
+
+      public:
+        std::size_t resolved{0};
+        std::size_t rejected{0};
+
+      public:
+        trace_clock::duration parse{};
+        trace_clock::duration handler{};
+    };
+
+    template <Serializer Serializer>
+    class basic_replay
+    {
+        struct counters
+        {
+            std::atomic_size_t resolved{0};
+            std::atomic_size_t rejected{0};
+        };
+
+      private:
+        Serializer m_serializer;
+        std::shared_ptr<counters> m_counters{std::make_shared<counters>()};
+        std::unordered_map<std::string, serializer_core::function> m_functions;
+
+      public:
+        template <typename T>
+        void expose(std::string name, T &&func);
+
+      public:
+        // Feeds every record through the parser and straight into its handler on the calling thread, no webview involved.
+        // Handlers that settle asynchronously are only counted once they did, calls relying on buffers or files will be rejected.
+        replay_stats run(std::span<const ipc_record>);
+    };
+
+    using replay = basic_replay<default_serializer>;
+} // namespace saucer
+
+#include "replay.inl"
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "replay.hpp"
+
+#include <utility>
+
+namespace saucer
+{
+    template <Serializer Serializer>
+    template <typename T>
+    void basic_replay<Serializer>::expose(std::string name, T &&func)
+    {
+        static_assert(!traits::producer<T>::valid, "Producers stream their results and can not be replayed");
+        m_functions.insert_or_assign(std::move(name), Serializer::convert(std::forward<T>(func)));
+    }
+
+    template <Serializer Serializer>
+    replay_stats basic_replay<Serializer>::run(std::span<const ipc_record> records)
+    {
+        auto rtn = replay_stats{};
+
+        for (const auto &record : records)
+        {
+            const auto start = trace_clock::now();
+            auto parsed      = m_serializer.parse(record.message);
+            const auto begin = trace_clock::now();
+
+            rtn.parse += begin - start;
+
+            auto *const data       = std::get_if<std::unique_ptr<function_data>>(&parsed);
+            const auto *const name = data ? std::get_if<std::string>(&(*data)->name) : nullptr;
+            const auto function    = name ? m_functions.find(*name) : m_functions.end();
+
+            if (function == m_functions.end())
+            {
+                rtn.skipped++;
+                continue;
+            }
+
+            auto executor = serializer_core::executor{
+                .resolve = [counters = m_counters](std::string) { counters->resolved.fetch_add(1, std::memory_order_relaxed); },
+                .reject  = [counters = m_counters](std::string) { counters->rejected.fetch_add(1, std::memory_order_relaxed); },
+            };
+
+            function->second(std::move(*data), std::move(executor));
+
+            rtn.calls++;
+            rtn.handler += trace_clock::now() - begin;
+        }
+
+        rtn.resolved = m_counters->resolved.exchange(0, std::memory_order_relaxed);
+        rtn.rejected = m_counters->rejected.exchange(0, std::memory_order_relaxed);
+
+        return rtn;
+    }
+} // namespace saucer
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "scheme.hpp"
+
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <optional>
+
+namespace saucer::scheme
+{
+    class response_cache
+    {
+        struct impl;
+
+      public:
+        struct options;
+
+      private:
+        std::shared_ptr<impl> m_impl;
+
+      public:
+        response_cache(options);
+
+      private:
+        [[nodiscard]] resolver wrap(resolver &&) const;
+
+      public:
+        template <typename T>
+        [[nodiscard]] resolver operator()(T &&handler) const;
+
+      public:
+        [[nodiscard]] std::size_t hits() const;
+        [[nodiscard]] std::size_t misses() const;
+        [[nodiscard]] std::size_t coalesced() const;
+        [[nodiscard]] std::size_t size() const;
+
+      public:
+        void clear();
+    };
+
+    struct response_cache::options
+    {
+        std::size_t capacity{32 * 1024 * 1024};
+        std::vector<std::string> vary;
+
+      public:
+        bool coalesce{true};
+
+      public:
+        // Successful responses are also written here, usually below `webview::options::storage_path`, and memory-mapped again on
+        // later launches. Entries written with a different version are ignored.
+        std::optional<fs::path> directory;
+        std::string version;
+    };
+} // namespace saucer::scheme
+
+#include "response_cache.inl"
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "response_cache.hpp"
+#include "traits/traits.hpp"
+
+namespace saucer::scheme
+{
+    template <typename T>
+    resolver response_cache::operator()(T &&handler) const
+    {
+        using transformer = traits::transformer<T, std::tuple<request>, executor>;
+        return wrap(resolver{transformer{std::forward<T>(handler)}});
+    }
+} // namespace saucer::scheme
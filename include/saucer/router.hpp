@@ -0,0 +1,35 @@
+#pragma once
+
+#include "scheme.hpp"
+
+#include <memory>
+#include <string_view>
+
+namespace saucer::scheme
+{
+    class router
+    {
+        struct impl;
+
+      private:
+        std::shared_ptr<impl> m_impl;
+
+      public:
+        router();
+
+      private:
+        void insert(std::string_view method, std::string_view pattern, resolver &&);
+
+      public:
+        template <typename T>
+        router &add(std::string_view method, std::string_view pattern, T &&handler);
+
+        template <typename T>
+        router &fallback(T &&handler);
+
+      public:
+        void operator()(request, executor) const;
+    };
+} // namespace saucer::scheme
+
+#include "router.inl"
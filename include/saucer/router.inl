@@ -0,0 +1,22 @@
+#pragma once
+
+#include "router.hpp"
+#include "traits/traits.hpp"
+
+namespace saucer::scheme
+{
+    template <typename T>
+    router &router::add(std::string_view method, std::string_view pattern, T &&handler)
+    {
+        using transformer = traits::transformer<T, std::tuple<request>, executor>;
+        insert(method, pattern, resolver{transformer{std::forward<T>(handler)}});
+
+        return *this;
+    }
+
+    template <typename T>
+    router &router::fallback(T &&handler)
+    {
+        return add("", "/**", std::forward<T>(handler));
+    }
+} // namespace saucer::scheme
@@ -2,13 +2,19 @@
 
 #include "url.hpp"
 #include "executor.hpp"
+#include "header_list.hpp"
 #include "stash/stash.hpp"
 
+#include <span>
+#include <chrono>
 #include <memory>
+#include <cstddef>
 #include <cstdint>
+#include <optional>
 
 #include <map>
 #include <string>
+#include <functional>
 
 namespace saucer::scheme
 {
@@ -20,11 +26,18 @@ namespace saucer::scheme
         failed    = -1,
     };
 
+    enum class write_status : std::uint8_t
+    {
+        written,
+        saturated,
+        closed,
+    };
+
     struct response
     {
         stash data;
         std::string mime;
-        std::map<std::string, std::string> headers;
+        header_list headers;
 
       public:
         int status{200};
@@ -35,25 +48,35 @@ namespace saucer::scheme
         struct impl;
 
       private:
-        std::unique_ptr<impl> m_impl;
+        std::shared_ptr<impl> m_impl;
+
+      private:
+        explicit request(std::shared_ptr<impl>);
 
       public:
         request(impl);
 
       public:
-        request(const request &);
         request(request &&) noexcept;
 
       public:
         ~request();
 
+      public:
+        // Refers to the same native request, including its body cursor, and is not synchronized with the original
+        [[nodiscard]] request share() const;
+
       public:
         [[nodiscard]] saucer::url url() const;
         [[nodiscard]] std::string method() const;
 
       public:
         [[nodiscard]] stash content() const;
-        [[nodiscard]] std::map<std::string, std::string> headers() const;
+        [[nodiscard]] std::optional<std::string> header(std::string_view name) const;
+        [[nodiscard]] const std::map<std::string, std::string> &headers() const;
+
+      public:
+        [[nodiscard]] std::size_t read(std::span<std::uint8_t> buffer) const;
     };
 
     using executor = saucer::executor<response, error>;
@@ -62,8 +85,12 @@ namespace saucer::scheme
     struct stream_response
     {
         std::string mime;
-        std::map<std::string, std::string> headers;
+        header_list headers;
         int status{200};
+
+      public:
+        std::optional<std::size_t> capacity;
+        std::optional<std::chrono::milliseconds> timeout;
     };
 
     class stream_writer
@@ -82,11 +109,22 @@ namespace saucer::scheme
 
       public:
         void start(const stream_response &);
-        void write(stash data);
+
+      public:
+        // Chunks are sent after `write` returned, so views are copied first
+        write_status write(stash data);
+        write_status write_file(int fd, std::size_t offset, std::size_t length);
         void finish();
         void reject(error err);
         [[nodiscard]] bool valid() const;
     };
 
     using stream_resolver = std::function<void(request, stream_writer)>;
+
+    using reader = std::function<stash(std::size_t offset, std::size_t length)>;
+
+    [[nodiscard]] std::optional<std::string> header(const request &, std::string_view name);
+
+    [[nodiscard]] response serve(const request &, std::size_t size, const reader &, std::string mime, header_list headers = {});
+    [[nodiscard]] response serve(const request &, const stash &, std::string mime, header_list headers = {});
 } // namespace saucer::scheme
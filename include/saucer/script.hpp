@@ -2,6 +2,7 @@
 
 #include <string>
 #include <cstdint>
+#include <optional>
 
 namespace saucer
 {
@@ -15,10 +16,12 @@ namespace saucer
 
       public:
         std::string code;
+        std::optional<std::string> world;
 
       public:
         time run_at;
         bool no_frames{true};
+        bool lazy{false};
 
       public:
         bool clearable{true};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "../glaze/glaze.hpp"
+
+#include <glaze/beve.hpp>
+
+namespace saucer::serializers::beve
+{
+    namespace detail
+    {
+        void encode(std::string_view, std::string &);
+    } // namespace detail
+
+    template <typename T>
+    concept Readable = glaze::Readable<T>;
+
+    template <typename T>
+    concept Writable = glz::write_supported<T, glz::BEVE> || std::convertible_to<T, std::string_view>;
+
+    struct serializer : saucer::serializer<serializer>
+    {
+        using result_data   = glaze::result_data;
+        using function_data = glaze::function_data;
+
+      public:
+        ~serializer() override;
+
+      public:
+        [[nodiscard]] std::string script() const override;
+        [[nodiscard]] std::string js_serializer() const override;
+        [[nodiscard]] parse_result parse(std::string_view) const override;
+
+      public:
+        template <Writable T>
+        static std::string write(T &&);
+
+        template <Writable T>
+        static void append(T &&, std::string &);
+
+        template <Readable T>
+        static result<T> read(std::string_view);
+
+      public:
+        template <Readable T>
+        static result<T> read(const result_data &);
+
+        template <Readable T>
+        static result<T> read(const function_data &);
+    };
+} // namespace saucer::serializers::beve
+
+#include "beve.inl"
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "beve.hpp"
+
+namespace saucer::serializers::beve
+{
+    template <Writable T>
+    std::string serializer::write(T &&value)
+    {
+        std::string rtn;
+        append(std::forward<T>(value), rtn);
+
+        return rtn;
+    }
+
+    template <Writable T>
+    void serializer::append(T &&value, std::string &out)
+    {
+        static thread_local std::string buffer;
+
+        auto error = [&]
+        {
+            if constexpr (std::convertible_to<T, std::string_view> && !std::same_as<std::remove_cvref_t<T>, std::string>)
+            {
+                return glz::write_beve(std::string_view{value}, buffer);
+            }
+            else
+            {
+                return glz::write_beve(std::forward<T>(value), buffer);
+            }
+        }();
+
+        if (error)
+        {
+            out += "null";
+            return;
+        }
+
+        static constexpr std::string_view prefix = R"(window.saucer.internal.beve(")";
+        static constexpr std::string_view suffix = R"("))";
+
+        out.reserve(out.size() + prefix.size() + (((buffer.size() + 2) / 3) * 4) + suffix.size());
+
+        out += prefix;
+        detail::encode(buffer, out);
+        out += suffix;
+
+        if (buffer.capacity() > glaze::detail::retained_capacity)
+        {
+            buffer = {};
+        }
+    }
+
+    template <Readable T>
+    serializer::result<T> serializer::read(std::string_view data)
+    {
+        return glaze::serializer::read<T>(data);
+    }
+
+    template <Readable T>
+    serializer::result<T> serializer::read(const result_data &data)
+    {
+        return glaze::serializer::read<T>(data);
+    }
+
+    template <Readable T>
+    serializer::result<T> serializer::read(const function_data &data)
+    {
+        return glaze::serializer::read<T>(data);
+    }
+} // namespace saucer::serializers::beve
@@ -1,17 +1,31 @@
 #pragma once
 
+#include "../stash/stash.hpp"
+
 #include <string>
+#include <vector>
+#include <variant>
 #include <cstddef>
+#include <filesystem>
+#include <string_view>
 
 namespace saucer
 {
     struct function_data
     {
         std::size_t id;
-        std::string name;
+        std::variant<std::size_t, std::string> name;
+
+      public:
+        std::vector<stash> buffers;
+        std::vector<std::filesystem::path> files;
 
       public:
         virtual ~function_data() = default;
+
+      public:
+        virtual void own() {}
+        [[nodiscard]] virtual std::string_view raw() const { return {}; }
     };
 
     struct result_data
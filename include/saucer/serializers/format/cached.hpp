@@ -0,0 +1,38 @@
+#pragma once
+
+#include <mutex>
+#include <memory>
+#include <string>
+#include <cstddef>
+
+namespace saucer
+{
+    // Serializes its value once and reuses the result until the value is changed, copies share the cache
+    template <typename T>
+    class cached
+    {
+        struct state;
+
+      private:
+        std::shared_ptr<state> m_state;
+
+      public:
+        cached(T value);
+
+      public:
+        [[nodiscard]] T value() const;
+        [[nodiscard]] std::size_t version() const;
+
+      public:
+        void set(T value);
+
+        template <typename Callback>
+        void modify(Callback &&);
+
+      public:
+        template <typename Interface>
+        [[nodiscard]] std::string serialize() const;
+    };
+} // namespace saucer
+
+#include "cached.inl"
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "cached.hpp"
+
+#include <utility>
+#include <functional>
+
+namespace saucer
+{
+    template <typename T>
+    struct cached<T>::state
+    {
+        T value;
+        std::size_t version{0};
+
+      public:
+        const void *serializer{nullptr};
+        std::size_t serialized_version{0};
+        std::string serialized;
+
+      public:
+        std::mutex mutex;
+    };
+
+    namespace detail
+    {
+        template <typename Interface>
+        inline constexpr char cache_key{};
+    } // namespace detail
+
+    template <typename T>
+    cached<T>::cached(T value) : m_state(std::make_shared<state>(std::move(value)))
+    {
+    }
+
+    template <typename T>
+    T cached<T>::value() const
+    {
+        std::lock_guard lock{m_state->mutex};
+        return m_state->value;
+    }
+
+    template <typename T>
+    std::size_t cached<T>::version() const
+    {
+        std::lock_guard lock{m_state->mutex};
+        return m_state->version;
+    }
+
+    template <typename T>
+    void cached<T>::set(T value)
+    {
+        std::lock_guard lock{m_state->mutex};
+
+        m_state->value = std::move(value);
+        m_state->version++;
+    }
+
+    template <typename T>
+    template <typename Callback>
+    void cached<T>::modify(Callback &&callback)
+    {
+        std::lock_guard lock{m_state->mutex};
+
+        std::invoke(std::forward<Callback>(callback), m_state->value);
+        m_state->version++;
+    }
+
+    template <typename T>
+    template <typename Interface>
+    std::string cached<T>::serialize() const
+    {
+        static constexpr const void *key = &detail::cache_key<Interface>;
+
+        std::lock_guard lock{m_state->mutex};
+
+        if (m_state->serializer != key || m_state->serialized_version != m_state->version)
+        {
+            m_state->serialized         = Interface::write(std::as_const(m_state->value));
+            m_state->serializer         = key;
+            m_state->serialized_version = m_state->version;
+        }
+
+        return m_state->serialized;
+    }
+} // namespace saucer
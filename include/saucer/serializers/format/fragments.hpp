@@ -0,0 +1,51 @@
+#pragma once
+
+#include <span>
+#include <array>
+#include <format>
+
+#include <string>
+#include <string_view>
+
+namespace saucer
+{
+    // A format string that is split into literal and argument segments at compile time, so formatting only has to concatenate
+    template <typename... Ts>
+    struct fragments
+    {
+        struct segment
+        {
+            std::size_t offset;
+            std::size_t size;
+            std::size_t arg;
+        };
+
+      public:
+        static constexpr auto capacity = 32uz;
+        static constexpr auto literal  = ~std::size_t{0};
+
+      private:
+        std::string_view m_str;
+        std::size_t m_count{0};
+        std::size_t m_literals{0};
+        bool m_fallback{false};
+        std::array<segment, capacity> m_segments{};
+
+      public:
+        template <typename T>
+            requires std::convertible_to<const T &, std::string_view>
+        consteval fragments(const T &);
+
+      public:
+        [[nodiscard]] constexpr std::string_view get() const;
+
+      public:
+        [[nodiscard]] std::string format(std::span<const std::string, sizeof...(Ts)>, std::string_view prefix = {},
+                                         std::string_view suffix = {}) const;
+
+      private:
+        consteval void push(segment);
+    };
+} // namespace saucer
+
+#include "fragments.inl"
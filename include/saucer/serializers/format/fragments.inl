@@ -0,0 +1,146 @@
+#pragma once
+
+#include "fragments.hpp"
+
+#include <utility>
+
+namespace saucer
+{
+    template <typename... Ts>
+    template <typename T>
+        requires std::convertible_to<const T &, std::string_view>
+    consteval fragments<Ts...>::fragments(const T &str) : m_str(str)
+    {
+        [[maybe_unused]] const auto validated = std::format_string<Ts...>{str};
+
+        auto next  = 0uz;
+        auto start = 0uz;
+
+        for (auto i = 0uz; m_str.size() > i; i++)
+        {
+            const auto current = m_str[i];
+
+            if (current != '{' && current != '}')
+            {
+                continue;
+            }
+
+            // Escaped braces keep the first of the pair as part of the literal and skip the second one
+            if (current == '}' || m_str[i + 1] == '{')
+            {
+                push({.offset = start, .size = i + 1 - start, .arg = literal});
+                start = ++i + 1;
+                continue;
+            }
+
+            push({.offset = start, .size = i - start, .arg = literal});
+
+            const auto end = m_str.find('}', i);
+            const auto id  = m_str.substr(i + 1, end - i - 1);
+
+            auto index = next++;
+
+            if (!id.empty())
+            {
+                index = 0;
+
+                for (const auto digit : id)
+                {
+                    if (digit < '0' || digit > '9')
+                    {
+                        // Replacement fields with format specs are left to `std::format`
+                        m_fallback = true;
+                        break;
+                    }
+
+                    index = (index * 10) + static_cast<std::size_t>(digit - '0');
+                }
+            }
+
+            push({.offset = 0, .size = 0, .arg = index});
+            start = (i = end) + 1;
+        }
+
+        push({.offset = start, .size = m_str.size() - start, .arg = literal});
+    }
+
+    template <typename... Ts>
+    consteval void fragments<Ts...>::push(segment value)
+    {
+        if (value.arg == literal && value.size == 0)
+        {
+            return;
+        }
+
+        if (m_count == capacity)
+        {
+            m_fallback = true;
+            return;
+        }
+
+        if (value.arg == literal)
+        {
+            m_literals += value.size;
+        }
+
+        m_segments[m_count++] = value;
+    }
+
+    template <typename... Ts>
+    constexpr std::string_view fragments<Ts...>::get() const
+    {
+        return m_str;
+    }
+
+    template <typename... Ts>
+    std::string fragments<Ts...>::format(std::span<const std::string, sizeof...(Ts)> args, std::string_view prefix,
+                                         std::string_view suffix) const
+    {
+        std::string rtn;
+
+        if (m_fallback) [[unlikely]]
+        {
+            auto unpack = [&]<std::size_t... Is>(std::index_sequence<Is...>)
+            {
+                return std::vformat(m_str, std::make_format_args(args[Is]...));
+            };
+
+            auto formatted = unpack(std::index_sequence_for<Ts...>());
+
+            rtn.reserve(prefix.size() + formatted.size() + suffix.size());
+            rtn.append(prefix).append(formatted).append(suffix);
+
+            return rtn;
+        }
+
+        auto size = prefix.size() + m_literals + suffix.size();
+
+        for (auto i = 0uz; m_count > i; i++)
+        {
+            if (const auto &current = m_segments[i]; current.arg != literal)
+            {
+                size += args[current.arg].size();
+            }
+        }
+
+        rtn.reserve(size);
+        rtn.append(prefix);
+
+        for (auto i = 0uz; m_count > i; i++)
+        {
+            const auto &current = m_segments[i];
+
+            if (current.arg == literal)
+            {
+                rtn.append(m_str.substr(current.offset, current.size));
+                continue;
+            }
+
+            rtn.append(args[current.arg]);
+        }
+
+        rtn.append(suffix);
+
+        return rtn;
+    }
+} // namespace saucer
@@ -8,7 +8,12 @@ namespace saucer::serializers::glaze
 {
     struct function_data : saucer::function_data
     {
-        glz::raw_json params;
+        glz::raw_json_view params;
+        std::string storage;
+
+      public:
+        void own() override;
+        [[nodiscard]] std::string_view raw() const override;
     };
 
     struct result_data : saucer::result_data
@@ -39,6 +44,9 @@ namespace saucer::serializers::glaze
         template <Writable T>
         static std::string write(T &&);
 
+        template <Writable T>
+        static void append(T &&, std::string &);
+
         template <Readable T>
         static result<T> read(std::string_view);
 
@@ -9,7 +9,8 @@ namespace saucer::serializers::glaze
 {
     namespace detail
     {
-        static constexpr auto opts = glz::opts{.error_on_missing_keys = true};
+        static constexpr auto opts              = glz::opts{.error_on_missing_keys = true};
+        static constexpr auto retained_capacity = std::size_t{1024} * 1024;
 
         template <typename T>
         auto try_parse(T &value, const glz::generic &data)
@@ -53,7 +54,29 @@ namespace saucer::serializers::glaze
     template <Writable T>
     std::string serializer::write(T &&value)
     {
-        return glz::write<detail::opts>(std::forward<T>(value)).value_or("null");
+        std::string rtn;
+        append(std::forward<T>(value), rtn);
+
+        return rtn;
+    }
+
+    template <Writable T>
+    void serializer::append(T &&value, std::string &out)
+    {
+        static thread_local std::string buffer;
+
+        if (glz::write<detail::opts>(std::forward<T>(value), buffer))
+        {
+            out += "null";
+            return;
+        }
+
+        out += buffer;
+
+        if (buffer.capacity() > detail::retained_capacity)
+        {
+            buffer = {};
+        }
     }
 
     template <Readable T>
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "../serializer.hpp"
+
+#include <simdjson.h>
+
+namespace saucer::serializers::ondemand
+{
+    namespace detail
+    {
+        template <typename T>
+        struct reader;
+
+        template <typename T>
+        struct writer;
+    } // namespace detail
+
+    template <typename T>
+    concept Readable = requires(simdjson::ondemand::value &value, std::remove_cvref_t<T> &out) {
+        { detail::reader<std::remove_cvref_t<T>>::read(value, out) } -> std::same_as<simdjson::error_code>;
+    };
+
+    template <typename T>
+    concept Writable = requires(const std::remove_cvref_t<T> &value, std::string &out) {
+        { detail::writer<std::remove_cvref_t<T>>::write(value, out) };
+    };
+
+    struct function_data : saucer::function_data
+    {
+        std::string storage;
+        std::string_view params;
+
+      public:
+        [[nodiscard]] std::string_view raw() const override;
+    };
+
+    struct result_data : saucer::result_data
+    {
+        std::string storage;
+        std::string_view result;
+    };
+
+    // Keeps the raw json of a value around and only parses the parts that are actually asked for.
+    // Copies share their state, which is not synchronized.
+    struct document
+    {
+        struct state;
+
+      private:
+        std::shared_ptr<state> m_state;
+
+      public:
+        document();
+        explicit document(std::string_view json);
+
+      public:
+        [[nodiscard]] bool empty() const;
+        [[nodiscard]] std::string_view raw() const;
+
+      public:
+        template <Readable T>
+        [[nodiscard]] serializer_core::result<T> as() const;
+
+        template <Readable T>
+        [[nodiscard]] serializer_core::result<T> at(std::string_view pointer) const;
+
+      public:
+        [[nodiscard]] bool contains(std::string_view pointer) const;
+    };
+
+    struct serializer : saucer::serializer<serializer>
+    {
+        using result_data   = ondemand::result_data;
+        using function_data = ondemand::function_data;
+
+      public:
+        ~serializer() override;
+
+      public:
+        [[nodiscard]] std::string script() const override;
+        [[nodiscard]] std::string js_serializer() const override;
+        [[nodiscard]] parse_result parse(std::string_view) const override;
+
+      public:
+        template <Writable T>
+        static std::string write(T &&);
+
+        template <Writable T>
+        static void append(T &&, std::string &);
+
+        template <Readable T>
+        static result<T> read(std::string_view);
+
+      public:
+        template <Readable T>
+        static result<T> read(const result_data &);
+
+        template <Readable T>
+        static result<T> read(const function_data &);
+    };
+} // namespace saucer::serializers::ondemand
+
+#include "ondemand.inl"
@@ -0,0 +1,600 @@
+#pragma once
+
+#include "ondemand.hpp"
+
+#include <rebind/name.hpp>
+
+#include <map>
+#include <array>
+#include <tuple>
+#include <vector>
+#include <ranges>
+#include <limits>
+#include <utility>
+#include <optional>
+#include <charconv>
+#include <unordered_map>
+
+namespace saucer::serializers::ondemand
+{
+    struct document::state
+    {
+        std::string json;
+        std::size_t size;
+
+      public:
+        simdjson::ondemand::parser parser;
+        simdjson::ondemand::document root;
+
+      public:
+        bool iterated{false};
+        simdjson::error_code error{simdjson::SUCCESS};
+
+      public:
+        simdjson::error_code rewind();
+    };
+
+    namespace detail
+    {
+        // simdjson reads past the end of its input, so every buffer we hand to it is over-allocated
+        void pad(std::string_view, std::string &);
+        std::size_t capacity(std::string_view, const std::string &storage);
+
+        simdjson::ondemand::parser &parser();
+
+        template <typename T>
+        struct is_optional : std::false_type
+        {
+        };
+
+        template <typename T>
+        struct is_optional<std::optional<T>> : std::true_type
+        {
+        };
+
+        template <typename T>
+        struct is_sequence : std::false_type
+        {
+        };
+
+        template <typename... Ts>
+        struct is_sequence<std::tuple<Ts...>> : std::bool_constant<(Readable<Ts> && ...)>
+        {
+        };
+
+        template <typename T, std::size_t N>
+        struct is_sequence<std::array<T, N>> : std::bool_constant<Readable<T>>
+        {
+        };
+
+        template <typename T>
+        concept String = std::convertible_to<T, std::string_view>;
+
+        template <typename T>
+        concept Map = std::ranges::input_range<T> && requires { typename T::mapped_type; } &&
+                      String<typename T::key_type> && Writable<typename T::mapped_type>;
+
+        template <typename T>
+        concept Range = std::ranges::input_range<T> && not String<T> && not Map<T> && Writable<std::ranges::range_value_t<T>>;
+
+        template <typename T, typename Source>
+        simdjson::error_code read(Source &source, T &out)
+        {
+            return reader<T>::read(source, out);
+        }
+
+        template <>
+        struct reader<bool>
+        {
+            static simdjson::error_code read(auto &source, bool &out)
+            {
+                return source.get_bool().get(out);
+            }
+        };
+
+        template <typename T>
+            requires std::is_integral_v<T> && (not std::same_as<T, bool>)
+        struct reader<T>
+        {
+            using wide = std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>;
+
+          public:
+            static simdjson::error_code read(auto &source, T &out)
+            {
+                wide value{};
+                auto error = simdjson::SUCCESS;
+
+                if constexpr (std::is_signed_v<T>)
+                {
+                    error = source.get_int64().get(value);
+                }
+                else
+                {
+                    error = source.get_uint64().get(value);
+                }
+
+                if (error)
+                {
+                    return error;
+                }
+
+                if (!std::in_range<T>(value))
+                {
+                    return simdjson::NUMBER_OUT_OF_RANGE;
+                }
+
+                out = static_cast<T>(value);
+
+                return simdjson::SUCCESS;
+            }
+        };
+
+        template <typename T>
+            requires std::is_floating_point_v<T>
+        struct reader<T>
+        {
+            static simdjson::error_code read(auto &source, T &out)
+            {
+                double value{};
+
+                if (auto error = source.get_double().get(value); error)
+                {
+                    return error;
+                }
+
+                out = static_cast<T>(value);
+
+                return simdjson::SUCCESS;
+            }
+        };
+
+        template <>
+        struct reader<std::string>
+        {
+            static simdjson::error_code read(auto &source, std::string &out)
+            {
+                std::string_view value{};
+
+                if (auto error = source.get_string().get(value); error)
+                {
+                    return error;
+                }
+
+                out.assign(value);
+
+                return simdjson::SUCCESS;
+            }
+        };
+
+        template <>
+        struct reader<document>
+        {
+            static simdjson::error_code read(auto &source, document &out)
+            {
+                std::string_view value{};
+
+                if (auto error = source.raw_json().get(value); error)
+                {
+                    return error;
+                }
+
+                out = document{value.substr(0, value.find_last_not_of(" \t\r\n") + 1)};
+
+                return simdjson::SUCCESS;
+            }
+        };
+
+        template <Readable T>
+        struct reader<std::optional<T>>
+        {
+            static simdjson::error_code read(auto &source, std::optional<T> &out)
+            {
+                bool null{};
+
+                if (auto error = source.is_null().get(null); error)
+                {
+                    return error;
+                }
+
+                if (null)
+                {
+                    out.reset();
+                    return simdjson::SUCCESS;
+                }
+
+                return detail::read(source, out.emplace());
+            }
+        };
+
+        template <Readable T>
+        struct reader<std::vector<T>>
+        {
+            static simdjson::error_code read(auto &source, std::vector<T> &out)
+            {
+                simdjson::ondemand::array array;
+
+                if (auto error = source.get_array().get(array); error)
+                {
+                    return error;
+                }
+
+                out.clear();
+
+                for (auto element : array)
+                {
+                    simdjson::ondemand::value value;
+
+                    if (auto error = element.get(value); error)
+                    {
+                        return error;
+                    }
+
+                    // Going through a temporary keeps `std::vector<bool>` working, it has no references to hand out
+                    T item{};
+
+                    if (auto error = detail::read(value, item); error)
+                    {
+                        return error;
+                    }
+
+                    out.push_back(std::move(item));
+                }
+
+                return simdjson::SUCCESS;
+            }
+        };
+
+        template <typename T>
+            requires is_sequence<T>::value
+        struct reader<T>
+        {
+            static constexpr auto size = std::tuple_size_v<T>;
+
+          public:
+            static simdjson::error_code read(auto &source, T &out)
+            {
+                simdjson::ondemand::array array;
+
+                if (auto error = source.get_array().get(array); error)
+                {
+                    return error;
+                }
+
+                auto index = 0uz;
+
+                for (auto element : array)
+                {
+                    simdjson::ondemand::value value;
+
+                    if (auto error = element.get(value); error)
+                    {
+                        return error;
+                    }
+
+                    if (index >= size)
+                    {
+                        return simdjson::INCORRECT_TYPE;
+                    }
+
+                    auto error = simdjson::SUCCESS;
+
+                    auto visit = [&]<std::size_t... Is>(std::index_sequence<Is...>)
+                    {
+                        std::ignore = ((index == Is && (error = detail::read(value, std::get<Is>(out)), true)) || ...);
+                    };
+                    visit(std::make_index_sequence<size>());
+
+                    if (error)
+                    {
+                        return error;
+                    }
+
+                    index++;
+                }
+
+                return index == size ? simdjson::SUCCESS : simdjson::INCORRECT_TYPE;
+            }
+        };
+
+        template <typename T>
+            requires(Readable<typename T::mapped_type> &&
+                     (std::same_as<T, std::map<std::string, typename T::mapped_type>> ||
+                      std::same_as<T, std::unordered_map<std::string, typename T::mapped_type>>))
+        struct reader<T>
+        {
+            static simdjson::error_code read(auto &source, T &out)
+            {
+                simdjson::ondemand::object object;
+
+                if (auto error = source.get_object().get(object); error)
+                {
+                    return error;
+                }
+
+                out.clear();
+
+                for (auto field : object)
+                {
+                    std::string_view key{};
+
+                    if (auto error = field.unescaped_key().get(key); error)
+                    {
+                        return error;
+                    }
+
+                    simdjson::ondemand::value value;
+
+                    if (auto error = field.value().get(value); error)
+                    {
+                        return error;
+                    }
+
+                    if (auto error = detail::read(value, out[std::string{key}]); error)
+                    {
+                        return error;
+                    }
+                }
+
+                return simdjson::SUCCESS;
+            }
+        };
+
+        template <typename T>
+        std::string mismatch(simdjson::error_code error)
+        {
+            if constexpr (tuple::Tuple<T>)
+            {
+                return std::format("Expected parameters of type '{}': {}", rebind::type_name<T>, simdjson::error_message(error));
+            }
+            else
+            {
+                return std::format("Expected value of type '{}': {}", rebind::type_name<T>, simdjson::error_message(error));
+            }
+        }
+
+        template <typename T>
+        serializer_core::result<T> parse(std::string_view json, std::size_t capacity)
+        {
+            auto parsed = parser().iterate(json, capacity);
+
+            simdjson::ondemand::document root;
+
+            if (auto error = std::move(parsed).get(root); error)
+            {
+                return std::unexpected{mismatch<T>(error)};
+            }
+
+            T rtn{};
+
+            if (auto error = detail::read(root, rtn); error)
+            {
+                return std::unexpected{mismatch<T>(error)};
+            }
+
+            if (!root.at_end())
+            {
+                return std::unexpected{mismatch<T>(simdjson::TRAILING_CONTENT)};
+            }
+
+            return rtn;
+        }
+
+        void escape(std::string_view, std::string &);
+
+        template <>
+        struct writer<bool>
+        {
+            static void write(bool value, std::string &out)
+            {
+                out += value ? "true" : "false";
+            }
+        };
+
+        template <typename T>
+            requires std::is_arithmetic_v<T> && (not std::same_as<T, bool>)
+        struct writer<T>
+        {
+            static void write(T value, std::string &out)
+            {
+                if constexpr (std::is_floating_point_v<T>)
+                {
+                    if (value != value || value == std::numeric_limits<T>::infinity() || value == -std::numeric_limits<T>::infinity())
+                    {
+                        out += "null";
+                        return;
+                    }
+                }
+
+                std::array<char, 32> buffer{};
+                auto [end, _] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+
+                out.append(buffer.data(), end);
+            }
+        };
+
+        template <String T>
+        struct writer<T>
+        {
+            static void write(const T &value, std::string &out)
+            {
+                escape(value, out);
+            }
+        };
+
+        template <>
+        struct writer<document>
+        {
+            static void write(const document &value, std::string &out)
+            {
+                out += value.empty() ? "null" : value.raw();
+            }
+        };
+
+        template <>
+        struct writer<std::nullptr_t>
+        {
+            static void write(std::nullptr_t, std::string &out)
+            {
+                out += "null";
+            }
+        };
+
+        template <typename T>
+            requires is_optional<T>::value && Writable<typename T::value_type>
+        struct writer<T>
+        {
+            static void write(const T &value, std::string &out)
+            {
+                if (!value.has_value())
+                {
+                    out += "null";
+                    return;
+                }
+
+                writer<std::remove_cvref_t<typename T::value_type>>::write(*value, out);
+            }
+        };
+
+        template <Range T>
+        struct writer<T>
+        {
+            static void write(const T &value, std::string &out)
+            {
+                out += '[';
+
+                for (auto first = true; const auto &element : value)
+                {
+                    if (!std::exchange(first, false))
+                    {
+                        out += ',';
+                    }
+
+                    writer<std::remove_cvref_t<decltype(element)>>::write(element, out);
+                }
+
+                out += ']';
+            }
+        };
+
+        template <Map T>
+        struct writer<T>
+        {
+            static void write(const T &value, std::string &out)
+            {
+                out += '{';
+
+                for (auto first = true; const auto &[key, element] : value)
+                {
+                    if (!std::exchange(first, false))
+                    {
+                        out += ',';
+                    }
+
+                    escape(key, out);
+                    out += ':';
+
+                    writer<std::remove_cvref_t<decltype(element)>>::write(element, out);
+                }
+
+                out += '}';
+            }
+        };
+
+        template <tuple::Tuple T>
+            requires(not Range<T>)
+        struct writer<T>
+        {
+            static void write(const T &value, std::string &out)
+            {
+                out += '[';
+
+                auto unpack = [&]<std::size_t... Is>(std::index_sequence<Is...>)
+                {
+                    ((out += Is == 0 ? "" : ",", writer<std::remove_cvref_t<std::tuple_element_t<Is, T>>>::write(std::get<Is>(value), out)), ...);
+                };
+                unpack(std::make_index_sequence<std::tuple_size_v<T>>());
+
+                out += ']';
+            }
+        };
+    } // namespace detail
+
+    template <Readable T>
+    serializer_core::result<T> document::as() const
+    {
+        if (auto error = m_state ? m_state->rewind() : simdjson::EMPTY; error)
+        {
+            return std::unexpected{detail::mismatch<T>(error)};
+        }
+
+        T rtn{};
+
+        if (auto error = detail::read(m_state->root, rtn); error)
+        {
+            return std::unexpected{detail::mismatch<T>(error)};
+        }
+
+        return rtn;
+    }
+
+    template <Readable T>
+    serializer_core::result<T> document::at(std::string_view pointer) const
+    {
+        if (auto error = m_state ? m_state->rewind() : simdjson::EMPTY; error)
+        {
+            return std::unexpected{detail::mismatch<T>(error)};
+        }
+
+        simdjson::ondemand::value value;
+
+        if (auto error = m_state->root.at_pointer(pointer).get(value); error)
+        {
+            return std::unexpected{detail::mismatch<T>(error)};
+        }
+
+        T rtn{};
+
+        if (auto error = detail::read(value, rtn); error)
+        {
+            return std::unexpected{detail::mismatch<T>(error)};
+        }
+
+        return rtn;
+    }
+
+    template <Writable T>
+    std::string serializer::write(T &&value)
+    {
+        std::string rtn;
+        append(std::forward<T>(value), rtn);
+
+        return rtn;
+    }
+
+    template <Writable T>
+    void serializer::append(T &&value, std::string &out)
+    {
+        detail::writer<std::remove_cvref_t<T>>::write(value, out);
+    }
+
+    template <Readable T>
+    serializer::result<T> serializer::read(std::string_view data)
+    {
+        static thread_local std::string buffer;
+        detail::pad(data, buffer);
+
+        return detail::parse<T>(std::string_view{buffer.data(), data.size()}, buffer.size());
+    }
+
+    template <Readable T>
+    serializer::result<T> serializer::read(const result_data &data)
+    {
+        return detail::parse<T>(data.result, detail::capacity(data.result, data.storage));
+    }
+
+    template <Readable T>
+    serializer::result<T> serializer::read(const function_data &data)
+    {
+        return detail::parse<T>(data.params, detail::capacity(data.params, data.storage));
+    }
+} // namespace saucer::serializers::ondemand
@@ -8,12 +8,15 @@ namespace saucer::serializers::rflpp
 {
     struct function_data : saucer::function_data
     {
-        rfl::Generic params;
+        std::string params;
+
+      public:
+        [[nodiscard]] std::string_view raw() const override;
     };
 
     struct result_data : saucer::result_data
     {
-        rfl::Generic result;
+        std::string result;
     };
 
     template <typename T>
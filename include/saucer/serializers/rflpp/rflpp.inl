@@ -31,22 +31,10 @@ namespace saucer::serializers::rflpp
             return write(std::string{std::forward<T>(value)});
         }
 
-        template <typename T, typename U>
-        auto read_impl(U &&value)
-        {
-            return rfl::json::read<T>(std::forward<U>(value));
-        }
-
-        template <typename T>
-        auto read_impl(const rfl::Generic &value)
-        {
-            return rfl::from_generic<T>(value);
-        }
-
         template <typename T, typename U>
         serializer::result<T> read(U &&value)
         {
-            auto rtn = read_impl<T>(std::forward<U>(value));
+            auto rtn = rfl::json::read<T>(std::forward<U>(value));
 
             if (!rtn.has_value())
             {
@@ -1,8 +1,11 @@
 #pragma once
 
 #include "data.hpp"
+#include "../channel.hpp"
 #include "../executor.hpp"
 
+#include "format/fragments.hpp"
+
 #include <memory>
 #include <functional>
 
@@ -33,7 +36,8 @@ namespace saucer
     struct serializer_core
     {
         using parse_result = std::variant<std::unique_ptr<function_data>, std::unique_ptr<result_data>, std::monostate>;
-        using executor     = saucer::executor<std::string_view>;
+        using executor     = saucer::executor<std::string, std::string>;
+        using channel      = saucer::channel<std::string, std::string>;
 
       public:
         template <typename T>
@@ -42,6 +46,7 @@ namespace saucer
       public:
         using resolver = std::move_only_function<void(std::unique_ptr<result_data>)>;
         using function = std::move_only_function<void(std::unique_ptr<function_data>, executor)>;
+        using producer = std::move_only_function<void(std::unique_ptr<function_data>, channel)>;
 
       public:
         virtual ~serializer_core() = default;
@@ -80,6 +85,9 @@ namespace saucer
         template <typename T>
         static auto convert(T &&);
 
+        template <typename T>
+        static auto produce(T &&);
+
         template <Readable<Interface> T>
         static auto resolve(coco::promise<result<T>>);
 
@@ -89,7 +97,7 @@ namespace saucer
     };
 
     template <Serializer Serializer, typename... Ts>
-    using format_string = std::format_string<std::enable_if_t<Writable<Ts, Serializer>, std::string>...>;
+    using format_string = fragments<std::enable_if_t<Writable<Ts, Serializer>, std::string>...>;
 } // namespace saucer
 
 #include "serializer.inl"
@@ -3,12 +3,19 @@
 #include "serializer.hpp"
 
 #include "format/args.hpp"
+#include "format/cached.hpp"
 #include "format/unquoted.hpp"
 
+#include "../error/error.hpp"
 #include "../utils/tuple.hpp"
 #include "../traits/traits.hpp"
 
+#include <span>
 #include <ranges>
+#include <cstdint>
+#include <utility>
+#include <optional>
+#include <filesystem>
 
 namespace saucer
 {
@@ -22,19 +29,29 @@ namespace saucer
         {
         };
 
+        template <typename T>
+        struct is_cached : std::false_type
+        {
+        };
+
+        template <typename T>
+        struct is_cached<cached<T>> : std::true_type
+        {
+        };
+
         template <typename T, typename Interface>
         concept Writable = requires(T value) {
             { Interface::write(value) } -> std::same_as<std::string>;
         };
 
         template <typename T, typename Interface>
-            requires Writable<T, Interface>
+            requires(Writable<T, Interface> && not is_cached<std::remove_cvref_t<T>>::value)
         struct is_writable<T, Interface> : std::true_type
         {
         };
 
         template <typename... Ts, typename Interface>
-            requires(Writable<Ts, Interface> && ...)
+            requires((Writable<Ts, Interface> || is_cached<std::remove_cvref_t<Ts>>::value) && ...)
         struct is_writable<arguments<Ts...>, Interface> : std::true_type
         {
         };
@@ -44,6 +61,12 @@ namespace saucer
         {
         };
 
+        template <typename T, typename Interface>
+            requires is_cached<std::remove_cvref_t<T>>::value
+        struct is_writable<T, Interface> : std::true_type
+        {
+        };
+
         template <typename T, typename Interface, typename Buffer>
         struct is_readable : std::false_type
         {
@@ -75,6 +98,46 @@ namespace saucer
         {
         };
 
+        template <typename T>
+        struct is_span : std::false_type
+        {
+        };
+
+        template <typename T>
+            requires std::is_arithmetic_v<T>
+        struct is_span<std::span<const T>> : std::true_type
+        {
+        };
+
+        template <typename T>
+        concept Binary = std::same_as<T, stash> || is_span<T>::value;
+
+        template <typename T>
+        concept Path = std::same_as<T, std::filesystem::path>;
+
+        template <typename T>
+        struct has_buffers : std::false_type
+        {
+        };
+
+        template <typename... Ts>
+        struct has_buffers<std::tuple<Ts...>> : std::bool_constant<((Binary<Ts> || Path<Ts>) || ...)>
+        {
+        };
+
+        template <typename T>
+        struct has_spans : std::false_type
+        {
+        };
+
+        template <typename... Ts>
+        struct has_spans<std::tuple<Ts...>> : std::bool_constant<(is_span<Ts>::value || ...)>
+        {
+        };
+
+        template <typename T>
+        using buffer_slot_t = std::conditional_t<Binary<T> || Path<T>, std::size_t, T>;
+
         template <typename Interface, typename T>
         struct reader
         {
@@ -94,6 +157,90 @@ namespace saucer
             }
         };
 
+        template <typename Interface, tuple::Tuple T>
+            requires has_buffers<T>::value
+        struct reader<Interface, T>
+        {
+            static result<T> read(const auto &value)
+            {
+                using slots = tuple::transform_t<T, buffer_slot_t>;
+                auto parsed = Interface::template read<slots>(value);
+
+                if (!parsed.has_value())
+                {
+                    return std::unexpected{std::move(parsed.error())};
+                }
+
+                std::optional<std::string> error;
+
+                auto convert = [&]<std::size_t I>() -> std::tuple_element_t<I, T>
+                {
+                    using current = std::tuple_element_t<I, T>;
+                    auto &slot    = std::get<I>(*parsed);
+
+                    if constexpr (std::same_as<current, stash>)
+                    {
+                        if (slot < value.buffers.size())
+                        {
+                            return value.buffers[slot];
+                        }
+
+                        error.emplace(std::format("Expected parameter {} to be binary", I));
+                        return stash::empty();
+                    }
+                    else if constexpr (is_span<current>::value)
+                    {
+                        using element = current::element_type;
+
+                        if (slot < value.buffers.size())
+                        {
+                            const auto &buffer = value.buffers[slot];
+                            const auto *data   = buffer.data();
+
+                            const auto sized   = buffer.size() % sizeof(element) == 0;
+                            const auto aligned = reinterpret_cast<std::uintptr_t>(data) % alignof(element) == 0;
+
+                            if (sized && aligned)
+                            {
+                                return current{reinterpret_cast<element *>(data), buffer.size() / sizeof(element)};
+                            }
+                        }
+
+                        error.emplace(std::format("Expected parameter {} to be a typed array", I));
+                        return current{};
+                    }
+                    else if constexpr (Path<current>)
+                    {
+                        if (slot < value.files.size())
+                        {
+                            return value.files[slot];
+                        }
+
+                        error.emplace(std::format("Expected parameter {} to be a file", I));
+                        return current{};
+                    }
+                    else
+                    {
+                        return std::move(slot);
+                    }
+                };
+
+                auto unpack = [&]<std::size_t... Is>(std::index_sequence<Is...>)
+                {
+                    return T{convert.template operator()<Is>()...};
+                };
+
+                auto rtn = unpack(std::make_index_sequence<std::tuple_size_v<T>>());
+
+                if (error.has_value())
+                {
+                    return std::unexpected{std::move(*error)};
+                }
+
+                return rtn;
+            }
+        };
+
         template <typename Interface>
         struct reader<Interface, void>
         {
@@ -115,6 +262,13 @@ namespace saucer
             return Interface::template write<T>(std::forward<T>(value));
         }
 
+        template <typename Interface, typename T>
+            requires is_cached<std::remove_cvref_t<T>>::value
+        std::string write(T &&value)
+        {
+            return value.template serialize<Interface>();
+        }
+
         template <typename Interface>
         std::string write(unquoted_t &&value) // NOLINT(*-not-moved)
         {
@@ -128,20 +282,108 @@ namespace saucer
             return {};
         }
 
+        template <typename Interface, typename T>
+        void append(std::string &out, T &&value)
+        {
+            if constexpr (requires { Interface::append(std::forward<T>(value), out); })
+            {
+                Interface::append(std::forward<T>(value), out);
+            }
+            else
+            {
+                out += write<Interface>(std::forward<T>(value));
+            }
+        }
+
         template <typename Interface, typename... Ts>
         std::string write(arguments<Ts...> value)
         {
-            std::vector<std::string> rtn;
-            rtn.reserve(sizeof...(Ts));
+            std::string rtn;
+            auto first = true;
+
+            auto next = [&]<typename U>(U &&arg)
+            {
+                if (!std::exchange(first, false))
+                {
+                    rtn += ',';
+                }
+
+                append<Interface>(rtn, std::forward<U>(arg));
+            };
 
             auto unpack = [&]<typename... Us>(Us &&...args)
             {
-                (rtn.emplace_back(write<Interface>(std::forward<Us>(args))), ...);
+                (next(std::forward<Us>(args)), ...);
             };
             std::apply(unpack, std::move(value.tuple));
 
-            return rtn | std::views::join_with(',') | std::ranges::to<std::string>();
+            return rtn;
+        }
+
+        template <typename Interface, typename T, typename Args>
+        void dispatch(T &callable, Args &&args, serializer_core::executor &exec)
+#if defined(__cpp_exceptions) && !defined(SAUCER_NO_EXCEPTIONS)
+        try
+#endif
+        {
+            using result = decltype(std::apply(callable, std::forward<Args>(args)));
+
+            if constexpr (std::is_void_v<result>)
+            {
+                std::apply(callable, std::forward<Args>(args));
+
+                if (exec.cancelled())
+                {
+                    return;
+                }
+
+                exec.resolve(write<Interface>());
+            }
+            else if constexpr (Expected<std::remove_cvref_t<result>>)
+            {
+                auto rtn = std::apply(callable, std::forward<Args>(args));
+
+                if (exec.cancelled())
+                {
+                    return;
+                }
+
+                if (!rtn.has_value())
+                {
+                    return exec.reject(write<Interface>(std::move(rtn).error()));
+                }
+
+                if constexpr (std::is_void_v<typename std::remove_cvref_t<result>::value_type>)
+                {
+                    exec.resolve(write<Interface>());
+                }
+                else
+                {
+                    exec.resolve(write<Interface>(*std::move(rtn)));
+                }
+            }
+            else
+            {
+                decltype(auto) rtn = std::apply(callable, std::forward<Args>(args));
+
+                if (exec.cancelled())
+                {
+                    return;
+                }
+
+                exec.resolve(write<Interface>(std::forward<result>(rtn)));
+            }
+        }
+#if defined(__cpp_exceptions) && !defined(SAUCER_NO_EXCEPTIONS)
+        catch (std::exception &ex)
+        {
+            exec.reject(write<Interface>(ex.what()));
+        }
+        catch (...)
+        {
+            exec.reject(write<Interface>("Unknown Exception"));
         }
+#endif
     } // namespace detail
 
     template <typename Interface>
@@ -163,53 +405,141 @@ namespace saucer
 
         static_assert(transformer::valid, "Could not transform callable. Please refer to the documentation on how to expose functions!");
 
-        return [converted = transformer{std::forward<T>(callable)}](std::unique_ptr<function_data> data,
-                                                                    serializer_core::executor exec) mutable
+        if constexpr (traits::direct<std::remove_cvref_t<T>, args>::value)
         {
-            const auto &message = *static_cast<Interface::function_data *>(data.get());
-            auto parsed         = reader::read(message);
-
-            if (!parsed.has_value())
+            return [callable = std::forward<T>(callable)](std::unique_ptr<function_data> data, serializer_core::executor exec) mutable
             {
-                return exec.reject(detail::write<Interface>(parsed.error()));
-            }
+                const auto &message = *static_cast<Interface::function_data *>(data.get());
+                auto parsed         = reader::read(message);
 
-            auto resolve = [resolve = std::move(exec.resolve)]<typename... Ts>(Ts &&...value)
-            {
-                resolve(detail::write<Interface>(std::forward<Ts>(value)...));
+                if (!parsed.has_value())
+                {
+                    return exec.reject(detail::write<Interface>(parsed.error()));
+                }
+
+                detail::dispatch<Interface>(callable, std::move(*parsed), exec);
             };
+        }
+        else
+        {
+            static_assert(not detail::has_spans<args>::value, "std::span parameters require a synchronous function");
 
-#if defined(__cpp_exceptions) && !defined(SAUCER_NO_EXCEPTIONS)
-            auto except = [reject = exec.reject](const std::exception_ptr &ptr)
+            return [converted = transformer{std::forward<T>(callable)}](std::unique_ptr<function_data> data,
+                                                                        serializer_core::executor exec) mutable
             {
-                try
+                const auto &message = *static_cast<Interface::function_data *>(data.get());
+                auto parsed         = reader::read(message);
+
+                if (!parsed.has_value())
                 {
-                    std::rethrow_exception(ptr);
+                    return exec.reject(detail::write<Interface>(parsed.error()));
                 }
-                catch (std::exception &ex)
+
+                // Results of cancelled calls are dropped before they are serialized, the page has already given up on them
+                auto resolve = [resolve = std::move(exec.resolve), token = exec.token]<typename... Ts>(Ts &&...value)
                 {
-                    reject(detail::write<Interface>(ex.what()));
-                }
-                catch (...)
+                    if (token && token->load(std::memory_order_relaxed))
+                    {
+                        return;
+                    }
+
+                    resolve(detail::write<Interface>(std::forward<Ts>(value)...));
+                };
+
+                // The rejection path is shared with the exception handler, which the transformer may copy
+                auto failure = std::make_shared<decltype(exec.reject)>(std::move(exec.reject));
+
+#if defined(__cpp_exceptions) && !defined(SAUCER_NO_EXCEPTIONS)
+                auto except = [failure](const std::exception_ptr &ptr)
                 {
-                    reject(detail::write<Interface>("Unknown Exception"));
-                }
-            };
+                    try
+                    {
+                        std::rethrow_exception(ptr);
+                    }
+                    catch (std::exception &ex)
+                    {
+                        (*failure)(detail::write<Interface>(ex.what()));
+                    }
+                    catch (...)
+                    {
+                        (*failure)(detail::write<Interface>("Unknown Exception"));
+                    }
+                };
+#endif
+
+                auto reject = [failure = std::move(failure), token = exec.token]<typename... Ts>(Ts &&...value)
+                {
+                    if (token && token->load(std::memory_order_relaxed))
+                    {
+                        return;
+                    }
+
+                    (*failure)(detail::write<Interface>(std::forward<Ts>(value)...));
+                };
+
+                auto transformed_exec = executor{std::move(resolve), std::move(reject), exec.token};
+                auto params           = std::tuple_cat(
+#if defined(__cpp_exceptions) && !defined(SAUCER_NO_EXCEPTIONS)
+                    std::make_tuple(std::move(except)),
 #endif
+                    std::move(*parsed), std::make_tuple(std::move(transformed_exec)));
+
+                std::apply(converted, std::move(params));
+            };
+        }
+    }
+
+    template <typename Interface>
+    template <typename T>
+    auto serializer<Interface>::produce(T &&callable) // NOLINT(*-std-forward)
+    {
+        using producer = traits::producer<T>;
+
+        using args    = producer::args;
+        using channel = producer::channel;
+        using reader  = detail::reader<Interface, args>;
+
+        static_assert(producer::valid, "Producers should take a `saucer::channel` as their last parameter");
+        static_assert(not detail::has_spans<args>::value, "std::span parameters require a synchronous function");
 
-            auto reject = [reject = std::move(exec.reject)]<typename... Ts>(Ts &&...value)
+        return [callable = std::forward<T>(callable)](std::unique_ptr<function_data> data, serializer_core::channel output) mutable
+        {
+            const auto &message = *static_cast<Interface::function_data *>(data.get());
+            auto parsed         = reader::read(message);
+
+            if (!parsed.has_value())
+            {
+                return output.reject(detail::write<Interface>(parsed.error()));
+            }
+
+            auto push = [push = std::move(output.push)]<typename U>(U &&value)
+            {
+                return push(detail::write<Interface>(std::forward<U>(value)));
+            };
+
+            auto reject = [reject = output.reject]<typename U>(U &&value)
             {
-                reject(detail::write<Interface>(std::forward<Ts>(value)...));
+                reject(detail::write<Interface>(std::forward<U>(value)));
             };
 
-            auto transformed_exec = executor{std::move(resolve), std::move(reject)};
-            auto params           = std::tuple_cat(
+            auto params = std::tuple_cat(std::move(*parsed), std::make_tuple(channel{std::move(push), reject, output.close}));
+
 #if defined(__cpp_exceptions) && !defined(SAUCER_NO_EXCEPTIONS)
-                std::make_tuple(std::move(except)),
+            try
+            {
+                std::apply(callable, std::move(params));
+            }
+            catch (std::exception &ex)
+            {
+                reject(ex.what());
+            }
+            catch (...)
+            {
+                reject("Unknown Exception");
+            }
+#else
+            std::apply(callable, std::move(params));
 #endif
-                std::move(*parsed), std::make_tuple(std::move(transformed_exec)));
-
-            std::apply(converted, std::move(params));
         };
     }
 
@@ -222,6 +552,11 @@ namespace saucer
 
         return [promise = std::move(promise)](std::unique_ptr<result_data> data) mutable
         {
+            if (!data)
+            {
+                return promise.set_value(std::unexpected{std::string{"Evaluation was cancelled"}});
+            }
+
             const auto &res = *static_cast<Interface::result_data *>(data.get());
 
             if (!res.exception) [[likely]]
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <span>
+#include <memory>
+#include <cstdint>
+
+namespace saucer
+{
+    struct shared_buffer
+    {
+        struct impl;
+
+      private:
+        std::shared_ptr<impl> m_impl;
+
+      public:
+        shared_buffer(std::shared_ptr<impl>);
+
+      public:
+        [[nodiscard]] std::span<std::uint8_t> data() const;
+        [[nodiscard]] std::size_t size() const;
+
+      public:
+        [[nodiscard]] impl *native() const;
+    };
+} // namespace saucer
@@ -1,19 +1,82 @@
 #pragma once
 
+#include "trace.hpp"
 #include "webview.hpp"
+#include "dom_patch.hpp"
+#include "asset_store.hpp"
 
 #include "config.hpp"
 #include "serializers/serializer.hpp"
 
 #include <string_view>
 
+#include <span>
 #include <memory>
 #include <string>
+#include <cstdint>
+
+#include <chrono>
+#include <optional>
+#include <functional>
 
 #include <coco/promise/promise.hpp>
 
 namespace saucer
 {
+    struct prepared
+    {
+        std::size_t id;
+        std::size_t script;
+    };
+
+    enum class limit : std::uint8_t
+    {
+        throttle,
+        debounce,
+        coalesce,
+    };
+
+    struct rate_limit
+    {
+        limit mode;
+        std::chrono::milliseconds interval{0};
+
+      public:
+        launch policy{launch::sync};
+        priority level{priority::normal};
+    };
+
+    struct memoize
+    {
+        std::size_t capacity{256};
+
+      public:
+        launch policy{launch::sync};
+        priority level{priority::normal};
+    };
+
+    struct concurrency
+    {
+        std::size_t limit{1};
+
+      public:
+        launch policy{launch::pool};
+        priority level{priority::normal};
+    };
+
+    struct ipc_compression
+    {
+        // Both directions use the zlib format (RFC 1950), which is what `CompressionStream("deflate")` produces and accepts
+        std::function<std::string(std::string_view)> compress;
+        std::function<std::optional<std::string>(std::string_view)> decompress;
+
+      public:
+        std::size_t threshold{64 * 1024};
+    };
+
+    // Receives calls to functions that are not exposed on the webview, along with the message exactly as the page sent it
+    using ipc_fallback = std::function<void(std::string_view, serializer_core::executor)>;
+
     struct smartview_base : webview
     {
         struct impl;
@@ -30,13 +93,61 @@ namespace saucer
       public:
         ~smartview_base();
 
+      public:
+        [[sc::thread_safe]] coco::future<void> destroy();
+
       protected:
-        void add_function(std::string, serializer_core::function &&);
-        void add_evaluation(serializer_core::resolver &&, std::string_view);
+        void add_function(std::string, serializer_core::function &&, launch, priority, std::size_t cache = 0,
+                          std::optional<rate_limit> limit = std::nullopt, std::size_t parallel = 0);
+        void add_producer(std::string, serializer_core::producer &&, launch, priority);
+        [[nodiscard]] std::optional<std::size_t> track_evaluation(serializer_core::resolver &&);
+        void add_invocation(serializer_core::resolver &&, prepared, std::string_view);
+        void add_emission(std::string_view, std::string);
+        void add_state(std::string);
 
       public:
         [[sc::thread_safe]] void unexpose();
         [[sc::thread_safe]] void unexpose(const std::string &name);
+
+      public:
+        [[sc::thread_safe]] [[nodiscard]] prepared prepare(std::string_view function);
+        [[sc::thread_safe]] void unprepare(prepared);
+
+      public:
+        [[sc::thread_safe]] [[nodiscard]] bool subscribed(std::string_view topic) const;
+
+      public:
+        [[sc::thread_safe]] void share(const shared_buffer &buffer, std::string_view topic);
+
+      public:
+        [[sc::thread_safe]] void patch(const dom_patch &);
+
+      public:
+        [[sc::thread_safe]] void clear_state();
+
+      public:
+        [[sc::thread_safe]] [[nodiscard]] std::size_t pending_evaluations() const;
+
+      public:
+        [[sc::thread_safe]] void set_evaluation_limit(std::optional<std::size_t> limit);
+        [[sc::thread_safe]] void set_evaluation_timeout(std::optional<std::chrono::milliseconds> timeout);
+
+      public:
+        [[sc::thread_safe]] void cancel_evaluations();
+
+      public:
+        [[sc::thread_safe]] void set_ipc_tracer(ipc_tracer tracer, std::size_t sample_rate = 1);
+
+      public:
+        // Receives every inbound message (unpacked from batches and compression) before it is parsed, see `saucer::replay`
+        [[sc::thread_safe]] void set_ipc_recorder(ipc_recorder recorder);
+
+      public:
+        // Calls that carry buffers or files are never handed to the fallback, see `saucer::remote`
+        [[sc::thread_safe]] void set_ipc_fallback(ipc_fallback fallback);
+
+      public:
+        [[sc::thread_safe]] void set_compression(std::optional<ipc_compression> options);
     };
 
     template <Serializer Serializer>
@@ -49,18 +160,48 @@ namespace saucer
 
       public:
         static result<basic_smartview> create(const options &);
+        [[sc::thread_safe]] static coco::future<result<basic_smartview>> create_async(const options &);
+
+      public:
+        template <typename T>
+        [[sc::thread_safe]] void expose(std::string name, T &&func, launch policy = launch::sync, priority level = priority::normal);
+
+        template <typename T>
+        [[sc::thread_safe]] void expose(std::string name, T &&func, memoize options);
+
+        template <typename T>
+        [[sc::thread_safe]] void expose(std::string name, T &&func, rate_limit options);
+
+        template <typename T>
+        [[sc::thread_safe]] void expose(std::string name, T &&func, concurrency options);
+
+      public:
+        template <typename T>
+        [[sc::thread_safe]] void emit(std::string_view topic, T &&value);
 
       public:
+        // Available as `saucer.state` in every document from the moment it is created, until replaced or cleared
         template <typename T>
-        [[sc::thread_safe]] void expose(std::string name, T &&func);
+        [[sc::thread_safe]] void set_state(T &&value);
 
       public:
         template <typename... Ts>
         [[sc::thread_safe]] void execute(format_string<Serializer, Ts...> code, Ts &&...params);
 
+      public:
+        template <typename... Ts>
+        [[sc::thread_safe]] static void broadcast(std::span<basic_smartview *const> webviews, format_string<Serializer, Ts...> code,
+                                                  Ts &&...params);
+
+        template <typename T>
+        [[sc::thread_safe]] static void broadcast_emit(std::span<basic_smartview *const> webviews, std::string_view topic, T &&value);
+
       public:
         template <typename R, typename... Ts>
         [[sc::thread_safe]] [[nodiscard]] auto evaluate(format_string<Serializer, Ts...> code, Ts &&...params);
+
+        template <typename R, typename... Ts>
+        [[sc::thread_safe]] [[nodiscard]] auto invoke(prepared function, Ts &&...params);
     };
 
     template <>
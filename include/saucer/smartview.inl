@@ -25,11 +25,91 @@ namespace saucer
         return basic_smartview{std::move(*base)};
     }
 
+    template <Serializer Serializer>
+    coco::future<result<basic_smartview<Serializer>>> basic_smartview<Serializer>::create_async(const options &opts)
+    {
+        auto promise = coco::promise<result<basic_smartview>>{};
+        auto rtn     = promise.get_future();
+
+        auto window = opts.window.value();
+
+        if (!window)
+        {
+            promise.set_value(err(contract_error::required_invalid));
+            return rtn;
+        }
+
+        auto task = [opts, promise = std::move(promise)]() mutable
+        {
+            promise.set_value(create(opts));
+        };
+
+        window->parent().post(std::move(task));
+
+        return rtn;
+    }
+
+    template <Serializer Serializer>
+    template <typename T>
+    void basic_smartview<Serializer>::emit(std::string_view topic, T &&value)
+    {
+        if (!subscribed(topic))
+        {
+            return;
+        }
+
+        add_emission(topic, Serializer::serialize(std::forward<T>(value)));
+    }
+
+    template <Serializer Serializer>
+    template <typename T>
+    void basic_smartview<Serializer>::set_state(T &&value)
+    {
+        add_state(Serializer::serialize(std::forward<T>(value)));
+    }
+
     template <Serializer Serializer>
     template <typename... Ts>
     void basic_smartview<Serializer>::execute(format_string<Serializer, Ts...> code, Ts &&...params)
     {
-        webview::execute(std::format(code, Serializer::serialize(std::forward<Ts>(params))...));
+        const auto args = std::array<std::string, sizeof...(Ts)>{Serializer::serialize(std::forward<Ts>(params))...};
+        webview::execute(std::make_shared<const std::string>(code.format(args)));
+    }
+
+    template <Serializer Serializer>
+    template <typename... Ts>
+    void basic_smartview<Serializer>::broadcast(std::span<basic_smartview *const> webviews, format_string<Serializer, Ts...> code,
+                                                Ts &&...params)
+    {
+        const auto args = std::array<std::string, sizeof...(Ts)>{Serializer::serialize(std::forward<Ts>(params))...};
+        auto script     = std::make_shared<const std::string>(code.format(args));
+
+        for (auto *webview : webviews)
+        {
+            webview->webview::execute(script);
+        }
+    }
+
+    template <Serializer Serializer>
+    template <typename T>
+    void basic_smartview<Serializer>::broadcast_emit(std::span<basic_smartview *const> webviews, std::string_view topic, T &&value)
+    {
+        std::optional<std::string> serialized;
+
+        for (auto *webview : webviews)
+        {
+            if (!webview->subscribed(topic))
+            {
+                continue;
+            }
+
+            if (!serialized.has_value())
+            {
+                serialized.emplace(Serializer::serialize(std::forward<T>(value)));
+            }
+
+            webview->add_emission(topic, *serialized);
+        }
     }
 
     template <Serializer Serializer>
@@ -39,19 +119,83 @@ namespace saucer
         auto promise = coco::promise<serializer_core::result<R>>{};
         auto rtn     = promise.get_future();
 
-        auto format  = std::format(code, Serializer::serialize(std::forward<Ts>(params))...);
+        const auto args = std::array<std::string, sizeof...(Ts)>{Serializer::serialize(std::forward<Ts>(params))...};
+        const auto id   = track_evaluation(Serializer::resolve(std::move(promise)));
+
+        if (!id.has_value())
+        {
+            return rtn;
+        }
+
+        auto prefix        = std::array<char, 64>{};
+        const auto written = std::format_to_n(prefix.data(), prefix.size(), "window.saucer.internal.resolve({}, async () => ", *id);
+
+        // The script is assembled with an exact reservation and handed to the backend without another copy
+        webview::execute(std::make_shared<const std::string>(code.format(args, {prefix.data(), written.out}, ")")));
+
+        return rtn;
+    }
+
+    template <Serializer Serializer>
+    template <typename R, typename... Ts>
+    auto basic_smartview<Serializer>::invoke(prepared function, Ts &&...params)
+    {
+        auto promise = coco::promise<serializer_core::result<R>>{};
+        auto rtn     = promise.get_future();
+
+        auto args    = Serializer::serialize(make_args(std::forward<Ts>(params)...));
         auto resolve = Serializer::resolve(std::move(promise));
 
-        add_evaluation(std::move(resolve), format);
+        add_invocation(std::move(resolve), function, args);
 
         return rtn;
     }
 
     template <Serializer Serializer>
     template <typename Function>
-    void basic_smartview<Serializer>::expose(std::string name, Function &&func)
+    void basic_smartview<Serializer>::expose(std::string name, Function &&func, launch policy, priority level)
+    {
+        if constexpr (traits::producer<Function>::valid)
+        {
+            auto produce = Serializer::produce(std::forward<Function>(func));
+            add_producer(std::move(name), std::move(produce), policy, level);
+        }
+        else
+        {
+            auto resolve = Serializer::convert(std::forward<Function>(func));
+            add_function(std::move(name), std::move(resolve), policy, level);
+        }
+    }
+
+    template <Serializer Serializer>
+    template <typename Function>
+    void basic_smartview<Serializer>::expose(std::string name, Function &&func, memoize options)
+    {
+        static_assert(!traits::producer<Function>::valid, "Producers stream their results and can not be memoized");
+
+        auto resolve = Serializer::convert(std::forward<Function>(func));
+        add_function(std::move(name), std::move(resolve), options.policy, options.level, options.capacity);
+    }
+
+    template <Serializer Serializer>
+    template <typename Function>
+    void basic_smartview<Serializer>::expose(std::string name, Function &&func, rate_limit options)
     {
+        static_assert(!traits::producer<Function>::valid, "Producers stream their results and can not be rate limited");
+
         auto resolve = Serializer::convert(std::forward<Function>(func));
-        add_function(std::move(name), std::move(resolve));
+        add_function(std::move(name), std::move(resolve), options.policy, options.level, 0, options);
+    }
+
+    template <Serializer Serializer>
+    template <typename Function>
+    void basic_smartview<Serializer>::expose(std::string name, Function &&func, concurrency options)
+    {
+        static_assert(!traits::producer<Function>::valid, "Producers stream their results and can not be limited in concurrency");
+
+        auto resolve        = Serializer::convert(std::forward<Function>(func));
+        const auto parallel = options.limit > 0 ? options.limit : 1;
+
+        add_function(std::move(name), std::move(resolve), options.policy, options.level, 0, std::nullopt, parallel);
     }
 } // namespace saucer
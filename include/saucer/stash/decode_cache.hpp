@@ -0,0 +1,33 @@
+#pragma once
+
+#include "stash.hpp"
+
+#include <memory>
+#include <cstddef>
+#include <functional>
+#include <string_view>
+
+namespace saucer
+{
+    class decode_cache
+    {
+        struct impl;
+
+      public:
+        using decoder = std::function<stash(const stash &compressed, std::string_view encoding)>;
+
+      private:
+        std::shared_ptr<impl> m_impl;
+
+      public:
+        decode_cache(decoder, std::size_t capacity = 16 * 1024 * 1024);
+
+      public:
+        [[nodiscard]] stash get(const stash &compressed, std::string_view encoding) const;
+
+      public:
+        [[nodiscard]] std::size_t hits() const;
+        [[nodiscard]] std::size_t misses() const;
+        [[nodiscard]] std::size_t size() const;
+    };
+} // namespace saucer
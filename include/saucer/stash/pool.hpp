@@ -0,0 +1,33 @@
+#pragma once
+
+#include "stash.hpp"
+
+#include <span>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace saucer
+{
+    class stash_pool
+    {
+        struct impl;
+
+      public:
+        using writer = std::function<std::size_t(std::span<std::uint8_t>)>;
+
+      private:
+        std::shared_ptr<impl> m_impl;
+
+      public:
+        stash_pool(std::size_t capacity = 64);
+
+      public:
+        [[nodiscard]] stash make(std::size_t size, const writer &);
+        [[nodiscard]] stash copy(std::span<const std::uint8_t>);
+
+      public:
+        [[nodiscard]] std::size_t cached() const;
+    };
+} // namespace saucer
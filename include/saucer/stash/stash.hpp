@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../error/error.hpp"
+
 #include <memory>
 #include <cstdint>
 
@@ -9,6 +11,7 @@
 #include <span>
 #include <vector>
 #include <variant>
+#include <filesystem>
 
 namespace saucer
 {
@@ -16,6 +19,17 @@ namespace saucer
     {
         template <typename T>
         struct lazy;
+
+        template <typename T>
+        struct shared
+        {
+            std::shared_ptr<const T[]> buffer;
+            std::size_t length;
+
+          public:
+            [[nodiscard]] const T *data() const { return buffer.get(); }
+            [[nodiscard]] std::size_t size() const { return length; }
+        };
     };
 
     template <typename T>
@@ -24,7 +38,8 @@ namespace saucer
         using owning_t  = std::vector<std::remove_const_t<T>>;
         using viewing_t = std::span<std::add_const_t<T>>;
         using lazy_t    = std::shared_ptr<detail::lazy<basic_stash<T>>>;
-        using variant_t = std::variant<owning_t, viewing_t, lazy_t>;
+        using shared_t  = detail::shared<T>;
+        using variant_t = std::variant<owning_t, viewing_t, lazy_t, shared_t>;
 
       private:
         variant_t m_data;
@@ -35,6 +50,18 @@ namespace saucer
       public:
         [[nodiscard]] const T *data() const;
         [[nodiscard]] std::size_t size() const;
+        [[nodiscard]] bool deferred() const;
+
+      public:
+        // Views are copied, everything else already keeps its data alive and is moved as is
+        [[nodiscard]] basic_stash owned() &&;
+
+        // Owned data is moved behind a shared pointer, so that copies and slices no longer duplicate it
+        [[nodiscard]] basic_stash share() &&;
+
+      public:
+        // Slices keep the stash they were taken from alive, only owned stashes copy the range
+        [[nodiscard]] basic_stash slice(std::size_t offset, std::size_t length) const;
 
       public:
         [[nodiscard]] std::string str()
@@ -44,6 +71,11 @@ namespace saucer
         [[nodiscard]] static basic_stash from(owning_t);
         [[nodiscard]] static basic_stash view(viewing_t);
         [[nodiscard]] static basic_stash lazy(lazy_t);
+        [[nodiscard]] static basic_stash shared(std::shared_ptr<const T[]>, std::size_t size);
+
+      public:
+        [[nodiscard]] static result<basic_stash> map(const std::filesystem::path &)
+            requires std::same_as<T, std::uint8_t>;
 
       public:
         [[nodiscard]] static basic_stash from_str(std::string_view)
@@ -62,6 +94,9 @@ namespace saucer
     };
 
     using stash = basic_stash<std::uint8_t>;
+
+    template <>
+    result<stash> stash::map(const std::filesystem::path &);
 } // namespace saucer
 
 #include "stash.inl"
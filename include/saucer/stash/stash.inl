@@ -3,6 +3,7 @@
 #include "stash.hpp"
 #include "../utils/overload.hpp"
 
+#include <mutex>
 #include <optional>
 #include <functional>
 
@@ -16,6 +17,7 @@ namespace saucer
       private:
         callback_t m_callback;
         std::optional<T> m_value;
+        std::once_flag m_once;
 
       public:
         lazy(callback_t callback) : m_callback(std::move(callback)) {}
@@ -25,11 +27,7 @@ namespace saucer
             requires std::is_lvalue_reference_v<Self>
         [[nodiscard]] auto &value(this Self &&self)
         {
-            if (!self.m_value.has_value())
-            {
-                self.m_value.emplace(self.m_callback());
-            }
-
+            std::call_once(self.m_once, [&self] { self.m_value.emplace(self.m_callback()); });
             return *std::forward<Self>(self).m_value;
         }
     };
@@ -61,6 +59,65 @@ namespace saucer
         return std::visit(visitor, m_data);
     }
 
+    template <typename T>
+    bool basic_stash<T>::deferred() const
+    {
+        return std::holds_alternative<lazy_t>(m_data);
+    }
+
+    template <typename T>
+    basic_stash<T> basic_stash<T>::owned() &&
+    {
+        if (const auto *view = std::get_if<viewing_t>(&m_data); view)
+        {
+            return from({view->begin(), view->end()});
+        }
+
+        return std::move(*this);
+    }
+
+    template <typename T>
+    basic_stash<T> basic_stash<T>::share() &&
+    {
+        auto *const data = std::get_if<owning_t>(&m_data);
+
+        if (!data)
+        {
+            return std::move(*this);
+        }
+
+        auto owner      = std::make_shared<owning_t>(std::move(*data));
+        const auto *raw = owner->data();
+        const auto size = owner->size();
+
+        return shared(std::shared_ptr<const T[]>{std::move(owner), raw}, size);
+    }
+
+    template <typename T>
+    basic_stash<T> basic_stash<T>::slice(std::size_t offset, std::size_t length) const
+    {
+        auto visitor = overload{
+            [&](const owning_t &data)
+            {
+                const auto begin = data.begin() + static_cast<std::ptrdiff_t>(offset);
+                return from({begin, begin + static_cast<std::ptrdiff_t>(length)});
+            },
+            [&](const viewing_t &data) { return view(data.subspan(offset, length)); },
+            [&](const lazy_t &data)
+            {
+                auto resolve = [data, offset, length]
+                {
+                    return shared(std::shared_ptr<const T[]>{data, data->value().data() + offset}, length);
+                };
+
+                return lazy(std::move(resolve));
+            },
+            [&](const shared_t &data) { return shared(std::shared_ptr<const T[]>{data.buffer, data.data() + offset}, length); },
+        };
+
+        return std::visit(visitor, m_data);
+    }
+
     template <typename T>
     std::string basic_stash<T>::str()
         requires std::same_as<T, std::uint8_t>
@@ -89,6 +146,12 @@ namespace saucer
         return {std::move(data)};
     }
 
+    template <typename T>
+    basic_stash<T> basic_stash<T>::shared(std::shared_ptr<const T[]> data, std::size_t size)
+    {
+        return {shared_t{std::move(data), size}};
+    }
+
     template <typename T>
     basic_stash<T> basic_stash<T>::from_str(std::string_view data)
         requires std::same_as<T, std::uint8_t>
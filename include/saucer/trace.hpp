@@ -0,0 +1,79 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <source_location>
+
+namespace saucer
+{
+    using trace_clock = std::chrono::steady_clock;
+
+    enum class startup_phase : std::uint8_t
+    {
+        application,
+        window,
+        webview,
+        environment,
+        controller,
+        register_scheme,
+        first_load,
+        first_dom_ready,
+    };
+
+    struct startup_trace
+    {
+        startup_phase phase;
+
+      public:
+        trace_clock::time_point start;
+        trace_clock::time_point end;
+    };
+
+    using trace_callback = std::function<void(const startup_trace &)>;
+
+    enum class ipc_stage : std::uint8_t
+    {
+        parse,
+        queue,
+        handler,
+        marshal,
+        resolve,
+        evaluation,
+    };
+
+    struct ipc_span
+    {
+        std::size_t id;
+        ipc_stage stage;
+
+      public:
+        trace_clock::time_point start;
+        trace_clock::time_point end;
+    };
+
+    using ipc_tracer = std::function<void(const ipc_span &)>;
+
+    struct ipc_record
+    {
+        // Relative to the moment the recorder was installed
+        std::chrono::nanoseconds offset;
+        std::string message;
+    };
+
+    using ipc_recorder = std::function<void(const ipc_record &)>;
+
+    struct long_task
+    {
+        // Points at the caller of `post`, tasks queued through `invoke` or `dispatch` carry the callback type in `function_name()`
+        std::source_location origin;
+
+      public:
+        trace_clock::time_point start;
+        trace_clock::time_point end;
+    };
+
+    using long_task_callback = std::function<void(const long_task &)>;
+} // namespace saucer
@@ -13,6 +13,12 @@ namespace saucer::traits
 
     template <typename T>
     struct resolver;
+
+    template <typename T, typename Args>
+    struct direct;
+
+    template <typename T>
+    struct producer;
 } // namespace saucer::traits
 
 #include "traits.inl"
@@ -2,6 +2,7 @@
 
 #include "traits.hpp"
 
+#include "../channel.hpp"
 #include "../executor.hpp"
 #include "../utils/tuple.hpp"
 
@@ -41,6 +42,9 @@ namespace saucer::traits
 
         template <typename T, typename Args = fixed_args_t<T>, typename Result = result_t<T>, typename Last = tuple::last_t<Args>>
         struct resolver;
+
+        template <typename T, typename Args = fixed_args_t<T>, typename Last = tuple::last_t<Args>>
+        struct producer;
     } // namespace detail
 
     template <typename T>
@@ -298,4 +302,36 @@ namespace saucer::traits
     struct resolver : detail::resolver<T>
     {
     };
+
+    template <typename T, typename Args>
+    struct direct : std::false_type
+    {
+    };
+
+    template <typename T, typename... Ts>
+        requires std::invocable<T &, Ts...> && (not coco::awaitable<std::invoke_result_t<T &, Ts...>>)
+    struct direct<T, std::tuple<Ts...>> : std::true_type
+    {
+    };
+
+    template <typename T, typename Args, typename Last>
+    struct detail::producer
+    {
+        static constexpr auto valid = false;
+    };
+
+    template <typename T, typename Args, typename R, typename E>
+    struct detail::producer<T, Args, channel<R, E>>
+    {
+        static constexpr auto valid = true;
+
+      public:
+        using args    = tuple::drop_last_t<Args>;
+        using channel = saucer::channel<R, E>;
+    };
+
+    template <typename T>
+    struct producer : detail::producer<T>
+    {
+    };
 } // namespace saucer::traits
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "url.hpp"
+
+#include "error/error.hpp"
+
+#include <string>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+namespace saucer
+{
+    struct url_view
+    {
+        struct component
+        {
+            std::size_t offset{0};
+            std::size_t size{0};
+
+          public:
+            bool present{false};
+        };
+
+      private:
+        std::string m_buffer;
+        std::optional<std::size_t> m_port;
+
+      private:
+        component m_scheme;
+        component m_user;
+        component m_password;
+        component m_host;
+        component m_path;
+        component m_query;
+        component m_fragment;
+
+      private:
+        url_view() = default;
+
+      private:
+        [[nodiscard]] std::string_view get(const component &) const;
+        [[nodiscard]] std::optional<std::string_view> find(const component &) const;
+
+      public:
+        [[nodiscard]] std::string_view string() const;
+
+      public:
+        [[nodiscard]] std::string_view path() const;
+        [[nodiscard]] std::string_view scheme() const;
+
+      public:
+        [[nodiscard]] std::optional<std::string_view> host() const;
+        [[nodiscard]] std::optional<std::size_t> port() const;
+
+      public:
+        [[nodiscard]] std::optional<std::string_view> user() const;
+        [[nodiscard]] std::optional<std::string_view> password() const;
+
+      public:
+        [[nodiscard]] std::optional<std::string_view> query() const;
+        [[nodiscard]] std::optional<std::string_view> fragment() const;
+
+      public:
+        [[nodiscard]] bool operator==(std::string_view) const;
+
+      public:
+        static result<url_view> parse(std::string input);
+        static result<url_view> parse(const url &);
+    };
+} // namespace saucer
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <concepts>
+#include <type_traits>
+
+namespace saucer
+{
+    namespace detail
+    {
+        struct task_vtable;
+
+        template <typename T, bool Local>
+        struct task_model;
+    }
+
+    class task
+    {
+        static constexpr auto capacity = 6 * sizeof(void *);
+
+      private:
+        alignas(std::max_align_t) std::byte m_storage[capacity];
+        const detail::task_vtable *m_vtable{nullptr};
+
+      public:
+        template <typename T>
+        static constexpr bool local = sizeof(T) <= capacity && alignof(T) <= alignof(std::max_align_t) &&
+                                      std::is_nothrow_move_constructible_v<T>;
+
+      public:
+        task() noexcept;
+
+      public:
+        template <typename T>
+            requires(std::invocable<std::decay_t<T> &> and not std::same_as<std::decay_t<T>, task>)
+        task(T &&);
+
+      public:
+        task(task &&) noexcept;
+        task &operator=(task &&) noexcept;
+
+      public:
+        ~task();
+
+      public:
+        void operator()();
+        explicit operator bool() const noexcept;
+    };
+} // namespace saucer
+
+#include "task.inl"
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "task.hpp"
+
+#include <new>
+#include <memory>
+#include <utility>
+#include <functional>
+
+namespace saucer
+{
+    struct detail::task_vtable
+    {
+        void (*invoke)(std::byte *);
+        void (*move)(std::byte *, std::byte *) noexcept;
+        void (*destroy)(std::byte *) noexcept;
+    };
+
+    template <typename T, bool Local>
+    struct detail::task_model
+    {
+        static T &get(std::byte *storage)
+        {
+            if constexpr (Local)
+            {
+                return *std::launder(reinterpret_cast<T *>(storage));
+            }
+            else
+            {
+                return **std::launder(reinterpret_cast<T **>(storage));
+            }
+        }
+
+      public:
+        static void invoke(std::byte *storage)
+        {
+            std::invoke(get(storage));
+        }
+
+        static void move(std::byte *to, std::byte *from) noexcept
+        {
+            if constexpr (Local)
+            {
+                std::construct_at(reinterpret_cast<T *>(to), std::move(get(from)));
+                std::destroy_at(std::addressof(get(from)));
+            }
+            else
+            {
+                std::construct_at(reinterpret_cast<T **>(to), std::addressof(get(from)));
+            }
+        }
+
+        static void destroy(std::byte *storage) noexcept
+        {
+            if constexpr (Local)
+            {
+                std::destroy_at(std::addressof(get(storage)));
+            }
+            else
+            {
+                delete std::addressof(get(storage));
+            }
+        }
+
+      public:
+        static constexpr task_vtable vtable{.invoke = invoke, .move = move, .destroy = destroy};
+    };
+
+    inline task::task() noexcept = default;
+
+    template <typename T>
+        requires(std::invocable<std::decay_t<T> &> and not std::same_as<std::decay_t<T>, task>)
+    task::task(T &&callback)
+    {
+        using callback_t = std::decay_t<T>;
+
+        if constexpr (local<callback_t>)
+        {
+            std::construct_at(reinterpret_cast<callback_t *>(m_storage), std::forward<T>(callback));
+        }
+        else
+        {
+            std::construct_at(reinterpret_cast<callback_t **>(m_storage), new callback_t{std::forward<T>(callback)});
+        }
+
+        m_vtable = &detail::task_model<callback_t, local<callback_t>>::vtable;
+    }
+
+    inline task::task(task &&other) noexcept : m_vtable(std::exchange(other.m_vtable, nullptr))
+    {
+        if (!m_vtable)
+        {
+            return;
+        }
+
+        m_vtable->move(m_storage, other.m_storage);
+    }
+
+    inline task &task::operator=(task &&other) noexcept
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        std::destroy_at(this);
+        std::construct_at(this, std::move(other));
+
+        return *this;
+    }
+
+    inline task::~task()
+    {
+        if (!m_vtable)
+        {
+            return;
+        }
+
+        m_vtable->destroy(m_storage);
+    }
+
+    inline void task::operator()()
+    {
+        m_vtable->invoke(m_storage);
+    }
+
+    inline task::operator bool() const noexcept
+    {
+        return m_vtable != nullptr;
+    }
+} // namespace saucer
@@ -8,22 +8,35 @@
 #include "utils/required.hpp"
 
 #include "stash/stash.hpp"
+#include "stash/decode_cache.hpp"
 
 #include "url.hpp"
 #include "icon.hpp"
+#include "cookie.hpp"
 #include "script.hpp"
+#include "url_view.hpp"
 #include "permission.hpp"
+#include "shared_buffer.hpp"
 
 #include "scheme.hpp"
+#include "router.hpp"
+#include "response_cache.hpp"
+#include "pipeline.hpp"
+#include "event_stream.hpp"
+#include "multi_writer.hpp"
 #include "navigation.hpp"
 
 #include <memory>
 #include <optional>
+#include <functional>
 
+#include <chrono>
 #include <compare>
 #include <cstdint>
 
 #include <set>
+#include <span>
+#include <vector>
 #include <filesystem>
 #include <unordered_map>
 
@@ -48,10 +61,86 @@ namespace saucer
         unhandled,
     };
 
+    enum class termination : std::uint8_t
+    {
+        crashed,
+        memory,
+        killed,
+    };
+
+    enum class launch : std::uint8_t
+    {
+        sync,
+        pool,
+        strand,
+    };
+
+    enum class memory_target : std::uint8_t
+    {
+        normal,
+        low,
+    };
+
+    enum class cache_model : std::uint8_t
+    {
+        document_viewer,
+        document_browser,
+        web_browser,
+    };
+
+    enum class process_model : std::uint8_t
+    {
+        per_site,
+        shared,
+    };
+
+    enum class layer : std::uint8_t
+    {
+        below,
+        above,
+    };
+
     struct embedded_file
     {
         stash content;
         std::string mime;
+
+      public:
+        std::optional<stash> brotli;
+        std::optional<stash> gzip;
+
+      public:
+        std::optional<decode_cache> decoder;
+
+      public:
+        std::vector<std::string> preload;
+    };
+
+    struct bundled_file
+    {
+        std::string_view path;
+        std::size_t offset;
+        std::size_t size;
+
+      public:
+        std::string_view mime;
+        std::string_view hash;
+    };
+
+    struct embedded_bundle
+    {
+        std::span<const std::uint8_t> blob;
+        std::span<const bundled_file> files;
+    };
+
+    struct navigation_rule
+    {
+        std::optional<std::string> scheme;
+        std::optional<std::string> host;
+        std::optional<std::string> prefix;
+
+      public:
+        policy action;
     };
 
     struct bounds
@@ -63,12 +152,15 @@ namespace saucer
         std::strong_ordering operator<=>(const bounds &) const = default;
     };
 
+    struct asset_store;
+
     struct webview
     {
         struct impl;
 
       public:
         struct options;
+        struct channel;
 
       private:
         using embedded_files = std::unordered_map<fs::path, embedded_file>;
@@ -77,6 +169,7 @@ namespace saucer
         enum class event : std::uint8_t
         {
             permission,
+            process_gone,
             fullscreen,
             dom_ready,
             navigated,
@@ -86,11 +179,13 @@ namespace saucer
             favicon,
             title,
             load,
+            timing,
         };
 
       public:
         using events = ereignis::manager<                                                             //
             ereignis::event<event::permission, status(const std::shared_ptr<permission::request> &)>, //
+            ereignis::event<event::process_gone, policy(termination)>,                                //
             ereignis::event<event::fullscreen, policy(bool)>,                                         //
             ereignis::event<event::dom_ready, void()>,                                                //
             ereignis::event<event::navigated, void(const saucer::url &)>,                             //
@@ -99,7 +194,8 @@ namespace saucer
             ereignis::event<event::request, void(const saucer::url &)>,                               //
             ereignis::event<event::favicon, void(const icon &)>,                                      //
             ereignis::event<event::title, void(std::string_view)>,                                    //
-            ereignis::event<event::load, void(const state &)>                                         //
+            ereignis::event<event::load, void(const state &)>,                                        //
+            ereignis::event<event::timing, void(const load_timing &)>                                 //
             >;
 
       protected:
@@ -114,16 +210,20 @@ namespace saucer
 
       public:
         static result<webview> create(const options &);
+        [[sc::thread_safe]] static coco::future<result<webview>> create_async(const options &);
 
       public:
         ~webview();
 
+      public:
+        [[sc::thread_safe]] coco::future<void> destroy();
+
       protected:
         template <event Event>
         void setup();
 
       protected:
-        void handle_scheme(const std::string &, scheme::resolver &&);
+        void handle_scheme(const std::string &, scheme::resolver &&, launch);
 
       public:
         template <bool Stable = true>
@@ -150,12 +250,23 @@ namespace saucer
       public:
         [[sc::thread_safe]] [[nodiscard]] saucer::bounds bounds() const;
 
+      public:
+        [[sc::thread_safe]] [[nodiscard]] bool suspended() const;
+
       public:
         [[sc::thread_safe]] void set_url(const saucer::url &);
         [[sc::thread_safe]] void set_url(cstring_view);
 
       public:
         [[sc::theead_safe]] void set_html(cstring_view);
+        [[sc::thread_safe]] void set_html(stash);
+
+      public:
+        [[sc::thread_safe]] void set_navigation_rules(std::vector<navigation_rule>);
+        [[sc::thread_safe]] void set_content_rules(std::vector<std::string> block);
+
+      public:
+        [[sc::thread_safe]] void clear_permissions();
 
       public:
         [[sc::thread_safe]] void set_dev_tools(bool);
@@ -169,6 +280,17 @@ namespace saucer
         [[sc::thread_safe]] void reset_bounds();
         [[sc::thread_safe]] void set_bounds(saucer::bounds);
 
+      public:
+        // Hosts a native view (`HWND`, `NSView *`, `GtkWidget *` or `QWidget *`) in the window and keeps it on top of the element
+        // tagged with `data-webview-surface="<name>"`. The view stays owned by the caller and only shows through a transparent
+        // background when placed below the webview.
+        [[sc::thread_safe]] void attach_surface(std::string name, void *handle, layer = layer::below);
+        [[sc::thread_safe]] void detach_surface(const std::string &name);
+
+      public:
+        [[sc::thread_safe]] void set_suspended(bool);
+        [[sc::thread_safe]] void set_memory_target(memory_target);
+
       public:
         [[sc::thread_safe]] void back();
         [[sc::thread_safe]] void forward();
@@ -178,23 +300,48 @@ namespace saucer
 
       public:
         [[sc::thread_safe]] void serve(fs::path);
+        [[sc::thread_safe]] void serve_directory(const fs::path &directory, std::string host = "saucer.example");
         [[sc::thread_safe]] void embed(embedded_files);
+        [[sc::thread_safe]] void embed(const fs::path &directory);
+        [[sc::thread_safe]] void embed(const embedded_bundle &);
 
       public:
         [[sc::thread_safe]] void unembed();
         [[sc::thread_safe]] void unembed(const fs::path &);
 
+      public:
+        [[sc::thread_safe]] void mount(asset_store);
+        [[sc::thread_safe]] void unmount(const asset_store &);
+
       public:
         [[sc::thread_safe]] void execute(cstring_view);
+        [[sc::thread_safe]] void execute(std::shared_ptr<const std::string>);
         [[sc::thread_safe]] std::size_t inject(const script &);
 
+      public:
+        [[sc::thread_safe]] [[nodiscard]] coco::future<result<std::string>> evaluate_raw(cstring_view);
+        [[sc::thread_safe]] [[nodiscard]] coco::future<result<icon>> capture(std::optional<saucer::size> bounds = std::nullopt);
+        [[sc::thread_safe]] [[nodiscard]] coco::future<memory_usage> memory_stats();
+        [[sc::thread_safe]] [[nodiscard]] coco::future<result<std::string>> devtools_protocol(std::string method,
+                                                                                              std::string params = "{}");
+
+      public:
+        [[sc::thread_safe]] [[nodiscard]] coco::future<result<>> set_cookies(std::vector<cookie>);
+        [[sc::thread_safe]] [[nodiscard]] coco::future<result<>> clear_data(site_data = {});
+
+      public:
+        [[sc::thread_safe]] [[nodiscard]] result<shared_buffer> create_buffer(std::size_t size);
+
+      public:
+        [[sc::thread_safe]] [[nodiscard]] result<channel> open_channel(std::string name);
+
       public:
         [[sc::thread_safe]] void uninject();
         [[sc::thread_safe]] void uninject(std::size_t);
 
       public:
         template <typename T>
-        [[sc::thread_safe]] void handle_scheme(const std::string &name, T &&handler);
+        [[sc::thread_safe]] void handle_scheme(const std::string &name, T &&handler, launch policy = launch::sync);
         [[sc::thread_safe]] void remove_scheme(const std::string &name);
 
       public:
@@ -226,17 +373,88 @@ namespace saucer
 
       public:
         bool attributes{true};
+        bool native_regions{false};
+        bool offscreen{false};
         bool persistent_cookies{true};
         bool non_persistent_data_store{false};
         bool hardware_acceleration{true};
 
+      public:
+        // Never shows the window and renders in software, without the attribute script. Meant for pooled background JS workers.
+        bool headless{false};
+
+      public:
+        bool cache_permissions{false};
+        std::optional<fs::path> permission_store;
+
+      public:
+        std::optional<saucer::process_model> process_model;
+        std::optional<bool> gpu_rasterization;
+        std::optional<bool> background_throttling;
+
       public:
         std::optional<fs::path> storage_path;
         std::optional<std::string> user_agent;
 
+      public:
+        std::optional<std::string> session;
+
+      public:
+        std::string cache_control{"no-cache"};
+
+      public:
+        std::optional<saucer::cache_model> cache_model;
+        std::optional<std::size_t> cache_size;
+
+      public:
+        // Chromium based backends only keep http(s) pages and are the only ones to honor the size, WebKit also keeps custom scheme
+        // (and thus embedded) pages. WKWebView always uses its back/forward cache and ignores both options.
+        std::optional<bool> back_forward_cache;
+        std::optional<std::size_t> back_forward_cache_size;
+
+      public:
+        // Unset features keep the engine default, toggles a backend has no setting for are ignored
+        std::optional<bool> spellcheck;
+        std::optional<bool> autofill;
+        std::optional<bool> password_manager;
+        std::optional<bool> smooth_scrolling;
+        std::optional<bool> accessibility;
+        std::optional<bool> pinch_zoom;
+
+      public:
+        std::optional<std::chrono::milliseconds> batch_window;
+
+      public:
+        bool frame_bridge{false};
+        bool collect_timing{false};
+        bool structured_messages{false};
+        bool suspend_when_minimized{false};
+
       public:
         std::set<std::string> browser_flags;
     };
+
+    struct webview::channel
+    {
+        struct state;
+
+      private:
+        std::shared_ptr<state> m_state;
+
+      public:
+        channel(std::shared_ptr<state>);
+
+      public:
+        [[nodiscard]] const std::string &name() const;
+
+      public:
+        // Frames are batched and delivered in order, sending returns `false` once the channel is closed
+        [[sc::thread_safe]] bool send(stash) const;
+        [[sc::thread_safe]] void on_receive(std::function<void(stash)>) const;
+
+      public:
+        [[sc::thread_safe]] void close() const;
+    };
 } // namespace saucer
 
 #include "webview.inl"
@@ -6,10 +6,10 @@
 namespace saucer
 {
     template <typename T>
-    void webview::handle_scheme(const std::string &name, T &&handler)
+    void webview::handle_scheme(const std::string &name, T &&handler, launch policy)
     {
         using transformer = traits::transformer<T, std::tuple<scheme::request>, scheme::executor>;
-        handle_scheme(name, scheme::resolver{transformer{std::forward<T>(handler)}});
+        handle_scheme(name, scheme::resolver{transformer{std::forward<T>(handler)}}, policy);
     }
 
     template <webview::event Event>
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "app.hpp"
+#include "window.hpp"
+#include "webview.hpp"
+
+#include <deque>
+#include <memory>
+#include <cstddef>
+#include <functional>
+
+namespace saucer
+{
+    template <typename T>
+    struct prewarmed
+    {
+        std::shared_ptr<saucer::window> window;
+        T webview;
+    };
+
+    template <typename T = webview>
+    class basic_webview_pool
+    {
+        struct state;
+
+      public:
+        using entry       = prewarmed<T>;
+        using configure_t = std::function<webview::options(std::shared_ptr<saucer::window>)>;
+
+      private:
+        std::shared_ptr<state> m_state;
+
+      public:
+        basic_webview_pool(application *, std::size_t capacity, configure_t = {});
+
+      public:
+        basic_webview_pool(basic_webview_pool &&) noexcept;
+
+      private:
+        static result<entry> create(state &);
+        static void refill(const std::shared_ptr<state> &);
+
+      public:
+        [[nodiscard]] std::size_t capacity() const;
+        [[nodiscard]] std::size_t available() const;
+
+      public:
+        void fill();
+        [[nodiscard]] result<entry> acquire();
+    };
+
+    using webview_pool = basic_webview_pool<>;
+} // namespace saucer
+
+#include "webview_pool.inl"
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "webview_pool.hpp"
+
+namespace saucer
+{
+    template <typename T>
+    struct basic_webview_pool<T>::state
+    {
+        application *parent;
+        std::size_t capacity;
+        configure_t configure;
+
+      public:
+        std::deque<entry> entries;
+        std::size_t scheduled{0};
+    };
+
+    template <typename T>
+    basic_webview_pool<T>::basic_webview_pool(application *parent, std::size_t capacity, configure_t configure)
+        : m_state(std::make_shared<state>(parent, capacity, std::move(configure)))
+    {
+        if (!m_state->configure)
+        {
+            m_state->configure = [](std::shared_ptr<saucer::window> window)
+            {
+                return webview::options{.window = std::move(window)};
+            };
+        }
+    }
+
+    template <typename T>
+    basic_webview_pool<T>::basic_webview_pool(basic_webview_pool &&) noexcept = default;
+
+    template <typename T>
+    result<typename basic_webview_pool<T>::entry> basic_webview_pool<T>::create(state &self)
+    {
+        auto window = window::create(self.parent);
+
+        if (!window.has_value())
+        {
+            return err(window);
+        }
+
+        auto webview = T::create(self.configure(*window));
+
+        if (!webview.has_value())
+        {
+            return err(webview);
+        }
+
+        return entry{.window = std::move(*window), .webview = std::move(*webview)};
+    }
+
+    template <typename T>
+    void basic_webview_pool<T>::refill(const std::shared_ptr<state> &self)
+    {
+        while (self->entries.size() + self->scheduled < self->capacity)
+        {
+            auto callback = [weak = std::weak_ptr{self}]
+            {
+                auto self = weak.lock();
+
+                if (!self)
+                {
+                    return;
+                }
+
+                self->scheduled--;
+
+                if (auto entry = create(*self); entry.has_value())
+                {
+                    self->entries.emplace_back(std::move(*entry));
+                }
+            };
+
+            self->scheduled++;
+            self->parent->post(std::move(callback), priority::background);
+        }
+    }
+
+    template <typename T>
+    std::size_t basic_webview_pool<T>::capacity() const
+    {
+        return m_state->capacity;
+    }
+
+    template <typename T>
+    std::size_t basic_webview_pool<T>::available() const
+    {
+        return m_state->entries.size();
+    }
+
+    template <typename T>
+    void basic_webview_pool<T>::fill()
+    {
+        if (!m_state->parent->thread_safe())
+        {
+            return m_state->parent->invoke(&basic_webview_pool::fill, this);
+        }
+
+        refill(m_state);
+    }
+
+    template <typename T>
+    result<typename basic_webview_pool<T>::entry> basic_webview_pool<T>::acquire()
+    {
+        if (!m_state->parent->thread_safe())
+        {
+            return m_state->parent->invoke(&basic_webview_pool::acquire, this);
+        }
+
+        if (m_state->entries.empty())
+        {
+            auto rtn = create(*m_state);
+            refill(m_state);
+            return rtn;
+        }
+
+        auto rtn = std::move(m_state->entries.front());
+        m_state->entries.pop_front();
+
+        refill(m_state);
+
+        return rtn;
+    }
+} // namespace saucer
@@ -33,6 +33,9 @@ namespace saucer
     {
         struct impl;
 
+      public:
+        struct properties;
+
       public:
         enum class event : std::uint8_t
         {
@@ -42,6 +45,7 @@ namespace saucer
             closed,
             resize,
             focus,
+            frame,
             close,
         };
 
@@ -74,6 +78,7 @@ namespace saucer
             ereignis::event<event::closed, void()>,              //
             ereignis::event<event::resize, void(int, int)>,      //
             ereignis::event<event::focus, void(bool)>,           //
+            ereignis::event<event::frame, void()>,               //
             ereignis::event<event::close, policy()>              //
             >;
 
@@ -85,11 +90,17 @@ namespace saucer
         window(application *);
 
       public:
-        static result<std::shared_ptr<window>> create(application *);
+        static result<std::shared_ptr<window>> create(application *, const properties & = {});
+
+        // Always queued on the UI thread, so that many creations can be started at once and interleave with other work
+        [[sc::thread_safe]] static coco::future<result<std::shared_ptr<window>>> create_async(application *, const properties & = {});
 
       public:
         ~window();
 
+      public:
+        [[sc::thread_safe]] coco::future<void> destroy();
+
       protected:
         template <event Event>
         void setup();
@@ -157,6 +168,9 @@ namespace saucer
         [[sc::thread_safe]] void set_always_on_top(bool);
         [[sc::thread_safe]] void set_click_through(bool);
 
+      public:
+        [[sc::thread_safe]] void set_coalesce_resize(bool);
+
       public:
         [[sc::thread_safe]] void set_icon(const icon &);
         [[sc::thread_safe]] void set_title(cstring_view);
@@ -173,6 +187,9 @@ namespace saucer
       public:
         [[sc::thread_safe]] void set_position(saucer::position);
 
+      public:
+        [[sc::thread_safe]] void apply(properties);
+
       public:
         template <event Event>
         [[sc::thread_safe]] auto on(events::event<Event>::listener);
@@ -188,6 +205,34 @@ namespace saucer
         [[sc::thread_safe]] void off(event);
         [[sc::thread_safe]] void off(event, std::size_t id);
     };
+
+    struct window::properties
+    {
+        std::optional<std::string> title;
+        std::optional<saucer::icon> icon;
+
+      public:
+        std::optional<color> background;
+        std::optional<decoration> decorations;
+
+      public:
+        std::optional<saucer::size> size;
+        std::optional<saucer::size> max_size;
+        std::optional<saucer::size> min_size;
+
+      public:
+        std::optional<saucer::position> position;
+
+      public:
+        std::optional<bool> resizable;
+        std::optional<bool> always_on_top;
+        std::optional<bool> click_through;
+
+      public:
+        std::optional<bool> minimized;
+        std::optional<bool> maximized;
+        std::optional<bool> fullscreen;
+    };
 } // namespace saucer
 
 #include "window.inl"
@@ -2,7 +2,17 @@
 
 #include <saucer/app.hpp>
 
+#include "lease.hpp"
+#include "queue.hpp"
+#include "instance.hpp"
+
+#include <mutex>
+#include <chrono>
+#include <string>
 #include <thread>
+#include <vector>
+#include <optional>
+#include <unordered_map>
 
 namespace saucer
 {
@@ -10,6 +20,10 @@ namespace saucer
     {
         struct native;
 
+      public:
+        // Used by backends whose loop can not be waited on from the outside
+        static constexpr auto poll_interval = std::chrono::milliseconds{10};
+
       public:
         application::events events;
 
@@ -17,8 +31,13 @@ namespace saucer
         std::thread::id thread;
         coco::future<void> finish;
 
+      public:
+        utils::queue queue;
+        trace_callback trace;
+
       public:
         std::unique_ptr<native> platform;
+        utils::lease<application::impl *> lease{this};
 
       public:
         impl();
@@ -29,13 +48,54 @@ namespace saucer
       public:
         result<> init_platform(const options &);
 
+      public:
+        std::mutex screen_mutex;
+        std::size_t screen_generation{0};
+        std::optional<std::vector<screen>> screen_cache;
+
       public:
         [[nodiscard]] std::vector<screen> screens() const;
+        void screens_changed();
+
+      public:
+        struct timer
+        {
+            bool repeat;
+            std::shared_ptr<timer_callback_t> callback;
+        };
+
+      public:
+        std::size_t timer_counter{0};
+        std::unordered_map<std::size_t, timer> timers;
+
+      public:
+        std::size_t add_timer(std::chrono::milliseconds, timer_callback_t, timer_precision, bool repeat);
+        void remove_timer(std::size_t);
+        bool fire(std::size_t);
+
+      public:
+        void start_timer(std::size_t, std::chrono::milliseconds, timer_precision, bool repeat);
+        void stop_timer(std::size_t);
+
+      public:
+        void wake(priority);
+        void record(startup_phase, trace_clock::time_point) const;
 
       public:
         int run(application *, callback_t);
 
+      public:
+        poll_set prepare();
+        bool process(const poll_set &);
+
       public:
         void quit();
+
+      public:
+        std::unique_ptr<utils::single_instance> instance;
+
+      public:
+        [[nodiscard]] static std::vector<std::string> arguments(const options &);
+        [[nodiscard]] bool claim(const std::string &id, const std::vector<std::string> &args);
     };
 } // namespace saucer
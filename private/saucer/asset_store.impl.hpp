@@ -0,0 +1,26 @@
+#pragma once
+
+#include "webview.impl.hpp"
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace saucer
+{
+    struct asset_store::impl
+    {
+        using entry = webview::impl::embedded_entry;
+
+      public:
+        mutable std::mutex mutex;
+        std::map<std::string, std::shared_ptr<const entry>, std::less<>> files;
+
+      public:
+        [[nodiscard]] std::shared_ptr<const entry> find(std::string_view) const;
+
+      public:
+        void retag(std::string_view, const stash &, std::string);
+    };
+} // namespace saucer
@@ -12,6 +12,8 @@ namespace saucer
     struct application::impl::native
     {
         NSApplication *application;
+        dispatch_source_t memory_source;
+        id<NSObject> screen_observer;
 
       public:
         std::string id;
@@ -19,6 +21,7 @@ namespace saucer
 
       public:
         std::unordered_map<NSWindow *, bool> instances;
+        std::unordered_map<std::size_t, CFRunLoopTimerRef> timers;
 
       public:
         static void iteration();
@@ -2,6 +2,7 @@
 
 #include <saucer/icon.hpp>
 
+#include "encoded.hpp"
 #include "cocoa.utils.hpp"
 
 #import <Cocoa/Cocoa.h>
@@ -11,5 +12,6 @@ namespace saucer
     struct icon::impl
     {
         utils::objc_ptr<NSImage> icon;
+        utils::encoded png{};
     };
 } // namespace saucer
@@ -8,6 +8,7 @@
 #include <functional>
 
 #import <Cocoa/Cocoa.h>
+#import <QuartzCore/QuartzCore.h>
 
 @class WindowDelegate;
 
@@ -71,6 +72,7 @@ namespace saucer
     saucer::observer_callback_t m_callback;
 }
 - (instancetype)initWithCallback:(saucer::observer_callback_t)callback;
+- (void)tick:(id)sender;
 @end
 
 @interface WindowDelegate : NSObject <NSWindowDelegate>
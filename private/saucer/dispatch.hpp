@@ -0,0 +1,11 @@
+#pragma once
+
+#include "invoke.hpp"
+
+namespace saucer::utils
+{
+    template <detail::callback Callback, typename T, typename... Ts>
+    void dispatch(T *, Ts &&...);
+} // namespace saucer::utils
+
+#include "dispatch.inl"
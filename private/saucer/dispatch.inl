@@ -0,0 +1,56 @@
+#pragma once
+
+#include "dispatch.hpp"
+#include "lease.hpp"
+
+#include <string>
+#include <type_traits>
+
+#include <saucer/utils/cstring.hpp>
+
+namespace saucer::utils
+{
+    namespace detail
+    {
+        template <typename T>
+        struct owned
+        {
+            using type = T;
+        };
+
+        template <typename T>
+        struct owned<std::basic_string_view<T>>
+        {
+            using type = std::basic_string<T>;
+        };
+
+        template <typename T>
+        struct owned<basic_cstring_view<T>>
+        {
+            using type = std::basic_string<T>;
+        };
+
+        template <typename T>
+        using owned_t = owned<std::remove_cvref_t<T>>::type;
+    } // namespace detail
+
+    template <detail::callback Callback, typename T, typename... Ts>
+    void dispatch(T *self, Ts &&...args)
+    {
+        static constexpr auto name = rebind::member_name<Callback.value>;
+        static constexpr auto pure = name.substr(0, name.find_first_of("(<"));
+        static_assert(pure == Callback.name, "Name of implementation does not match interface");
+
+        if (!self)
+        {
+            return;
+        }
+
+        auto callback = [... args = detail::owned_t<Ts>(std::forward<Ts>(args))](T *impl) mutable
+        {
+            std::invoke(Callback.value, impl, std::move(args)...);
+        };
+
+        self->parent->dispatch(defer(self->lease, std::move(callback)));
+    }
+} // namespace saucer::utils
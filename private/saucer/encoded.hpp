@@ -0,0 +1,28 @@
+#pragma once
+
+#include <saucer/stash/stash.hpp>
+
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+namespace saucer::utils
+{
+    class encoded
+    {
+        struct state;
+
+      private:
+        std::shared_ptr<state> m_state;
+
+      public:
+        encoded();
+
+      public:
+        template <typename Callback>
+        [[nodiscard]] stash get(Callback &&) const;
+    };
+} // namespace saucer::utils
+
+#include "encoded.inl"
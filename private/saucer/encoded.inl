@@ -0,0 +1,29 @@
+#pragma once
+
+#include "encoded.hpp"
+
+#include <functional>
+
+namespace saucer::utils
+{
+    struct encoded::state
+    {
+        std::once_flag once;
+        std::vector<std::uint8_t> data;
+    };
+
+    inline encoded::encoded() : m_state(std::make_shared<state>()) {}
+
+    template <typename Callback>
+    stash encoded::get(Callback &&callback) const
+    {
+        std::call_once(m_state->once, [this, &callback] { m_state->data = std::invoke(std::forward<Callback>(callback)); });
+
+        auto view = [state = m_state]
+        {
+            return stash::view(state->data);
+        };
+
+        return stash::lazy(std::move(view));
+    }
+} // namespace saucer::utils
@@ -3,6 +3,7 @@
 #include "app.impl.hpp"
 #include "gtk.utils.hpp"
 
+#include <optional>
 #include <unordered_map>
 
 #include <adwaita.h>
@@ -12,6 +13,7 @@ namespace saucer
     struct application::impl::native
     {
         utils::g_object_ptr<AdwApplication> application;
+        utils::g_object_ptr<GMemoryMonitor> memory_monitor;
 
       public:
         int argc;
@@ -21,9 +23,14 @@ namespace saucer
         bool quit_on_last_window_closed;
         std::unordered_map<void *, bool> instances;
 
+      public:
+        std::optional<gint> poll_priority;
+        std::unordered_map<std::size_t, guint> timers;
+
       public:
         static void iteration();
         static screen convert(GdkMonitor *);
+        static int convert(priority);
 
       public:
         static std::string fix_id(const std::string &);
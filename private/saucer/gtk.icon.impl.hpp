@@ -2,6 +2,7 @@
 
 #include <saucer/icon.hpp>
 
+#include "encoded.hpp"
 #include "gtk.utils.hpp"
 
 #include <gtk/gtk.h>
@@ -11,5 +12,6 @@ namespace saucer
     struct icon::impl
     {
         utils::g_object_ptr<GdkTexture> texture;
+        utils::encoded png{};
     };
 } // namespace saucer
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+
+namespace saucer::utils
+{
+    struct string_hash
+    {
+        using is_transparent = void;
+
+      public:
+        std::size_t operator()(std::string_view value) const
+        {
+            return std::hash<std::string_view>{}(value);
+        }
+    };
+
+    template <typename T>
+    using string_map = std::unordered_map<std::string, T, string_hash, std::equal_to<>>;
+} // namespace saucer::utils
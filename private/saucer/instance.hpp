@@ -0,0 +1,38 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <functional>
+#include <string_view>
+
+namespace saucer::utils
+{
+    class single_instance
+    {
+        struct native;
+
+      public:
+        using callback = std::function<void(std::vector<std::string>)>;
+
+      private:
+        std::unique_ptr<native> m_native;
+
+      private:
+        single_instance();
+
+      public:
+        ~single_instance();
+
+      public:
+        // Where instances claiming `id` listen, on macOS this is a socket in the temporary directory
+        static std::string endpoint(std::string_view id);
+
+      public:
+        // Hands the arguments to the instance listening on `id`, fails if there is none
+        static bool forward(std::string_view id, const std::vector<std::string> &);
+
+        // Fails if another instance already (or concurrently) claimed `id`, the callback is invoked on a helper thread
+        static std::unique_ptr<single_instance> listen(std::string_view id, callback);
+    };
+} // namespace saucer::utils
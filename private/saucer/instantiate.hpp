@@ -19,12 +19,13 @@
 
 #define SAUCER_INSTANTIATE_WINDOW_EVENTS(MACRO)                                                                                       \
     SAUCER_RECURSE(MACRO, window::event::decorated, window::event::maximize, window::event::minimize, window::event::closed,          \
-                   window::event::resize, window::event::focus, window::event::close)
+                   window::event::resize, window::event::focus, window::event::frame, window::event::close)
 
 #define SAUCER_INSTANTIATE_WEBVIEW_EVENT(EVENT)      SAUCER_INSTANTIATE_EVENT(webview, EVENT)
 #define SAUCER_INSTANTIATE_WEBVIEW_IMPL_EVENT(EVENT) SAUCER_INSTANTIATE_EVENT(webview::impl, EVENT)
 
 #define SAUCER_INSTANTIATE_WEBVIEW_EVENTS(MACRO)                                                                                      \
-    SAUCER_RECURSE(MACRO, webview::event::permission, webview::event::fullscreen, webview::event::dom_ready,                          \
-                   webview::event::navigated, webview::event::navigate, webview::event::message, webview::event::request,             \
-                   webview::event::favicon, webview::event::title, webview::event::load)
+    SAUCER_RECURSE(MACRO, webview::event::permission, webview::event::process_gone, webview::event::fullscreen,                       \
+                   webview::event::dom_ready, webview::event::navigated, webview::event::navigate, webview::event::message,           \
+                   webview::event::request, webview::event::favicon, webview::event::title, webview::event::load,                     \
+                   webview::event::timing)
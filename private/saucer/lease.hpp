@@ -1,7 +1,6 @@
 #pragma once
 
 #include <memory>
-#include <shared_mutex>
 
 namespace saucer::utils
 {
@@ -62,10 +61,14 @@ namespace saucer::utils
     class rental<T>::lock
     {
         std::shared_ptr<state> m_state;
-        std::shared_lock<std::shared_mutex> m_guard;
+        std::size_t m_readers;
 
       public:
         explicit lock(const rental &);
+        lock(const lock &) = delete;
+
+      public:
+        ~lock();
 
       public:
         [[nodiscard]] T *value() const;
@@ -3,7 +3,7 @@
 #include "lease.hpp"
 #include "invoke.hpp"
 
-#include <mutex>
+#include <atomic>
 #include <optional>
 
 namespace saucer::utils
@@ -11,8 +11,11 @@ namespace saucer::utils
     template <typename T>
     struct lease<T>::state
     {
+        static constexpr auto revoked = ~(~std::size_t{0} >> 1);
+
+      public:
         std::optional<T> value;
-        std::shared_mutex mutex;
+        std::atomic<std::size_t> readers{0};
     };
 
     template <typename T>
@@ -37,7 +40,14 @@ namespace saucer::utils
             return;
         }
 
-        std::unique_lock guard{m_state->mutex};
+        auto current = m_state->readers.fetch_or(state::revoked, std::memory_order_acq_rel);
+
+        // Rentals that arrive after revocation back off on their own, so we only wait for the ones already inside
+        while (current & ~state::revoked)
+        {
+            m_state->readers.wait(current, std::memory_order_acquire);
+            current = m_state->readers.load(std::memory_order_acquire);
+        }
 
         m_state->value.reset();
     }
@@ -75,13 +85,40 @@ namespace saucer::utils
     }
 
     template <typename T>
-    rental<T>::lock::lock(const rental &other) : m_state(other.m_state), m_guard(m_state->mutex)
+    rental<T>::lock::lock(const rental &other) : m_state(other.m_state), m_readers(state::revoked)
+    {
+        if (!m_state)
+        {
+            return;
+        }
+
+        m_readers = m_state->readers.fetch_add(1, std::memory_order_acquire);
+    }
+
+    template <typename T>
+    rental<T>::lock::~lock()
     {
+        if (!m_state)
+        {
+            return;
+        }
+
+        if (m_state->readers.fetch_sub(1, std::memory_order_release) != (state::revoked | 1))
+        {
+            return;
+        }
+
+        m_state->readers.notify_all();
     }
 
     template <typename T>
     T *rental<T>::lock::value() const
     {
+        if (m_readers & state::revoked)
+        {
+            return nullptr;
+        }
+
         auto &rtn = m_state->value;
 
         if (!rtn.has_value())
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <saucer/metrics.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace saucer::utils
+{
+    struct metrics
+    {
+        std::atomic_uint64_t calls{0};
+        std::atomic_uint64_t scheme_requests{0};
+        std::atomic_uint64_t scheme_bytes{0};
+
+      public:
+        std::atomic_int64_t evaluations{0};
+        std::atomic_int64_t stream_writers{0};
+
+      public:
+        std::atomic_uint64_t latency_count{0};
+        std::atomic_uint64_t latency_sum{0};
+        std::array<std::atomic_uint64_t, histogram::bounds.size() + 1> latency{};
+
+      public:
+        void observe(std::chrono::nanoseconds);
+
+      public:
+        [[nodiscard]] saucer::metrics snapshot() const;
+
+      public:
+        [[nodiscard]] static metrics &get();
+    };
+
+    class tracked
+    {
+        std::atomic_int64_t *m_gauge;
+
+      public:
+        explicit tracked(std::atomic_int64_t &);
+
+      public:
+        tracked(const tracked &) = delete;
+        tracked &operator=(const tracked &) = delete;
+
+      public:
+        ~tracked();
+    };
+} // namespace saucer::utils
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <saucer/url.hpp>
+#include <saucer/permission.hpp>
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <optional>
+#include <filesystem>
+
+namespace saucer::utils
+{
+    namespace fs = std::filesystem;
+
+    class permission_cache
+    {
+        using key = std::pair<std::string, permission::type>;
+
+      private:
+        mutable std::mutex m_mutex;
+        std::map<key, bool> m_decisions;
+
+      private:
+        std::optional<fs::path> m_store;
+
+      public:
+        explicit permission_cache(std::optional<fs::path> store);
+
+      private:
+        void load();
+        void save() const;
+
+      public:
+        [[nodiscard]] std::optional<bool> find(const saucer::url &, permission::type) const;
+
+      public:
+        void store(const saucer::url &, permission::type, bool);
+        void clear();
+
+      public:
+        [[nodiscard]] static std::string origin(const saucer::url &);
+    };
+} // namespace saucer::utils
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <mutex>
+#include <condition_variable>
+
+#include <array>
+#include <deque>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <optional>
+
+#include <functional>
+
+namespace saucer::utils
+{
+    // Every worker owns a queue, idle workers steal from the others before going to sleep
+    class pool
+    {
+        using task = std::move_only_function<void()>;
+
+      public:
+        static constexpr std::size_t lanes = 3;
+
+      private:
+        struct queue
+        {
+            std::mutex mutex;
+            std::array<std::deque<task>, lanes> tasks;
+        };
+
+      private:
+        bool m_stop{false};
+        std::size_t m_pending{0};
+        std::vector<std::unique_ptr<queue>> m_queues;
+
+      private:
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+
+      private:
+        std::vector<std::thread> m_workers;
+
+      public:
+        explicit pool(std::size_t threads);
+
+      public:
+        ~pool();
+
+      private:
+        void work(std::size_t index);
+        std::optional<task> take(std::size_t index);
+
+      public:
+        void submit(task, std::size_t lane = 1);
+
+      public:
+        [[nodiscard]] std::size_t size() const;
+
+      public:
+        [[nodiscard]] static pool &shared();
+    };
+} // namespace saucer::utils
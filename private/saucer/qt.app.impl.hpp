@@ -2,7 +2,10 @@
 
 #include "app.impl.hpp"
 
+#include <unordered_map>
+
 #include <QEvent>
+#include <QTimer>
 #include <QScreen>
 #include <QApplication>
 
@@ -11,6 +14,7 @@ namespace saucer
     struct application::impl::native
     {
         std::unique_ptr<QApplication> application;
+        std::unordered_map<std::size_t, std::unique_ptr<QTimer>> timers;
 
       public:
         static inline std::string id;
@@ -20,6 +24,8 @@ namespace saucer
       public:
         static void iteration();
         static screen convert(QScreen *);
+        static int convert(priority);
+        static Qt::TimerType convert(timer_precision);
     };
 
     class safe_event : public QEvent
@@ -2,6 +2,8 @@
 
 #include <saucer/icon.hpp>
 
+#include "encoded.hpp"
+
 #include <QIcon>
 
 namespace saucer
@@ -9,6 +11,7 @@ namespace saucer
     struct icon::impl
     {
         QIcon icon;
+        utils::encoded png{};
 
       public:
         [[nodiscard]] std::optional<QPixmap> pixmap() const;
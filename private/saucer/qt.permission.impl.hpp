@@ -2,6 +2,8 @@
 
 #include <saucer/permission.hpp>
 
+#include <functional>
+
 #include <QWebEnginePermission>
 
 namespace saucer::permission
@@ -13,5 +15,8 @@ namespace saucer::permission
       public:
         QWebEnginePermission::PermissionType type;
         QUrl origin;
+
+      public:
+        std::move_only_function<void(bool)> decided;
     };
 } // namespace saucer::permission
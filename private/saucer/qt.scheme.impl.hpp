@@ -2,6 +2,8 @@
 
 #include <saucer/scheme.hpp>
 
+#include "metrics.impl.hpp"
+
 #include <QWebEngineUrlRequestJob>
 #include <QWebEngineUrlSchemeHandler>
 
@@ -11,8 +13,16 @@ namespace saucer::scheme
 {
     struct request::impl
     {
-        std::shared_ptr<lockpp::lock<QWebEngineUrlRequestJob *>> request;
+        QUrl url;
+        std::string method;
         QByteArray body;
+        std::map<std::string, std::string> headers;
+
+      public:
+        std::size_t offset{0};
+
+      public:
+        static impl from(QWebEngineUrlRequestJob *);
     };
 
     class handler : public QWebEngineUrlSchemeHandler
@@ -49,5 +59,8 @@ namespace saucer::scheme
         class stream_device *device;
         std::atomic<bool> started{false};
         std::atomic<bool> finished{false};
+
+      public:
+        utils::tracked active{utils::metrics::get().stream_writers};
     };
 } // namespace saucer::scheme
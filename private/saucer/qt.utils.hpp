@@ -1,6 +1,11 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <string_view>
+
+#include <QString>
+#include <QStringView>
 
 namespace saucer::utils
 {
@@ -15,6 +20,9 @@ namespace saucer::utils
 
     template <typename T, typename... Ts>
     auto make_deferred(Ts &&...);
+
+    [[nodiscard]] QString widen(std::string_view);
+    [[nodiscard]] std::string narrow(QStringView);
 } // namespace saucer::utils
 
 #include "qt.utils.inl"
@@ -2,6 +2,7 @@
 
 #include "webview.impl.hpp"
 
+#include "hash.hpp"
 #include "qt.utils.hpp"
 #include "qt.scheme.impl.hpp"
 
@@ -12,6 +13,7 @@
 
 #include <QMetaObject>
 #include <QWebChannel>
+#include <QRegularExpression>
 
 #include <QWebEngineView>
 #include <QWebEngineScript>
@@ -31,11 +33,13 @@ namespace saucer
 
       public:
         bool clearable;
+        bool standalone;
     };
 
     struct webview::impl::native
     {
         std::unique_ptr<QWebEngineProfile> profile;
+        int cache_size{0};
 
       public:
         utils::deferred_ptr<QWebEngineView> web_view;
@@ -60,19 +64,27 @@ namespace saucer
         std::size_t on_closed;
         QMetaObject::Connection on_load;
         QMetaObject::Connection on_fullscreen;
+        QMetaObject::Connection on_terminated;
 
       public:
         std::unique_ptr<request_interceptor> interceptor;
-        std::unordered_map<std::string, scheme::handler> schemes;
-        std::unordered_map<std::string, scheme::stream_handler> stream_schemes;
+        std::vector<QRegularExpression> content_rules;
+        utils::string_map<scheme::handler> schemes;
+        utils::string_map<scheme::stream_handler> stream_schemes;
 
       public:
         template <event>
         void setup(impl *);
 
       public:
+        void intercept(impl *);
         QWebEngineScript find(const char *) const;
 
+      public:
+        static quint32 world(const std::string &);
+        static std::optional<std::size_t> resident(qint64 pid);
+        static QWebEngineProfile::HttpCacheType convert(cache_model);
+
       public:
         static bool init_web_channel();
         static inline std::string channel_script{};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <source_location>
+
+#include <saucer/trace.hpp>
+#include <saucer/utils/task.hpp>
+
+namespace saucer::utils
+{
+    class queue
+    {
+        struct node;
+        struct cache;
+
+      private:
+        struct lane
+        {
+            std::atomic<node *> head{nullptr};
+
+          public:
+            node *front{nullptr};
+            node *back{nullptr};
+        };
+
+      public:
+        static constexpr std::size_t lanes = 3;
+
+      private:
+        std::array<lane, lanes> m_lanes;
+        std::atomic<std::size_t> m_size{0};
+
+      private:
+        std::atomic<node *> m_free{nullptr};
+
+      private:
+        trace_clock::duration m_budget{};
+        long_task_callback m_report;
+
+      public:
+        queue();
+
+      public:
+        ~queue();
+
+      private:
+        static void take(lane &);
+
+      private:
+        node *acquire();
+        void release(node *);
+
+      public:
+        [[nodiscard]] bool push(task, std::size_t lane, std::source_location = {});
+        [[nodiscard]] std::size_t size() const;
+
+      public:
+        void watch(trace_clock::duration budget, long_task_callback);
+
+      public:
+        void drain();
+    };
+} // namespace saucer::utils
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 
+#include <array>
+#include <vector>
 #include <variant>
 #include <optional>
 
@@ -47,8 +50,58 @@ namespace saucer::request
         std::size_t id;
     };
 
-    using request = std::variant<start_resize, start_drag, maximize, minimize, close, maximized, minimized>;
+    struct regions
+    {
+        std::vector<std::array<int, 4>> drag;
+        std::vector<std::array<int, 4>> ignore;
+
+      public:
+        static constexpr auto name = "setRegions";
+    };
+
+    struct resource
+    {
+        std::string name;
+        std::string type;
+
+      public:
+        double start;
+        double duration;
+        std::uint64_t size;
+    };
+
+    struct timing
+    {
+        double dns;
+        double connect;
+        double ttfb;
+        double dom_content_loaded;
+        double load;
+
+      public:
+        std::vector<resource> resources;
+
+      public:
+        static constexpr auto internal = true;
+    };
+
+    struct surface
+    {
+        std::string name;
+        std::array<int, 4> bounds;
+    };
+
+    struct surfaces
+    {
+        std::vector<surface> entries;
+
+      public:
+        static constexpr auto internal = true;
+    };
+
+    using request = std::variant<start_resize, start_drag, maximize, minimize, close, maximized, minimized, regions, timing, surfaces>;
 
     [[nodiscard]] std::string stubs();
+    [[nodiscard]] bool tagged(std::string_view);
     [[nodiscard]] std::optional<request> parse(std::string_view);
 } // namespace saucer::request
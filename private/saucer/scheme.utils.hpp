@@ -0,0 +1,8 @@
+#pragma once
+
+#include <saucer/scheme.hpp>
+
+namespace saucer::utils
+{
+    [[nodiscard]] scheme::write_status write_file(scheme::stream_writer &, int fd, std::size_t offset, std::size_t length);
+} // namespace saucer::utils
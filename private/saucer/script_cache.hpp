@@ -0,0 +1,29 @@
+#pragma once
+
+#include <saucer/script.hpp>
+
+#include <list>
+#include <tuple>
+#include <string>
+#include <utility>
+#include <optional>
+
+namespace saucer::utils
+{
+    // Permanent scripts (our own runtime, serializers, bridges) are identical across webviews, so they share one native instance.
+    // Only the most recently used ones are kept, which bounds the cache no matter how many distinct scripts are injected.
+    template <typename T, std::size_t Capacity = 32>
+    class script_cache
+    {
+        using key = std::tuple<std::string, std::optional<std::string>, script::time, bool>;
+
+      private:
+        std::list<std::pair<key, T>> m_entries;
+
+      public:
+        template <typename Callback>
+        T get(const script &, Callback &&make);
+    };
+} // namespace saucer::utils
+
+#include "script_cache.inl"
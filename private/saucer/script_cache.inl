@@ -0,0 +1,31 @@
+#pragma once
+
+#include "script_cache.hpp"
+
+#include <algorithm>
+
+namespace saucer::utils
+{
+    template <typename T, std::size_t Capacity>
+    template <typename Callback>
+    T script_cache<T, Capacity>::get(const script &script, Callback &&make)
+    {
+        auto id = key{script.code, script.world, script.run_at, script.no_frames};
+        auto it = std::ranges::find(m_entries, id, &std::pair<key, T>::first);
+
+        if (it != m_entries.end())
+        {
+            m_entries.splice(m_entries.begin(), m_entries, it);
+            return m_entries.front().second;
+        }
+
+        if (m_entries.size() >= Capacity)
+        {
+            m_entries.pop_back();
+        }
+
+        m_entries.emplace_front(std::move(id), std::forward<Callback>(make)());
+
+        return m_entries.front().second;
+    }
+} // namespace saucer::utils
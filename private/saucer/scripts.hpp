@@ -10,25 +10,144 @@ namespace saucer::scripts
         internal: 
         {{
             idc: 0,
-            rpc: [],
-            send: async (message, serializer = JSON.stringify) =>
+            rpc: new Map(),
+            structured: false,
+            token: null,
+            batched: null,
+            signal: null,
+            stringify: JSON.stringify,
+            attach: null,
+            send: async (message, serializer = window.saucer.internal.stringify, buffers = [], signal = null, files = []) =>
             {{
+                if (signal?.aborted)
+                {{
+                    throw signal.reason;
+                }}
+
                 const id = ++window.saucer.internal.idc;
 
                 const promise = new Promise((resolve, reject) => {{
-                    window.saucer.internal.rpc[id] = {{
+                    window.saucer.internal.rpc.set(id, {{
                         reject,
                         resolve,
-                    }};
+                    }});
                 }});
 
-                await window.saucer.internal.message(serializer({{
-                    ...message,
-                    id
-                }}));
+                if (signal)
+                {{
+                    window.saucer.internal.abortable(id, signal);
+                }}
+
+                const payload    = {{ ...message, id }};
+                const batched    = window.saucer.internal.batched;
+                const plain      = buffers.length === 0 && files.length === 0;
+                const structured = window.saucer.internal.structured && plain && !batched;
+                const serialized = structured ? payload : serializer(payload);
+
+                if (batched && plain)
+                {{
+                    batched.push(serialized);
+                }}
+                else if (files.length > 0)
+                {{
+                    await window.saucer.internal.attach(serialized, files);
+                }}
+                else if (buffers.length === 0)
+                {{
+                    await window.saucer.internal.message(serialized);
+                }}
+                else
+                {{
+                    await window.saucer.internal.transfer(serialized, buffers);
+                }}
 
                 return promise;
             }},
+            transfer: async (message, buffers) =>
+            {{
+                const header  = buffers.map(buffer => buffer.byteLength ?? buffer.size).join(",");
+                const encoder = new TextEncoder();
+
+                const token = window.saucer.internal.token ?? "";
+                const parts = [token, "\0", header, "\0", message, "\0"];
+                let offset  = token.length + encoder.encode(header).length + encoder.encode(message).length + 3;
+
+                for (const buffer of buffers)
+                {{
+                    const padding = (8 - (offset % 8)) % 8;
+
+                    parts.push(new Uint8Array(padding), buffer);
+                    offset += padding + buffer.byteLength;
+                }}
+
+                const body = new Blob(parts, {{ type: "text/plain" }});
+
+                const response = await fetch("saucer://message/", {{ method: "POST", body }});
+
+                if (!response.ok)
+                {{
+                    throw 'Failed to transfer buffers';
+                }}
+            }},
+            abortable: (id, signal) =>
+            {{
+                window.saucer.internal.send({{ ["saucer:call"]: true, name: `saucer:abortable:${{id}}`, params: [] }});
+
+                signal.addEventListener("abort", () =>
+                {{
+                    const pending = window.saucer.internal.rpc.get(id);
+
+                    if (!pending)
+                    {{
+                        return;
+                    }}
+
+                    window.saucer.internal.rpc.delete(id);
+                    window.saucer.internal.send({{ ["saucer:call"]: true, name: `saucer:abort:${{id}}`, params: [] }});
+
+                    pending.reject(signal.reason);
+                }}, {{ once: true }});
+            }},
+            chunks: new Map(),
+            chunk: (id, part) =>
+            {{
+                const parts = window.saucer.internal.chunks.get(id);
+                parts ? parts.push(part) : window.saucer.internal.chunks.set(id, [part]);
+            }},
+            assemble: (id, resolved) =>
+            {{
+                const text = (window.saucer.internal.chunks.get(id) ?? []).join("");
+                window.saucer.internal.chunks.delete(id);
+
+                let value = undefined;
+
+                try
+                {{
+                    value = JSON.parse(text);
+                }} catch
+                {{
+                    value = (0, eval)(`(${{text}})`);
+                }}
+
+                window.saucer.internal.settle([[id, resolved, value]]);
+            }},
+            settle: (replies) =>
+            {{
+                for (const [id, resolved, value] of replies)
+                {{
+                    const pending = window.saucer.internal.rpc.get(id);
+
+                    if (!pending)
+                    {{
+                        continue;
+                    }}
+
+                    const {{ resolve, reject }} = pending;
+                    window.saucer.internal.rpc.delete(id);
+
+                    resolved ? resolve(value) : reject(value);
+                }}
+            }},
             {0}
         }},
     }};
@@ -44,14 +163,27 @@ namespace saucer::scripts
 
     window.saucer.internal.fire = async (id, message) =>
     {{
-        await window.saucer.internal.message(JSON.stringify({{
+        await window.saucer.internal.message(window.saucer.internal.stringify({{
             [id]: true,
             ...message,
         }}));
     }};
 
+    window.saucer.internal.mirror = (state) =>
+    {{
+        window.saucer.internal.window = {{ ...window.saucer.internal.window, ...state }};
+    }};
+
     {0}
 
+    for (const name of ["maximized", "minimized"])
+    {{
+        const query         = window.saucer[name];
+        window.saucer[name] = async () => window.saucer.internal.window?.[name] ?? await query();
+    }}
+
+    window.saucer.windowState = () => window.saucer.internal.window;
+
     document.addEventListener("mousedown", async ({{ x, y, target, button, detail }}) => 
     {{
         if (button !== 0)
@@ -92,7 +224,11 @@ namespace saucer::scripts
 
         if (has("data-webview-drag"))
         {{
-            await window.saucer.startDrag();
+            if (!window.saucer.internal.regions)
+            {{
+                await window.saucer.startDrag();
+            }}
+
             return;
         }}
 
@@ -110,7 +246,156 @@ namespace saucer::scripts
     }});
     )js";
 
+    static constexpr std::string_view region_script = R"js(
+    window.saucer.internal.regions = true;
+
+    (() =>
+    {
+        const ignored = "[data-webview-ignore], [data-webview-close], [data-webview-minimize], [data-webview-maximize]";
+
+        const style       = document.createElement("style");
+        style.textContent = `[data-webview-drag] { app-region: drag; } ${ignored} { app-region: no-drag; }`;
+
+        const collect = (selector) => [...document.querySelectorAll(selector)].map(elem =>
+        {
+            const { x, y, width, height } = elem.getBoundingClientRect();
+            return [Math.floor(x), Math.floor(y), Math.ceil(width), Math.ceil(height)];
+        });
+
+        let last    = "";
+        let pending = false;
+
+        const report = () =>
+        {
+            if (pending)
+            {
+                return;
+            }
+
+            pending = true;
+
+            requestAnimationFrame(() =>
+            {
+                pending = false;
+
+                const drag   = collect("[data-webview-drag]");
+                const ignore = collect(ignored);
+                const state  = JSON.stringify([drag, ignore]);
+
+                if (state === last)
+                {
+                    return;
+                }
+
+                last = state;
+                window.saucer.setRegions(drag, ignore);
+            });
+        };
+
+        document.addEventListener("DOMContentLoaded", () =>
+        {
+            document.head.append(style);
+
+            new MutationObserver(report).observe(document.documentElement, {
+                subtree: true,
+                childList: true,
+                attributes: true,
+            });
+
+            window.addEventListener("resize", report);
+            document.addEventListener("scroll", report, { capture: true, passive: true });
+
+            report();
+        });
+    })();
+    )js";
+
+    static constexpr std::string_view surface_script = R"js(
+    (() =>
+    {
+        if (self !== top || window.saucer.internal.surfaces)
+        {
+            return;
+        }
+
+        const collect = () => [...document.querySelectorAll("[data-webview-surface]")].flatMap(elem =>
+        {
+            const { x, y, width, height } = elem.getBoundingClientRect();
+
+            if (width <= 0 || height <= 0 || elem.checkVisibility?.() === false)
+            {
+                return [];
+            }
+
+            const bounds = [Math.round(x), Math.round(y), Math.round(width), Math.round(height)];
+            return [{ name: elem.dataset.webviewSurface, bounds }];
+        });
+
+        let last    = "";
+        let pending = false;
+
+        const report = () =>
+        {
+            if (pending)
+            {
+                return;
+            }
+
+            pending = true;
+
+            requestAnimationFrame(() =>
+            {
+                pending = false;
+
+                const entries = collect();
+                const state   = JSON.stringify(entries);
+
+                if (state === last)
+                {
+                    return;
+                }
+
+                last = state;
+
+                window.saucer.internal.message(window.saucer.internal.stringify({
+                    ["saucer:surfaces"]: true,
+                    entries,
+                }));
+            });
+        };
+
+        const observe = () =>
+        {
+            new MutationObserver(report).observe(document.documentElement, {
+                subtree: true,
+                childList: true,
+                attributes: true,
+            });
+
+            window.addEventListener("resize", report);
+            document.addEventListener("scroll", report, { capture: true, passive: true });
+            document.addEventListener("transitionend", report, { capture: true });
+
+            report();
+        };
+
+        window.saucer.internal.surfaces = report;
+
+        if (document.readyState === "loading")
+        {
+            document.addEventListener("DOMContentLoaded", observe, { once: true });
+            return;
+        }
+
+        observe();
+    })();
+    )js";
+
     static constexpr std::string_view bridge_script = R"js(
+    window.saucer.internal.functions  = new Map();
+    window.saucer.internal.prepared   = new Map();
+    window.saucer.internal.serializer = {0};
+
     window.saucer.internal.resolve = async (id, fn) =>
     {{
         let value     = undefined;
@@ -125,15 +410,73 @@ namespace saucer::scripts
             exception = true;
         }}
 
-        await window.saucer.internal.message({0}({{
-                ["saucer:resolve"]: true,
-                id,
-                exception, 
-                result: value === undefined ? null : value,
-        }}));
+        const reply = {{
+            ["saucer:resolve"]: true,
+            id,
+            exception,
+            result: value === undefined ? null : value,
+        }};
+
+        await window.saucer.internal.message(window.saucer.internal.structured ? reply : window.saucer.internal.serializer(reply));
+    }};
+
+    window.saucer.internal.uncompressed = null;
+
+    window.saucer.internal.compress = (threshold) =>
+    {{
+        const original = window.saucer.internal.uncompressed ??= window.saucer.internal.message;
+        window.saucer.internal.message = original;
+
+        if (threshold === null || typeof CompressionStream === "undefined" || typeof DecompressionStream === "undefined")
+        {{
+            return;
+        }}
+
+        window.saucer.internal.message = async (data) =>
+        {{
+            if (typeof data !== "string" || data.length < threshold)
+            {{
+                return original(data);
+            }}
+
+            const stream = new Blob([data]).stream().pipeThrough(new CompressionStream("deflate"));
+            const bytes  = new Uint8Array(await new Response(stream).arrayBuffer());
+
+            let binary = "";
+
+            for (let i = 0; i < bytes.length; i += 0x8000)
+            {{
+                binary += String.fromCharCode(...bytes.subarray(i, i + 0x8000));
+            }}
+
+            return original(`saucer:compressed\n${{btoa(binary)}}`);
+        }};
+
+        window.saucer.call("saucer:compression", []);
     }};
+
+    window.saucer.internal.inflate = async (id, resolved, data) =>
+    {{
+        const bytes  = Uint8Array.from(atob(data), ch => ch.charCodeAt(0));
+        const stream = new Blob([bytes]).stream().pipeThrough(new DecompressionStream("deflate"));
+
+        window.saucer.internal.chunks.set(id, [await new Response(stream).text()]);
+        window.saucer.internal.assemble(id, resolved);
+    }};
+
+    window.saucer.internal.invoke = (id, handle, args) => window.saucer.internal.resolve(id, async () =>
+    {{
+        const prepared = window.saucer.internal.prepared.get(handle);
+
+        if (!prepared)
+        {{
+            throw 'Unknown prepared function';
+        }}
+
+        return prepared(...args);
+    }});
     
-    window.saucer.call = async (name, params) =>
+    window.saucer.call = async (name, params, options = {{}}) =>
     {{
         if (!Array.isArray(params))
         {{
@@ -145,15 +488,838 @@ namespace saucer::scripts
             throw 'Bad name, expected string';
         }}
 
+        const id       = window.saucer.internal.functions.get(name) ?? name;
+        const signal   = options.signal ?? window.saucer.internal.signal;
+        const dispatch = () => window.saucer.internal.dispatch(id, params, signal);
+
+        switch (options.priority)
+        {{
+        case "interactive":
+            return window.saucer.internal.urgent(dispatch);
+        case "background":
+            return window.saucer.internal.idle(dispatch);
+        default:
+            return dispatch();
+        }}
+    }};
+
+    window.saucer.internal.urgent = (callback) =>
+    {{
+        const batched                  = window.saucer.internal.batched;
+        window.saucer.internal.batched = null;
+
+        try
+        {{
+            return callback();
+        }} finally
+        {{
+            window.saucer.internal.batched = batched;
+        }}
+    }};
+
+    window.saucer.internal.idle = (callback) => new Promise(resolve => setTimeout(resolve, 0)).then(callback);
+
+    window.saucer.internal.binary = (value) => value instanceof ArrayBuffer || ArrayBuffer.isView(value);
+
+    window.saucer.internal.file = (value) => value instanceof File || (window.FileSystemHandle && value instanceof FileSystemHandle);
+
+    window.saucer.internal.dispatch = (name, params, signal = window.saucer.internal.signal) =>
+    {{
+        const buffers = [];
+        const files   = [];
+
+        const {{ binary, file }} = window.saucer.internal;
+        const native           = window.saucer.internal.attach && !params.some(binary);
+
+        params = params.map(param =>
+        {{
+            if (binary(param))
+            {{
+                return buffers.push(param) - 1;
+            }}
+
+            if (!file(param))
+            {{
+                return param;
+            }}
+
+            if (native)
+            {{
+                return files.push(param) - 1;
+            }}
+
+            // Without access to the path, a `File` is still streamed from disk as part of the request body instead of being read here
+            return param instanceof Blob ? buffers.push(param) - 1 : param;
+        }});
+
         return window.saucer.internal.send({{
             ["saucer:call"]: true,
             name,
             params,
-        }}, {0});
+        }}, window.saucer.internal.serializer, buffers, signal, files);
     }};
 
-    window.saucer.exposed = new Proxy({{}}, {{
-        get: (_, prop) => (...args) => window.saucer.call(prop, args),
+    window.saucer.internal.define = (name, id, limit = null) =>
+    {{
+        window.saucer.internal.functions.set(name, id);
+
+        const call = async (...params) => window.saucer.internal.dispatch(id, params);
+
+        Object.defineProperty(window.saucer.exposed, name, {{
+            value: limit ? window.saucer.internal.limit(call, limit) : call,
+            configurable: true,
+            enumerable: true,
+        }});
+    }};
+
+    window.saucer.internal.limit = (call, {{ mode, interval }}) =>
+    {{
+        if (mode === "throttle")
+        {{
+            let last = -Infinity;
+
+            return async (...params) =>
+            {{
+                const now = performance.now();
+
+                if (now - last < interval)
+                {{
+                    throw 'Rate limited';
+                }}
+
+                last = now;
+                return call(...params);
+            }};
+        }}
+
+        if (mode === "debounce")
+        {{
+            let timer   = null;
+            let waiting = [];
+
+            return (...params) => new Promise((resolve, reject) =>
+            {{
+                clearTimeout(timer);
+                waiting.push({{ resolve, reject }});
+
+                timer = setTimeout(() =>
+                {{
+                    const settled = waiting;
+                    waiting       = [];
+
+                    call(...params).then(
+                        value => settled.forEach(it => it.resolve(value)),
+                        error => settled.forEach(it => it.reject(error)));
+                }}, interval);
+            }});
+        }}
+
+        const inflight = new Map();
+
+        return (...params) =>
+        {{
+            if (params.some(window.saucer.internal.binary))
+            {{
+                return call(...params);
+            }}
+
+            const key = window.saucer.internal.stringify(params);
+
+            if (!inflight.has(key))
+            {{
+                inflight.set(key, call(...params).finally(() => inflight.delete(key)));
+            }}
+
+            return inflight.get(key);
+        }};
+    }};
+
+    window.saucer.internal.undefine = (name) =>
+    {{
+        delete window.saucer.exposed[name];
+    }};
+
+    window.saucer.internal.stream = (id) =>
+    {{
+        const buffered = [];
+
+        let done  = false;
+        let chain = Promise.resolve();
+
+        const pull = async () =>
+        {{
+            if (buffered.length === 0 && !done)
+            {{
+                try
+                {{
+                    const [values, finished] = await window.saucer.call(`saucer:pull:${{id}}`, []);
+
+                    for (const value of values)
+                    {{
+                        buffered.push(value);
+                    }}
+
+                    done = finished;
+                }} catch (e)
+                {{
+                    done = true;
+                    throw e;
+                }}
+            }}
+
+            if (buffered.length === 0)
+            {{
+                return {{ value: undefined, done: true }};
+            }}
+
+            return {{ value: buffered.shift(), done: false }};
+        }};
+
+        const cancel = async () =>
+        {{
+            if (!done)
+            {{
+                done            = true;
+                buffered.length = 0;
+
+                await window.saucer.call(`saucer:cancel:${{id}}`, []);
+            }}
+
+            return {{ value: undefined, done: true }};
+        }};
+
+        const next = () =>
+        {{
+            const rtn = chain.then(pull);
+            chain     = rtn.catch(() => {{}});
+
+            return rtn;
+        }};
+
+        return {{
+            next,
+            return: cancel,
+            ["saucer:stream"]: id,
+            [Symbol.asyncIterator]() {{ return this; }},
+        }};
+    }};
+
+    window.saucer.internal.patches = [];
+
+    window.saucer.internal.apply = (root, [type, index, count, name, value]) =>
+    {{
+        const child = root.children[index];
+
+        switch (type)
+        {{
+        case 0:
+            root.innerHTML = value;
+            break;
+        case 1:
+            child ? child.insertAdjacentHTML("beforebegin", value) : root.insertAdjacentHTML("beforeend", value);
+            break;
+        case 2:
+            child?.insertAdjacentHTML("afterend", value);
+            child?.remove();
+            break;
+        case 3:
+            for (let i = 0; i < count && root.children[index]; i++)
+            {{
+                root.children[index].remove();
+            }}
+            break;
+        case 4:
+            child && (child.textContent = value);
+            break;
+        case 5:
+            value === null ? child?.removeAttribute(name) : child?.setAttribute(name, value);
+            break;
+        }}
+    }};
+
+    window.saucer.internal.patch = (patches) =>
+    {{
+        const queue     = window.saucer.internal.patches;
+        const scheduled = queue.length > 0;
+
+        for (const patch of patches)
+        {{
+            queue.push(patch);
+        }}
+
+        if (scheduled)
+        {{
+            return;
+        }}
+
+        requestAnimationFrame(() =>
+        {{
+            for (const [target, operations] of queue.splice(0))
+            {{
+                const root = document.getElementById(target);
+
+                if (!root)
+                {{
+                    continue;
+                }}
+
+                for (const operation of operations)
+                {{
+                    window.saucer.internal.apply(root, operation);
+                }}
+            }}
+        }});
+    }};
+
+    window.saucer.internal.topics = new Map();
+
+    window.saucer.internal.emit = (events) =>
+    {{
+        for (const [topic, value] of events)
+        {{
+            const callbacks = window.saucer.internal.topics.get(topic);
+
+            if (!callbacks)
+            {{
+                continue;
+            }}
+
+            for (const callback of callbacks)
+            {{
+                try
+                {{
+                    callback(value);
+                }} catch (e)
+                {{
+                    console.error(e);
+                }}
+            }}
+        }}
+    }};
+
+    window.saucer.subscribe = (topic, callback) =>
+    {{
+        const topics = window.saucer.internal.topics;
+
+        if (!topics.has(topic))
+        {{
+            topics.set(topic, new Set());
+            window.saucer.call(`saucer:subscribe:${{topic}}`, []);
+        }}
+
+        topics.get(topic).add(callback);
+
+        return () =>
+        {{
+            const callbacks = topics.get(topic);
+
+            if (!callbacks?.delete(callback) || callbacks.size > 0)
+            {{
+                return;
+            }}
+
+            topics.delete(topic);
+            window.saucer.call(`saucer:unsubscribe:${{topic}}`, []);
+        }};
+    }};
+
+    window.saucer.internal.shared = async (topic, id) =>
+    {{
+        const response = await fetch(`saucer://buffer/${{id}}`);
+        window.saucer.internal.emit([[topic, await response.arrayBuffer()]]);
+    }};
+
+    window.chrome?.webview?.addEventListener("sharedbufferreceived", (event) =>
+    {{
+        const topic = event.additionalData?.["saucer:topic"];
+
+        if (topic === undefined)
+        {{
+            return;
+        }}
+
+        window.saucer.internal.emit([[topic, event.getBuffer()]]);
     }});
+
+    window.saucer.internal.channels = new Map();
+
+    window.saucer.internal.pull = (name) =>
+    {{
+        const channel = window.saucer.internal.channels.get(name);
+
+        if (!channel)
+        {{
+            return window.saucer.channel(name);
+        }}
+
+        channel.pull();
+    }};
+
+    window.saucer.channel = (name) =>
+    {{
+        const channels = window.saucer.internal.channels;
+
+        if (channels.has(name))
+        {{
+            return channels.get(name);
+        }}
+
+        const backlog = [];
+
+        let receiver = null;
+        let outgoing = null;
+        let sending  = Promise.resolve();
+        let pulling  = Promise.resolve();
+
+        const deliver = (message) =>
+        {{
+            if (!receiver)
+            {{
+                return backlog.push(message);
+            }}
+
+            try
+            {{
+                receiver(message);
+            }} catch (e)
+            {{
+                console.error(e);
+            }}
+        }};
+
+        const flush = async (parts) =>
+        {{
+            const response = await fetch(`saucer://channel/${{name}}`, {{ method: "POST", body: new Blob(parts) }});
+
+            if (!response.ok)
+            {{
+                throw 'Failed to send frames';
+            }}
+        }};
+
+        const channel = {{
+            get onmessage()
+            {{
+                return receiver;
+            }},
+            set onmessage(callback)
+            {{
+                receiver = callback;
+
+                for (const message of backlog.splice(0))
+                {{
+                    deliver(message);
+                }}
+            }},
+            send: (data) =>
+            {{
+                const size = new DataView(new ArrayBuffer(4));
+                size.setUint32(0, data.byteLength, true);
+
+                if (outgoing)
+                {{
+                    outgoing.parts.push(size, data);
+                    return outgoing.sent;
+                }}
+
+                // Frames sent while a batch is in flight are collected into the next one, which keeps them in order
+                const batch = outgoing = {{ parts: [size, data] }};
+                batch.sent  = sending.then(() => {{ outgoing = null; return flush(batch.parts); }});
+                sending     = batch.sent.catch(() => {{}});
+
+                return batch.sent;
+            }},
+            pull: () =>
+            {{
+                pulling = pulling.then(async () =>
+                {{
+                    const buffer = await (await fetch(`saucer://channel/${{name}}`)).arrayBuffer();
+                    const view   = new DataView(buffer);
+
+                    for (let offset = 0; offset + 4 <= buffer.byteLength;)
+                    {{
+                        const size = view.getUint32(offset, true);
+                        offset += 4;
+
+                        deliver(buffer.slice(offset, offset + size));
+                        offset += size;
+                    }}
+                }}).catch(console.error);
+            }},
+        }};
+
+        channels.set(name, channel);
+        channel.pull();
+
+        return channel;
+    }};
+
+    window.saucer.internal.relay = (port) =>
+    {{
+        const reply = (id, resolved, value, stream) =>
+        {{
+            try
+            {{
+                port.postMessage({{ id, resolved, value, stream }});
+            }} catch (e)
+            {{
+                port.postMessage({{ id, resolved: false, value: `${{e}}` }});
+            }}
+        }};
+
+        const handle = async ({{ id, kind, name, params, payload, priority }}) =>
+        {{
+            if (kind === "channel")
+            {{
+                const channel     = window.saucer.channel(name);
+                channel.onmessage = (message) => port.postMessage({{ kind: "frame", name, payload: message }}, [message]);
+
+                return;
+            }}
+
+            try
+            {{
+                const channel = kind === "send" ? window.saucer.channel(name) : null;
+                const value   = await (channel ? channel.send(payload) : window.saucer.call(name, params, {{ priority }}));
+                const stream  = value?.["saucer:stream"];
+
+                reply(id, true, stream === undefined ? value : null, stream);
+            }} catch (e)
+            {{
+                reply(id, false, e);
+            }}
+        }};
+
+        port.addEventListener("message", ({{ data }}) => handle(data));
+        port.start();
+    }};
+
+    window.saucer.internal.remote = (scope) =>
+    {{
+        const pending  = new Map();
+        const channels = new Map();
+        const queued   = [];
+
+        let idc  = 0;
+        let port = null;
+
+        const post = (message) => port ? port.postMessage(message) : queued.push(message);
+
+        const request = (message) => new Promise((resolve, reject) =>
+        {{
+            const id = ++idc;
+
+            pending.set(id, {{ resolve, reject }});
+            post({{ ...message, id }});
+        }});
+
+        const receive = ({{ data }}) =>
+        {{
+            if (data.kind === "frame")
+            {{
+                return channels.get(data.name)?.deliver(data.payload);
+            }}
+
+            const entry = pending.get(data.id);
+
+            if (!entry)
+            {{
+                return;
+            }}
+
+            pending.delete(data.id);
+
+            if (!data.resolved)
+            {{
+                return entry.reject(data.value);
+            }}
+
+            entry.resolve(data.stream === undefined ? data.value : saucer.internal.stream(data.stream));
+        }};
+
+        // The relay port is handed over with the first message, calls made before it arrives are queued
+        const attach = (event) =>
+        {{
+            if (!event.data?.["saucer:port"])
+            {{
+                return;
+            }}
+
+            event.stopImmediatePropagation();
+
+            port           = event.ports[0];
+            port.onmessage = receive;
+
+            for (const message of queued.splice(0))
+            {{
+                port.postMessage(message);
+            }}
+        }};
+
+        scope.addEventListener("message", attach);
+
+        scope.addEventListener("connect", (event) =>
+        {{
+            const [connection] = event.ports;
+
+            connection.addEventListener("message", attach);
+            connection.start();
+        }});
+
+        const channel = (name) =>
+        {{
+            if (channels.has(name))
+            {{
+                return channels.get(name);
+            }}
+
+            const backlog = [];
+            let receiver  = null;
+
+            const rtn = {{
+                get onmessage()
+                {{
+                    return receiver;
+                }},
+                set onmessage(callback)
+                {{
+                    receiver = callback;
+
+                    for (const message of backlog.splice(0))
+                    {{
+                        rtn.deliver(message);
+                    }}
+                }},
+                send: (data) => request({{ kind: "send", name, payload: data }}),
+                deliver: (message) =>
+                {{
+                    if (!receiver)
+                    {{
+                        return backlog.push(message);
+                    }}
+
+                    try
+                    {{
+                        receiver(message);
+                    }} catch (e)
+                    {{
+                        console.error(e);
+                    }}
+                }},
+            }};
+
+            channels.set(name, rtn);
+            post({{ kind: "channel", name }});
+
+            return rtn;
+        }};
+
+        const call = async (name, params, options = {{}}) =>
+        {{
+            if (!Array.isArray(params))
+            {{
+                throw 'Bad arguments, expected array';
+            }}
+
+            return request({{ kind: "call", name: `${{name}}`, params, priority: options.priority }});
+        }};
+
+        const saucer = {{
+            call,
+            channel,
+            internal: {{}},
+            exposed: new Proxy({{}}, {{ get: (_, prop) => (...args) => call(prop, args) }}),
+        }};
+
+        return saucer;
+    }};
+
+    window.saucer.internal.bootstrap = () => [
+        "(() =>",
+        "{{",
+        `    const window = {{ saucer: (${{window.saucer.internal.remote}})(self) }};`,
+        `    window.saucer.internal.stream = ${{window.saucer.internal.stream}};`,
+        "    self.saucer = window.saucer;",
+        "}})();",
+    ].join("\n");
+
+    window.saucer.internal.scripts = new Map();
+
+    window.saucer.internal.script = (url, options) =>
+    {{
+        const source = new URL(url, location.href).href;
+        const module = options?.type === "module";
+        const key    = `${{module}}:${{source}}`;
+
+        if (window.saucer.internal.scripts.has(key))
+        {{
+            return window.saucer.internal.scripts.get(key);
+        }}
+
+        const load = module ? `await import(${{JSON.stringify(source)}});` : `importScripts(${{JSON.stringify(source)}});`;
+        const blob = new Blob([window.saucer.internal.bootstrap(), "\n", load], {{ type: "text/javascript" }});
+        const rtn  = URL.createObjectURL(blob);
+
+        window.saucer.internal.scripts.set(key, rtn);
+
+        return rtn;
+    }};
+
+    window.saucer.internal.connect = (target) =>
+    {{
+        const {{ port1, port2 }} = new MessageChannel();
+
+        window.saucer.internal.relay(port1);
+        target.postMessage({{ ["saucer:port"]: true }}, [port2]);
+    }};
+
+    window.saucer.Worker = class extends Worker
+    {{
+        constructor(url, options)
+        {{
+            super(window.saucer.internal.script(url, options), options);
+            window.saucer.internal.connect(this);
+        }}
+    }};
+
+    if (window.SharedWorker)
+    {{
+        window.saucer.SharedWorker = class extends SharedWorker
+        {{
+            constructor(url, options)
+            {{
+                super(window.saucer.internal.script(url, typeof options === "string" ? {{ name: options }} : options), options);
+                window.saucer.internal.connect(this.port);
+            }}
+        }};
+    }}
+
+    window.saucer.batch = (callback) =>
+    {{
+        if (window.saucer.internal.batched)
+        {{
+            return callback();
+        }}
+
+        const batched = window.saucer.internal.batched = [];
+
+        try
+        {{
+            return callback();
+        }} finally
+        {{
+            window.saucer.internal.batched = null;
+
+            if (batched.length > 0)
+            {{
+                window.saucer.internal.message(`saucer:batch\n${{batched.join("\n")}}`);
+            }}
+        }}
+    }};
+
+    window.saucer.abortable = (signal, callback) =>
+    {{
+        const previous                = window.saucer.internal.signal;
+        window.saucer.internal.signal = signal;
+
+        try
+        {{
+            return callback();
+        }} finally
+        {{
+            window.saucer.internal.signal = previous;
+        }}
+    }};
+
+    window.saucer.exposed = Object.create(new Proxy({{}}, {{
+        get: (_, prop) => (...args) => window.saucer.call(prop, args),
+    }}));
+    )js";
+
+    static constexpr std::string_view timing_script = R"js(
+    (() =>
+    {
+        const resources = [];
+        const observer  = new PerformanceObserver((list) =>
+        {
+            for (const entry of list.getEntries())
+            {
+                resources.push({
+                    name: entry.name,
+                    type: entry.initiatorType,
+                    start: entry.startTime,
+                    duration: entry.duration,
+                    size: entry.transferSize ?? 0,
+                });
+            }
+        });
+
+        observer.observe({ type: "resource", buffered: true });
+
+        // The load event has to finish before `loadEventEnd` is populated
+        window.addEventListener("load", () => setTimeout(() =>
+        {
+            observer.disconnect();
+
+            const [navigation] = performance.getEntriesByType("navigation");
+
+            if (!navigation)
+            {
+                return;
+            }
+
+            window.saucer.internal.message(window.saucer.internal.stringify({
+                ["saucer:timing"]: true,
+                dns: navigation.domainLookupEnd - navigation.domainLookupStart,
+                connect: navigation.connectEnd - navigation.connectStart,
+                ttfb: navigation.responseStart,
+                dom_content_loaded: navigation.domContentLoadedEventEnd,
+                load: navigation.loadEventEnd,
+                resources,
+            }));
+        }), { once: true });
+    })();
+    )js";
+
+    static constexpr std::string_view heap_script = "performance.memory?.usedJSHeapSize ?? null";
+
+    static constexpr std::string_view lazy_script = R"js(
+    (() =>
+    {{
+        if (self === top)
+        {{
+            return;
+        }}
+
+        const lazy = (self.__saucer_lazy ??= {{ pending: [], attached: false }});
+
+        if (lazy.attached)
+        {{
+            (0, eval)({0});
+            return;
+        }}
+
+        if (lazy.pending.push({0}) > 1)
+        {{
+            return;
+        }}
+
+        const attach = () =>
+        {{
+            delete self.saucer;
+            lazy.attached = true;
+
+            for (const code of lazy.pending.splice(0))
+            {{
+                (0, eval)(code);
+            }}
+        }};
+
+        Object.defineProperty(self, "saucer", {{
+            configurable: true,
+            get: () => (attach(), self.saucer),
+            set: (value) => (attach(), self.saucer = value),
+        }});
+    }})();
     )js";
 } // namespace saucer::scripts
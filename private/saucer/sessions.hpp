@@ -0,0 +1,24 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace saucer::utils
+{
+    // Webviews that name the same session share its engine state, which is released together with the last of them
+    template <typename T>
+    class sessions
+    {
+        std::unordered_map<std::string, std::weak_ptr<T>> m_sessions;
+
+      public:
+        [[nodiscard]] std::shared_ptr<T> find(const std::string &);
+
+      public:
+        template <typename Callback>
+        std::shared_ptr<T> join(const std::string &, Callback &&make);
+    };
+} // namespace saucer::utils
+
+#include "sessions.inl"
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "sessions.hpp"
+
+namespace saucer::utils
+{
+    template <typename T>
+    std::shared_ptr<T> sessions<T>::find(const std::string &name)
+    {
+        auto it = m_sessions.find(name);
+
+        if (it == m_sessions.end())
+        {
+            return nullptr;
+        }
+
+        return it->second.lock();
+    }
+
+    template <typename T>
+    template <typename Callback>
+    std::shared_ptr<T> sessions<T>::join(const std::string &name, Callback &&make)
+    {
+        if (auto rtn = find(name); rtn)
+        {
+            return rtn;
+        }
+
+        auto release = [this, name](T *value)
+        {
+            m_sessions.erase(name);
+            delete value;
+        };
+
+        auto rtn = std::shared_ptr<T>{new T{std::forward<Callback>(make)()}, release};
+        m_sessions.insert_or_assign(name, rtn);
+
+        return rtn;
+    }
+} // namespace saucer::utils
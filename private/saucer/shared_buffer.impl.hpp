@@ -0,0 +1,20 @@
+#pragma once
+
+#include <saucer/shared_buffer.hpp>
+
+#include <vector>
+
+namespace saucer
+{
+    struct shared_buffer::impl
+    {
+        std::span<std::uint8_t> data;
+
+      public:
+        std::vector<std::uint8_t> storage;
+        std::shared_ptr<void> handle;
+
+      public:
+        static shared_buffer host(std::size_t);
+    };
+} // namespace saucer
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+namespace saucer::utils
+{
+    // A single consumer message queue in named shared memory. Pushes are serialized by a process-local mutex, so there may
+    // only ever be one producing process per ring.
+    class shm_ring
+    {
+        struct native;
+
+      private:
+        std::unique_ptr<native> m_native;
+
+      private:
+        shm_ring();
+
+      public:
+        ~shm_ring();
+
+      public:
+        // The creator owns the name, it is released again once the ring is destroyed
+        static std::unique_ptr<shm_ring> create(const std::string &name, std::size_t capacity);
+        static std::unique_ptr<shm_ring> open(const std::string &name);
+
+      public:
+        // Waits (at most `timeout`) for space while the ring is full, fails once it was closed or if the message exceeds its capacity
+        bool push(std::string_view, std::chrono::milliseconds timeout = std::chrono::milliseconds{250});
+
+        // Waits for the next message, there is none once the ring was closed and drained. Corrupt frames close the ring.
+        std::optional<std::string> pop();
+
+      public:
+        // Visible to both processes, wakes a waiting consumer
+        void close();
+    };
+} // namespace saucer::utils
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <saucer/app.hpp>
+
+#include <cstdint>
+
+namespace saucer::utils
+{
+    enum class thread_role : std::uint8_t
+    {
+        worker,
+        helper,
+    };
+
+    void configure(thread_options workers, thread_options helpers);
+
+    [[nodiscard]] thread_options thread_config(thread_role);
+    void apply(thread_role);
+} // namespace saucer::utils
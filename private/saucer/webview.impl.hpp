@@ -1,13 +1,53 @@
 #pragma once
 
 #include <saucer/webview.hpp>
+#include <saucer/asset_store.hpp>
+
+#include "pool.hpp"
+#include "lease.hpp"
+#include "permission_cache.hpp"
+
+#include <set>
+#include <map>
+#include <array>
+#include <mutex>
+#include <vector>
+#include <functional>
+#include <unordered_map>
 
 namespace saucer
 {
+    namespace request
+    {
+        struct timing;
+    } // namespace request
+
     struct webview::impl
     {
         struct native;
 
+      public:
+        struct embedded_entry
+        {
+            std::string path;
+            embedded_file file;
+            std::string etag;
+        };
+
+      public:
+        struct lazy_entry
+        {
+            std::size_t stub;
+            bool clearable;
+        };
+
+      public:
+        struct surface
+        {
+            void *handle;
+            layer position;
+        };
+
       public:
         std::shared_ptr<saucer::window> window;
 
@@ -17,10 +57,88 @@ namespace saucer
 
       public:
         bool attributes;
-        embedded_files embedded;
+        bool regions{false};
+        std::vector<std::array<int, 4>> drag_regions;
+        std::vector<std::array<int, 4>> ignore_regions;
+
+      public:
+        std::map<std::string, embedded_entry, std::less<>> embedded;
+        std::vector<embedded_bundle> bundles;
+        std::vector<asset_store> stores;
+        std::optional<fs::path> directory;
+
+      public:
+        std::string cache_control;
+
+      public:
+        bool ruled{false};
+        std::vector<navigation_rule> rules;
+
+      public:
+        std::shared_ptr<utils::permission_cache> permissions;
+
+      public:
+        bool frame_bridge{false};
+        std::unordered_map<std::size_t, lazy_entry> lazy_scripts;
+
+      public:
+        // Only handed to the documents that get the bridge, `saucer://message/` refuses requests that do not carry it
+        std::string bridge_token;
+
+      public:
+        std::optional<std::size_t> surface_observer;
+        std::unordered_map<std::string, surface> surfaces;
+        std::unordered_map<std::string, saucer::bounds> surface_bounds;
+
+      public:
+        std::function<status(std::string_view)> on_rpc;
+        std::function<status(std::string_view, std::vector<stash>)> on_buffers;
+        std::function<status(std::string_view, std::vector<fs::path>)> on_files;
+
+      public:
+        static constexpr auto chunk_size = 1024uz * 1024;
+
+      public:
+        std::string batched;
+        std::optional<std::chrono::milliseconds> batch_window;
+
+      public:
+        // Set by the smartview once compression is configured, returns the packed (base64) payload or nothing to send it as is
+        std::function<std::optional<std::string>(std::string_view)> compress;
+
+      public:
+        static constexpr auto inline_html = 512uz * 1024;
+
+      public:
+        std::size_t document_counter{0};
+        std::optional<stash> document;
+
+      public:
+        static constexpr auto title_interval = std::chrono::milliseconds{16};
+
+      public:
+        bool title_pending{false};
+        std::string last_title;
+
+      public:
+        bool suspended{false};
+        std::optional<std::size_t> on_minimize;
+        std::optional<std::size_t> on_memory;
+        std::vector<std::pair<window::event, std::size_t>> mirrored;
+
+      public:
+        std::size_t shared_counter{0};
+        std::unordered_map<std::size_t, shared_buffer> shared;
+
+      public:
+        std::unordered_map<std::string, std::shared_ptr<channel::state>> channels;
 
       public:
         std::unique_ptr<native> platform;
+        utils::lease<webview::impl *> lease;
+
+      public:
+        std::unordered_map<std::string, std::unique_ptr<utils::pool>> strands;
 
       public:
         impl();
@@ -35,14 +153,51 @@ namespace saucer
         template <event Event>
         void setup();
 
+      public:
+        void unsubscribe();
+        void process_gone(termination, bool recoverable = true);
+        void title_changed();
+
+      public:
+        [[nodiscard]] const embedded_entry *find(std::string_view) const;
+        [[nodiscard]] std::shared_ptr<const embedded_entry> lookup(std::string_view) const;
+
+      public:
+        void erase(std::string_view);
+        void merge(std::vector<embedded_entry>);
+        void retag(std::string_view, const stash &, std::string);
+        const embedded_entry *load(std::string_view);
+        const embedded_entry *unpack(std::string_view);
+
+      public:
+        [[nodiscard]] std::optional<policy> decide(const navigation &) const;
+        bool blocked(const navigation &);
+
+      public:
+        static scheme::response acknowledge(const scheme::request &);
+
       public:
         void handle_embed(const scheme::request &, const scheme::executor &);
+        void handle_buffers(const scheme::request &, const scheme::executor &);
+        void handle_shared(const scheme::request &, const scheme::executor &);
+        void handle_channel(const scheme::request &, const scheme::executor &);
+        void handle_document(const scheme::request &, const scheme::executor &);
         void handle_scheme(const std::string &, scheme::resolver &&);
         void handle_stream_scheme(const std::string &, scheme::stream_resolver &&);
 
       public:
-        void reject(std::size_t, std::string_view);
-        void resolve(std::size_t, std::string_view);
+        [[nodiscard]] scheme::resolver offload(const std::string &, scheme::resolver, launch);
+        [[nodiscard]] static scheme::resolver instrument(scheme::resolver);
+        [[nodiscard]] static std::string make_token();
+
+      public:
+        void reject(std::size_t, std::string);
+        void resolve(std::size_t, std::string);
+
+      public:
+        void flush();
+        void settle(std::size_t, bool, std::string);
+        void chunk(std::size_t, bool, std::string_view);
 
       public:
         [[nodiscard]] saucer::url url() const;
@@ -65,6 +220,13 @@ namespace saucer
       public:
         void set_url(const saucer::url &);
         void set_html(cstring_view);
+        void set_html(stash);
+
+      public:
+        void serve_directory(const fs::path &, const std::string &);
+
+      public:
+        void set_content_rules(std::vector<std::string>);
 
       public:
         void set_dev_tools(bool);
@@ -78,6 +240,22 @@ namespace saucer
         void reset_bounds();
         void set_bounds(saucer::bounds);
 
+      public:
+        void attach_surface(std::string, void *, layer);
+        void detach_surface(const std::string &);
+        void place_surfaces();
+
+      public:
+        // Bounds are relative to the webview, surfaces without any are hidden
+        void add_surface(void *, layer);
+        void remove_surface(void *);
+        void move_surface(void *, std::optional<saucer::bounds>);
+
+      public:
+        void suspend(bool);
+        void set_suspended(bool);
+        void set_memory_target(memory_target);
+
       public:
         void back();
         void forward();
@@ -89,6 +267,28 @@ namespace saucer
         void execute(cstring_view);
         std::size_t inject(const script &);
 
+      public:
+        void evaluate_raw(cstring_view, coco::promise<result<std::string>>);
+        void capture(std::optional<saucer::size>, coco::promise<result<icon>>);
+        void memory_stats(coco::promise<memory_usage>);
+        void devtools_protocol(const std::string &, const std::string &, coco::promise<result<std::string>>);
+
+      public:
+        // Engines write cookies from their network process and report back per cookie, the promise settles once the last one did.
+        // Site data is grouped by registrable domain, so clearing an origin looks its records up first (see `same_site`).
+        void set_cookies(std::vector<cookie>, coco::promise<result<>>);
+        void clear_data(const site_data &, coco::promise<result<>>);
+
+      public:
+        result<shared_buffer> create_buffer(std::size_t);
+
+      public:
+        result<channel> open_channel(std::string);
+
+      public:
+        void share(const shared_buffer &, std::string_view);
+        void share_fallback(const shared_buffer &, std::string_view);
+
       public:
         void uninject();
         void uninject(std::size_t);
@@ -98,12 +298,60 @@ namespace saucer
         void remove_stream_scheme(const std::string &);
         static void register_scheme(const std::string &);
 
+      public:
+        static void prewarm(const application::options &);
+
+      public:
+        [[nodiscard]] bool remembered(const permission::request &) const;
+        [[nodiscard]] std::move_only_function<void(bool)> recorder(const permission::request &) const;
+
+      public:
+        void mirror();
+        [[nodiscard]] bool draggable(double x, double y) const;
+
       public:
         status on_message(std::string_view);
+        void dispatch(std::string_view);
+        void dispatch(std::string_view, std::vector<fs::path>);
+        void report(request::timing);
+
+      public:
+        static std::string etag(const stash &);
+        static const stash *compressed(const embedded_file &);
+
+      public:
+        static const std::string &ready_script();
+        static const std::string &creation_script();
+        static const std::string &attribute_script();
+        static const std::string &region_script();
+        static const std::string &surface_script();
+        static std::string lazy_script(std::string_view);
+
+      public:
+        static std::string content_pattern(std::string_view);
+        static std::string content_rule_list(const std::vector<std::string> &);
+        static saucer::size fit(saucer::size, saucer::size);
+        static std::set<std::string> chromium_flags(const options &);
+        static options headless(options);
+
+      public:
+        static std::optional<std::string> origin_host(const std::string &);
+        static bool same_site(std::string_view host, std::string_view domain);
+    };
+
+    struct webview::channel::state
+    {
+        std::string name;
+        application *parent;
+        utils::rental<webview::impl *> owner;
+
+      public:
+        std::mutex mutex;
+        bool closed{false};
+        bool scheduled{false};
 
       public:
-        static std::string ready_script();
-        static std::string creation_script();
-        static std::string attribute_script();
+        std::vector<std::uint8_t> pending;
+        std::function<void(stash)> receiver;
     };
 } // namespace saucer
@@ -40,18 +40,4 @@ namespace saucer
         static constexpr auto WM_SAFE_CALL                 = WM_USER + 1;
         static inline const utils::atom_handle ATOM_WINDOW = GlobalAddAtomW(L"saucer-window");
     };
-
-    class safe_message
-    {
-        using callback_t = std::move_only_function<void()>;
-
-      private:
-        callback_t m_callback;
-
-      public:
-        safe_message(callback_t callback);
-
-      public:
-        ~safe_message();
-    };
 } // namespace saucer
@@ -2,6 +2,8 @@
 
 #include <saucer/icon.hpp>
 
+#include "encoded.hpp"
+
 #include <windows.h>
 #include <gdiplus.h>
 
@@ -10,5 +12,6 @@ namespace saucer
     struct icon::impl
     {
         std::shared_ptr<Gdiplus::Bitmap> bitmap;
+        utils::encoded png{};
     };
 } // namespace saucer
@@ -57,11 +57,16 @@ namespace saucer::utils
     void set_immersive_dark(HWND, bool);
     void extend_frame(HWND, std::array<int, 4>);
 
+    [[nodiscard]] bool wait_for_vblank();
+
     [[nodiscard]] OSVERSIONINFOEXW version();
 
     [[nodiscard]] std::wstring widen(std::string_view);
     [[nodiscard]] std::string narrow(std::wstring_view);
 
+    void widen(std::string_view, std::wstring &);
+    void narrow(std::wstring_view, std::string &);
+
     [[nodiscard]] std::vector<std::uint8_t> read(IStream *);
 
     [[nodiscard]] result<dispatch_controller> create_dispatch_controller();
@@ -4,6 +4,8 @@
 
 #include "win32.utils.hpp"
 
+#include <atomic>
+#include <thread>
 #include <optional>
 
 #include <windows.h>
@@ -56,6 +58,10 @@ namespace saucer
         utils::handle<HICON, DestroyIcon> icon;
         std::optional<saucer::size> max_size, min_size;
 
+      public:
+        std::jthread frame_thread;
+        std::atomic<bool> frame_pending{false};
+
       public:
         template <mode>
         [[nodiscard]] saucer::size scale(saucer::size) const;
@@ -2,6 +2,10 @@
 
 #include <saucer/window.hpp>
 
+#include "lease.hpp"
+
+#include <atomic>
+
 namespace saucer
 {
     struct window::impl
@@ -11,6 +15,14 @@ namespace saucer
       public:
         application *parent;
         window::events events;
+        utils::lease<window::impl *> lease;
+
+      public:
+        std::atomic<bool> coalesce_resize{false};
+        bool resize_pending{false};
+
+      public:
+        bool offscreen{false};
 
       public:
         std::unique_ptr<native> platform;
@@ -28,6 +40,9 @@ namespace saucer
         template <event Event>
         void setup();
 
+      public:
+        void resized(int width, int height);
+
       public:
         [[nodiscard]] bool visible() const;
         [[nodiscard]] bool focused() const;
@@ -99,5 +114,8 @@ namespace saucer
 
       public:
         void set_position(saucer::position);
+
+      public:
+        void apply(const properties &);
     };
 } // namespace saucer
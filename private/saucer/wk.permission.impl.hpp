@@ -4,6 +4,8 @@
 
 #include "cocoa.utils.hpp"
 
+#include <functional>
+
 #import <WebKit/WebKit.h>
 
 namespace saucer::permission
@@ -17,5 +19,8 @@ namespace saucer::permission
 
       public:
         WKMediaCaptureType type;
+
+      public:
+        std::move_only_function<void(bool)> decided;
     };
 } // namespace saucer::permission
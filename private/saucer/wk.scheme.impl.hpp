@@ -3,6 +3,7 @@
 #include <saucer/scheme.hpp>
 
 #include "cocoa.utils.hpp"
+#include "metrics.impl.hpp"
 
 #import <WebKit/WebKit.h>
 #include <lockpp/lock.hpp>
@@ -14,6 +15,11 @@ namespace saucer::scheme
     struct request::impl
     {
         task_ref task;
+
+      public:
+        std::size_t offset{0};
+        utils::objc_ptr<NSInputStream> stream;
+        std::optional<std::map<std::string, std::string>> headers;
     };
 
     struct stream_writer::impl
@@ -23,6 +29,9 @@ namespace saucer::scheme
         NSUInteger handle;
         std::atomic<bool> started{false};
         std::atomic<bool> finished{false};
+
+      public:
+        utils::tracked active{utils::metrics::get().stream_writers};
     };
 } // namespace saucer::scheme
 
@@ -2,7 +2,10 @@
 
 #include "webview.impl.hpp"
 
+#include "hash.hpp"
+#include "sessions.hpp"
 #include "cocoa.utils.hpp"
+#include "script_cache.hpp"
 #include "wk.scheme.impl.hpp"
 #include "cocoa.window.impl.hpp"
 
@@ -22,6 +25,7 @@ namespace saucer
     {
         utils::objc_ptr<WKWebViewConfiguration> config;
         utils::objc_ptr<WKWebView> web_view;
+        std::shared_ptr<utils::objc_ptr<WKWebsiteDataStore>> session;
 
       public:
         utils::objc_ptr<UIDelegate> ui_delegate;
@@ -53,12 +57,20 @@ namespace saucer
       public:
         void inject(const script &) const;
 
+      public:
+        static std::shared_ptr<utils::objc_ptr<WKWebsiteDataStore>> ephemeral_store(const std::optional<std::string> &);
+        static inline utils::sessions<utils::objc_ptr<WKWebsiteDataStore>> sessions;
+
+      public:
+        static utils::objc_ptr<WKUserScript> compile(const script &);
+        static inline utils::script_cache<utils::objc_ptr<WKUserScript>> compiled;
+
       public:
         static WKWebViewConfiguration *make_config(const options &);
         static NSUUID *data_store_id(const options &, const std::string &);
 
       public:
-        static inline std::unordered_map<std::string, utils::objc_ptr<SchemeHandler>> schemes;
+        static inline utils::string_map<utils::objc_ptr<SchemeHandler>> schemes;
     };
 } // namespace saucer
 
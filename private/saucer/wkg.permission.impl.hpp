@@ -4,6 +4,8 @@
 
 #include "gtk.utils.hpp"
 
+#include <functional>
+
 #include <webkit/webkit.h>
 
 namespace saucer::permission
@@ -15,5 +17,8 @@ namespace saucer::permission
       public:
         saucer::url url;
         permission::type type;
+
+      public:
+        std::move_only_function<void(bool)> decided;
     };
 } // namespace saucer::permission
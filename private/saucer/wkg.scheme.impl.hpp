@@ -1,18 +1,34 @@
 #pragma once
 
+#include <mutex>
+#include <deque>
 #include <atomic>
+#include <vector>
+#include <variant>
 
 #include <saucer/scheme.hpp>
 
+#include "handle.hpp"
 #include "gtk.utils.hpp"
+#include "metrics.impl.hpp"
 
+#include <unistd.h>
 #include <webkit/webkit.h>
 
 namespace saucer::scheme
 {
     struct request::impl
     {
-        utils::g_object_ptr<WebKitURISchemeRequest> request;
+        std::string url;
+        std::string method;
+        std::vector<std::uint8_t> body;
+        std::map<std::string, std::string> headers;
+
+      public:
+        std::size_t offset{0};
+
+      public:
+        static impl from(WebKitURISchemeRequest *);
     };
 
     class handler
@@ -39,13 +55,55 @@ namespace saucer::scheme
         static void handle(WebKitURISchemeRequest *, stream_handler *);
     };
 
+    struct file_segment
+    {
+        utils::handle<int, ::close, -1> fd;
+
+      public:
+        std::size_t offset;
+        std::size_t remaining;
+    };
+
     struct stream_writer::impl
     {
+        using chunk = std::variant<stash, file_segment>;
+
+      public:
+        // Unless the response asks for a different capacity, this is how much may be queued before writes saturate
+        static constexpr auto default_limit = 1024uz * 1024;
+
+      public:
         utils::g_object_ptr<WebKitURISchemeRequest> request;
-        int write_fd{-1};
         std::atomic<bool> started{false};
         std::atomic<bool> finished{false};
 
+      public:
+        std::mutex mutex;
+        int write_fd{-1};
+        guint source{0};
+        bool closing{false};
+
+      public:
+        std::deque<chunk> pending;
+        std::size_t offset{0};
+
+      public:
+        std::size_t queued{0};
+        std::size_t limit{default_limit};
+
+      public:
+        utils::tracked active{utils::metrics::get().stream_writers};
+
+      public:
         ~impl();
+
+      public:
+        bool flush();
+        void close();
+        void drop();
+
+      public:
+        ssize_t transfer(chunk &);
+        bool advance(chunk &, std::size_t);
     };
 } // namespace saucer::scheme
@@ -2,7 +2,10 @@
 
 #include "webview.impl.hpp"
 
+#include "hash.hpp"
+#include "sessions.hpp"
 #include "gtk.utils.hpp"
+#include "script_cache.hpp"
 #include "wkg.scheme.impl.hpp"
 
 #include <vector>
@@ -13,6 +16,8 @@ namespace saucer
 {
     using script_ptr          = utils::ref_ptr<WebKitUserScript, webkit_user_script_ref, webkit_user_script_unref>;
     using content_manager_ptr = utils::g_object_ptr<WebKitUserContentManager>;
+    using content_filter_ptr  = utils::ref_ptr<WebKitUserContentFilter, webkit_user_content_filter_ref, webkit_user_content_filter_unref>;
+    using soup_cookie_ptr     = utils::handle<SoupCookie *, soup_cookie_free>;
 
     struct wkg_script
     {
@@ -31,6 +36,7 @@ namespace saucer
       public:
         content_manager_ptr manager;
         utils::g_object_ptr<WebKitSettings> settings;
+        std::shared_ptr<utils::g_object_ptr<WebKitNetworkSession>> session;
 
       public:
         std::size_t id_counter{0};
@@ -43,6 +49,7 @@ namespace saucer
       public:
         std::size_t id_context;
         std::size_t id_load;
+        std::size_t id_terminated;
 
       public:
         std::size_t id_message;
@@ -61,14 +68,31 @@ namespace saucer
       public:
         static void on_message(WebKitWebView *, JSCValue *, impl *);
         static void on_load(WebKitWebView *, WebKitLoadEvent, impl *);
+        static void on_terminated(WebKitWebView *, WebKitWebProcessTerminationReason, impl *);
 
       public:
         static void on_click(GtkGestureClick *, gint, gdouble, gdouble, impl *);
         static void on_release(GtkGestureClick *, gdouble, gdouble, guint, GdkEventSequence *, impl *);
 
+      public:
+        static script_ptr compile(const script &);
+        static inline utils::script_cache<script_ptr> compiled;
+
+      public:
+        static WebKitCacheModel convert(cache_model);
+        static soup_cookie_ptr convert(const cookie &);
+        static WebKitWebsiteDataTypes convert(const site_data &);
+        static utils::g_object_ptr<GdkTexture> scale(GtkWidget *, GdkTexture *, saucer::size);
+
+      public:
+        static std::shared_ptr<utils::g_object_ptr<WebKitNetworkSession>> ephemeral_session(const std::optional<std::string> &);
+        static WebKitUserContentFilterStore *filter_store();
+        static inline utils::sessions<utils::g_object_ptr<WebKitNetworkSession>> sessions;
+
       public:
         static WebKitSettings *make_settings(const options &);
-        static inline std::unordered_map<std::string, std::unique_ptr<scheme::handler>> schemes;
-        static inline std::unordered_map<std::string, std::unique_ptr<scheme::stream_handler>> stream_schemes;
+        static void set_back_forward_cache(WebKitSettings *, bool);
+        static inline utils::string_map<std::unique_ptr<scheme::handler>> schemes;
+        static inline utils::string_map<std::unique_ptr<scheme::stream_handler>> stream_schemes;
     };
 } // namespace saucer
@@ -2,6 +2,8 @@
 
 #include <saucer/permission.hpp>
 
+#include <functional>
+
 #include <wrl.h>
 #include <WebView2.h>
 
@@ -13,5 +15,8 @@ namespace saucer::permission
     {
         ComPtr<ICoreWebView2PermissionRequestedEventArgs> request;
         ComPtr<ICoreWebView2Deferral> deferral;
+
+      public:
+        std::move_only_function<void(bool)> decided;
     };
 } // namespace saucer::permission
@@ -2,6 +2,8 @@
 
 #include <saucer/scheme.hpp>
 
+#include "metrics.impl.hpp"
+
 #include <wrl.h>
 #include <WebView2.h>
 
@@ -9,6 +11,9 @@
 
 #include <deque>
 #include <mutex>
+#include <memory>
+#include <vector>
+#include <optional>
 #include <condition_variable>
 
 namespace saucer::scheme
@@ -17,21 +22,37 @@ namespace saucer::scheme
 
     struct request::impl
     {
-        ComPtr<ICoreWebView2WebResourceRequest> request;
+        std::string url;
+        std::string method;
         ComPtr<IStream> body;
+        std::map<std::string, std::string> headers;
+
+      public:
+        static impl from(ICoreWebView2WebResourceRequest *);
     };
 
     class stream_buffer : public IStream
     {
         LONG m_ref{1};
+
+      private:
         std::mutex m_mutex;
-        std::condition_variable m_cv;
-        std::deque<std::uint8_t> m_buffer;
+        std::condition_variable m_readable;
+        std::condition_variable m_writable;
+
+      private:
+        std::deque<stash> m_chunks;
+        std::size_t m_offset{0};
+        std::size_t m_size{0};
+
+      private:
         bool m_finished{false};
+        std::optional<std::size_t> m_capacity;
 
       public:
-        void push(const std::uint8_t *data, std::size_t size);
+        bool push(stash data);
         void close_write();
+        void set_capacity(std::optional<std::size_t>);
 
         HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void **ppv) override;
         ULONG STDMETHODCALLTYPE AddRef() override;
@@ -49,6 +70,34 @@ namespace saucer::scheme
         HRESULT STDMETHODCALLTYPE Clone(IStream **) override;
     };
 
+    class stash_stream : public IStream
+    {
+        LONG m_ref{1};
+
+      private:
+        std::shared_ptr<const stash> m_data;
+        std::size_t m_position{0};
+
+      public:
+        stash_stream(std::shared_ptr<const stash>, std::size_t = 0);
+
+      public:
+        HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void **ppv) override;
+        ULONG STDMETHODCALLTYPE AddRef() override;
+        ULONG STDMETHODCALLTYPE Release() override;
+        HRESULT STDMETHODCALLTYPE Read(void *pv, ULONG cb, ULONG *pcbRead) override;
+        HRESULT STDMETHODCALLTYPE Write(const void *, ULONG, ULONG *) override;
+        HRESULT STDMETHODCALLTYPE Seek(LARGE_INTEGER, DWORD, ULARGE_INTEGER *) override;
+        HRESULT STDMETHODCALLTYPE SetSize(ULARGE_INTEGER) override;
+        HRESULT STDMETHODCALLTYPE CopyTo(IStream *, ULARGE_INTEGER, ULARGE_INTEGER *, ULARGE_INTEGER *) override;
+        HRESULT STDMETHODCALLTYPE Commit(DWORD) override;
+        HRESULT STDMETHODCALLTYPE Revert() override;
+        HRESULT STDMETHODCALLTYPE LockRegion(ULARGE_INTEGER, ULARGE_INTEGER, DWORD) override;
+        HRESULT STDMETHODCALLTYPE UnlockRegion(ULARGE_INTEGER, ULARGE_INTEGER, DWORD) override;
+        HRESULT STDMETHODCALLTYPE Stat(STATSTG *pstatstg, DWORD) override;
+        HRESULT STDMETHODCALLTYPE Clone(IStream **) override;
+    };
+
     struct stream_writer::impl
     {
         ComPtr<ICoreWebView2WebResourceRequestedEventArgs> args;
@@ -57,5 +106,8 @@ namespace saucer::scheme
         ComPtr<stream_buffer> buffer;
         std::atomic<bool> started{false};
         std::atomic<bool> finished{false};
+
+      public:
+        utils::tracked active{utils::metrics::get().stream_writers};
     };
 } // namespace saucer::scheme
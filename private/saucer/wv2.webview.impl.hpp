@@ -2,10 +2,15 @@
 
 #include "webview.impl.hpp"
 
+#include "hash.hpp"
 #include "lease.hpp"
+#include "sessions.hpp"
 
 #include <map>
+#include <regex>
 #include <limits>
+#include <vector>
+#include <utility>
 #include <unordered_map>
 
 #include <wrl.h>
@@ -20,6 +25,7 @@ namespace saucer
 
     // These type-names are straight from hell. Thanks microsoft!
     using ScriptInjected       = ICoreWebView2AddScriptToExecuteOnDocumentCreatedCompletedHandler;
+    using ScriptExecuted       = ICoreWebView2ExecuteScriptCompletedHandler;
     using EnvironmentCompleted = ICoreWebView2CreateCoreWebView2EnvironmentCompletedHandler;
     using ControllerCompleted  = ICoreWebView2CreateCoreWebView2ControllerCompletedHandler;
     using Fullscreen           = ICoreWebView2ContainsFullScreenElementChangedEventHandler;
@@ -33,12 +39,29 @@ namespace saucer
     using DOMLoaded            = ICoreWebView2DOMContentLoadedEventHandler;
     using FaviconChanged       = ICoreWebView2FaviconChangedEventHandler;
     using GetFavicon           = ICoreWebView2GetFaviconCompletedHandler;
+    using PreviewCaptured      = ICoreWebView2CapturePreviewCompletedHandler;
+    using ProtocolCalled       = ICoreWebView2CallDevToolsProtocolMethodCompletedHandler;
     using SourceChanged        = ICoreWebView2SourceChangedEventHandler;
+    using ProcessFailed        = ICoreWebView2ProcessFailedEventHandler;
+    using BrowsingDataCleared  = ICoreWebView2ClearBrowsingDataCompletedHandler;
 
     struct environment_options
     {
         std::wstring storage_path;
+        std::wstring arguments;
         ICoreWebView2EnvironmentOptions *opts;
+
+      public:
+        std::optional<std::string> session;
+    };
+
+    struct prewarmed_environment
+    {
+        std::wstring storage_path;
+
+      public:
+        bool ready{false};
+        ComPtr<ICoreWebView2Environment> environment;
     };
 
     struct scheme_options
@@ -60,6 +83,7 @@ namespace saucer
         ComPtr<ICoreWebView2Controller> controller;
         ComPtr<ICoreWebView2Settings> settings;
         ComPtr<ICoreWebView2_22> web_view;
+        std::shared_ptr<ComPtr<ICoreWebView2Environment>> session;
 
       public:
         icon favicon;
@@ -68,11 +92,17 @@ namespace saucer
         bool dom_loaded{false};
         std::vector<std::string> pending;
 
+      public:
+        std::wstring widened;
+
       public:
         std::size_t id_counter{0};
         std::map<std::size_t, wv2_script> scripts;
-        std::unordered_map<std::string, scheme::resolver> schemes;
-        std::unordered_map<std::string, scheme::stream_resolver> stream_schemes;
+        utils::string_map<scheme::resolver> schemes;
+        utils::string_map<scheme::stream_resolver> stream_schemes;
+
+      public:
+        std::vector<std::pair<std::wstring, std::regex>> content_rules;
 
       public:
         std::size_t on_resize, on_minimize;
@@ -89,6 +119,9 @@ namespace saucer
         template <event>
         void setup(impl *);
 
+      public:
+        void filter(const std::string &, bool) const;
+
       public:
         static ComPtr<ICoreWebView2EnvironmentOptions> env_options();
 
@@ -97,6 +130,10 @@ namespace saucer
         static result<ComPtr<ICoreWebView2Environment>> create_environment(application *, const environment_options &);
         static result<ComPtr<ICoreWebView2Controller>> create_controller(application *, HWND, ICoreWebView2Environment *);
 
+      public:
+        static std::optional<std::size_t> engine_memory(ICoreWebView2 *);
+        static std::vector<fs::path> attached(ICoreWebView2WebMessageReceivedEventArgs *);
+
       public:
         static HRESULT on_message(impl *, ICoreWebView2 *, ICoreWebView2WebMessageReceivedEventArgs *);
         static HRESULT on_resource(impl *, ICoreWebView2 *, ICoreWebView2WebResourceRequestedEventArgs *);
@@ -107,6 +144,7 @@ namespace saucer
 
       public:
         static HRESULT on_favicon(impl *, ICoreWebView2 *, IUnknown *);
+        static HRESULT on_failed(impl *, ICoreWebView2 *, ICoreWebView2ProcessFailedEventArgs *);
         static HRESULT on_fullscreen(impl *, ICoreWebView2 *, IUnknown *);
         static HRESULT on_window(impl *, ICoreWebView2 *, ICoreWebView2NewWindowRequestedEventArgs *);
 
@@ -115,5 +153,8 @@ namespace saucer
 
       public:
         static inline auto bound_events = std::numeric_limits<std::size_t>::max();
+        static inline utils::sessions<ComPtr<ICoreWebView2Environment>> sessions;
+        static inline std::map<std::pair<std::wstring, std::wstring>, ComPtr<ICoreWebView2Environment>> environments;
+        static inline std::shared_ptr<prewarmed_environment> prewarmed;
     };
 } // namespace saucer
@@ -1,6 +1,14 @@
 #include "app.impl.hpp"
 
+#include "pool.hpp"
+#include "threads.hpp"
 #include "error.impl.hpp"
+#include "metrics.impl.hpp"
+#include "webview.impl.hpp"
+
+#include <utility>
+#include <algorithm>
+#include <functional>
 
 namespace saucer
 {
@@ -11,6 +19,123 @@ namespace saucer
 
     application::application(application &&) noexcept = default;
 
+    void application::impl::record(startup_phase phase, trace_clock::time_point start) const
+    {
+        if (!trace)
+        {
+            return;
+        }
+
+        trace({.phase = phase, .start = start, .end = trace_clock::now()});
+    }
+
+    void application::impl::screens_changed()
+    {
+        auto current = screens();
+
+        {
+            std::lock_guard lock{screen_mutex};
+
+            if (screen_cache == current)
+            {
+                return;
+            }
+
+            screen_cache.emplace(std::move(current));
+            screen_generation++;
+        }
+
+        events.get<event::screens_changed>().fire();
+    }
+
+    std::size_t application::impl::add_timer(std::chrono::milliseconds interval, timer_callback_t callback, timer_precision precision,
+                                             bool repeat)
+    {
+        const auto id = ++timer_counter;
+
+        timers.emplace(id, timer{.repeat = repeat, .callback = std::make_shared<timer_callback_t>(std::move(callback))});
+        start_timer(id, std::max(interval, std::chrono::milliseconds{0}), precision, repeat);
+
+        return id;
+    }
+
+    void application::impl::remove_timer(std::size_t id)
+    {
+        if (!timers.erase(id))
+        {
+            return;
+        }
+
+        stop_timer(id);
+    }
+
+    bool application::impl::fire(std::size_t id)
+    {
+        auto it = timers.find(id);
+
+        if (it == timers.end())
+        {
+            return false;
+        }
+
+        // The callback is kept alive separately, as it may cancel its own timer
+        auto callback     = it->second.callback;
+        const auto repeat = it->second.repeat;
+
+        if (!repeat)
+        {
+            timers.erase(it);
+        }
+
+        std::invoke(*callback);
+
+        return repeat && timers.contains(id);
+    }
+
+    std::vector<std::string> application::impl::arguments(const options &opts)
+    {
+        if (!opts.argc.has_value() || !opts.argv.has_value())
+        {
+            return {};
+        }
+
+        return {*opts.argv, *opts.argv + *opts.argc};
+    }
+
+    bool application::impl::claim(const std::string &id, const std::vector<std::string> &args)
+    {
+        auto forwarded = [this](std::vector<std::string> args)
+        {
+            auto fire = [this, args = std::move(args)]
+            {
+                events.get<event::instance>().fire(args);
+            };
+
+            if (!queue.push(std::move(fire), std::to_underlying(priority::normal)))
+            {
+                return;
+            }
+
+            wake(priority::normal);
+        };
+
+        // Another launch may have claimed the endpoint since we failed to forward, in which case it gets our arguments after all
+        for (auto attempt = 0; 3 > attempt; attempt++)
+        {
+            if ((instance = utils::single_instance::listen(id, forwarded)))
+            {
+                return true;
+            }
+
+            if (utils::single_instance::forward(id, args))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
     result<application> application::create(const options &opts)
     {
         if (static bool once{false}; once)
@@ -22,14 +147,46 @@ namespace saucer
             once = true;
         }
 
+        const auto start = trace_clock::now();
+
+        // Has to happen before the first worker is spawned, the pools read their configuration on startup
+        utils::configure(opts.workers, opts.helpers);
+
+        const auto args = opts.single_instance ? impl::arguments(opts) : std::vector<std::string>{};
+
+        if (opts.single_instance && utils::single_instance::forward(opts.id.value(), args))
+        {
+            // The running instance took over, there is no point in bringing up the toolkit and engine
+            return err(contract_error::instance_forwarded);
+        }
+
         auto rtn           = application{};
         rtn.m_impl->thread = std::this_thread::get_id();
+        rtn.m_impl->trace  = opts.trace;
+
+        if (opts.long_tasks)
+        {
+            rtn.m_impl->queue.watch(opts.task_budget, opts.long_tasks);
+        }
 
         if (auto status = rtn.m_impl->init_platform(opts); !status.has_value())
         {
             return err(status);
         }
 
+        // Only listen once the platform is up, forwarded arguments are posted to (and thus wake) the event loop
+        if (opts.single_instance && !rtn.m_impl->claim(opts.id.value(), args))
+        {
+            return err(contract_error::instance_forwarded);
+        }
+
+        if (opts.prewarm_engine)
+        {
+            webview::impl::prewarm(opts);
+        }
+
+        rtn.m_impl->record(startup_phase::application, start);
+
         return rtn;
     }
 
@@ -40,6 +197,8 @@ namespace saucer
             return;
         }
 
+        // The listener posts to our queue, it has to be gone before the platform is torn down
+        m_impl->instance.reset();
         m_events->clear(true);
     }
 
@@ -53,6 +212,74 @@ namespace saucer
         return m_impl->thread == std::this_thread::get_id();
     }
 
+    std::size_t application::pending() const
+    {
+        if (!m_impl)
+        {
+            return {};
+        }
+
+        return m_impl->queue.size();
+    }
+
+    saucer::metrics application::metrics() const
+    {
+        auto rtn   = utils::metrics::get().snapshot();
+        rtn.queued = pending();
+
+        return rtn;
+    }
+
+    void application::post(post_callback_t callback, priority priority, std::source_location origin) const
+    {
+        if (!m_impl->queue.push(std::move(callback), std::to_underlying(priority), origin))
+        {
+            return;
+        }
+
+        m_impl->wake(priority);
+    }
+
+    void application::submit(post_callback_t callback, priority priority) const // NOLINT(*-static)
+    {
+        utils::pool::shared().submit(std::move(callback), std::to_underlying(priority));
+    }
+
+    std::size_t application::concurrency() const // NOLINT(*-static)
+    {
+        return utils::pool::shared().size();
+    }
+
+    std::size_t application::schedule(std::chrono::milliseconds delay, timer_callback_t callback, timer_precision precision)
+    {
+        if (!m_impl)
+        {
+            return 0;
+        }
+
+        return invoke(&impl::add_timer, m_impl.get(), delay, std::move(callback), precision, false);
+    }
+
+    std::size_t application::every(std::chrono::milliseconds interval, timer_callback_t callback, timer_precision precision)
+    {
+        if (!m_impl)
+        {
+            return 0;
+        }
+
+        return invoke(&impl::add_timer, m_impl.get(), interval, std::move(callback), precision, true);
+    }
+
+    void application::cancel(std::size_t id)
+    {
+        if (!m_impl)
+        {
+            return;
+        }
+
+        return invoke(&impl::remove_timer, m_impl.get(), id);
+    }
+
     std::vector<screen> application::screens() const
     {
         if (!m_impl)
@@ -60,7 +287,29 @@ namespace saucer
             return {};
         }
 
-        return invoke(&impl::screens, m_impl.get());
+        std::size_t generation{};
+
+        {
+            std::lock_guard lock{m_impl->screen_mutex};
+
+            if (m_impl->screen_cache.has_value())
+            {
+                return *m_impl->screen_cache;
+            }
+
+            generation = m_impl->screen_generation;
+        }
+
+        auto rtn = invoke(&impl::screens, m_impl.get());
+
+        std::lock_guard lock{m_impl->screen_mutex};
+
+        if (m_impl->screen_generation == generation)
+        {
+            m_impl->screen_cache.emplace(rtn);
+        }
+
+        return rtn;
     }
 
     int application::run(callback_t callback)
@@ -92,6 +341,26 @@ namespace saucer
         return std::move(m_impl->finish);
     }
 
+    poll_set application::prepare()
+    {
+        if (!m_impl || !thread_safe())
+        {
+            return {};
+        }
+
+        return m_impl->prepare();
+    }
+
+    bool application::process(const poll_set &set)
+    {
+        if (!m_impl || !thread_safe())
+        {
+            return false;
+        }
+
+        return m_impl->process(set);
+    }
+
     void application::quit()
     {
         if (!m_impl)
@@ -0,0 +1,130 @@
+#include "asset_store.impl.hpp"
+
+#include "pool.hpp"
+
+#include <vector>
+#include <utility>
+
+namespace saucer
+{
+    asset_store::asset_store() : m_impl(std::make_shared<impl>()) {}
+
+    void asset_store::embed(embedded_files files)
+    {
+        auto entries  = std::vector<std::shared_ptr<const impl::entry>>{};
+        auto deferred = std::vector<std::pair<std::string, stash>>{};
+
+        entries.reserve(files.size());
+
+        for (auto &[path, file] : files)
+        {
+            auto name = path.lexically_normal().generic_string();
+            auto tag  = std::string{};
+
+            if (const auto *source = webview::impl::compressed(file); source)
+            {
+                tag = webview::impl::etag(*source);
+            }
+            else if (file.content.deferred())
+            {
+                deferred.emplace_back(name, file.content);
+            }
+            else
+            {
+                tag = webview::impl::etag(file.content);
+            }
+
+            entries.emplace_back(std::make_shared<const impl::entry>(std::move(name), std::move(file), std::move(tag)));
+        }
+
+        {
+            std::lock_guard lock{m_impl->mutex};
+
+            for (auto &entry : entries)
+            {
+                auto path = entry->path;
+                m_impl->files.insert_or_assign(std::move(path), std::move(entry));
+            }
+        }
+
+        if (deferred.empty())
+        {
+            return;
+        }
+
+        auto precompute = [weak = std::weak_ptr{m_impl}, deferred = std::move(deferred)]
+        {
+            for (const auto &[path, content] : deferred)
+            {
+                auto tag  = webview::impl::etag(content);
+                auto self = weak.lock();
+
+                if (!self)
+                {
+                    return;
+                }
+
+                self->retag(path, content, std::move(tag));
+            }
+        };
+
+        utils::pool::shared().submit(std::move(precompute));
+    }
+
+    void asset_store::unembed()
+    {
+        std::lock_guard lock{m_impl->mutex};
+        m_impl->files.clear();
+    }
+
+    void asset_store::unembed(const fs::path &file)
+    {
+        const auto key = file.lexically_normal().generic_string();
+        std::lock_guard lock{m_impl->mutex};
+
+        if (const auto it = m_impl->files.find(key); it != m_impl->files.end())
+        {
+            m_impl->files.erase(it);
+        }
+    }
+
+    std::size_t asset_store::size() const
+    {
+        std::lock_guard lock{m_impl->mutex};
+        return m_impl->files.size();
+    }
+
+    asset_store::impl *asset_store::native() const
+    {
+        return m_impl.get();
+    }
+
+    std::shared_ptr<const asset_store::impl::entry> asset_store::impl::find(std::string_view file) const
+    {
+        std::lock_guard lock{mutex};
+        const auto it = files.find(file);
+
+        if (it == files.end())
+        {
+            return nullptr;
+        }
+
+        return it->second;
+    }
+
+    void asset_store::impl::retag(std::string_view file, const stash &content, std::string tag)
+    {
+        std::lock_guard lock{mutex};
+        const auto it = files.find(file);
+
+        if (it == files.end() || it->second->file.content.data() != content.data())
+        {
+            return;
+        }
+
+        auto updated  = std::make_shared<entry>(*it->second);
+        updated->etag = std::move(tag);
+
+        it->second = std::move(updated);
+    }
+} // namespace saucer
@@ -0,0 +1,180 @@
+#include "serializers/beve/beve.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace saucer::serializers::beve
+{
+    static constexpr auto decoder = R"js(
+    window.saucer.internal.beve = (encoded) =>
+    {
+        const bytes   = Uint8Array.from(atob(encoded), c => c.charCodeAt(0));
+        const view    = new DataView(bytes.buffer);
+        const decoder = new TextDecoder();
+        const widths  = [1, 2, 4, 8, 16];
+
+        let offset = 0;
+
+        const size = () =>
+        {
+            const width = 1 << (bytes[offset] & 0b11);
+            let rtn     = 0;
+
+            for (let i = width - 1; i >= 0; i--)
+            {
+                rtn = rtn * 256 + bytes[offset + i];
+            }
+
+            offset += width;
+            return Math.floor(rtn / 4);
+        };
+
+        const string = () =>
+        {
+            const length = size();
+            const rtn    = decoder.decode(bytes.subarray(offset, offset + length));
+
+            offset += length;
+            return rtn;
+        };
+
+        const number = (type, width) =>
+        {
+            // JavaScript has neither 128-bit integers nor half-floats, reading them as something narrower would corrupt the payload
+            if (width === undefined || width > 8 || (type === 0 && width < 4))
+            {
+                throw new Error(`Unsupported BEVE number: type ${type}, width ${width}`);
+            }
+
+            const at = offset;
+            offset  += width;
+
+            if (type === 0)
+            {
+                return width === 4 ? view.getFloat32(at, true) : view.getFloat64(at, true);
+            }
+
+            switch (width)
+            {
+                case 1:
+                    return type === 1 ? view.getInt8(at) : view.getUint8(at);
+                case 2:
+                    return type === 1 ? view.getInt16(at, true) : view.getUint16(at, true);
+                case 4:
+                    return type === 1 ? view.getInt32(at, true) : view.getUint32(at, true);
+                case 8:
+                    return Number(type === 1 ? view.getBigInt64(at, true) : view.getBigUint64(at, true));
+            }
+        };
+
+        const booleans = (length) =>
+        {
+            const at = offset;
+            offset  += Math.ceil(length / 8);
+
+            return Array.from({ length }, (_, i) => (bytes[at + (i >> 3)] & (1 << (i & 7))) !== 0);
+        };
+
+        const value = () =>
+        {
+            const header = bytes[offset++];
+            const type   = (header >> 3) & 0b11;
+            const width  = widths[header >> 5];
+
+            switch (header & 0b111)
+            {
+                case 0:
+                    return header === 0 ? null : (header & 0b10000) !== 0;
+                case 1:
+                    return number(type, width);
+                case 2:
+                    return string();
+                case 3:
+                {
+                    const rtn = {};
+
+                    for (let i = 0, length = size(); i < length; i++)
+                    {
+                        const key = type === 0 ? string() : number(type, width);
+                        rtn[key]  = value();
+                    }
+
+                    return rtn;
+                }
+                case 4:
+                {
+                    const length = size();
+
+                    if (type !== 3)
+                    {
+                        return Array.from({ length }, () => number(type, width));
+                    }
+
+                    return (header & 0b100000) ? Array.from({ length }, () => string()) : booleans(length);
+                }
+                case 5:
+                    return Array.from({ length: size() }, () => value());
+                case 6:
+                    if ((header >> 3) === 1)
+                    {
+                        size();
+                        return value();
+                    }
+            }
+
+            throw new Error(`Unsupported BEVE header: ${header}`);
+        };
+
+        return value();
+    };
+    )js";
+
+    void detail::encode(std::string_view data, std::string &out)
+    {
+        static constexpr std::string_view alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+        auto at = [&data](std::size_t index) -> std::uint32_t
+        {
+            return static_cast<std::uint8_t>(data[index]);
+        };
+
+        auto i = 0uz;
+
+        for (; i + 2 < data.size(); i += 3)
+        {
+            const auto chunk = (at(i) << 16) | (at(i + 1) << 8) | at(i + 2);
+
+            out += alphabet[(chunk >> 18) & 0x3F];
+            out += alphabet[(chunk >> 12) & 0x3F];
+            out += alphabet[(chunk >> 6) & 0x3F];
+            out += alphabet[chunk & 0x3F];
+        }
+
+        if (const auto remaining = data.size() - i; remaining > 0)
+        {
+            const auto chunk = (at(i) << 16) | (remaining > 1 ? at(i + 1) << 8 : 0);
+
+            out += alphabet[(chunk >> 18) & 0x3F];
+            out += alphabet[(chunk >> 12) & 0x3F];
+            out += remaining > 1 ? alphabet[(chunk >> 6) & 0x3F] : '=';
+            out += '=';
+        }
+    }
+
+    serializer::~serializer() = default;
+
+    std::string serializer::script() const
+    {
+        return decoder;
+    }
+
+    std::string serializer::js_serializer() const
+    {
+        return "JSON.stringify";
+    }
+
+    serializer::parse_result serializer::parse(std::string_view data) const
+    {
+        return glaze::serializer{}.parse(data);
+    }
+} // namespace saucer::serializers::beve
@@ -0,0 +1,451 @@
+#include "capi.h"
+
+#include "lease.hpp"
+#include "webview.impl.hpp"
+
+#include <span>
+#include <mutex>
+#include <format>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <iterator>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+
+namespace saucer::capi
+{
+    struct handler
+    {
+        saucer_scheme_batch callback;
+        void *user;
+
+      public:
+        struct pending
+        {
+            std::uint64_t id;
+            std::string url;
+            std::string method;
+            stash body;
+        };
+
+      public:
+        std::vector<pending> queued;
+    };
+
+    struct state
+    {
+        application *parent;
+
+      public:
+        std::mutex mutex;
+
+      public:
+        saucer_message_batch on_messages{nullptr};
+        void *messages_user{nullptr};
+        std::optional<std::size_t> listener;
+        std::vector<std::string> messages;
+
+      public:
+        std::uint64_t counter{0};
+        std::unordered_map<std::string, handler> schemes;
+        std::unordered_map<std::uint64_t, saucer::scheme::executor> executors;
+
+      public:
+        bool scheduled{false};
+
+      public:
+        void schedule(const std::shared_ptr<state> &);
+        void flush();
+    };
+
+    void state::schedule(const std::shared_ptr<state> &self)
+    {
+        if (std::exchange(scheduled, true))
+        {
+            return;
+        }
+
+        // Everything that arrives within one turn of the event loop is handed over in one go
+        parent->post(
+            [weak = std::weak_ptr{self}]
+            {
+                if (auto self = weak.lock(); self)
+                {
+                    self->flush();
+                }
+            });
+    }
+
+    void state::flush()
+    {
+        std::vector<std::string> messages;
+        std::vector<std::pair<handler, std::vector<handler::pending>>> requests;
+
+        saucer_message_batch callback{nullptr};
+        void *user{nullptr};
+
+        {
+            std::lock_guard lock{mutex};
+            scheduled = false;
+
+            if (on_messages)
+            {
+                callback = on_messages;
+                user     = messages_user;
+                messages = std::exchange(this->messages, {});
+            }
+
+            for (auto &[name, entry] : schemes)
+            {
+                if (entry.queued.empty())
+                {
+                    continue;
+                }
+
+                requests.emplace_back(handler{.callback = entry.callback, .user = entry.user}, std::exchange(entry.queued, {}));
+            }
+        }
+
+        if (!messages.empty())
+        {
+            std::vector<saucer_slice> slices;
+            slices.reserve(messages.size());
+
+            for (const auto &message : messages)
+            {
+                slices.push_back({.data = message.data(), .size = message.size()});
+            }
+
+            callback(user, slices.data(), slices.size());
+        }
+
+        for (const auto &[entry, pending] : requests)
+        {
+            std::vector<saucer_scheme_request> batch;
+            batch.reserve(pending.size());
+
+            for (const auto &request : pending)
+            {
+                batch.push_back({
+                    .id     = request.id,
+                    .url    = {.data = request.url.data(), .size = request.url.size()},
+                    .method = {.data = request.method.data(), .size = request.method.size()},
+                    .body   = {.data = reinterpret_cast<const char *>(request.body.data()), .size = request.body.size()},
+                });
+            }
+
+            entry.callback(entry.user, batch.data(), batch.size());
+        }
+    }
+
+    static std::string_view view(saucer_slice slice)
+    {
+        return {slice.data, slice.size};
+    }
+} // namespace saucer::capi
+
+struct saucer_webview
+{
+    saucer::webview *webview;
+    std::shared_ptr<saucer::capi::state> state;
+};
+
+using namespace saucer;
+
+saucer_webview *saucer_webview_wrap(saucer::webview &webview)
+{
+    auto state    = std::make_shared<capi::state>();
+    state->parent = &webview.parent().parent();
+
+    return new saucer_webview{.webview = &webview, .state = std::move(state)};
+}
+
+extern "C"
+{
+    void saucer_webview_on_messages(saucer_webview *handle, saucer_message_batch callback, void *user)
+    {
+        auto &state = handle->state;
+        std::optional<std::size_t> previous;
+
+        {
+            std::lock_guard lock{state->mutex};
+
+            state->on_messages   = callback;
+            state->messages_user = user;
+
+            if (callback && state->listener.has_value())
+            {
+                return;
+            }
+
+            if (!callback)
+            {
+                state->messages.clear();
+                previous = std::exchange(state->listener, std::nullopt);
+            }
+        }
+
+        if (!callback)
+        {
+            if (previous.has_value())
+            {
+                handle->webview->off(webview::event::message, *previous);
+            }
+
+            return;
+        }
+
+        auto listener = [weak = std::weak_ptr{state}](std::string_view message)
+        {
+            auto self = weak.lock();
+
+            if (!self)
+            {
+                return status::unhandled;
+            }
+
+            {
+                std::lock_guard lock{self->mutex};
+
+                if (!self->on_messages)
+                {
+                    return status::unhandled;
+                }
+
+                self->messages.emplace_back(message);
+            }
+
+            self->schedule(self);
+
+            return status::handled;
+        };
+
+        const auto id = handle->webview->on<webview::event::message>(std::move(listener));
+
+        std::lock_guard lock{state->mutex};
+        state->listener = id;
+    }
+
+    void saucer_webview_settle(saucer_webview *handle, const saucer_reply *replies, size_t count)
+    {
+        struct reply
+        {
+            std::uint64_t id;
+            bool resolved;
+            std::string value;
+        };
+
+        std::vector<reply> owned;
+        owned.reserve(count);
+
+        for (const auto &current : std::span{replies, count})
+        {
+            owned.push_back({.id = current.id, .resolved = current.resolved, .value = std::string{capi::view(current.value)}});
+        }
+
+        auto callback = [owned = std::move(owned)](webview::impl *self) mutable
+        {
+            std::string script;
+
+            for (auto &[id, resolved, value] : owned)
+            {
+                // Compressed or huge values take the regular route, which knows how to pack or split them
+                if (self->compress || value.size() > webview::impl::chunk_size)
+                {
+                    self->settle(id, resolved, std::move(value));
+                    continue;
+                }
+
+                std::format_to(std::back_inserter(script), "[{},{},{}],", id, resolved, value);
+            }
+
+            if (script.empty())
+            {
+                return;
+            }
+
+            self->execute(std::format("window.saucer.internal.settle([{}]);", script));
+        };
+
+        auto *const impl = handle->webview->native<false>();
+        impl->parent->dispatch(utils::defer(impl->lease, std::move(callback)));
+    }
+
+    void saucer_webview_execute(saucer_webview *handle, const saucer_slice *scripts, size_t count)
+    {
+        auto code = std::make_shared<std::string>();
+
+        for (const auto &current : std::span{scripts, count})
+        {
+            code->append(capi::view(current)).append(";\n");
+        }
+
+        handle->webview->execute(std::move(code));
+    }
+
+    void saucer_webview_handle_scheme(saucer_webview *handle, saucer_slice name, saucer_scheme_batch callback, void *user)
+    {
+        auto &state = handle->state;
+        auto key    = std::string{capi::view(name)};
+
+        {
+            std::lock_guard lock{state->mutex};
+            state->schemes.insert_or_assign(key, capi::handler{.callback = callback, .user = user});
+        }
+
+        auto resolver = [weak = std::weak_ptr{state}, key](const scheme::request &request, scheme::executor exec)
+        {
+            auto self = weak.lock();
+
+            if (!self)
+            {
+                return exec.reject(scheme::error::failed);
+            }
+
+            {
+                std::lock_guard lock{self->mutex};
+
+                auto it = self->schemes.find(key);
+
+                if (it == self->schemes.end())
+                {
+                    return exec.reject(scheme::error::not_found);
+                }
+
+                const auto id = ++self->counter;
+
+                self->executors.emplace(id, std::move(exec));
+                it->second.queued.push_back({
+                    .id     = id,
+                    .url    = request.url().string(),
+                    .method = request.method(),
+                    .body   = request.content(),
+                });
+            }
+
+            self->schedule(self);
+        };
+
+        handle->webview->handle_scheme(key, std::move(resolver));
+    }
+
+    void saucer_webview_remove_scheme(saucer_webview *handle, saucer_slice name)
+    {
+        auto key = std::string{capi::view(name)};
+
+        handle->webview->remove_scheme(key);
+
+        std::lock_guard lock{handle->state->mutex};
+        handle->state->schemes.erase(key);
+    }
+
+    void saucer_scheme_respond(saucer_webview *handle, const saucer_scheme_response *responses, size_t count)
+    {
+        for (const auto &current : std::span{responses, count})
+        {
+            std::optional<scheme::executor> exec;
+
+            {
+                std::lock_guard lock{handle->state->mutex};
+
+                if (auto node = handle->state->executors.extract(current.id); !node.empty())
+                {
+                    exec.emplace(std::move(node.mapped()));
+                }
+            }
+
+            const auto *data = reinterpret_cast<const std::uint8_t *>(current.data.data);
+
+            auto content = [&]
+            {
+                if (!current.release)
+                {
+                    return stash::from({data, data + current.data.size});
+                }
+
+                auto release = [release = current.release, context = current.context](const std::uint8_t *)
+                {
+                    release(context);
+                };
+
+                return stash::shared(std::shared_ptr<const std::uint8_t[]>{data, std::move(release)}, current.data.size);
+            }();
+
+            if (!exec.has_value())
+            {
+                continue;
+            }
+
+            auto response = scheme::response{
+                .data   = std::move(content),
+                .mime   = std::string{capi::view(current.mime)},
+                .status = current.status,
+            };
+
+            for (const auto &header : std::span{current.headers, current.header_count})
+            {
+                response.headers.emplace(std::string{capi::view(header.name)}, std::string{capi::view(header.value)});
+            }
+
+            exec->resolve(std::move(response));
+        }
+    }
+
+    void saucer_scheme_fail(saucer_webview *handle, uint64_t id, int32_t error)
+    {
+        std::optional<scheme::executor> exec;
+
+        {
+            std::lock_guard lock{handle->state->mutex};
+
+            if (auto node = handle->state->executors.extract(id); !node.empty())
+            {
+                exec.emplace(std::move(node.mapped()));
+            }
+        }
+
+        if (!exec.has_value())
+        {
+            return;
+        }
+
+        exec->reject(static_cast<scheme::error>(error));
+    }
+
+    void saucer_webview_release(saucer_webview *handle)
+    {
+        saucer_webview_on_messages(handle, nullptr, nullptr);
+
+        std::vector<std::string> names;
+        std::unordered_map<std::uint64_t, scheme::executor> executors;
+
+        {
+            std::lock_guard lock{handle->state->mutex};
+
+            for (const auto &[name, _] : handle->state->schemes)
+            {
+                names.emplace_back(name);
+            }
+
+            handle->state->schemes.clear();
+            executors = std::exchange(handle->state->executors, {});
+        }
+
+        // Nobody is left to answer these, the ids handed out for them are meaningless from now on
+        for (auto &[id, exec] : executors)
+        {
+            exec.reject(scheme::error::failed);
+        }
+
+        for (const auto &name : names)
+        {
+            handle->webview->remove_scheme(name);
+        }
+
+        delete handle;
+    }
+}
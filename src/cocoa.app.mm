@@ -21,10 +21,52 @@ namespace saucer
 
         native::init_menu();
 
+        static constexpr auto mask = DISPATCH_MEMORYPRESSURE_NORMAL | DISPATCH_MEMORYPRESSURE_WARN | DISPATCH_MEMORYPRESSURE_CRITICAL;
+        auto *const source         = dispatch_source_create(DISPATCH_SOURCE_TYPE_MEMORYPRESSURE, 0, mask, dispatch_get_main_queue());
+
+        dispatch_source_set_event_handler(source, ^{
+            const auto flags = dispatch_source_get_data(source);
+
+            auto pressure = memory_pressure::normal;
+
+            if (flags & DISPATCH_MEMORYPRESSURE_CRITICAL)
+            {
+                pressure = memory_pressure::critical;
+            }
+            else if (flags & DISPATCH_MEMORYPRESSURE_WARN)
+            {
+                pressure = memory_pressure::warning;
+            }
+
+            events.get<event::memory>().fire(pressure);
+        });
+
+        dispatch_resume(source);
+        platform->memory_source = source;
+
+        auto *const center        = [NSNotificationCenter defaultCenter];
+        platform->screen_observer = [center addObserverForName:NSApplicationDidChangeScreenParametersNotification
+                                                        object:nil
+                                                         queue:[NSOperationQueue mainQueue]
+                                                    usingBlock:^(NSNotification *) {
+                                                        screens_changed();
+                                                    }];
+
         return {};
     };
 
-    impl::~impl() = default;
+    impl::~impl()
+    {
+        if (!platform)
+        {
+            return;
+        }
+
+        dispatch_source_cancel(platform->memory_source);
+        dispatch_release(platform->memory_source);
+
+        [[NSNotificationCenter defaultCenter] removeObserver:platform->screen_observer];
+    }
 
     std::vector<screen> impl::screens() const // NOLINT(*-static)
     {
@@ -42,20 +84,70 @@ namespace saucer
         return rtn;
     }
 
-    void application::post(post_callback_t callback) const // NOLINT(*-static)
+    void impl::wake(priority)
     {
-        auto *const queue = dispatch_get_main_queue();
-        auto *const ptr   = new post_callback_t{std::move(callback)};
-
-        dispatch_async(queue,
-                       [ptr]
+        dispatch_async(dispatch_get_main_queue(),
+                       [rental = lease.rent()]
                        {
-                           const auto guard = utils::autorelease_guard{};
-                           auto callback    = std::unique_ptr<post_callback_t>{ptr};
-                           (*callback)();
+                           auto locked = rental.access();
+
+                           if (auto *const self = locked.value(); self)
+                           {
+                               const auto guard = utils::autorelease_guard{};
+                               (*self)->queue.drain();
+                           }
                        });
     }
 
+    void impl::start_timer(std::size_t id, std::chrono::milliseconds interval, timer_precision precision, bool repeat)
+    {
+        const auto seconds = std::chrono::duration<double>{interval}.count();
+
+        auto tick = ^(CFRunLoopTimerRef) {
+          if (fire(id))
+          {
+              return;
+          }
+
+          stop_timer(id);
+        };
+
+        auto *const timer = CFRunLoopTimerCreateWithHandler(kCFAllocatorDefault,                  //
+                                                            CFAbsoluteTimeGetCurrent() + seconds, //
+                                                            repeat ? seconds : 0,                 //
+                                                            0,                                    //
+                                                            0,                                    //
+                                                            tick);
+
+        switch (precision)
+        {
+        case timer_precision::precise:
+            break;
+        case timer_precision::coarse:
+            CFRunLoopTimerSetTolerance(timer, seconds * 0.05);
+            break;
+        case timer_precision::very_coarse:
+            CFRunLoopTimerSetTolerance(timer, 1.0);
+            break;
+        }
+
+        CFRunLoopAddTimer(CFRunLoopGetMain(), timer, kCFRunLoopCommonModes);
+        platform->timers.emplace(id, timer);
+    }
+
+    void impl::stop_timer(std::size_t id) // NOLINT(*-const)
+    {
+        auto node = platform->timers.extract(id);
+
+        if (node.empty())
+        {
+            return;
+        }
+
+        CFRunLoopTimerInvalidate(node.mapped());
+        CFRelease(node.mapped());
+    }
+
     int impl::run(application *self, callback_t callback)
     {
         const utils::autorelease_guard guard{};
@@ -71,6 +163,45 @@ namespace saucer
         return 0;
     }
 
+    poll_set impl::prepare()
+    {
+        // The ports backing the main run loop and queue are private, we can only bound the wait by the next timer
+        if (queue.size() > 0)
+        {
+            return {.timeout = std::chrono::milliseconds{0}};
+        }
+
+        const auto next  = CFRunLoopGetNextTimerFireDate(CFRunLoopGetMain(), kCFRunLoopDefaultMode);
+        const auto delta = std::chrono::duration<double>{next - CFAbsoluteTimeGetCurrent()};
+
+        if (next == 0 || delta >= poll_interval)
+        {
+            return {.timeout = poll_interval};
+        }
+
+        return {.timeout = std::max(std::chrono::ceil<std::chrono::milliseconds>(delta), std::chrono::milliseconds{0})};
+    }
+
+    bool impl::process(const poll_set &) // NOLINT(*-static)
+    {
+        const utils::autorelease_guard guard{};
+
+        auto next = []
+        {
+            return [NSApp nextEventMatchingMask:NSEventMaskAny untilDate:[NSDate now] inMode:NSDefaultRunLoopMode dequeue:YES];
+        };
+
+        auto rtn = false;
+
+        for (auto *event = next(); event; event = next())
+        {
+            [NSApp sendEvent:event];
+            rtn = true;
+        }
+
+        return rtn;
+    }
+
     void impl::quit() // NOLINT(*-static)
     {
         [NSApp stop:nil];
@@ -39,14 +39,19 @@ namespace saucer
 
     stash icon::data() const
     {
-        const utils::autorelease_guard guard{};
+        auto encode = [icon = m_impl->icon.get()]
+        {
+            const utils::autorelease_guard guard{};
 
-        auto *const tiff = [m_impl->icon.get() TIFFRepresentation];
-        auto *const rep  = [NSBitmapImageRep imageRepWithData:tiff];
-        auto *const data = [rep representationUsingType:NSBitmapImageFileTypePNG properties:[NSDictionary dictionary]];
+            auto *const tiff = [icon TIFFRepresentation];
+            auto *const rep  = [NSBitmapImageRep imageRepWithData:tiff];
+            auto *const data = [rep representationUsingType:NSBitmapImageFileTypePNG properties:[NSDictionary dictionary]];
+
+            const auto *raw = reinterpret_cast<const std::uint8_t *>(data.bytes);
+            return std::vector<std::uint8_t>{raw, raw + data.length};
+        };
 
-        const auto *raw = reinterpret_cast<const std::uint8_t *>(data.bytes);
-        return stash::from({raw, raw + data.length});
+        return m_impl->png.get(encode);
     }
 
     void icon::save(const fs::path &path) const
@@ -67,6 +67,48 @@ namespace saucer
     {
     }
 
+    template <>
+    void native::setup<event::frame>(impl *self)
+    {
+        auto &event = self->events.get<event::frame>();
+
+        if (!event.empty())
+        {
+            return;
+        }
+
+        const utils::autorelease_guard guard{};
+
+        auto callback = [self]
+        {
+            const auto occlusion = self->platform->window.occlusionState;
+
+            if (!(occlusion & NSWindowOcclusionStateVisible) || self->minimized())
+            {
+                return;
+            }
+
+            self->events.get<event::frame>().fire();
+        };
+
+        const utils::objc_ptr<Observer> observer = [[Observer alloc] initWithCallback:std::move(callback)];
+
+        id source = nil;
+
+        if (@available(macOS 14.0, *))
+        {
+            source = [window.contentView displayLinkWithTarget:observer.get() selector:@selector(tick:)];
+            [source addToRunLoop:NSRunLoop.mainRunLoop forMode:NSRunLoopCommonModes];
+        }
+        else
+        {
+            source = [NSTimer timerWithTimeInterval:1.0 / 60.0 target:observer.get() selector:@selector(tick:) userInfo:nil repeats:YES];
+            [NSRunLoop.mainRunLoop addTimer:source forMode:NSRunLoopCommonModes];
+        }
+
+        event.on_clear([source] { [source invalidate]; });
+    }
+
     template <>
     void native::setup<event::close>(impl *)
     {
@@ -185,6 +227,11 @@ using namespace saucer;
 {
     m_callback();
 }
+
+- (void)tick:(id)sender
+{
+    m_callback();
+}
 @end
 
 @implementation WindowDelegate
@@ -209,7 +256,7 @@ using namespace saucer;
 - (void)windowDidResize:(NSNotification *)notification
 {
     const auto [width, height] = me->size();
-    me->events.get<event::resize>().fire(width, height);
+    me->resized(width, height);
 }
 
 - (void)windowDidBecomeKey:(NSNotification *)notification
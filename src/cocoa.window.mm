@@ -201,6 +201,12 @@ namespace saucer
         const utils::autorelease_guard guard{};
 
         parent->native<false>()->platform->instances[platform->window] = true;
+
+        if (offscreen)
+        {
+            return;
+        }
+
         [platform->window makeKeyAndOrderFront:nil];
     }
 
@@ -0,0 +1,122 @@
+#include <saucer/stash/decode_cache.hpp>
+
+#include <list>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+
+namespace saucer
+{
+    struct decode_cache::impl
+    {
+        using buffer = std::shared_ptr<const stash>;
+
+      public:
+        struct entry;
+
+      public:
+        decoder decode;
+        std::size_t capacity;
+
+      public:
+        std::mutex mutex;
+        std::size_t size{0};
+        std::list<entry> entries;
+        std::unordered_map<const std::uint8_t *, std::list<entry>::iterator> lookup;
+
+      public:
+        std::atomic<std::size_t> hits{0};
+        std::atomic<std::size_t> misses{0};
+
+      public:
+        [[nodiscard]] buffer find(const std::uint8_t *);
+        void insert(const std::uint8_t *, buffer);
+    };
+
+    struct decode_cache::impl::entry
+    {
+        const std::uint8_t *key;
+        buffer data;
+    };
+
+    decode_cache::impl::buffer decode_cache::impl::find(const std::uint8_t *key)
+    {
+        std::lock_guard lock{mutex};
+        auto it = lookup.find(key);
+
+        if (it == lookup.end())
+        {
+            return nullptr;
+        }
+
+        entries.splice(entries.begin(), entries, it->second);
+
+        return it->second->data;
+    }
+
+    void decode_cache::impl::insert(const std::uint8_t *key, buffer data)
+    {
+        if (data->size() > capacity)
+        {
+            return;
+        }
+
+        std::lock_guard lock{mutex};
+
+        if (lookup.contains(key))
+        {
+            return;
+        }
+
+        size += data->size();
+        entries.emplace_front(key, std::move(data));
+        lookup.emplace(key, entries.begin());
+
+        while (size > capacity)
+        {
+            auto &last = entries.back();
+
+            size -= last.data->size();
+            lookup.erase(last.key);
+
+            entries.pop_back();
+        }
+    }
+
+    decode_cache::decode_cache(decoder decode, std::size_t capacity) : m_impl(std::make_shared<impl>(std::move(decode), capacity)) {}
+
+    stash decode_cache::get(const stash &compressed, std::string_view encoding) const
+    {
+        const auto *const key = compressed.data();
+        auto data             = m_impl->find(key);
+
+        if (data)
+        {
+            m_impl->hits.fetch_add(1, std::memory_order_relaxed);
+            return stash::shared({data, data->data()}, data->size());
+        }
+
+        m_impl->misses.fetch_add(1, std::memory_order_relaxed);
+
+        data = std::make_shared<const stash>(m_impl->decode(compressed, encoding));
+        m_impl->insert(key, data);
+
+        return stash::shared({data, data->data()}, data->size());
+    }
+
+    std::size_t decode_cache::hits() const
+    {
+        return m_impl->hits.load(std::memory_order_relaxed);
+    }
+
+    std::size_t decode_cache::misses() const
+    {
+        return m_impl->misses.load(std::memory_order_relaxed);
+    }
+
+    std::size_t decode_cache::size() const
+    {
+        std::lock_guard lock{m_impl->mutex};
+        return m_impl->size;
+    }
+} // namespace saucer
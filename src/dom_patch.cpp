@@ -0,0 +1,68 @@
+#include "dom_patch.hpp"
+
+#include <utility>
+
+namespace saucer
+{
+    dom_patch::dom_patch(std::string target) : m_target(std::move(target)) {}
+
+    dom_patch &dom_patch::html(std::string html)
+    {
+        // Replacing the whole content makes every operation before it moot
+        m_operations.clear();
+        m_operations.emplace_back(operation{.type = kind::html, .value = std::move(html)});
+
+        return *this;
+    }
+
+    dom_patch &dom_patch::insert(std::size_t index, std::string html)
+    {
+        m_operations.emplace_back(operation{.type = kind::insert, .index = index, .value = std::move(html)});
+        return *this;
+    }
+
+    dom_patch &dom_patch::replace(std::size_t index, std::string html)
+    {
+        m_operations.emplace_back(operation{.type = kind::replace, .index = index, .value = std::move(html)});
+        return *this;
+    }
+
+    dom_patch &dom_patch::remove(std::size_t index, std::size_t count)
+    {
+        if (count == 0)
+        {
+            return *this;
+        }
+
+        m_operations.emplace_back(operation{.type = kind::remove, .index = index, .count = count});
+
+        return *this;
+    }
+
+    dom_patch &dom_patch::text(std::size_t index, std::string text)
+    {
+        m_operations.emplace_back(operation{.type = kind::text, .index = index, .value = std::move(text)});
+        return *this;
+    }
+
+    dom_patch &dom_patch::attribute(std::size_t index, std::string name, std::optional<std::string> value)
+    {
+        m_operations.emplace_back(operation{.type = kind::attribute, .index = index, .name = std::move(name), .value = std::move(value)});
+        return *this;
+    }
+
+    bool dom_patch::empty() const
+    {
+        return m_operations.empty();
+    }
+
+    const std::string &dom_patch::target() const
+    {
+        return m_target;
+    }
+
+    const std::vector<dom_patch::operation> &dom_patch::operations() const
+    {
+        return m_operations;
+    }
+} // namespace saucer
@@ -61,6 +61,9 @@ namespace saucer
 
         case required_invalid:
             return "required argument was invalid";
+
+        case instance_forwarded:
+            return "arguments were forwarded to the running instance";
         }
 
         std::unreachable();
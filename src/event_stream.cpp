@@ -0,0 +1,229 @@
+#include <saucer/event_stream.hpp>
+#include <saucer/pipeline.hpp>
+
+#include "threads.hpp"
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <format>
+#include <thread>
+#include <vector>
+#include <ranges>
+#include <algorithm>
+#include <string_view>
+#include <condition_variable>
+
+namespace saucer::scheme
+{
+    struct event_stream::impl
+    {
+        options opts;
+
+      public:
+        std::mutex mutex;
+        std::condition_variable wake;
+
+      public:
+        std::vector<std::unique_ptr<pipeline>> clients;
+        std::atomic_size_t count{0};
+        std::atomic_size_t dropped{0};
+
+      public:
+        bool closed{false};
+        std::thread heartbeat;
+
+      public:
+        ~impl();
+
+      public:
+        void beat();
+        void broadcast(const stash &);
+        void shutdown();
+
+      public:
+        static stash frame(const event &);
+        static std::string_view line(std::string_view);
+    };
+
+    event_stream::impl::~impl()
+    {
+        shutdown();
+
+        if (!heartbeat.joinable())
+        {
+            return;
+        }
+
+        heartbeat.join();
+    }
+
+    void event_stream::impl::beat()
+    {
+        static constexpr std::string_view comment = ":\n\n";
+        utils::apply(utils::thread_role::helper);
+
+        while (true)
+        {
+            {
+                std::unique_lock lock{mutex};
+
+                if (wake.wait_for(lock, opts.heartbeat, [this] { return closed; }))
+                {
+                    return;
+                }
+            }
+
+            broadcast(stash::view_str(comment));
+        }
+    }
+
+    void event_stream::impl::broadcast(const stash &data)
+    {
+        auto gone = std::vector<std::unique_ptr<pipeline>>{};
+
+        {
+            std::lock_guard lock{mutex};
+
+            // Every client is offered the same buffer, slow ones lose the event instead of stalling the others
+            for (auto it = clients.begin(); it != clients.end();)
+            {
+                const auto status = (*it)->try_push(data);
+
+                if (status == write_status::saturated)
+                {
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                if (status == write_status::written || (status == write_status::saturated && opts.policy == overflow::drop))
+                {
+                    ++it;
+                    continue;
+                }
+
+                gone.emplace_back(std::move(*it));
+                it = clients.erase(it);
+            }
+
+            count.store(clients.size(), std::memory_order_relaxed);
+        }
+
+        for (auto &client : gone)
+        {
+            client->finish();
+        }
+    }
+
+    void event_stream::impl::shutdown()
+    {
+        auto gone = std::vector<std::unique_ptr<pipeline>>{};
+
+        {
+            std::lock_guard lock{mutex};
+
+            closed = true;
+            gone   = std::exchange(clients, {});
+
+            count.store(0, std::memory_order_relaxed);
+        }
+
+        wake.notify_all();
+
+        for (auto &client : gone)
+        {
+            client->finish();
+        }
+    }
+
+    std::string_view event_stream::impl::line(std::string_view value)
+    {
+        return value.substr(0, value.find_first_of("\r\n"));
+    }
+
+    stash event_stream::impl::frame(const event &value)
+    {
+        auto rtn = std::string{};
+
+        if (!value.id.empty())
+        {
+            std::format_to(std::back_inserter(rtn), "id: {}\n", line(value.id));
+        }
+
+        if (!value.type.empty())
+        {
+            std::format_to(std::back_inserter(rtn), "event: {}\n", line(value.type));
+        }
+
+        for (const auto part : std::views::split(std::string_view{value.data}, '\n'))
+        {
+            auto data = std::string_view{part.begin(), part.end()};
+
+            if (data.ends_with('\r'))
+            {
+                data.remove_suffix(1);
+            }
+
+            std::format_to(std::back_inserter(rtn), "data: {}\n", data);
+        }
+
+        rtn += '\n';
+
+        // Shared so that fanning out to every client only bumps a reference count
+        auto buffer = std::make_shared_for_overwrite<std::uint8_t[]>(rtn.size());
+        std::ranges::copy(rtn, buffer.get());
+
+        return stash::shared(std::move(buffer), rtn.size());
+    }
+
+    event_stream::event_stream(options opts) : m_impl(std::make_shared<impl>(std::move(opts))) {}
+
+    void event_stream::operator()(request, stream_writer writer) const
+    {
+        const auto response = stream_response{
+            .mime    = "text/event-stream",
+            .headers = {{"Cache-Control", "no-cache"}, {"Access-Control-Allow-Origin", "*"}},
+        };
+
+        auto client = std::make_unique<pipeline>(std::move(writer), response, m_impl->opts.backlog);
+
+        if (const auto &retry = m_impl->opts.retry; retry.has_value())
+        {
+            client->push(stash::from_str(std::format("retry: {}\n\n", retry->count())));
+        }
+
+        std::lock_guard lock{m_impl->mutex};
+
+        if (m_impl->closed)
+        {
+            return client->finish();
+        }
+
+        if (!m_impl->heartbeat.joinable() && m_impl->opts.heartbeat.count() > 0)
+        {
+            m_impl->heartbeat = std::thread{&impl::beat, m_impl.get()};
+        }
+
+        m_impl->clients.emplace_back(std::move(client));
+        m_impl->count.store(m_impl->clients.size(), std::memory_order_relaxed);
+    }
+
+    void event_stream::publish(const event &value) const
+    {
+        m_impl->broadcast(impl::frame(value));
+    }
+
+    void event_stream::close() const
+    {
+        m_impl->shutdown();
+    }
+
+    std::size_t event_stream::clients() const
+    {
+        return m_impl->count.load(std::memory_order_relaxed);
+    }
+
+    std::size_t event_stream::dropped() const
+    {
+        return m_impl->dropped.load(std::memory_order_relaxed);
+    }
+} // namespace saucer::scheme
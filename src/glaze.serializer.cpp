@@ -1,6 +1,7 @@
 #include "serializers/glaze/glaze.hpp"
 
 #include <optional>
+#include <string_view>
 
 template <>
 struct glz::meta<saucer::serializers::glaze::function_data>
@@ -34,6 +35,22 @@ namespace saucer::serializers::glaze
         .raw_string            = false,
     };
 
+    void function_data::own()
+    {
+        if (params.str.data() == storage.data())
+        {
+            return;
+        }
+
+        storage    = params.str;
+        params.str = storage;
+    }
+
+    std::string_view function_data::raw() const
+    {
+        return params.str;
+    }
+
     serializer::~serializer() = default;
 
     std::string serializer::script() const
@@ -47,7 +64,7 @@ namespace saucer::serializers::glaze
     }
 
     template <typename T>
-    std::optional<T> parse_as(std::string_view buffer)
+    static std::optional<T> parse_as(std::string_view buffer)
     {
         T value{};
 
@@ -59,16 +76,59 @@ namespace saucer::serializers::glaze
         return value;
     }
 
+    static std::string_view discriminator(std::string_view data)
+    {
+        static constexpr auto whitespace = " \t\r\n";
+
+        const auto start = data.find_first_not_of(whitespace);
+
+        if (start == std::string_view::npos || data[start] != '{')
+        {
+            return {};
+        }
+
+        const auto key = data.find_first_not_of(whitespace, start + 1);
+
+        if (key == std::string_view::npos || data[key] != '"')
+        {
+            return {};
+        }
+
+        const auto end = data.find('"', key + 1);
+
+        if (end == std::string_view::npos)
+        {
+            return {};
+        }
+
+        return data.substr(key + 1, end - key - 1);
+    }
+
+    template <typename T>
+    static serializer::parse_result parse_into(std::string_view data)
+    {
+        auto res = parse_as<T>(data);
+
+        if (!res.has_value())
+        {
+            return std::monostate{};
+        }
+
+        return std::make_unique<T>(std::move(*res));
+    }
+
     serializer::parse_result serializer::parse(std::string_view data) const
     {
-        if (auto res = parse_as<function_data>(data); res.has_value())
+        const auto key = discriminator(data);
+
+        if (key == "saucer:call")
         {
-            return std::make_unique<function_data>(*res);
+            return parse_into<function_data>(data);
         }
 
-        if (auto res = parse_as<result_data>(data); res.has_value())
+        if (key == "saucer:resolve")
         {
-            return std::make_unique<result_data>(*res);
+            return parse_into<result_data>(data);
         }
 
         return std::monostate{};
@@ -1,6 +1,9 @@
 #include "gtk.app.impl.hpp"
 
 #include <format>
+#include <ranges>
+#include <utility>
+#include <algorithm>
 
 namespace saucer
 {
@@ -31,6 +34,15 @@ namespace saucer
             g_application_hold(G_APPLICATION(platform->application.get()));
         }
 
+        auto on_memory = [](GMemoryMonitor *, GMemoryMonitorWarningLevel level, impl *self)
+        {
+            const auto pressure = level >= G_MEMORY_MONITOR_WARNING_LEVEL_CRITICAL ? memory_pressure::critical : memory_pressure::warning;
+            self->events.get<event::memory>().fire(pressure);
+        };
+
+        platform->memory_monitor = utils::g_object_ptr<GMemoryMonitor>{g_memory_monitor_dup_default()};
+        utils::connect(platform->memory_monitor.get(), "low-memory-warning", +on_memory, this);
+
         return {};
     }
 
@@ -55,15 +67,71 @@ namespace saucer
         return rtn;
     }
 
-    void application::post(post_callback_t callback) const // NOLINT(*-static)
+    void impl::wake(priority priority)
     {
-        auto once = [](post_callback_t *data)
+        using data_t = utils::rental<impl *>;
+
+        auto once = [](data_t *data)
         {
-            auto callback = std::unique_ptr<post_callback_t>{data};
-            (*callback)();
+            auto locked = data->access();
+
+            if (auto *const self = locked.value(); self)
+            {
+                (*self)->queue.drain();
+            }
+
+            return G_SOURCE_REMOVE;
         };
 
-        g_idle_add_once(reinterpret_cast<GSourceOnceFunc>(+once), new post_callback_t{std::move(callback)});
+        auto *const data    = new data_t{lease.rent()};
+        auto *const destroy = reinterpret_cast<GDestroyNotify>(+[](data_t *data) { delete data; });
+
+        g_idle_add_full(native::convert(priority), reinterpret_cast<GSourceFunc>(+once), data, destroy);
+    }
+
+    void impl::start_timer(std::size_t id, std::chrono::milliseconds interval, timer_precision precision, bool)
+    {
+        using data_t = std::pair<impl *, std::size_t>;
+
+        auto tick = [](data_t *data)
+        {
+            auto &[self, id] = *data;
+
+            if (self->fire(id))
+            {
+                return G_SOURCE_CONTINUE;
+            }
+
+            self->platform->timers.erase(id);
+
+            return G_SOURCE_REMOVE;
+        };
+
+        auto *const data    = new data_t{this, id};
+        auto *const destroy = reinterpret_cast<GDestroyNotify>(+[](data_t *data) { delete data; });
+        auto *const func    = reinterpret_cast<GSourceFunc>(+tick);
+
+        // Second granularity lets GLib wake up for all coarse timers at once
+        if (precision == timer_precision::very_coarse)
+        {
+            const auto seconds = std::max(std::chrono::ceil<std::chrono::seconds>(interval).count(), std::int64_t{1});
+            platform->timers[id] = g_timeout_add_seconds_full(G_PRIORITY_DEFAULT, static_cast<guint>(seconds), func, data, destroy);
+            return;
+        }
+
+        platform->timers[id] = g_timeout_add_full(G_PRIORITY_DEFAULT, static_cast<guint>(interval.count()), func, data, destroy);
+    }
+
+    void impl::stop_timer(std::size_t id) // NOLINT(*-const)
+    {
+        auto node = platform->timers.extract(id);
+
+        if (node.empty())
+        {
+            return;
+        }
+
+        g_source_remove(node.mapped());
     }
 
     int impl::run(application *self, callback_t callback)
@@ -80,6 +148,19 @@ namespace saucer
             std::call_once(flag, callback, self);
         };
 
+        auto startup = [](GtkApplication *, impl *self)
+        {
+            auto changed = [](GListModel *, guint, guint, guint, impl *self)
+            {
+                self->screens_changed();
+            };
+
+            auto *const monitors = gdk_display_get_monitors(gdk_display_get_default());
+            utils::connect(monitors, "items-changed", +changed, self);
+        };
+
+        utils::connect(platform->application.get(), "startup", +startup, this);
+
         utils::connect(platform->application.get(), "activate", +activate, &data);
         const auto rtn = g_application_run(G_APPLICATION(platform->application.get()), platform->argc, platform->argv);
 
@@ -88,6 +169,82 @@ namespace saucer
         return rtn;
     }
 
+    poll_set impl::prepare()
+    {
+        auto *const context = g_main_context_default();
+
+        if (!g_main_context_acquire(context))
+        {
+            return {.timeout = poll_interval};
+        }
+
+        gint priority{};
+        g_main_context_prepare(context, &priority);
+
+        gint timeout{};
+        std::vector<GPollFD> fds(8);
+
+        auto query = [&]
+        {
+            return static_cast<std::size_t>(g_main_context_query(context, priority, &timeout, fds.data(), static_cast<gint>(fds.size())));
+        };
+
+        if (const auto count = query(); count > fds.size())
+        {
+            fds.resize(count);
+        }
+
+        fds.resize(std::min(query(), fds.size()));
+
+        g_main_context_release(context);
+        platform->poll_priority.emplace(priority);
+
+        auto convert = [](const GPollFD &fd)
+        {
+            return poll_handle{.handle = fd.fd, .events = fd.events, .revents = 0};
+        };
+
+        return {
+            .handles = fds | std::views::transform(convert) | std::ranges::to<std::vector>(),
+            .timeout = timeout < 0 ? std::nullopt : std::make_optional(std::chrono::milliseconds{timeout}),
+        };
+    }
+
+    bool impl::process(const poll_set &set)
+    {
+        if (!platform->poll_priority.has_value())
+        {
+            return false;
+        }
+
+        auto *const context = g_main_context_default();
+
+        if (!g_main_context_acquire(context))
+        {
+            return false;
+        }
+
+        auto convert = [](const poll_handle &handle)
+        {
+            return GPollFD{.fd = static_cast<gint>(handle.handle), .events = handle.events, .revents = handle.revents};
+        };
+
+        auto fds = set.handles | std::views::transform(convert) | std::ranges::to<std::vector>();
+
+        // `g_main_context_check` has to follow every `g_main_context_prepare`, even if nothing became ready
+        const auto priority = *std::exchange(platform->poll_priority, std::nullopt);
+        const bool ready    = g_main_context_check(context, priority, fds.data(), static_cast<gint>(fds.size()));
+
+        if (ready)
+        {
+            g_main_context_dispatch(context);
+        }
+
+        g_main_context_release(context);
+
+        return ready;
+    }
+
     void impl::quit() // NOLINT(*-const)
     {
         g_application_quit(G_APPLICATION(platform->application.get()));
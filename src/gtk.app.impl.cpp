@@ -26,6 +26,23 @@ namespace saucer
         };
     }
 
+    int native::convert(priority priority)
+    {
+        using enum saucer::priority;
+
+        switch (priority)
+        {
+        case interactive:
+            return G_PRIORITY_DEFAULT;
+        case normal:
+            return G_PRIORITY_DEFAULT_IDLE;
+        case background:
+            return G_PRIORITY_LOW;
+        }
+
+        std::unreachable();
+    }
+
     std::string native::fix_id(const std::string &id)
     {
         return id                                                                                            //
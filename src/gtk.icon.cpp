@@ -43,12 +43,17 @@ namespace saucer
             return stash::empty();
         }
 
-        const auto bytes = utils::g_bytes_ptr{gdk_texture_save_to_png_bytes(m_impl->texture.get())};
+        auto encode = [texture = m_impl->texture.get()]
+        {
+            const auto bytes = utils::g_bytes_ptr{gdk_texture_save_to_png_bytes(texture)};
+
+            gsize size{};
+            const auto *data = reinterpret_cast<const std::uint8_t *>(g_bytes_get_data(bytes.get(), &size));
 
-        gsize size{};
-        const auto *data = reinterpret_cast<const std::uint8_t *>(g_bytes_get_data(bytes.get(), &size));
+            return std::vector<std::uint8_t>{data, data + size};
+        };
 
-        return stash::from({data, data + size});
+        return m_impl->png.get(encode);
     }
 
     void icon::save(const fs::path &path) const
@@ -195,6 +195,13 @@ namespace saucer
     void impl::show() const
     {
         parent->native<false>()->platform->instances[platform->window.get()] = true;
+
+        if (offscreen)
+        {
+            gtk_widget_realize(GTK_WIDGET(platform->window.get()));
+            return;
+        }
+
         gtk_window_present(platform->window.get());
     }
 
@@ -2,6 +2,7 @@
 
 #include "gtk.app.impl.hpp"
 
+#include <utility>
 #include <algorithm>
 
 namespace saucer
@@ -53,10 +54,32 @@ namespace saucer
             return;
         }
 
-        auto callback = [](void *, GParamSpec *, impl *self)
+        static constexpr auto tick = [](GtkWidget *, GdkFrameClock *, gpointer data)
         {
+            auto *const self     = static_cast<impl *>(data);
+            self->resize_pending = false;
+
             auto [width, height] = self->size();
             self->events.get<event::resize>().fire(width, height);
+
+            return G_SOURCE_REMOVE;
+        };
+
+        auto callback = [](void *, GParamSpec *, impl *self)
+        {
+            if (!self->coalesce_resize.load(std::memory_order_relaxed))
+            {
+                auto [width, height] = self->size();
+                self->events.get<event::resize>().fire(width, height);
+                return;
+            }
+
+            if (std::exchange(self->resize_pending, true))
+            {
+                return;
+            }
+
+            gtk_widget_add_tick_callback(GTK_WIDGET(self->platform->window.get()), +tick, self, nullptr);
         };
 
         const auto width  = utils::connect(window.get(), "notify::default-width", +callback, self);
@@ -113,6 +136,34 @@ namespace saucer
         event.on_clear([this, id] { g_signal_handler_disconnect(window.get(), id); });
     }
 
+    template <>
+    void native::setup<event::frame>(impl *self)
+    {
+        auto &event = self->events.get<event::frame>();
+
+        if (!event.empty())
+        {
+            return;
+        }
+
+        auto callback = [](GtkWidget *, GdkFrameClock *, gpointer data)
+        {
+            auto *const self = static_cast<impl *>(data);
+
+            if (self->minimized() || !self->visible())
+            {
+                return G_SOURCE_CONTINUE;
+            }
+
+            self->events.get<event::frame>().fire();
+
+            return G_SOURCE_CONTINUE;
+        };
+
+        const auto id = gtk_widget_add_tick_callback(GTK_WIDGET(window.get()), +callback, self, nullptr);
+        event.on_clear([this, id] { gtk_widget_remove_tick_callback(GTK_WIDGET(window.get()), id); });
+    }
+
     template <>
     void native::setup<event::close>(impl *)
     {
@@ -0,0 +1,176 @@
+#include "header_list.hpp"
+
+#include <iterator>
+#include <algorithm>
+
+namespace saucer::scheme
+{
+    static bool equal(std::string_view first, std::string_view second)
+    {
+        static constexpr auto lower = [](unsigned char c)
+        {
+            return c >= 'A' && c <= 'Z' ? static_cast<unsigned char>(c + ('a' - 'A')) : c;
+        };
+
+        return std::ranges::equal(first, second, {}, lower, lower);
+    }
+
+    header_text::header_text() noexcept : m_value(std::string_view{""}) {}
+
+    bool header_text::owned() const noexcept
+    {
+        return std::holds_alternative<std::string>(m_value);
+    }
+
+    std::size_t header_text::size() const noexcept
+    {
+        return view().size();
+    }
+
+    const char *header_text::c_str() const noexcept
+    {
+        return view().c_str();
+    }
+
+    cstring_view header_text::view() const noexcept
+    {
+        // Views are only created by the consteval constructor, so both alternatives are null-terminated
+        if (const auto *value = std::get_if<std::string>(&m_value); value)
+        {
+            return {value->c_str(), value->size()};
+        }
+
+        const auto &value = std::get<std::string_view>(m_value);
+        return {value.data(), value.size()};
+    }
+
+    header_text::operator std::string_view() const noexcept
+    {
+        return view();
+    }
+
+    bool header_text::operator==(std::string_view other) const noexcept
+    {
+        return static_cast<std::string_view>(*this) == other;
+    }
+
+    header_list::header_list() = default;
+
+    header_list::header_list(std::initializer_list<header_field> headers)
+    {
+        for (const auto &[name, value] : headers)
+        {
+            insert_or_assign(name, value);
+        }
+    }
+
+    header_list::header_list(const header_list &) = default;
+
+    header_list::header_list(header_list &&other) noexcept
+        : m_size(std::exchange(other.m_size, 0)), m_inline(std::move(other.m_inline)), m_spilled(std::move(other.m_spilled))
+    {
+    }
+
+    header_list &header_list::operator=(const header_list &) = default;
+
+    header_list &header_list::operator=(header_list &&other) noexcept
+    {
+        if (this != &other)
+        {
+            m_size    = std::exchange(other.m_size, 0);
+            m_inline  = std::move(other.m_inline);
+            m_spilled = std::move(other.m_spilled);
+        }
+
+        return *this;
+    }
+
+    header_list::~header_list() = default;
+
+    header_field *header_list::data() noexcept
+    {
+        return m_spilled.empty() ? m_inline.data() : m_spilled.data();
+    }
+
+    const header_field *header_list::data() const noexcept
+    {
+        return m_spilled.empty() ? m_inline.data() : m_spilled.data();
+    }
+
+    void header_list::push(header_field entry)
+    {
+        if (m_spilled.empty() && m_size < inline_capacity)
+        {
+            m_inline[m_size++] = std::move(entry);
+            return;
+        }
+
+        if (m_spilled.empty())
+        {
+            m_spilled.reserve(inline_capacity * 2);
+            std::ranges::move(m_inline, std::back_inserter(m_spilled));
+        }
+
+        m_spilled.emplace_back(std::move(entry));
+        m_size++;
+    }
+
+    bool header_list::empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    std::size_t header_list::size() const noexcept
+    {
+        return m_size;
+    }
+
+    header_list::iterator header_list::begin() noexcept
+    {
+        return data();
+    }
+
+    header_list::iterator header_list::end() noexcept
+    {
+        return data() + m_size;
+    }
+
+    header_list::const_iterator header_list::begin() const noexcept
+    {
+        return data();
+    }
+
+    header_list::const_iterator header_list::end() const noexcept
+    {
+        return data() + m_size;
+    }
+
+    header_list::const_iterator header_list::find(std::string_view name) const noexcept
+    {
+        return std::ranges::find_if(*this, [name](const header_field &entry) { return equal(entry.name, name); });
+    }
+
+    bool header_list::emplace(header_text name, header_text value)
+    {
+        if (find(name) != end())
+        {
+            return false;
+        }
+
+        push({std::move(name), std::move(value)});
+
+        return true;
+    }
+
+    void header_list::insert_or_assign(header_text name, header_text value)
+    {
+        const auto it = find(name);
+
+        if (it == end())
+        {
+            return push({std::move(name), std::move(value)});
+        }
+
+        begin()[it - begin()].value = std::move(value);
+    }
+} // namespace saucer::scheme
@@ -0,0 +1,155 @@
+#include <saucer/icon.hpp>
+
+#include "pool.hpp"
+
+#include <array>
+#include <vector>
+#include <cstring>
+#include <optional>
+#include <algorithm>
+
+namespace saucer
+{
+    static constexpr auto header_size = 6uz;
+    static constexpr auto entry_size  = 16uz;
+
+    template <typename T>
+    static T read(const std::uint8_t *data)
+    {
+        T rtn{};
+
+        for (auto i = 0uz; sizeof(T) > i; i++)
+        {
+            rtn |= static_cast<T>(static_cast<T>(data[i]) << (8 * i));
+        }
+
+        return rtn;
+    }
+
+    static stash select(const stash &ico, std::size_t size)
+    {
+        const auto *const data = ico.data();
+        const auto total       = ico.size();
+
+        if (total < header_size || read<std::uint16_t>(data) != 0 || read<std::uint16_t>(data + 2) != 1)
+        {
+            return stash::view({data, total});
+        }
+
+        const auto count = read<std::uint16_t>(data + 4);
+
+        if (count <= 1 || total < header_size + (count * entry_size))
+        {
+            return stash::view({data, total});
+        }
+
+        struct candidate
+        {
+            std::size_t edge;
+            std::uint16_t depth;
+            const std::uint8_t *entry;
+        };
+
+        std::optional<candidate> best;
+
+        auto better = [size](const candidate &current, const candidate &other)
+        {
+            const auto fits       = current.edge >= size;
+            const auto other_fits = other.edge >= size;
+
+            if (fits != other_fits)
+            {
+                return fits;
+            }
+
+            if (current.edge != other.edge)
+            {
+                return fits ? current.edge < other.edge : current.edge > other.edge;
+            }
+
+            return current.depth > other.depth;
+        };
+
+        for (auto i = 0uz; count > i; i++)
+        {
+            const auto *const entry = data + header_size + (i * entry_size);
+
+            const auto length = read<std::uint32_t>(entry + 8);
+            const auto offset = read<std::uint32_t>(entry + 12);
+
+            if (offset > total || length > total - offset)
+            {
+                continue;
+            }
+
+            const auto edge    = entry[0] == 0 ? 256uz : static_cast<std::size_t>(entry[0]);
+            const auto current = candidate{.edge = edge, .depth = read<std::uint16_t>(entry + 6), .entry = entry};
+
+            if (!best || better(current, *best))
+            {
+                best.emplace(current);
+            }
+        }
+
+        if (!best)
+        {
+            return stash::view({data, total});
+        }
+
+        const auto length = read<std::uint32_t>(best->entry + 8);
+        const auto offset = read<std::uint32_t>(best->entry + 12);
+
+        auto rtn = std::vector<std::uint8_t>(header_size + entry_size + length);
+
+        static constexpr auto header = std::array<std::uint8_t, header_size>{0, 0, 1, 0, 1, 0};
+        static constexpr auto start  = static_cast<std::uint32_t>(header_size + entry_size);
+
+        std::ranges::copy(header, rtn.begin());
+        std::memcpy(rtn.data() + header_size, best->entry, 12);
+
+        for (auto i = 0uz; sizeof(start) > i; i++)
+        {
+            rtn[header_size + 12 + i] = static_cast<std::uint8_t>(start >> (8 * i));
+        }
+
+        std::memcpy(rtn.data() + start, data + offset, length);
+
+        return stash::from(std::move(rtn));
+    }
+
+    result<icon> icon::from(const stash &ico, std::size_t size)
+    {
+        return from(select(ico, size));
+    }
+
+    coco::future<result<icon>> icon::load(const stash &ico, std::optional<std::size_t> size)
+    {
+        auto promise = coco::promise<result<icon>>{};
+        auto rtn     = promise.get_future();
+
+        auto decode = [data = std::vector<std::uint8_t>{ico.data(), ico.data() + ico.size()}, size, promise = std::move(promise)]() mutable
+        {
+            const auto ico = stash::view(data);
+            promise.set_value(size.has_value() ? from(ico, *size) : from(ico));
+        };
+
+        utils::pool::shared().submit(std::move(decode));
+
+        return rtn;
+    }
+
+    coco::future<result<icon>> icon::load(fs::path file)
+    {
+        auto promise = coco::promise<result<icon>>{};
+        auto rtn     = promise.get_future();
+
+        auto decode = [file = std::move(file), promise = std::move(promise)]() mutable
+        {
+            promise.set_value(from(file));
+        };
+
+        utils::pool::shared().submit(std::move(decode));
+
+        return rtn;
+    }
+} // namespace saucer
@@ -0,0 +1,509 @@
+#include "instance.hpp"
+
+#include "handle.hpp"
+#include "threads.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <format>
+#include <thread>
+#include <ranges>
+#include <cstddef>
+#include <optional>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/un.h>
+#include <sys/file.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#endif
+
+namespace saucer::utils
+{
+#ifdef _WIN32
+    using handle_t = HANDLE;
+#else
+    using handle_t = int;
+#endif
+
+    struct single_instance::native
+    {
+        std::string endpoint;
+        handle_t handle;
+
+      public:
+        std::atomic_bool stop{false};
+        std::thread thread;
+    };
+
+    namespace
+    {
+        // Wake-ups and probes connect without sending anything, a forwarded launch always leads with this
+        constexpr std::string_view header = "saucer:instance\n";
+
+        std::string pack(const std::vector<std::string> &args)
+        {
+            auto rtn = std::string{header};
+
+            for (const auto &arg : args)
+            {
+                rtn.append(arg).push_back('\0');
+            }
+
+            return rtn;
+        }
+
+        std::optional<std::vector<std::string>> unpack(std::string_view data)
+        {
+            if (!data.starts_with(header))
+            {
+                return std::nullopt;
+            }
+
+            std::vector<std::string> rtn;
+            data.remove_prefix(header.size());
+
+            if (data.empty())
+            {
+                return rtn;
+            }
+
+            data.remove_suffix(data.back() == '\0' ? 1 : 0);
+
+            for (const auto &arg : data | std::views::split('\0'))
+            {
+                rtn.emplace_back(arg.begin(), arg.end());
+            }
+
+            return rtn;
+        }
+
+#ifndef _WIN32
+        int make_socket()
+        {
+            const auto rtn = socket(AF_UNIX, SOCK_STREAM, 0);
+
+            if (rtn < 0)
+            {
+                return rtn;
+            }
+
+            fcntl(rtn, F_SETFD, FD_CLOEXEC);
+
+#ifdef SO_NOSIGPIPE
+            // There is no `MSG_NOSIGNAL` on macOS, a listener going away must not kill us with `SIGPIPE`
+            static constexpr int enabled = 1;
+            setsockopt(rtn, SOL_SOCKET, SO_NOSIGPIPE, &enabled, sizeof(enabled));
+#endif
+
+            return rtn;
+        }
+
+        sockaddr_un address(const std::string &endpoint)
+        {
+            sockaddr_un rtn{};
+
+            rtn.sun_family = AF_UNIX;
+            std::memcpy(rtn.sun_path, endpoint.data(), std::min(endpoint.size(), sizeof(rtn.sun_path) - 1));
+
+            return rtn;
+        }
+
+        socklen_t length(const std::string &endpoint)
+        {
+            return static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + std::min(endpoint.size(), sizeof(sockaddr_un::sun_path) - 1));
+        }
+
+        bool trusted(int client)
+        {
+            // Abstract sockets have no file permissions, any local user could connect and hand us arguments otherwise
+#ifdef __APPLE__
+            uid_t uid{};
+            gid_t gid{};
+
+            if (getpeereid(client, &uid, &gid) != 0)
+            {
+                return false;
+            }
+
+            return uid == getuid();
+#else
+            ucred peer{};
+            socklen_t size = sizeof(peer);
+
+            if (getsockopt(client, SOL_SOCKET, SO_PEERCRED, &peer, &size) != 0)
+            {
+                return false;
+            }
+
+            return peer.uid == getuid();
+#endif
+        }
+
+#ifdef __APPLE__
+        bool stale(const std::string &endpoint)
+        {
+            const auto fd = make_socket();
+
+            if (fd < 0)
+            {
+                return false;
+            }
+
+            const auto addr    = address(endpoint);
+            const auto refused = connect(fd, reinterpret_cast<const sockaddr *>(&addr), length(endpoint)) != 0 && errno == ECONNREFUSED;
+
+            close(fd);
+
+            return refused;
+        }
+#endif
+
+        bool claim(int handle, const std::string &endpoint)
+        {
+            const auto addr = address(endpoint);
+            const auto *raw = reinterpret_cast<const sockaddr *>(&addr);
+
+            if (bind(handle, raw, length(endpoint)) == 0)
+            {
+                return ::listen(handle, SOMAXCONN) == 0;
+            }
+
+#ifdef __APPLE__
+            if (errno != EADDRINUSE)
+            {
+                return false;
+            }
+
+            // Launches that all found the socket stale take turns, whoever comes after the first one finds it answering again
+            const auto lock = utils::handle<int, ::close, -1>{open((endpoint + ".lock").c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600)};
+
+            if (lock.get() < 0 || flock(lock.get(), LOCK_EX) != 0)
+            {
+                return false;
+            }
+
+            // Only a socket nobody answers on is left over from an instance that did not exit cleanly
+            if (!stale(endpoint))
+            {
+                return false;
+            }
+
+            unlink(endpoint.c_str());
+
+            return bind(handle, raw, length(endpoint)) == 0 && ::listen(handle, SOMAXCONN) == 0;
+#else
+            return false;
+#endif
+        }
+#endif
+
+        // Persistent failures (running out of descriptors, for one) must not have the listener spin
+        void back_off(std::size_t &failures)
+        {
+            static constexpr auto base = std::chrono::milliseconds{10};
+            static constexpr auto cap  = std::chrono::milliseconds{500};
+
+            failures = std::min(failures + 1, 6uz);
+            std::this_thread::sleep_for(std::min(base * (1 << failures), cap));
+        }
+
+        bool send(const std::string &endpoint, std::string_view data)
+        {
+#ifdef _WIN32
+            const auto name = std::wstring{endpoint.begin(), endpoint.end()};
+            auto *pipe      = CreateFileW(name.c_str(), GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, 0, nullptr);
+
+            // The listener serves one client at a time, others wait for the pipe to become available
+            if (pipe == INVALID_HANDLE_VALUE && GetLastError() == ERROR_PIPE_BUSY && WaitNamedPipeW(name.c_str(), 1000))
+            {
+                pipe = CreateFileW(name.c_str(), GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, 0, nullptr);
+            }
+
+            if (pipe == INVALID_HANDLE_VALUE)
+            {
+                return false;
+            }
+
+            auto ok = true;
+
+            for (DWORD written{}; ok && !data.empty(); data.remove_prefix(written))
+            {
+                ok = WriteFile(pipe, data.data(), static_cast<DWORD>(data.size()), &written, nullptr);
+            }
+
+            FlushFileBuffers(pipe);
+            CloseHandle(pipe);
+
+            return ok;
+#else
+            const auto fd = make_socket();
+
+            if (fd < 0)
+            {
+                return false;
+            }
+
+            const auto addr = address(endpoint);
+
+            if (connect(fd, reinterpret_cast<const sockaddr *>(&addr), length(endpoint)) != 0)
+            {
+                close(fd);
+                return false;
+            }
+
+            auto ok = true;
+
+            while (ok && !data.empty())
+            {
+#ifdef MSG_NOSIGNAL
+                const auto written = ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+#else
+                const auto written = ::send(fd, data.data(), data.size(), 0);
+#endif
+
+                ok = written > 0;
+                data.remove_prefix(ok ? static_cast<std::size_t>(written) : data.size());
+            }
+
+            // Waiting for the listener to hang up guarantees the arguments were received before we exit
+            shutdown(fd, SHUT_WR);
+
+            for (char buffer{}; recv(fd, &buffer, sizeof(buffer), 0) > 0;)
+            {
+            }
+
+            close(fd);
+
+            return ok;
+#endif
+        }
+
+        void wake(const std::string &endpoint)
+        {
+#ifdef _WIN32
+            send(endpoint, {});
+#else
+            // Unlike `send` we do not wait for a hang up, the listener might be done before it ever accepts us
+            const auto fd = make_socket();
+
+            if (fd < 0)
+            {
+                return;
+            }
+
+            const auto addr = address(endpoint);
+            connect(fd, reinterpret_cast<const sockaddr *>(&addr), length(endpoint));
+
+            close(fd);
+#endif
+        }
+
+        std::optional<std::string> receive(handle_t handle)
+        {
+            std::string rtn;
+            char buffer[4096];
+
+#ifdef _WIN32
+            BOOL ok{TRUE};
+
+            for (DWORD read{}; (ok = ReadFile(handle, buffer, sizeof(buffer), &read, nullptr)) && read > 0;)
+            {
+                rtn.append(buffer, read);
+            }
+
+            // The destructor cancels reads from clients that never hang up
+            if (!ok && GetLastError() == ERROR_OPERATION_ABORTED)
+            {
+                return std::nullopt;
+            }
+#else
+            // A client that connects but never finishes sending must not keep the listener (and thus our destructor) waiting
+            static constexpr auto limit = std::chrono::seconds{2};
+            const auto timeout          = timeval{.tv_sec = static_cast<decltype(timeval::tv_sec)>(limit.count()), .tv_usec = 0};
+
+            setsockopt(handle, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+            auto read = recv(handle, buffer, sizeof(buffer), 0);
+
+            for (; read > 0; read = recv(handle, buffer, sizeof(buffer), 0))
+            {
+                rtn.append(buffer, static_cast<std::size_t>(read));
+            }
+
+            // Partial arguments from a client that timed out (or failed) are dropped
+            if (read < 0)
+            {
+                return std::nullopt;
+            }
+#endif
+
+            return rtn;
+        }
+    } // namespace
+
+    std::string single_instance::endpoint(std::string_view id)
+    {
+        // FNV-1a keeps the endpoint stable between launches, unlike `std::hash`
+        auto hash = 0xcbf29ce484222325ull;
+
+        for (const auto ch : id)
+        {
+            hash = (hash ^ static_cast<unsigned char>(ch)) * 0x100000001b3ull;
+        }
+
+#ifdef _WIN32
+        DWORD session{};
+        ProcessIdToSessionId(GetCurrentProcessId(), &session);
+
+        return std::format(R"(\\.\pipe\saucer-{:016x}-{})", hash, session);
+#elif defined(__APPLE__)
+        // The temporary directory is private to the user on macOS
+        const auto *tmp = std::getenv("TMPDIR");
+        return std::format("{}/saucer-{:016x}.sock", tmp ? tmp : "/tmp", hash);
+#else
+        // Abstract sockets (leading NUL) vanish with their owner, so a crashed instance leaves nothing stale behind
+        return std::format("{}saucer-{:016x}-{}", '\0', hash, getuid());
+#endif
+    }
+
+    single_instance::single_instance() : m_native(std::make_unique<native>()) {}
+
+    single_instance::~single_instance()
+    {
+        m_native->stop = true;
+
+        // Connecting to ourselves wakes the listener, which is blocked waiting for a client
+        wake(m_native->endpoint);
+
+        if (m_native->thread.joinable())
+        {
+#ifdef _WIN32
+            // The pipe is busy while a client is still connected, which leaves the listener reading instead
+            CancelSynchronousIo(m_native->thread.native_handle());
+#endif
+            m_native->thread.join();
+        }
+
+#ifdef __APPLE__
+        // Removed while we still listen on it, a launch that claims the endpoint after us must not lose its socket
+        unlink(m_native->endpoint.c_str());
+#endif
+
+#ifdef _WIN32
+        CloseHandle(m_native->handle);
+#else
+        close(m_native->handle);
+#endif
+    }
+
+    bool single_instance::forward(std::string_view id, const std::vector<std::string> &args)
+    {
+        return send(endpoint(id), pack(args));
+    }
+
+    std::unique_ptr<single_instance> single_instance::listen(std::string_view id, callback callback)
+    {
+        auto name = endpoint(id);
+
+#ifdef _WIN32
+        static constexpr auto mode  = PIPE_ACCESS_INBOUND | FILE_FLAG_FIRST_PIPE_INSTANCE;
+        static constexpr auto flags = PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS;
+
+        const auto wide = std::wstring{name.begin(), name.end()};
+        auto *handle    = CreateNamedPipeW(wide.c_str(), mode, flags, 1, 0, 64 * 1024, 0, nullptr);
+
+        if (handle == INVALID_HANDLE_VALUE)
+        {
+            return nullptr;
+        }
+#else
+        const auto handle = make_socket();
+
+        if (handle < 0)
+        {
+            return nullptr;
+        }
+
+        if (!claim(handle, name))
+        {
+            close(handle);
+            return nullptr;
+        }
+#endif
+
+        auto rtn                = std::unique_ptr<single_instance>{new single_instance};
+        rtn->m_native->handle   = handle;
+        rtn->m_native->endpoint = std::move(name);
+
+        auto serve = [state = rtn->m_native.get(), callback = std::move(callback)]
+        {
+            utils::apply(thread_role::helper);
+
+            for (std::size_t failures{0}; !state->stop;)
+            {
+#ifdef _WIN32
+                if (!ConnectNamedPipe(state->handle, nullptr) && GetLastError() != ERROR_PIPE_CONNECTED)
+                {
+                    // The client was gone before we got to it, the pipe has to be disconnected before it can be reused
+                    if (GetLastError() == ERROR_NO_DATA)
+                    {
+                        DisconnectNamedPipe(state->handle);
+                        continue;
+                    }
+
+                    back_off(failures);
+                    continue;
+                }
+
+                auto data = receive(state->handle);
+                DisconnectNamedPipe(state->handle);
+#else
+                const auto client = accept(state->handle, nullptr, nullptr);
+
+                if (client < 0 && (errno == EINTR || errno == ECONNABORTED))
+                {
+                    continue;
+                }
+
+                if (client < 0)
+                {
+                    back_off(failures);
+                    continue;
+                }
+
+                auto data = trusted(client) ? receive(client) : std::nullopt;
+                close(client);
+#endif
+
+                failures = 0;
+
+                if (state->stop)
+                {
+                    break;
+                }
+
+                auto args = data.has_value() ? unpack(*data) : std::nullopt;
+
+                if (!args.has_value())
+                {
+                    continue;
+                }
+
+                callback(std::move(*args));
+            }
+        };
+
+        rtn->m_native->thread = std::thread{std::move(serve)};
+
+        return rtn;
+    }
+} // namespace saucer::utils
@@ -0,0 +1,54 @@
+#include "metrics.impl.hpp"
+
+#include <algorithm>
+
+namespace saucer::utils
+{
+    void metrics::observe(std::chrono::nanoseconds elapsed)
+    {
+        const auto ms     = std::chrono::duration<double, std::milli>(elapsed).count();
+        const auto bucket = std::ranges::lower_bound(histogram::bounds, ms) - histogram::bounds.begin();
+
+        latency[bucket].fetch_add(1, std::memory_order_relaxed);
+        latency_sum.fetch_add(static_cast<std::uint64_t>(elapsed.count()), std::memory_order_relaxed);
+        latency_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    saucer::metrics metrics::snapshot() const
+    {
+        static constexpr auto relaxed = std::memory_order_relaxed;
+
+        auto rtn = saucer::metrics{
+            .queued              = 0,
+            .pending_evaluations = static_cast<std::size_t>(std::max<std::int64_t>(evaluations.load(relaxed), 0)),
+            .exposed_calls       = calls.load(relaxed),
+            .call_latency        = {},
+            .scheme_requests     = scheme_requests.load(relaxed),
+            .scheme_bytes        = scheme_bytes.load(relaxed),
+            .stream_writers      = static_cast<std::size_t>(std::max<std::int64_t>(stream_writers.load(relaxed), 0)),
+        };
+
+        std::ranges::transform(latency, rtn.call_latency.buckets.begin(), [](const auto &value) { return value.load(relaxed); });
+
+        rtn.call_latency.count = latency_count.load(relaxed);
+        rtn.call_latency.sum   = static_cast<double>(latency_sum.load(relaxed)) / 1'000'000.0;
+
+        return rtn;
+    }
+
+    metrics &metrics::get()
+    {
+        static metrics instance;
+        return instance;
+    }
+
+    tracked::tracked(std::atomic_int64_t &gauge) : m_gauge(&gauge)
+    {
+        m_gauge->fetch_add(1, std::memory_order_relaxed);
+    }
+
+    tracked::~tracked()
+    {
+        m_gauge->fetch_sub(1, std::memory_order_relaxed);
+    }
+} // namespace saucer::utils
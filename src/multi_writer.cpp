@@ -0,0 +1,193 @@
+#include <saucer/multi_writer.hpp>
+
+#include <map>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace saucer::scheme
+{
+    struct multi_writer::impl
+    {
+        struct node;
+
+      public:
+        stream_writer writer;
+
+      public:
+        std::atomic<node *> head{nullptr};
+        std::atomic_size_t next{0};
+
+      public:
+        std::atomic_size_t signals{0};
+        std::atomic_bool draining{false};
+        std::atomic_bool closed{false};
+
+      public:
+        std::atomic_bool finishing{false};
+        std::atomic_size_t total{0};
+
+      public:
+        std::atomic_bool rejected{false};
+        std::atomic<error> failure{error::failed};
+
+      public:
+        std::size_t expected{0};
+        std::map<std::size_t, stash> pending;
+
+      public:
+        ~impl();
+
+      public:
+        void push(std::size_t, stash);
+
+      public:
+        void drain();
+        void notify();
+        void flush();
+        void close();
+    };
+
+    struct multi_writer::impl::node
+    {
+        std::size_t sequence;
+        stash data;
+
+      public:
+        node *next;
+    };
+
+    multi_writer::impl::~impl()
+    {
+        auto *current = head.exchange(nullptr);
+
+        while (current)
+        {
+            delete std::exchange(current, current->next);
+        }
+    }
+
+    void multi_writer::impl::push(std::size_t sequence, stash data)
+    {
+        auto *const entry = new node{.sequence = sequence, .data = std::move(data), .next = head.load(std::memory_order_relaxed)};
+
+        while (!head.compare_exchange_weak(entry->next, entry))
+        {
+        }
+    }
+
+    void multi_writer::impl::drain()
+    {
+        // Whoever wins the flag writes on behalf of everyone else, so the backend only ever sees a single producer
+        while (!draining.exchange(true))
+        {
+            const auto seen = signals.load();
+
+            for (auto *current = head.exchange(nullptr); current;)
+            {
+                auto owned = std::unique_ptr<node>{std::exchange(current, current->next)};
+                pending.insert_or_assign(owned->sequence, std::move(owned->data));
+            }
+
+            flush();
+
+            draining.store(false);
+
+            if (signals.load() == seen)
+            {
+                return;
+            }
+        }
+    }
+
+    void multi_writer::impl::notify()
+    {
+        signals.fetch_add(1);
+        drain();
+    }
+
+    void multi_writer::impl::flush()
+    {
+        if (closed.load())
+        {
+            pending.clear();
+            return;
+        }
+
+        if (rejected.load())
+        {
+            close();
+            return writer.reject(failure.load());
+        }
+
+        while (!pending.empty() && pending.begin()->first == expected)
+        {
+            auto entry = pending.extract(pending.begin());
+            expected++;
+
+            if (writer.write(std::move(entry.mapped())) != write_status::closed)
+            {
+                continue;
+            }
+
+            return close();
+        }
+
+        if (!finishing.load() || expected < total.load())
+        {
+            return;
+        }
+
+        close();
+        writer.finish();
+    }
+
+    void multi_writer::impl::close()
+    {
+        closed.store(true);
+        pending.clear();
+    }
+
+    multi_writer::multi_writer(stream_writer writer, const stream_response &response)
+        : m_impl(std::make_shared<impl>(std::move(writer)))
+    {
+        m_impl->writer.start(response);
+    }
+
+    std::size_t multi_writer::reserve(std::size_t count) const
+    {
+        return m_impl->next.fetch_add(count);
+    }
+
+    write_status multi_writer::write(stash data) const
+    {
+        return write(reserve(), std::move(data));
+    }
+
+    write_status multi_writer::write(std::size_t sequence, stash data) const
+    {
+        if (m_impl->closed.load())
+        {
+            return write_status::closed;
+        }
+
+        m_impl->push(sequence, std::move(data));
+        m_impl->notify();
+
+        return write_status::written;
+    }
+
+    void multi_writer::finish() const
+    {
+        m_impl->total.store(m_impl->next.load());
+        m_impl->finishing.store(true);
+        m_impl->notify();
+    }
+
+    void multi_writer::reject(error err) const
+    {
+        m_impl->failure.store(err);
+        m_impl->rejected.store(true);
+        m_impl->notify();
+    }
+} // namespace saucer::scheme
@@ -0,0 +1,323 @@
+#include "serializers/ondemand/ondemand.hpp"
+
+#include <format>
+#include <utility>
+#include <iterator>
+
+namespace saucer::serializers::ondemand
+{
+    simdjson::error_code document::state::rewind()
+    {
+        if (std::exchange(iterated, true))
+        {
+            if (!error)
+            {
+                root.rewind();
+            }
+
+            return error;
+        }
+
+        error = parser.iterate(std::string_view{json.data(), size}, json.size()).get(root);
+
+        return error;
+    }
+
+    document::document() = default;
+
+    document::document(std::string_view json) : m_state(std::make_shared<state>())
+    {
+        detail::pad(json, m_state->json);
+        m_state->size = json.size();
+    }
+
+    bool document::empty() const
+    {
+        return !m_state || m_state->size == 0;
+    }
+
+    std::string_view document::raw() const
+    {
+        if (!m_state)
+        {
+            return {};
+        }
+
+        return {m_state->json.data(), m_state->size};
+    }
+
+    bool document::contains(std::string_view pointer) const
+    {
+        if (!m_state || m_state->rewind())
+        {
+            return false;
+        }
+
+        return m_state->root.at_pointer(pointer).error() == simdjson::SUCCESS;
+    }
+
+    void detail::pad(std::string_view data, std::string &out)
+    {
+        out.reserve(data.size() + simdjson::SIMDJSON_PADDING);
+        out.assign(data);
+        out.resize(data.size() + simdjson::SIMDJSON_PADDING);
+    }
+
+    std::size_t detail::capacity(std::string_view data, const std::string &storage)
+    {
+        return static_cast<std::size_t>(storage.data() + storage.size() - data.data());
+    }
+
+    simdjson::ondemand::parser &detail::parser()
+    {
+        static thread_local simdjson::ondemand::parser rtn;
+        return rtn;
+    }
+
+    void detail::escape(std::string_view value, std::string &out)
+    {
+        out.reserve(out.size() + value.size() + 2);
+        out += '"';
+
+        for (const auto ch : value)
+        {
+            switch (ch)
+            {
+            case '"':
+                out += R"(\")";
+                continue;
+            case '\\':
+                out += R"(\\)";
+                continue;
+            case '\n':
+                out += R"(\n)";
+                continue;
+            case '\r':
+                out += R"(\r)";
+                continue;
+            case '\t':
+                out += R"(\t)";
+                continue;
+            default:
+                break;
+            }
+
+            if (static_cast<unsigned char>(ch) < 0x20)
+            {
+                std::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<unsigned char>(ch));
+                continue;
+            }
+
+            out += ch;
+        }
+
+        out += '"';
+    }
+
+    std::string_view function_data::raw() const
+    {
+        return params;
+    }
+
+    serializer::~serializer() = default;
+
+    std::string serializer::script() const
+    {
+        return {};
+    }
+
+    std::string serializer::js_serializer() const
+    {
+        return "JSON.stringify";
+    }
+
+    static std::string_view discriminator(std::string_view data)
+    {
+        static constexpr auto whitespace = " \t\r\n";
+
+        const auto start = data.find_first_not_of(whitespace);
+
+        if (start == std::string_view::npos || data[start] != '{')
+        {
+            return {};
+        }
+
+        const auto key = data.find_first_not_of(whitespace, start + 1);
+
+        if (key == std::string_view::npos || data[key] != '"')
+        {
+            return {};
+        }
+
+        const auto end = data.find('"', key + 1);
+
+        if (end == std::string_view::npos)
+        {
+            return {};
+        }
+
+        return data.substr(key + 1, end - key - 1);
+    }
+
+    static bool read_id(simdjson::ondemand::value &value, std::size_t &out)
+    {
+        std::uint64_t id{};
+
+        if (value.get_uint64().get(id) || !std::in_range<std::size_t>(id))
+        {
+            return false;
+        }
+
+        out = static_cast<std::size_t>(id);
+
+        return true;
+    }
+
+    static bool read_name(simdjson::ondemand::value &value, std::variant<std::size_t, std::string> &out)
+    {
+        simdjson::ondemand::json_type type{};
+
+        if (value.type().get(type))
+        {
+            return false;
+        }
+
+        if (type == simdjson::ondemand::json_type::number)
+        {
+            return read_id(value, out.emplace<std::size_t>());
+        }
+
+        std::string_view name{};
+
+        if (value.get_string().get(name))
+        {
+            return false;
+        }
+
+        out.emplace<std::string>(name);
+
+        return true;
+    }
+
+    template <typename T, typename Callback>
+    static std::unique_ptr<T> envelope(std::string_view data, std::string_view payload, std::string_view T::*slice, Callback &&field)
+    {
+        auto rtn = std::make_unique<T>();
+        detail::pad(data, rtn->storage);
+
+        simdjson::ondemand::document root;
+        simdjson::ondemand::object object;
+
+        if (detail::parser().iterate(std::string_view{rtn->storage.data(), data.size()}, rtn->storage.size()).get(root) ||
+            root.get_object().get(object))
+        {
+            return nullptr;
+        }
+
+        auto found      = false;
+        auto identified = false;
+
+        for (auto member : object)
+        {
+            std::string_view key{};
+            simdjson::ondemand::value value;
+
+            if (member.unescaped_key().get(key) || member.value().get(value))
+            {
+                return nullptr;
+            }
+
+            if (key != payload)
+            {
+                identified = identified || key == "id";
+
+                if (!field(*rtn, key, value))
+                {
+                    return nullptr;
+                }
+
+                continue;
+            }
+
+            // Only the slice is remembered, the payload is parsed once the callee knows what it expects
+            std::string_view raw{};
+
+            if (value.raw_json().get(raw))
+            {
+                return nullptr;
+            }
+
+            (*rtn).*slice = raw.substr(0, raw.find_last_not_of(" \t\r\n") + 1);
+            found         = true;
+        }
+
+        // Without an id there is nobody to hand the result to
+        if (!found || !identified)
+        {
+            return nullptr;
+        }
+
+        return rtn;
+    }
+
+    template <typename T, typename Callback>
+    static serializer::parse_result parse_into(std::string_view data, std::string_view payload, std::string_view T::*slice,
+                                               Callback &&field)
+    {
+        auto rtn = envelope<T>(data, payload, slice, std::forward<Callback>(field));
+
+        if (!rtn)
+        {
+            return std::monostate{};
+        }
+
+        return rtn;
+    }
+
+    serializer::parse_result serializer::parse(std::string_view data) const
+    {
+        const auto key = discriminator(data);
+
+        if (key == "saucer:call")
+        {
+            auto field = [](function_data &out, std::string_view key, simdjson::ondemand::value &value)
+            {
+                if (key == "id")
+                {
+                    return read_id(value, out.id);
+                }
+
+                if (key == "name")
+                {
+                    return read_name(value, out.name);
+                }
+
+                return key == "saucer:call";
+            };
+
+            return parse_into(data, "params", &function_data::params, field);
+        }
+
+        if (key == "saucer:resolve")
+        {
+            auto field = [](result_data &out, std::string_view key, simdjson::ondemand::value &value)
+            {
+                if (key == "id")
+                {
+                    return read_id(value, out.id);
+                }
+
+                if (key == "exception")
+                {
+                    return !value.get_bool().get(out.exception);
+                }
+
+                return key == "saucer:resolve";
+            };
+
+            return parse_into(data, "result", &result_data::result, field);
+        }
+
+        return std::monostate{};
+    }
+} // namespace saucer::serializers::ondemand
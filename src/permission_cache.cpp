@@ -0,0 +1,90 @@
+#include "permission_cache.hpp"
+
+#include <format>
+#include <fstream>
+#include <utility>
+
+namespace saucer::utils
+{
+    permission_cache::permission_cache(std::optional<fs::path> store) : m_store(std::move(store))
+    {
+        load();
+    }
+
+    void permission_cache::load()
+    {
+        if (!m_store.has_value())
+        {
+            return;
+        }
+
+        auto file = std::ifstream{*m_store};
+
+        std::string origin;
+        int type{};
+        bool allowed{};
+
+        while (file >> origin >> type >> allowed)
+        {
+            m_decisions.insert_or_assign({origin, static_cast<permission::type>(type)}, allowed);
+        }
+    }
+
+    void permission_cache::save() const
+    {
+        if (!m_store.has_value())
+        {
+            return;
+        }
+
+        std::error_code ec{};
+        fs::create_directories(m_store->parent_path(), ec);
+
+        auto file = std::ofstream{*m_store, std::ios::trunc};
+
+        for (const auto &[key, allowed] : m_decisions)
+        {
+            file << std::format("{} {} {}\n", key.first, std::to_underlying(key.second), static_cast<int>(allowed));
+        }
+    }
+
+    std::optional<bool> permission_cache::find(const saucer::url &url, permission::type type) const
+    {
+        std::lock_guard lock{m_mutex};
+
+        if (auto it = m_decisions.find({origin(url), type}); it != m_decisions.end())
+        {
+            return it->second;
+        }
+
+        return std::nullopt;
+    }
+
+    void permission_cache::store(const saucer::url &url, permission::type type, bool allowed)
+    {
+        std::lock_guard lock{m_mutex};
+
+        m_decisions.insert_or_assign({origin(url), type}, allowed);
+        save();
+    }
+
+    void permission_cache::clear()
+    {
+        std::lock_guard lock{m_mutex};
+
+        m_decisions.clear();
+        save();
+    }
+
+    std::string permission_cache::origin(const saucer::url &url)
+    {
+        auto rtn = std::format("{}://{}", url.scheme(), url.host().value_or(""));
+
+        if (auto port = url.port(); port.has_value())
+        {
+            std::format_to(std::back_inserter(rtn), ":{}", *port);
+        }
+
+        return rtn;
+    }
+} // namespace saucer::utils
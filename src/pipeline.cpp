@@ -0,0 +1,191 @@
+#include <saucer/pipeline.hpp>
+
+#include "threads.hpp"
+
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <optional>
+#include <algorithm>
+#include <condition_variable>
+
+namespace saucer::scheme
+{
+    struct pipeline::impl
+    {
+        stream_writer writer;
+        std::size_t depth;
+
+      public:
+        std::mutex mutex;
+        std::condition_variable readable;
+        std::condition_variable writable;
+
+      public:
+        std::deque<stash> chunks;
+        std::optional<error> failure;
+
+      public:
+        bool closed{false};
+        bool finished{false};
+
+      public:
+        std::thread drainer;
+
+      public:
+        ~impl();
+
+      public:
+        void drain();
+        void close(std::optional<error>);
+    };
+
+    pipeline::impl::~impl()
+    {
+        close(std::nullopt);
+
+        if (!drainer.joinable())
+        {
+            return;
+        }
+
+        drainer.join();
+    }
+
+    void pipeline::impl::drain()
+    {
+        utils::apply(utils::thread_role::helper);
+
+        while (true)
+        {
+            std::unique_lock lock{mutex};
+            readable.wait(lock, [this] { return !chunks.empty() || finished; });
+
+            if (chunks.empty())
+            {
+                break;
+            }
+
+            auto chunk = std::move(chunks.front());
+            chunks.pop_front();
+
+            lock.unlock();
+            writable.notify_one();
+
+            const auto status = writer.write(std::move(chunk));
+
+            if (status == write_status::saturated)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+
+            if (status != write_status::closed)
+            {
+                continue;
+            }
+
+            lock.lock();
+
+            closed = true;
+            chunks.clear();
+
+            lock.unlock();
+            writable.notify_all();
+
+            return;
+        }
+
+        if (failure.has_value())
+        {
+            return writer.reject(failure.value());
+        }
+
+        writer.finish();
+    }
+
+    void pipeline::impl::close(std::optional<error> err)
+    {
+        {
+            std::lock_guard lock{mutex};
+
+            if (finished)
+            {
+                return;
+            }
+
+            if (err.has_value())
+            {
+                chunks.clear();
+            }
+
+            failure  = err;
+            finished = true;
+        }
+
+        readable.notify_all();
+        writable.notify_all();
+    }
+
+    pipeline::pipeline(stream_writer writer, const stream_response &response, std::size_t depth)
+        : m_impl(std::make_unique<impl>(std::move(writer), std::max(depth, 1uz)))
+    {
+        m_impl->writer.start(response);
+        m_impl->drainer = std::thread{&impl::drain, m_impl.get()};
+    }
+
+    pipeline::pipeline(pipeline &&) noexcept = default;
+
+    pipeline::~pipeline() = default;
+
+    bool pipeline::push(stash data)
+    {
+        {
+            std::unique_lock lock{m_impl->mutex};
+            m_impl->writable.wait(lock, [this] { return m_impl->closed || m_impl->finished || m_impl->chunks.size() < m_impl->depth; });
+
+            if (m_impl->closed || m_impl->finished)
+            {
+                return false;
+            }
+
+            m_impl->chunks.emplace_back(std::move(data));
+        }
+
+        m_impl->readable.notify_one();
+
+        return true;
+    }
+
+    write_status pipeline::try_push(stash data)
+    {
+        {
+            std::lock_guard lock{m_impl->mutex};
+
+            if (m_impl->closed || m_impl->finished)
+            {
+                return write_status::closed;
+            }
+
+            if (m_impl->chunks.size() >= m_impl->depth)
+            {
+                return write_status::saturated;
+            }
+
+            m_impl->chunks.emplace_back(std::move(data));
+        }
+
+        m_impl->readable.notify_one();
+
+        return write_status::written;
+    }
+
+    void pipeline::finish()
+    {
+        m_impl->close(std::nullopt);
+    }
+
+    void pipeline::reject(error err)
+    {
+        m_impl->close(err);
+    }
+} // namespace saucer::scheme
@@ -0,0 +1,136 @@
+#include "pool.hpp"
+#include "threads.hpp"
+
+#include <atomic>
+#include <algorithm>
+
+namespace saucer::utils
+{
+    namespace
+    {
+        struct current
+        {
+            const pool *owner{nullptr};
+            std::size_t index{0};
+        };
+
+        thread_local current worker{};
+        std::atomic_size_t round_robin{0};
+    } // namespace
+
+    pool::pool(std::size_t threads)
+    {
+        threads = std::max(threads, 1uz);
+
+        m_queues.reserve(threads);
+        m_workers.reserve(threads);
+
+        for (std::size_t i = 0; i < threads; ++i)
+        {
+            m_queues.emplace_back(std::make_unique<queue>());
+        }
+
+        for (std::size_t i = 0; i < threads; ++i)
+        {
+            m_workers.emplace_back(&pool::work, this, i);
+        }
+    }
+
+    pool::~pool()
+    {
+        {
+            std::lock_guard guard{m_mutex};
+            m_stop = true;
+        }
+
+        m_condition.notify_all();
+
+        for (auto &worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    void pool::work(std::size_t index)
+    {
+        worker = {.owner = this, .index = index};
+        apply(thread_role::worker);
+
+        while (true)
+        {
+            if (auto current = take(index); current.has_value())
+            {
+                {
+                    std::lock_guard guard{m_mutex};
+                    --m_pending;
+                }
+
+                (*current)();
+                continue;
+            }
+
+            std::unique_lock guard{m_mutex};
+            m_condition.wait(guard, [this] { return m_stop || m_pending > 0; });
+
+            // Queued tasks still run on shutdown, dropping them would leave the executors they carry unsettled
+            if (m_stop && m_pending == 0)
+            {
+                return;
+            }
+        }
+    }
+
+    std::optional<pool::task> pool::take(std::size_t index)
+    {
+        const auto count = m_queues.size();
+
+        // Lanes are drained in priority order, our own queue is preferred over those of the other workers
+        for (auto lane = 0uz; lanes > lane; ++lane)
+        {
+            for (auto offset = 0uz; count > offset; ++offset)
+            {
+                auto &current = *m_queues[(index + offset) % count];
+                std::lock_guard guard{current.mutex};
+
+                if (auto &tasks = current.tasks[lane]; !tasks.empty())
+                {
+                    auto rtn = std::move(tasks.front());
+                    tasks.pop_front();
+
+                    return rtn;
+                }
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    void pool::submit(task callback, std::size_t lane)
+    {
+        const auto index = worker.owner == this ? worker.index : round_robin.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+
+        {
+            // The count is held while queueing, a worker that takes the task right away can not decrement it before it was incremented
+            std::lock_guard pending{m_mutex};
+
+            auto &target = *m_queues[index];
+            std::lock_guard guard{target.mutex};
+
+            target.tasks[std::min(lane, lanes - 1)].emplace_back(std::move(callback));
+            ++m_pending;
+        }
+
+        m_condition.notify_one();
+    }
+
+    std::size_t pool::size() const
+    {
+        return m_workers.size();
+    }
+
+    pool &pool::shared()
+    {
+        static auto instance = pool{thread_config(thread_role::worker).count.value_or(std::max(1u, std::thread::hardware_concurrency()))};
+        return instance;
+    }
+} // namespace saucer::utils
@@ -1,5 +1,7 @@
 #include "qt.app.impl.hpp"
 
+#include <algorithm>
+
 namespace saucer
 {
     using impl = application::impl;
@@ -22,6 +24,31 @@ namespace saucer
         platform->application = std::make_unique<QApplication>(native::argc, native::argv.data());
         platform->application->setQuitOnLastWindowClosed(opts.quit_on_last_window_closed);
 
+        auto changed = [this]
+        {
+            screens_changed();
+        };
+
+        auto watch = [changed](QScreen *screen)
+        {
+            screen->connect(screen, &QScreen::geometryChanged, changed);
+            screen->connect(screen, &QScreen::availableGeometryChanged, changed);
+        };
+
+        std::ranges::for_each(QApplication::screens(), watch);
+
+        auto *const app = platform->application.get();
+
+        app->connect(app, &QGuiApplication::screenAdded,
+                     [watch, changed](QScreen *screen)
+                     {
+                         watch(screen);
+                         changed();
+                     });
+
+        app->connect(app, &QGuiApplication::screenRemoved, changed);
+        app->connect(app, &QGuiApplication::primaryScreenChanged, changed);
+
         return {};
     }
 
@@ -42,10 +69,48 @@ namespace saucer
         return rtn;
     }
 
-    void application::post(post_callback_t callback) const
+    void impl::wake(priority priority)
     {
-        auto *const event = new safe_event{std::move(callback)};
-        QApplication::postEvent(m_impl->platform->application.get(), event);
+        auto drain        = utils::defer(lease, [](impl *self) { self->queue.drain(); });
+        auto *const event = new safe_event{std::move(drain)};
+        QApplication::postEvent(platform->application.get(), event, native::convert(priority));
+    }
+
+    void impl::start_timer(std::size_t id, std::chrono::milliseconds interval, timer_precision precision, bool repeat)
+    {
+        auto timer = std::make_unique<QTimer>();
+
+        timer->setInterval(interval);
+        timer->setSingleShot(!repeat);
+        timer->setTimerType(native::convert(precision));
+
+        timer->connect(timer.get(), &QTimer::timeout,
+                       [this, id]
+                       {
+                           if (fire(id))
+                           {
+                               return;
+                           }
+
+                           stop_timer(id);
+                       });
+
+        timer->start();
+        platform->timers.emplace(id, std::move(timer));
+    }
+
+    void impl::stop_timer(std::size_t id) // NOLINT(*-const)
+    {
+        auto node = platform->timers.extract(id);
+
+        if (node.empty())
+        {
+            return;
+        }
+
+        // The timer might be stopped from within its own slot
+        node.mapped()->stop();
+        node.mapped().release()->deleteLater();
     }
 
     int impl::run(application *self, callback_t callback)
@@ -60,6 +125,18 @@ namespace saucer
         return rtn;
     }
 
+    poll_set impl::prepare()
+    {
+        // Qt does not expose the handles of its event dispatcher, so we can only bound the wait
+        return {.timeout = queue.size() > 0 ? std::chrono::milliseconds{0} : poll_interval};
+    }
+
+    bool impl::process(const poll_set &) // NOLINT(*-static)
+    {
+        QApplication::processEvents();
+        return true;
+    }
+
     void impl::quit() // NOLINT(*-static)
     {
         QApplication::quit();
@@ -20,6 +20,40 @@ namespace saucer
         };
     }
 
+    int native::convert(priority priority)
+    {
+        using enum saucer::priority;
+
+        switch (priority)
+        {
+        case interactive:
+            return Qt::HighEventPriority;
+        case normal:
+            return Qt::NormalEventPriority;
+        case background:
+            return Qt::LowEventPriority;
+        }
+
+        std::unreachable();
+    }
+
+    Qt::TimerType native::convert(timer_precision precision)
+    {
+        using enum timer_precision;
+
+        switch (precision)
+        {
+        case precise:
+            return Qt::PreciseTimer;
+        case coarse:
+            return Qt::CoarseTimer;
+        case very_coarse:
+            return Qt::VeryCoarseTimer;
+        }
+
+        std::unreachable();
+    }
+
     safe_event::safe_event(callback_t callback) : QEvent(QEvent::User), m_callback(std::move(callback)) {}
 
     safe_event::~safe_event()
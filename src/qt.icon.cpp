@@ -48,12 +48,17 @@ namespace saucer
             return stash::empty();
         }
 
-        QByteArray bytes;
+        auto encode = [&pixmap]
+        {
+            QByteArray bytes;
+
+            QBuffer buffer{&bytes};
+            pixmap->save(&buffer, "PNG");
 
-        QBuffer buffer{&bytes};
-        pixmap->save(&buffer, "PNG");
+            return std::vector<std::uint8_t>{bytes.begin(), bytes.end()};
+        };
 
-        return stash::from({bytes.begin(), bytes.end()});
+        return m_impl->png.get(encode);
     }
 
     void icon::save(const fs::path &path) const
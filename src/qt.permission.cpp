@@ -13,6 +13,7 @@ namespace saucer::permission
 
     request::~request()
     {
+        m_impl->decided = nullptr;
         accept(false);
     }
 
@@ -62,5 +63,10 @@ namespace saucer::permission
         auto request = std::move(m_impl->request);
 
         (request.*(value ? &QWebEnginePermission::grant : &QWebEnginePermission::deny))();
+
+        if (auto decided = std::exchange(m_impl->decided, nullptr); decided)
+        {
+            decided(value);
+        }
     }
 } // namespace saucer::permission
@@ -1,25 +1,40 @@
 #include "qt.scheme.impl.hpp"
 
 #include "qt.url.impl.hpp"
+#include "scheme.utils.hpp"
 
 #include <ranges>
 #include <chrono>
 #include <deque>
 #include <mutex>
+#include <optional>
+#include <algorithm>
+#include <functional>
 #include <condition_variable>
 
 #include <QMap>
-#include <QBuffer>
 #include <QIODevice>
 
 namespace saucer::scheme
 {
     class stream_device : public QIODevice
     {
+        static constexpr auto default_timeout = std::chrono::seconds(5);
+
+      private:
         mutable std::mutex m_mutex;
-        std::condition_variable m_cv;
-        std::deque<std::uint8_t> m_buffer;
+        std::condition_variable m_readable;
+        std::condition_variable m_writable;
+
+      private:
+        std::deque<stash> m_chunks;
+        std::size_t m_offset{0};
+        std::size_t m_size{0};
+
+      private:
         bool m_finished{false};
+        std::optional<std::size_t> m_capacity;
+        std::chrono::milliseconds m_timeout{default_timeout};
 
       public:
         stream_device(QObject *parent = nullptr) : QIODevice(parent)
@@ -27,14 +42,40 @@ namespace saucer::scheme
             open(QIODevice::ReadOnly);
         }
 
-        void push(const std::uint8_t *data, std::size_t size)
+      public:
+        void configure(const stream_response &response)
         {
             {
                 std::lock_guard lock{m_mutex};
-                m_buffer.insert(m_buffer.end(), data, data + size);
+                m_capacity = response.capacity;
+                m_timeout  = response.timeout.value_or(default_timeout);
             }
-            m_cv.notify_one();
+            m_writable.notify_all();
+        }
+
+        bool push(stash data)
+        {
+            if (data.size() == 0)
+            {
+                return true;
+            }
+
+            {
+                std::unique_lock lock{m_mutex};
+                m_writable.wait(lock, [this] { return m_finished || !m_capacity.has_value() || m_size < *m_capacity; });
+
+                if (m_finished)
+                {
+                    return false;
+                }
+
+                m_size += data.size();
+                m_chunks.emplace_back(std::move(data));
+            }
+            m_readable.notify_one();
             QMetaObject::invokeMethod(this, &QIODevice::readyRead, Qt::QueuedConnection);
+
+            return true;
         }
 
         void close_write()
@@ -43,36 +84,94 @@ namespace saucer::scheme
                 std::lock_guard lock{m_mutex};
                 m_finished = true;
             }
-            m_cv.notify_one();
+            m_readable.notify_all();
+            m_writable.notify_all();
             QMetaObject::invokeMethod(this, &QIODevice::readyRead, Qt::QueuedConnection);
         }
 
+      public:
         bool isSequential() const override { return true; }
         qint64 bytesAvailable() const override
         {
             std::lock_guard lock{m_mutex};
-            return static_cast<qint64>(m_buffer.size()) + QIODevice::bytesAvailable();
+            return static_cast<qint64>(m_size) + QIODevice::bytesAvailable();
         }
 
       protected:
         qint64 readData(char *data, qint64 max) override
         {
             std::unique_lock lock{m_mutex};
-            if (!m_cv.wait_for(lock, std::chrono::seconds(5), [this] { return !m_buffer.empty() || m_finished; }))
+
+            if (!m_readable.wait_for(lock, m_timeout, [this] { return !m_chunks.empty() || m_finished; }))
             {
                 return 0;
             }
 
-            if (m_buffer.empty())
+            if (m_chunks.empty())
             {
                 return m_finished ? -1 : 0;
             }
 
-            auto to_read = std::min(static_cast<std::size_t>(max), m_buffer.size());
-            std::copy_n(m_buffer.begin(), to_read, data);
-            m_buffer.erase(m_buffer.begin(), m_buffer.begin() + static_cast<std::ptrdiff_t>(to_read));
+            const auto limit = static_cast<std::size_t>(max);
+            std::size_t read{0};
+
+            while (read < limit && !m_chunks.empty())
+            {
+                const auto &front = m_chunks.front();
+                const auto count  = std::min(limit - read, front.size() - m_offset);
+
+                std::copy_n(front.data() + m_offset, count, reinterpret_cast<std::uint8_t *>(data) + read);
+
+                read += count;
+                m_offset += count;
+
+                if (m_offset < front.size())
+                {
+                    continue;
+                }
+
+                m_chunks.pop_front();
+                m_offset = 0;
+            }
+
+            m_size -= read;
+            lock.unlock();
+
+            m_writable.notify_one();
+
+            return static_cast<qint64>(read);
+        }
+
+        qint64 writeData(const char *, qint64) override { return -1; }
+    };
+
+    class stash_device : public QIODevice
+    {
+        stash m_data;
+
+      public:
+        stash_device(stash data, QObject *parent = nullptr) : QIODevice(parent), m_data(std::move(data))
+        {
+            open(QIODevice::ReadOnly);
+        }
+
+      public:
+        qint64 size() const override { return static_cast<qint64>(m_data.size()); }
+
+      protected:
+        qint64 readData(char *data, qint64 max) override
+        {
+            const auto offset = static_cast<std::size_t>(pos());
+
+            if (offset >= m_data.size())
+            {
+                return 0;
+            }
+
+            const auto count = std::min(static_cast<std::size_t>(max), m_data.size() - offset);
+            std::copy_n(m_data.data() + offset, count, reinterpret_cast<std::uint8_t *>(data));
 
-            return static_cast<qint64>(to_read);
+            return static_cast<qint64>(count);
         }
 
         qint64 writeData(const char *, qint64) override { return -1; }
@@ -99,24 +198,34 @@ namespace saucer::scheme
 
         auto to_array = [](auto &item)
         {
-            return std::make_pair(QByteArray::fromStdString(item.first), QByteArray::fromStdString(item.second));
+            return std::make_pair(QByteArray{item.name.c_str(), static_cast<qsizetype>(item.name.size())},
+                                  QByteArray{item.value.c_str(), static_cast<qsizetype>(item.value.size())});
         };
 
         const auto headers   = std::views::transform(response.headers, to_array);
         const auto converted = QMultiMap<QByteArray, QByteArray>{{headers.begin(), headers.end()}};
 
+        m_impl->device->configure(response);
+
         req.value()->setAdditionalResponseHeaders(converted);
         req.value()->reply(QString::fromStdString(response.mime).toUtf8(), m_impl->device);
     }
 
-    void stream_writer::write(stash data)
+    write_status stream_writer::write(stash data)
     {
         if (!m_impl || !m_impl->started || m_impl->finished)
         {
-            return;
+            return write_status::closed;
         }
 
-        m_impl->device->push(data.data(), data.size());
+        utils::metrics::get().scheme_bytes.fetch_add(data.size(), std::memory_order_relaxed);
+
+        return m_impl->device->push(std::move(data).owned()) ? write_status::written : write_status::closed;
+    }
+
+    write_status stream_writer::write_file(int fd, std::size_t offset, std::size_t length)
+    {
+        return utils::write_file(*this, fd, offset, length);
     }
 
     void stream_writer::finish()
@@ -176,24 +285,53 @@ namespace saucer::scheme
         auto req = m_impl->request->write();
         return req.value() && !m_impl->finished;
     }
-    request::request(impl data) : m_impl(std::make_unique<impl>(std::move(data))) {}
-
-    request::request(const request &other) : request(*other.m_impl) {}
+    request::request(impl data) : m_impl(std::make_shared<impl>(std::move(data))) {}
 
     request::request(request &&) noexcept = default;
 
     request::~request() = default;
 
+    // Replies can not carry a status, QtWebEngine answers range requests itself by seeking the reply device
+    static bool unsupported(const QByteArray &name)
+    {
+        return name.compare("range", Qt::CaseInsensitive) == 0 || name.compare("if-none-match", Qt::CaseInsensitive) == 0;
+    }
+
+    request::impl request::impl::from(QWebEngineUrlRequestJob *request)
+    {
+        auto rtn = impl{
+            .url    = request->requestUrl(),
+            .method = request->requestMethod().toStdString(),
+        };
+
+        for (const auto &[name, value] : request->requestHeaders().asKeyValueRange())
+        {
+            if (unsupported(name))
+            {
+                continue;
+            }
+
+            rtn.headers.emplace(name.toStdString(), value.toStdString());
+        }
+
+        auto *const body = request->requestBody();
+
+        if (body && body->open(QIODevice::OpenModeFlag::ReadOnly))
+        {
+            rtn.body = body->readAll();
+        }
+
+        return rtn;
+    }
+
     url request::url() const
     {
-        const auto request = m_impl->request->write();
-        return url::impl{request.value()->requestUrl()};
+        return url::impl{m_impl->url};
     }
 
     std::string request::method() const
     {
-        const auto request = m_impl->request->write();
-        return request.value()->requestMethod().toStdString();
+        return m_impl->method;
     }
 
     stash request::content() const
@@ -202,19 +340,39 @@ namespace saucer::scheme
         return stash::view({data, data + m_impl->body.size()});
     }
 
-    std::map<std::string, std::string> request::headers() const
+    std::size_t request::read(std::span<std::uint8_t> buffer) const
+    {
+        const auto remaining = static_cast<std::size_t>(m_impl->body.size()) - m_impl->offset;
+        const auto count     = std::min(remaining, buffer.size());
+
+        std::ranges::copy_n(m_impl->body.data() + m_impl->offset, static_cast<std::ptrdiff_t>(count), buffer.begin());
+        m_impl->offset += count;
+
+        return count;
+    }
+
+    std::optional<std::string> request::header(std::string_view name) const
     {
-        const auto request = m_impl->request->write();
-        const auto headers = request.value()->requestHeaders();
+        const auto key = QByteArray::fromRawData(name.data(), static_cast<qsizetype>(name.size()));
 
-        auto transform = [&headers](auto &item)
+        auto matches = [&key](const auto &item)
         {
-            return std::make_pair(item.toStdString(), headers[item].toStdString());
+            return QByteArray::fromStdString(item.first).compare(key, Qt::CaseInsensitive) == 0;
         };
 
-        return headers                            //
-               | std::views::transform(transform) //
-               | std::ranges::to<std::map<std::string, std::string>>();
+        const auto it = std::ranges::find_if(m_impl->headers, matches);
+
+        if (it == m_impl->headers.end())
+        {
+            return std::nullopt;
+        }
+
+        return it->second;
+    }
+
+    const std::map<std::string, std::string> &request::headers() const
+    {
+        return m_impl->headers;
     }
 
     handler::handler(scheme::resolver resolver) : resolver(std::move(resolver)) {}
@@ -229,16 +387,8 @@ namespace saucer::scheme
         }
 
         auto request = std::make_shared<lockpp::lock<QWebEngineUrlRequestJob *>>(raw);
-        auto content = QByteArray{};
-
-        auto *const body = raw->requestBody();
-
-        if (body && body->open(QIODevice::OpenModeFlag::ReadOnly))
-        {
-            content = body->readAll();
-        }
 
-        auto resolve = [request](const scheme::response &response)
+        auto resolve = [request](scheme::response response)
         {
             const auto req = request->write();
 
@@ -249,7 +399,8 @@ namespace saucer::scheme
 
             auto to_array = [](auto &item)
             {
-                return std::make_pair(QByteArray::fromStdString(item.first), QByteArray::fromStdString(item.second));
+                return std::make_pair(QByteArray{item.name.c_str(), static_cast<qsizetype>(item.name.size())},
+                                      QByteArray{item.value.c_str(), static_cast<qsizetype>(item.value.size())});
             };
 
             const auto headers   = std::views::transform(response.headers, to_array);
@@ -257,12 +408,7 @@ namespace saucer::scheme
 
             req.value()->setAdditionalResponseHeaders(converted);
 
-            const auto data = response.data;
-            auto *buffer    = new QBuffer{};
-
-            buffer->open(QIODevice::WriteOnly);
-            buffer->write(reinterpret_cast<const char *>(data.data()), static_cast<std::int64_t>(data.size()));
-            buffer->close();
+            auto *const buffer = new stash_device{std::move(response.data)};
 
             connect(req.value(), &QObject::destroyed, buffer, &QObject::deleteLater);
             req.value()->reply(QString::fromStdString(response.mime).toUtf8(), buffer);
@@ -302,7 +448,7 @@ namespace saucer::scheme
         };
 
         auto executor = scheme::executor{std::move(resolve), std::move(reject)};
-        auto req      = scheme::request{{.request = request, .body = std::move(content)}};
+        auto req      = scheme::request{scheme::request::impl::from(raw)};
 
         connect(raw, &QObject::destroyed, [request]() { request->assign(nullptr); });
 
@@ -321,14 +467,6 @@ namespace saucer::scheme
         }
 
         auto request = std::make_shared<lockpp::lock<QWebEngineUrlRequestJob *>>(raw);
-        auto content = QByteArray{};
-
-        auto *const body = raw->requestBody();
-
-        if (body && body->open(QIODevice::OpenModeFlag::ReadOnly))
-        {
-            content = body->readAll();
-        }
 
         auto *device      = new stream_device{raw};
         auto writer_impl  = std::make_shared<stream_writer::impl>();
@@ -336,7 +474,7 @@ namespace saucer::scheme
         writer_impl->device  = device;
 
         auto writer = stream_writer{writer_impl};
-        auto req    = scheme::request{{.request = request, .body = std::move(content)}};
+        auto req    = scheme::request{scheme::request::impl::from(raw)};
 
         connect(raw, &QObject::destroyed, [request, device]()
         {
@@ -0,0 +1,27 @@
+#include "qt.utils.hpp"
+
+#include <QStringEncoder>
+
+namespace saucer
+{
+    QString utils::widen(std::string_view value)
+    {
+        return QString::fromUtf8(value.data(), static_cast<qsizetype>(value.size()));
+    }
+
+    std::string utils::narrow(QStringView value)
+    {
+        // Encodes straight into the result, `QString::toStdString` would go through an intermediate `QByteArray` first
+        auto encoder = QStringEncoder{QStringEncoder::Utf8};
+
+        auto convert = [&encoder, value](char *data, std::size_t)
+        {
+            return static_cast<std::size_t>(encoder.appendToBuffer(data, value) - data);
+        };
+
+        std::string rtn;
+        rtn.resize_and_overwrite(static_cast<std::size_t>(encoder.requiredSpace(value.size())), convert);
+
+        return rtn;
+    }
+} // namespace saucer
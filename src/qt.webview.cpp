@@ -8,15 +8,22 @@
 #include "qt.url.impl.hpp"
 #include "qt.icon.impl.hpp"
 #include "qt.window.impl.hpp"
+#include "shared_buffer.impl.hpp"
 
 #include <ranges>
+#include <limits>
+#include <algorithm>
 
 #include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
 #include <QWebEngineScriptCollection>
 
+#include <QNetworkCookie>
 #include <QWebEngineProfile>
 #include <QWebEngineSettings>
 #include <QWebEngineUrlScheme>
+#include <QWebEngineCookieStore>
 #include <QWebEngineFullScreenRequest>
 
 namespace saucer
@@ -34,7 +41,7 @@ namespace saucer
             return err(std::errc::no_such_file_or_directory);
         }
 
-        auto flags = opts.browser_flags;
+        auto flags = impl::chromium_flags(opts);
 
         if (opts.hardware_acceleration)
         {
@@ -71,12 +78,31 @@ namespace saucer
         {
             profile->setPersistentCookiesPolicy(opts.persistent_cookies ? ForcePersistentCookies : NoPersistentCookies);
         }
+        if (opts.cache_model.has_value())
+        {
+            profile->setHttpCacheType(native::convert(*opts.cache_model));
+        }
+
+        const auto cache_size = static_cast<int>(std::min<std::size_t>(opts.cache_size.value_or(0), std::numeric_limits<int>::max()));
+        profile->setHttpCacheMaximumSize(cache_size);
+
         profile->settings()->setAttribute(QWebEngineSettings::LocalContentCanAccessRemoteUrls, true);
         profile->settings()->setAttribute(QWebEngineSettings::FullScreenSupportEnabled, true);
 
+        if (opts.spellcheck.has_value())
+        {
+            profile->setSpellCheckEnabled(*opts.spellcheck);
+        }
+
+        if (opts.smooth_scrolling.has_value())
+        {
+            profile->settings()->setAttribute(QWebEngineSettings::ScrollAnimatorEnabled, *opts.smooth_scrolling);
+        }
+
         platform = std::make_unique<native>();
 
         platform->profile     = std::move(profile);
+        platform->cache_size  = cache_size;
         platform->web_view    = utils::make_deferred<QWebEngineView>();
         platform->web_page    = std::make_unique<QWebEnginePage>();
         platform->channel     = std::make_unique<QWebChannel>();
@@ -126,6 +152,20 @@ namespace saucer
                                             return request.accept();
                                         });
 
+        platform->on_terminated =
+            platform->web_page->connect(platform->web_page.get(), &QWebEnginePage::renderProcessTerminated,
+                                        [this](QWebEnginePage::RenderProcessTerminationStatus status, int)
+                                        {
+                                            using enum QWebEnginePage::RenderProcessTerminationStatus;
+
+                                            if (status == NormalTerminationStatus)
+                                            {
+                                                return;
+                                            }
+
+                                            process_gone(status == KilledTerminationStatus ? termination::killed : termination::crashed);
+                                        });
+
         platform->on_closed = window->on<window::event::closed>({{.func = [this] { set_dev_tools(false); }, .clearable = false}});
 
         window->native<false>()->platform->add_widget(platform->web_view.get());
@@ -148,6 +188,7 @@ namespace saucer
 
         platform->web_view->disconnect(platform->on_load);
         platform->web_page->disconnect(platform->on_fullscreen);
+        platform->web_page->disconnect(platform->on_terminated);
 
         window->native<false>()->platform->remove_widget(platform->web_view.get());
     }
@@ -219,9 +260,38 @@ namespace saucer
         platform->web_view->setUrl(url.native<false>()->url);
     }
 
+    void impl::serve_directory(const fs::path &root, const std::string &)
+    {
+        auto index = url::from(root / "index.html");
+
+        if (!index.has_value())
+        {
+            return;
+        }
+
+        set_url(index.value());
+    }
+
     void impl::set_html(cstring_view html) // NOLINT(*-function-const)
     {
-        platform->web_view->setHtml(QString::fromUtf8(html));
+        platform->web_view->setHtml(utils::widen(html));
+    }
+
+    void impl::set_content_rules(std::vector<std::string> block) // NOLINT(*-function-const)
+    {
+        platform->content_rules.clear();
+
+        for (const auto &wildcard : block)
+        {
+            platform->content_rules.emplace_back(QString::fromStdString(impl::content_pattern(wildcard)));
+        }
+
+        if (platform->content_rules.empty())
+        {
+            return;
+        }
+
+        platform->intercept(this);
     }
 
     void impl::set_dev_tools(bool enabled) // NOLINT(*-function-const)
@@ -272,12 +342,103 @@ namespace saucer
     {
         window->native<false>()->platform->unmanaged.erase(platform->web_view.get());
         platform->web_view->layout()->invalidate();
+
+        place_surfaces();
     }
 
     void impl::set_bounds(saucer::bounds bounds) // NOLINT(*-function-const)
     {
         window->native<false>()->platform->unmanaged.emplace(platform->web_view.get());
         platform->web_view->setGeometry({bounds.x, bounds.y, bounds.w, bounds.h});
+
+        place_surfaces();
+    }
+
+    void impl::add_surface(void *handle, layer position) // NOLINT(*-function-const)
+    {
+        auto *const widget = static_cast<QWidget *>(handle);
+        auto *const parent = window->native<false>()->platform.get();
+
+        // Surfaces are laid out by us, the overlay layout must not stretch them over the window
+        parent->unmanaged.emplace(widget);
+        parent->add_widget(widget);
+
+        widget->hide();
+
+        if (position == layer::below)
+        {
+            widget->stackUnder(platform->web_view.get());
+        }
+        else
+        {
+            widget->raise();
+        }
+    }
+
+    void impl::remove_surface(void *handle) // NOLINT(*-function-const)
+    {
+        auto *const widget = static_cast<QWidget *>(handle);
+        auto *const parent = window->native<false>()->platform.get();
+
+        widget->hide();
+
+        parent->remove_widget(widget);
+        parent->unmanaged.erase(widget);
+    }
+
+    void impl::move_surface(void *handle, std::optional<saucer::bounds> bounds) // NOLINT(*-function-const)
+    {
+        auto *const widget = static_cast<QWidget *>(handle);
+
+        if (!bounds.has_value())
+        {
+            widget->hide();
+            return;
+        }
+
+        const auto origin = platform->web_view->geometry().topLeft();
+
+        widget->setGeometry({origin.x() + bounds->x, origin.y() + bounds->y, bounds->w, bounds->h});
+        widget->show();
+    }
+
+    void impl::suspend(bool value)
+    {
+        auto *const page = platform->web_view->page();
+
+        if (value)
+        {
+            page->setVisible(false);
+            page->setLifecycleState(QWebEnginePage::LifecycleState::Frozen);
+            return;
+        }
+
+        page->setLifecycleState(QWebEnginePage::LifecycleState::Active);
+        page->setVisible(true);
+
+        if (!platform->dom_loaded)
+        {
+            return;
+        }
+
+        for (const auto &script : std::exchange(platform->pending, {}))
+        {
+            execute(script);
+        }
+    }
+
+    void impl::set_memory_target(memory_target target) // NOLINT(*-function-const)
+    {
+        static constexpr auto low_cache = 4 * 1024 * 1024;
+
+        if (target != memory_target::low)
+        {
+            platform->profile->setHttpCacheMaximumSize(platform->cache_size);
+            return;
+        }
+
+        platform->profile->setHttpCacheMaximumSize(low_cache);
+        platform->profile->clearHttpCache();
     }
 
     void impl::back() // NOLINT(*-function-const)
@@ -297,22 +458,134 @@ namespace saucer
 
     void impl::execute(cstring_view code) // NOLINT(*-function-const)
     {
-        if (!platform->dom_loaded)
+        if (!platform->dom_loaded || suspended)
         {
             platform->pending.emplace_back(code);
             return;
         }
 
-        platform->web_view->page()->runJavaScript(QString::fromUtf8(code));
+        platform->web_view->page()->runJavaScript(utils::widen(code));
+    }
+
+    void impl::evaluate_raw(cstring_view code, coco::promise<result<std::string>> promise) // NOLINT(*-function-const)
+    {
+        auto shared = std::make_shared<coco::promise<result<std::string>>>(std::move(promise));
+
+        auto completed = [shared](const QVariant &value)
+        {
+            // QJsonDocument only serializes objects and arrays, so scalars are wrapped in an array which is stripped afterward
+            const auto json = QJsonDocument{QJsonArray{QJsonValue::fromVariant(value)}}.toJson(QJsonDocument::Compact);
+            shared->set_value(std::string{json.constData() + 1, static_cast<std::size_t>(json.size() - 2)});
+        };
+
+        platform->web_view->page()->runJavaScript(utils::widen(code), completed);
+    }
+
+    void impl::capture(std::optional<saucer::size> bounds, coco::promise<result<icon>> promise) // NOLINT(*-function-const)
+    {
+        auto pixmap = platform->web_view->grab();
+
+        if (pixmap.isNull())
+        {
+            promise.set_value(err(std::errc::resource_unavailable_try_again));
+            return;
+        }
+
+        if (bounds.has_value())
+        {
+            pixmap = pixmap.scaled(bounds->w, bounds->h, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        }
+
+        promise.set_value(icon{icon::impl{QIcon{pixmap}}});
+    }
+
+    void impl::memory_stats(coco::promise<memory_usage> promise) // NOLINT(*-function-const)
+    {
+        auto *const page = platform->web_view->page();
+
+        auto shared = std::make_shared<coco::promise<memory_usage>>(std::move(promise));
+        auto usage  = memory_usage{.engine = native::resident(page->renderProcessPid())};
+
+        auto completed = [shared, usage](const QVariant &value) mutable
+        {
+            if (value.canConvert<double>() && !value.isNull())
+            {
+                usage.heap = static_cast<std::size_t>(value.toDouble());
+            }
+
+            shared->set_value(usage);
+        };
+
+        page->runJavaScript(utils::widen(scripts::heap_script), completed);
+    }
+
+    void impl::devtools_protocol(const std::string &, const std::string &,
+                                 coco::promise<result<std::string>> promise) // NOLINT(*-function-const)
+    {
+        // Qt only serves the protocol through its remote debugging port, which is configured by environment at startup
+        promise.set_value(err(std::errc::operation_not_supported));
+    }
+
+    void impl::set_cookies(std::vector<cookie> cookies, coco::promise<result<>> promise) // NOLINT(*-function-const)
+    {
+        auto *const store = platform->web_view->page()->profile()->cookieStore();
+
+        // The store hands the cookies to the network service, which writes them in the background
+        for (const auto &cookie : cookies)
+        {
+            auto native = QNetworkCookie{QByteArray::fromStdString(cookie.name), QByteArray::fromStdString(cookie.value)};
+
+            native.setDomain(QString::fromStdString(cookie.domain));
+            native.setPath(QString::fromStdString(cookie.path));
+            native.setSecure(cookie.secure);
+            native.setHttpOnly(cookie.http_only);
+
+            if (cookie.expires.has_value())
+            {
+                const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(cookie.expires->time_since_epoch());
+                native.setExpirationDate(QDateTime::fromSecsSinceEpoch(seconds.count()));
+            }
+
+            store->setCookie(native);
+        }
+
+        promise.set_value({});
+    }
+
+    void impl::clear_data(const site_data &data, coco::promise<result<>> promise) // NOLINT(*-function-const)
+    {
+        // Qt neither exposes the DOM storage of a profile nor lets cookies be looked up by origin
+        if (data.storage || data.origin.has_value())
+        {
+            promise.set_value(err(std::errc::operation_not_supported));
+            return;
+        }
+
+        auto *const profile = platform->web_view->page()->profile();
+
+        if (data.cookies)
+        {
+            profile->cookieStore()->deleteAllCookies();
+        }
+
+        if (!data.cache)
+        {
+            promise.set_value({});
+            return;
+        }
+
+        auto shared = std::make_shared<coco::promise<result<>>>(std::move(promise));
+
+        QObject::connect(
+            profile, &QWebEngineProfile::clearHttpCacheCompleted, profile, [shared] { shared->set_value({}); }, Qt::SingleShotConnection);
+
+        profile->clearHttpCache();
     }
 
     std::size_t impl::inject(const script &script) // NOLINT(*-function-const)
     {
         using enum script::time;
 
-        auto original = platform->find(script.run_at == creation ? native::creation_script : native::ready_script);
-        auto source   = original.sourceCode().toStdString();
-
         auto uuid       = QUuid::createUuid();
         auto identifier = std::format(native::script_identifier, uuid.toString().toStdString());
 
@@ -329,6 +602,35 @@ namespace saucer
                                code);
         }
 
+        const auto id = platform->id_counter++;
+
+        auto entry = qt_script{.id = identifier, .run_at = script.run_at, .clearable = script.clearable, .standalone = false};
+
+        // Scripts bound to a named world can't share the main-world containers, so they are registered on their own
+        if (script.world.has_value())
+        {
+            const auto point = script.run_at == creation ? QWebEngineScript::DocumentCreation : QWebEngineScript::DocumentReady;
+
+            QWebEngineScript standalone;
+            {
+                standalone.setRunsOnSubFrames(!script.no_frames);
+                standalone.setWorldId(native::world(*script.world));
+
+                standalone.setName(QString::fromStdString(identifier));
+                standalone.setSourceCode(QString::fromStdString(code));
+                standalone.setInjectionPoint(point);
+            }
+            platform->web_page->scripts().insert(standalone);
+
+            entry.standalone = true;
+            platform->scripts.emplace(id, std::move(entry));
+
+            return id;
+        }
+
+        auto original = platform->find(script.run_at == creation ? native::creation_script : native::ready_script);
+        auto source   = original.sourceCode().toStdString();
+
         auto replacement = original;
         auto new_source  = std::format("{0}\n{1}\n{2}\n{1}", source, identifier, code, identifier);
 
@@ -337,8 +639,7 @@ namespace saucer
         platform->web_page->scripts().remove(original);
         platform->web_page->scripts().insert(replacement);
 
-        const auto id = platform->id_counter++;
-        platform->scripts.emplace(id, qt_script{.id = identifier, .run_at = script.run_at, .clearable = script.clearable});
+        platform->scripts.emplace(id, std::move(entry));
 
         return id;
     }
@@ -366,6 +667,13 @@ namespace saucer
 
         const auto &script = platform->scripts[id];
 
+        if (script.standalone)
+        {
+            platform->web_page->scripts().remove(platform->find(script.id.c_str()));
+            platform->scripts.erase(id);
+            return;
+        }
+
         auto original = platform->find(script.run_at == creation ? native::creation_script : native::ready_script);
         auto source   = original.sourceCode().toStdString();
 
@@ -386,23 +694,27 @@ namespace saucer
 
     void impl::handle_scheme(const std::string &name, scheme::resolver &&resolver) // NOLINT(*-function-const)
     {
-        if (platform->schemes.contains(name))
+        auto [it, inserted] = platform->schemes.try_emplace(name, std::move(resolver));
+
+        if (!inserted)
         {
             return;
         }
 
-        auto &scheme = platform->schemes.emplace(name, std::move(resolver)).first->second;
+        auto &scheme = it->second;
         platform->web_view->page()->profile()->installUrlSchemeHandler(QByteArray::fromStdString(name), &scheme);
     }
 
     void impl::handle_stream_scheme(const std::string &name, scheme::stream_resolver &&resolver) // NOLINT(*-function-const)
     {
-        if (platform->stream_schemes.contains(name))
+        auto [it, inserted] = platform->stream_schemes.try_emplace(name, std::move(resolver));
+
+        if (!inserted)
         {
             return;
         }
 
-        auto &scheme = platform->stream_schemes.emplace(name, std::move(resolver)).first->second;
+        auto &scheme = it->second;
         platform->web_view->page()->profile()->installUrlSchemeHandler(QByteArray::fromStdString(name), &scheme);
     }
 
@@ -444,14 +756,29 @@ namespace saucer
         QWebEngineUrlScheme::registerScheme(scheme);
     }
 
-    std::string impl::ready_script()
+    void impl::prewarm(const application::options &)
+    {
+    }
+
+    result<shared_buffer> impl::create_buffer(std::size_t size) // NOLINT(*-function-const)
     {
-        return "window.saucer.internal.message('dom_loaded')";
+        return shared_buffer::impl::host(size);
     }
 
-    std::string impl::creation_script()
+    void impl::share(const shared_buffer &buffer, std::string_view topic)
     {
-        static const auto script = std::format(scripts::ipc_script, R"js(
+        share_fallback(buffer, topic);
+    }
+
+    const std::string &impl::ready_script()
+    {
+        static const std::string script = "window.saucer.internal.message('dom_loaded')";
+        return script;
+    }
+
+    const std::string &impl::creation_script()
+    {
+        static const auto ipc = std::format(scripts::ipc_script, R"js(
             channel: new Promise((resolve) =>
             {
                 new QWebChannel(qt.webChannelTransport, function(channel) {
@@ -460,11 +787,15 @@ namespace saucer
             }),
             message: async (message) =>
             {
-                (await window.saucer.internal.channel).on_message(message);
+                const serialized = typeof message === "string" ? message : window.saucer.internal.stringify(message);
+                (await window.saucer.internal.channel).on_message(serialized);
             }
         )js");
 
-        return std::format("{}\n{}", native::channel_script, script);
+        // `init_web_channel` always succeeds before the first webview injects this, so the channel script is known by then
+        static const auto script = std::format("{}\n{}", native::channel_script, ipc);
+
+        return script;
     }
 
     SAUCER_INSTANTIATE_WEBVIEW_EVENTS(SAUCER_INSTANTIATE_WEBVIEW_IMPL_EVENT);
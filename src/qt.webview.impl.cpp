@@ -6,12 +6,27 @@
 #include "qt.navigation.impl.hpp"
 #include "qt.permission.impl.hpp"
 
+#include <mutex>
+#include <format>
+#include <utility>
+#include <fstream>
+#include <algorithm>
+
 #include <QFile>
 #include <QBuffer>
 
 #include <QWebEngineUrlRequestJob>
 #include <QWebEngineScriptCollection>
 
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_MACOS)
+#include <libproc.h>
+#else
+#include <unistd.h>
+#endif
+
 namespace saucer
 {
     using native = webview::impl::native;
@@ -21,33 +36,51 @@ namespace saucer
 
     void web_class::on_message(const QString &raw)
     {
-        auto message = raw.toStdString();
+        auto message = utils::narrow(raw);
 
         if (message == "dom_loaded")
         {
             impl->platform->dom_loaded = true;
 
-            for (const auto &pending : impl->platform->pending)
+            for (const auto &script : std::exchange(impl->platform->pending, {}))
             {
-                impl->execute(pending);
+                impl->execute(script);
             }
 
-            impl->platform->pending.clear();
             impl->events.get<event::dom_ready>().fire();
 
             return;
         }
 
-        impl->events.get<event::message>().fire(message).find(status::handled);
+        impl->dispatch(message);
     }
 
     request_interceptor::request_interceptor(webview::impl *impl) : impl(impl) {}
 
     void request_interceptor::interceptRequest(QWebEngineUrlRequestInfo &request)
     {
+        const auto target = request.requestUrl().toString();
+
+        if (std::ranges::any_of(impl->platform->content_rules, [&target](const auto &rule) { return rule.match(target).hasMatch(); }))
+        {
+            request.block(true);
+            return;
+        }
+
         impl->events.get<event::request>().fire(url::impl{request.requestUrl()});
     }
 
+    void native::intercept(impl *self)
+    {
+        if (interceptor)
+        {
+            return;
+        }
+
+        interceptor = std::make_unique<request_interceptor>(self);
+        profile->setUrlRequestInterceptor(interceptor.get());
+    }
+
     template <>
     void native::setup<event::permission>([[maybe_unused]] impl *self)
     {
@@ -73,6 +106,12 @@ namespace saucer
                 .origin  = raw.origin(),
             });
 
+            if (self->remembered(*req))
+            {
+                return;
+            }
+
+            req->native<false>()->decided = self->recorder(*req);
             self->events.get<event::permission>().fire(req).find(status::handled);
         };
 
@@ -85,6 +124,11 @@ namespace saucer
     {
     }
 
+    template <>
+    void native::setup<event::process_gone>(impl *)
+    {
+    }
+
     template <>
     void native::setup<event::dom_ready>(impl *)
     {
@@ -123,7 +167,7 @@ namespace saucer
         {
             auto request = navigation{navigation::impl{&req}};
 
-            if (!self->events.get<event::navigate>().fire(request).find(policy::block))
+            if (!self->blocked(request))
             {
                 return;
             }
@@ -160,10 +204,19 @@ namespace saucer
             return;
         }
 
-        interceptor = std::make_unique<request_interceptor>(self);
-        profile->setUrlRequestInterceptor(interceptor.get());
+        intercept(self);
 
-        event.on_clear([this] { interceptor.reset(); });
+        event.on_clear(
+            [this]
+            {
+                if (!content_rules.empty())
+                {
+                    return;
+                }
+
+                profile->setUrlRequestInterceptor(nullptr);
+                interceptor.reset();
+            });
     }
 
     template <>
@@ -195,15 +248,20 @@ namespace saucer
             return;
         }
 
-        auto handler = [self](const auto &title)
+        auto handler = [self](const auto &)
         {
-            self->events.get<event::title>().fire(title.toStdString());
+            self->title_changed();
         };
 
         const auto id = web_view->connect(web_view.get(), &QWebEngineView::titleChanged, handler);
         event.on_clear([this, id] { web_view->disconnect(id); });
     }
 
+    template <>
+    void native::setup<event::timing>(impl *)
+    {
+    }
+
     template <>
     void native::setup<event::load>(impl *self)
     {
@@ -228,6 +286,83 @@ namespace saucer
         return web_page->scripts().find(name).at(0);
     }
 
+    quint32 native::world(const std::string &name)
+    {
+        static std::mutex mutex;
+        static utils::string_map<quint32> worlds;
+
+        std::lock_guard lock{mutex};
+
+        // Qt identifies worlds by number only, every distinct name gets its own id above the ones reserved by Qt
+        const auto id = QWebEngineScript::UserWorld + static_cast<quint32>(worlds.size());
+
+        return worlds.try_emplace(name, id).first->second;
+    }
+
+    std::optional<std::size_t> native::resident(qint64 pid)
+    {
+        if (pid <= 0)
+        {
+            return std::nullopt;
+        }
+
+#if defined(Q_OS_WIN)
+        auto *const handle = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, false, static_cast<DWORD>(pid));
+
+        if (!handle)
+        {
+            return std::nullopt;
+        }
+
+        PROCESS_MEMORY_COUNTERS counters{};
+        const auto success = GetProcessMemoryInfo(handle, &counters, sizeof(counters));
+
+        CloseHandle(handle);
+
+        if (!success)
+        {
+            return std::nullopt;
+        }
+
+        return counters.WorkingSetSize;
+#elif defined(Q_OS_MACOS)
+        rusage_info_v2 info{};
+
+        if (proc_pid_rusage(static_cast<int>(pid), RUSAGE_INFO_V2, reinterpret_cast<rusage_info_t *>(&info)) != 0)
+        {
+            return std::nullopt;
+        }
+
+        return info.ri_resident_size;
+#else
+        std::size_t size{}, pages{};
+
+        if (!(std::ifstream{std::format("/proc/{}/statm", pid)} >> size >> pages))
+        {
+            return std::nullopt;
+        }
+
+        return pages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+    }
+
+    QWebEngineProfile::HttpCacheType native::convert(cache_model model)
+    {
+        switch (model)
+        {
+            using enum cache_model;
+
+        case document_viewer:
+            return QWebEngineProfile::NoCache;
+        case document_browser:
+            return QWebEngineProfile::MemoryHttpCache;
+        case web_browser:
+            return QWebEngineProfile::DiskHttpCache;
+        }
+
+        std::unreachable();
+    }
+
     bool native::init_web_channel()
     {
         if (!channel_script.empty())
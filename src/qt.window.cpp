@@ -5,6 +5,8 @@
 
 #include "instantiate.hpp"
 
+#include <QTimer>
+#include <QScreen>
 #include <QWindow>
 
 #include <flagpp/flags.hpp>
@@ -49,6 +51,38 @@ namespace saucer
     {
     }
 
+    template <>
+    void impl::setup<window::event::frame>()
+    {
+        auto &event = events.get<event::frame>();
+
+        if (!event.empty())
+        {
+            return;
+        }
+
+        auto *const timer = new QTimer{platform->window.get()};
+        const auto rate   = platform->window->screen()->refreshRate();
+
+        auto callback = [this]
+        {
+            if (minimized() || !visible())
+            {
+                return;
+            }
+
+            events.get<event::frame>().fire();
+        };
+
+        timer->setTimerType(Qt::PreciseTimer);
+        timer->setInterval(static_cast<int>(1000.0 / (rate > 0 ? rate : 60.0)));
+
+        QObject::connect(timer, &QTimer::timeout, callback);
+        timer->start();
+
+        event.on_clear([timer] { timer->deleteLater(); });
+    }
+
     bool impl::visible() const
     {
         return platform->window->isVisible();
@@ -163,6 +197,7 @@ namespace saucer
 
     void impl::show() const
     {
+        platform->window->setAttribute(Qt::WA_DontShowOnScreen, offscreen);
         platform->window->show();
     }
 
@@ -79,7 +79,7 @@ namespace saucer
     void main_window::resizeEvent(QResizeEvent *event)
     {
         QMainWindow::resizeEvent(event);
-        impl->events.get<event::resize>().fire(width(), height());
+        impl->resized(width(), height());
     }
 
     overlay_layout::overlay_layout(window::impl *impl) : QLayout(), impl(impl) {}
@@ -0,0 +1,198 @@
+#include "queue.hpp"
+
+#include <utility>
+#include <algorithm>
+
+namespace saucer::utils
+{
+    struct queue::node
+    {
+        task callback;
+        node *next;
+
+      public:
+        std::source_location origin;
+    };
+
+    struct queue::cache
+    {
+        node *head{nullptr};
+
+      public:
+        ~cache()
+        {
+            while (head)
+            {
+                delete std::exchange(head, head->next);
+            }
+        }
+    };
+
+    queue::queue() = default;
+
+    queue::~queue()
+    {
+        for (auto &lane : m_lanes)
+        {
+            take(lane);
+
+            while (lane.front)
+            {
+                delete std::exchange(lane.front, lane.front->next);
+            }
+        }
+
+        for (auto *current = m_free.exchange(nullptr); current;)
+        {
+            delete std::exchange(current, current->next);
+        }
+    }
+
+    void queue::take(lane &lane)
+    {
+        if (!lane.head.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        node *batch{nullptr};
+        node *back{nullptr};
+
+        for (auto *current = lane.head.exchange(nullptr, std::memory_order_acquire); current;)
+        {
+            auto *const next = std::exchange(current->next, batch);
+
+            if (!batch)
+            {
+                back = current;
+            }
+
+            batch   = current;
+            current = next;
+        }
+
+        if (!batch)
+        {
+            return;
+        }
+
+        if (lane.back)
+        {
+            lane.back->next = batch;
+        }
+        else
+        {
+            lane.front = batch;
+        }
+
+        lane.back = back;
+    }
+
+    queue::node *queue::acquire()
+    {
+        // Consumed nodes are handed back through `m_free`, which producers only ever take as a whole to sidestep ABA
+        static thread_local cache local;
+
+        if (!local.head)
+        {
+            local.head = m_free.exchange(nullptr, std::memory_order_acquire);
+        }
+
+        if (!local.head)
+        {
+            return new node{};
+        }
+
+        return std::exchange(local.head, local.head->next);
+    }
+
+    void queue::release(node *item)
+    {
+        item->callback = {};
+        item->next     = m_free.load(std::memory_order_relaxed);
+
+        while (!m_free.compare_exchange_weak(item->next, item, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    bool queue::push(task callback, std::size_t index, std::source_location origin)
+    {
+        auto &lane       = m_lanes[std::min(index, lanes - 1)];
+        auto *const item = acquire();
+
+        item->callback = std::move(callback);
+        item->origin   = origin;
+        auto *head     = lane.head.load(std::memory_order_relaxed);
+
+        m_size.fetch_add(1, std::memory_order_relaxed);
+
+        do
+        {
+            item->next = head;
+        } while (!lane.head.compare_exchange_weak(head, item, std::memory_order_release, std::memory_order_relaxed));
+
+        // Only the producer that finds its lane empty has to wake the consumer
+        return head == nullptr;
+    }
+
+    std::size_t queue::size() const
+    {
+        return m_size.load(std::memory_order_relaxed);
+    }
+
+    void queue::watch(trace_clock::duration budget, long_task_callback callback)
+    {
+        m_budget = budget;
+        m_report = std::move(callback);
+    }
+
+    void queue::drain()
+    {
+        for (auto &lane : m_lanes)
+        {
+            take(lane);
+        }
+
+        // Callbacks may spin a nested event loop which drains again, so the batch is consumed one node at a time
+        while (true)
+        {
+            take(m_lanes.front());
+
+            auto lane = std::ranges::find_if(m_lanes, [](const auto &lane) { return lane.front != nullptr; });
+
+            if (lane == m_lanes.end())
+            {
+                return;
+            }
+
+            auto *const item = std::exchange(lane->front, lane->front->next);
+
+            if (!lane->front)
+            {
+                lane->back = nullptr;
+            }
+
+            m_size.fetch_sub(1, std::memory_order_relaxed);
+
+            if (!m_report)
+            {
+                item->callback();
+                release(item);
+
+                continue;
+            }
+
+            const auto origin = item->origin;
+            const auto start  = trace_clock::now();
+
+            item->callback();
+            release(item);
+
+            if (const auto end = trace_clock::now(); end - start > m_budget)
+            {
+                m_report({.origin = origin, .start = start, .end = end});
+            }
+        }
+    }
+} // namespace saucer::utils
@@ -0,0 +1,1092 @@
+#include "remote.hpp"
+
+#include "threads.hpp"
+#include "shm_ring.hpp"
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <format>
+#include <thread>
+#include <cstdint>
+#include <utility>
+#include <charconv>
+#include <iterator>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <condition_variable>
+
+#include <coco/utils/utils.hpp>
+
+#ifdef _WIN32
+#include <cwchar>
+#include <windows.h>
+#else
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <spawn.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+extern char **environ;
+#endif
+
+namespace saucer::remote
+{
+    namespace
+    {
+        constexpr std::string_view variable = "SAUCER_REMOTE";
+        constexpr std::string_view detached = R"("Host unavailable")";
+
+        // Every frame is `<kind><id> ` followed by length prefixed fields (`<size>:<data>`), so payloads may contain anything
+        struct frame
+        {
+            char kind;
+            std::uint64_t id;
+            std::vector<std::string_view> fields;
+        };
+
+        std::string encode(char kind, std::uint64_t id, std::initializer_list<std::string_view> fields)
+        {
+            auto rtn = std::format("{}{} ", kind, id);
+
+            for (const auto &field : fields)
+            {
+                std::format_to(std::back_inserter(rtn), "{}:", field.size());
+                rtn.append(field);
+            }
+
+            return rtn;
+        }
+
+        std::optional<frame> decode(std::string_view data)
+        {
+            if (data.empty())
+            {
+                return std::nullopt;
+            }
+
+            auto rtn         = frame{.kind = data.front(), .id = 0, .fields = {}};
+            const auto *end  = data.data() + data.size();
+            auto [ptr, code] = std::from_chars(data.data() + 1, end, rtn.id);
+
+            if (code != std::errc{} || ptr == end || *ptr != ' ')
+            {
+                return std::nullopt;
+            }
+
+            for (++ptr; ptr != end;)
+            {
+                std::size_t size{};
+                auto [next, error] = std::from_chars(ptr, end, size);
+
+                if (error != std::errc{} || next == end || *next != ':' || static_cast<std::size_t>(end - next - 1) < size)
+                {
+                    return std::nullopt;
+                }
+
+                rtn.fields.emplace_back(next + 1, size);
+                ptr = next + 1 + size;
+            }
+
+            return rtn;
+        }
+
+        template <typename T>
+        std::optional<T> number(std::string_view value)
+        {
+            T rtn{};
+            auto [ptr, code] = std::from_chars(value.data(), value.data() + value.size(), rtn);
+
+            if (code != std::errc{} || ptr != value.data() + value.size())
+            {
+                return std::nullopt;
+            }
+
+            return rtn;
+        }
+
+        template <typename T>
+        std::string pack(const T &headers)
+        {
+            std::string rtn;
+
+            for (const auto &[name, value] : headers)
+            {
+                rtn.append(std::string_view{name}).push_back('\0');
+                rtn.append(std::string_view{value}).push_back('\0');
+            }
+
+            return rtn;
+        }
+
+        std::vector<std::pair<std::string_view, std::string_view>> unpack(std::string_view data)
+        {
+            std::vector<std::pair<std::string_view, std::string_view>> rtn;
+
+            while (!data.empty())
+            {
+                const auto name  = data.find('\0');
+                const auto value = name == std::string_view::npos ? name : data.find('\0', name + 1);
+
+                if (value == std::string_view::npos)
+                {
+                    break;
+                }
+
+                rtn.emplace_back(data.substr(0, name), data.substr(name + 1, value - name - 1));
+                data.remove_prefix(value + 1);
+            }
+
+            return rtn;
+        }
+
+        std::string_view view(const stash &data)
+        {
+            return {reinterpret_cast<const char *>(data.data()), data.size()};
+        }
+
+#ifdef _WIN32
+        std::wstring widen(std::string_view value)
+        {
+            const auto size = MultiByteToWideChar(CP_UTF8, 0, value.data(), static_cast<int>(value.size()), nullptr, 0);
+            auto rtn        = std::wstring(static_cast<std::size_t>(size), L'\0');
+
+            MultiByteToWideChar(CP_UTF8, 0, value.data(), static_cast<int>(value.size()), rtn.data(), size);
+
+            return rtn;
+        }
+
+        std::wstring quote(std::wstring_view value)
+        {
+            auto rtn = std::wstring{L"\""};
+
+            for (const auto ch : value)
+            {
+                rtn.append(ch == L'"' ? L"\\\"" : std::wstring(1, ch));
+            }
+
+            return rtn.append(L"\"");
+        }
+#endif
+    } // namespace
+
+    struct host_base::impl
+    {
+        using promise = coco::promise<result<std::string>>;
+
+      public:
+        application *parent;
+        std::unique_ptr<serializer_core> serializer;
+
+      public:
+        std::unique_ptr<utils::shm_ring> up;
+        std::unique_ptr<utils::shm_ring> down;
+
+      public:
+#ifdef _WIN32
+        HANDLE process{nullptr};
+#else
+        pid_t process{-1};
+#endif
+
+      public:
+        std::thread reader;
+        std::thread monitor;
+
+      public:
+        std::mutex mutex;
+        std::condition_variable exited;
+        std::optional<int> code;
+        bool released{false};
+
+      public:
+        std::uint64_t counter{0};
+        std::function<void(int)> on_exit;
+
+      public:
+        std::unordered_map<std::string, std::shared_ptr<serializer_core::function>> functions;
+        std::unordered_map<std::uint64_t, promise> evaluations;
+        std::unordered_map<std::string, resolver> schemes;
+
+      public:
+        bool send(std::string_view) const;
+        std::optional<promise> extract(std::uint64_t);
+
+      public:
+        template <typename T>
+        bool dispatch(T &);
+
+      public:
+        void receive(const std::weak_ptr<impl> &);
+        void wait(const std::weak_ptr<impl> &);
+        void reap();
+
+      public:
+        void call(const std::weak_ptr<impl> &, std::uint64_t, std::string);
+        void serve(const std::weak_ptr<impl> &, std::uint64_t, remote::request, const std::string &);
+    };
+
+    bool host_base::impl::send(std::string_view data) const
+    {
+        return down && down->push(data);
+    }
+
+    std::optional<host_base::impl::promise> host_base::impl::extract(std::uint64_t id)
+    {
+        std::lock_guard lock{mutex};
+
+        auto node = evaluations.extract(id);
+
+        if (node.empty())
+        {
+            return std::nullopt;
+        }
+
+        return std::move(node.mapped());
+    }
+
+    template <typename T>
+    bool host_base::impl::dispatch(T &callback)
+    {
+        std::lock_guard lock{mutex};
+
+        // Once the host is gone nothing is posted anymore, the application might not outlive it
+        if (released)
+        {
+            return false;
+        }
+
+        parent->post(std::move(callback));
+
+        return true;
+    }
+
+    void host_base::impl::receive(const std::weak_ptr<impl> &weak)
+    {
+        utils::apply(utils::thread_role::helper);
+
+        while (auto message = up->pop())
+        {
+            auto parsed = decode(*message);
+
+            if (!parsed.has_value())
+            {
+                continue;
+            }
+
+            const auto &[kind, id, fields] = *parsed;
+
+            if ((kind == 'v' || kind == 'x') && fields.size() == 1)
+            {
+                auto evaluation = extract(id);
+
+                if (!evaluation.has_value())
+                {
+                    continue;
+                }
+
+                auto value = kind == 'v' ? result<std::string>{std::string{fields[0]}} : result<std::string>{err(std::errc::io_error)};
+
+                // Continuations run wherever the promise is fulfilled, which has to be the main thread like for calls and requests
+                auto settle = [evaluation = std::move(*evaluation), value = std::move(value)]() mutable
+                {
+                    evaluation.set_value(std::move(value));
+                };
+
+                if (!dispatch(settle))
+                {
+                    settle();
+                }
+
+                continue;
+            }
+
+            if (kind == 'c' && fields.size() == 1)
+            {
+                auto forward = [weak, id, raw = std::string{fields[0]}]() mutable
+                {
+                    if (auto self = weak.lock(); self)
+                    {
+                        self->call(weak, id, std::move(raw));
+                    }
+                };
+
+                dispatch(forward);
+                continue;
+            }
+
+            if (kind != 'q' || fields.size() != 6)
+            {
+                continue;
+            }
+
+            auto req = remote::request{
+                .url     = std::string{fields[2]},
+                .method  = std::string{fields[3]},
+                .headers = {},
+                .body    = std::string{fields[5]},
+            };
+
+            for (const auto &[name, value] : unpack(fields[4]))
+            {
+                req.headers.emplace(name, value);
+            }
+
+            auto key = std::format("{}:{}", fields[0], fields[1]);
+
+            auto forward = [weak, id, req = std::move(req), key = std::move(key)]() mutable
+            {
+                if (auto self = weak.lock(); self)
+                {
+                    self->serve(weak, id, std::move(req), key);
+                }
+            };
+
+            dispatch(forward);
+        }
+    }
+
+    void host_base::impl::wait(const std::weak_ptr<impl> &weak)
+    {
+        utils::apply(utils::thread_role::helper);
+
+#ifdef _WIN32
+        DWORD status{};
+
+        WaitForSingleObject(process, INFINITE);
+        GetExitCodeProcess(process, &status);
+
+        const auto exit_code = static_cast<int>(status);
+#else
+        int status{};
+
+        while (waitpid(process, &status, 0) < 0 && errno == EINTR)
+        {
+        }
+
+        const auto exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+#endif
+
+        // Closing both directions lets the reader drain what the child sent last and stop afterwards
+        up->close();
+        down->close();
+
+        std::unordered_map<std::uint64_t, promise> pending;
+
+        {
+            std::lock_guard lock{mutex};
+            code    = exit_code;
+            pending = std::exchange(evaluations, {});
+        }
+
+        exited.notify_all();
+
+        auto finish = [weak, exit_code, pending = std::move(pending)]() mutable
+        {
+            for (auto &[id, evaluation] : pending)
+            {
+                evaluation.set_value(err(std::errc::broken_pipe));
+            }
+
+            auto self = weak.lock();
+
+            if (!self)
+            {
+                return;
+            }
+
+            std::function<void(int)> callback;
+
+            {
+                std::lock_guard lock{self->mutex};
+                callback = self->on_exit;
+            }
+
+            if (!callback)
+            {
+                return;
+            }
+
+            callback(exit_code);
+        };
+
+        if (!dispatch(finish))
+        {
+            finish();
+        }
+    }
+
+    void host_base::impl::reap()
+    {
+        utils::apply(utils::thread_role::helper);
+
+        {
+            std::unique_lock lock{mutex};
+
+            if (!exited.wait_for(lock, std::chrono::seconds{5}, [this] { return code.has_value(); }))
+            {
+#ifdef _WIN32
+                TerminateProcess(process, 1);
+#else
+                kill(process, SIGKILL);
+#endif
+            }
+        }
+
+        monitor.join();
+        reader.join();
+
+#ifdef _WIN32
+        CloseHandle(process);
+#endif
+    }
+
+    void host_base::impl::call(const std::weak_ptr<impl> &weak, std::uint64_t id, std::string raw)
+    {
+        auto parsed = serializer->parse(raw);
+        auto *data  = std::get_if<std::unique_ptr<function_data>>(&parsed);
+
+        if (!data)
+        {
+            send(encode('j', id, {R"("Malformed call")"}));
+            return;
+        }
+
+        const auto *name = std::get_if<std::string>(&(*data)->name);
+        std::shared_ptr<serializer_core::function> function;
+
+        if (name)
+        {
+            std::lock_guard lock{mutex};
+
+            if (auto it = functions.find(*name); it != functions.end())
+            {
+                function = it->second;
+            }
+        }
+
+        if (!function)
+        {
+            send(encode('j', id, {std::format("\"No exposed function '{}'\"", name ? *name : "")}));
+            return;
+        }
+
+        auto settle = [&weak, id](char kind)
+        {
+            return [weak, id, kind](std::string value)
+            {
+                if (auto self = weak.lock(); self)
+                {
+                    self->send(encode(kind, id, {value}));
+                }
+            };
+        };
+
+        (*data)->own();
+        (*function)(std::move(*data), serializer_core::executor{settle('r'), settle('j')});
+    }
+
+    void host_base::impl::serve(const std::weak_ptr<impl> &weak, std::uint64_t id, remote::request req, const std::string &key)
+    {
+        resolver handler;
+
+        {
+            std::lock_guard lock{mutex};
+
+            if (auto it = schemes.find(key); it != schemes.end())
+            {
+                handler = it->second;
+            }
+        }
+
+        auto fail = [weak, id](scheme::error error)
+        {
+            if (auto self = weak.lock(); self)
+            {
+                self->send(encode('f', id, {std::to_string(std::to_underlying(error))}));
+            }
+        };
+
+        if (!handler)
+        {
+            return fail(scheme::error::not_found);
+        }
+
+        auto respond = [weak, id, fail](scheme::response response)
+        {
+            auto self = weak.lock();
+
+            if (!self)
+            {
+                return;
+            }
+
+            const auto status  = std::to_string(response.status);
+            const auto headers = pack(response.headers);
+
+            // Responses that exceed the capacity of the ring would never arrive, the request is failed instead
+            if (self->send(encode('p', id, {status, response.mime, headers, view(response.data)})))
+            {
+                return;
+            }
+
+            fail(scheme::error::failed);
+        };
+
+        handler(req, scheme::executor{std::move(respond), std::move(fail)});
+    }
+
+    host_base::host_base(application *parent, std::unique_ptr<serializer_core> serializer) : m_impl(std::make_shared<impl>())
+    {
+        m_impl->parent     = parent;
+        m_impl->serializer = std::move(serializer);
+    }
+
+    host_base::host_base(host_base &&) noexcept = default;
+
+    host_base::~host_base()
+    {
+        if (!m_impl || !m_impl->monitor.joinable())
+        {
+            return;
+        }
+
+        auto &self = *m_impl;
+
+        std::unordered_map<std::string, std::shared_ptr<serializer_core::function>> functions;
+        std::unordered_map<std::string, resolver> schemes;
+        std::function<void(int)> on_exit;
+
+        // The handlers are destroyed right here on the main thread, not on whichever thread lets go of the state last
+        {
+            std::lock_guard lock{self.mutex};
+
+            self.released = true;
+
+            functions = std::exchange(self.functions, {});
+            schemes   = std::exchange(self.schemes, {});
+            on_exit   = std::exchange(self.on_exit, {});
+        }
+
+        self.up->close();
+        self.down->close();
+
+        // Waiting for the child to exit (and killing it if it does not) could block the main thread for seconds
+        std::thread{[impl = m_impl] { impl->reap(); }}.detach();
+    }
+
+    result<void> host_base::launch(const options &opts)
+    {
+        static std::atomic_size_t counter{0};
+
+        auto &self = *m_impl;
+
+#ifdef _WIN32
+        const auto pid = static_cast<std::uint64_t>(GetCurrentProcessId());
+#else
+        const auto pid = static_cast<std::uint64_t>(getpid());
+#endif
+
+        // Kept short on purpose, macOS limits the names of shared memory objects and semaphores to 31 characters
+        const auto base = std::format("sr{:x}-{:x}", pid, counter.fetch_add(1));
+
+        self.up   = utils::shm_ring::create(base + "u", opts.capacity);
+        self.down = utils::shm_ring::create(base + "d", opts.capacity);
+
+        if (!self.up || !self.down)
+        {
+            return err(std::errc::not_enough_memory);
+        }
+
+#ifdef _WIN32
+        auto command = quote(opts.executable.wstring());
+
+        for (const auto &arg : opts.arguments)
+        {
+            command.append(L" ").append(quote(widen(arg)));
+        }
+
+        std::wstring environment;
+        auto *const strings = GetEnvironmentStringsW();
+
+        for (const auto *it = strings; *it; it += std::wcslen(it) + 1)
+        {
+            environment.append(it).push_back(L'\0');
+        }
+
+        FreeEnvironmentStringsW(strings);
+
+        environment.append(widen(std::format("{}={}", variable, base))).push_back(L'\0');
+        environment.push_back(L'\0');
+
+        auto startup = STARTUPINFOW{.cb = sizeof(STARTUPINFOW)};
+        auto info    = PROCESS_INFORMATION{};
+
+        if (!CreateProcessW(opts.executable.wstring().c_str(), command.data(), nullptr, nullptr, false, CREATE_UNICODE_ENVIRONMENT,
+                            environment.data(), nullptr, &startup, &info))
+        {
+            return err(std::errc::no_such_file_or_directory);
+        }
+
+        CloseHandle(info.hThread);
+        self.process = info.hProcess;
+#else
+        auto arguments = std::vector<std::string>{opts.executable.string()};
+        arguments.insert(arguments.end(), opts.arguments.begin(), opts.arguments.end());
+
+        std::vector<std::string> environment;
+
+        for (auto **it = environ; *it; ++it)
+        {
+            if (std::string_view{*it}.starts_with(std::format("{}=", variable)))
+            {
+                continue;
+            }
+
+            environment.emplace_back(*it);
+        }
+
+        environment.emplace_back(std::format("{}={}", variable, base));
+
+        auto pointers = [](std::vector<std::string> &values)
+        {
+            auto rtn = std::vector<char *>{};
+
+            for (auto &value : values)
+            {
+                rtn.emplace_back(value.data());
+            }
+
+            rtn.emplace_back(nullptr);
+
+            return rtn;
+        };
+
+        auto argv = pointers(arguments);
+        auto envp = pointers(environment);
+
+        if (const auto status = posix_spawn(&self.process, argv[0], nullptr, nullptr, argv.data(), envp.data()); status != 0)
+        {
+            return err(static_cast<std::errc>(status));
+        }
+#endif
+
+        self.reader  = std::thread{[impl = m_impl.get(), weak = std::weak_ptr{m_impl}] { impl->receive(weak); }};
+        self.monitor = std::thread{[impl = m_impl.get(), weak = std::weak_ptr{m_impl}] { impl->wait(weak); }};
+
+        return {};
+    }
+
+    void host_base::add_function(std::string name, serializer_core::function &&function)
+    {
+        std::lock_guard lock{m_impl->mutex};
+        m_impl->functions.insert_or_assign(std::move(name), std::make_shared<serializer_core::function>(std::move(function)));
+    }
+
+    bool host_base::running() const
+    {
+        std::lock_guard lock{m_impl->mutex};
+        return m_impl->monitor.joinable() && !m_impl->code.has_value();
+    }
+
+    void host_base::execute(std::size_t view, std::string code)
+    {
+        m_impl->send(encode('n', 0, {std::to_string(view), code}));
+    }
+
+    coco::future<result<std::string>> host_base::evaluate_raw(std::size_t view, std::string code)
+    {
+        auto promise = impl::promise{};
+        auto rtn     = promise.get_future();
+
+        std::uint64_t id{};
+
+        {
+            std::lock_guard lock{m_impl->mutex};
+
+            id = ++m_impl->counter;
+            m_impl->evaluations.emplace(id, std::move(promise));
+        }
+
+        if (m_impl->send(encode('e', id, {std::to_string(view), code})))
+        {
+            return rtn;
+        }
+
+        if (auto evaluation = m_impl->extract(id); evaluation.has_value())
+        {
+            evaluation->set_value(err(std::errc::not_connected));
+        }
+
+        return rtn;
+    }
+
+    void host_base::handle_scheme(std::size_t view, const std::string &name, resolver handler)
+    {
+        {
+            std::lock_guard lock{m_impl->mutex};
+            m_impl->schemes.insert_or_assign(std::format("{}:{}", view, name), std::move(handler));
+        }
+
+        m_impl->send(encode('s', 0, {std::to_string(view), name}));
+    }
+
+    void host_base::on_exit(std::function<void(int)> callback)
+    {
+        std::lock_guard lock{m_impl->mutex};
+        m_impl->on_exit = std::move(callback);
+    }
+
+    struct child::impl
+    {
+        application *parent;
+
+      public:
+        std::unique_ptr<utils::shm_ring> up;
+        std::unique_ptr<utils::shm_ring> down;
+
+      public:
+        std::thread reader;
+        std::atomic_bool stopping{false};
+
+      public:
+        std::mutex mutex;
+        std::uint64_t counter{0};
+        std::vector<smartview_base *> views;
+
+      public:
+        std::unordered_map<std::uint64_t, serializer_core::executor> calls;
+        std::unordered_map<std::uint64_t, scheme::executor> requests;
+
+      public:
+        smartview_base *find(std::string_view);
+
+      public:
+        std::optional<serializer_core::executor> claim(std::uint64_t);
+        std::optional<scheme::executor> respond(std::uint64_t);
+
+      public:
+        void receive(const std::weak_ptr<impl> &);
+        void handle(const std::weak_ptr<impl> &, const frame &);
+        void serve(const std::weak_ptr<impl> &, std::string_view, std::string_view);
+    };
+
+    smartview_base *child::impl::find(std::string_view index)
+    {
+        const auto value = number<std::size_t>(index);
+
+        std::lock_guard lock{mutex};
+
+        if (!value.has_value() || *value >= views.size())
+        {
+            return nullptr;
+        }
+
+        return views[*value];
+    }
+
+    std::optional<serializer_core::executor> child::impl::claim(std::uint64_t id)
+    {
+        std::lock_guard lock{mutex};
+
+        auto node = calls.extract(id);
+
+        if (node.empty())
+        {
+            return std::nullopt;
+        }
+
+        return std::move(node.mapped());
+    }
+
+    std::optional<scheme::executor> child::impl::respond(std::uint64_t id)
+    {
+        std::lock_guard lock{mutex};
+
+        auto node = requests.extract(id);
+
+        if (node.empty())
+        {
+            return std::nullopt;
+        }
+
+        return std::move(node.mapped());
+    }
+
+    void child::impl::receive(const std::weak_ptr<impl> &weak)
+    {
+        utils::apply(utils::thread_role::helper);
+
+        while (auto message = down->pop())
+        {
+            if (auto parsed = decode(*message); parsed.has_value())
+            {
+                handle(weak, *parsed);
+            }
+        }
+
+        std::unordered_map<std::uint64_t, serializer_core::executor> pending;
+        std::unordered_map<std::uint64_t, scheme::executor> unanswered;
+
+        {
+            std::lock_guard lock{mutex};
+
+            pending    = std::exchange(calls, {});
+            unanswered = std::exchange(requests, {});
+        }
+
+        for (auto &[id, executor] : pending)
+        {
+            executor.reject(std::string{detached});
+        }
+
+        for (auto &[id, executor] : unanswered)
+        {
+            executor.reject(scheme::error::failed);
+        }
+
+        if (stopping)
+        {
+            return;
+        }
+
+        parent->post([parent = parent] { parent->quit(); });
+    }
+
+    void child::impl::handle(const std::weak_ptr<impl> &weak, const frame &current)
+    {
+        const auto &[kind, id, fields] = current;
+
+        if ((kind == 'r' || kind == 'j') && fields.size() == 1)
+        {
+            auto executor = claim(id);
+
+            if (!executor.has_value())
+            {
+                return;
+            }
+
+            if (kind == 'r')
+            {
+                return executor->resolve(std::string{fields[0]});
+            }
+
+            return executor->reject(std::string{fields[0]});
+        }
+
+        if (kind == 'p' && fields.size() == 4)
+        {
+            auto executor = respond(id);
+
+            if (!executor.has_value())
+            {
+                return;
+            }
+
+            const auto *data = reinterpret_cast<const std::uint8_t *>(fields[3].data());
+
+            auto response = scheme::response{
+                .data   = stash::from({data, data + fields[3].size()}),
+                .mime   = std::string{fields[1]},
+                .status = number<int>(fields[0]).value_or(200),
+            };
+
+            for (const auto &[name, value] : unpack(fields[2]))
+            {
+                response.headers.emplace(std::string{name}, std::string{value});
+            }
+
+            return executor->resolve(std::move(response));
+        }
+
+        if (kind == 'f' && fields.size() == 1)
+        {
+            if (auto executor = respond(id); executor.has_value())
+            {
+                executor->reject(static_cast<scheme::error>(number<int>(fields[0]).value_or(-1)));
+            }
+
+            return;
+        }
+
+        if (fields.size() != 2)
+        {
+            return;
+        }
+
+        if (kind == 's')
+        {
+            return serve(weak, fields[0], fields[1]);
+        }
+
+        auto *const target = find(fields[0]);
+
+        // Scripts for views that were not attached (yet) are dropped, evaluations would otherwise never settle
+        if (!target && kind == 'e')
+        {
+            up->push(encode('x', id, {"No such view"}));
+            return;
+        }
+
+        if (!target)
+        {
+            return;
+        }
+
+        if (kind == 'n')
+        {
+            return target->execute(std::make_shared<const std::string>(fields[1]));
+        }
+
+        if (kind != 'e')
+        {
+            return;
+        }
+
+        auto settle = [weak, id](result<std::string> value)
+        {
+            auto self = weak.lock();
+
+            if (!self)
+            {
+                return;
+            }
+
+            self->up->push(value.has_value() ? encode('v', id, {*value}) : encode('x', id, {value.error().message()}));
+        };
+
+        coco::then(target->evaluate_raw(std::string{fields[1]}), std::move(settle));
+    }
+
+    void child::impl::serve(const std::weak_ptr<impl> &weak, std::string_view index, std::string_view name)
+    {
+        auto *const target = find(index);
+
+        if (!target)
+        {
+            return;
+        }
+
+        auto handler = [weak, index = std::string{index}, name = std::string{name}](const scheme::request &req, scheme::executor executor)
+        {
+            auto self = weak.lock();
+
+            if (!self)
+            {
+                return executor.reject(scheme::error::failed);
+            }
+
+            std::uint64_t id{};
+
+            {
+                std::lock_guard lock{self->mutex};
+
+                id = ++self->counter;
+                self->requests.emplace(id, std::move(executor));
+            }
+
+            const auto body    = req.content();
+            const auto headers = pack(req.headers());
+
+            if (self->up->push(encode('q', id, {index, name, req.url().string(), req.method(), headers, view(body)})))
+            {
+                return;
+            }
+
+            if (auto pending = self->respond(id); pending.has_value())
+            {
+                pending->reject(scheme::error::failed);
+            }
+        };
+
+        target->handle_scheme(std::string{name}, std::move(handler));
+    }
+
+    child::child() : m_impl(std::make_shared<impl>()) {}
+
+    child::~child()
+    {
+        m_impl->stopping = true;
+
+        m_impl->up->close();
+        m_impl->down->close();
+
+        m_impl->reader.join();
+    }
+
+    std::unique_ptr<child> child::connect(application *parent)
+    {
+        const auto *base = std::getenv(variable.data());
+
+        if (!base)
+        {
+            return nullptr;
+        }
+
+        auto up   = utils::shm_ring::open(std::format("{}u", base));
+        auto down = utils::shm_ring::open(std::format("{}d", base));
+
+        if (!up || !down)
+        {
+            return nullptr;
+        }
+
+        auto rtn   = std::unique_ptr<child>{new child};
+        auto &impl = *rtn->m_impl;
+
+        impl.parent = parent;
+        impl.up     = std::move(up);
+        impl.down   = std::move(down);
+        impl.reader = std::thread{[impl = rtn->m_impl.get(), weak = std::weak_ptr{rtn->m_impl}] { impl->receive(weak); }};
+
+        return rtn;
+    }
+
+    std::size_t child::attach(smartview_base &webview)
+    {
+        std::size_t rtn{};
+
+        {
+            std::lock_guard lock{m_impl->mutex};
+
+            rtn = m_impl->views.size();
+            m_impl->views.emplace_back(&webview);
+        }
+
+        auto fallback = [weak = std::weak_ptr{m_impl}](std::string_view raw, serializer_core::executor executor)
+        {
+            auto self = weak.lock();
+
+            if (!self)
+            {
+                return executor.reject(std::string{detached});
+            }
+
+            std::uint64_t id{};
+
+            {
+                std::lock_guard lock{self->mutex};
+
+                id = ++self->counter;
+                self->calls.emplace(id, std::move(executor));
+            }
+
+            if (self->up->push(encode('c', id, {raw})))
+            {
+                return;
+            }
+
+            if (auto pending = self->claim(id); pending.has_value())
+            {
+                pending->reject(std::string{detached});
+            }
+        };
+
+        webview.set_ipc_fallback(std::move(fallback));
+
+        return rtn;
+    }
+} // namespace saucer::remote
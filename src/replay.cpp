@@ -0,0 +1,65 @@
+#include <saucer/replay.hpp>
+
+#include <mutex>
+#include <cstdint>
+#include <fstream>
+#include <utility>
+
+namespace saucer
+{
+    struct recording_file
+    {
+        std::mutex mutex;
+        std::ofstream out;
+    };
+
+    result<ipc_recorder> recording::writer(const fs::path &path)
+    {
+        auto file = std::make_shared<recording_file>();
+        file->out.open(path, std::ios::binary | std::ios::trunc);
+
+        if (!file->out)
+        {
+            return err(std::errc::permission_denied);
+        }
+
+        return [file = std::move(file)](const ipc_record &record)
+        {
+            std::lock_guard lock{file->mutex};
+
+            file->out << record.offset.count() << ' ' << record.message.size() << '\n';
+            file->out.write(record.message.data(), static_cast<std::streamsize>(record.message.size()));
+            file->out.put('\n');
+        };
+    }
+
+    result<std::vector<ipc_record>> recording::read(const fs::path &path)
+    {
+        auto in = std::ifstream{path, std::ios::binary};
+
+        if (!in)
+        {
+            return err(std::errc::no_such_file_or_directory);
+        }
+
+        std::vector<ipc_record> rtn;
+
+        std::int64_t offset{};
+        std::size_t size{};
+
+        while (in >> offset >> size && in.ignore())
+        {
+            auto message = std::string(size, '\0');
+
+            // A recording cut short (e.g. by a crash) keeps every record that was written completely
+            if (!in.read(message.data(), static_cast<std::streamsize>(size)) || !in.ignore())
+            {
+                break;
+            }
+
+            rtn.push_back({.offset = std::chrono::nanoseconds{offset}, .message = std::move(message)});
+        }
+
+        return rtn;
+    }
+} // namespace saucer
@@ -28,6 +28,11 @@ namespace saucer
         }
     }();
 
+    template <typename T>
+    concept Internal = requires() {
+        { T::internal } -> std::convertible_to<bool>;
+    };
+
     template <typename Message>
     auto make_stub()
     {
@@ -35,6 +40,11 @@ namespace saucer
         constexpr auto members  = rebind::utils::member_names<Message>;
         constexpr auto contains = std::ranges::contains(members, "id");
 
+        if constexpr (Internal<Message>)
+        {
+            return std::string{};
+        }
+
         auto filtered = members | std::views::filter([](auto &&member) { return member != "id"; });
         auto params   = filtered | std::views::join_with(',') | std::ranges::to<std::string>();
 
@@ -45,6 +55,37 @@ namespace saucer
         return std::format("window.saucer.{} = ({}) => window.saucer.internal.{};", name<Message>, params, invocation);
     }
 
+    bool request::tagged(std::string_view message)
+    {
+        static constexpr auto whitespace = " \t\r\n";
+
+        if (!message.starts_with('{'))
+        {
+            return false;
+        }
+
+        message.remove_prefix(std::min(message.find_first_not_of(whitespace, 1), message.size()));
+
+        if (!message.starts_with("\"saucer:"))
+        {
+            return false;
+        }
+
+        const auto end = message.find('"', 1);
+
+        if (end == std::string_view::npos)
+        {
+            return false;
+        }
+
+        const auto key = message.substr(1, end - 1);
+
+        return []<auto... Is>(std::string_view key, std::index_sequence<Is...>)
+        {
+            return ((key == request::utils::tag<std::variant_alternative_t<Is, request>>) || ...);
+        }(key, std::make_index_sequence<std::variant_size_v<request>>());
+    }
+
     std::string request::stubs()
     {
         const auto stubs = []<auto... Is>(std::index_sequence<Is...>)
@@ -0,0 +1,420 @@
+#include <saucer/response_cache.hpp>
+
+#include "pool.hpp"
+
+#include <list>
+#include <mutex>
+#include <atomic>
+#include <format>
+#include <thread>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <unordered_map>
+
+namespace saucer::scheme
+{
+    struct response_cache::impl
+    {
+        using buffer = std::shared_ptr<const std::vector<std::uint8_t>>;
+
+      public:
+        struct entry;
+
+      public:
+        options opts;
+
+      public:
+        std::mutex mutex;
+        std::size_t size{0};
+        std::list<entry> entries;
+        std::unordered_map<std::string, std::list<entry>::iterator> lookup;
+        std::unordered_map<std::string, std::vector<executor>> inflight;
+
+      public:
+        std::atomic<std::size_t> hits{0};
+        std::atomic<std::size_t> misses{0};
+        std::atomic<std::size_t> coalesced{0};
+
+      public:
+        [[nodiscard]] std::string key(const request &) const;
+
+      public:
+        [[nodiscard]] std::optional<response> find(const std::string &);
+        void insert(std::string, const response &, stash);
+
+      public:
+        [[nodiscard]] fs::path file(std::string_view) const;
+        [[nodiscard]] std::optional<response> restore(const std::string &);
+        void persist(entry) const;
+
+      public:
+        [[nodiscard]] bool join(const std::string &, executor &);
+        [[nodiscard]] std::vector<executor> settle(const std::string &);
+
+      public:
+        static stash view(buffer);
+    };
+
+    struct response_cache::impl::entry
+    {
+        std::string key;
+        stash data;
+
+      public:
+        std::string mime;
+        header_list headers;
+
+      public:
+        int status;
+    };
+
+    stash response_cache::impl::view(buffer data)
+    {
+        const auto size = data->size();
+        return stash::shared({data, data->data()}, size);
+    }
+
+    std::string response_cache::impl::key(const request &req) const
+    {
+        auto rtn = std::format("{} {}", req.method(), req.url().string());
+
+        for (const auto &name : opts.vary)
+        {
+            rtn += std::format("\n{}: {}", name, req.header(name).value_or(""));
+        }
+
+        return rtn;
+    }
+
+    std::optional<response> response_cache::impl::find(const std::string &key)
+    {
+        std::lock_guard lock{mutex};
+        auto it = lookup.find(key);
+
+        if (it == lookup.end())
+        {
+            return std::nullopt;
+        }
+
+        entries.splice(entries.begin(), entries, it->second);
+        const auto &entry = *it->second;
+
+        return response{.data = entry.data, .mime = entry.mime, .headers = entry.headers, .status = entry.status};
+    }
+
+    void response_cache::impl::insert(std::string key, const response &res, stash data)
+    {
+        if (data.size() > opts.capacity)
+        {
+            return;
+        }
+
+        std::lock_guard lock{mutex};
+
+        if (auto it = lookup.find(key); it != lookup.end())
+        {
+            size -= it->second->data.size();
+            entries.erase(it->second);
+            lookup.erase(it);
+        }
+
+        size += data.size();
+        entries.emplace_front(key, std::move(data), res.mime, res.headers, res.status);
+        lookup.emplace(std::move(key), entries.begin());
+
+        while (size > opts.capacity)
+        {
+            auto &last = entries.back();
+
+            size -= last.data.size();
+            lookup.erase(last.key);
+
+            entries.pop_back();
+        }
+    }
+
+    fs::path response_cache::impl::file(std::string_view key) const
+    {
+        // FNV-1a keeps the file names stable between launches, unlike `std::hash`
+        auto hash = 0xcbf29ce484222325ull;
+
+        for (const auto ch : key)
+        {
+            hash = (hash ^ static_cast<unsigned char>(ch)) * 0x100000001b3ull;
+        }
+
+        return *opts.directory / std::format("{:016x}.cache", hash);
+    }
+
+    std::optional<response> response_cache::impl::restore(const std::string &key)
+    {
+        if (!opts.directory.has_value())
+        {
+            return std::nullopt;
+        }
+
+        const auto path = file(key);
+        auto in         = std::ifstream{path, std::ios::binary};
+
+        std::size_t version{};
+        std::size_t length{};
+        std::size_t count{};
+        std::size_t size{};
+        int status{};
+
+        if (!(in >> version >> length >> status >> count >> size) || !in.ignore())
+        {
+            return std::nullopt;
+        }
+
+        // Entries written for another version or colliding with a different key are treated as a miss
+        if (version != opts.version.size() || length != key.size())
+        {
+            return std::nullopt;
+        }
+
+        std::string mime;
+        header_list headers;
+
+        std::getline(in, mime);
+
+        for (auto i = 0uz; count > i; i++)
+        {
+            std::string name;
+            std::string value;
+
+            std::getline(std::getline(in, name), value);
+            headers.emplace(std::move(name), std::move(value));
+        }
+
+        std::string stored(version + length, '\0');
+
+        if (!in.read(stored.data(), static_cast<std::streamsize>(stored.size())) || stored != opts.version + key)
+        {
+            return std::nullopt;
+        }
+
+        auto body = stash::map(fs::path{path}.replace_extension(".body"));
+
+        if (!body.has_value() || body->size() != size)
+        {
+            return std::nullopt;
+        }
+
+        auto rtn = response{.data = body.value(), .mime = std::move(mime), .headers = std::move(headers), .status = status};
+        insert(key, rtn, std::move(body.value()));
+
+        return rtn;
+    }
+
+    void response_cache::impl::persist(entry value) const
+    {
+        if (!opts.directory.has_value() || value.data.size() > opts.capacity)
+        {
+            return;
+        }
+
+        auto write = [directory = *opts.directory, version = opts.version, path = file(value.key), value = std::move(value)]
+        {
+            std::error_code ec{};
+            fs::create_directories(directory, ec);
+
+            // Files are written next to their target and renamed into place, readers never see a partial entry
+            auto emit = [&ec](const fs::path &target, auto &&callback)
+            {
+                auto temporary = target;
+                temporary += std::format(".{}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+                {
+                    auto out = std::ofstream{temporary, std::ios::binary | std::ios::trunc};
+                    callback(out);
+
+                    if (!out.flush())
+                    {
+                        out.close();
+                        fs::remove(temporary, ec);
+
+                        return false;
+                    }
+                }
+
+                fs::rename(temporary, target, ec);
+
+                return !ec;
+            };
+
+            auto body = [&value](std::ofstream &out)
+            {
+                out.write(reinterpret_cast<const char *>(value.data.data()), static_cast<std::streamsize>(value.data.size()));
+            };
+
+            auto meta = [&](std::ofstream &out)
+            {
+                const auto &[key, data, mime, headers, status] = value;
+                out << std::format("{} {} {} {} {}\n{}\n", version.size(), key.size(), status, headers.size(), data.size(), mime);
+
+                for (const auto &[name, field] : headers)
+                {
+                    out << std::format("{}\n{}\n", std::string_view{name}, std::string_view{field});
+                }
+
+                out << version << key;
+            };
+
+            // The body goes first, an entry only becomes visible once its metadata is in place
+            if (!emit(fs::path{path}.replace_extension(".body"), body))
+            {
+                return;
+            }
+
+            emit(path, meta);
+        };
+
+        utils::pool::shared().submit(std::move(write), utils::pool::lanes - 1);
+    }
+
+    bool response_cache::impl::join(const std::string &key, executor &exec)
+    {
+        if (!opts.coalesce)
+        {
+            return false;
+        }
+
+        std::lock_guard lock{mutex};
+
+        if (auto it = inflight.find(key); it != inflight.end())
+        {
+            it->second.emplace_back(std::move(exec));
+            return true;
+        }
+
+        inflight.emplace(key, std::vector<executor>{});
+
+        return false;
+    }
+
+    std::vector<executor> response_cache::impl::settle(const std::string &key)
+    {
+        std::lock_guard lock{mutex};
+        auto node = inflight.extract(key);
+
+        if (node.empty())
+        {
+            return {};
+        }
+
+        return std::move(node.mapped());
+    }
+
+    response_cache::response_cache(options opts) : m_impl(std::make_shared<impl>(std::move(opts))) {}
+
+    resolver response_cache::wrap(resolver &&handler) const
+    {
+        return [state = m_impl, handler = std::move(handler)](request req, executor exec)
+        {
+            auto key = state->key(req);
+
+            if (auto cached = state->find(key).or_else([&] { return state->restore(key); }); cached.has_value())
+            {
+                state->hits.fetch_add(1, std::memory_order_relaxed);
+                return exec.resolve(std::move(cached.value()));
+            }
+
+            if (state->join(key, exec))
+            {
+                state->coalesced.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            state->misses.fetch_add(1, std::memory_order_relaxed);
+
+            auto resolve = [state, key, resolve = std::move(exec.resolve)](response res)
+            {
+                auto waiters = state->settle(key);
+
+                if (res.status != 200 && waiters.empty())
+                {
+                    return resolve(std::move(res));
+                }
+
+                const auto *raw = res.data.data();
+                auto data       = std::make_shared<const std::vector<std::uint8_t>>(raw, raw + res.data.size());
+
+                if (res.status == 200)
+                {
+                    state->insert(key, res, impl::view(data));
+                    state->persist({.key = key, .data = impl::view(data), .mime = res.mime, .headers = res.headers, .status = res.status});
+                }
+
+                for (auto &waiter : waiters)
+                {
+                    waiter.resolve({.data = impl::view(data), .mime = res.mime, .headers = res.headers, .status = res.status});
+                }
+
+                res.data = impl::view(std::move(data));
+                resolve(std::move(res));
+            };
+
+            auto reject = [state, key, reject = std::move(exec.reject)](error err)
+            {
+                for (auto &waiter : state->settle(key))
+                {
+                    waiter.reject(err);
+                }
+
+                reject(err);
+            };
+
+            handler(std::move(req), {std::move(resolve), std::move(reject)});
+        };
+    }
+
+    std::size_t response_cache::hits() const
+    {
+        return m_impl->hits.load(std::memory_order_relaxed);
+    }
+
+    std::size_t response_cache::misses() const
+    {
+        return m_impl->misses.load(std::memory_order_relaxed);
+    }
+
+    std::size_t response_cache::coalesced() const
+    {
+        return m_impl->coalesced.load(std::memory_order_relaxed);
+    }
+
+    std::size_t response_cache::size() const
+    {
+        std::lock_guard lock{m_impl->mutex};
+        return m_impl->size;
+    }
+
+    void response_cache::clear()
+    {
+        std::lock_guard lock{m_impl->mutex};
+
+        m_impl->size = 0;
+        m_impl->entries.clear();
+        m_impl->lookup.clear();
+
+        if (!m_impl->opts.directory.has_value())
+        {
+            return;
+        }
+
+        std::error_code ec{};
+
+        // Only our own entries are removed, the directory itself may be shared with other data
+        for (const auto &entry : fs::directory_iterator{*m_impl->opts.directory, ec})
+        {
+            if (const auto extension = entry.path().extension(); extension != ".cache" && extension != ".body" && extension != ".tmp")
+            {
+                continue;
+            }
+
+            fs::remove(entry.path(), ec);
+        }
+    }
+} // namespace saucer::scheme
@@ -1,6 +1,7 @@
 #include "serializers/rflpp/rflpp.hpp"
 
 #include <optional>
+#include <string_view>
 
 namespace rfl
 {
@@ -16,17 +17,15 @@ namespace rfl
         {
             rfl::Rename<"saucer:call", bool> tag;
             std::size_t id;
-            std::string name;
-            rfl::Generic params;
+            std::variant<std::size_t, std::string> name;
         };
 
         static function_data to(const ReflType &v) noexcept
         {
             function_data rtn;
 
-            rtn.id     = v.id;
-            rtn.name   = v.name;
-            rtn.params = v.params;
+            rtn.id   = v.id;
+            rtn.name = v.name;
 
             return rtn;
         }
@@ -40,7 +39,6 @@ namespace rfl
             rfl::Rename<"saucer:resolve", bool> tag;
             std::size_t id;
             bool exception;
-            rfl::Generic result;
         };
 
         static result_data to(const ReflType &v) noexcept
@@ -48,7 +46,6 @@ namespace rfl
             result_data rtn;
 
             rtn.id        = v.id;
-            rtn.result    = v.result;
             rtn.exception = v.exception;
 
             return rtn;
@@ -58,6 +55,11 @@ namespace rfl
 
 namespace saucer::serializers::rflpp
 {
+    std::string_view function_data::raw() const
+    {
+        return params;
+    }
+
     serializer::~serializer() = default;
 
     std::string serializer::script() const
@@ -83,16 +85,166 @@ namespace saucer::serializers::rflpp
         return *result;
     }
 
+    std::size_t skip_whitespace(std::string_view data, std::size_t pos)
+    {
+        const auto rtn = data.find_first_not_of(" \t\r\n", pos);
+        return rtn == std::string_view::npos ? data.size() : rtn;
+    }
+
+    std::size_t skip_string(std::string_view data, std::size_t pos)
+    {
+        for (++pos; pos < data.size(); ++pos)
+        {
+            if (data[pos] == '\\')
+            {
+                ++pos;
+                continue;
+            }
+
+            if (data[pos] == '"')
+            {
+                return pos + 1;
+            }
+        }
+
+        return std::string_view::npos;
+    }
+
+    std::size_t skip_value(std::string_view data, std::size_t pos)
+    {
+        std::size_t depth{0};
+
+        while (pos < data.size())
+        {
+            const auto current = data[pos];
+
+            if (current == '"')
+            {
+                pos = skip_string(data, pos);
+
+                if (pos == std::string_view::npos)
+                {
+                    return pos;
+                }
+
+                if (depth == 0)
+                {
+                    return pos;
+                }
+
+                continue;
+            }
+
+            if (current == '{' || current == '[')
+            {
+                ++depth;
+            }
+            else if (current == '}' || current == ']')
+            {
+                if (depth == 0)
+                {
+                    return pos;
+                }
+
+                if (--depth == 0)
+                {
+                    return pos + 1;
+                }
+            }
+            else if (current == ',' && depth == 0)
+            {
+                return pos;
+            }
+
+            ++pos;
+        }
+
+        return depth == 0 ? pos : std::string_view::npos;
+    }
+
+    std::optional<std::string_view> member(std::string_view data, std::string_view key)
+    {
+        auto pos = skip_whitespace(data, 0);
+
+        if (pos >= data.size() || data[pos] != '{')
+        {
+            return std::nullopt;
+        }
+
+        pos = skip_whitespace(data, pos + 1);
+
+        while (pos < data.size() && data[pos] == '"')
+        {
+            const auto end = skip_string(data, pos);
+
+            if (end == std::string_view::npos)
+            {
+                return std::nullopt;
+            }
+
+            const auto name = data.substr(pos + 1, end - pos - 2);
+            pos             = skip_whitespace(data, end);
+
+            if (pos >= data.size() || data[pos] != ':')
+            {
+                return std::nullopt;
+            }
+
+            const auto start = skip_whitespace(data, pos + 1);
+            const auto stop  = skip_value(data, start);
+
+            if (stop == std::string_view::npos || stop == start)
+            {
+                return std::nullopt;
+            }
+
+            if (name == key)
+            {
+                auto value = data.substr(start, stop - start);
+                return value.substr(0, value.find_last_not_of(" \t\r\n") + 1);
+            }
+
+            pos = skip_whitespace(data, stop);
+
+            if (pos >= data.size() || data[pos] != ',')
+            {
+                return std::nullopt;
+            }
+
+            pos = skip_whitespace(data, pos + 1);
+        }
+
+        return std::nullopt;
+    }
+
     serializer::parse_result serializer::parse(std::string_view data) const
     {
         if (auto res = parse_as<function_data>(data); res.has_value())
         {
-            return std::make_unique<function_data>(*res);
+            auto params = member(data, "params");
+
+            if (!params.has_value())
+            {
+                return std::monostate{};
+            }
+
+            res->params = *params;
+
+            return std::make_unique<function_data>(std::move(*res));
         }
 
         if (auto res = parse_as<result_data>(data); res.has_value())
         {
-            return std::make_unique<result_data>(*res);
+            auto result = member(data, "result");
+
+            if (!result.has_value())
+            {
+                return std::monostate{};
+            }
+
+            res->result = *result;
+
+            return std::make_unique<result_data>(std::move(*res));
         }
 
         return std::monostate{};
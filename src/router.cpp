@@ -0,0 +1,148 @@
+#include <saucer/router.hpp>
+
+#include <map>
+#include <span>
+#include <ranges>
+#include <string>
+#include <vector>
+
+namespace saucer::scheme
+{
+    struct router::impl
+    {
+        using handlers = std::map<std::string, resolver, std::less<>>;
+
+      public:
+        struct node;
+
+      public:
+        std::unique_ptr<node> root;
+
+      public:
+        static const resolver *find(const handlers &, std::string_view method);
+        static const resolver *match(const node &, std::span<const std::string_view> path, std::string_view method);
+    };
+
+    struct router::impl::node
+    {
+        std::map<std::string, std::unique_ptr<node>, std::less<>> children;
+        std::unique_ptr<node> wildcard;
+
+      public:
+        handlers exact;
+        handlers prefix;
+    };
+
+    static std::vector<std::string_view> segments(std::string_view path)
+    {
+        auto transform = [](auto &&segment)
+        {
+            return std::string_view{segment.begin(), segment.end()};
+        };
+
+        auto filled = [](const auto &segment)
+        {
+            return !segment.empty();
+        };
+
+        return path                               //
+               | std::views::split('/')           //
+               | std::views::transform(transform) //
+               | std::views::filter(filled)       //
+               | std::ranges::to<std::vector>();
+    }
+
+    const resolver *router::impl::find(const handlers &candidates, std::string_view method)
+    {
+        if (auto it = candidates.find(method); it != candidates.end())
+        {
+            return &it->second;
+        }
+
+        if (auto it = candidates.find(""); it != candidates.end())
+        {
+            return &it->second;
+        }
+
+        return nullptr;
+    }
+
+    const resolver *router::impl::match(const node &current, std::span<const std::string_view> path, std::string_view method)
+    {
+        if (path.empty())
+        {
+            if (const auto *rtn = find(current.exact, method); rtn)
+            {
+                return rtn;
+            }
+        }
+        else
+        {
+            if (auto it = current.children.find(path.front()); it != current.children.end())
+            {
+                if (const auto *rtn = match(*it->second, path.subspan(1), method); rtn)
+                {
+                    return rtn;
+                }
+            }
+
+            if (current.wildcard)
+            {
+                if (const auto *rtn = match(*current.wildcard, path.subspan(1), method); rtn)
+                {
+                    return rtn;
+                }
+            }
+        }
+
+        return find(current.prefix, method);
+    }
+
+    router::router() : m_impl(std::make_shared<impl>(std::make_unique<impl::node>())) {}
+
+    void router::insert(std::string_view method, std::string_view pattern, resolver &&handler)
+    {
+        auto *current = m_impl->root.get();
+
+        for (const auto &segment : segments(pattern))
+        {
+            if (segment == "**")
+            {
+                current->prefix.insert_or_assign(std::string{method}, std::move(handler));
+                return;
+            }
+
+            auto &next = [&]() -> std::unique_ptr<impl::node> &
+            {
+                if (segment == "*" || segment.starts_with(':'))
+                {
+                    return current->wildcard;
+                }
+
+                return current->children[std::string{segment}];
+            }();
+
+            if (!next)
+            {
+                next = std::make_unique<impl::node>();
+            }
+
+            current = next.get();
+        }
+
+        current->exact.insert_or_assign(std::string{method}, std::move(handler));
+    }
+
+    void router::operator()(request req, executor exec) const
+    {
+        const auto path     = req.url().path().generic_string();
+        const auto *handler = impl::match(*m_impl->root, segments(path), req.method());
+
+        if (!handler)
+        {
+            return exec.reject(error::not_found);
+        }
+
+        return (*handler)(std::move(req), std::move(exec));
+    }
+} // namespace saucer::scheme
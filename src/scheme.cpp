@@ -0,0 +1,202 @@
+#include <saucer/scheme.hpp>
+
+#include "scheme.utils.hpp"
+
+#include <format>
+#include <ranges>
+#include <charconv>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace saucer::scheme
+{
+    struct range
+    {
+        std::size_t offset;
+        std::size_t length;
+
+      public:
+        bool satisfiable{true};
+    };
+
+    static std::string_view trim(std::string_view value)
+    {
+        const auto begin = value.find_first_not_of(" \t");
+
+        if (begin == std::string_view::npos)
+        {
+            return {};
+        }
+
+        return value.substr(begin, value.find_last_not_of(" \t") - begin + 1);
+    }
+
+    static std::optional<std::size_t> parse_number(std::string_view value)
+    {
+        std::size_t rtn{};
+
+        if (value.empty())
+        {
+            return std::nullopt;
+        }
+
+        const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), rtn);
+
+        if (ec != std::errc{} || end != value.data() + value.size())
+        {
+            return std::nullopt;
+        }
+
+        return rtn;
+    }
+
+    request::request(std::shared_ptr<impl> impl) : m_impl(std::move(impl)) {}
+
+    request request::share() const
+    {
+        return request{m_impl};
+    }
+
+    std::optional<std::string> header(const request &request, std::string_view name)
+    {
+        return request.header(name);
+    }
+
+    static std::optional<range> parse_range(std::string_view header, std::size_t size)
+    {
+        static constexpr std::string_view unit = "bytes=";
+
+        header = trim(header);
+
+        if (!header.starts_with(unit) || header.contains(','))
+        {
+            return std::nullopt;
+        }
+
+        const auto spec      = trim(header.substr(unit.size()));
+        const auto separator = spec.find('-');
+
+        if (separator == std::string_view::npos)
+        {
+            return std::nullopt;
+        }
+
+        const auto first = trim(spec.substr(0, separator));
+        const auto last  = trim(spec.substr(separator + 1));
+
+        if (first.empty())
+        {
+            const auto suffix = parse_number(last);
+
+            if (!suffix.has_value())
+            {
+                return std::nullopt;
+            }
+
+            if (*suffix == 0 || size == 0)
+            {
+                return range{.offset = 0, .length = 0, .satisfiable = false};
+            }
+
+            const auto length = std::min(*suffix, size);
+            return range{.offset = size - length, .length = length};
+        }
+
+        const auto start = parse_number(first);
+        const auto end   = last.empty() ? std::optional{size - 1} : parse_number(last);
+
+        if (!start.has_value() || !end.has_value() || *end < *start)
+        {
+            return std::nullopt;
+        }
+
+        if (*start >= size)
+        {
+            return range{.offset = 0, .length = 0, .satisfiable = false};
+        }
+
+        return range{.offset = *start, .length = std::min(*end, size - 1) - *start + 1};
+    }
+
+    response serve(const request &request, std::size_t size, const reader &read, std::string mime, header_list headers)
+    {
+        headers.emplace("Accept-Ranges", "bytes");
+
+        const auto requested = header(request, "range");
+        const auto target    = requested.and_then([size](const auto &value) { return parse_range(value, size); });
+
+        if (!target.has_value())
+        {
+            return {.data = read(0, size), .mime = std::move(mime), .headers = std::move(headers)};
+        }
+
+        if (!target->satisfiable)
+        {
+            headers.insert_or_assign("Content-Range", std::format("bytes */{}", size));
+            return {.data = stash::empty(), .mime = std::move(mime), .headers = std::move(headers), .status = 416};
+        }
+
+        const auto offset = target->offset;
+        const auto length = target->length;
+
+        headers.insert_or_assign("Content-Range", std::format("bytes {}-{}/{}", offset, offset + length - 1, size));
+
+        return {.data = read(offset, length), .mime = std::move(mime), .headers = std::move(headers), .status = 206};
+    }
+
+    response serve(const request &request, const stash &content, std::string mime, header_list headers)
+    {
+        auto read = [&content](std::size_t offset, std::size_t length)
+        {
+            if (offset == 0 && length == content.size())
+            {
+                return content;
+            }
+
+            return content.slice(offset, length);
+        };
+
+        return serve(request, content.size(), read, std::move(mime), std::move(headers));
+    }
+} // namespace saucer::scheme
+
+namespace saucer
+{
+    scheme::write_status utils::write_file(scheme::stream_writer &writer, int fd, std::size_t offset, std::size_t length)
+    {
+        static constexpr auto chunk_size = 256uz * 1024;
+
+        auto status = scheme::write_status::written;
+
+        while (length > 0 && status != scheme::write_status::closed)
+        {
+            auto buffer = std::vector<std::uint8_t>(std::min(chunk_size, length));
+
+#ifdef _WIN32
+            _lseeki64(fd, static_cast<__int64>(offset), SEEK_SET);
+            const auto read = _read(fd, buffer.data(), static_cast<unsigned>(buffer.size()));
+#else
+            const auto read = ::pread(fd, buffer.data(), buffer.size(), static_cast<off_t>(offset));
+#endif
+
+            if (read <= 0)
+            {
+                break;
+            }
+
+            buffer.resize(static_cast<std::size_t>(read));
+
+            offset += buffer.size();
+            length -= buffer.size();
+
+            status = writer.write(stash::from(std::move(buffer)));
+        }
+
+        return status;
+    }
+} // namespace saucer
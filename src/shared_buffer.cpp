@@ -0,0 +1,31 @@
+#include "shared_buffer.impl.hpp"
+
+namespace saucer
+{
+    shared_buffer::shared_buffer(std::shared_ptr<impl> data) : m_impl(std::move(data)) {}
+
+    std::span<std::uint8_t> shared_buffer::data() const
+    {
+        return m_impl->data;
+    }
+
+    std::size_t shared_buffer::size() const
+    {
+        return m_impl->data.size();
+    }
+
+    shared_buffer::impl *shared_buffer::native() const
+    {
+        return m_impl.get();
+    }
+
+    shared_buffer shared_buffer::impl::host(std::size_t size)
+    {
+        auto rtn = std::make_shared<impl>();
+
+        rtn->storage.resize(size);
+        rtn->data = rtn->storage;
+
+        return {std::move(rtn)};
+    }
+} // namespace saucer
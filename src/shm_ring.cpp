@@ -0,0 +1,413 @@
+#include "shm_ring.hpp"
+
+#include <new>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <climits>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <semaphore.h>
+#endif
+
+namespace saucer::utils
+{
+    struct header
+    {
+        std::atomic<std::uint64_t> head{0};
+        std::atomic<std::uint64_t> tail{0};
+        std::atomic<std::uint32_t> closed{0};
+
+      public:
+        std::uint64_t capacity;
+    };
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Shared atomics have to be lock free");
+
+    struct shm_ring::native
+    {
+        std::string name;
+
+      public:
+        // Only what this process created itself is unlinked again, a name that was taken belongs to someone else
+        bool owns_memory{false};
+        bool owns_semaphore{false};
+
+      public:
+        header *shared{nullptr};
+        std::uint8_t *data{nullptr};
+        std::size_t size{0};
+
+      public:
+        // Kept locally, the other process could change the shared copy after it was checked
+        std::uint64_t capacity{0};
+
+      public:
+        std::mutex mutex;
+
+#ifdef _WIN32
+      public:
+        HANDLE mapping{nullptr};
+        HANDLE semaphore{nullptr};
+#else
+      public:
+        int fd{-1};
+        sem_t *semaphore{SEM_FAILED};
+#endif
+
+      public:
+        void write(std::uint64_t, const void *, std::size_t) const;
+        void read(std::uint64_t, void *, std::size_t) const;
+
+      public:
+        void post() const;
+        void wait() const;
+
+      public:
+        [[nodiscard]] bool full(std::uint64_t, std::size_t) const;
+    };
+
+    void shm_ring::native::write(std::uint64_t position, const void *source, std::size_t length) const
+    {
+        const auto offset = static_cast<std::size_t>(position % capacity);
+        const auto first  = std::min<std::size_t>(length, capacity - offset);
+
+        std::memcpy(data + offset, source, first);
+        std::memcpy(data, static_cast<const std::uint8_t *>(source) + first, length - first);
+    }
+
+    void shm_ring::native::read(std::uint64_t position, void *destination, std::size_t length) const
+    {
+        const auto offset = static_cast<std::size_t>(position % capacity);
+        const auto first  = std::min<std::size_t>(length, capacity - offset);
+
+        std::memcpy(destination, data + offset, first);
+        std::memcpy(static_cast<std::uint8_t *>(destination) + first, data, length - first);
+    }
+
+    void shm_ring::native::post() const
+    {
+#ifdef _WIN32
+        ReleaseSemaphore(semaphore, 1, nullptr);
+#else
+        sem_post(semaphore);
+#endif
+    }
+
+    void shm_ring::native::wait() const
+    {
+#ifdef _WIN32
+        WaitForSingleObject(semaphore, INFINITE);
+#else
+        // Interruptions are harmless, the caller re-checks the ring either way
+        sem_wait(semaphore);
+#endif
+    }
+
+    bool shm_ring::native::full(std::uint64_t head, std::size_t needed) const
+    {
+        return capacity - (head - shared->tail.load(std::memory_order_acquire)) < needed;
+    }
+
+    shm_ring::shm_ring() : m_native(std::make_unique<native>()) {}
+
+    shm_ring::~shm_ring()
+    {
+        // Construction may have failed half-way, so only what was acquired is released
+#ifdef _WIN32
+        if (m_native->shared)
+        {
+            UnmapViewOfFile(m_native->shared);
+        }
+
+        if (m_native->mapping)
+        {
+            CloseHandle(m_native->mapping);
+        }
+
+        if (m_native->semaphore)
+        {
+            CloseHandle(m_native->semaphore);
+        }
+#else
+        if (m_native->shared)
+        {
+            munmap(m_native->shared, m_native->size);
+        }
+
+        if (m_native->fd >= 0)
+        {
+            ::close(m_native->fd);
+        }
+
+        if (m_native->semaphore != SEM_FAILED)
+        {
+            sem_close(m_native->semaphore);
+        }
+
+        if (m_native->owns_memory)
+        {
+            shm_unlink(m_native->name.c_str());
+        }
+
+        if (m_native->owns_semaphore)
+        {
+            sem_unlink((m_native->name + "s").c_str());
+        }
+#endif
+    }
+
+    std::unique_ptr<shm_ring> shm_ring::create(const std::string &name, std::size_t capacity)
+    {
+        auto rtn   = std::unique_ptr<shm_ring>{new shm_ring};
+        auto &self = *rtn->m_native;
+
+        self.size = sizeof(header) + capacity;
+
+#ifdef _WIN32
+        self.name = "Local\\" + name;
+
+        const auto wide = std::wstring{self.name.begin(), self.name.end()};
+        const auto size = static_cast<std::uint64_t>(self.size);
+
+        self.mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, static_cast<DWORD>(size >> 32),
+                                          static_cast<DWORD>(size), wide.c_str());
+
+        if (!self.mapping || GetLastError() == ERROR_ALREADY_EXISTS)
+        {
+            return nullptr;
+        }
+
+        self.shared    = static_cast<header *>(MapViewOfFile(self.mapping, FILE_MAP_ALL_ACCESS, 0, 0, self.size));
+        self.semaphore = CreateSemaphoreW(nullptr, 0, LONG_MAX, (wide + L"-s").c_str());
+
+        if (!self.shared || !self.semaphore)
+        {
+            return nullptr;
+        }
+#else
+        self.name = "/" + name;
+        self.fd   = shm_open(self.name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+
+        if (self.fd < 0)
+        {
+            return nullptr;
+        }
+
+        self.owns_memory = true;
+        fcntl(self.fd, F_SETFD, FD_CLOEXEC);
+
+        if (ftruncate(self.fd, static_cast<off_t>(self.size)) != 0)
+        {
+            return nullptr;
+        }
+
+        void *mapped = mmap(nullptr, self.size, PROT_READ | PROT_WRITE, MAP_SHARED, self.fd, 0);
+
+        if (mapped == MAP_FAILED)
+        {
+            return nullptr;
+        }
+
+        self.shared    = static_cast<header *>(mapped);
+        self.semaphore = sem_open((self.name + "s").c_str(), O_CREAT | O_EXCL, 0600, 0);
+
+        if (self.semaphore == SEM_FAILED)
+        {
+            return nullptr;
+        }
+
+        self.owns_semaphore = true;
+#endif
+
+        self.shared           = new (self.shared) header{};
+        self.shared->capacity = capacity;
+        self.capacity         = capacity;
+        self.data             = reinterpret_cast<std::uint8_t *>(self.shared) + sizeof(header);
+
+        return rtn;
+    }
+
+    std::unique_ptr<shm_ring> shm_ring::open(const std::string &name)
+    {
+        auto rtn   = std::unique_ptr<shm_ring>{new shm_ring};
+        auto &self = *rtn->m_native;
+
+#ifdef _WIN32
+        self.name = "Local\\" + name;
+
+        const auto wide = std::wstring{self.name.begin(), self.name.end()};
+        self.mapping    = OpenFileMappingW(FILE_MAP_ALL_ACCESS, false, wide.c_str());
+
+        if (!self.mapping)
+        {
+            return nullptr;
+        }
+
+        self.shared    = static_cast<header *>(MapViewOfFile(self.mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+        self.semaphore = OpenSemaphoreW(SYNCHRONIZE | SEMAPHORE_MODIFY_STATE, false, (wide + L"-s").c_str());
+
+        if (!self.shared || !self.semaphore)
+        {
+            return nullptr;
+        }
+
+        MEMORY_BASIC_INFORMATION info{};
+
+        if (!VirtualQuery(self.shared, &info, sizeof(info)) || info.RegionSize <= sizeof(header))
+        {
+            return nullptr;
+        }
+
+        self.size = info.RegionSize;
+#else
+        self.name = "/" + name;
+        self.fd   = shm_open(self.name.c_str(), O_RDWR, 0600);
+
+        if (self.fd < 0)
+        {
+            return nullptr;
+        }
+
+        fcntl(self.fd, F_SETFD, FD_CLOEXEC);
+
+        struct stat info{};
+
+        if (fstat(self.fd, &info) != 0 || static_cast<std::size_t>(info.st_size) <= sizeof(header))
+        {
+            return nullptr;
+        }
+
+        self.size    = static_cast<std::size_t>(info.st_size);
+        void *mapped = mmap(nullptr, self.size, PROT_READ | PROT_WRITE, MAP_SHARED, self.fd, 0);
+
+        if (mapped == MAP_FAILED)
+        {
+            return nullptr;
+        }
+
+        self.shared    = static_cast<header *>(mapped);
+        self.semaphore = sem_open((self.name + "s").c_str(), 0);
+
+        if (self.semaphore == SEM_FAILED)
+        {
+            return nullptr;
+        }
+#endif
+
+        // The mapping is rounded up to whole pages, so the advertised capacity only has to fit into it
+        self.capacity = self.shared->capacity;
+        self.data     = reinterpret_cast<std::uint8_t *>(self.shared) + sizeof(header);
+
+        if (self.capacity == 0 || self.capacity > self.size - sizeof(header))
+        {
+            return nullptr;
+        }
+
+        return rtn;
+    }
+
+    bool shm_ring::push(std::string_view message, std::chrono::milliseconds timeout)
+    {
+        auto &self        = *m_native;
+        const auto needed = sizeof(std::uint32_t) + message.size();
+
+        if (needed > self.capacity)
+        {
+            return false;
+        }
+
+        std::lock_guard lock{self.mutex};
+
+        const auto head     = self.shared->head.load(std::memory_order_relaxed);
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+        // The consumer may live in a process that stalls, we give it a moment but do not block the caller indefinitely
+        while (self.full(head, needed))
+        {
+            if (self.shared->closed.load(std::memory_order_acquire) || std::chrono::steady_clock::now() >= deadline)
+            {
+                return false;
+            }
+
+            std::this_thread::sleep_for(std::chrono::microseconds{100});
+        }
+
+        if (self.shared->closed.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        const auto length = static_cast<std::uint32_t>(message.size());
+
+        self.write(head, &length, sizeof(length));
+        self.write(head + sizeof(length), message.data(), message.size());
+
+        self.shared->head.store(head + needed, std::memory_order_release);
+        self.post();
+
+        return true;
+    }
+
+    std::optional<std::string> shm_ring::pop()
+    {
+        auto &self = *m_native;
+
+        while (true)
+        {
+            const auto tail = self.shared->tail.load(std::memory_order_relaxed);
+            const auto head = self.shared->head.load(std::memory_order_acquire);
+
+            if (head != tail)
+            {
+                const auto available = head - tail;
+                std::uint32_t length{};
+
+                if (available < sizeof(length) || available > self.capacity)
+                {
+                    close();
+                    return std::nullopt;
+                }
+
+                self.read(tail, &length, sizeof(length));
+
+                // The length comes from another process, a frame that does not fit what was written means the ring is corrupt
+                if (length > available - sizeof(length) || length > self.capacity)
+                {
+                    close();
+                    return std::nullopt;
+                }
+
+                auto rtn = std::string(length, '\0');
+                self.read(tail + sizeof(length), rtn.data(), length);
+
+                self.shared->tail.store(tail + sizeof(length) + length, std::memory_order_release);
+
+                return rtn;
+            }
+
+            if (self.shared->closed.load(std::memory_order_acquire))
+            {
+                return std::nullopt;
+            }
+
+            self.wait();
+        }
+    }
+
+    void shm_ring::close()
+    {
+        m_native->shared->closed.store(1, std::memory_order_release);
+        m_native->post();
+    }
+} // namespace saucer::utils
@@ -2,11 +2,38 @@
 
 #include "webview.impl.hpp"
 
+#include "hash.hpp"
+#include "pool.hpp"
 #include "lease.hpp"
+#include "invoke.hpp"
 #include "scripts.hpp"
+#include "threads.hpp"
+#include "metrics.impl.hpp"
 
+#include <map>
+#include <list>
+#include <array>
+#include <deque>
+#include <mutex>
 #include <atomic>
+#include <chrono>
+#include <ranges>
+#include <format>
+#include <limits>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <variant>
+#include <utility>
+#include <charconv>
+#include <iterator>
+#include <optional>
+#include <typeindex>
+#include <algorithm>
 #include <functional>
+#include <string_view>
+#include <unordered_set>
+#include <condition_variable>
 
 #include <lockpp/lock.hpp>
 
@@ -17,145 +44,2156 @@ namespace saucer
     using resolver = serializer_core::resolver;
     using function = serializer_core::function;
 
+    struct result_cache
+    {
+        using entry = std::pair<std::string, std::string>;
+
+      public:
+        std::size_t capacity;
+
+      public:
+        std::mutex mutex;
+        std::list<entry> entries;
+        std::unordered_map<std::string_view, std::list<entry>::iterator> lookup;
+
+      public:
+        [[nodiscard]] std::optional<std::string> find(std::string_view);
+        void insert(std::string, std::string);
+    };
+
+    struct limiter
+    {
+        using clock = std::chrono::steady_clock;
+
+      public:
+        rate_limit options;
+
+      public:
+        std::mutex mutex;
+        std::optional<clock::time_point> last;
+        std::unordered_map<std::string, std::vector<std::size_t>> flights;
+
+      public:
+        [[nodiscard]] bool admit();
+        [[nodiscard]] bool join(const std::string &, std::size_t);
+        [[nodiscard]] std::vector<std::size_t> land(const std::string &);
+    };
+
+    struct semaphore
+    {
+        std::size_t limit;
+
+      public:
+        std::mutex mutex;
+        std::size_t running{0};
+        std::deque<task> waiting;
+
+      public:
+        [[nodiscard]] bool acquire(task &);
+        [[nodiscard]] std::optional<task> release();
+    };
+
+    struct permit
+    {
+        std::shared_ptr<semaphore> slots;
+        std::move_only_function<void(task)> resume;
+
+      public:
+        std::atomic_bool released{false};
+
+      public:
+        ~permit();
+
+      public:
+        void release();
+    };
+
+    struct exposed_function
+    {
+        function callback;
+        utils::pool *worker;
+        saucer::priority priority;
+
+      public:
+        std::shared_ptr<result_cache> cache;
+        std::shared_ptr<limiter> limit;
+        std::shared_ptr<semaphore> slots;
+    };
+
+    struct registry
+    {
+        using exposed = std::shared_ptr<exposed_function>;
+
+      public:
+        std::vector<exposed> functions;
+        utils::string_map<std::size_t> ids;
+
+      public:
+        std::unordered_map<std::size_t, std::size_t> stubs;
+        std::unordered_map<std::size_t, std::unique_ptr<utils::pool>> strands;
+
+      public:
+        [[nodiscard]] utils::pool *worker(std::size_t, launch);
+        [[nodiscard]] exposed find(const std::variant<std::size_t, std::string> &) const;
+    };
+
+    struct evaluation
+    {
+        using clock     = std::chrono::steady_clock;
+        using deadlines = std::multimap<clock::time_point, std::size_t>;
+
+      public:
+        resolver resolve;
+        std::size_t generation;
+
+      public:
+        std::optional<deadlines::iterator> deadline;
+    };
+
+    struct evaluation_table
+    {
+        std::unordered_map<std::size_t, evaluation> pending;
+        evaluation::deadlines deadlines;
+
+      public:
+        std::optional<std::size_t> limit;
+        std::optional<std::chrono::milliseconds> timeout;
+
+      public:
+        [[nodiscard]] std::optional<resolver> extract(std::size_t);
+    };
+
+    struct trace_context
+    {
+        std::shared_ptr<const ipc_tracer> tracer;
+        std::size_t id;
+
+      public:
+        void operator()(ipc_stage, trace_clock::time_point) const;
+    };
+
+    struct evaluation_reaper
+    {
+        bool stop{false};
+        std::thread thread;
+        std::once_flag started;
+
+      public:
+        std::mutex mutex;
+        std::condition_variable condition;
+    };
+
+    struct channel_state
+    {
+        using executor = serializer_core::executor;
+
+      public:
+        static constexpr auto capacity = 64uz;
+
+      public:
+        std::mutex mutex;
+        std::deque<std::string> queue;
+        std::optional<executor> waiting;
+
+      public:
+        bool closed{false};
+        std::optional<std::string> error;
+
+      public:
+        channel_status push(std::string);
+        void finish(std::optional<std::string>);
+
+      public:
+        bool pull(executor);
+        std::optional<executor> cancel();
+
+      public:
+        static std::string batch(const std::deque<std::string> &, bool);
+    };
+
+    struct channel_table
+    {
+        using channel = std::shared_ptr<channel_state>;
+
+      public:
+        std::size_t id_counter{0};
+        std::unordered_map<std::size_t, channel> open;
+    };
+
+    struct cancellation_table
+    {
+        using token = std::shared_ptr<std::atomic_bool>;
+
+      public:
+        std::unordered_set<std::size_t> armed;
+        std::unordered_map<std::size_t, std::weak_ptr<std::atomic_bool>> inflight;
+    };
+
+    struct topic_table
+    {
+        std::unordered_set<std::string, utils::string_hash, std::equal_to<>> subscribed;
+        std::string batched;
+    };
+
+    struct compression_state
+    {
+        ipc_compression options;
+
+      public:
+        std::atomic_bool negotiated{false};
+    };
+
+    struct recorder_state
+    {
+        ipc_recorder callback;
+        trace_clock::time_point start;
+    };
+
     struct smartview_base::impl
     {
-        using exposed = std::shared_ptr<function>;
+        using exposed = registry::exposed;
 
       public:
         std::atomic_size_t id_counter{0};
+        std::atomic_size_t prepare_counter{0};
         std::unique_ptr<serializer_core> serializer;
 
       public:
-        lock<std::unordered_map<std::string, exposed>> functions;
-        lock<std::unordered_map<std::size_t, resolver>> evaluations;
+        lock<registry> functions;
+        lock<evaluation_table> evaluations;
+
+      public:
+        std::atomic_size_t armed{0};
+        lock<cancellation_table> cancellations;
+
+      public:
+        std::atomic_bool live{false};
+        std::atomic_size_t generation{0};
 
       public:
+        std::atomic_size_t sample_rate{1};
+        std::atomic<std::shared_ptr<const ipc_tracer>> tracer;
+        std::atomic<std::shared_ptr<const recorder_state>> recorder;
+        std::atomic<std::shared_ptr<const ipc_fallback>> fallback;
+
+      public:
+        std::atomic<std::shared_ptr<compression_state>> compression;
+        lock<std::optional<std::size_t>> compression_script;
+
+      public:
+        evaluation_reaper reaper;
         utils::lease<webview::impl *> lease;
 
+      public:
+        std::shared_ptr<lock<channel_table>> channels{std::make_shared<lock<channel_table>>()};
+        std::shared_ptr<lock<topic_table>> topics{std::make_shared<lock<topic_table>>()};
+        std::shared_ptr<lock<std::string>> patches{std::make_shared<lock<std::string>>()};
+
+      public:
+        lock<std::optional<std::size_t>> state;
+
+      public:
+        ~impl();
+
       public:
         status on_message(std::string_view);
+        status on_batch(std::string_view);
+        status on_compressed(std::string_view);
+        status on_buffers(std::string_view, std::vector<stash>);
+        status on_files(std::string_view, std::vector<fs::path>);
+
+      public:
+        void on_dom_ready();
+        void on_load(const state &);
+
+      public:
+        void reap();
+        void wake();
+        void cancel(std::size_t);
+
+      public:
+        std::optional<std::size_t> track(resolver &&);
 
       public:
-        void call(std::unique_ptr<function_data>);
+        void call(std::unique_ptr<function_data>, std::string_view raw = {});
         void resolve(std::unique_ptr<result_data>);
+
+      public:
+        void close_channels();
+        bool control(std::string_view, std::size_t);
+
+      public:
+        bool abort(std::string_view, std::size_t);
+        cancellation_table::token claim(std::size_t);
+
+      public:
+        static void memoize(serializer_core::executor &, std::shared_ptr<result_cache>, std::string);
+        void share(serializer_core::executor &, std::shared_ptr<limiter>, std::string);
+        void occupy(serializer_core::executor &, const exposed &);
+
+      public:
+        [[nodiscard]] trace_context sample(std::size_t) const;
+        [[nodiscard]] serializer_core::executor marshal(trace_context, trace_clock::time_point, priority);
+
+      public:
+        static std::string quote(std::string_view);
+
+      public:
+        static std::string base64(std::string_view);
+        static std::optional<std::string> unbase64(std::string_view);
+        static trace_clock::time_point stamp();
+
+      public:
+        static std::pair<std::size_t, serializer_core::channel> open(const std::shared_ptr<lock<channel_table>> &);
     };
 
-    smartview_base::smartview_base(webview &&base, std::unique_ptr<serializer_core> serializer)
-        : webview(std::move(base)), m_impl(std::make_unique<impl>())
+    void trace_context::operator()(ipc_stage stage, trace_clock::time_point start) const
     {
-        using namespace scripts;
+        if (!tracer)
+        {
+            return;
+        }
 
-        m_impl->lease      = utils::lease{webview::m_impl.get()};
-        m_impl->serializer = std::move(serializer);
+        (*tracer)({.id = id, .stage = stage, .start = start, .end = trace_clock::now()});
+    }
 
-        inject({
-            .code      = m_impl->serializer->script(),
-            .run_at    = script::time::creation,
-            .clearable = false,
-        });
+    std::optional<resolver> evaluation_table::extract(std::size_t id)
+    {
+        auto node = pending.extract(id);
 
-        inject({
-            .code      = std::format(bridge_script, m_impl->serializer->js_serializer()),
-            .run_at    = script::time::creation,
-            .clearable = false,
-        });
+        if (!node)
+        {
+            return std::nullopt;
+        }
+
+        auto &entry = node.mapped();
+
+        if (entry.deadline.has_value())
+        {
+            deadlines.erase(*entry.deadline);
+        }
+
+        utils::metrics::get().evaluations.fetch_sub(1, std::memory_order_relaxed);
 
-        on<event::message>({{.func = std::bind_front(&impl::on_message, m_impl.get()), .clearable = false}});
+        return std::move(entry.resolve);
     }
 
-    smartview_base::smartview_base(smartview_base &&) noexcept = default;
+    channel_status channel_state::push(std::string value)
+    {
+        std::unique_lock guard{mutex};
 
-    smartview_base::~smartview_base() = default;
+        if (closed)
+        {
+            return channel_status::closed;
+        }
 
-    status smartview_base::impl::on_message(std::string_view message)
+        if (!waiting.has_value())
+        {
+            queue.emplace_back(std::move(value));
+            return queue.size() >= capacity ? channel_status::saturated : channel_status::written;
+        }
+
+        auto exec = std::move(*waiting);
+        waiting.reset();
+
+        guard.unlock();
+
+        auto values = std::deque<std::string>{};
+        values.emplace_back(std::move(value));
+
+        exec.resolve(batch(values, false));
+
+        return channel_status::written;
+    }
+
+    void channel_state::finish(std::optional<std::string> reason)
     {
-        auto parsed = serializer->parse(message);
+        std::unique_lock guard{mutex};
 
-        overload visitor = {
-            [](std::monostate &)
-            {
-                //
-                return status::unhandled;
-            },
-            [this](std::unique_ptr<function_data> &parsed)
-            {
-                call(std::move(parsed));
-                return status::handled;
-            },
-            [this](std::unique_ptr<result_data> &parsed)
-            {
-                resolve(std::move(parsed));
-                return status::handled;
-            },
-        };
+        if (closed)
+        {
+            return;
+        }
 
-        return std::visit(visitor, parsed);
+        closed = true;
+        error  = std::move(reason);
+
+        if (!waiting.has_value())
+        {
+            return;
+        }
+
+        auto exec = std::move(*waiting);
+        waiting.reset();
+
+        auto values     = std::exchange(queue, {});
+        const auto done = !error.has_value();
+        auto failure    = values.empty() ? std::exchange(error, std::nullopt) : std::nullopt;
+
+        guard.unlock();
+
+        if (failure.has_value())
+        {
+            return exec.reject(std::move(*failure));
+        }
+
+        exec.resolve(batch(values, done));
     }
 
-    void smartview_base::impl::call(std::unique_ptr<function_data> message)
+    bool channel_state::pull(executor exec)
     {
-        exposed function;
+        std::unique_lock guard{mutex};
 
-        if (auto locked = functions.write(); locked->contains(message->name))
+        if (waiting.has_value())
         {
-            function = locked->at(message->name);
+            guard.unlock();
+            exec.reject(R"("Channel is already being read")");
+
+            return false;
         }
-        else
+
+        if (queue.empty() && !closed)
         {
-            return lease.value()->reject(message->id, std::format("\"No exposed function '{}'\"", message->name));
+            waiting.emplace(std::move(exec));
+            return false;
         }
 
-        auto executor = serializer_core::executor{
-            utils::defer(lease, [id = message->id](auto *self, auto result) { return self->resolve(id, result); }),
-            utils::defer(lease, [id = message->id](auto *self, auto error) { return self->reject(id, error); }),
-        };
+        auto values = std::exchange(queue, {});
+
+        if (values.empty() && error.has_value())
+        {
+            auto failure = std::move(*error);
+            guard.unlock();
 
-        return (*function)(std::move(message), std::move(executor));
+            exec.reject(std::move(failure));
+
+            return true;
+        }
+
+        const auto done = closed && !error.has_value();
+        guard.unlock();
+
+        exec.resolve(batch(values, done));
+
+        return done;
     }
 
-    void smartview_base::impl::resolve(std::unique_ptr<result_data> message)
+    std::optional<channel_state::executor> channel_state::cancel()
+    {
+        std::lock_guard guard{mutex};
+
+        closed = true;
+
+        queue.clear();
+        error.reset();
+
+        return std::exchange(waiting, std::nullopt);
+    }
+
+    std::string channel_state::batch(const std::deque<std::string> &values, bool done)
     {
-        resolver evaluation;
+        std::string rtn{"[["};
 
-        if (auto locked = evaluations.write(); auto node = locked->extract(message->id))
+        for (auto it = values.begin(); it != values.end(); ++it)
         {
-            evaluation = std::move(node.mapped());
+            if (it != values.begin())
+            {
+                rtn += ',';
+            }
+
+            rtn += *it;
         }
-        else
+
+        std::format_to(std::back_inserter(rtn), "],{}]", done);
+
+        return rtn;
+    }
+
+    std::optional<std::string> result_cache::find(std::string_view key)
+    {
+        std::lock_guard lock{mutex};
+        auto it = lookup.find(key);
+
+        if (it == lookup.end())
         {
-            return;
+            return std::nullopt;
         }
 
-        evaluation(std::move(message));
+        entries.splice(entries.begin(), entries, it->second);
+
+        return it->second->second;
     }
 
-    void smartview_base::add_function(std::string name, function &&resolve)
+    void result_cache::insert(std::string key, std::string value)
     {
-        auto functions = m_impl->functions.write();
-        functions->emplace(std::move(name), std::make_shared<function>(std::move(resolve)));
+        std::lock_guard lock{mutex};
+
+        if (lookup.contains(key))
+        {
+            return;
+        }
+
+        entries.emplace_front(std::move(key), std::move(value));
+        lookup.emplace(entries.front().first, entries.begin());
+
+        while (entries.size() > capacity)
+        {
+            lookup.erase(entries.back().first);
+            entries.pop_back();
+        }
     }
 
-    void smartview_base::add_evaluation(resolver &&resolve, std::string_view code)
+    bool limiter::admit()
     {
-        auto id = m_impl->id_counter++;
+        // The bridge already enforces the interval, only half of it is checked here to tolerate jitter between page and native side
+        const auto now = clock::now();
+        std::lock_guard lock{mutex};
 
+        if (last.has_value() && now - *last < options.interval / 2)
         {
-            auto locked = m_impl->evaluations.write();
-            locked->emplace(id, std::move(resolve));
+            return false;
         }
 
-        webview::execute(std::format("window.saucer.internal.resolve({}, async () => {})", id, code));
+        last.emplace(now);
+
+        return true;
     }
 
-    void smartview_base::unexpose()
+    bool limiter::join(const std::string &key, std::size_t id)
     {
-        auto locked = m_impl->functions.write();
-        locked->clear();
+        std::lock_guard lock{mutex};
+
+        if (auto it = flights.find(key); it != flights.end())
+        {
+            it->second.emplace_back(id);
+            return true;
+        }
+
+        flights.emplace(key, std::vector<std::size_t>{});
+
+        return false;
     }
 
-    void smartview_base::unexpose(const std::string &name)
+    std::vector<std::size_t> limiter::land(const std::string &key)
     {
-        auto locked = m_impl->functions.write();
-        locked->erase(name);
+        std::lock_guard lock{mutex};
+        auto node = flights.extract(key);
+
+        if (node.empty())
+        {
+            return {};
+        }
+
+        return std::move(node.mapped());
+    }
+
+    bool semaphore::acquire(task &callback)
+    {
+        std::lock_guard lock{mutex};
+
+        if (running < limit)
+        {
+            running++;
+            return true;
+        }
+
+        waiting.emplace_back(std::move(callback));
+
+        return false;
+    }
+
+    std::optional<task> semaphore::release()
+    {
+        std::lock_guard lock{mutex};
+
+        // The slot is handed straight to the next waiting call, so the running count only drops once the queue is empty
+        if (waiting.empty())
+        {
+            running--;
+            return std::nullopt;
+        }
+
+        auto rtn = std::move(waiting.front());
+        waiting.pop_front();
+
+        return rtn;
+    }
+
+    permit::~permit()
+    {
+        release();
+    }
+
+    void permit::release()
+    {
+        if (released.exchange(true))
+        {
+            return;
+        }
+
+        auto next = slots->release();
+
+        if (!next.has_value())
+        {
+            return;
+        }
+
+        resume(std::move(*next));
+    }
+
+    utils::pool *registry::worker(std::size_t index, launch policy)
+    {
+        switch (policy)
+        {
+            using enum launch;
+
+        case sync:
+            return nullptr;
+
+        case pool:
+            return &utils::pool::shared();
+
+        case strand:
+        {
+            auto &dedicated = strands[index];
+
+            if (!dedicated)
+            {
+                dedicated = std::make_unique<utils::pool>(1);
+            }
+
+            return dedicated.get();
+        }
+        }
+
+        std::unreachable();
+    }
+
+    registry::exposed registry::find(const std::variant<std::size_t, std::string> &name) const
+    {
+        auto visitor = overload{
+            [this](std::size_t index) -> exposed
+            {
+                if (index >= functions.size())
+                {
+                    return nullptr;
+                }
+
+                return functions[index];
+            },
+            [this](const std::string &name) -> exposed
+            {
+                auto it = ids.find(std::string_view{name});
+
+                if (it == ids.end())
+                {
+                    return nullptr;
+                }
+
+                return functions[it->second];
+            },
+        };
+
+        return std::visit(visitor, name);
+    }
+
+    struct bridge_scripts
+    {
+        std::string serializer;
+        std::string bridge;
+    };
+
+    static const bridge_scripts &bridge(const serializer_core &serializer)
+    {
+        static std::mutex mutex;
+        static std::unordered_map<std::type_index, bridge_scripts> cache;
+
+        std::lock_guard lock{mutex};
+        auto [it, inserted] = cache.try_emplace(typeid(serializer));
+
+        if (inserted)
+        {
+            it->second = {
+                .serializer = serializer.script(),
+                .bridge     = std::format(scripts::bridge_script, serializer.js_serializer()),
+            };
+        }
+
+        return it->second;
+    }
+
+    smartview_base::smartview_base(webview &&base, std::unique_ptr<serializer_core> serializer)
+        : webview(std::move(base)), m_impl(std::make_unique<impl>())
+    {
+        m_impl->lease      = utils::lease{webview::m_impl.get()};
+        m_impl->serializer = std::move(serializer);
+
+        const auto no_frames = !webview::m_impl->frame_bridge;
+        const auto &builtin  = bridge(*m_impl->serializer);
+
+        inject({
+            .code      = builtin.serializer,
+            .run_at    = script::time::creation,
+            .no_frames = no_frames,
+            .lazy      = true,
+            .clearable = false,
+        });
+
+        inject({
+            .code      = builtin.bridge,
+            .run_at    = script::time::creation,
+            .no_frames = no_frames,
+            .lazy      = true,
+            .clearable = false,
+        });
+
+        on<event::dom_ready>({{.func = std::bind_front(&impl::on_dom_ready, m_impl.get()), .clearable = false}});
+        on<event::load>({{.func = std::bind_front(&impl::on_load, m_impl.get()), .clearable = false}});
+
+        auto handlers = [](auto *impl, auto rpc, auto buffers, auto files)
+        {
+            impl->on_rpc     = std::move(rpc);
+            impl->on_buffers = std::move(buffers);
+            impl->on_files   = std::move(files);
+        };
+
+        utils::invoke(handlers, webview::m_impl.get(), std::bind_front(&impl::on_message, m_impl.get()),
+                      std::bind_front(&impl::on_buffers, m_impl.get()), std::bind_front(&impl::on_files, m_impl.get()));
+    }
+
+    smartview_base::smartview_base(smartview_base &&) noexcept = default;
+
+    smartview_base::~smartview_base() = default;
+
+    coco::future<void> smartview_base::destroy()
+    {
+        if (!webview::m_impl)
+        {
+            return webview::destroy();
+        }
+
+        auto *const parent = webview::m_impl->parent;
+        auto rtn           = webview::destroy();
+
+        // Our state is referenced by the webview's handlers, so it is only released once they have been cleared
+        parent->dispatch([impl = std::move(m_impl)] {});
+
+        return rtn;
+    }
+
+    smartview_base::impl::~impl()
+    {
+        {
+            std::lock_guard guard{reaper.mutex};
+            reaper.stop = true;
+        }
+
+        reaper.condition.notify_one();
+
+        if (reaper.thread.joinable())
+        {
+            reaper.thread.join();
+        }
+
+        cancel(std::numeric_limits<std::size_t>::max());
+        close_channels();
+    }
+
+    status smartview_base::impl::on_message(std::string_view message)
+    {
+        static constexpr std::string_view batch_prefix      = "saucer:batch\n";
+        static constexpr std::string_view compressed_prefix = "saucer:compressed\n";
+
+        if (message.starts_with(batch_prefix))
+        {
+            return on_batch(message.substr(batch_prefix.size()));
+        }
+
+        if (message.starts_with(compressed_prefix))
+        {
+            return on_compressed(message.substr(compressed_prefix.size()));
+        }
+
+        if (auto state = recorder.load(std::memory_order_acquire); state)
+        {
+            const auto offset = std::chrono::duration_cast<std::chrono::nanoseconds>(trace_clock::now() - state->start);
+            state->callback({.offset = offset, .message = std::string{message}});
+        }
+
+        const auto start = stamp();
+        auto parsed      = serializer->parse(message);
+
+        overload visitor = {
+            [](std::monostate &)
+            {
+                //
+                return status::unhandled;
+            },
+            [this, start, message](std::unique_ptr<function_data> &parsed)
+            {
+                sample(parsed->id)(ipc_stage::parse, start);
+                call(std::move(parsed), message);
+                return status::handled;
+            },
+            [this, start](std::unique_ptr<result_data> &parsed)
+            {
+                sample(parsed->id)(ipc_stage::parse, start);
+                resolve(std::move(parsed));
+                return status::handled;
+            },
+        };
+
+        return std::visit(visitor, parsed);
+    }
+
+    status smartview_base::impl::on_batch(std::string_view batch)
+    {
+        auto rtn = status::unhandled;
+
+        for (auto part : batch | std::views::split('\n'))
+        {
+            if (on_message(std::string_view{part}) == status::handled)
+            {
+                rtn = status::handled;
+            }
+        }
+
+        return rtn;
+    }
+
+    status smartview_base::impl::on_compressed(std::string_view message)
+    {
+        auto state = compression.load(std::memory_order_acquire);
+
+        if (!state)
+        {
+            return status::unhandled;
+        }
+
+        auto decoded  = unbase64(message);
+        auto inflated = decoded.has_value() ? state->options.decompress(*decoded) : std::nullopt;
+
+        if (!inflated.has_value())
+        {
+            return status::unhandled;
+        }
+
+        return on_message(*inflated);
+    }
+
+    status smartview_base::impl::on_buffers(std::string_view message, std::vector<stash> buffers)
+    {
+        const auto start = stamp();
+        auto parsed      = serializer->parse(message);
+        auto *data       = std::get_if<std::unique_ptr<function_data>>(&parsed);
+
+        if (!data)
+        {
+            return status::unhandled;
+        }
+
+        sample((*data)->id)(ipc_stage::parse, start);
+
+        (*data)->buffers = std::move(buffers);
+        call(std::move(*data));
+
+        return status::handled;
+    }
+
+    status smartview_base::impl::on_files(std::string_view message, std::vector<fs::path> files)
+    {
+        const auto start = stamp();
+        auto parsed      = serializer->parse(message);
+        auto *data       = std::get_if<std::unique_ptr<function_data>>(&parsed);
+
+        if (!data)
+        {
+            return status::unhandled;
+        }
+
+        sample((*data)->id)(ipc_stage::parse, start);
+
+        (*data)->files = std::move(files);
+        call(std::move(*data));
+
+        return status::handled;
+    }
+
+    void smartview_base::impl::call(std::unique_ptr<function_data> message, std::string_view raw)
+    {
+        auto function = functions.read()->find(message->name);
+
+        if (const auto *name = std::get_if<std::string>(&message->name); !function && name && control(*name, message->id))
+        {
+            return;
+        }
+
+        auto token = claim(message->id);
+
+        const auto attached = !message->buffers.empty() || !message->files.empty();
+
+        if (!function)
+        {
+            auto handler = fallback.load(std::memory_order_acquire);
+
+            // Only the serialized message is handed on, calls whose buffers or files would be lost on the way are refused instead
+            if (handler && (attached || raw.empty()))
+            {
+                return lease.value()->reject(message->id, "\"Calls with attachments cannot be forwarded\"");
+            }
+
+            if (handler)
+            {
+                auto executor  = marshal(sample(message->id), trace_clock::now(), priority::normal);
+                executor.token = std::move(token);
+
+                return (*handler)(raw, std::move(executor));
+            }
+
+            auto visitor = overload{
+                [](std::size_t index) { return std::format("\"No exposed function with id {}\"", index); },
+                [](const std::string &name) { return std::format("\"No exposed function '{}'\"", name); },
+            };
+
+            return lease.value()->reject(message->id, std::visit(visitor, message->name));
+        }
+
+        utils::metrics::get().calls.fetch_add(1, std::memory_order_relaxed);
+
+        // Buffers and files are not part of the serialized params, calls that carry them always reach the handler
+        auto key            = function->cache && !attached ? std::string{message->raw()} : std::string{};
+
+        if (auto hit = key.empty() ? std::nullopt : function->cache->find(key); hit.has_value())
+        {
+            return lease.value()->resolve(message->id, std::move(*hit));
+        }
+
+        const auto &gate    = function->limit;
+        const auto coalesce = gate && gate->options.mode == limit::coalesce;
+
+        if (gate && !coalesce && !gate->admit())
+        {
+            return lease.value()->reject(message->id, "\"Rate limited\"");
+        }
+
+        // Abortable calls never lead a flight, a cancelled leader would leave its followers hanging
+        auto flight = coalesce && !token && !attached ? std::string{message->raw()} : std::string{};
+
+        if (!flight.empty() && gate->join(flight, message->id))
+        {
+            return;
+        }
+
+        const auto start = trace_clock::now();
+        auto context     = sample(message->id);
+
+        // Interactive results skip the batch window, background calls yield to everything else queued on the main thread
+        const auto urgent = function->priority == priority::interactive;
+
+        if (!function->worker)
+        {
+            auto settle = [context, start, urgent](auto method)
+            {
+                return [context, start, urgent, method](auto *self, std::string value)
+                {
+                    utils::metrics::get().observe(trace_clock::now() - start);
+                    context(ipc_stage::handler, start);
+
+                    const auto begin = stamp();
+                    (self->*method)(context.id, std::move(value));
+
+                    if (urgent)
+                    {
+                        self->flush();
+                    }
+
+                    context(ipc_stage::resolve, begin);
+                };
+            };
+
+            auto executor = serializer_core::executor{
+                utils::defer(lease, settle(&webview::impl::resolve)),
+                utils::defer(lease, settle(&webview::impl::reject)),
+                std::move(token),
+            };
+
+            if (!key.empty())
+            {
+                memoize(executor, function->cache, std::move(key));
+            }
+
+            if (!flight.empty())
+            {
+                share(executor, gate, std::move(flight));
+            }
+
+            if (!function->slots && function->priority != priority::background)
+            {
+                return function->callback(std::move(message), std::move(executor));
+            }
+
+            message->own();
+
+            if (function->slots)
+            {
+                occupy(executor, function);
+            }
+
+            task deferred = [function, executor = std::move(executor), message = std::move(message)]() mutable
+            {
+                function->callback(std::move(message), std::move(executor));
+            };
+
+            if (function->slots && !function->slots->acquire(deferred))
+            {
+                return;
+            }
+
+            if (function->priority != priority::background)
+            {
+                return deferred();
+            }
+
+            return lease.value()->parent->post(std::move(deferred), priority::background);
+        }
+
+        message->own();
+
+        auto executor  = marshal(context, start, function->priority);
+        executor.token = std::move(token);
+
+        if (!key.empty())
+        {
+            memoize(executor, function->cache, std::move(key));
+        }
+
+        if (!flight.empty())
+        {
+            share(executor, gate, std::move(flight));
+        }
+
+        if (function->slots)
+        {
+            occupy(executor, function);
+        }
+
+        auto work = [function, context, start, executor = std::move(executor), message = std::move(message)]() mutable
+        {
+            context(ipc_stage::queue, start);
+            function->callback(std::move(message), std::move(executor));
+        };
+
+        task submit = [function, work = std::move(work)]() mutable
+        {
+            function->worker->submit(std::move(work), std::to_underlying(function->priority));
+        };
+
+        if (function->slots && !function->slots->acquire(submit))
+        {
+            return;
+        }
+
+        submit();
+    }
+
+    void smartview_base::impl::memoize(serializer_core::executor &exec, std::shared_ptr<result_cache> cache, std::string key)
+    {
+        auto resolve = [cache = std::move(cache), key = std::move(key), resolve = std::move(exec.resolve)](std::string value)
+        {
+            cache->insert(key, value);
+            resolve(std::move(value));
+        };
+
+        exec.resolve = std::move(resolve);
+    }
+
+    void smartview_base::impl::share(serializer_core::executor &exec, std::shared_ptr<limiter> limit, std::string flight)
+    {
+        auto relay = utils::defer(lease,
+                                  [](webview::impl *self, const std::vector<std::size_t> &ids, bool resolved, const std::string &value)
+                                  {
+                                      for (const auto id : ids)
+                                      {
+                                          resolved ? self->resolve(id, value) : self->reject(id, value);
+                                      }
+                                  });
+
+        auto wrap = [limit = std::move(limit), flight = std::move(flight), relay](auto callback, bool resolved)
+        {
+            return [limit, flight, relay, resolved, callback = std::move(callback)](std::string value) mutable
+            {
+                if (auto ids = limit->land(flight); !ids.empty())
+                {
+                    relay(ids, resolved, value);
+                }
+
+                callback(std::move(value));
+            };
+        };
+
+        exec.resolve = wrap(std::move(exec.resolve), true);
+        exec.reject  = wrap(std::move(exec.reject), false);
+    }
+
+    void smartview_base::impl::occupy(serializer_core::executor &exec, const exposed &function)
+    {
+        auto *parent = lease.value()->parent;
+
+        // Calls that waited for a slot are resumed from wherever the previous one settled
+        auto resume = [parent, function](task next) mutable
+        {
+            if (function->worker)
+            {
+                return next();
+            }
+
+            parent->post(std::move(next), function->priority);
+        };
+
+        // Executors that are dropped without ever settling still give their slot back
+        auto slot = std::make_shared<permit>(function->slots, std::move(resume));
+
+        auto wrap = [slot](auto callback)
+        {
+            return [slot, callback = std::move(callback)](std::string value) mutable
+            {
+                callback(std::move(value));
+                slot->release();
+            };
+        };
+
+        exec.resolve = wrap(std::move(exec.resolve));
+        exec.reject  = wrap(std::move(exec.reject));
+    }
+
+    trace_context smartview_base::impl::sample(std::size_t id) const
+    {
+#ifdef SAUCER_IPC_TRACING
+        auto current = tracer.load(std::memory_order_acquire);
+
+        if (!current || id % sample_rate.load(std::memory_order_relaxed) != 0)
+        {
+            return {.tracer = nullptr, .id = id};
+        }
+
+        return {.tracer = std::move(current), .id = id};
+#else
+        return {.tracer = nullptr, .id = id};
+#endif
+    }
+
+    serializer_core::executor smartview_base::impl::marshal(trace_context context, trace_clock::time_point start, priority level)
+    {
+        auto post = [parent = lease.value()->parent, rental = lease.rent(), context = std::move(context), start, level](auto method)
+        {
+            return [parent, rental, context, start, level, method](std::string value)
+            {
+                utils::metrics::get().observe(trace_clock::now() - start);
+                context(ipc_stage::handler, start);
+
+                auto callback = [rental, context, level, method, posted = stamp(), value = std::move(value)]() mutable
+                {
+                    context(ipc_stage::marshal, posted);
+
+                    auto locked = rental.access();
+
+                    if (auto *const self = locked.value(); self)
+                    {
+                        const auto begin = stamp();
+                        ((*self)->*method)(context.id, std::move(value));
+
+                        if (level == priority::interactive)
+                        {
+                            (*self)->flush();
+                        }
+
+                        context(ipc_stage::resolve, begin);
+                    }
+                };
+
+                parent->post(std::move(callback), level);
+            };
+        };
+
+        return {post(&webview::impl::resolve), post(&webview::impl::reject)};
+    }
+
+    void smartview_base::impl::resolve(std::unique_ptr<result_data> message)
+    {
+        auto evaluation = evaluations.write()->extract(message->id);
+
+        if (!evaluation.has_value())
+        {
+            return;
+        }
+
+        const auto start = stamp();
+        auto context     = sample(message->id);
+
+        (*evaluation)(std::move(message));
+
+        context(ipc_stage::evaluation, start);
+    }
+
+    void smartview_base::impl::on_dom_ready()
+    {
+        live = true;
+        cancel(++generation);
+    }
+
+    void smartview_base::impl::on_load(const state &current)
+    {
+        if (current != state::started)
+        {
+            return;
+        }
+
+        live = false;
+        close_channels();
+
+        if (auto state = compression.load(std::memory_order_acquire); state)
+        {
+            state->negotiated = false;
+        }
+
+        auto locked = topics->write();
+
+        locked->subscribed.clear();
+        locked->batched.clear();
+    }
+
+    void smartview_base::impl::close_channels()
+    {
+        auto open = std::exchange(channels->write()->open, {});
+
+        for (const auto &[_, state] : open)
+        {
+            std::ignore = state->cancel();
+        }
+    }
+
+    bool smartview_base::impl::abort(std::string_view name, std::size_t id)
+    {
+        static constexpr std::string_view abortable_prefix = "saucer:abortable:";
+        static constexpr std::string_view abort_prefix     = "saucer:abort:";
+
+        const auto abortable = name.starts_with(abortable_prefix);
+
+        if (!abortable && !name.starts_with(abort_prefix))
+        {
+            return false;
+        }
+
+        name.remove_prefix(abortable ? abortable_prefix.size() : abort_prefix.size());
+
+        std::size_t key{};
+
+        if (auto [_, ec] = std::from_chars(name.data(), name.data() + name.size(), key); ec != std::errc{})
+        {
+            return false;
+        }
+
+        {
+            auto locked = cancellations.write();
+
+            if (abortable)
+            {
+                // Calls that settled without being aborted leave expired entries behind, which are pruned whenever a new call is armed
+                std::erase_if(locked->inflight, [](const auto &entry) { return entry.second.expired(); });
+
+                locked->armed.emplace(key);
+                armed.fetch_add(1, std::memory_order_relaxed);
+            }
+            else if (auto it = locked->inflight.find(key); it != locked->inflight.end())
+            {
+                if (auto token = it->second.lock(); token)
+                {
+                    token->store(true, std::memory_order_relaxed);
+                }
+
+                locked->inflight.erase(it);
+            }
+        }
+
+        lease.value()->resolve(id, "null");
+        return true;
+    }
+
+    cancellation_table::token smartview_base::impl::claim(std::size_t id)
+    {
+        if (armed.load(std::memory_order_relaxed) == 0)
+        {
+            return nullptr;
+        }
+
+        auto locked = cancellations.write();
+
+        if (!locked->armed.erase(id))
+        {
+            return nullptr;
+        }
+
+        armed.fetch_sub(1, std::memory_order_relaxed);
+
+        auto rtn = std::make_shared<std::atomic_bool>(false);
+        locked->inflight.emplace(id, rtn);
+
+        return rtn;
+    }
+
+    bool smartview_base::impl::control(std::string_view name, std::size_t id)
+    {
+        static constexpr std::string_view pull_prefix   = "saucer:pull:";
+        static constexpr std::string_view cancel_prefix = "saucer:cancel:";
+
+        static constexpr std::string_view subscribe_prefix   = "saucer:subscribe:";
+        static constexpr std::string_view unsubscribe_prefix = "saucer:unsubscribe:";
+
+        if (abort(name, id))
+        {
+            return true;
+        }
+
+        // The page only asks for compressed replies once it knows it can inflate them
+        if (name == "saucer:compression")
+        {
+            if (auto state = compression.load(std::memory_order_acquire); state)
+            {
+                state->negotiated = true;
+            }
+
+            lease.value()->resolve(id, "null");
+            return true;
+        }
+
+        if (name.starts_with(subscribe_prefix) || name.starts_with(unsubscribe_prefix))
+        {
+            const auto subscribe = name.starts_with(subscribe_prefix);
+            const auto topic     = name.substr(subscribe ? subscribe_prefix.size() : unsubscribe_prefix.size());
+
+            {
+                auto locked = topics->write();
+
+                if (subscribe)
+                {
+                    locked->subscribed.emplace(topic);
+                }
+                else if (auto it = locked->subscribed.find(topic); it != locked->subscribed.end())
+                {
+                    locked->subscribed.erase(it);
+                }
+            }
+
+            lease.value()->resolve(id, "null");
+            return true;
+        }
+
+        const auto pull = name.starts_with(pull_prefix);
+
+        if (!pull && !name.starts_with(cancel_prefix))
+        {
+            return false;
+        }
+
+        name.remove_prefix(pull ? pull_prefix.size() : cancel_prefix.size());
+
+        std::size_t key{};
+
+        if (auto [_, ec] = std::from_chars(name.data(), name.data() + name.size(), key); ec != std::errc{})
+        {
+            return false;
+        }
+
+        auto executor = serializer_core::executor{
+            utils::defer(lease, [id](webview::impl *self, std::string value) { self->resolve(id, std::move(value)); }),
+            utils::defer(lease, [id](webview::impl *self, std::string value) { self->reject(id, std::move(value)); }),
+        };
+
+        auto state = [&]() -> channel_table::channel
+        {
+            auto locked = channels->read();
+            auto it     = locked->open.find(key);
+
+            if (it == locked->open.end())
+            {
+                return nullptr;
+            }
+
+            return it->second;
+        }();
+
+        if (!pull)
+        {
+            if (state)
+            {
+                channels->write()->open.erase(key);
+            }
+
+            if (auto waiting = state ? state->cancel() : std::nullopt; waiting.has_value())
+            {
+                waiting->resolve(channel_state::batch({}, true));
+            }
+
+            executor.resolve("null");
+            return true;
+        }
+
+        if (!state)
+        {
+            executor.reject(R"("Channel is closed")");
+            return true;
+        }
+
+        if (state->pull(std::move(executor)))
+        {
+            channels->write()->open.erase(key);
+        }
+
+        return true;
+    }
+
+    void smartview_base::impl::reap()
+    {
+        utils::apply(utils::thread_role::helper);
+        std::unique_lock guard{reaper.mutex};
+
+        while (!reaper.stop)
+        {
+            std::vector<resolver> expired;
+            std::optional<evaluation::clock::time_point> next;
+
+            {
+                auto locked    = evaluations.write();
+                const auto now = evaluation::clock::now();
+
+                auto &deadlines = locked->deadlines;
+
+                while (!deadlines.empty() && deadlines.begin()->first <= now)
+                {
+                    auto node = locked->pending.extract(deadlines.begin()->second);
+                    deadlines.erase(deadlines.begin());
+
+                    if (node)
+                    {
+                        utils::metrics::get().evaluations.fetch_sub(1, std::memory_order_relaxed);
+                        expired.emplace_back(std::move(node.mapped().resolve));
+                    }
+                }
+
+                if (!deadlines.empty())
+                {
+                    next.emplace(deadlines.begin()->first);
+                }
+            }
+
+            if (!expired.empty())
+            {
+                guard.unlock();
+
+                for (auto &callback : expired)
+                {
+                    callback(nullptr);
+                }
+
+                guard.lock();
+                continue;
+            }
+
+            if (!next.has_value())
+            {
+                reaper.condition.wait(guard);
+                continue;
+            }
+
+            reaper.condition.wait_until(guard, *next);
+        }
+    }
+
+    void smartview_base::impl::wake()
+    {
+        {
+            std::lock_guard guard{reaper.mutex};
+        }
+
+        reaper.condition.notify_one();
+    }
+
+    void smartview_base::impl::cancel(std::size_t generation)
+    {
+        std::vector<resolver> cancelled;
+
+        {
+            auto locked = evaluations.write();
+
+            for (auto it = locked->pending.begin(); it != locked->pending.end();)
+            {
+                auto &entry = it->second;
+
+                if (entry.generation >= generation)
+                {
+                    ++it;
+                    continue;
+                }
+
+                if (entry.deadline.has_value())
+                {
+                    locked->deadlines.erase(*entry.deadline);
+                }
+
+                cancelled.emplace_back(std::move(entry.resolve));
+                it = locked->pending.erase(it);
+
+                utils::metrics::get().evaluations.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+
+        for (auto &callback : cancelled)
+        {
+            callback(nullptr);
+        }
+    }
+
+    std::string smartview_base::impl::quote(std::string_view value)
+    {
+        std::string rtn{'"'};
+        rtn.reserve(value.size() + 2);
+
+        for (const auto ch : value)
+        {
+            if (ch == '"' || ch == '\\')
+            {
+                rtn += '\\';
+            }
+
+            if (static_cast<unsigned char>(ch) < 0x20)
+            {
+                std::format_to(std::back_inserter(rtn), "\\u{:04x}", static_cast<unsigned char>(ch));
+                continue;
+            }
+
+            rtn += ch;
+        }
+
+        rtn += '"';
+
+        return rtn;
+    }
+
+    std::string smartview_base::impl::base64(std::string_view value)
+    {
+        static constexpr std::string_view alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+        std::string rtn;
+        rtn.reserve(((value.size() + 2) / 3) * 4);
+
+        for (auto i = 0uz; value.size() > i; i += 3)
+        {
+            const auto remaining = value.size() - i;
+            auto chunk           = static_cast<std::uint32_t>(static_cast<unsigned char>(value[i])) << 16;
+
+            if (remaining > 1)
+            {
+                chunk |= static_cast<std::uint32_t>(static_cast<unsigned char>(value[i + 1])) << 8;
+            }
+
+            if (remaining > 2)
+            {
+                chunk |= static_cast<unsigned char>(value[i + 2]);
+            }
+
+            rtn += alphabet[(chunk >> 18) & 0x3F];
+            rtn += alphabet[(chunk >> 12) & 0x3F];
+            rtn += remaining > 1 ? alphabet[(chunk >> 6) & 0x3F] : '=';
+            rtn += remaining > 2 ? alphabet[chunk & 0x3F] : '=';
+        }
+
+        return rtn;
+    }
+
+    std::optional<std::string> smartview_base::impl::unbase64(std::string_view value)
+    {
+        static constexpr auto lookup = []
+        {
+            std::array<std::int8_t, 256> rtn{};
+            rtn.fill(-1);
+
+            for (auto i = 0; i < 64; i++)
+            {
+                rtn["ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"[i]] = static_cast<std::int8_t>(i);
+            }
+
+            return rtn;
+        }();
+
+        while (value.ends_with('='))
+        {
+            value.remove_suffix(1);
+        }
+
+        std::string rtn;
+        rtn.reserve((value.size() * 3) / 4);
+
+        std::uint32_t buffer{0};
+        auto bits = 0;
+
+        for (const auto ch : value)
+        {
+            const auto digit = lookup[static_cast<unsigned char>(ch)];
+
+            if (digit < 0)
+            {
+                return std::nullopt;
+            }
+
+            buffer = (buffer << 6) | static_cast<std::uint32_t>(digit);
+            bits += 6;
+
+            if (bits < 8)
+            {
+                continue;
+            }
+
+            bits -= 8;
+            rtn += static_cast<char>((buffer >> bits) & 0xFF);
+        }
+
+        return rtn;
+    }
+
+    trace_clock::time_point smartview_base::impl::stamp()
+    {
+#ifdef SAUCER_IPC_TRACING
+        return trace_clock::now();
+#else
+        return {};
+#endif
+    }
+
+    std::pair<std::size_t, serializer_core::channel> smartview_base::impl::open(const std::shared_ptr<lock<channel_table>> &channels)
+    {
+        auto state = std::make_shared<channel_state>();
+        auto id    = std::size_t{};
+
+        {
+            auto locked = channels->write();
+            id          = locked->id_counter++;
+
+            locked->open.emplace(id, state);
+        }
+
+        auto guard = std::shared_ptr<void>{nullptr, [state](void *) { state->finish(std::nullopt); }};
+
+        auto push = [state, guard](std::string value)
+        {
+            return state->push(std::move(value));
+        };
+
+        auto reject = [state, guard](std::string reason)
+        {
+            state->finish(std::move(reason));
+        };
+
+        auto close = [state, guard]
+        {
+            state->finish(std::nullopt);
+        };
+
+        return {id, {std::move(push), std::move(reject), std::move(close)}};
+    }
+
+    void smartview_base::add_function(std::string name, function &&resolve, launch policy, priority level, std::size_t cache,
+                                      std::optional<rate_limit> limit, std::size_t parallel)
+    {
+        std::optional<std::size_t> defined;
+        std::optional<std::size_t> previous;
+
+        {
+            auto locked = m_impl->functions.write();
+            auto it     = locked->ids.find(std::string_view{name});
+
+            if (it == locked->ids.end())
+            {
+                it = locked->ids.emplace(name, locked->functions.size()).first;
+                locked->functions.emplace_back();
+            }
+
+            if (auto &slot = locked->functions[it->second]; !slot)
+            {
+                slot = std::make_shared<exposed_function>(std::move(resolve), locked->worker(it->second, policy), level);
+
+                if (cache > 0)
+                {
+                    slot->cache = std::make_shared<result_cache>(cache);
+                }
+
+                if (limit.has_value())
+                {
+                    slot->limit = std::make_shared<limiter>(*limit);
+                }
+
+                if (parallel > 0)
+                {
+                    slot->slots = std::make_shared<semaphore>(parallel);
+                }
+
+                defined.emplace(it->second);
+            }
+
+            if (auto stub = locked->stubs.find(it->second); defined.has_value() && stub != locked->stubs.end())
+            {
+                previous.emplace(stub->second);
+            }
+        }
+
+        if (!defined.has_value())
+        {
+            return;
+        }
+
+        static constexpr auto modes = std::array{"throttle", "debounce", "coalesce"};
+
+        auto options = std::string{"null"};
+
+        if (limit.has_value())
+        {
+            options = std::format(R"({{ mode: "{}", interval: {} }})", modes[std::to_underlying(limit->mode)], limit->interval.count());
+        }
+
+        // Every exposed name gets its own stub on `saucer.exposed`, which spares hot calls the proxy trap and the argument checks
+        auto code = std::format("window.saucer.internal.define({}, {}, {});", impl::quote(name), *defined, options);
+        webview::execute(code);
+
+        if (previous.has_value())
+        {
+            uninject(*previous);
+        }
+
+        const auto stub = inject({.code = std::move(code), .run_at = script::time::creation, .clearable = false});
+        m_impl->functions.write()->stubs.insert_or_assign(*defined, stub);
+    }
+
+    void smartview_base::add_producer(std::string name, serializer_core::producer &&produce, launch policy, priority level)
+    {
+        auto callback = [channels = m_impl->channels, produce = std::move(produce)](std::unique_ptr<function_data> data,
+                                                                                      serializer_core::executor exec) mutable
+        {
+            auto [id, output] = impl::open(channels);
+
+            exec.resolve(std::format("window.saucer.internal.stream({})", id));
+            produce(std::move(data), std::move(output));
+        };
+
+        add_function(std::move(name), std::move(callback), policy, level);
+    }
+
+    void smartview_base::add_emission(std::string_view topic, std::string value)
+    {
+        {
+            auto locked          = m_impl->topics->write();
+            const auto scheduled = !locked->batched.empty();
+
+            locked->batched.append("[").append(impl::quote(topic)).append(",").append(value).append("],");
+
+            if (scheduled)
+            {
+                return;
+            }
+        }
+
+        auto flush = [topics = m_impl->topics, rental = m_impl->lease.rent()]
+        {
+            auto batch = std::exchange(topics->write()->batched, {});
+
+            if (batch.empty())
+            {
+                return;
+            }
+
+            auto locked = rental.access();
+
+            if (auto *const self = locked.value(); self)
+            {
+                (*self)->execute(std::format("window.saucer.internal.emit([{}]);", batch));
+            }
+        };
+
+        auto rental = m_impl->lease.rent();
+        auto locked = rental.access();
+
+        if (auto *const self = locked.value(); self)
+        {
+            (*self)->parent->post(std::move(flush));
+        }
+    }
+
+    std::optional<std::size_t> smartview_base::impl::track(resolver &&resolve)
+    {
+        const auto id      = id_counter++;
+        const auto current = live ? generation.load() : generation + 1;
+
+        std::optional<resolver> rejected;
+        auto timed = false;
+
+        {
+            auto locked = evaluations.write();
+
+            if (locked->limit.has_value() && locked->pending.size() >= *locked->limit)
+            {
+                rejected.emplace(std::move(resolve));
+            }
+            else
+            {
+                auto [it, _] = locked->pending.emplace(id, evaluation{.resolve = std::move(resolve), .generation = current});
+                auto &entry  = it->second;
+
+                utils::metrics::get().evaluations.fetch_add(1, std::memory_order_relaxed);
+
+                if (locked->timeout.has_value())
+                {
+                    entry.deadline = locked->deadlines.emplace(evaluation::clock::now() + *locked->timeout, id);
+                    timed          = true;
+                }
+            }
+        }
+
+        if (rejected.has_value())
+        {
+            (*rejected)(nullptr);
+            return std::nullopt;
+        }
+
+        if (timed)
+        {
+            wake();
+        }
+
+        return id;
+    }
+
+    std::optional<std::size_t> smartview_base::track_evaluation(resolver &&resolve)
+    {
+        return m_impl->track(std::move(resolve));
+    }
+
+    void smartview_base::add_invocation(resolver &&resolve, prepared function, std::string_view args)
+    {
+        const auto id = m_impl->track(std::move(resolve));
+
+        if (!id.has_value())
+        {
+            return;
+        }
+
+        webview::execute(std::format("window.saucer.internal.invoke({}, {}, [{}])", *id, function.id, args));
+    }
+
+    prepared smartview_base::prepare(std::string_view function)
+    {
+        const auto id   = m_impl->prepare_counter++;
+        const auto code = std::format("window.saucer.internal.prepared.set({}, {});", id, function);
+
+        // The permanent script re-registers the function after every navigation, the execute covers the current page
+        const auto injected = webview::inject({.code = code, .run_at = script::time::creation, .clearable = false});
+        webview::execute(code);
+
+        return {.id = id, .script = injected};
+    }
+
+    void smartview_base::unprepare(prepared function)
+    {
+        webview::uninject(function.script);
+        webview::execute(std::format("window.saucer.internal.prepared.delete({});", function.id));
+    }
+
+    void smartview_base::add_state(std::string value)
+    {
+        const auto code = std::format("window.saucer.state = {};", value);
+
+        // The payload rides along with the bridge, so every new document has it before any of its own scripts run
+        const auto injected = inject({
+            .code      = code,
+            .run_at    = script::time::creation,
+            .no_frames = !webview::m_impl->frame_bridge,
+            .lazy      = true,
+            .clearable = false,
+        });
+
+        webview::execute(code);
+
+        if (auto previous = std::exchange(*m_impl->state.write(), injected); previous.has_value())
+        {
+            uninject(*previous);
+        }
+    }
+
+    void smartview_base::clear_state()
+    {
+        auto previous = std::exchange(*m_impl->state.write(), std::nullopt);
+
+        if (!previous.has_value())
+        {
+            return;
+        }
+
+        uninject(*previous);
+        webview::execute("delete window.saucer.state;");
+    }
+
+    bool smartview_base::subscribed(std::string_view topic) const
+    {
+        return m_impl->topics->read()->subscribed.contains(topic);
+    }
+
+    void smartview_base::patch(const dom_patch &patch)
+    {
+        if (patch.empty())
+        {
+            return;
+        }
+
+        auto serialized = std::format("[{},[", impl::quote(patch.target()));
+
+        for (const auto &[type, index, count, name, value] : patch.operations())
+        {
+            std::format_to(std::back_inserter(serialized), "[{},{},{},{},{}],", std::to_underlying(type), index, count, impl::quote(name),
+                           value.transform(impl::quote).value_or("null"));
+        }
+
+        serialized.back() = ']';
+        serialized.append("],");
+
+        {
+            auto locked          = m_impl->patches->write();
+            const auto scheduled = !locked->empty();
+
+            locked->append(serialized);
+
+            if (scheduled)
+            {
+                return;
+            }
+        }
+
+        // Patches queued within one turn of the event loop cross the bridge together, the page applies them on its next frame
+        auto flush = [patches = m_impl->patches, rental = m_impl->lease.rent()]
+        {
+            auto batch = std::exchange(*patches->write(), {});
+
+            if (batch.empty())
+            {
+                return;
+            }
+
+            batch.pop_back();
+
+            auto locked = rental.access();
+
+            if (auto *const self = locked.value(); self)
+            {
+                (*self)->execute(std::format("window.saucer.internal.patch([{}]);", batch));
+            }
+        };
+
+        auto rental = m_impl->lease.rent();
+        auto locked = rental.access();
+
+        if (auto *const self = locked.value(); self)
+        {
+            (*self)->parent->post(std::move(flush));
+        }
+    }
+
+    void smartview_base::share(const shared_buffer &buffer, std::string_view topic)
+    {
+        if (!subscribed(topic))
+        {
+            return;
+        }
+
+        utils::invoke<&webview::impl::share>(webview::m_impl.get(), buffer, impl::quote(topic));
+    }
+
+    std::size_t smartview_base::pending_evaluations() const
+    {
+        return m_impl->evaluations.read()->pending.size();
+    }
+
+    void smartview_base::set_evaluation_limit(std::optional<std::size_t> limit)
+    {
+        m_impl->evaluations.write()->limit = limit;
+    }
+
+    void smartview_base::set_evaluation_timeout(std::optional<std::chrono::milliseconds> timeout)
+    {
+        m_impl->evaluations.write()->timeout = timeout;
+
+        if (!timeout.has_value())
+        {
+            return;
+        }
+
+        std::call_once(m_impl->reaper.started, [self = m_impl.get()] { self->reaper.thread = std::thread{&impl::reap, self}; });
+    }
+
+    void smartview_base::cancel_evaluations()
+    {
+        m_impl->cancel(std::numeric_limits<std::size_t>::max());
+    }
+
+    void smartview_base::set_ipc_tracer(ipc_tracer tracer, std::size_t sample_rate)
+    {
+        m_impl->sample_rate.store(std::max<std::size_t>(sample_rate, 1), std::memory_order_relaxed);
+
+        if (!tracer)
+        {
+            m_impl->tracer.store(nullptr, std::memory_order_release);
+            return;
+        }
+
+        m_impl->tracer.store(std::make_shared<const ipc_tracer>(std::move(tracer)), std::memory_order_release);
+    }
+
+    void smartview_base::set_ipc_recorder(ipc_recorder recorder)
+    {
+        if (!recorder)
+        {
+            m_impl->recorder.store(nullptr, std::memory_order_release);
+            return;
+        }
+
+        auto state = std::make_shared<const recorder_state>(std::move(recorder), trace_clock::now());
+        m_impl->recorder.store(std::move(state), std::memory_order_release);
+    }
+
+    void smartview_base::set_ipc_fallback(ipc_fallback fallback)
+    {
+        if (!fallback)
+        {
+            m_impl->fallback.store(nullptr, std::memory_order_release);
+            return;
+        }
+
+        m_impl->fallback.store(std::make_shared<const ipc_fallback>(std::move(fallback)), std::memory_order_release);
+    }
+
+    void smartview_base::set_compression(std::optional<ipc_compression> options)
+    {
+        std::shared_ptr<compression_state> state;
+
+        if (options.has_value() && options->compress && options->decompress)
+        {
+            state = std::make_shared<compression_state>(std::move(*options));
+        }
+
+        m_impl->compression.store(state, std::memory_order_release);
+
+        auto compress = [state](std::string_view value) -> std::optional<std::string>
+        {
+            if (!state->negotiated || value.size() < state->options.threshold)
+            {
+                return std::nullopt;
+            }
+
+            // Payloads that do not shrink are sent as they are, the bridge would only pay for inflating them
+            if (auto packed = impl::base64(state->options.compress(value)); packed.size() < value.size())
+            {
+                return packed;
+            }
+
+            return std::nullopt;
+        };
+
+        auto install = [&state, &compress](webview::impl *self)
+        {
+            self->compress = state ? std::move(compress) : decltype(self->compress){};
+        };
+
+        utils::invoke(install, webview::m_impl.get());
+
+        const auto threshold = state ? std::to_string(state->options.threshold) : std::string{"null"};
+        const auto code      = std::format("window.saucer.internal.compress({});", threshold);
+
+        std::optional<std::size_t> injected;
+
+        if (state)
+        {
+            injected.emplace(inject({
+                .code      = code,
+                .run_at    = script::time::creation,
+                .no_frames = !webview::m_impl->frame_bridge,
+                .lazy      = true,
+                .clearable = false,
+            }));
+        }
+
+        webview::execute(code);
+
+        if (auto previous = std::exchange(*m_impl->compression_script.write(), injected); previous.has_value())
+        {
+            uninject(*previous);
+        }
+    }
+
+    void smartview_base::unexpose()
+    {
+        std::string code;
+        std::vector<std::size_t> stubs;
+
+        {
+            auto locked = m_impl->functions.write();
+
+            for (const auto &name : locked->ids | std::views::keys)
+            {
+                code += std::format("window.saucer.internal.undefine({});", impl::quote(name));
+            }
+
+            std::ranges::fill(locked->functions, nullptr);
+            std::ranges::copy(locked->stubs | std::views::values, std::back_inserter(stubs));
+
+            locked->stubs.clear();
+        }
+
+        // Otherwise the stubs would come back with the next navigation
+        for (const auto &stub : stubs)
+        {
+            uninject(stub);
+        }
+
+        if (code.empty())
+        {
+            return;
+        }
+
+        webview::execute(code);
+    }
+
+    void smartview_base::unexpose(const std::string &name)
+    {
+        std::optional<std::size_t> previous;
+
+        {
+            auto locked = m_impl->functions.write();
+            auto it     = locked->ids.find(std::string_view{name});
+
+            if (it == locked->ids.end())
+            {
+                return;
+            }
+
+            locked->functions[it->second] = nullptr;
+
+            if (auto stub = locked->stubs.find(it->second); stub != locked->stubs.end())
+            {
+                previous.emplace(stub->second);
+                locked->stubs.erase(stub);
+            }
+        }
+
+        if (previous.has_value())
+        {
+            uninject(*previous);
+        }
+
+        webview::execute(std::format("window.saucer.internal.undefine({});", impl::quote(name)));
     }
 } // namespace saucer
@@ -0,0 +1,188 @@
+#include <saucer/stash/stash.hpp>
+
+#include "error.impl.hpp"
+
+#include <system_error>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace saucer
+{
+    namespace detail
+    {
+        struct mapping;
+    }
+
+    struct detail::mapping
+    {
+        const std::uint8_t *data{nullptr};
+        std::size_t size{0};
+
+#ifdef _WIN32
+      public:
+        HANDLE file{INVALID_HANDLE_VALUE};
+        HANDLE view{nullptr};
+#endif
+
+      public:
+        mapping() = default;
+
+      public:
+        mapping(const mapping &) = delete;
+        mapping &operator=(const mapping &) = delete;
+
+      public:
+        ~mapping();
+
+      public:
+        static result<std::shared_ptr<mapping>> open(const std::filesystem::path &);
+    };
+
+    static std::error_code last_error()
+    {
+#ifdef _WIN32
+        return {static_cast<int>(GetLastError()), std::system_category()};
+#else
+        return {errno, std::generic_category()};
+#endif
+    }
+
+#ifdef _WIN32
+    detail::mapping::~mapping()
+    {
+        if (data)
+        {
+            UnmapViewOfFile(data);
+        }
+
+        if (view)
+        {
+            CloseHandle(view);
+        }
+
+        if (file != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(file);
+        }
+    }
+
+    result<std::shared_ptr<detail::mapping>> detail::mapping::open(const std::filesystem::path &path)
+    {
+        auto rtn = std::make_shared<mapping>();
+
+        rtn->file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (rtn->file == INVALID_HANDLE_VALUE)
+        {
+            return err(last_error());
+        }
+
+        LARGE_INTEGER size{};
+
+        if (!GetFileSizeEx(rtn->file, &size))
+        {
+            return err(last_error());
+        }
+
+        if (size.QuadPart == 0)
+        {
+            return rtn;
+        }
+
+        rtn->view = CreateFileMappingW(rtn->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if (!rtn->view)
+        {
+            return err(last_error());
+        }
+
+        rtn->data = static_cast<const std::uint8_t *>(MapViewOfFile(rtn->view, FILE_MAP_READ, 0, 0, 0));
+
+        if (!rtn->data)
+        {
+            return err(last_error());
+        }
+
+        rtn->size = static_cast<std::size_t>(size.QuadPart);
+
+        return rtn;
+    }
+#else
+    detail::mapping::~mapping()
+    {
+        if (!data)
+        {
+            return;
+        }
+
+        munmap(const_cast<std::uint8_t *>(data), size);
+    }
+
+    result<std::shared_ptr<detail::mapping>> detail::mapping::open(const std::filesystem::path &path)
+    {
+        const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+        if (fd < 0)
+        {
+            return err(last_error());
+        }
+
+        struct stat info{};
+
+        if (fstat(fd, &info) != 0)
+        {
+            const auto error = last_error();
+            close(fd);
+            return err(error);
+        }
+
+        auto rtn = std::make_shared<mapping>();
+
+        if (info.st_size == 0)
+        {
+            close(fd);
+            return rtn;
+        }
+
+        auto *const data = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        const auto error = last_error();
+
+        close(fd);
+
+        if (data == MAP_FAILED)
+        {
+            return err(error);
+        }
+
+        rtn->data = static_cast<const std::uint8_t *>(data);
+        rtn->size = static_cast<std::size_t>(info.st_size);
+
+        return rtn;
+    }
+#endif
+
+    template <>
+    result<stash> stash::map(const std::filesystem::path &path)
+    {
+        auto mapped = detail::mapping::open(path);
+
+        if (!mapped.has_value())
+        {
+            return err(mapped);
+        }
+
+        auto view = [file = std::move(mapped.value())]
+        {
+            return stash::view({file->data, file->size});
+        };
+
+        return stash::lazy(std::move(view));
+    }
+} // namespace saucer
@@ -0,0 +1,98 @@
+#include <saucer/stash/pool.hpp>
+
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+namespace saucer
+{
+    struct stash_pool::impl
+    {
+        using buffer = std::vector<std::uint8_t>;
+
+      public:
+        std::size_t capacity;
+
+      public:
+        std::mutex mutex;
+        std::vector<buffer> free;
+
+      public:
+        buffer acquire(std::size_t);
+        void release(buffer);
+    };
+
+    stash_pool::impl::buffer stash_pool::impl::acquire(std::size_t size)
+    {
+        std::lock_guard lock{mutex};
+
+        auto fits = [size](const auto &item)
+        {
+            return item.capacity() >= size;
+        };
+
+        auto it = std::ranges::find_if(free, fits);
+
+        if (it == free.end())
+        {
+            return buffer(size);
+        }
+
+        auto rtn = std::move(*it);
+        free.erase(it);
+
+        rtn.resize(size);
+
+        return rtn;
+    }
+
+    void stash_pool::impl::release(buffer data)
+    {
+        std::lock_guard lock{mutex};
+
+        if (free.size() >= capacity || data.capacity() == 0)
+        {
+            return;
+        }
+
+        data.clear();
+        free.emplace_back(std::move(data));
+    }
+
+    stash_pool::stash_pool(std::size_t capacity) : m_impl(std::make_shared<impl>(capacity)) {}
+
+    stash stash_pool::make(std::size_t size, const writer &write)
+    {
+        auto recycle = [state = std::weak_ptr{m_impl}](impl::buffer *data)
+        {
+            if (auto locked = state.lock(); locked)
+            {
+                locked->release(std::move(*data));
+            }
+
+            delete data;
+        };
+
+        auto holder     = std::shared_ptr<impl::buffer>{new impl::buffer{m_impl->acquire(size)}, std::move(recycle)};
+        const auto used = std::min(write(*holder), holder->size());
+
+        return stash::shared({holder, holder->data()}, used);
+    }
+
+    stash stash_pool::copy(std::span<const std::uint8_t> data)
+    {
+        auto write = [data](std::span<std::uint8_t> buffer)
+        {
+            std::ranges::copy(data, buffer.begin());
+            return data.size();
+        };
+
+        return make(data.size(), write);
+    }
+
+    std::size_t stash_pool::cached() const
+    {
+        std::lock_guard lock{m_impl->mutex};
+        return m_impl->free.size();
+    }
+} // namespace saucer
@@ -0,0 +1,130 @@
+#include "threads.hpp"
+
+#include <array>
+#include <mutex>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#include <pthread/qos.h>
+#else
+#include <sched.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/resource.h>
+#endif
+
+namespace saucer::utils
+{
+    namespace
+    {
+        struct thread_registry
+        {
+            std::mutex mutex;
+            thread_options workers;
+            thread_options helpers;
+        };
+
+        thread_registry &registry()
+        {
+            static thread_registry instance;
+            return instance;
+        }
+    } // namespace
+
+    void configure(thread_options workers, thread_options helpers)
+    {
+        auto &state = registry();
+        std::lock_guard lock{state.mutex};
+
+        state.workers = std::move(workers);
+        state.helpers = std::move(helpers);
+    }
+
+    thread_options thread_config(thread_role role)
+    {
+        auto &state = registry();
+        std::lock_guard lock{state.mutex};
+
+        return role == thread_role::worker ? state.workers : state.helpers;
+    }
+
+#ifdef _WIN32
+    void apply(thread_role role)
+    {
+        static constexpr auto priorities = std::array{
+            THREAD_PRIORITY_LOWEST,
+            THREAD_PRIORITY_BELOW_NORMAL,
+            THREAD_PRIORITY_NORMAL,
+            THREAD_PRIORITY_ABOVE_NORMAL,
+        };
+
+        const auto config  = thread_config(role);
+        auto *const thread = GetCurrentThread();
+
+        if (config.affinity.has_value())
+        {
+            SetThreadAffinityMask(thread, static_cast<DWORD_PTR>(*config.affinity));
+        }
+
+        if (!config.priority.has_value())
+        {
+            return;
+        }
+
+        SetThreadPriority(thread, priorities[std::to_underlying(*config.priority)]);
+    }
+#elif defined(__APPLE__)
+    void apply(thread_role role)
+    {
+        static constexpr auto classes = std::array{
+            QOS_CLASS_BACKGROUND,
+            QOS_CLASS_UTILITY,
+            QOS_CLASS_DEFAULT,
+            QOS_CLASS_USER_INITIATED,
+        };
+
+        const auto config = thread_config(role);
+
+        if (!config.priority.has_value())
+        {
+            return;
+        }
+
+        pthread_set_qos_class_self_np(classes[std::to_underlying(*config.priority)], 0);
+    }
+#else
+    void apply(thread_role role)
+    {
+        static constexpr auto nice = std::array{19, 10, 0, -5};
+
+        const auto config = thread_config(role);
+
+        if (config.affinity.has_value())
+        {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+
+            for (auto cpu = 0uz; 64 > cpu; cpu++)
+            {
+                if ((*config.affinity >> cpu) & 1)
+                {
+                    CPU_SET(cpu, &set);
+                }
+            }
+
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        }
+
+        if (!config.priority.has_value())
+        {
+            return;
+        }
+
+        // Nice values apply per thread on Linux, raising above normal needs `CAP_SYS_NICE` and is silently refused otherwise
+        setpriority(PRIO_PROCESS, static_cast<id_t>(gettid()), nice[std::to_underlying(*config.priority)]);
+    }
+#endif
+} // namespace saucer::utils
@@ -0,0 +1,178 @@
+#include "url_view.hpp"
+
+#include <cctype>
+#include <charconv>
+#include <algorithm>
+
+namespace saucer
+{
+    static url_view::component slice(std::string_view buffer, std::size_t begin, std::size_t end)
+    {
+        return {.offset = begin, .size = std::min(end, buffer.size()) - begin, .present = true};
+    }
+
+    std::string_view url_view::get(const component &part) const
+    {
+        return std::string_view{m_buffer}.substr(part.offset, part.size);
+    }
+
+    std::optional<std::string_view> url_view::find(const component &part) const
+    {
+        if (!part.present)
+        {
+            return std::nullopt;
+        }
+
+        return get(part);
+    }
+
+    std::string_view url_view::string() const
+    {
+        return m_buffer;
+    }
+
+    std::string_view url_view::path() const
+    {
+        return get(m_path);
+    }
+
+    std::string_view url_view::scheme() const
+    {
+        return get(m_scheme);
+    }
+
+    std::optional<std::string_view> url_view::host() const
+    {
+        return find(m_host);
+    }
+
+    std::optional<std::size_t> url_view::port() const
+    {
+        return m_port;
+    }
+
+    std::optional<std::string_view> url_view::user() const
+    {
+        return find(m_user);
+    }
+
+    std::optional<std::string_view> url_view::password() const
+    {
+        return find(m_password);
+    }
+
+    std::optional<std::string_view> url_view::query() const
+    {
+        return find(m_query);
+    }
+
+    std::optional<std::string_view> url_view::fragment() const
+    {
+        return find(m_fragment);
+    }
+
+    bool url_view::operator==(std::string_view other) const
+    {
+        return m_buffer == other;
+    }
+
+    result<url_view> url_view::parse(std::string input)
+    {
+        auto rtn          = url_view{};
+        rtn.m_buffer      = std::move(input);
+        const auto buffer = std::string_view{rtn.m_buffer};
+
+        const auto colon = buffer.find(':');
+
+        if (colon == 0 || colon == std::string_view::npos || !std::isalpha(static_cast<unsigned char>(buffer.front())))
+        {
+            return err(std::errc::invalid_argument);
+        }
+
+        auto valid = [](unsigned char c)
+        {
+            return std::isalnum(c) || c == '+' || c == '-' || c == '.';
+        };
+
+        if (!std::ranges::all_of(buffer.substr(0, colon), valid))
+        {
+            return err(std::errc::invalid_argument);
+        }
+
+        rtn.m_scheme = slice(buffer, 0, colon);
+
+        auto position = colon + 1;
+
+        if (buffer.substr(position).starts_with("//"))
+        {
+            const auto begin = position + 2;
+            const auto end   = std::min(buffer.find_first_of("/?#", begin), buffer.size());
+
+            auto host = begin;
+
+            if (const auto at = buffer.substr(begin, end - begin).rfind('@'); at != std::string_view::npos)
+            {
+                const auto info  = buffer.substr(begin, at);
+                const auto split = info.find(':');
+
+                rtn.m_user = slice(buffer, begin, split == std::string_view::npos ? begin + at : begin + split);
+
+                if (split != std::string_view::npos)
+                {
+                    rtn.m_password = slice(buffer, begin + split + 1, begin + at);
+                }
+
+                host = begin + at + 1;
+            }
+
+            auto port = buffer.substr(host, end - host).rfind(':');
+
+            if (buffer.substr(host, end - host).starts_with('[') && buffer.substr(host, end - host).rfind(']') > port)
+            {
+                port = std::string_view::npos;
+            }
+
+            rtn.m_host = slice(buffer, host, port == std::string_view::npos ? end : host + port);
+
+            if (port != std::string_view::npos && host + port + 1 < end)
+            {
+                const auto digits = buffer.substr(host + port + 1, end - (host + port + 1));
+
+                std::size_t value{};
+                const auto [ptr, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), value);
+
+                if (ec != std::errc{} || ptr != digits.data() + digits.size())
+                {
+                    return err(std::errc::invalid_argument);
+                }
+
+                rtn.m_port = value;
+            }
+
+            position = end;
+        }
+
+        const auto path_end = std::min(buffer.find_first_of("?#", position), buffer.size());
+        rtn.m_path          = slice(buffer, position, path_end);
+        position            = path_end;
+
+        if (position < buffer.size() && buffer[position] == '?')
+        {
+            const auto end = std::min(buffer.find('#', position), buffer.size());
+            rtn.m_query    = slice(buffer, position + 1, end);
+            position       = end;
+        }
+
+        if (position < buffer.size() && buffer[position] == '#')
+        {
+            rtn.m_fragment = slice(buffer, position + 1, buffer.size());
+        }
+
+        return rtn;
+    }
+
+    result<url_view> url_view::parse(const url &value)
+    {
+        return parse(value.string());
+    }
+} // namespace saucer
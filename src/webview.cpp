@@ -1,12 +1,25 @@
 #include "webview.impl.hpp"
 
 #include "invoke.hpp"
+#include "scripts.hpp"
+#include "dispatch.hpp"
 #include "instantiate.hpp"
 
+#include "app.impl.hpp"
 #include "error.impl.hpp"
 #include "window.impl.hpp"
+#include "metrics.impl.hpp"
+#include "asset_store.impl.hpp"
+#include "shared_buffer.impl.hpp"
 
 #include <format>
+#include <ranges>
+#include <random>
+#include <cctype>
+#include <limits>
+#include <cstdint>
+#include <charconv>
+#include <iterator>
 #include <algorithm>
 #include <functional>
 
@@ -23,6 +36,11 @@ namespace saucer
 
     result<webview> webview::create(const options &opts)
     {
+        if (opts.headless)
+        {
+            return create(impl::headless(opts));
+        }
+
         auto window = opts.window.value();
 
         if (!window)
@@ -37,102 +55,1311 @@ namespace saucer
             return parent->invoke(&webview::create, opts);
         }
 
+        auto *const app_impl = parent->native<false>();
+        const auto start     = trace_clock::now();
+
         if (static auto once{true}; once)
         {
-            register_scheme("saucer");
-            once = false;
+            register_scheme("saucer");
+            app_impl->record(startup_phase::register_scheme, start);
+            once = false;
+        }
+
+        auto rtn         = webview{parent};
+        auto *const impl = rtn.m_impl.get();
+
+        impl->window        = opts.window.value();
+        impl->parent        = parent;
+        impl->attributes    = opts.attributes;
+        impl->batch_window  = opts.batch_window;
+        impl->cache_control = opts.cache_control;
+        impl->frame_bridge  = opts.frame_bridge;
+        impl->bridge_token  = impl::make_token();
+        impl->lease         = utils::lease{impl};
+
+        if (opts.cache_permissions || opts.permission_store.has_value())
+        {
+            impl->permissions = std::make_shared<utils::permission_cache>(opts.permission_store);
+        }
+
+        window->native<false>()->offscreen = opts.offscreen;
+
+        if (auto status = impl->init_platform(opts); !status.has_value())
+        {
+            return err(status);
+        }
+
+        impl->handle_scheme("saucer", impl::instrument(std::bind_front(&impl::handle_embed, impl)));
+
+        const auto no_frames = !opts.frame_bridge;
+
+        rtn.inject({
+            .code      = impl::creation_script(),
+            .run_at    = script::time::creation,
+            .no_frames = no_frames,
+            .lazy      = true,
+            .clearable = false,
+        });
+
+        rtn.inject({
+            .code      = std::format("window.saucer.internal.token = \"{}\";", impl->bridge_token),
+            .run_at    = script::time::creation,
+            .no_frames = no_frames,
+            .lazy      = true,
+            .clearable = false,
+        });
+
+        rtn.inject({.code = impl::ready_script(), .run_at = script::time::ready, .clearable = false});
+
+        if (opts.collect_timing)
+        {
+            rtn.inject({
+                .code      = std::string{scripts::timing_script},
+                .run_at    = script::time::creation,
+                .clearable = false,
+            });
+        }
+
+        if (opts.structured_messages)
+        {
+            rtn.inject({
+                .code      = "window.saucer.internal.structured = true;",
+                .run_at    = script::time::creation,
+                .no_frames = no_frames,
+                .lazy      = true,
+                .clearable = false,
+            });
+        }
+
+        auto on_memory = [impl](memory_pressure pressure)
+        {
+            impl->set_memory_target(pressure == memory_pressure::normal ? memory_target::normal : memory_target::low);
+        };
+
+        impl->on_memory = parent->on<application::event::memory>({{.func = on_memory, .clearable = false}});
+
+        if (opts.suspend_when_minimized)
+        {
+            auto suspend = [impl](bool minimized)
+            {
+                impl->set_suspended(minimized);
+            };
+
+            impl->on_minimize = impl->window->on<window::event::minimize>({{.func = suspend, .clearable = false}});
+        }
+
+        if (opts.attributes)
+        {
+            rtn.inject({.code = impl::attribute_script(), .run_at = script::time::creation, .clearable = false});
+        }
+
+        if (opts.attributes)
+        {
+            auto mirror = [impl](bool)
+            {
+                impl->mirror();
+            };
+
+            impl->mirrored = {
+                {window::event::maximize, impl->window->on<window::event::maximize>({{.func = mirror, .clearable = false}})},
+                {window::event::minimize, impl->window->on<window::event::minimize>({{.func = mirror, .clearable = false}})},
+                {window::event::focus, impl->window->on<window::event::focus>({{.func = mirror, .clearable = false}})},
+            };
+
+            rtn.on<event::dom_ready>({{.func = [impl] { impl->mirror(); }, .clearable = false}});
+        }
+
+        if (opts.attributes && impl->regions)
+        {
+            rtn.inject({.code = impl::region_script(), .run_at = script::time::creation, .clearable = false});
+        }
+
+        app_impl->record(startup_phase::webview, start);
+
+        if (!app_impl->trace)
+        {
+            return rtn;
+        }
+
+        auto loaded = [app_impl, start, done = false](const state &value) mutable
+        {
+            if (done || value != state::finished)
+            {
+                return;
+            }
+
+            app_impl->record(startup_phase::first_load, start);
+            done = true;
+        };
+
+        auto ready = [app_impl, start, done = false]() mutable
+        {
+            if (done)
+            {
+                return;
+            }
+
+            app_impl->record(startup_phase::first_dom_ready, start);
+            done = true;
+        };
+
+        rtn.on<event::load>({{.func = std::move(loaded), .clearable = false}});
+        rtn.on<event::dom_ready>({{.func = std::move(ready), .clearable = false}});
+
+        return rtn;
+    }
+
+    coco::future<result<webview>> webview::create_async(const options &opts)
+    {
+        auto promise = coco::promise<result<webview>>{};
+        auto rtn     = promise.get_future();
+
+        auto window = opts.window.value();
+
+        if (!window)
+        {
+            promise.set_value(err(contract_error::required_invalid));
+            return rtn;
+        }
+
+        auto task = [opts, promise = std::move(promise)]() mutable
+        {
+            promise.set_value(create(opts));
+        };
+
+        // Queued even when already on the UI thread, creating the engine is costly and other work should be able to run in-between
+        window->parent().post(std::move(task));
+
+        return rtn;
+    }
+
+    void impl::unsubscribe()
+    {
+        events.clear(true);
+
+        if (on_minimize.has_value())
+        {
+            window->off(window::event::minimize, *on_minimize);
+        }
+
+        if (on_memory.has_value())
+        {
+            parent->off(application::event::memory, *on_memory);
+        }
+
+        for (const auto &[event, id] : mirrored)
+        {
+            window->off(event, id);
+        }
+
+        for (const auto &[name, entry] : std::exchange(surfaces, {}))
+        {
+            remove_surface(entry.handle);
+        }
+    }
+
+    void impl::process_gone(termination reason, bool recoverable)
+    {
+        if (events.get<event::process_gone>().fire(reason).find(policy::block) || !recoverable)
+        {
+            return;
+        }
+
+        // Injected scripts live in the content manager or controller, which survive the process, so a reload restores the page
+        reload();
+    }
+
+    void impl::title_changed()
+    {
+        if (std::exchange(title_pending, true))
+        {
+            return;
+        }
+
+        auto fire = [](impl *self)
+        {
+            self->title_pending = false;
+
+            if (auto title = self->page_title(); title != self->last_title)
+            {
+                self->last_title = std::move(title);
+                self->events.get<event::title>().fire(self->last_title);
+            }
+        };
+
+        // Pages that rewrite their title per route change (or timer tick) only report the title that settled within a frame
+        parent->schedule(title_interval, utils::defer(lease, fire));
+    }
+
+    webview::~webview()
+    {
+        utils::invoke<&impl::unsubscribe>(m_impl.get());
+    }
+
+    coco::future<void> webview::destroy()
+    {
+        auto promise = coco::promise<void>{};
+        auto rtn     = promise.get_future();
+
+        if (!m_impl)
+        {
+            promise.set_value();
+            return rtn;
+        }
+
+        auto *const parent = m_impl->parent;
+
+        auto task = [impl = std::move(m_impl), promise = std::move(promise)]() mutable
+        {
+            impl->unsubscribe();
+            impl.reset();
+            promise.set_value();
+        };
+
+        parent->dispatch(std::move(task));
+
+        return rtn;
+    }
+
+    template <webview::event Event>
+    void webview::setup()
+    {
+        return utils::invoke<&impl::setup<Event>>(m_impl.get());
+    }
+
+    static std::string_view trim(std::string_view value)
+    {
+        const auto begin = value.find_first_not_of(" \t");
+
+        if (begin == std::string_view::npos)
+        {
+            return {};
+        }
+
+        return value.substr(begin, value.find_last_not_of(" \t") - begin + 1);
+    }
+
+    static bool accepts(std::string_view header, std::string_view coding)
+    {
+        std::optional<bool> wildcard;
+
+        for (const auto &part : header | std::views::split(','))
+        {
+            const auto token = std::string_view{part.data(), part.size()};
+            const auto split = std::min(token.find(';'), token.size());
+
+            const auto name   = trim(token.substr(0, split));
+            const auto params = token.substr(split);
+
+            const auto quality  = params.find("q=");
+            const auto value    = quality == std::string_view::npos ? std::string_view{} : trim(params.substr(quality + 2));
+            const auto rejected = !value.empty() && value.find_first_not_of("0.") == std::string_view::npos;
+
+            if (name == coding)
+            {
+                return !rejected;
+            }
+
+            if (name == "*")
+            {
+                wildcard = !rejected;
+            }
+        }
+
+        return wildcard.value_or(false);
+    }
+
+    std::string webview::impl::etag(const stash &content)
+    {
+        std::uint64_t hash{14695981039346656037ull};
+
+        for (const auto byte : std::span{content.data(), content.size()})
+        {
+            hash ^= byte;
+            hash *= 1099511628211ull;
+        }
+
+        return std::format("{:016x}-{:x}", hash, content.size());
+    }
+
+    const stash *webview::impl::compressed(const embedded_file &file)
+    {
+        if (!file.decoder || file.content.size() > 0)
+        {
+            return nullptr;
+        }
+
+        if (file.brotli)
+        {
+            return &file.brotli.value();
+        }
+
+        if (file.gzip)
+        {
+            return &file.gzip.value();
+        }
+
+        return nullptr;
+    }
+
+    static bool matches(std::string_view header, std::string_view tag)
+    {
+        for (const auto &part : header | std::views::split(','))
+        {
+            auto token = trim(std::string_view{part.data(), part.size()});
+
+            if (token.starts_with("W/"))
+            {
+                token.remove_prefix(2);
+            }
+
+            if (token == "*" || token == tag)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    static std::string mime_type(const fs::path &file)
+    {
+        static const std::unordered_map<std::string, std::string> types = {
+            {".html", "text/html"},
+            {".htm", "text/html"},
+            {".css", "text/css"},
+            {".js", "text/javascript"},
+            {".mjs", "text/javascript"},
+            {".json", "application/json"},
+            {".wasm", "application/wasm"},
+            {".svg", "image/svg+xml"},
+            {".png", "image/png"},
+            {".jpg", "image/jpeg"},
+            {".jpeg", "image/jpeg"},
+            {".gif", "image/gif"},
+            {".webp", "image/webp"},
+            {".ico", "image/x-icon"},
+            {".woff", "font/woff"},
+            {".woff2", "font/woff2"},
+            {".ttf", "font/ttf"},
+            {".mp3", "audio/mpeg"},
+            {".mp4", "video/mp4"},
+            {".webm", "video/webm"},
+            {".txt", "text/plain"},
+        };
+
+        auto extension = file.extension().string();
+        std::ranges::transform(extension, extension.begin(), [](unsigned char c) { return std::tolower(c); });
+
+        if (!types.contains(extension))
+        {
+            return "application/octet-stream";
+        }
+
+        return types.at(extension);
+    }
+
+    static std::string preload_links(const std::vector<std::string> &paths)
+    {
+        std::string rtn;
+
+        for (const auto &path : paths)
+        {
+            const auto mime = mime_type(path);
+            auto target     = std::string_view{"fetch"};
+            auto cors       = false;
+
+            if (mime == "text/javascript")
+            {
+                target = "script";
+            }
+            else if (mime == "text/css")
+            {
+                target = "style";
+            }
+            else if (mime.starts_with("font/"))
+            {
+                target = "font";
+                cors   = true;
+            }
+            else if (mime.starts_with("image/"))
+            {
+                target = "image";
+            }
+            else
+            {
+                cors = true;
+            }
+
+            const auto link = fs::path{path}.lexically_normal().generic_string();
+            rtn += std::format("{}<{}>; rel=preload; as={}{}", rtn.empty() ? "" : ", ", link, target, cors ? "; crossorigin" : "");
+        }
+
+        return rtn;
+    }
+
+    static bool matches(const navigation_rule &rule, const url_view &url)
+    {
+        if (rule.scheme && url.scheme() != *rule.scheme)
+        {
+            return false;
+        }
+
+        if (rule.prefix && !url.string().starts_with(*rule.prefix))
+        {
+            return false;
+        }
+
+        if (!rule.host)
+        {
+            return true;
+        }
+
+        const auto host = url.host().value_or("");
+
+        if (!rule.host->starts_with("*."))
+        {
+            return host == *rule.host;
+        }
+
+        const auto suffix = std::string_view{*rule.host}.substr(1);
+        return host.size() > suffix.size() && host.ends_with(suffix);
+    }
+
+    std::optional<policy> webview::impl::decide(const navigation &nav) const
+    {
+        if (rules.empty())
+        {
+            return std::nullopt;
+        }
+
+        const auto url = url_view::parse(nav.url());
+
+        if (!url.has_value())
+        {
+            return std::nullopt;
+        }
+
+        for (const auto &rule : rules)
+        {
+            if (!matches(rule, *url))
+            {
+                continue;
+            }
+
+            return rule.action;
+        }
+
+        return std::nullopt;
+    }
+
+    bool webview::impl::blocked(const navigation &nav)
+    {
+        if (const auto decision = decide(nav); decision.has_value())
+        {
+            return decision == policy::block;
+        }
+
+        return static_cast<bool>(events.get<event::navigate>().fire(nav).find(policy::block));
+    }
+
+    void webview::impl::handle_embed(const scheme::request &request, const scheme::executor &exec)
+    {
+        const auto &[resolve, reject] = exec;
+        const auto url                = request.url();
+
+        if (url.scheme() == "saucer" && url.host() == "message")
+        {
+            return handle_buffers(request, exec);
+        }
+
+        if (url.scheme() == "saucer" && url.host() == "buffer")
+        {
+            return handle_shared(request, exec);
+        }
+
+        if (url.scheme() == "saucer" && url.host() == "channel")
+        {
+            return handle_channel(request, exec);
+        }
+
+        if (url.scheme() == "saucer" && url.host() == "document")
+        {
+            return handle_document(request, exec);
+        }
+
+        if (url.scheme() != "saucer" || url.host() != "embedded")
+        {
+            return reject(scheme::error::invalid);
+        }
+
+        const auto file   = url.path().generic_string();
+        const auto *entry = find(file);
+        auto mounted      = std::shared_ptr<const embedded_entry>{};
+
+        if (!entry)
+        {
+            mounted = lookup(file);
+            entry   = mounted.get();
+        }
+
+        if (!entry)
+        {
+            entry = unpack(file);
+        }
+
+        if (!entry)
+        {
+            entry = load(file);
+        }
+
+        if (!entry)
+        {
+            return reject(scheme::error::not_found);
+        }
+
+        const auto &data     = entry->file;
+        const auto encodings = scheme::header(request, "accept-encoding").value_or("");
+        const auto mime      = mime_type(file) == "application/wasm" ? std::string{"application/wasm"} : data.mime;
+
+        auto headers = scheme::header_list{{"Access-Control-Allow-Origin", "*"}};
+
+        if (!cache_control.empty())
+        {
+            headers.emplace("Cache-Control", cache_control);
+        }
+
+        if (data.brotli || data.gzip)
+        {
+            headers.emplace("Vary", "Accept-Encoding");
+        }
+
+        if (!data.preload.empty())
+        {
+            headers.emplace("Link", preload_links(data.preload));
+        }
+
+        const auto *body = &data.content;
+        auto encoding    = std::string_view{};
+        auto decoded     = stash::empty();
+
+        if (data.brotli && accepts(encodings, "br"))
+        {
+            body     = &data.brotli.value();
+            encoding = "br";
+        }
+        else if (data.gzip && accepts(encodings, "gzip"))
+        {
+            body     = &data.gzip.value();
+            encoding = "gzip";
+        }
+        else if (const auto *source = compressed(data); source)
+        {
+            decoded = data.decoder->get(*source, data.brotli ? "br" : "gzip");
+            body    = &decoded;
+        }
+
+        if (!encoding.empty())
+        {
+            headers.emplace("Content-Encoding", encoding);
+        }
+
+        if (!entry->etag.empty())
+        {
+            const auto tag = encoding.empty() ? std::format("\"{}\"", entry->etag) : std::format("\"{}-{}\"", entry->etag, encoding);
+            headers.emplace("ETag", tag);
+
+            if (matches(scheme::header(request, "if-none-match").value_or(""), tag))
+            {
+                return resolve({.data = stash::empty(), .mime = mime, .headers = std::move(headers), .status = 304});
+            }
+        }
+
+        return resolve(scheme::serve(request, *body, mime, std::move(headers)));
+    }
+
+    const impl::embedded_entry *webview::impl::find(std::string_view file) const
+    {
+        const auto it = embedded.find(file);
+
+        if (it == embedded.end())
+        {
+            return nullptr;
+        }
+
+        return &it->second;
+    }
+
+    std::shared_ptr<const impl::embedded_entry> webview::impl::lookup(std::string_view file) const
+    {
+        for (const auto &store : stores | std::views::reverse)
+        {
+            if (auto rtn = store.native()->find(file); rtn)
+            {
+                return rtn;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void webview::impl::erase(std::string_view file)
+    {
+        const auto it = embedded.find(file);
+
+        if (it == embedded.end())
+        {
+            return;
+        }
+
+        embedded.erase(it);
+    }
+
+    void webview::impl::merge(std::vector<embedded_entry> entries)
+    {
+        // Range requests slice the served stash, sharing owned files spares them a copy of the whole file
+        auto share = [](stash &value)
+        {
+            value = std::move(value).share();
+        };
+
+        for (auto &entry : entries)
+        {
+            auto path  = entry.path;
+            auto &file = entry.file;
+
+            share(file.content);
+
+            if (file.brotli)
+            {
+                share(*file.brotli);
+            }
+
+            if (file.gzip)
+            {
+                share(*file.gzip);
+            }
+
+            embedded.insert_or_assign(std::move(path), std::move(entry));
+        }
+    }
+
+    void webview::impl::retag(std::string_view file, const stash &content, std::string tag)
+    {
+        const auto it = embedded.find(file);
+
+        if (it == embedded.end() || it->second.file.content.data() != content.data())
+        {
+            return;
+        }
+
+        it->second.etag = std::move(tag);
+    }
+
+    const impl::embedded_entry *webview::impl::unpack(std::string_view file)
+    {
+        for (const auto &[blob, files] : bundles)
+        {
+            const auto it = std::ranges::lower_bound(files, file, {}, &bundled_file::path);
+
+            if (it == files.end() || it->path != file || it->offset > blob.size() || it->size > blob.size() - it->offset)
+            {
+                continue;
+            }
+
+            const auto content = stash::view(blob.subspan(it->offset, it->size));
+
+            auto entry = embedded_entry{
+                .path = std::string{file},
+                .file = {.content = content, .mime = std::string{it->mime}},
+                .etag = it->hash.empty() ? etag(content) : std::string{it->hash},
+            };
+
+            return &embedded.insert_or_assign(std::string{file}, std::move(entry)).first->second;
+        }
+
+        return nullptr;
+    }
+
+    const impl::embedded_entry *webview::impl::load(std::string_view file)
+    {
+        if (!directory.has_value())
+        {
+            return nullptr;
+        }
+
+        std::error_code ec{};
+        const auto path = fs::weakly_canonical(*directory / fs::path{file}.relative_path(), ec);
+
+        if (ec || std::mismatch(directory->begin(), directory->end(), path.begin(), path.end()).first != directory->end())
+        {
+            return nullptr;
+        }
+
+        if (!fs::is_regular_file(path, ec))
+        {
+            return nullptr;
+        }
+
+        auto content = stash::map(path);
+
+        if (!content.has_value())
+        {
+            return nullptr;
+        }
+
+        auto variant = [&path](const char *extension) -> std::optional<stash>
+        {
+            auto sibling = path;
+            sibling += extension;
+
+            std::error_code ec{};
+
+            if (!fs::is_regular_file(sibling, ec))
+            {
+                return std::nullopt;
+            }
+
+            auto mapped = stash::map(sibling);
+
+            if (!mapped.has_value())
+            {
+                return std::nullopt;
+            }
+
+            return std::move(mapped.value());
+        };
+
+        const auto modified = fs::last_write_time(path, ec).time_since_epoch().count();
+        auto entry = embedded_entry{
+            .path = std::string{file},
+            .file =
+                {
+                    .content = std::move(content.value()),
+                    .mime    = mime_type(path),
+                    .brotli  = variant(".br"),
+                    .gzip    = variant(".gz"),
+                },
+            .etag = std::format("{:x}-{:x}", fs::file_size(path, ec), modified),
+        };
+
+        return &embedded.insert_or_assign(std::string{file}, std::move(entry)).first->second;
+    }
+
+    scheme::resolver webview::impl::offload(const std::string &name, scheme::resolver handler, launch policy)
+    {
+        utils::pool *worker{};
+
+        switch (policy)
+        {
+            using enum launch;
+
+        case sync:
+            return handler;
+
+        case pool:
+            worker = &utils::pool::shared();
+            break;
+
+        case strand:
+        {
+            auto &dedicated = strands[name];
+
+            if (!dedicated)
+            {
+                dedicated = std::make_unique<utils::pool>(1);
+            }
+
+            worker = dedicated.get();
+            break;
+        }
+        }
+
+        // The native executor is only ever called and released on the main thread, the worker merely holds on to it
+        auto marshal = [parent = parent](scheme::executor executor)
+        {
+            auto release = [parent](scheme::executor *value)
+            {
+                parent->post([value] { delete value; });
+            };
+
+            auto token = executor.token;
+            auto state = std::shared_ptr<scheme::executor>{new scheme::executor{std::move(executor)}, release};
+
+            auto resolve = [parent, state](scheme::response response)
+            {
+                parent->post([state, response = std::move(response)]() mutable { state->resolve(std::move(response)); });
+            };
+
+            auto reject = [parent, state](scheme::error error)
+            {
+                parent->post([state, error] { state->reject(error); });
+            };
+
+            return scheme::executor{.resolve = std::move(resolve), .reject = std::move(reject), .token = std::move(token)};
+        };
+
+        auto resolver = std::make_shared<scheme::resolver>(std::move(handler));
+
+        return [worker, marshal, resolver](scheme::request request, scheme::executor executor)
+        {
+            auto task = [resolver, request = std::move(request), executor = marshal(std::move(executor))]() mutable
+            {
+                (*resolver)(std::move(request), std::move(executor));
+            };
+
+            worker->submit(std::move(task));
+        };
+    }
+
+    scheme::resolver webview::impl::instrument(scheme::resolver handler)
+    {
+        return [handler = std::move(handler)](scheme::request request, scheme::executor executor)
+        {
+            auto &metrics = utils::metrics::get();
+            metrics.scheme_requests.fetch_add(1, std::memory_order_relaxed);
+
+            auto &[resolve, reject] = executor;
+
+            auto counted = [&metrics, resolve = std::move(resolve)](scheme::response response)
+            {
+                metrics.scheme_bytes.fetch_add(response.data.size(), std::memory_order_relaxed);
+                resolve(std::move(response));
+            };
+
+            handler(std::move(request), {std::move(counted), std::move(reject)});
+        };
+    }
+
+    std::string webview::impl::make_token()
+    {
+        auto device = std::random_device{};
+        auto rtn    = std::string{};
+
+        for (auto i = 0; 4 > i; i++)
+        {
+            std::format_to(std::back_inserter(rtn), "{:08x}", device());
+        }
+
+        return rtn;
+    }
+
+    scheme::response webview::impl::acknowledge(const scheme::request &request)
+    {
+        auto rtn = scheme::response{
+            .data = stash::empty(),
+            .mime = "text/plain",
+        };
+
+        // The token already proved the request came from a bridged document, so its origin may read the (empty) answer
+        if (auto origin = request.header("Origin"); origin.has_value())
+        {
+            rtn.headers.emplace("Access-Control-Allow-Origin", std::move(*origin));
+            rtn.headers.emplace("Vary", "Origin");
+        }
+
+        return rtn;
+    }
+
+    void webview::impl::handle_buffers(const scheme::request &request, const scheme::executor &exec)
+    {
+        const auto &[resolve, reject] = exec;
+
+        if (!on_buffers || request.method() != "POST")
+        {
+            return reject(scheme::error::invalid);
+        }
+
+        auto content    = std::make_shared<stash>(request.content());
+        const auto body = std::string_view{reinterpret_cast<const char *>(content->data()), content->size()};
+
+        // Sub-frames without the bridge could otherwise invoke exposed functions by simply fetching this endpoint
+        const auto token_end = body.find('\0');
+
+        if (token_end == std::string_view::npos || body.substr(0, token_end) != bridge_token)
+        {
+            return reject(scheme::error::denied);
+        }
+
+        const auto header_end = body.find('\0', token_end + 1);
+
+        if (header_end == std::string_view::npos)
+        {
+            return reject(scheme::error::invalid);
+        }
+
+        const auto message_end = body.find('\0', header_end + 1);
+
+        if (message_end == std::string_view::npos)
+        {
+            return reject(scheme::error::invalid);
+        }
+
+        static constexpr auto alignment = 8uz;
+
+        auto offset  = message_end + 1;
+        auto buffers = std::vector<stash>{};
+
+        for (const auto &part : body.substr(token_end + 1, header_end - token_end - 1) | std::views::split(','))
+        {
+            std::size_t size{};
+
+            if (auto [_, ec] = std::from_chars(part.data(), part.data() + part.size(), size); ec != std::errc{})
+            {
+                return reject(scheme::error::invalid);
+            }
+
+            offset = (offset + alignment - 1) & ~(alignment - 1);
+
+            if (offset > body.size() || size > body.size() - offset)
+            {
+                return reject(scheme::error::invalid);
+            }
+
+            auto buffer = [content, offset, size]
+            {
+                const auto *data = content->data() + offset;
+
+                if (reinterpret_cast<std::uintptr_t>(data) % alignment == 0)
+                {
+                    return stash::view({data, size});
+                }
+
+                return stash::from({data, data + size});
+            };
+
+            buffers.emplace_back(stash::lazy(std::move(buffer)));
+            offset += size;
+        }
+
+        const auto message = body.substr(header_end + 1, message_end - header_end - 1);
+
+        if (on_buffers(message, std::move(buffers)) != status::handled)
+        {
+            return reject(scheme::error::invalid);
+        }
+
+        return resolve(acknowledge(request));
+    }
+
+    void webview::impl::handle_shared(const scheme::request &request, const scheme::executor &exec)
+    {
+        const auto &[resolve, reject] = exec;
+        const auto name               = request.url().path().filename().string();
+
+        std::size_t id{};
+
+        if (auto [_, ec] = std::from_chars(name.data(), name.data() + name.size(), id); ec != std::errc{})
+        {
+            return reject(scheme::error::invalid);
+        }
+
+        auto node = shared.extract(id);
+
+        if (!node)
+        {
+            return reject(scheme::error::not_found);
+        }
+
+        auto content = [buffer = std::move(node.mapped())]
+        {
+            return stash::view(buffer.data());
+        };
+
+        return resolve({
+            .data    = stash::lazy(std::move(content)),
+            .mime    = "application/octet-stream",
+            .headers = {{"Access-Control-Allow-Origin", "*"}},
+        });
+    }
+
+    void webview::impl::set_html(stash html)
+    {
+        document.emplace(std::move(html).share());
+
+        // Every document gets a fresh url, so that the engine neither skips the navigation nor serves a cached copy
+        set_url(url::make({.scheme = "saucer", .host = "document", .path = std::format("/{}.html", ++document_counter)}));
+    }
+
+    void webview::impl::handle_document(const scheme::request &request, const scheme::executor &exec)
+    {
+        const auto &[resolve, reject] = exec;
+        const auto name               = request.url().path().stem().string();
+
+        std::size_t id{};
+
+        if (auto [_, ec] = std::from_chars(name.data(), name.data() + name.size(), id); ec != std::errc{})
+        {
+            return reject(scheme::error::invalid);
+        }
+
+        // Only the latest document is kept, earlier ones were released once they were replaced
+        if (!document.has_value() || id != document_counter)
+        {
+            return reject(scheme::error::not_found);
+        }
+
+        auto headers = scheme::header_list{{"Cache-Control", "no-store"}};
+
+        return resolve(scheme::serve(request, *document, "text/html", std::move(headers)));
+    }
+
+    void webview::impl::handle_channel(const scheme::request &request, const scheme::executor &exec)
+    {
+        const auto &[resolve, reject] = exec;
+        const auto it                 = channels.find(request.url().path().filename().string());
+
+        if (it == channels.end())
+        {
+            return reject(scheme::error::not_found);
+        }
+
+        const auto &state = it->second;
+
+        if (request.method() == "GET")
+        {
+            auto pending = std::vector<std::uint8_t>{};
+
+            {
+                std::lock_guard lock{state->mutex};
+
+                pending          = std::exchange(state->pending, {});
+                state->scheduled = false;
+            }
+
+            return resolve({
+                .data    = stash::from(std::move(pending)),
+                .mime    = "application/octet-stream",
+                .headers = {{"Access-Control-Allow-Origin", "*"}},
+            });
+        }
+
+        if (request.method() != "POST")
+        {
+            return reject(scheme::error::invalid);
+        }
+
+        auto content     = std::make_shared<stash>(request.content());
+        const auto *data = content->data();
+        const auto total = content->size();
+
+        auto frames = std::vector<stash>{};
+
+        // Every frame is a little-endian 32-bit length followed by its payload
+        for (auto offset = 0uz; total > offset;)
+        {
+            if (total - offset < 4)
+            {
+                return reject(scheme::error::invalid);
+            }
+
+            const auto size = std::size_t{data[offset]} | (std::size_t{data[offset + 1]} << 8) | (std::size_t{data[offset + 2]} << 16) |
+                              (std::size_t{data[offset + 3]} << 24);
+
+            offset += 4;
+
+            if (size > total - offset)
+            {
+                return reject(scheme::error::invalid);
+            }
+
+            auto frame = [content, offset, size]
+            {
+                return stash::view({content->data() + offset, size});
+            };
+
+            frames.emplace_back(stash::lazy(std::move(frame)));
+            offset += size;
+        }
+
+        auto receiver = std::function<void(stash)>{};
+
+        {
+            std::lock_guard lock{state->mutex};
+            receiver = state->receiver;
+        }
+
+        for (auto &frame : frames)
+        {
+            if (!receiver)
+            {
+                break;
+            }
+
+            receiver(std::move(frame));
+        }
+
+        return resolve(acknowledge(request));
+    }
+
+    void webview::handle_scheme(const std::string &name, scheme::resolver &&handler, launch policy)
+    {
+        auto handle = [policy](auto *impl, const auto &name, auto handler)
+        {
+            impl->handle_scheme(name, impl->offload(name, impl::instrument(std::move(handler)), policy));
+        };
+
+        return utils::invoke(handle, m_impl.get(), name, std::move(handler));
+    }
+
+    void webview::handle_stream_scheme(const std::string &name, scheme::stream_resolver &&handler)
+    {
+        return utils::invoke<&impl::handle_stream_scheme>(m_impl.get(), name, std::move(handler));
+    }
+
+    void impl::set_suspended(bool value)
+    {
+        if (std::exchange(suspended, value) == value)
+        {
+            return;
+        }
+
+        suspend(value);
+    }
+
+    result<webview::channel> impl::open_channel(std::string name)
+    {
+        auto valid = [](const char ch)
+        {
+            return std::isalnum(static_cast<unsigned char>(ch)) || ch == '-' || ch == '_';
+        };
+
+        // Names end up in urls and scripts verbatim, so they are kept to a set that needs no escaping
+        if (name.empty() || !std::ranges::all_of(name, valid))
+        {
+            return err(std::errc::invalid_argument);
         }
 
-        auto rtn         = webview{parent};
-        auto *const impl = rtn.m_impl.get();
-
-        impl->window     = opts.window.value();
-        impl->parent     = parent;
-        impl->attributes = opts.attributes;
-
-        if (auto status = impl->init_platform(opts); !status.has_value())
+        if (auto it = channels.find(name); it != channels.end())
         {
-            return err(status);
+            return channel{it->second};
         }
 
-        rtn.on<event::message>({{.func = std::bind_front(&impl::on_message, impl), .clearable = false}});
+        auto state = std::make_shared<channel::state>(name, parent, lease.rent());
+        channels.emplace(std::move(name), state);
 
-        rtn.inject({.code = impl::creation_script(), .run_at = script::time::creation, .clearable = false});
-        rtn.inject({.code = impl::ready_script(), .run_at = script::time::ready, .clearable = false});
+        return channel{std::move(state)};
+    }
 
-        if (opts.attributes)
-        {
-            rtn.inject({.code = impl::attribute_script(), .run_at = script::time::creation, .clearable = false});
-        }
+    void impl::share_fallback(const shared_buffer &buffer, std::string_view topic)
+    {
+        const auto id = shared_counter++;
 
-        return rtn;
+        shared.emplace(id, buffer);
+        execute(std::format("window.saucer.internal.shared({}, {});", topic, id));
     }
 
-    webview::~webview()
+    void impl::reject(std::size_t id, std::string reason)
     {
-        utils::invoke([](auto *impl) { impl->events.clear(true); }, m_impl.get());
+        return utils::invoke([id, &reason](auto *impl) { impl->settle(id, false, std::move(reason)); }, this);
     }
 
-    template <webview::event Event>
-    void webview::setup()
+    void impl::resolve(std::size_t id, std::string result)
     {
-        return utils::invoke<&impl::setup<Event>>(m_impl.get());
+        return utils::invoke([id, &result](auto *impl) { impl->settle(id, true, std::move(result)); }, this);
     }
 
-    void webview::impl::handle_embed(const scheme::request &request, const scheme::executor &exec)
+    void impl::flush()
     {
-        const auto &[resolve, reject] = exec;
-        const auto url                = request.url();
+        if (batched.empty())
+        {
+            return;
+        }
 
-        if (url.scheme() != "saucer" || url.host() != "embedded")
+        execute(std::format("window.saucer.internal.settle([{}]);", std::exchange(batched, {})));
+    }
+
+    void impl::settle(std::size_t id, bool resolved, std::string value)
+    {
+        if (auto packed = compress ? compress(value) : std::nullopt; packed.has_value())
         {
-            return reject(scheme::error::invalid);
+            return execute(std::format("window.saucer.internal.inflate({},{},\"{}\");", id, resolved, *packed));
         }
 
-        const auto file = url.path();
+        if (value.size() > chunk_size)
+        {
+            return chunk(id, resolved, value);
+        }
 
-        if (!embedded.contains(file))
+        if (!batch_window.has_value())
         {
-            return reject(scheme::error::not_found);
+            static constexpr std::string_view suffix = "]]);";
+
+            auto script = std::format("window.saucer.internal.settle([[{},{},", id, resolved);
+            script.reserve(script.size() + value.size() + suffix.size());
+
+            {
+                auto consumed = std::move(value);
+                script.append(consumed).append(suffix);
+            }
+
+            return execute(script);
         }
 
-        const auto &data = embedded.at(file);
+        const auto scheduled = !batched.empty();
+        std::format_to(std::back_inserter(batched), "[{},{},{}],", id, resolved, value);
 
-        return resolve({
-            .data    = data.content,
-            .mime    = data.mime,
-            .headers = {{"Access-Control-Allow-Origin", "*"}},
-        });
-    }
+        if (scheduled)
+        {
+            return;
+        }
 
-    void webview::handle_scheme(const std::string &name, scheme::resolver &&handler)
-    {
-        return utils::invoke<&impl::handle_scheme>(m_impl.get(), name, std::move(handler));
-    }
+        auto flush = [rental = lease.rent()]
+        {
+            auto locked = rental.access();
 
-    void webview::handle_stream_scheme(const std::string &name, scheme::stream_resolver &&handler)
-    {
-        return utils::invoke<&impl::handle_stream_scheme>(m_impl.get(), name, std::move(handler));
-    }
+            if (auto *const self = locked.value(); self)
+            {
+                (*self)->flush();
+            }
+        };
 
-    void impl::reject(std::size_t id, std::string_view reason)
-    {
-        static constexpr auto code = R"(
-            window.saucer.internal.rpc[{0}].reject({1});
-            delete window.saucer.internal.rpc[{0}];
-        )";
+        if (batch_window->count() <= 0)
+        {
+            return parent->post(std::move(flush));
+        }
 
-        return utils::invoke([id, reason](auto *impl) { impl->execute(std::format(code, id, reason)); }, this);
+        parent->schedule(*batch_window, std::move(flush), timer_precision::precise);
     }
 
-    void impl::resolve(std::size_t id, std::string_view result)
+    void impl::chunk(std::size_t id, bool resolved, std::string_view value)
     {
-        static constexpr auto code = R"(
-            window.saucer.internal.rpc[{0}].resolve({1});
-            delete window.saucer.internal.rpc[{0}];
-        )";
+        static constexpr std::string_view suffix = "\");";
+
+        // Huge results are handed over as string literals of at most `chunk_size` bytes, which the bridge reassembles before settling
+        while (!value.empty())
+        {
+            auto size = std::min(value.size(), chunk_size);
+
+            while (size < value.size() && (static_cast<unsigned char>(value[size]) & 0xC0) == 0x80)
+            {
+                size--;
+            }
+
+            auto script = std::format("window.saucer.internal.chunk({},\"", id);
+            script.reserve(script.size() + size + (size / 8) + suffix.size());
+
+            for (const auto ch : value.substr(0, size))
+            {
+                if (ch == '"' || ch == '\\')
+                {
+                    script += '\\';
+                }
+
+                if (static_cast<unsigned char>(ch) < 0x20)
+                {
+                    std::format_to(std::back_inserter(script), "\\u{:04x}", static_cast<unsigned char>(ch));
+                    continue;
+                }
+
+                script += ch;
+            }
+
+            execute(script.append(suffix));
+            value.remove_prefix(size);
+        }
 
-        return utils::invoke([id, result](auto *impl) { impl->execute(std::format(code, id, result)); }, this);
+        execute(std::format("window.saucer.internal.assemble({},{});", id, resolved));
     }
 
     window &webview::parent() const
@@ -180,9 +1407,14 @@ namespace saucer
         return utils::invoke<&impl::bounds>(m_impl.get());
     }
 
+    bool webview::suspended() const
+    {
+        return utils::invoke([](auto *impl) { return impl->suspended; }, m_impl.get());
+    }
+
     void webview::set_url(const saucer::url &url)
     {
-        return utils::invoke<&impl::set_url>(m_impl.get(), url);
+        return utils::dispatch<&impl::set_url>(m_impl.get(), url);
     }
 
     void webview::set_url(cstring_view str)
@@ -199,52 +1431,121 @@ namespace saucer
 
     void webview::set_html(cstring_view html)
     {
-        return utils::invoke<&impl::set_html>(m_impl.get(), html);
+        using overload = void (impl::*)(cstring_view);
+
+        if (html.size() > impl::inline_html)
+        {
+            return set_html(stash::from_str(html));
+        }
+
+        return utils::dispatch<static_cast<overload>(&impl::set_html)>(m_impl.get(), html);
+    }
+
+    void webview::set_html(stash html)
+    {
+        using overload = void (impl::*)(stash);
+        return utils::dispatch<static_cast<overload>(&impl::set_html)>(m_impl.get(), std::move(html));
+    }
+
+    void webview::set_navigation_rules(std::vector<navigation_rule> rules)
+    {
+        auto apply = [](auto *impl, auto rules)
+        {
+            impl->rules = std::move(rules);
+            return !std::exchange(impl->ruled, true);
+        };
+
+        if (!utils::invoke(apply, m_impl.get(), std::move(rules)))
+        {
+            return;
+        }
+
+        on<event::navigate>({{.func = [](const navigation &) { return policy::allow; }, .clearable = false}});
+    }
+
+    void webview::set_content_rules(std::vector<std::string> block)
+    {
+        return utils::dispatch<&impl::set_content_rules>(m_impl.get(), std::move(block));
+    }
+
+    void webview::clear_permissions()
+    {
+        auto clear = [](auto *impl)
+        {
+            if (!impl->permissions)
+            {
+                return;
+            }
+
+            impl->permissions->clear();
+        };
+
+        return utils::invoke(clear, m_impl.get());
     }
 
     void webview::set_dev_tools(bool value)
     {
-        return utils::invoke<&impl::set_dev_tools>(m_impl.get(), value);
+        return utils::dispatch<&impl::set_dev_tools>(m_impl.get(), value);
     }
 
     void webview::set_context_menu(bool value)
     {
-        return utils::invoke<&impl::set_context_menu>(m_impl.get(), value);
+        return utils::dispatch<&impl::set_context_menu>(m_impl.get(), value);
     }
 
     void webview::set_force_dark(bool value)
     {
-        return utils::invoke<&impl::set_force_dark>(m_impl.get(), value);
+        return utils::dispatch<&impl::set_force_dark>(m_impl.get(), value);
     }
 
     void webview::set_background(color background)
     {
-        return utils::invoke<&impl::set_background>(m_impl.get(), background);
+        return utils::dispatch<&impl::set_background>(m_impl.get(), background);
     }
 
     void webview::reset_bounds()
     {
-        return utils::invoke<&impl::reset_bounds>(m_impl.get());
+        return utils::dispatch<&impl::reset_bounds>(m_impl.get());
     }
 
     void webview::set_bounds(saucer::bounds bounds)
     {
-        return utils::invoke<&impl::set_bounds>(m_impl.get(), bounds);
+        return utils::dispatch<&impl::set_bounds>(m_impl.get(), bounds);
+    }
+
+    void webview::attach_surface(std::string name, void *handle, layer position)
+    {
+        return utils::dispatch<&impl::attach_surface>(m_impl.get(), std::move(name), handle, position);
+    }
+
+    void webview::detach_surface(const std::string &name)
+    {
+        return utils::dispatch<&impl::detach_surface>(m_impl.get(), name);
+    }
+
+    void webview::set_suspended(bool value)
+    {
+        return utils::dispatch<&impl::set_suspended>(m_impl.get(), value);
+    }
+
+    void webview::set_memory_target(memory_target target)
+    {
+        return utils::dispatch<&impl::set_memory_target>(m_impl.get(), target);
     }
 
     void webview::back()
     {
-        return utils::invoke<&impl::back>(m_impl.get());
+        return utils::dispatch<&impl::back>(m_impl.get());
     }
 
     void webview::forward()
     {
-        return utils::invoke<&impl::forward>(m_impl.get());
+        return utils::dispatch<&impl::forward>(m_impl.get());
     }
 
     void webview::reload()
     {
-        return utils::invoke<&impl::reload>(m_impl.get());
+        return utils::dispatch<&impl::reload>(m_impl.get());
     }
 
     void webview::serve(fs::path file)
@@ -252,53 +1553,286 @@ namespace saucer
         return set_url(url::make({.scheme = "saucer", .host = "embedded", .path = std::move(file)}));
     }
 
+    void webview::serve_directory(const fs::path &directory, std::string host)
+    {
+        std::error_code ec{};
+        auto root = fs::canonical(directory, ec);
+
+        if (ec)
+        {
+            return;
+        }
+
+        return utils::dispatch<&impl::serve_directory>(m_impl.get(), std::move(root), std::move(host));
+    }
+
     void webview::embed(embedded_files files)
     {
-        auto embed = [](auto *impl, auto files)
+        auto entries  = std::vector<impl::embedded_entry>{};
+        auto deferred = std::vector<std::pair<std::string, stash>>{};
+
+        entries.reserve(files.size());
+
+        for (auto &[path, file] : files)
+        {
+            auto name = path.lexically_normal().generic_string();
+
+            if (const auto *source = impl::compressed(file); source)
+            {
+                auto tag = impl::etag(*source);
+                entries.emplace_back(std::move(name), std::move(file), std::move(tag));
+                continue;
+            }
+
+            if (file.content.deferred())
+            {
+                deferred.emplace_back(name, file.content);
+                entries.emplace_back(std::move(name), std::move(file));
+                continue;
+            }
+
+            auto tag = impl::etag(file.content);
+            entries.emplace_back(std::move(name), std::move(file), std::move(tag));
+        }
+
+        utils::invoke([](auto *impl, auto entries) { impl->merge(std::move(entries)); }, m_impl.get(), std::move(entries));
+
+        if (deferred.empty())
+        {
+            return;
+        }
+
+        auto apply = utils::defer(m_impl->lease,
+                                  [](webview::impl *self, const std::string &path, const stash &content, std::string tag)
+                                  { self->retag(path, content, std::move(tag)); });
+
+        auto precompute = [parent = m_impl->parent, apply = std::move(apply), deferred = std::move(deferred)]() mutable
         {
-            impl->embedded.merge(std::move(files));
-            impl->handle_scheme("saucer", std::bind_front(&impl::handle_embed, impl));
+            for (auto &[path, content] : deferred)
+            {
+                auto retag = [apply, path = std::move(path), content, tag = impl::etag(content)]() mutable
+                {
+                    apply(path, content, std::move(tag));
+                };
+
+                parent->post(std::move(retag), priority::background);
+            }
         };
 
-        return utils::invoke(embed, m_impl.get(), std::move(files));
+        utils::pool::shared().submit(std::move(precompute));
+    }
+
+    void webview::embed(const fs::path &directory)
+    {
+        std::error_code ec{};
+        auto root = fs::canonical(directory, ec);
+
+        if (ec)
+        {
+            return;
+        }
+
+        return utils::invoke([](auto *impl, auto root) { impl->directory.emplace(std::move(root)); }, m_impl.get(), std::move(root));
+    }
+
+    void webview::embed(const embedded_bundle &bundle)
+    {
+        if (std::ranges::is_sorted(bundle.files, {}, &bundled_file::path))
+        {
+            return utils::invoke([bundle](auto *impl) { impl->bundles.emplace_back(bundle); }, m_impl.get());
+        }
+
+        auto files = embedded_files{};
+
+        for (const auto &file : bundle.files)
+        {
+            if (file.offset > bundle.blob.size() || file.size > bundle.blob.size() - file.offset)
+            {
+                continue;
+            }
+
+            files.emplace(file.path, embedded_file{
+                                         .content = stash::view(bundle.blob.subspan(file.offset, file.size)),
+                                         .mime    = std::string{file.mime},
+                                     });
+        }
+
+        return embed(std::move(files));
     }
 
     void webview::unembed()
     {
-        auto unembed = [](auto *impl)
+        auto clear = [](auto *impl)
         {
             impl->embedded.clear();
-            impl->remove_scheme("saucer");
+            impl->bundles.clear();
+            impl->stores.clear();
+            impl->directory.reset();
         };
 
-        return utils::invoke(unembed, m_impl.get());
+        return utils::invoke(clear, m_impl.get());
     }
 
     void webview::unembed(const fs::path &file)
     {
-        return utils::invoke([file](auto *impl) { impl->embedded.erase(file); }, m_impl.get());
+        return utils::invoke([key = file.lexically_normal().generic_string()](auto *impl) { impl->erase(key); }, m_impl.get());
+    }
+
+    void webview::mount(asset_store store)
+    {
+        auto mount = [](auto *impl, auto store)
+        {
+            std::erase(impl->stores, store);
+            impl->stores.emplace_back(std::move(store));
+        };
+
+        return utils::invoke(mount, m_impl.get(), std::move(store));
+    }
+
+    void webview::unmount(const asset_store &store)
+    {
+        return utils::invoke([store](auto *impl) { std::erase(impl->stores, store); }, m_impl.get());
     }
 
     void webview::execute(cstring_view code)
     {
-        return utils::invoke<&impl::execute>(m_impl.get(), code);
+        return utils::dispatch<&impl::execute>(m_impl.get(), code);
+    }
+
+    void webview::execute(std::shared_ptr<const std::string> code)
+    {
+        if (!m_impl || !code)
+        {
+            return;
+        }
+
+        auto callback = [code = std::move(code)](impl *self)
+        {
+            self->execute(*code);
+        };
+
+        m_impl->parent->dispatch(utils::defer(m_impl->lease, std::move(callback)));
+    }
+
+    result<shared_buffer> webview::create_buffer(std::size_t size)
+    {
+        return utils::invoke<&impl::create_buffer>(m_impl.get(), size);
+    }
+
+    result<webview::channel> webview::open_channel(std::string name)
+    {
+        return utils::invoke<&impl::open_channel>(m_impl.get(), std::move(name));
+    }
+
+    coco::future<result<std::string>> webview::evaluate_raw(cstring_view code)
+    {
+        auto promise = coco::promise<result<std::string>>{};
+        auto rtn     = promise.get_future();
+
+        utils::dispatch<&impl::evaluate_raw>(m_impl.get(), code, std::move(promise));
+
+        return rtn;
+    }
+
+    coco::future<result<icon>> webview::capture(std::optional<saucer::size> bounds)
+    {
+        auto promise = coco::promise<result<icon>>{};
+        auto rtn     = promise.get_future();
+
+        utils::dispatch<&impl::capture>(m_impl.get(), bounds, std::move(promise));
+
+        return rtn;
+    }
+
+    coco::future<memory_usage> webview::memory_stats()
+    {
+        auto promise = coco::promise<memory_usage>{};
+        auto rtn     = promise.get_future();
+
+        utils::dispatch<&impl::memory_stats>(m_impl.get(), std::move(promise));
+
+        return rtn;
+    }
+
+    coco::future<result<std::string>> webview::devtools_protocol(std::string method, std::string params)
+    {
+        auto promise = coco::promise<result<std::string>>{};
+        auto rtn     = promise.get_future();
+
+        utils::dispatch<&impl::devtools_protocol>(m_impl.get(), std::move(method), std::move(params), std::move(promise));
+
+        return rtn;
+    }
+
+    coco::future<result<>> webview::set_cookies(std::vector<cookie> cookies)
+    {
+        auto promise = coco::promise<result<>>{};
+        auto rtn     = promise.get_future();
+
+        utils::dispatch<&impl::set_cookies>(m_impl.get(), std::move(cookies), std::move(promise));
+
+        return rtn;
+    }
+
+    coco::future<result<>> webview::clear_data(site_data data)
+    {
+        auto promise = coco::promise<result<>>{};
+        auto rtn     = promise.get_future();
+
+        utils::dispatch<&impl::clear_data>(m_impl.get(), std::move(data), std::move(promise));
+
+        return rtn;
     }
 
     std::size_t webview::inject(const script &script)
     {
-        return utils::invoke<&impl::inject>(m_impl.get(), script);
+        if (script.no_frames || !script.lazy)
+        {
+            return utils::invoke<&impl::inject>(m_impl.get(), script);
+        }
+
+        // The top frame receives the script as is, sub-frames only get a stub that evaluates it once `saucer` is first accessed
+        auto inject = [](impl *self, saucer::script script)
+        {
+            auto stub = script;
+            stub.code = impl::lazy_script(script.code);
+
+            script.no_frames = true;
+            const auto rtn   = self->inject(script);
+
+            self->lazy_scripts.emplace(rtn, impl::lazy_entry{.stub = self->inject(stub), .clearable = script.clearable});
+
+            return rtn;
+        };
+
+        return utils::invoke(inject, m_impl.get(), script);
     }
 
     void webview::uninject()
     {
-        static constexpr auto uninject = static_cast<void (impl::*)()>(&impl::uninject);
-        return utils::invoke<uninject>(m_impl.get());
+        auto uninject = [](auto *impl)
+        {
+            impl->uninject();
+            std::erase_if(impl->lazy_scripts, [](const auto &entry) { return entry.second.clearable; });
+        };
+
+        return utils::invoke(uninject, m_impl.get());
     }
 
     void webview::uninject(std::size_t id)
     {
-        static constexpr auto uninject = static_cast<void (impl::*)(std::size_t)>(&impl::uninject);
-        return utils::invoke<uninject>(m_impl.get(), id);
+        auto uninject = [](auto *impl, std::size_t id)
+        {
+            impl->uninject(id);
+
+            if (auto it = impl->lazy_scripts.find(id); it != impl->lazy_scripts.end())
+            {
+                impl->uninject(it->second.stub);
+                impl->lazy_scripts.erase(it);
+            }
+        };
+
+        return utils::invoke(uninject, m_impl.get(), id);
     }
 
     void webview::remove_scheme(const std::string &name)
@@ -326,5 +1860,104 @@ namespace saucer
         return impl::register_scheme(name);
     }
 
+    webview::channel::channel(std::shared_ptr<state> state) : m_state(std::move(state)) {}
+
+    const std::string &webview::channel::name() const
+    {
+        return m_state->name;
+    }
+
+    bool webview::channel::send(stash data) const
+    {
+        const auto size = data.size();
+
+        if (size > std::numeric_limits<std::uint32_t>::max())
+        {
+            return false;
+        }
+
+        {
+            std::lock_guard lock{m_state->mutex};
+
+            if (m_state->closed)
+            {
+                return false;
+            }
+
+            auto &pending = m_state->pending;
+
+            for (auto shift = 0uz; 32 > shift; shift += 8)
+            {
+                pending.emplace_back(static_cast<std::uint8_t>(size >> shift));
+            }
+
+            pending.insert(pending.end(), data.data(), data.data() + size);
+
+            // Only the first frame of a batch asks the page to pull, the rest ride along with it
+            if (std::exchange(m_state->scheduled, true))
+            {
+                return true;
+            }
+        }
+
+        auto pull = [owner = m_state->owner, code = std::format("window.saucer.internal.pull(\"{}\");", m_state->name)]
+        {
+            auto locked = owner.access();
+            auto *value = locked.value();
+
+            if (!value)
+            {
+                return;
+            }
+
+            (*value)->execute(code);
+        };
+
+        m_state->parent->dispatch(std::move(pull));
+
+        return true;
+    }
+
+    void webview::channel::on_receive(std::function<void(stash)> callback) const
+    {
+        std::lock_guard lock{m_state->mutex};
+        m_state->receiver = std::move(callback);
+    }
+
+    void webview::channel::close() const
+    {
+        {
+            std::lock_guard lock{m_state->mutex};
+
+            if (std::exchange(m_state->closed, true))
+            {
+                return;
+            }
+
+            m_state->pending.clear();
+            m_state->receiver = nullptr;
+        }
+
+        auto erase = [owner = m_state->owner, state = m_state]
+        {
+            auto locked = owner.access();
+            auto *value = locked.value();
+
+            if (!value)
+            {
+                return;
+            }
+
+            auto &channels = (*value)->channels;
+
+            if (auto it = channels.find(state->name); it != channels.end() && it->second == state)
+            {
+                channels.erase(it);
+            }
+        };
+
+        m_state->parent->dispatch(std::move(erase));
+    }
+
     SAUCER_INSTANTIATE_WEBVIEW_EVENTS(SAUCER_INSTANTIATE_WEBVIEW_EVENT);
 } // namespace saucer
@@ -3,20 +3,44 @@
 #include "scripts.hpp"
 #include "request.hpp"
 
+#include <ranges>
+#include <algorithm>
+
 namespace saucer
 {
     using impl = webview::impl;
 
     status impl::on_message(std::string_view message)
     {
-        if (!attributes)
+        auto request = request::parse(message);
+
+        if (!request.has_value())
         {
             return status::unhandled;
         }
 
-        auto request = request::parse(message);
+        if (auto *const timing = std::get_if<request::timing>(&*request); timing)
+        {
+            report(std::move(*timing));
+            return status::handled;
+        }
 
-        if (!request.has_value())
+        if (auto *const data = std::get_if<request::surfaces>(&*request); data)
+        {
+            surface_bounds.clear();
+
+            for (auto &[name, bounds] : data->entries)
+            {
+                const auto [x, y, w, h] = bounds;
+                surface_bounds.emplace(std::move(name), saucer::bounds{.x = x, .y = y, .w = w, .h = h});
+            }
+
+            place_surfaces();
+
+            return status::handled;
+        }
+
+        if (!attributes)
         {
             return status::unhandled;
         }
@@ -29,6 +53,13 @@ namespace saucer
             [this](const request::close &) { window->close(); },
             [this](const request::maximized &data) { resolve(data.id, std::format("{}", window->maximized())); },
             [this](const request::minimized &data) { resolve(data.id, std::format("{}", window->minimized())); },
+            [this](request::regions &data)
+            {
+                drag_regions   = std::move(data.drag);
+                ignore_regions = std::move(data.ignore);
+            },
+            [](const request::timing &) {},
+            [](const request::surfaces &) {},
         };
 
         std::visit(visitor, *request);
@@ -36,9 +67,383 @@ namespace saucer
         return status::handled;
     }
 
-    std::string impl::attribute_script()
+    void impl::report(request::timing data)
+    {
+        auto convert = [](request::resource &resource)
+        {
+            return resource_timing{
+                .name     = std::move(resource.name),
+                .type     = std::move(resource.type),
+                .start    = resource.start,
+                .duration = resource.duration,
+                .size     = resource.size,
+            };
+        };
+
+        const auto timing = load_timing{
+            .dns                = data.dns,
+            .connect            = data.connect,
+            .ttfb               = data.ttfb,
+            .dom_content_loaded = data.dom_content_loaded,
+            .load               = data.load,
+            .resources          = data.resources | std::views::transform(convert) | std::ranges::to<std::vector>(),
+        };
+
+        events.get<event::timing>().fire(timing);
+    }
+
+    void impl::mirror()
+    {
+        static constexpr auto code = R"(window.saucer.internal.mirror({{"maximized":{},"minimized":{},"fullscreen":{},"focused":{}}});)";
+        execute(std::format(code, window->maximized(), window->minimized(), window->fullscreen(), window->focused()));
+    }
+
+    bool impl::draggable(double x, double y) const
+    {
+        auto contains = [x, y](const auto &region)
+        {
+            const auto [left, top, width, height] = region;
+            return x >= left && y >= top && x < left + width && y < top + height;
+        };
+
+        return std::ranges::any_of(drag_regions, contains) && !std::ranges::any_of(ignore_regions, contains);
+    }
+
+    void impl::attach_surface(std::string name, void *handle, layer position)
+    {
+        detach_surface(name);
+
+        if (!surface_observer.has_value())
+        {
+            // Pages only report their surfaces once one is attached, the current document is caught up right away
+            surface_observer = inject({.code = surface_script(), .run_at = script::time::creation, .clearable = false});
+            execute(surface_script());
+        }
+
+        add_surface(handle, position);
+        surfaces.emplace(std::move(name), surface{.handle = handle, .position = position});
+
+        place_surfaces();
+    }
+
+    void impl::detach_surface(const std::string &name)
+    {
+        auto node = surfaces.extract(name);
+
+        if (node.empty())
+        {
+            return;
+        }
+
+        remove_surface(node.mapped().handle);
+    }
+
+    void impl::place_surfaces()
+    {
+        for (const auto &[name, entry] : surfaces)
+        {
+            auto it = surface_bounds.find(name);
+
+            if (it == surface_bounds.end())
+            {
+                move_surface(entry.handle, std::nullopt);
+                continue;
+            }
+
+            move_surface(entry.handle, it->second);
+        }
+    }
+
+    void impl::dispatch(std::string_view message)
+    {
+        const auto attribute = request::tagged(message);
+
+        if (!attribute && on_rpc && on_rpc(message) == status::handled)
+        {
+            return;
+        }
+
+        if (attribute && on_message(message) == status::handled)
+        {
+            return;
+        }
+
+        events.get<event::message>().fire(message).find(status::handled);
+    }
+
+    void impl::dispatch(std::string_view message, std::vector<fs::path> files)
+    {
+        if (files.empty())
+        {
+            return dispatch(message);
+        }
+
+        if (on_files && on_files(message, std::move(files)) == status::handled)
+        {
+            return;
+        }
+
+        dispatch(message);
+    }
+
+    const std::string &impl::attribute_script()
     {
         static const auto rtn = std::format(scripts::attribute_script, request::stubs());
         return rtn;
     }
+
+    bool impl::remembered(const permission::request &request) const
+    {
+        if (!permissions)
+        {
+            return false;
+        }
+
+        const auto decision = permissions->find(request.url(), request.type());
+
+        if (!decision.has_value())
+        {
+            return false;
+        }
+
+        request.accept(*decision);
+
+        return true;
+    }
+
+    std::move_only_function<void(bool)> impl::recorder(const permission::request &request) const
+    {
+        if (!permissions)
+        {
+            return {};
+        }
+
+        return [permissions = permissions, url = request.url(), type = request.type()](bool allowed)
+        {
+            permissions->store(url, type, allowed);
+        };
+    }
+
+    const std::string &impl::region_script()
+    {
+        static const auto rtn = std::string{scripts::region_script};
+        return rtn;
+    }
+
+    const std::string &impl::surface_script()
+    {
+        static const auto rtn = std::string{scripts::surface_script};
+        return rtn;
+    }
+
+    std::string impl::lazy_script(std::string_view code)
+    {
+        std::string quoted{"\""};
+
+        for (const auto ch : code)
+        {
+            switch (ch)
+            {
+            case '"':
+                quoted += R"(\")";
+                break;
+            case '\\':
+                quoted += R"(\\)";
+                break;
+            case '\n':
+                quoted += R"(\n)";
+                break;
+            case '\r':
+                quoted += R"(\r)";
+                break;
+            case '\t':
+                quoted += R"(\t)";
+                break;
+            default:
+                if (static_cast<unsigned char>(ch) < 0x20)
+                {
+                    std::format_to(std::back_inserter(quoted), R"(\u{:04x})", static_cast<int>(ch));
+                    break;
+                }
+
+                quoted += ch;
+            }
+        }
+
+        quoted += '"';
+
+        return std::format(scripts::lazy_script, quoted);
+    }
+
+    std::set<std::string> impl::chromium_flags(const options &opts)
+    {
+        auto rtn = opts.browser_flags;
+
+        if (opts.process_model == process_model::per_site)
+        {
+            rtn.emplace("--process-per-site");
+        }
+        else if (opts.process_model == process_model::shared)
+        {
+            rtn.emplace("--renderer-process-limit=1");
+        }
+
+        if (opts.gpu_rasterization.has_value())
+        {
+            rtn.emplace(*opts.gpu_rasterization ? "--enable-gpu-rasterization" : "--disable-gpu-rasterization");
+        }
+
+        if (opts.back_forward_cache == false)
+        {
+            rtn.emplace("--disable-features=BackForwardCache");
+        }
+        else if (opts.back_forward_cache_size.has_value())
+        {
+            rtn.emplace(std::format("--enable-features=BackForwardCache:cache_size/{}", *opts.back_forward_cache_size));
+        }
+        else if (opts.back_forward_cache == true)
+        {
+            rtn.emplace("--enable-features=BackForwardCache");
+        }
+
+        if (opts.offscreen || opts.background_throttling == false)
+        {
+            rtn.emplace("--disable-background-timer-throttling");
+            rtn.emplace("--disable-renderer-backgrounding");
+            rtn.emplace("--disable-backgrounding-occluded-windows");
+        }
+
+        if (opts.smooth_scrolling.has_value())
+        {
+            rtn.emplace(*opts.smooth_scrolling ? "--enable-smooth-scrolling" : "--disable-smooth-scrolling");
+        }
+
+        if (opts.accessibility.has_value())
+        {
+            rtn.emplace(*opts.accessibility ? "--force-renderer-accessibility" : "--disable-renderer-accessibility");
+        }
+
+        if (opts.pinch_zoom == false)
+        {
+            rtn.emplace("--disable-pinch");
+        }
+
+        return rtn;
+    }
+
+    webview::options impl::headless(options opts)
+    {
+        opts.headless              = false;
+        opts.offscreen             = true;
+        opts.attributes            = false;
+        opts.native_regions        = false;
+        opts.hardware_acceleration = false;
+        opts.back_forward_cache    = false;
+
+        // Workers rarely revisit resources, so the engine is kept from holding on to decoded pages and images
+        opts.cache_model = opts.cache_model.value_or(cache_model::document_viewer);
+
+        return opts;
+    }
+
+    std::optional<std::string> impl::origin_host(const std::string &origin)
+    {
+        auto parsed = url_view::parse(origin);
+
+        if (!parsed.has_value())
+        {
+            return std::nullopt;
+        }
+
+        auto host = parsed->host();
+
+        if (!host.has_value() || host->empty())
+        {
+            return std::nullopt;
+        }
+
+        return std::string{*host};
+    }
+
+    bool impl::same_site(std::string_view host, std::string_view domain)
+    {
+        if (!host.ends_with(domain))
+        {
+            return false;
+        }
+
+        // Engines group their records by registrable domain, which also covers all of its subdomains
+        return host.size() == domain.size() || host[host.size() - domain.size() - 1] == '.';
+    }
+
+    saucer::size impl::fit(saucer::size source, saucer::size bounds)
+    {
+        if (source.w <= 0 || source.h <= 0 || bounds.w <= 0 || bounds.h <= 0)
+        {
+            return source;
+        }
+
+        const auto scale = std::min(static_cast<double>(bounds.w) / source.w, static_cast<double>(bounds.h) / source.h);
+
+        return {
+            .w = std::max(1, static_cast<int>(source.w * scale)),
+            .h = std::max(1, static_cast<int>(source.h * scale)),
+        };
+    }
+
+    std::string impl::content_pattern(std::string_view wildcard)
+    {
+        static constexpr auto special = std::string_view{R"(\^$.|+()[]{})"};
+
+        std::string rtn{"^"};
+
+        for (const auto ch : wildcard)
+        {
+            if (ch == '*')
+            {
+                rtn += ".*";
+                continue;
+            }
+
+            if (ch == '?')
+            {
+                rtn += '.';
+                continue;
+            }
+
+            if (special.contains(ch))
+            {
+                rtn += '\\';
+            }
+
+            rtn += ch;
+        }
+
+        return rtn + "$";
+    }
+
+    std::string impl::content_rule_list(const std::vector<std::string> &block)
+    {
+        std::string rtn{"["};
+
+        for (const auto &wildcard : block)
+        {
+            auto pattern = std::string{};
+
+            for (const auto ch : content_pattern(wildcard))
+            {
+                if (ch == '\\' || ch == '"')
+                {
+                    pattern += '\\';
+                }
+
+                pattern += ch;
+            }
+
+            std::format_to(std::back_inserter(rtn), R"({}{{"trigger":{{"url-filter":"{}"}},"action":{{"type":"block"}}}})",
+                           rtn.size() > 1 ? "," : "", pattern);
+        }
+
+        return rtn + "]";
+    }
 } // namespace saucer
@@ -1,6 +1,8 @@
 #include "win32.app.impl.hpp"
 #include "win32.error.hpp"
 
+#include <algorithm>
+
 namespace saucer
 {
     using impl = application::impl;
@@ -52,6 +54,8 @@ namespace saucer
             return err(GetLastError());
         }
 
+        SetWindowLongPtrW(platform->msg_window.get(), GWLP_USERDATA, reinterpret_cast<LONG_PTR>(this));
+
         utils::set_dpi_awareness();
         CoInitializeEx(nullptr, COINIT_APARTMENTTHREADED);
 
@@ -80,10 +84,34 @@ namespace saucer
         return rtn;
     }
 
-    void application::post(post_callback_t callback) const
+    void impl::wake(priority)
+    {
+        PostMessageW(platform->msg_window.get(), native::WM_SAFE_CALL, 0, 0);
+    }
+
+    void impl::start_timer(std::size_t id, std::chrono::milliseconds interval, timer_precision precision, bool) // NOLINT(*-const)
+    {
+        const auto elapse = static_cast<UINT>(std::clamp<std::int64_t>(interval.count(), USER_TIMER_MINIMUM, USER_TIMER_MAXIMUM));
+        ULONG tolerance   = TIMERV_NO_COALESCING;
+
+        switch (precision)
+        {
+        case timer_precision::precise:
+            break;
+        case timer_precision::coarse:
+            tolerance = std::max<ULONG>(elapse / 20, 1);
+            break;
+        case timer_precision::very_coarse:
+            tolerance = 1000;
+            break;
+        }
+
+        SetCoalescableTimer(platform->msg_window.get(), id, elapse, nullptr, tolerance);
+    }
+
+    void impl::stop_timer(std::size_t id) // NOLINT(*-const)
     {
-        auto *message = new safe_message{std::move(callback)};
-        PostMessageW(m_impl->platform->msg_window.get(), impl::native::WM_SAFE_CALL, 0, reinterpret_cast<LPARAM>(message));
+        KillTimer(platform->msg_window.get(), id);
     }
 
     int impl::run(application *self, callback_t callback) // NOLINT(*-static)
@@ -106,6 +134,33 @@ namespace saucer
         return 0;
     }
 
+    poll_set impl::prepare() // NOLINT(*-static)
+    {
+        const auto pending = HIWORD(GetQueueStatus(QS_ALLINPUT)) != 0;
+        return {.timeout = pending ? std::make_optional(std::chrono::milliseconds{0}) : std::nullopt, .messages = true};
+    }
+
+    bool impl::process(const poll_set &) // NOLINT(*-static)
+    {
+        MSG msg{};
+        auto rtn = false;
+
+        while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE))
+        {
+            if (msg.message == WM_QUIT)
+            {
+                break;
+            }
+
+            TranslateMessage(&msg);
+            DispatchMessage(&msg);
+
+            rtn = true;
+        }
+
+        return rtn;
+    }
+
     void impl::quit() // NOLINT(*-static)
     {
         PostQuitMessage(0);
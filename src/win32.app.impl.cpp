@@ -28,12 +28,25 @@ namespace saucer
 
     LRESULT CALLBACK native::wnd_proc(HWND hwnd, UINT msg, WPARAM w_param, LPARAM l_param)
     {
+        if (msg == WM_TIMER)
+        {
+            auto *const self = reinterpret_cast<application::impl *>(GetWindowLongPtrW(hwnd, GWLP_USERDATA));
+
+            if (!self->fire(w_param))
+            {
+                KillTimer(hwnd, w_param);
+            }
+
+            return 0;
+        }
+
         if (msg != WM_SAFE_CALL)
         {
             return DefWindowProcW(hwnd, msg, w_param, l_param);
         }
 
-        delete reinterpret_cast<safe_message *>(l_param);
+        // Messages to a destroyed window are dropped, so the wake-up never outlives the application it was posted to
+        reinterpret_cast<application::impl *>(GetWindowLongPtrW(hwnd, GWLP_USERDATA))->queue.drain();
 
         return 0;
     }
@@ -59,11 +72,4 @@ namespace saucer
 
         return TRUE;
     }
-
-    safe_message::safe_message(callback_t callback) : m_callback(std::move(callback)) {}
-
-    safe_message::~safe_message()
-    {
-        m_callback();
-    }
 } // namespace saucer
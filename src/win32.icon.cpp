@@ -50,21 +50,26 @@ namespace saucer
             return stash::empty();
         }
 
-        ComPtr<IStream> stream;
-
-        if (!SUCCEEDED(CreateStreamOnHGlobal(nullptr, true, &stream)))
+        auto encode = [bitmap = m_impl->bitmap.get()]
         {
-            return stash::empty();
-        }
+            ComPtr<IStream> stream;
+
+            if (!SUCCEEDED(CreateStreamOnHGlobal(nullptr, true, &stream)))
+            {
+                return std::vector<std::uint8_t>{};
+            }
+
+            bitmap->Save(stream.Get(), &png_encoder);
 
-        m_impl->bitmap->Save(stream.Get(), &png_encoder);
+            LARGE_INTEGER pos;
+            pos.QuadPart = 0;
 
-        LARGE_INTEGER pos;
-        pos.QuadPart = 0;
+            stream->Seek(pos, STREAM_SEEK_SET, nullptr);
 
-        stream->Seek(pos, STREAM_SEEK_SET, nullptr);
+            return utils::read(stream.Get());
+        };
 
-        return stash::from(utils::read(stream.Get()));
+        return m_impl->png.get(encode);
     }
 
     void icon::save(const fs::path &path) const
@@ -9,6 +9,15 @@
 #include <windows.ui.composition.interop.h>
 
 #include <ranges>
+#include <algorithm>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <emmintrin.h>
+#define SAUCER_SSE2
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#include <arm_neon.h>
+#define SAUCER_NEON
+#endif
 
 namespace saucer
 {
@@ -118,6 +127,19 @@ namespace saucer
         call_as<decltype(DwmExtendFrameIntoClientArea)>(func, hwnd, &margins);
     }
 
+    bool utils::wait_for_vblank()
+    {
+        static const auto dwmapi = module_handle{LoadLibraryW(L"Dwmapi.dll")};
+        static auto *const func  = GetProcAddress(dwmapi.get(), "DwmFlush");
+
+        if (!func)
+        {
+            return false;
+        }
+
+        return SUCCEEDED(call_as<decltype(DwmFlush)>(func));
+    }
+
     OSVERSIONINFOEXW utils::version()
     {
         auto ntdll = module_handle{LoadLibraryW(L"ntdll.dll")};
@@ -134,34 +156,150 @@ namespace saucer
         return rtn;
     }
 
-    std::wstring utils::widen(std::string_view narrow)
+    static std::size_t widen_ascii(const char *in, std::size_t size, wchar_t *out)
     {
-        auto size = MultiByteToWideChar(CP_UTF8, 0, narrow.data(), static_cast<int>(narrow.size()), nullptr, 0);
+        std::size_t i = 0;
 
-        if (!size)
+#if defined(SAUCER_SSE2)
+        const auto zero = _mm_setzero_si128();
+
+        for (; i + 16 <= size; i += 16)
         {
-            return {};
+            const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+
+            if (_mm_movemask_epi8(chunk) != 0)
+            {
+                break;
+            }
+
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_unpacklo_epi8(chunk, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i + 8), _mm_unpackhi_epi8(chunk, zero));
         }
+#elif defined(SAUCER_NEON)
+        for (; i + 16 <= size; i += 16)
+        {
+            const auto chunk = vld1q_u8(reinterpret_cast<const std::uint8_t *>(in + i));
 
-        std::wstring out(size, '\0');
-        MultiByteToWideChar(CP_UTF8, MB_ERR_INVALID_CHARS, narrow.data(), static_cast<int>(narrow.size()), out.data(), size);
+            if (vmaxvq_u8(chunk) >= 0x80)
+            {
+                break;
+            }
 
-        return out;
+            vst1q_u16(reinterpret_cast<std::uint16_t *>(out + i), vmovl_u8(vget_low_u8(chunk)));
+            vst1q_u16(reinterpret_cast<std::uint16_t *>(out + i + 8), vmovl_high_u8(chunk));
+        }
+#endif
+
+        for (; i < size && static_cast<unsigned char>(in[i]) < 0x80; i++)
+        {
+            out[i] = static_cast<wchar_t>(in[i]);
+        }
+
+        return i;
     }
 
-    std::string utils::narrow(std::wstring_view wide)
+    static std::size_t narrow_ascii(const wchar_t *in, std::size_t size, char *out)
     {
-        auto size = WideCharToMultiByte(CP_UTF8, 0, wide.data(), static_cast<int>(wide.size()), nullptr, 0, nullptr, nullptr);
+        std::size_t i = 0;
+
+#if defined(SAUCER_SSE2)
+        const auto zero = _mm_setzero_si128();
+        const auto mask = _mm_set1_epi16(static_cast<short>(0xFF80));
 
-        if (!size)
+        for (; i + 16 <= size; i += 16)
         {
-            return {};
+            const auto low  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+            const auto high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i + 8));
+            const auto wide = _mm_and_si128(_mm_or_si128(low, high), mask);
+
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(wide, zero)) != 0xFFFF)
+            {
+                break;
+            }
+
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_packus_epi16(low, high));
         }
+#elif defined(SAUCER_NEON)
+        for (; i + 16 <= size; i += 16)
+        {
+            const auto low  = vld1q_u16(reinterpret_cast<const std::uint16_t *>(in + i));
+            const auto high = vld1q_u16(reinterpret_cast<const std::uint16_t *>(in + i + 8));
 
-        std::string out(size, '\0');
-        WideCharToMultiByte(CP_UTF8, 0, wide.data(), static_cast<int>(wide.size()), out.data(), size, nullptr, nullptr);
+            if (vmaxvq_u16(vorrq_u16(low, high)) >= 0x80)
+            {
+                break;
+            }
+
+            vst1q_u8(reinterpret_cast<std::uint8_t *>(out + i), vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+        }
+#endif
+
+        for (; i < size && in[i] < 0x80; i++)
+        {
+            out[i] = static_cast<char>(in[i]);
+        }
 
-        return out;
+        return i;
+    }
+
+    void utils::widen(std::string_view narrow, std::wstring &out)
+    {
+        // A single UTF-8 byte never yields more than one UTF-16 code unit, which lets us skip the sizing pass
+        auto convert = [narrow](wchar_t *data, std::size_t capacity)
+        {
+            auto done = widen_ascii(narrow.data(), narrow.size(), data);
+
+            if (done == narrow.size())
+            {
+                return done;
+            }
+
+            const auto rest    = narrow.substr(done);
+            const auto written = MultiByteToWideChar(CP_UTF8, 0, rest.data(), static_cast<int>(rest.size()), data + done,
+                                                     static_cast<int>(capacity - done));
+
+            return done + static_cast<std::size_t>(std::max(written, 0));
+        };
+
+        out.resize_and_overwrite(narrow.size(), convert);
+    }
+
+    void utils::narrow(std::wstring_view wide, std::string &out)
+    {
+        // Every UTF-16 code unit expands to at most three UTF-8 bytes, surrogate pairs take four bytes for two units
+        auto convert = [wide](char *data, std::size_t capacity)
+        {
+            auto done = narrow_ascii(wide.data(), wide.size(), data);
+
+            if (done == wide.size())
+            {
+                return done;
+            }
+
+            const auto rest    = wide.substr(done);
+            const auto written = WideCharToMultiByte(CP_UTF8, 0, rest.data(), static_cast<int>(rest.size()), data + done,
+                                                     static_cast<int>(capacity - done), nullptr, nullptr);
+
+            return done + static_cast<std::size_t>(std::max(written, 0));
+        };
+
+        out.resize_and_overwrite(wide.size() * 3, convert);
+    }
+
+    std::wstring utils::widen(std::string_view narrow)
+    {
+        std::wstring rtn;
+        widen(narrow, rtn);
+
+        return rtn;
+    }
+
+    std::string utils::narrow(std::wstring_view wide)
+    {
+        std::string rtn;
+        narrow(wide, rtn);
+
+        return rtn;
     }
 
     std::vector<std::uint8_t> utils::read(IStream *stream)
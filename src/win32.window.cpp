@@ -6,8 +6,11 @@
 #include "win32.app.impl.hpp"
 #include "win32.icon.impl.hpp"
 
+#include "threads.hpp"
 #include "instantiate.hpp"
 
+#include <chrono>
+#include <thread>
 #include <cassert>
 
 #include <dwmapi.h>
@@ -95,6 +98,52 @@ namespace saucer
     {
     }
 
+    template <>
+    void impl::setup<window::event::frame>()
+    {
+        auto &event = events.get<event::frame>();
+
+        if (!event.empty())
+        {
+            return;
+        }
+
+        auto fire = [](impl *self)
+        {
+            self->platform->frame_pending = false;
+
+            if (self->minimized() || !self->visible())
+            {
+                return;
+            }
+
+            self->events.get<event::frame>().fire();
+        };
+
+        auto loop = [this, native = platform.get(), fire](const std::stop_token &token)
+        {
+            utils::apply(utils::thread_role::helper);
+
+            while (!token.stop_requested())
+            {
+                if (!utils::wait_for_vblank())
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(16));
+                }
+
+                if (native->frame_pending.exchange(true))
+                {
+                    continue;
+                }
+
+                parent->post(utils::defer(lease, fire));
+            }
+        };
+
+        platform->frame_thread = std::jthread{loop};
+        event.on_clear([this] { platform->frame_thread = {}; });
+    }
+
     bool impl::visible() const
     {
         return IsWindowVisible(platform->hwnd.get());
@@ -229,6 +278,12 @@ namespace saucer
     void impl::show() const
     {
         parent->native<false>()->platform->instances[platform->hwnd.get()] = true;
+
+        if (offscreen)
+        {
+            return;
+        }
+
         ShowWindow(platform->hwnd.get(), SW_SHOW);
     }
 
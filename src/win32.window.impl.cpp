@@ -228,7 +228,7 @@ namespace saucer
 
             const auto [w, h] = self->platform->scale<mode::sub>({.w = width, .h = height});
 
-            self->events.get<event::resize>().fire(w, h);
+            self->resized(w, h);
             self->platform->window_target.Root().Size({static_cast<float>(width), static_cast<float>(height)});
 
             break;
@@ -262,6 +262,9 @@ namespace saucer
 
             return 0;
         }
+        case WM_DISPLAYCHANGE:
+            self->parent->native<false>()->screens_changed();
+            break;
         case WM_DPICHANGED:
             const auto size     = self->size();
             self->platform->dpi = HIWORD(w_param);
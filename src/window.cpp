@@ -1,10 +1,14 @@
 #include "window.impl.hpp"
 
+#include "app.impl.hpp"
 #include "error.impl.hpp"
 
 #include "invoke.hpp"
+#include "dispatch.hpp"
 #include "instantiate.hpp"
 
+#include <utility>
+
 namespace saucer
 {
     window::window(application *app) : m_impl(detail::make_safe<impl>(app))
@@ -12,21 +16,43 @@ namespace saucer
         m_events = &m_impl->events;
     }
 
-    result<std::shared_ptr<window>> window::create(application *parent)
+    result<std::shared_ptr<window>> window::create(application *parent, const properties &props)
     {
         if (!parent->thread_safe())
         {
-            return parent->invoke(&window::create, parent);
+            return parent->invoke(&window::create, parent, props);
         }
 
+        const auto start = trace_clock::now();
+
         auto rtn            = std::shared_ptr<window>{new window{parent}};
         rtn->m_impl->parent = parent;
+        rtn->m_impl->lease  = utils::lease{rtn->m_impl.get()};
 
         if (auto status = rtn->m_impl->init_platform(); !status.has_value())
         {
             return err(status);
         }
 
+        rtn->m_impl->apply(props);
+
+        parent->native<false>()->record(startup_phase::window, start);
+
+        return rtn;
+    }
+
+    coco::future<result<std::shared_ptr<window>>> window::create_async(application *parent, const properties &props)
+    {
+        auto promise = coco::promise<result<std::shared_ptr<window>>>{};
+        auto rtn     = promise.get_future();
+
+        auto task = [parent, props, promise = std::move(promise)]() mutable
+        {
+            promise.set_value(create(parent, props));
+        };
+
+        parent->post(std::move(task));
+
         return rtn;
     }
 
@@ -35,6 +61,31 @@ namespace saucer
         utils::invoke([](auto *impl) { impl->events.clear(true); }, m_impl.get());
     }
 
+    coco::future<void> window::destroy()
+    {
+        auto promise = coco::promise<void>{};
+        auto rtn     = promise.get_future();
+
+        if (!m_impl)
+        {
+            promise.set_value();
+            return rtn;
+        }
+
+        auto *const parent = m_impl->parent;
+
+        auto task = [impl = std::move(m_impl), promise = std::move(promise)]() mutable
+        {
+            impl->events.clear(true);
+            impl.reset();
+            promise.set_value();
+        };
+
+        parent->dispatch(std::move(task));
+
+        return rtn;
+    }
+
     template <window::event Event>
     void window::setup()
     {
@@ -128,12 +179,12 @@ namespace saucer
 
     void window::hide()
     {
-        return utils::invoke<&impl::hide>(m_impl.get());
+        return utils::dispatch<&impl::hide>(m_impl.get());
     }
 
     void window::show()
     {
-        return utils::invoke<&impl::show>(m_impl.get());
+        return utils::dispatch<&impl::show>(m_impl.get());
     }
 
     void window::close()
@@ -143,7 +194,7 @@ namespace saucer
 
     void window::focus()
     {
-        return utils::invoke<&impl::focus>(m_impl.get());
+        return utils::dispatch<&impl::focus>(m_impl.get());
     }
 
     void window::start_drag()
@@ -158,72 +209,155 @@ namespace saucer
 
     void window::set_minimized(bool enabled)
     {
-        return utils::invoke<&impl::set_minimized>(m_impl.get(), enabled);
+        return utils::dispatch<&impl::set_minimized>(m_impl.get(), enabled);
     }
 
     void window::set_maximized(bool enabled)
     {
-        return utils::invoke<&impl::set_maximized>(m_impl.get(), enabled);
+        return utils::dispatch<&impl::set_maximized>(m_impl.get(), enabled);
     }
 
     void window::set_resizable(bool enabled)
     {
-        return utils::invoke<&impl::set_resizable>(m_impl.get(), enabled);
+        return utils::dispatch<&impl::set_resizable>(m_impl.get(), enabled);
     }
 
     void window::set_fullscreen(bool enabled)
     {
-        return utils::invoke<&impl::set_fullscreen>(m_impl.get(), enabled);
+        return utils::dispatch<&impl::set_fullscreen>(m_impl.get(), enabled);
     }
 
     void window::set_always_on_top(bool enabled)
     {
-        return utils::invoke<&impl::set_always_on_top>(m_impl.get(), enabled);
+        return utils::dispatch<&impl::set_always_on_top>(m_impl.get(), enabled);
     }
 
     void window::set_click_through(bool enabled)
     {
-        return utils::invoke<&impl::set_click_through>(m_impl.get(), enabled);
+        return utils::dispatch<&impl::set_click_through>(m_impl.get(), enabled);
+    }
+
+    void window::set_coalesce_resize(bool enabled)
+    {
+        m_impl->coalesce_resize.store(enabled, std::memory_order_relaxed);
     }
 
     void window::set_icon(const icon &icon)
     {
-        return utils::invoke<&impl::set_icon>(m_impl.get(), icon);
+        return utils::dispatch<&impl::set_icon>(m_impl.get(), icon);
     }
 
     void window::set_title(cstring_view title)
     {
-        return utils::invoke<&impl::set_title>(m_impl.get(), title);
+        return utils::dispatch<&impl::set_title>(m_impl.get(), title);
     }
 
     void window::set_background(color background)
     {
-        return utils::invoke<&impl::set_background>(m_impl.get(), background);
+        return utils::dispatch<&impl::set_background>(m_impl.get(), background);
     }
 
     void window::set_decorations(decoration decoration)
     {
-        return utils::invoke<&impl::set_decorations>(m_impl.get(), decoration);
+        return utils::dispatch<&impl::set_decorations>(m_impl.get(), decoration);
     }
 
     void window::set_size(saucer::size size)
     {
-        return utils::invoke<&impl::set_size>(m_impl.get(), size);
+        return utils::dispatch<&impl::set_size>(m_impl.get(), size);
     }
 
     void window::set_max_size(saucer::size size)
     {
-        return utils::invoke<&impl::set_max_size>(m_impl.get(), size);
+        return utils::dispatch<&impl::set_max_size>(m_impl.get(), size);
     }
 
     void window::set_min_size(saucer::size size)
     {
-        return utils::invoke<&impl::set_min_size>(m_impl.get(), size);
+        return utils::dispatch<&impl::set_min_size>(m_impl.get(), size);
     }
 
     void window::set_position(saucer::position position)
     {
-        return utils::invoke<&impl::set_position>(m_impl.get(), position);
+        return utils::dispatch<&impl::set_position>(m_impl.get(), position);
+    }
+
+    void window::apply(properties props)
+    {
+        return utils::dispatch<&impl::apply>(m_impl.get(), std::move(props));
+    }
+
+    void window::impl::apply(const properties &props)
+    {
+        if (props.decorations)
+        {
+            set_decorations(*props.decorations);
+        }
+
+        if (props.background)
+        {
+            set_background(*props.background);
+        }
+
+        if (props.resizable)
+        {
+            set_resizable(*props.resizable);
+        }
+
+        if (props.min_size)
+        {
+            set_min_size(*props.min_size);
+        }
+
+        if (props.max_size)
+        {
+            set_max_size(*props.max_size);
+        }
+
+        if (props.size)
+        {
+            set_size(*props.size);
+        }
+
+        if (props.position)
+        {
+            set_position(*props.position);
+        }
+
+        if (props.title)
+        {
+            set_title(*props.title);
+        }
+
+        if (props.icon)
+        {
+            set_icon(*props.icon);
+        }
+
+        if (props.always_on_top)
+        {
+            set_always_on_top(*props.always_on_top);
+        }
+
+        if (props.click_through)
+        {
+            set_click_through(*props.click_through);
+        }
+
+        if (props.maximized)
+        {
+            set_maximized(*props.maximized);
+        }
+
+        if (props.minimized)
+        {
+            set_minimized(*props.minimized);
+        }
+
+        if (props.fullscreen)
+        {
+            set_fullscreen(*props.fullscreen);
+        }
     }
 
     void window::off(event event)
@@ -236,5 +370,29 @@ namespace saucer
         return utils::invoke([event, id](auto *impl) { impl->events.remove(event, id); }, m_impl.get());
     }
 
+    void window::impl::resized(int width, int height)
+    {
+        if (!coalesce_resize.load(std::memory_order_relaxed))
+        {
+            events.get<event::resize>().fire(width, height);
+            return;
+        }
+
+        if (std::exchange(resize_pending, true))
+        {
+            return;
+        }
+
+        auto flush = [](impl *self)
+        {
+            self->resize_pending = false;
+
+            auto [width, height] = self->size();
+            self->events.get<event::resize>().fire(width, height);
+        };
+
+        parent->post(utils::defer(lease, flush));
+    }
+
     SAUCER_INSTANTIATE_WINDOW_EVENTS(SAUCER_INSTANTIATE_WINDOW_EVENT);
 } // namespace saucer
@@ -13,6 +13,7 @@ namespace saucer::permission
 
     request::~request()
     {
+        m_impl->decided = nullptr;
         accept(false);
     }
 
@@ -49,5 +50,10 @@ namespace saucer::permission
         auto handler = std::move(m_impl->handler);
 
         (handler.get())(value ? WKPermissionDecisionGrant : WKPermissionDecisionDeny);
+
+        if (auto decided = std::exchange(m_impl->decided, nullptr); decided)
+        {
+            decided(value);
+        }
     }
 } // namespace saucer::permission
@@ -1,10 +1,24 @@
 #include "wk.scheme.impl.hpp"
 
+#include "scheme.utils.hpp"
+
 #include <dispatch/dispatch.h>
 
 using namespace saucer;
 using namespace saucer::scheme;
 
+static NSData *wrap(stash data)
+{
+    auto *const owner = new stash{std::move(data)};
+    auto *const bytes = const_cast<std::uint8_t *>(owner->data());
+
+    return [[NSData alloc] initWithBytesNoCopy:bytes
+                                        length:owner->size()
+                                   deallocator:^(void *, NSUInteger) {
+                                       delete owner;
+                                   }];
+}
+
 stream_writer::stream_writer(std::shared_ptr<impl> impl) : m_impl(std::move(impl)) {}
 
 stream_writer::stream_writer(const stream_writer &) = default;
@@ -64,11 +78,11 @@ void stream_writer::start(const stream_response &response)
     });
 }
 
-void stream_writer::write(stash data)
+write_status stream_writer::write(stash data)
 {
     if (!m_impl || !m_impl->started || m_impl->finished)
     {
-        return;
+        return write_status::closed;
     }
 
     task_ref task_copy;
@@ -76,19 +90,18 @@ void stream_writer::write(stash data)
         auto tasks = m_impl->tasks->read();
         if (!tasks->contains(m_impl->handle))
         {
-            return;
+            return write_status::closed;
         }
         task_copy = tasks->at(m_impl->handle);
     }
 
-    auto data_copy = std::vector<std::uint8_t>(data.data(), data.data() + data.size());
+    utils::metrics::get().scheme_bytes.fetch_add(data.size(), std::memory_order_relaxed);
+
+    auto *const ns_data = wrap(std::move(data).owned());
 
     dispatch_async(dispatch_get_main_queue(), ^{
         const utils::autorelease_guard guard{};
 
-        auto *const ns_data = [NSData dataWithBytes:data_copy.data()
-                                             length:static_cast<NSInteger>(data_copy.size())];
-
         @try
         {
             [task_copy.get() didReceiveData:ns_data];
@@ -96,7 +109,16 @@ void stream_writer::write(stash data)
         @catch (NSException *)
         {
         }
+
+        [ns_data release];
     });
+
+    return write_status::written;
+}
+
+write_status stream_writer::write_file(int fd, std::size_t offset, std::size_t length)
+{
+    return utils::write_file(*this, fd, offset, length);
 }
 
 void stream_writer::finish()
@@ -201,7 +223,7 @@ bool stream_writer::valid() const
 {
     const utils::autorelease_guard guard{};
 
-    if (self->m_stream_callbacks.contains(instance))
+    if (const auto stream = self->m_stream_callbacks.find(instance); stream != self->m_stream_callbacks.end())
     {
         auto ref = task_ref::ref(task);
 
@@ -219,11 +241,13 @@ bool stream_writer::valid() const
         auto writer = stream_writer{writer_impl};
         auto req    = scheme::request{{ref}};
 
-        return self->m_stream_callbacks[instance](std::move(req), std::move(writer));
+        return stream->second(std::move(req), std::move(writer));
     }
 
     // Regular callback handling
-    if (!self->m_callbacks.contains(instance))
+    const auto callback = self->m_callbacks.find(instance);
+
+    if (callback == self->m_callbacks.end())
     {
         return;
     }
@@ -236,7 +260,7 @@ bool stream_writer::valid() const
         return locked->emplace(task.hash, ref).first->first;
     }();
 
-    auto resolve = [self, handle](const scheme::response &response)
+    auto resolve = [self, handle](scheme::response response)
     {
         const utils::autorelease_guard guard{};
 
@@ -248,9 +272,9 @@ bool stream_writer::valid() const
         }
 
         auto task          = tasks->at(handle);
-        const auto content = response.data;
+        const auto size    = response.data.size();
 
-        auto *const data    = [NSData dataWithBytes:content.data() length:static_cast<NSInteger>(content.size())];
+        auto *const data    = [wrap(std::move(response.data)) autorelease];
         auto *const headers = [[[NSMutableDictionary<NSString *, NSString *> alloc] init] autorelease];
 
         for (const auto &[key, value] : response.headers)
@@ -259,7 +283,7 @@ bool stream_writer::valid() const
         }
 
         auto *const mime   = [NSString stringWithUTF8String:response.mime.c_str()];
-        auto *const length = [NSString stringWithFormat:@"%zu", content.size()];
+        auto *const length = [NSString stringWithFormat:@"%zu", size];
 
         [headers setObject:mime forKey:@"Content-Type"];
         [headers setObject:length forKey:@"Content-Length"];
@@ -297,7 +321,7 @@ bool stream_writer::valid() const
     auto req      = scheme::request{{ref}};
     auto executor = scheme::executor{std::move(resolve), std::move(reject)};
 
-    return self->m_callbacks[instance](std::move(req), std::move(executor));
+    return callback->second(std::move(req), std::move(executor));
 }
 
 - (void)webView:(nonnull WKWebView *)webview stopURLSchemeTask:(nonnull id<WKURLSchemeTask>)task
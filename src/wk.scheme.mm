@@ -2,11 +2,11 @@
 
 #include "wk.url.impl.hpp"
 
+#include <algorithm>
+
 namespace saucer::scheme
 {
-    request::request(impl data) : m_impl(std::make_unique<impl>(std::move(data))) {}
-
-    request::request(const request &other) : request(*other.m_impl) {}
+    request::request(impl data) : m_impl(std::make_shared<impl>(std::move(data))) {}
 
     request::request(request &&) noexcept = default;
 
@@ -35,11 +35,59 @@ namespace saucer::scheme
         return stash::from({raw, raw + body.length});
     }
 
-    std::map<std::string, std::string> request::headers() const
+    std::size_t request::read(std::span<std::uint8_t> buffer) const
     {
-        auto *const headers = m_impl->task.get().request.allHTTPHeaderFields;
+        auto *const request = m_impl->task.get().request;
+
+        if (auto *const body = request.HTTPBody; body)
+        {
+            const auto count = std::min(static_cast<std::size_t>(body.length) - m_impl->offset, buffer.size());
+
+            [body getBytes:buffer.data() range:NSMakeRange(m_impl->offset, count)];
+            m_impl->offset += count;
+
+            return count;
+        }
 
-        std::map<std::string, std::string> rtn;
+        if (!m_impl->stream && request.HTTPBodyStream)
+        {
+            m_impl->stream = utils::objc_ptr<NSInputStream>::ref(request.HTTPBodyStream);
+            [m_impl->stream.get() open];
+        }
+
+        if (!m_impl->stream)
+        {
+            return 0;
+        }
+
+        const auto read = [m_impl->stream.get() read:buffer.data() maxLength:buffer.size()];
+        return read > 0 ? static_cast<std::size_t>(read) : 0;
+    }
+
+    std::optional<std::string> request::header(std::string_view name) const
+    {
+        const utils::autorelease_guard guard{};
+
+        auto *const key   = [[[NSString alloc] initWithBytes:name.data() length:name.size() encoding:NSUTF8StringEncoding] autorelease];
+        auto *const value = [m_impl->task.get().request valueForHTTPHeaderField:key];
+
+        if (!value)
+        {
+            return std::nullopt;
+        }
+
+        return value.UTF8String;
+    }
+
+    const std::map<std::string, std::string> &request::headers() const
+    {
+        if (m_impl->headers)
+        {
+            return *m_impl->headers;
+        }
+
+        auto *const headers = m_impl->task.get().request.allHTTPHeaderFields;
+        auto &rtn           = m_impl->headers.emplace();
 
         [headers enumerateKeysAndObjectsUsingBlock:[&rtn](NSString *key, NSString *value, BOOL *)
                  {
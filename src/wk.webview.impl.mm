@@ -46,6 +46,11 @@ namespace saucer
         event.on_clear([this, observer] { [web_view.get() removeObserver:observer.get() forKeyPath:@"fullscreenState"]; });
     }
 
+    template <>
+    void native::setup<event::process_gone>(impl *)
+    {
+    }
+
     template <>
     void native::setup<event::dom_ready>(impl *)
     {
@@ -102,29 +107,57 @@ namespace saucer
 
         const utils::objc_ptr<Observer> observer = [[Observer alloc] initWithCallback:[self]
                                                                      {
-                                                                         self->events.get<event::title>().fire(self->page_title());
+                                                                         self->title_changed();
                                                                      }];
 
         [web_view.get() addObserver:observer.get() forKeyPath:@"title" options:0 context:nullptr];
         event.on_clear([this, observer] { [web_view.get() removeObserver:observer.get() forKeyPath:@"title"]; });
     }
 
+    template <>
+    void native::setup<event::timing>(impl *)
+    {
+    }
+
     template <>
     void native::setup<event::load>(impl *)
     {
     }
 
     void native::inject(const script &script) const
+    {
+        const auto guard = utils::autorelease_guard{};
+        [controller addUserScript:compile(script).get()];
+    }
+
+    utils::objc_ptr<WKUserScript> native::compile(const script &script)
     {
         using enum script::time;
 
-        const auto guard = utils::autorelease_guard{};
-        const auto time  = script.run_at == creation ? WKUserScriptInjectionTimeAtDocumentStart : WKUserScriptInjectionTimeAtDocumentEnd;
+        const auto time = script.run_at == creation ? WKUserScriptInjectionTimeAtDocumentStart : WKUserScriptInjectionTimeAtDocumentEnd;
+
+        auto make = [&]
+        {
+            auto *const source = [NSString stringWithUTF8String:script.code.c_str()];
+            auto *world        = WKContentWorld.pageWorld;
+
+            if (script.world.has_value())
+            {
+                world = [WKContentWorld worldWithName:[NSString stringWithUTF8String:script.world->c_str()]];
+            }
+
+            return utils::objc_ptr<WKUserScript>{[[WKUserScript alloc] initWithSource:source
+                                                                        injectionTime:time
+                                                                     forMainFrameOnly:static_cast<BOOL>(script.no_frames)
+                                                                       inContentWorld:world]};
+        };
+
+        if (script.clearable)
+        {
+            return make();
+        }
 
-        auto *const user_script = [[[WKUserScript alloc] initWithSource:[NSString stringWithUTF8String:script.code.c_str()]
-                                                          injectionTime:time
-                                                       forMainFrameOnly:static_cast<BOOL>(script.no_frames)] autorelease];
-        [controller addUserScript:user_script];
+        return compiled.get(script, make);
     }
 
     WKWebViewConfiguration *native::make_config(const options &opts)
@@ -223,6 +256,21 @@ namespace saucer
         return config;
     }
 
+    std::shared_ptr<utils::objc_ptr<WKWebsiteDataStore>> native::ephemeral_store(const std::optional<std::string> &session)
+    {
+        auto make = []
+        {
+            return utils::objc_ptr<WKWebsiteDataStore>::ref([WKWebsiteDataStore nonPersistentDataStore]);
+        };
+
+        if (!session.has_value())
+        {
+            return std::make_shared<utils::objc_ptr<WKWebsiteDataStore>>(make());
+        }
+
+        return sessions.join(*session, make);
+    }
+
     NSUUID *native::data_store_id(const options &opts, const std::string &id)
     {
         if (opts.storage_path)
@@ -256,29 +304,39 @@ using namespace saucer;
 
     const id body = raw.body;
 
-    if (![body isKindOfClass:[NSString class]])
+    std::string_view message;
+    NSData *json = nil;
+
+    if ([body isKindOfClass:[NSString class]])
     {
-        return;
+        message = static_cast<NSString *>(body).UTF8String;
+    }
+    else if ([NSJSONSerialization isValidJSONObject:body])
+    {
+        json    = [NSJSONSerialization dataWithJSONObject:body options:0 error:nil];
+        message = {static_cast<const char *>(json.bytes), json.length};
     }
 
-    std::string message{static_cast<NSString *>(body).UTF8String};
+    if (message.empty())
+    {
+        return;
+    }
 
-    if (message == "dom_loaded")
+    if (!message.starts_with('{') && message == "dom_loaded")
     {
         me->platform->dom_loaded = true;
 
-        for (const auto &pending : me->platform->pending)
+        for (const auto &script : std::exchange(me->platform->pending, {}))
         {
-            me->execute(pending);
+            me->execute(script);
         }
 
-        me->platform->pending.clear();
         me->events.get<event::dom_ready>().fire();
 
         return;
     }
 
-    me->events.get<event::message>().fire(message).find(status::handled);
+    me->dispatch(message);
 }
 @end
 
@@ -343,6 +401,12 @@ using namespace saucer;
         .type    = type,
     });
 
+    if (me->remembered(*req))
+    {
+        return;
+    }
+
+    req->native<false>()->decided = me->recorder(*req);
     me->events.get<event::permission>().fire(req).find(status::handled);
 }
 @end
@@ -372,7 +436,7 @@ using namespace saucer;
         .action = utils::objc_ptr<WKNavigationAction>::ref(action),
     }};
 
-    if (me->events.get<event::navigate>().fire(nav).find(policy::block))
+    if (me->blocked(nav))
     {
         return handler(WKNavigationActionPolicyCancel);
     }
@@ -384,6 +448,12 @@ using namespace saucer;
 {
     me->events.get<event::load>().fire(state::finished);
 }
+
+- (void)webViewWebContentProcessDidTerminate:(WKWebView *)webview
+{
+    // WebKit does not tell us why the content process went away
+    me->process_gone(termination::crashed);
+}
 @end
 
 @implementation SaucerView
@@ -6,12 +6,16 @@
 #include "instantiate.hpp"
 
 #include "wk.url.impl.hpp"
+#include "cocoa.icon.impl.hpp"
 #include "cocoa.app.impl.hpp"
 #include "cocoa.window.impl.hpp"
+#include "shared_buffer.impl.hpp"
 
 #include <format>
 #include <algorithm>
 
+#include <libproc.h>
+
 #import <objc/objc-runtime.h>
 #import <CoreImage/CoreImage.h>
 
@@ -38,6 +42,11 @@ namespace saucer
             platform->web_view.get().customUserAgent = [NSString stringWithUTF8String:opts.user_agent->c_str()];
         }
 
+        if (opts.pinch_zoom.has_value())
+        {
+            [platform->web_view.get() setAllowsMagnification:*opts.pinch_zoom];
+        }
+
         [platform->web_view.get() setUIDelegate:platform->ui_delegate.get()];
         [platform->web_view.get() setNavigationDelegate:platform->navigation_delegate.get()];
 
@@ -52,7 +61,8 @@ namespace saucer
         }
         else
         {
-            [platform->config.get() setWebsiteDataStore:[WKWebsiteDataStore nonPersistentDataStore]];
+            platform->session = native::ephemeral_store(opts.session);
+            [platform->config.get() setWebsiteDataStore:platform->session->get()];
         }
         [platform->config.get().preferences setElementFullscreenEnabled:YES];
 
@@ -192,11 +202,52 @@ namespace saucer
         [platform->web_view.get() loadRequest:request];
     }
 
+    void impl::serve_directory(const fs::path &root, const std::string &) // NOLINT(*-function-const)
+    {
+        const auto guard = utils::autorelease_guard{};
+
+        auto *const directory = [NSURL fileURLWithPath:[NSString stringWithUTF8String:root.c_str()] isDirectory:YES];
+        auto *const index     = [directory URLByAppendingPathComponent:@"index.html"];
+
+        [platform->web_view.get() loadFileURL:index allowingReadAccessToURL:directory];
+    }
+
     void impl::set_html(cstring_view html) // NOLINT(*-function-const)
     {
         [platform->web_view.get() loadHTMLString:[NSString stringWithUTF8String:html.c_str()] baseURL:nil];
     }
 
+    void impl::set_content_rules(std::vector<std::string> block) // NOLINT(*-function-const)
+    {
+        const utils::autorelease_guard guard{};
+
+        auto controller = utils::objc_ptr<WKUserContentController>::ref(platform->controller);
+        [controller.get() removeAllContentRuleLists];
+
+        if (block.empty())
+        {
+            return;
+        }
+
+        auto completed = [controller](WKContentRuleList *list, NSError *error)
+        {
+            if (error || !list)
+            {
+                return;
+            }
+
+            [controller.get() removeAllContentRuleLists];
+            [controller.get() addContentRuleList:list];
+        };
+
+        const auto identifier = std::format("saucer-{}", static_cast<const void *>(this));
+        const auto rules      = impl::content_rule_list(block);
+
+        [WKContentRuleListStore.defaultStore compileContentRuleListForIdentifier:[NSString stringWithUTF8String:identifier.c_str()]
+                                                           encodedContentRuleList:[NSString stringWithUTF8String:rules.c_str()]
+                                                                completionHandler:completed];
+    }
+
     void impl::set_dev_tools([[maybe_unused]] bool enabled) // NOLINT(*-function-const)
     {
         const utils::autorelease_guard guard{};
@@ -273,12 +324,94 @@ namespace saucer
     void impl::reset_bounds() // NOLINT(*-function-const)
     {
         [platform->web_view.get() setFrame:window->native<false>()->platform->window.contentView.frame];
+        place_surfaces();
     }
 
     void impl::set_bounds(saucer::bounds bounds) // NOLINT(*-function-const)
     {
         [platform->web_view.get() setFrame:{{.x = static_cast<CGFloat>(bounds.x), .y = static_cast<CGFloat>(bounds.y)},
                                             {.width = static_cast<CGFloat>(bounds.w), .height = static_cast<CGFloat>(bounds.h)}}];
+        place_surfaces();
+    }
+
+    void impl::add_surface(void *handle, layer position) // NOLINT(*-function-const)
+    {
+        const utils::autorelease_guard guard{};
+
+        auto *const view    = static_cast<NSView *>(handle);
+        auto *const content = window->native<false>()->platform->window.contentView;
+
+        [view setHidden:YES];
+
+        const auto ordering = position == layer::below ? NSWindowBelow : NSWindowAbove;
+        [content addSubview:view positioned:ordering relativeTo:platform->web_view.get()];
+    }
+
+    void impl::remove_surface(void *handle) // NOLINT(*-function-const)
+    {
+        const utils::autorelease_guard guard{};
+        [static_cast<NSView *>(handle) removeFromSuperview];
+    }
+
+    void impl::move_surface(void *handle, std::optional<saucer::bounds> bounds) // NOLINT(*-function-const)
+    {
+        const utils::autorelease_guard guard{};
+
+        auto *const view = static_cast<NSView *>(handle);
+
+        if (!bounds.has_value())
+        {
+            [view setHidden:YES];
+            return;
+        }
+
+        // The content view is not flipped, page coordinates start at the top of the webview
+        const auto [pos, size] = platform->web_view.get().frame;
+        const auto y           = pos.y + size.height - static_cast<CGFloat>(bounds->y + bounds->h);
+
+        [view setFrame:{{.x = pos.x + static_cast<CGFloat>(bounds->x), .y = y},
+                        {.width = static_cast<CGFloat>(bounds->w), .height = static_cast<CGFloat>(bounds->h)}}];
+        [view setHidden:NO];
+    }
+
+    void impl::suspend(bool value)
+    {
+        const utils::autorelease_guard guard{};
+
+        if (@available(macOS 12.0, *))
+        {
+            [platform->web_view.get() setAllMediaPlaybackSuspended:value completionHandler:nil];
+        }
+
+        if (value)
+        {
+            return;
+        }
+
+        if (!platform->dom_loaded)
+        {
+            return;
+        }
+
+        for (const auto &script : std::exchange(platform->pending, {}))
+        {
+            execute(script);
+        }
+    }
+
+    void impl::set_memory_target(memory_target target) // NOLINT(*-function-const)
+    {
+        const utils::autorelease_guard guard{};
+
+        if (target != memory_target::low)
+        {
+            return;
+        }
+
+        auto *const store = platform->web_view.get().configuration.websiteDataStore;
+        auto *const types = [NSSet setWithObject:WKWebsiteDataTypeMemoryCache];
+
+        [store removeDataOfTypes:types modifiedSince:NSDate.distantPast completionHandler:^{}];
     }
 
     void impl::back() // NOLINT(*-function-const)
@@ -303,7 +436,7 @@ namespace saucer
     {
         const utils::autorelease_guard guard{};
 
-        if (!platform->dom_loaded)
+        if (!platform->dom_loaded || suspended)
         {
             platform->pending.emplace_back(code);
             return;
@@ -312,6 +445,255 @@ namespace saucer
         [platform->web_view.get() evaluateJavaScript:[NSString stringWithUTF8String:code.c_str()] completionHandler:nil];
     }
 
+    void impl::evaluate_raw(cstring_view code, coco::promise<result<std::string>> promise) // NOLINT(*-function-const)
+    {
+        const utils::autorelease_guard guard{};
+
+        auto shared = std::make_shared<coco::promise<result<std::string>>>(std::move(promise));
+
+        auto completed = [shared](id value, NSError *error)
+        {
+            if (error)
+            {
+                shared->set_value(err(std::errc::invalid_argument));
+                return;
+            }
+
+            if (!value)
+            {
+                shared->set_value("null");
+                return;
+            }
+
+            NSError *failure{};
+            NSData *const data = [NSJSONSerialization dataWithJSONObject:value options:NSJSONWritingFragmentsAllowed error:&failure];
+
+            if (failure)
+            {
+                shared->set_value(err(std::errc::invalid_argument));
+                return;
+            }
+
+            shared->set_value(std::string{static_cast<const char *>(data.bytes), data.length});
+        };
+
+        [platform->web_view.get() evaluateJavaScript:[NSString stringWithUTF8String:code.c_str()] completionHandler:completed];
+    }
+
+    void impl::capture(std::optional<saucer::size> bounds, coco::promise<result<icon>> promise) // NOLINT(*-function-const)
+    {
+        const utils::autorelease_guard guard{};
+
+        auto shared          = std::make_shared<coco::promise<result<icon>>>(std::move(promise));
+        auto *const web_view = platform->web_view.get();
+
+        const utils::objc_ptr<WKSnapshotConfiguration> config = [[WKSnapshotConfiguration alloc] init];
+
+        if (bounds.has_value())
+        {
+            const auto frame  = web_view.bounds.size;
+            const auto [w, h] = impl::fit({.w = static_cast<int>(frame.width), .h = static_cast<int>(frame.height)}, *bounds);
+
+            config.get().snapshotWidth = @(w);
+        }
+
+        auto completed = [shared](NSImage *image, NSError *error)
+        {
+            if (error || !image)
+            {
+                shared->set_value(err(std::errc::resource_unavailable_try_again));
+                return;
+            }
+
+            shared->set_value(icon{icon::impl{utils::objc_ptr<NSImage>::ref(image)}});
+        };
+
+        [web_view takeSnapshotWithConfiguration:config.get() completionHandler:completed];
+    }
+
+    void impl::memory_stats(coco::promise<memory_usage> promise) // NOLINT(*-function-const)
+    {
+        auto rtn = memory_usage{};
+
+#ifdef SAUCER_WEBKIT_PRIVATE
+        const utils::autorelease_guard guard{};
+
+        auto *const web_view = platform->web_view.get();
+
+        if ([web_view respondsToSelector:@selector(_webProcessIdentifier)])
+        {
+            const auto pid = reinterpret_cast<NSNumber *>([web_view valueForKey:@"_webProcessIdentifier"]).intValue;
+            rusage_info_v2 info{};
+
+            if (pid > 0 && proc_pid_rusage(pid, RUSAGE_INFO_V2, reinterpret_cast<rusage_info_t *>(&info)) == 0)
+            {
+                rtn.engine = info.ri_resident_size;
+            }
+        }
+#endif
+
+        // WebKit does not expose its JS heap to pages, so only the web process is reported
+        promise.set_value(rtn);
+    }
+
+    void impl::devtools_protocol(const std::string &, const std::string &,
+                                 coco::promise<result<std::string>> promise) // NOLINT(*-function-const)
+    {
+        // WKWebView only offers its inspector to Safari's Web Inspector, not to the embedder
+        promise.set_value(err(std::errc::operation_not_supported));
+    }
+
+    void impl::set_cookies(std::vector<cookie> cookies, coco::promise<result<>> promise) // NOLINT(*-function-const)
+    {
+        const utils::autorelease_guard guard{};
+
+        struct batch
+        {
+            std::size_t remaining;
+            coco::promise<result<>> promise;
+        };
+
+        auto *const natives = [NSMutableArray arrayWithCapacity:cookies.size()];
+
+        for (const auto &cookie : cookies)
+        {
+            auto *const properties = [NSMutableDictionary dictionaryWithDictionary:@{
+                NSHTTPCookieName : [NSString stringWithUTF8String:cookie.name.c_str()],
+                NSHTTPCookieValue : [NSString stringWithUTF8String:cookie.value.c_str()],
+                NSHTTPCookieDomain : [NSString stringWithUTF8String:cookie.domain.c_str()],
+                NSHTTPCookiePath : [NSString stringWithUTF8String:cookie.path.c_str()],
+            }];
+
+            if (cookie.expires.has_value())
+            {
+                const auto seconds              = std::chrono::duration<double>{cookie.expires->time_since_epoch()};
+                properties[NSHTTPCookieExpires] = [NSDate dateWithTimeIntervalSince1970:seconds.count()];
+            }
+
+            if (cookie.secure)
+            {
+                properties[NSHTTPCookieSecure] = @"TRUE";
+            }
+
+            if (cookie.http_only)
+            {
+                // There is no public key for this attribute, `NSHTTPCookie` reads it from its properties all the same
+                properties[@"HttpOnly"] = @"TRUE";
+            }
+
+            auto *const native = [NSHTTPCookie cookieWithProperties:properties];
+
+            if (!native)
+            {
+                promise.set_value(err(std::errc::invalid_argument));
+                return;
+            }
+
+            [natives addObject:native];
+        }
+
+        if (natives.count == 0)
+        {
+            promise.set_value({});
+            return;
+        }
+
+        auto *const store = platform->web_view.get().configuration.websiteDataStore.httpCookieStore;
+        auto shared       = std::make_shared<batch>(batch{.remaining = natives.count, .promise = std::move(promise)});
+
+        auto completed = [shared]()
+        {
+            if (--shared->remaining > 0)
+            {
+                return;
+            }
+
+            shared->promise.set_value({});
+        };
+
+        // Settles once every cookie reported back
+        for (NSHTTPCookie *native in natives)
+        {
+            [store setCookie:native completionHandler:completed];
+        }
+    }
+
+    void impl::clear_data(const site_data &data, coco::promise<result<>> promise) // NOLINT(*-function-const)
+    {
+        const utils::autorelease_guard guard{};
+
+        auto *const types = [NSMutableSet set];
+
+        if (data.cookies)
+        {
+            [types addObject:WKWebsiteDataTypeCookies];
+        }
+
+        if (data.storage)
+        {
+            [types addObjectsFromArray:@[
+                WKWebsiteDataTypeLocalStorage, WKWebsiteDataTypeSessionStorage, WKWebsiteDataTypeIndexedDBDatabases,
+                WKWebsiteDataTypeWebSQLDatabases, WKWebsiteDataTypeServiceWorkerRegistrations
+            ]];
+        }
+
+        if (data.cache)
+        {
+            [types addObjectsFromArray:@[WKWebsiteDataTypeDiskCache, WKWebsiteDataTypeMemoryCache, WKWebsiteDataTypeFetchCache]];
+        }
+
+        if (types.count == 0)
+        {
+            promise.set_value({});
+            return;
+        }
+
+        auto *const store = platform->web_view.get().configuration.websiteDataStore;
+        auto shared       = std::make_shared<coco::promise<result<>>>(std::move(promise));
+
+        auto completed = [shared]()
+        {
+            shared->set_value({});
+        };
+
+        if (!data.origin.has_value())
+        {
+            [store removeDataOfTypes:types modifiedSince:NSDate.distantPast completionHandler:completed];
+            return;
+        }
+
+        auto host = origin_host(*data.origin);
+
+        if (!host.has_value())
+        {
+            shared->set_value(err(std::errc::invalid_argument));
+            return;
+        }
+
+        // Look up the records of the origin first
+        auto retained = std::make_pair(utils::objc_ptr<WKWebsiteDataStore>::ref(store), utils::objc_ptr<NSMutableSet>::ref(types));
+
+        auto fetched = [retained, host = std::move(*host), completed](NSArray<WKWebsiteDataRecord *> *records)
+        {
+            const auto &[store, types] = retained;
+            auto *const matching       = [NSMutableArray array];
+
+            for (WKWebsiteDataRecord *record in records)
+            {
+                if (!same_site(host, record.displayName.UTF8String))
+                {
+                    continue;
+                }
+
+                [matching addObject:record];
+            }
+
+            [store.get() removeDataOfTypes:types.get() forDataRecords:matching completionHandler:completed];
+        };
+
+        [store fetchDataRecordsOfTypes:types completionHandler:fetched];
+    }
+
     std::size_t impl::inject(const script &script) // NOLINT(*-function-const)
     {
         const auto id = platform->id_counter++;
@@ -358,37 +740,50 @@ namespace saucer
 
     void impl::handle_scheme(const std::string &name, scheme::resolver &&resolver) // NOLINT(*-function-const)
     {
-        if (!native::schemes.contains(name))
+        const auto it = native::schemes.find(name);
+
+        if (it == native::schemes.end())
         {
             return;
         }
 
-        [native::schemes[name].get() add_callback:std::move(resolver) webview:platform->web_view.get()];
+        [it->second.get() add_callback:std::move(resolver) webview:platform->web_view.get()];
     }
 
     void impl::handle_stream_scheme(const std::string &name, scheme::stream_resolver &&resolver) // NOLINT(*-function-const)
     {
-        if (!native::schemes.contains(name))
+        const auto it = native::schemes.find(name);
+
+        if (it == native::schemes.end())
         {
             return;
         }
 
-        [native::schemes[name].get() add_stream_callback:std::move(resolver) webview:platform->web_view.get()];
+        [it->second.get() add_stream_callback:std::move(resolver) webview:platform->web_view.get()];
     }
 
     void impl::remove_scheme(const std::string &name) // NOLINT(*-function-const)
     {
-        [native::schemes[name].get() del_callback:platform->web_view.get()];
+        const auto it = native::schemes.find(name);
+
+        if (it == native::schemes.end())
+        {
+            return;
+        }
+
+        [it->second.get() del_callback:platform->web_view.get()];
     }
 
     void impl::remove_stream_scheme(const std::string &name) // NOLINT(*-function-const)
     {
-        if (!native::schemes.contains(name))
+        const auto it = native::schemes.find(name);
+
+        if (it == native::schemes.end())
         {
             return;
         }
 
-        [native::schemes[name].get() del_stream_callback:platform->web_view.get()];
+        [it->second.get() del_stream_callback:platform->web_view.get()];
     }
 
     void impl::register_scheme(const std::string &name)
@@ -401,12 +796,27 @@ namespace saucer
         native::schemes.emplace(name, [[SchemeHandler alloc] init]);
     }
 
-    std::string impl::ready_script()
+    void impl::prewarm(const application::options &)
+    {
+    }
+
+    result<shared_buffer> impl::create_buffer(std::size_t size) // NOLINT(*-function-const)
     {
-        return "window.saucer.internal.message('dom_loaded')";
+        return shared_buffer::impl::host(size);
+    }
+
+    void impl::share(const shared_buffer &buffer, std::string_view topic)
+    {
+        share_fallback(buffer, topic);
+    }
+
+    const std::string &impl::ready_script()
+    {
+        static const std::string script = "window.saucer.internal.message('dom_loaded')";
+        return script;
     }
 
-    std::string impl::creation_script()
+    const std::string &impl::creation_script()
     {
         static const auto script = std::format(scripts::ipc_script, R"js(
             message: async (message) =>
@@ -6,6 +6,7 @@ namespace saucer::permission
 
     request::~request()
     {
+        m_impl->decided = nullptr;
         accept(false);
     }
 
@@ -29,5 +30,10 @@ namespace saucer::permission
         auto request = std::move(m_impl->request);
 
         (value ? webkit_permission_request_allow : webkit_permission_request_deny)(request.get());
+
+        if (auto decided = std::exchange(m_impl->decided, nullptr); decided)
+        {
+            decided(value);
+        }
     }
 } // namespace saucer::permission
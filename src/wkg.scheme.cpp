@@ -1,66 +1,110 @@
 #include "wkg.scheme.impl.hpp"
 
+#include <cctype>
+#include <algorithm>
+
 namespace saucer::scheme
 {
-    request::request(impl data) : m_impl(std::make_unique<impl>(std::move(data))) {}
-
-    request::request(const request &other) : request(*other.m_impl) {}
+    request::request(impl data) : m_impl(std::make_shared<impl>(std::move(data))) {}
 
     request::request(request &&) noexcept = default;
 
     request::~request() = default;
 
-    url request::url() const
+    request::impl request::impl::from(WebKitURISchemeRequest *request)
     {
-        return unwrap_safe(url::parse(webkit_uri_scheme_request_get_uri(m_impl->request.get())));
-    }
+        auto rtn = impl{
+            .url    = webkit_uri_scheme_request_get_uri(request),
+            .method = webkit_uri_scheme_request_get_http_method(request),
+        };
 
-    std::string request::method() const
-    {
-        return webkit_uri_scheme_request_get_http_method(m_impl->request.get());
-    }
+        auto emplace = [](const auto *name, const auto *value, gpointer data)
+        {
+            reinterpret_cast<std::map<std::string, std::string> *>(data)->emplace(name, value);
+        };
+        soup_message_headers_foreach(webkit_uri_scheme_request_get_http_headers(request), emplace, &rtn.headers);
 
-    stash request::content() const
-    {
-        auto stream = utils::g_object_ptr<GInputStream>{webkit_uri_scheme_request_get_http_body(m_impl->request.get())};
+        auto stream = utils::g_object_ptr<GInputStream>{webkit_uri_scheme_request_get_http_body(request)};
 
         if (!stream)
         {
-            return stash::empty();
+            return rtn;
         }
 
         static constexpr auto chunk_size = 4096;
 
-        std::vector<std::uint8_t> content;
-        content.reserve(chunk_size);
-
         gssize read{};
         guint8 buffer[chunk_size];
 
         while ((read = g_input_stream_read(stream.get(), buffer, chunk_size, nullptr, nullptr)) > 0)
         {
-            content.insert(content.end(), buffer, buffer + read);
+            rtn.body.insert(rtn.body.end(), buffer, buffer + read);
         }
 
         if (read == -1)
+        {
+            rtn.body.clear();
+        }
+
+        return rtn;
+    }
+
+    url request::url() const
+    {
+        return unwrap_safe(url::parse(m_impl->url));
+    }
+
+    std::string request::method() const
+    {
+        return m_impl->method;
+    }
+
+    stash request::content() const
+    {
+        if (m_impl->body.empty())
         {
             return stash::empty();
         }
 
-        return stash::from(std::move(content));
+        return stash::from(m_impl->body);
     }
 
-    std::map<std::string, std::string> request::headers() const
+    std::size_t request::read(std::span<std::uint8_t> buffer) const
     {
-        auto *const headers = webkit_uri_scheme_request_get_http_headers(m_impl->request.get());
-        auto rtn            = std::map<std::string, std::string>{};
+        const auto remaining = m_impl->body.size() - m_impl->offset;
+        const auto count     = std::min(remaining, buffer.size());
 
-        auto emplace = [](const auto *name, const auto *value, gpointer data)
+        std::ranges::copy_n(m_impl->body.begin() + static_cast<std::ptrdiff_t>(m_impl->offset), static_cast<std::ptrdiff_t>(count),
+                            buffer.begin());
+        m_impl->offset += count;
+
+        return count;
+    }
+
+    std::optional<std::string> request::header(std::string_view name) const
+    {
+        auto equal = [](char a, char b)
         {
-            reinterpret_cast<decltype(rtn) *>(data)->emplace(name, value);
+            return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
         };
-        soup_message_headers_foreach(headers, emplace, &rtn);
 
-        return rtn;
+        auto matches = [&](const auto &item)
+        {
+            return std::ranges::equal(item.first, name, equal);
+        };
+
+        const auto it = std::ranges::find_if(m_impl->headers, matches);
+
+        if (it == m_impl->headers.end())
+        {
+            return std::nullopt;
+        }
+
+        return it->second;
+    }
+
+    const std::map<std::string, std::string> &request::headers() const
+    {
+        return m_impl->headers;
     }
 } // namespace saucer::scheme
@@ -1,20 +1,202 @@
 #include "wkg.scheme.impl.hpp"
 
 #include "handle.hpp"
+#include "utils/overload.hpp"
 
 #include <rebind/utils/enum.hpp>
 
+#include <array>
+#include <algorithm>
+
+#include <fcntl.h>
 #include <unistd.h>
+
+#include <glib-unix.h>
 #include <gio/gunixinputstream.h>
 
 namespace saucer::scheme
 {
+    static utils::g_bytes_ptr make_bytes(stash data)
+    {
+        auto *const owned = new stash{std::move(data)};
+        auto release      = [](gpointer data)
+        {
+            delete static_cast<stash *>(data);
+        };
+
+        return utils::g_bytes_ptr{g_bytes_new_with_free_func(owned->data(), owned->size(), release, owned)};
+    }
+
     stream_writer::impl::~impl()
     {
+        close();
+    }
+
+    ssize_t stream_writer::impl::transfer(chunk &front)
+    {
+        auto fallback = [this](file_segment &segment) -> ssize_t
+        {
+            static constexpr auto chunk_size = 64uz * 1024;
+
+            std::array<std::uint8_t, chunk_size> buffer{};
+
+            const auto length = std::min(chunk_size, segment.remaining);
+            const auto read   = ::pread(segment.fd.get(), buffer.data(), length, static_cast<off_t>(segment.offset));
+
+            if (read <= 0)
+            {
+                return read;
+            }
+
+            return ::write(write_fd, buffer.data(), static_cast<std::size_t>(read));
+        };
+
+        auto visitor = overload{
+            [this](const stash &data) { return ::write(write_fd, data.data() + offset, data.size() - offset); },
+            [this, &fallback](file_segment &segment)
+            {
+                static constexpr auto flags = SPLICE_F_MOVE | SPLICE_F_NONBLOCK;
+
+                auto position      = static_cast<loff_t>(segment.offset);
+                const auto written = ::splice(segment.fd.get(), &position, write_fd, nullptr, segment.remaining, flags);
+
+                if (written < 0 && errno == EINVAL)
+                {
+                    return fallback(segment);
+                }
+
+                return written;
+            },
+        };
+
+        return std::visit(visitor, front);
+    }
+
+    bool stream_writer::impl::advance(chunk &front, std::size_t written)
+    {
+        auto visitor = overload{
+            [this, written](const stash &data)
+            {
+                offset += written;
+                return offset >= data.size();
+            },
+            [written](file_segment &segment)
+            {
+                segment.offset += written;
+                segment.remaining -= std::min(written, segment.remaining);
+                return written == 0 || segment.remaining == 0;
+            },
+        };
+
+        return std::visit(visitor, front);
+    }
+
+    bool stream_writer::impl::flush()
+    {
+        while (!pending.empty())
+        {
+            auto &front        = pending.front();
+            const auto written = transfer(front);
+
+            if (written < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            {
+                return false;
+            }
+
+            if (written < 0)
+            {
+                drop();
+                close();
+                return true;
+            }
+
+            queued -= std::min(queued, static_cast<std::size_t>(written));
+
+            if (!advance(front, static_cast<std::size_t>(written)))
+            {
+                continue;
+            }
+
+            // Files may turn out shorter than requested, whatever is left of them is never going to be written
+            if (const auto *segment = std::get_if<file_segment>(&front); segment)
+            {
+                queued -= std::min(queued, segment->remaining);
+            }
+
+            pending.pop_front();
+            offset = 0;
+        }
+
+        return true;
+    }
+
+    void stream_writer::impl::drop()
+    {
+        pending.clear();
+        offset = 0;
+        queued = 0;
+    }
+
+    void stream_writer::impl::close()
+    {
+        if (source != 0)
+        {
+            g_source_remove(source);
+            source = 0;
+        }
+
         if (write_fd >= 0)
         {
-            close(write_fd);
+            ::close(write_fd);
+            write_fd = -1;
+        }
+    }
+
+    static gboolean drain(gint, GIOCondition, gpointer data)
+    {
+        auto self = static_cast<std::weak_ptr<stream_writer::impl> *>(data)->lock();
+
+        if (!self)
+        {
+            return G_SOURCE_REMOVE;
+        }
+
+        std::lock_guard lock{self->mutex};
+
+        if (!self->flush())
+        {
+            return G_SOURCE_CONTINUE;
+        }
+
+        self->source = 0;
+
+        if (self->closing)
+        {
+            self->close();
+        }
+
+        return G_SOURCE_REMOVE;
+    }
+
+    static void watch(const std::shared_ptr<stream_writer::impl> &impl)
+    {
+        if (impl->source != 0)
+        {
+            return;
         }
+
+        auto *const weak = new std::weak_ptr<stream_writer::impl>{impl};
+        auto release     = [](gpointer data)
+        {
+            delete static_cast<std::weak_ptr<stream_writer::impl> *>(data);
+        };
+
+        impl->source = g_unix_fd_add_full(G_PRIORITY_DEFAULT, impl->write_fd, G_IO_OUT, drain, weak, release);
     }
 
     stream_writer::stream_writer(std::shared_ptr<impl> impl) : m_impl(std::move(impl)) {}
@@ -36,7 +218,21 @@ namespace saucer::scheme
             return;
         }
 
-        m_impl->write_fd = fds[1];
+        fcntl(fds[1], F_SETFL, fcntl(fds[1], F_GETFL) | O_NONBLOCK);
+
+#ifdef F_SETPIPE_SZ
+        if (response.capacity.has_value())
+        {
+            fcntl(fds[1], F_SETPIPE_SZ, static_cast<int>(*response.capacity));
+        }
+#endif
+
+        {
+            std::lock_guard lock{m_impl->mutex};
+
+            m_impl->write_fd = fds[1];
+            m_impl->limit    = response.capacity.value_or(stream_writer::impl::default_limit);
+        }
 
         auto stream = utils::g_object_ptr<GInputStream>{g_unix_input_stream_new(fds[0], TRUE)};
         auto res    = utils::g_object_ptr<WebKitURISchemeResponse>{webkit_uri_scheme_response_new(stream.get(), -1)};
@@ -55,32 +251,65 @@ namespace saucer::scheme
         webkit_uri_scheme_request_finish_with_response(m_impl->request.get(), res.get());
     }
 
-    void stream_writer::write(stash data)
+    static write_status enqueue(const std::shared_ptr<stream_writer::impl> &impl, stream_writer::impl::chunk data, std::size_t size)
     {
-        if (!m_impl || !m_impl->started || m_impl->finished || m_impl->write_fd < 0)
+        if (!impl || !impl->started || impl->finished)
         {
-            return;
+            return write_status::closed;
         }
 
-        const auto *ptr       = data.data();
-        std::size_t remaining = data.size();
+        std::lock_guard lock{impl->mutex};
 
-        while (remaining > 0)
+        if (impl->write_fd < 0)
         {
-            auto written = ::write(m_impl->write_fd, ptr, remaining);
+            return write_status::closed;
+        }
 
-            if (written < 0)
-            {
-                if (errno == EINTR)
-                {
-                    continue;
-                }
-                break;
-            }
+        if (size == 0)
+        {
+            return write_status::written;
+        }
 
-            ptr += written;
-            remaining -= static_cast<std::size_t>(written);
+        // Producers that keep writing despite `saturated` would otherwise grow the queue without bound
+        if (impl->queued + size > impl->limit * 8)
+        {
+            impl->drop();
+            impl->close();
+
+            return write_status::closed;
+        }
+
+        utils::metrics::get().scheme_bytes.fetch_add(size, std::memory_order_relaxed);
+
+        impl->queued += size;
+        impl->pending.emplace_back(std::move(data));
+
+        if (impl->flush())
+        {
+            return impl->write_fd < 0 ? write_status::closed : write_status::written;
         }
+
+        watch(impl);
+
+        return impl->queued > impl->limit ? write_status::saturated : write_status::written;
+    }
+
+    write_status stream_writer::write(stash data)
+    {
+        const auto size = data.size();
+        return enqueue(m_impl, std::move(data).owned(), size);
+    }
+
+    write_status stream_writer::write_file(int fd, std::size_t offset, std::size_t length)
+    {
+        auto copy = utils::handle<int, ::close, -1>{fcntl(fd, F_DUPFD_CLOEXEC, 0)};
+
+        if (copy.get() < 0)
+        {
+            return write_status::closed;
+        }
+
+        return enqueue(m_impl, file_segment{std::move(copy), offset, length}, length);
     }
 
     void stream_writer::finish()
@@ -90,11 +319,15 @@ namespace saucer::scheme
             return;
         }
 
-        if (m_impl->write_fd >= 0)
+        std::lock_guard lock{m_impl->mutex};
+
+        if (!m_impl->pending.empty())
         {
-            close(m_impl->write_fd);
-            m_impl->write_fd = -1;
+            m_impl->closing = true;
+            return;
         }
+
+        m_impl->close();
     }
 
     void stream_writer::reject(error err)
@@ -104,10 +337,11 @@ namespace saucer::scheme
             return;
         }
 
-        if (m_impl->write_fd >= 0)
         {
-            close(m_impl->write_fd);
-            m_impl->write_fd = -1;
+            std::lock_guard lock{m_impl->mutex};
+
+            m_impl->drop();
+            m_impl->close();
         }
 
         if (!m_impl->started)
@@ -141,7 +375,9 @@ namespace saucer::scheme
         auto request           = utils::g_object_ptr<WebKitURISchemeRequest>::ref(raw);
         auto *const identifier = webkit_uri_scheme_request_get_web_view(request.get());
 
-        if (!state->m_callbacks.contains(identifier))
+        const auto callback = state->m_callbacks.find(identifier);
+
+        if (callback == state->m_callbacks.end())
         {
             return;
         }
@@ -150,9 +386,9 @@ namespace saucer::scheme
         writer_impl->request = request;
 
         auto writer = stream_writer{writer_impl};
-        auto req    = scheme::request{{request}};
+        auto req    = scheme::request{scheme::request::impl::from(request.get())};
 
-        return state->m_callbacks[identifier](std::move(req), std::move(writer));
+        return callback->second(std::move(req), std::move(writer));
     }
     void handler::add_callback(WebKitWebView *id, scheme::resolver callback)
     {
@@ -169,17 +405,18 @@ namespace saucer::scheme
         auto request           = utils::g_object_ptr<WebKitURISchemeRequest>::ref(raw);
         auto *const identifier = webkit_uri_scheme_request_get_web_view(request.get());
 
-        if (!state->m_callbacks.contains(identifier))
+        const auto callback = state->m_callbacks.find(identifier);
+
+        if (callback == state->m_callbacks.end())
         {
             return;
         }
 
-        auto resolve = [request](const scheme::response &response)
+        auto resolve = [request](scheme::response response)
         {
-            const auto data = response.data;
-            const auto size = static_cast<gssize>(data.size());
+            const auto size = static_cast<gssize>(response.data.size());
 
-            auto bytes  = utils::g_bytes_ptr{g_bytes_new(data.data(), size)};
+            auto bytes  = make_bytes(std::move(response.data));
             auto stream = utils::g_object_ptr<GInputStream>{g_memory_input_stream_new_from_bytes(bytes.get())};
 
             auto res            = utils::g_object_ptr<WebKitURISchemeResponse>{webkit_uri_scheme_response_new(stream.get(), size)};
@@ -209,8 +446,8 @@ namespace saucer::scheme
         };
 
         auto executor = scheme::executor{std::move(resolve), std::move(reject)};
-        auto req      = scheme::request{{request}};
+        auto req      = scheme::request{scheme::request::impl::from(request.get())};
 
-        return state->m_callbacks[identifier](std::move(req), std::move(executor));
+        return callback->second(std::move(req), std::move(executor));
     }
 } // namespace saucer::scheme
@@ -1,6 +1,6 @@
 #include "wkg.webview.impl.hpp"
 
-#include "error.impl.hpp" // IWYU pragma: keep
+#include "gtk.error.hpp"
 
 #include "scripts.hpp"
 #include "instantiate.hpp"
@@ -8,6 +8,7 @@
 #include "gtk.icon.impl.hpp"
 #include "gtk.window.impl.hpp"
 #include "wkg.scheme.impl.hpp"
+#include "shared_buffer.impl.hpp"
 
 #include <cassert>
 
@@ -22,6 +23,7 @@ namespace saucer
         platform = std::make_unique<native>();
 
         platform->settings = native::make_settings(opts);
+        regions            = opts.native_regions;
 
         const auto acceleration = opts.hardware_acceleration ? WEBKIT_HARDWARE_ACCELERATION_POLICY_ALWAYS //
                                                              : WEBKIT_HARDWARE_ACCELERATION_POLICY_NEVER;
@@ -35,17 +37,36 @@ namespace saucer
 
         if (opts.non_persistent_data_store)
         {
-            auto *const session = webkit_network_session_new_ephemeral();
-            platform->web_view  = WEBKIT_WEB_VIEW(g_object_new(WEBKIT_TYPE_WEB_VIEW, "network-session", session, nullptr));
-            g_object_unref(session);
+            platform->session  = native::ephemeral_session(opts.session);
+            platform->web_view = WEBKIT_WEB_VIEW(g_object_new(WEBKIT_TYPE_WEB_VIEW, "network-session", platform->session->get(), nullptr));
         }
         else
         {
             platform->web_view = WEBKIT_WEB_VIEW(webkit_web_view_new());
         }
 
+        if (opts.back_forward_cache.has_value())
+        {
+            native::set_back_forward_cache(platform->settings.get(), *opts.back_forward_cache);
+        }
+
+        if (opts.smooth_scrolling.has_value())
+        {
+            webkit_settings_set_enable_smooth_scrolling(platform->settings.get(), *opts.smooth_scrolling);
+        }
+
         webkit_web_view_set_settings(platform->web_view, platform->settings.get());
 
+        if (opts.cache_model.has_value())
+        {
+            webkit_web_context_set_cache_model(webkit_web_view_get_context(platform->web_view), native::convert(*opts.cache_model));
+        }
+
+        if (opts.spellcheck.has_value())
+        {
+            webkit_web_context_set_spell_checking_enabled(webkit_web_view_get_context(platform->web_view), *opts.spellcheck);
+        }
+
         auto *const session      = webkit_web_view_get_network_session(platform->web_view);
         auto *const data_manager = webkit_network_session_get_website_data_manager(session);
 
@@ -58,8 +79,9 @@ namespace saucer
             webkit_cookie_manager_set_persistent_storage(manager, path.c_str(), WEBKIT_COOKIE_PERSISTENT_STORAGE_SQLITE);
         }
 
-        platform->id_context = utils::connect(platform->web_view, "context-menu", native::on_context, this);
-        platform->id_load    = utils::connect(platform->web_view, "load-changed", native::on_load, this);
+        platform->id_context    = utils::connect(platform->web_view, "context-menu", native::on_context, this);
+        platform->id_load       = utils::connect(platform->web_view, "load-changed", native::on_load, this);
+        platform->id_terminated = utils::connect(platform->web_view, "web-process-terminated", native::on_terminated, this);
 
         // The ContentManager is ref'd to prevent it from being destroyed early when using multiple webviews
         platform->manager = content_manager_ptr::ref(webkit_web_view_get_user_content_manager(platform->web_view));
@@ -102,6 +124,7 @@ namespace saucer
 
         g_signal_handler_disconnect(platform->web_view, platform->id_context);
         g_signal_handler_disconnect(platform->web_view, platform->id_load);
+        g_signal_handler_disconnect(platform->web_view, platform->id_terminated);
 
         g_signal_handler_disconnect(platform->manager.get(), platform->id_message);
 
@@ -206,11 +229,57 @@ namespace saucer
         webkit_web_view_load_uri(platform->web_view, url.string().c_str());
     }
 
+    void impl::serve_directory(const fs::path &root, const std::string &)
+    {
+        auto index = url::from(root / "index.html");
+
+        if (!index.has_value())
+        {
+            return;
+        }
+
+        set_url(index.value());
+    }
+
     void impl::set_html(cstring_view html) // NOLINT(*-function-const)
     {
         webkit_web_view_load_html(platform->web_view, html.c_str(), nullptr);
     }
 
+    void impl::set_content_rules(std::vector<std::string> block) // NOLINT(*-function-const)
+    {
+        webkit_user_content_manager_remove_all_filters(platform->manager.get());
+
+        if (block.empty())
+        {
+            return;
+        }
+
+        const auto rules = impl::content_rule_list(block);
+        auto bytes       = utils::g_bytes_ptr{g_bytes_new(rules.data(), rules.size())};
+
+        auto saved = [](GObject *source, GAsyncResult *res, WebKitUserContentManager *data)
+        {
+            auto *const store = WEBKIT_USER_CONTENT_FILTER_STORE(source);
+
+            auto manager = content_manager_ptr{data};
+            auto filter  = content_filter_ptr{webkit_user_content_filter_store_save_finish(store, res, nullptr)};
+
+            if (!filter)
+            {
+                return;
+            }
+
+            webkit_user_content_manager_remove_all_filters(manager.get());
+            webkit_user_content_manager_add_filter(manager.get(), filter.get());
+        };
+
+        const auto identifier = std::format("saucer-{}", static_cast<const void *>(this));
+
+        webkit_user_content_filter_store_save(native::filter_store(), identifier.c_str(), bytes.get(), nullptr,
+                                              reinterpret_cast<GAsyncReadyCallback>(+saved), g_object_ref(platform->manager.get()));
+    }
+
     void impl::set_dev_tools(bool enabled) // NOLINT(*-function-const)
     {
         auto *const settings  = webkit_web_view_get_settings(platform->web_view);
@@ -260,6 +329,8 @@ namespace saucer
         gtk_widget_set_margin_end(widget, 0);
         gtk_widget_set_margin_top(widget, 0);
         gtk_widget_set_margin_bottom(widget, 0);
+
+        place_surfaces();
     }
 
     void impl::set_bounds(saucer::bounds bounds) // NOLINT(*-function-const)
@@ -272,6 +343,81 @@ namespace saucer
 
         gtk_widget_set_margin_top(widget, bounds.y);
         gtk_widget_set_margin_bottom(widget, height - bounds.y - bounds.h);
+
+        place_surfaces();
+    }
+
+    void impl::add_surface(void *handle, layer position) // NOLINT(*-function-const)
+    {
+        auto *const widget  = GTK_WIDGET(handle);
+        auto *const content = window->native<false>()->platform->content;
+
+        gtk_widget_set_visible(widget, false);
+        gtk_widget_set_halign(widget, GTK_ALIGN_START);
+        gtk_widget_set_valign(widget, GTK_ALIGN_START);
+
+        gtk_overlay_add_overlay(content, widget);
+
+        // Overlays are drawn (and picked) in the order of their siblings
+        if (position == layer::below)
+        {
+            gtk_widget_insert_before(widget, GTK_WIDGET(content), GTK_WIDGET(platform->web_view));
+        }
+    }
+
+    void impl::remove_surface(void *handle) // NOLINT(*-function-const)
+    {
+        window->native<false>()->platform->remove_widget(GTK_WIDGET(handle));
+    }
+
+    void impl::move_surface(void *handle, std::optional<saucer::bounds> bounds) // NOLINT(*-function-const)
+    {
+        auto *const widget = GTK_WIDGET(handle);
+
+        if (!bounds.has_value())
+        {
+            gtk_widget_set_visible(widget, false);
+            return;
+        }
+
+        auto *const web_view = GTK_WIDGET(platform->web_view);
+
+        gtk_widget_set_margin_start(widget, gtk_widget_get_margin_start(web_view) + bounds->x);
+        gtk_widget_set_margin_top(widget, gtk_widget_get_margin_top(web_view) + bounds->y);
+        gtk_widget_set_size_request(widget, bounds->w, bounds->h);
+
+        gtk_widget_set_visible(widget, true);
+    }
+
+    void impl::suspend(bool value)
+    {
+        if (value)
+        {
+            return;
+        }
+
+        if (!platform->dom_loaded)
+        {
+            return;
+        }
+
+        for (const auto &script : std::exchange(platform->pending, {}))
+        {
+            execute(script);
+        }
+    }
+
+    void impl::set_memory_target(memory_target target) // NOLINT(*-function-const)
+    {
+        if (target != memory_target::low)
+        {
+            return;
+        }
+
+        auto *const session = webkit_web_view_get_network_session(platform->web_view);
+        auto *const manager = webkit_network_session_get_website_data_manager(session);
+
+        webkit_website_data_manager_clear(manager, WEBKIT_WEBSITE_DATA_MEMORY_CACHE, 0, nullptr, nullptr, nullptr);
     }
 
     void impl::back() // NOLINT(*-function-const)
@@ -291,7 +437,7 @@ namespace saucer
 
     void impl::execute(cstring_view code) // NOLINT(*-function-const)
     {
-        if (!platform->dom_loaded)
+        if (!platform->dom_loaded || suspended)
         {
             platform->pending.emplace_back(code);
             return;
@@ -300,21 +446,233 @@ namespace saucer
         webkit_web_view_evaluate_javascript(platform->web_view, code.c_str(), -1, nullptr, nullptr, nullptr, nullptr, nullptr);
     }
 
-    std::size_t impl::inject(const script &script) // NOLINT(*-function-const)
+    void impl::evaluate_raw(cstring_view code, coco::promise<result<std::string>> promise) // NOLINT(*-function-const)
+    {
+        using promise_t = coco::promise<result<std::string>>;
+
+        auto finished = [](GObject *source, GAsyncResult *res, promise_t *data)
+        {
+            auto promise = std::unique_ptr<promise_t>{data};
+            auto error   = utils::g_error_ptr{};
+
+            auto *const value = webkit_web_view_evaluate_javascript_finish(WEBKIT_WEB_VIEW(source), res, &error.reset());
+
+            if (!value)
+            {
+                promise->set_value(err(std::move(error)));
+                return;
+            }
+
+            auto json = utils::g_str_ptr{jsc_value_to_json(value, 0)};
+            g_object_unref(value);
+
+            promise->set_value(json.get() ? std::string{json.get()} : "null");
+        };
+
+        webkit_web_view_evaluate_javascript(platform->web_view, code.c_str(), -1, nullptr, nullptr, nullptr,
+                                            reinterpret_cast<GAsyncReadyCallback>(+finished), new promise_t{std::move(promise)});
+    }
+
+    void impl::capture(std::optional<saucer::size> bounds, coco::promise<result<icon>> promise) // NOLINT(*-function-const)
+    {
+        struct request
+        {
+            std::optional<saucer::size> bounds;
+            coco::promise<result<icon>> promise;
+        };
+
+        auto finished = [](GObject *source, GAsyncResult *res, request *data)
+        {
+            auto request = std::unique_ptr<struct request>{data};
+            auto error   = utils::g_error_ptr{};
+
+            auto *const web_view = WEBKIT_WEB_VIEW(source);
+            auto texture         = utils::g_object_ptr<GdkTexture>{webkit_web_view_get_snapshot_finish(web_view, res, &error.reset())};
+
+            if (!texture)
+            {
+                request->promise.set_value(err(std::move(error)));
+                return;
+            }
+
+            if (request->bounds.has_value())
+            {
+                texture = native::scale(GTK_WIDGET(web_view), texture.get(), *request->bounds);
+            }
+
+            request->promise.set_value(icon{icon::impl{std::move(texture)}});
+        };
+
+        webkit_web_view_get_snapshot(platform->web_view, WEBKIT_SNAPSHOT_REGION_VISIBLE, WEBKIT_SNAPSHOT_OPTIONS_NONE, nullptr,
+                                     reinterpret_cast<GAsyncReadyCallback>(+finished), new request{bounds, std::move(promise)});
+    }
+
+    void impl::memory_stats(coco::promise<memory_usage> promise) // NOLINT(*-function-const)
     {
-        using enum script::time;
+        // WebKitGTK neither exposes its web process nor the JS heap
+        promise.set_value(memory_usage{});
+    }
+
+    void impl::devtools_protocol(const std::string &, const std::string &,
+                                 coco::promise<result<std::string>> promise) // NOLINT(*-function-const)
+    {
+        // WebKitGTK only offers its inspector through the remote inspector server, not to the embedder
+        promise.set_value(err(std::errc::operation_not_supported));
+    }
+
+    void impl::set_cookies(std::vector<cookie> cookies, coco::promise<result<>> promise) // NOLINT(*-function-const)
+    {
+        struct batch
+        {
+            std::size_t remaining;
+            result<> status;
+            coco::promise<result<>> promise;
+        };
+
+        if (cookies.empty())
+        {
+            promise.set_value({});
+            return;
+        }
+
+        auto finished = [](GObject *source, GAsyncResult *res, batch *data)
+        {
+            auto error = utils::g_error_ptr{};
+
+            if (!webkit_cookie_manager_add_cookie_finish(WEBKIT_COOKIE_MANAGER(source), res, &error.reset()) && data->status.has_value())
+            {
+                data->status = err(std::move(error));
+            }
+
+            if (--data->remaining > 0)
+            {
+                return;
+            }
+
+            auto batch = std::unique_ptr<struct batch>{data};
+            batch->promise.set_value(std::move(batch->status));
+        };
+
+        auto *const session = webkit_web_view_get_network_session(platform->web_view);
+        auto *const manager = webkit_network_session_get_cookie_manager(session);
+        auto *const data    = new batch{.remaining = cookies.size(), .status = {}, .promise = std::move(promise)};
+
+        // Settles once every cookie reported back
+        for (const auto &cookie : cookies)
+        {
+            auto converted = native::convert(cookie);
+            webkit_cookie_manager_add_cookie(manager, converted.get(), nullptr, reinterpret_cast<GAsyncReadyCallback>(+finished), data);
+        }
+    }
+
+    void impl::clear_data(const site_data &data, coco::promise<result<>> promise) // NOLINT(*-function-const)
+    {
+        struct request
+        {
+            WebKitWebsiteDataTypes types;
+            std::string host;
+            coco::promise<result<>> promise;
+        };
+
+        const auto types = native::convert(data);
+
+        if (types == 0)
+        {
+            promise.set_value({});
+            return;
+        }
+
+        static constexpr auto finished = [](GObject *source, GAsyncResult *res, request *data)
+        {
+            auto request = std::unique_ptr<struct request>{data};
+            auto error   = utils::g_error_ptr{};
 
-        const auto time = (script.run_at == creation) ? WEBKIT_USER_SCRIPT_INJECT_AT_DOCUMENT_START //
-                                                      : WEBKIT_USER_SCRIPT_INJECT_AT_DOCUMENT_END;
+            auto *const manager = WEBKIT_WEBSITE_DATA_MANAGER(source);
+            const auto success  = request->host.empty() ? webkit_website_data_manager_clear_finish(manager, res, &error.reset())
+                                                        : webkit_website_data_manager_remove_finish(manager, res, &error.reset());
 
-        const auto frame = (script.no_frames) ? WEBKIT_USER_CONTENT_INJECT_TOP_FRAME //
-                                              : WEBKIT_USER_CONTENT_INJECT_ALL_FRAMES;
+            if (!success)
+            {
+                request->promise.set_value(err(std::move(error)));
+                return;
+            }
+
+            request->promise.set_value({});
+        };
+
+        auto *const session = webkit_web_view_get_network_session(platform->web_view);
+        auto *const manager = webkit_network_session_get_website_data_manager(session);
+
+        if (!data.origin.has_value())
+        {
+            webkit_website_data_manager_clear(manager, types, 0, nullptr, reinterpret_cast<GAsyncReadyCallback>(+finished),
+                                              new request{.types = types, .host = {}, .promise = std::move(promise)});
+            return;
+        }
+
+        auto host = origin_host(*data.origin);
+
+        if (!host.has_value())
+        {
+            promise.set_value(err(std::errc::invalid_argument));
+            return;
+        }
 
-        auto *const user_script = webkit_user_script_new(script.code.c_str(), frame, time, nullptr, nullptr);
-        const auto id           = platform->id_counter++;
+        // Look up the records of the origin first
+        auto fetched = [](GObject *source, GAsyncResult *res, request *data)
+        {
+            auto *const manager = WEBKIT_WEBSITE_DATA_MANAGER(source);
+            auto error          = utils::g_error_ptr{};
 
-        webkit_user_content_manager_add_script(platform->manager.get(), user_script);
-        platform->scripts.emplace(id, wkg_script{.ref = user_script, .clearable = script.clearable});
+            auto *const records = webkit_website_data_manager_fetch_finish(manager, res, &error.reset());
+
+            if (error.get())
+            {
+                auto request = std::unique_ptr<struct request>{data};
+                request->promise.set_value(err(std::move(error)));
+                return;
+            }
+
+            GList *matching{};
+
+            for (auto *it = records; it; it = it->next)
+            {
+                auto *const record = static_cast<WebKitWebsiteData *>(it->data);
+
+                if (!same_site(data->host, webkit_website_data_get_name(record)))
+                {
+                    continue;
+                }
+
+                matching = g_list_prepend(matching, record);
+            }
+
+            if (matching)
+            {
+                const auto callback = reinterpret_cast<GAsyncReadyCallback>(+finished);
+                webkit_website_data_manager_remove(manager, data->types, matching, nullptr, callback, data);
+            }
+            else
+            {
+                auto request = std::unique_ptr<struct request>{data};
+                request->promise.set_value({});
+            }
+
+            g_list_free(matching);
+            g_list_free_full(records, reinterpret_cast<GDestroyNotify>(webkit_website_data_unref));
+        };
+
+        webkit_website_data_manager_fetch(manager, types, nullptr, reinterpret_cast<GAsyncReadyCallback>(+fetched),
+                                          new request{.types = types, .host = std::move(*host), .promise = std::move(promise)});
+    }
+
+    std::size_t impl::inject(const script &script) // NOLINT(*-function-const)
+    {
+        auto user_script = native::compile(script);
+        const auto id    = platform->id_counter++;
+
+        webkit_user_content_manager_add_script(platform->manager.get(), user_script.get());
+        platform->scripts.emplace(id, wkg_script{.ref = std::move(user_script), .clearable = script.clearable});
 
         return id;
     }
@@ -349,18 +707,21 @@ namespace saucer
 
     void impl::handle_scheme(const std::string &name, scheme::resolver &&resolver) // NOLINT(*-function-const)
     {
-        if (!native::schemes.contains(name))
+        const auto it = native::schemes.find(name);
+
+        if (it == native::schemes.end())
         {
             return;
         }
 
-        // TODO: Use heterogenous lookup with C++26
-        native::schemes[name]->add_callback(platform->web_view, std::move(resolver));
+        it->second->add_callback(platform->web_view, std::move(resolver));
     }
 
     void impl::handle_stream_scheme(const std::string &name, scheme::stream_resolver &&resolver) // NOLINT(*-function-const)
     {
-        if (!native::stream_schemes.contains(name))
+        auto it = native::stream_schemes.find(name);
+
+        if (it == native::stream_schemes.end())
         {
             auto *const context  = webkit_web_context_get_default();
             auto *const security = webkit_web_context_get_security_manager(context);
@@ -369,33 +730,37 @@ namespace saucer
             auto callback = reinterpret_cast<WebKitURISchemeRequestCallback>(&scheme::stream_handler::handle);
 
             webkit_web_context_register_uri_scheme(context, name.c_str(), callback, handler.get(), nullptr);
-            native::stream_schemes.emplace(name, std::move(handler));
+            it = native::stream_schemes.emplace(name, std::move(handler)).first;
 
             webkit_security_manager_register_uri_scheme_as_secure(security, name.c_str());
             webkit_security_manager_register_uri_scheme_as_cors_enabled(security, name.c_str());
         }
 
-        native::stream_schemes[name]->add_callback(platform->web_view, std::move(resolver));
+        it->second->add_callback(platform->web_view, std::move(resolver));
     }
 
     void impl::remove_scheme(const std::string &name) // NOLINT(*-function-const)
     {
-        if (!native::schemes.contains(name))
+        const auto it = native::schemes.find(name);
+
+        if (it == native::schemes.end())
         {
             return;
         }
 
-        native::schemes[name]->del_callback(platform->web_view);
+        it->second->del_callback(platform->web_view);
     }
 
     void impl::remove_stream_scheme(const std::string &name) // NOLINT(*-function-const)
     {
-        if (!native::stream_schemes.contains(name))
+        const auto it = native::stream_schemes.find(name);
+
+        if (it == native::stream_schemes.end())
         {
             return;
         }
 
-        native::stream_schemes[name]->del_callback(platform->web_view);
+        it->second->del_callback(platform->web_view);
     }
 
     void impl::register_scheme(const std::string &name)
@@ -418,12 +783,27 @@ namespace saucer
         webkit_security_manager_register_uri_scheme_as_cors_enabled(security, name.c_str());
     }
 
-    std::string impl::ready_script()
+    void impl::prewarm(const application::options &)
+    {
+    }
+
+    result<shared_buffer> impl::create_buffer(std::size_t size) // NOLINT(*-function-const)
+    {
+        return shared_buffer::impl::host(size);
+    }
+
+    void impl::share(const shared_buffer &buffer, std::string_view topic)
+    {
+        share_fallback(buffer, topic);
+    }
+
+    const std::string &impl::ready_script()
     {
-        return "window.saucer.internal.message('dom_loaded')";
+        static const std::string script = "window.saucer.internal.message('dom_loaded')";
+        return script;
     }
 
-    std::string impl::creation_script()
+    const std::string &impl::creation_script()
     {
         static const auto script = std::format(scripts::ipc_script, R"js(
             message: async (message) =>
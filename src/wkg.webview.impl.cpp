@@ -6,8 +6,12 @@
 #include "wkg.navigation.impl.hpp"
 #include "wkg.permission.impl.hpp"
 
+#include <array>
+#include <chrono>
 #include <cassert>
+#include <utility>
 #include <optional>
+#include <string_view>
 
 #include <json-glib/json-glib.h>
 
@@ -103,6 +107,12 @@ namespace saucer
                 .type    = type,
             });
 
+            if (self->remembered(*req))
+            {
+                return;
+            }
+
+            req->native<false>()->decided = self->recorder(*req);
             self->events.get<event::permission>().fire(req).find(status::handled);
         };
 
@@ -141,6 +151,11 @@ namespace saucer
             });
     }
 
+    template <>
+    void native::setup<event::process_gone>(impl *)
+    {
+    }
+
     template <>
     void native::setup<event::dom_ready>(impl *)
     {
@@ -175,7 +190,7 @@ namespace saucer
                 .type     = type,
             }};
 
-            if (self->events.get<event::navigate>().fire(nav).find(policy::block))
+            if (self->blocked(nav))
             {
                 webkit_policy_decision_ignore(raw);
                 return true;
@@ -257,13 +272,18 @@ namespace saucer
 
         auto callback = [](void *, GParamSpec *, impl *self)
         {
-            self->events.get<event::title>().fire(self->page_title());
+            self->title_changed();
         };
 
         const auto id = utils::connect(web_view, "notify::title", +callback, self);
         event.on_clear([this, id] { g_signal_handler_disconnect(web_view, id); });
     }
 
+    template <>
+    void native::setup<event::timing>(impl *)
+    {
+    }
+
     template <>
     void native::setup<event::load>(impl *)
     {
@@ -276,24 +296,26 @@ namespace saucer
 
     void native::on_message(WebKitWebView *, JSCValue *value, impl *self)
     {
-        auto message = std::string{utils::g_str_ptr{jsc_value_to_string(value)}.get()};
+        static constexpr std::string_view dom_loaded = "dom_loaded";
+
+        const auto raw     = utils::g_str_ptr{jsc_value_is_string(value) ? jsc_value_to_string(value) : jsc_value_to_json(value, 0)};
+        const auto message = std::string_view{raw.get()};
 
-        if (message == "dom_loaded")
+        if (!message.starts_with('{') && message == dom_loaded)
         {
             self->platform->dom_loaded = true;
 
-            for (const auto &pending : self->platform->pending)
+            for (const auto &script : std::exchange(self->platform->pending, {}))
             {
-                self->execute(pending);
+                self->execute(script);
             }
 
-            self->platform->pending.clear();
             self->events.get<event::dom_ready>().fire();
 
             return;
         }
 
-        self->events.get<event::message>().fire(message).find(status::handled);
+        self->dispatch(message);
     }
 
     void native::on_load(WebKitWebView *, WebKitLoadEvent event, impl *self)
@@ -319,7 +341,20 @@ namespace saucer
         self->events.get<event::load>().fire(state::started);
     }
 
-    void native::on_click(GtkGestureClick *gesture, gint, gdouble, gdouble, impl *self)
+    void native::on_terminated(WebKitWebView *, WebKitWebProcessTerminationReason reason, impl *self)
+    {
+        switch (reason)
+        {
+        case WEBKIT_WEB_PROCESS_CRASHED:
+            return self->process_gone(termination::crashed);
+        case WEBKIT_WEB_PROCESS_EXCEEDED_MEMORY_LIMIT:
+            return self->process_gone(termination::memory);
+        case WEBKIT_WEB_PROCESS_TERMINATED_BY_API:
+            return self->process_gone(termination::killed);
+        }
+    }
+
+    void native::on_click(GtkGestureClick *gesture, gint, gdouble x, gdouble y, impl *self)
     {
         auto *const controller = GTK_EVENT_CONTROLLER(gesture);
         auto *const event      = gtk_event_controller_get_current_event(controller);
@@ -328,6 +363,13 @@ namespace saucer
             .event      = utils::g_event_ptr::ref(event),
             .controller = controller,
         });
+
+        if (!self->regions || !self->draggable(x, y))
+        {
+            return;
+        }
+
+        self->window->start_drag();
     }
 
     void native::on_release(GtkGestureClick *, gdouble, gdouble, guint, GdkEventSequence *, impl *self)
@@ -343,6 +385,159 @@ namespace saucer
         previous.reset();
     }
 
+    script_ptr native::compile(const script &script)
+    {
+        using enum script::time;
+
+        const auto time = (script.run_at == creation) ? WEBKIT_USER_SCRIPT_INJECT_AT_DOCUMENT_START //
+                                                      : WEBKIT_USER_SCRIPT_INJECT_AT_DOCUMENT_END;
+
+        const auto frame = (script.no_frames) ? WEBKIT_USER_CONTENT_INJECT_TOP_FRAME //
+                                              : WEBKIT_USER_CONTENT_INJECT_ALL_FRAMES;
+
+        auto make = [&]
+        {
+            if (!script.world.has_value())
+            {
+                return webkit_user_script_new(script.code.c_str(), frame, time, nullptr, nullptr);
+            }
+
+            return webkit_user_script_new_for_world(script.code.c_str(), frame, time, script.world->c_str(), nullptr, nullptr);
+        };
+
+        if (script.clearable)
+        {
+            return make();
+        }
+
+        return compiled.get(script, make);
+    }
+
+    WebKitCacheModel native::convert(cache_model model)
+    {
+        switch (model)
+        {
+            using enum cache_model;
+
+        case document_viewer:
+            return WEBKIT_CACHE_MODEL_DOCUMENT_VIEWER;
+        case document_browser:
+            return WEBKIT_CACHE_MODEL_DOCUMENT_BROWSER;
+        case web_browser:
+            return WEBKIT_CACHE_MODEL_WEB_BROWSER;
+        }
+
+        std::unreachable();
+    }
+
+    soup_cookie_ptr native::convert(const cookie &cookie)
+    {
+        auto *const raw = soup_cookie_new(cookie.name.c_str(), cookie.value.c_str(), cookie.domain.c_str(), cookie.path.c_str(), -1);
+        auto rtn        = soup_cookie_ptr{raw};
+
+        soup_cookie_set_secure(rtn.get(), cookie.secure);
+        soup_cookie_set_http_only(rtn.get(), cookie.http_only);
+
+        if (!cookie.expires.has_value())
+        {
+            return rtn;
+        }
+
+        const auto seconds  = std::chrono::duration_cast<std::chrono::seconds>(cookie.expires->time_since_epoch());
+        auto *const expires = g_date_time_new_from_unix_utc(seconds.count());
+
+        soup_cookie_set_expires(rtn.get(), expires);
+        g_date_time_unref(expires);
+
+        return rtn;
+    }
+
+    WebKitWebsiteDataTypes native::convert(const site_data &data)
+    {
+        auto rtn = 0u;
+
+        if (data.cookies)
+        {
+            rtn |= WEBKIT_WEBSITE_DATA_COOKIES;
+        }
+
+        if (data.storage)
+        {
+            rtn |= WEBKIT_WEBSITE_DATA_LOCAL_STORAGE | WEBKIT_WEBSITE_DATA_SESSION_STORAGE | WEBKIT_WEBSITE_DATA_INDEXEDDB_DATABASES;
+            rtn |= WEBKIT_WEBSITE_DATA_SERVICE_WORKER_REGISTRATIONS | WEBKIT_WEBSITE_DATA_DOM_CACHE;
+        }
+
+        if (data.cache)
+        {
+            rtn |= WEBKIT_WEBSITE_DATA_MEMORY_CACHE | WEBKIT_WEBSITE_DATA_DISK_CACHE;
+        }
+
+        return static_cast<WebKitWebsiteDataTypes>(rtn);
+    }
+
+    WebKitUserContentFilterStore *native::filter_store()
+    {
+        static const auto path  = utils::g_str_ptr{g_build_filename(g_get_user_cache_dir(), "saucer", "content-rules", nullptr)};
+        static const auto store = utils::g_object_ptr<WebKitUserContentFilterStore>{webkit_user_content_filter_store_new(path.get())};
+
+        return store.get();
+    }
+
+    std::shared_ptr<utils::g_object_ptr<WebKitNetworkSession>> native::ephemeral_session(const std::optional<std::string> &session)
+    {
+        auto make = []
+        {
+            return utils::g_object_ptr<WebKitNetworkSession>{webkit_network_session_new_ephemeral()};
+        };
+
+        if (!session.has_value())
+        {
+            return std::make_shared<utils::g_object_ptr<WebKitNetworkSession>>(make());
+        }
+
+        return sessions.join(*session, make);
+    }
+
+    utils::g_object_ptr<GdkTexture> native::scale(GtkWidget *widget, GdkTexture *texture, saucer::size bounds)
+    {
+        auto *const root     = gtk_widget_get_native(widget);
+        auto *const renderer = root ? gtk_native_get_renderer(root) : nullptr;
+
+        if (!renderer)
+        {
+            return utils::g_object_ptr<GdkTexture>::ref(texture);
+        }
+
+        const auto [w, h] = impl::fit({.w = gdk_texture_get_width(texture), .h = gdk_texture_get_height(texture)}, bounds);
+        const auto rect   = GRAPHENE_RECT_INIT(0, 0, static_cast<float>(w), static_cast<float>(h));
+
+        auto *const node = gsk_texture_scale_node_new(texture, &rect, GSK_SCALING_FILTER_TRILINEAR);
+        auto rtn         = utils::g_object_ptr<GdkTexture>{gsk_renderer_render_texture(renderer, node, &rect)};
+
+        gsk_render_node_unref(node);
+
+        return rtn;
+    }
+
+    void native::set_back_forward_cache(WebKitSettings *settings, bool enabled)
+    {
+        // The page cache was renamed to back/forward cache, older versions only know the former
+        static constexpr std::array properties = {"enable-back-forward-cache", "enable-page-cache"};
+
+        auto *const klass = G_OBJECT_GET_CLASS(settings);
+
+        for (const auto *property : properties)
+        {
+            if (!g_object_class_find_property(klass, property))
+            {
+                continue;
+            }
+
+            g_object_set(settings, property, static_cast<gboolean>(enabled), nullptr);
+            return;
+        }
+    }
+
     WebKitSettings *native::make_settings(const options &opts)
     {
         std::vector<GValue> values;
@@ -8,6 +8,7 @@ namespace saucer::permission
 
     request::~request()
     {
+        m_impl->decided = nullptr;
         accept(false);
     }
 
@@ -56,5 +57,10 @@ namespace saucer::permission
             m_impl->request->put_State(value ? COREWEBVIEW2_PERMISSION_STATE_ALLOW : COREWEBVIEW2_PERMISSION_STATE_DENY);
         }
         deferral->Complete();
+
+        if (auto decided = std::exchange(m_impl->decided, nullptr); decided)
+        {
+            decided(value);
+        }
     }
 } // namespace saucer::permission
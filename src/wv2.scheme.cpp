@@ -1,18 +1,37 @@
 #include "wv2.scheme.impl.hpp"
 
 #include "win32.utils.hpp"
+#include "scheme.utils.hpp"
+
+#include <cctype>
+#include <algorithm>
 
 #include <shlwapi.h>
 
 namespace saucer::scheme
 {
-    void stream_buffer::push(const std::uint8_t *data, std::size_t size)
+    bool stream_buffer::push(stash data)
     {
+        if (data.size() == 0)
         {
-            std::lock_guard lock{m_mutex};
-            m_buffer.insert(m_buffer.end(), data, data + size);
+            return true;
+        }
+
+        {
+            std::unique_lock lock{m_mutex};
+            m_writable.wait(lock, [this] { return m_finished || !m_capacity.has_value() || m_size < *m_capacity; });
+
+            if (m_finished)
+            {
+                return false;
+            }
+
+            m_size += data.size();
+            m_chunks.emplace_back(std::move(data));
         }
-        m_cv.notify_one();
+        m_readable.notify_one();
+
+        return true;
     }
 
     void stream_buffer::close_write()
@@ -21,7 +40,17 @@ namespace saucer::scheme
             std::lock_guard lock{m_mutex};
             m_finished = true;
         }
-        m_cv.notify_one();
+        m_readable.notify_all();
+        m_writable.notify_all();
+    }
+
+    void stream_buffer::set_capacity(std::optional<std::size_t> capacity)
+    {
+        {
+            std::lock_guard lock{m_mutex};
+            m_capacity = capacity;
+        }
+        m_writable.notify_all();
     }
 
     HRESULT stream_buffer::QueryInterface(REFIID riid, void **ppv)
@@ -51,9 +80,9 @@ namespace saucer::scheme
     HRESULT stream_buffer::Read(void *pv, ULONG cb, ULONG *pcbRead)
     {
         std::unique_lock lock{m_mutex};
-        m_cv.wait(lock, [this] { return !m_buffer.empty() || m_finished; });
+        m_readable.wait(lock, [this] { return !m_chunks.empty() || m_finished; });
 
-        if (m_buffer.empty())
+        if (m_chunks.empty())
         {
             if (pcbRead)
             {
@@ -62,13 +91,36 @@ namespace saucer::scheme
             return m_finished ? S_FALSE : S_OK;
         }
 
-        auto to_read = std::min(static_cast<std::size_t>(cb), m_buffer.size());
-        std::copy_n(m_buffer.begin(), to_read, static_cast<std::uint8_t *>(pv));
-        m_buffer.erase(m_buffer.begin(), m_buffer.begin() + static_cast<std::ptrdiff_t>(to_read));
+        auto *const output = static_cast<std::uint8_t *>(pv);
+        std::size_t read{0};
+
+        while (read < cb && !m_chunks.empty())
+        {
+            const auto &front = m_chunks.front();
+            const auto count  = std::min(static_cast<std::size_t>(cb) - read, front.size() - m_offset);
+
+            std::copy_n(front.data() + m_offset, count, output + read);
+
+            read += count;
+            m_offset += count;
+
+            if (m_offset < front.size())
+            {
+                continue;
+            }
+
+            m_chunks.pop_front();
+            m_offset = 0;
+        }
+
+        m_size -= read;
+        lock.unlock();
+
+        m_writable.notify_one();
 
         if (pcbRead)
         {
-            *pcbRead = static_cast<ULONG>(to_read);
+            *pcbRead = static_cast<ULONG>(read);
         }
         return S_OK;
     }
@@ -95,6 +147,115 @@ namespace saucer::scheme
 
     HRESULT stream_buffer::Clone(IStream **) { return E_NOTIMPL; }
 
+    stash_stream::stash_stream(std::shared_ptr<const stash> data, std::size_t position) : m_data(std::move(data)), m_position(position)
+    {
+    }
+
+    HRESULT stash_stream::QueryInterface(REFIID riid, void **ppv)
+    {
+        if (riid == IID_IUnknown || riid == IID_IStream || riid == IID_ISequentialStream)
+        {
+            *ppv = static_cast<IStream *>(this);
+            AddRef();
+            return S_OK;
+        }
+        *ppv = nullptr;
+        return E_NOINTERFACE;
+    }
+
+    ULONG stash_stream::AddRef() { return InterlockedIncrement(&m_ref); }
+
+    ULONG stash_stream::Release()
+    {
+        auto ref = InterlockedDecrement(&m_ref);
+        if (ref == 0)
+        {
+            delete this;
+        }
+        return ref;
+    }
+
+    HRESULT stash_stream::Read(void *pv, ULONG cb, ULONG *pcbRead)
+    {
+        const auto size  = m_data->size();
+        const auto count = m_position < size ? std::min(static_cast<std::size_t>(cb), size - m_position) : 0;
+
+        std::copy_n(m_data->data() + m_position, count, static_cast<std::uint8_t *>(pv));
+        m_position += count;
+
+        if (pcbRead)
+        {
+            *pcbRead = static_cast<ULONG>(count);
+        }
+        return count < cb ? S_FALSE : S_OK;
+    }
+
+    HRESULT stash_stream::Seek(LARGE_INTEGER move, DWORD origin, ULARGE_INTEGER *position)
+    {
+        LONGLONG base{};
+
+        switch (origin)
+        {
+        case STREAM_SEEK_SET:
+            base = 0;
+            break;
+        case STREAM_SEEK_CUR:
+            base = static_cast<LONGLONG>(m_position);
+            break;
+        case STREAM_SEEK_END:
+            base = static_cast<LONGLONG>(m_data->size());
+            break;
+        default:
+            return STG_E_INVALIDFUNCTION;
+        }
+
+        const auto target = base + move.QuadPart;
+
+        if (target < 0)
+        {
+            return STG_E_INVALIDPOINTER;
+        }
+
+        m_position = static_cast<std::size_t>(target);
+
+        if (position)
+        {
+            position->QuadPart = m_position;
+        }
+        return S_OK;
+    }
+
+    HRESULT stash_stream::Write(const void *, ULONG, ULONG *) { return STG_E_ACCESSDENIED; }
+    HRESULT stash_stream::SetSize(ULARGE_INTEGER) { return STG_E_ACCESSDENIED; }
+    HRESULT stash_stream::CopyTo(IStream *, ULARGE_INTEGER, ULARGE_INTEGER *, ULARGE_INTEGER *) { return E_NOTIMPL; }
+    HRESULT stash_stream::Commit(DWORD) { return S_OK; }
+    HRESULT stash_stream::Revert() { return E_NOTIMPL; }
+    HRESULT stash_stream::LockRegion(ULARGE_INTEGER, ULARGE_INTEGER, DWORD) { return STG_E_INVALIDFUNCTION; }
+    HRESULT stash_stream::UnlockRegion(ULARGE_INTEGER, ULARGE_INTEGER, DWORD) { return STG_E_INVALIDFUNCTION; }
+
+    HRESULT stash_stream::Stat(STATSTG *pstatstg, DWORD)
+    {
+        if (!pstatstg)
+        {
+            return E_POINTER;
+        }
+        std::memset(pstatstg, 0, sizeof(*pstatstg));
+        pstatstg->type            = STGTY_STREAM;
+        pstatstg->cbSize.QuadPart = m_data->size();
+        pstatstg->grfMode         = STGM_READ;
+        return S_OK;
+    }
+
+    HRESULT stash_stream::Clone(IStream **stream)
+    {
+        if (!stream)
+        {
+            return E_POINTER;
+        }
+        *stream = new stash_stream{m_data, m_position};
+        return S_OK;
+    }
+
     stream_writer::stream_writer(std::shared_ptr<impl> impl) : m_impl(std::move(impl)) {}
     stream_writer::stream_writer(const stream_writer &) = default;
     stream_writer::stream_writer(stream_writer &&) noexcept = default;
@@ -124,6 +285,8 @@ namespace saucer::scheme
             combined += headers[i];
         }
 
+        m_impl->buffer->set_capacity(response.capacity);
+
         ComPtr<ICoreWebView2WebResourceResponse> result;
         m_impl->environment->CreateWebResourceResponse(m_impl->buffer.Get(), response.status, L"OK", combined.c_str(), &result);
 
@@ -131,14 +294,21 @@ namespace saucer::scheme
         m_impl->deferral->Complete();
     }
 
-    void stream_writer::write(stash data)
+    write_status stream_writer::write(stash data)
     {
         if (!m_impl || !m_impl->started || m_impl->finished)
         {
-            return;
+            return write_status::closed;
         }
 
-        m_impl->buffer->push(data.data(), data.size());
+        utils::metrics::get().scheme_bytes.fetch_add(data.size(), std::memory_order_relaxed);
+
+        return m_impl->buffer->push(std::move(data).owned()) ? write_status::written : write_status::closed;
+    }
+
+    write_status stream_writer::write_file(int fd, std::size_t offset, std::size_t length)
+    {
+        return utils::write_file(*this, fd, offset, length);
     }
 
     void stream_writer::finish()
@@ -200,27 +370,57 @@ namespace saucer::scheme
     {
         return m_impl && !m_impl->finished;
     }
-    request::request(impl data) : m_impl(std::make_unique<impl>(std::move(data))) {}
-
-    request::request(const request &other) : request(*other.m_impl) {}
+    request::request(impl data) : m_impl(std::make_shared<impl>(std::move(data))) {}
 
     request::request(request &&) noexcept = default;
 
     request::~request() = default;
 
+    request::impl request::impl::from(ICoreWebView2WebResourceRequest *request)
+    {
+        auto rtn = impl{};
+
+        utils::string_handle uri;
+        request->get_Uri(&uri.reset());
+        rtn.url = utils::narrow(uri.get());
+
+        utils::string_handle method;
+        request->get_Method(&method.reset());
+        rtn.method = utils::narrow(method.get());
+
+        request->get_Content(&rtn.body);
+
+        ComPtr<ICoreWebView2HttpRequestHeaders> headers;
+        request->get_Headers(&headers);
+
+        ComPtr<ICoreWebView2HttpHeadersCollectionIterator> it;
+        headers->GetIterator(&it);
+
+        BOOL has_header{};
+
+        while ((it->get_HasCurrentHeader(&has_header), has_header))
+        {
+            utils::string_handle header;
+            utils::string_handle value;
+
+            it->GetCurrentHeader(&header.reset(), &value.reset());
+            rtn.headers.emplace(utils::narrow(header.get()), utils::narrow(value.get()));
+
+            BOOL has_next{};
+            it->MoveNext(&has_next);
+        }
+
+        return rtn;
+    }
+
     url request::url() const
     {
-        utils::string_handle raw;
-        m_impl->request->get_Uri(&raw.reset());
-        return unwrap_safe(url::parse(utils::narrow(raw.get())));
+        return unwrap_safe(url::parse(m_impl->url));
     }
 
     std::string request::method() const
     {
-        utils::string_handle raw;
-        m_impl->request->get_Method(&raw.reset());
-
-        return utils::narrow(raw.get());
+        return m_impl->method;
     }
 
     stash request::content() const
@@ -230,32 +430,48 @@ namespace saucer::scheme
             return stash::empty();
         }
 
+        m_impl->body->Seek({}, STREAM_SEEK_SET, nullptr);
+
         return stash::from(utils::read(m_impl->body.Get()));
     }
 
-    std::map<std::string, std::string> request::headers() const
+    std::size_t request::read(std::span<std::uint8_t> buffer) const
     {
-        ComPtr<ICoreWebView2HttpRequestHeaders> headers;
-        m_impl->request->get_Headers(&headers);
+        if (!m_impl->body)
+        {
+            return 0;
+        }
 
-        ComPtr<ICoreWebView2HttpHeadersCollectionIterator> it;
-        headers->GetIterator(&it);
+        ULONG read{};
+        m_impl->body->Read(buffer.data(), static_cast<ULONG>(buffer.size()), &read);
 
-        std::map<std::string, std::string> rtn;
-        BOOL has_header{};
+        return read;
+    }
 
-        while ((it->get_HasCurrentHeader(&has_header), has_header))
+    std::optional<std::string> request::header(std::string_view name) const
+    {
+        auto equal = [](char a, char b)
         {
-            utils::string_handle header;
-            utils::string_handle value;
+            return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+        };
 
-            it->GetCurrentHeader(&header.reset(), &value.reset());
-            rtn.emplace(utils::narrow(header.get()), utils::narrow(value.get()));
+        auto matches = [&](const auto &item)
+        {
+            return std::ranges::equal(item.first, name, equal);
+        };
 
-            BOOL has_next{};
-            it->MoveNext(&has_next);
+        const auto it = std::ranges::find_if(m_impl->headers, matches);
+
+        if (it == m_impl->headers.end())
+        {
+            return std::nullopt;
         }
 
-        return rtn;
+        return it->second;
+    }
+
+    const std::map<std::string, std::string> &request::headers() const
+    {
+        return m_impl->headers;
     }
 } // namespace saucer::scheme
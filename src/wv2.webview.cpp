@@ -2,16 +2,20 @@
 
 #include "win32.error.hpp"
 #include "win32.app.impl.hpp"
+#include "win32.icon.impl.hpp"
 #include "win32.window.impl.hpp"
+#include "shared_buffer.impl.hpp"
 
 #include "scripts.hpp"
 
+#include "pool.hpp"
 #include "instantiate.hpp"
 #include "win32.utils.hpp"
 
 #include <format>
 #include <ranges>
 
+#include <cwchar>
 #include <cassert>
 #include <filesystem>
 
@@ -27,13 +31,18 @@ namespace saucer
     result<> impl::init_platform(const options &opts)
     {
         auto env_options = native::env_options();
-        auto flags       = opts.browser_flags;
+        auto flags       = impl::chromium_flags(opts);
 
         if (!opts.hardware_acceleration)
         {
             flags.emplace("--disable-gpu");
         }
 
+        if (opts.cache_size.has_value())
+        {
+            flags.emplace(std::format("--disk-cache-size={}", *opts.cache_size));
+        }
+
         const auto arguments = flags                        //
                                | std::views::join_with(' ') //
                                | std::ranges::to<std::string>();
@@ -55,9 +64,14 @@ namespace saucer
             return err(storage_path);
         }
 
+        auto *const app_impl = parent->native<false>();
+        auto start           = trace_clock::now();
+
         auto environment = native::create_environment(parent, {
                                                                   .storage_path = *storage_path,
+                                                                  .arguments    = utils::widen(arguments),
                                                                   .opts         = env_options.Get(),
+                                                                  .session      = opts.session,
                                                               });
 
         if (!environment.has_value())
@@ -65,9 +79,12 @@ namespace saucer
             return err(environment);
         }
 
+        app_impl->record(startup_phase::environment, start);
+
         auto *const parent_window = window->native<false>()->platform.get();
         auto *const hwnd          = parent_window->hwnd.get();
 
+        start           = trace_clock::now();
         auto controller = native::create_controller(parent, hwnd, environment->Get());
 
         if (!controller.has_value())
@@ -75,6 +92,8 @@ namespace saucer
             return err(controller);
         }
 
+        app_impl->record(startup_phase::controller, start);
+
         ComPtr<ICoreWebView2> raw;
 
         if (auto status = (*controller)->get_CoreWebView2(&raw); !SUCCEEDED(status))
@@ -95,6 +114,11 @@ namespace saucer
         platform->web_view   = std::move(web_view);
         platform->lease      = utils::lease<webview::impl *>{this};
 
+        if (opts.session.has_value())
+        {
+            platform->session = native::sessions.join(*opts.session, [&] { return *environment; });
+        }
+
         if (opts.non_persistent_data_store || (!opts.storage_path.has_value() && !opts.persistent_cookies))
         {
             platform->cleanup = *storage_path;
@@ -114,6 +138,29 @@ namespace saucer
             settings->put_AreBrowserAcceleratorKeysEnabled(false);
         }
 
+        if (ComPtr<ICoreWebView2Settings4> settings; SUCCEEDED(platform->settings.As(&settings)))
+        {
+            if (opts.autofill.has_value())
+            {
+                settings->put_IsGeneralAutofillEnabled(*opts.autofill);
+            }
+
+            if (opts.password_manager.has_value())
+            {
+                settings->put_IsPasswordAutosaveEnabled(*opts.password_manager);
+            }
+        }
+
+        if (ComPtr<ICoreWebView2Settings5> settings; opts.pinch_zoom.has_value() && SUCCEEDED(platform->settings.As(&settings)))
+        {
+            settings->put_IsPinchZoomEnabled(*opts.pinch_zoom);
+        }
+
+        if (ComPtr<ICoreWebView2Settings9> settings; opts.native_regions && SUCCEEDED(platform->settings.As(&settings)))
+        {
+            regions = SUCCEEDED(settings->put_IsNonClientRegionSupportEnabled(true));
+        }
+
         set_dev_tools(false);
 
         auto bind = [this]<typename T, typename... Ts>(T &&func)
@@ -128,6 +175,7 @@ namespace saucer
         platform->web_view->add_NavigationStarting(Callback<NavigationStarting>(bind(&native::on_navigation)).Get(), nullptr);
         platform->web_view->add_DOMContentLoaded(Callback<DOMLoaded>(bind(&native::on_dom)).Get(), nullptr);
         platform->web_view->add_FaviconChanged(Callback<FaviconChanged>(bind(&native::on_favicon)).Get(), nullptr);
+        platform->web_view->add_ProcessFailed(Callback<ProcessFailed>(bind(&native::on_failed)).Get(), nullptr);
 
         auto on_resize = [this, parent_window](int width, int height)
         {
@@ -141,7 +189,7 @@ namespace saucer
 
         auto on_minimize = [this](bool minimized)
         {
-            platform->controller->put_IsVisible(!minimized);
+            platform->controller->put_IsVisible(!minimized && !suspended);
         };
 
         platform->on_resize   = native::bound_events--;
@@ -293,11 +341,45 @@ namespace saucer
         platform->web_view->Navigate(utils::widen(url.string()).c_str());
     }
 
+    void impl::serve_directory(const fs::path &root, const std::string &host) // NOLINT(*-function-const)
+    {
+        // Mapped hosts are served from the browser process, requests never reach `WebResourceRequested`
+        static constexpr auto access = COREWEBVIEW2_HOST_RESOURCE_ACCESS_KIND_ALLOW;
+        const auto name              = utils::widen(host);
+
+        platform->web_view->ClearVirtualHostNameToFolderMapping(name.c_str());
+        platform->web_view->SetVirtualHostNameToFolderMapping(name.c_str(), root.wstring().c_str(), access);
+
+        platform->web_view->Navigate(std::format(L"https://{}/index.html", name).c_str());
+    }
+
     void impl::set_html(cstring_view html)
     {
         platform->web_view->NavigateToString(utils::widen(html).c_str());
     }
 
+    void impl::set_content_rules(std::vector<std::string> block) // NOLINT(*-function-const)
+    {
+        static constexpr auto context = COREWEBVIEW2_WEB_RESOURCE_CONTEXT_ALL;
+        static constexpr auto sources = COREWEBVIEW2_WEB_RESOURCE_REQUEST_SOURCE_KINDS_ALL;
+
+        for (const auto &[pattern, _] : platform->content_rules)
+        {
+            platform->web_view->RemoveWebResourceRequestedFilterWithRequestSourceKinds(pattern.c_str(), context, sources);
+        }
+
+        platform->content_rules.clear();
+
+        for (const auto &wildcard : block)
+        {
+            auto pattern = utils::widen(wildcard);
+
+            platform->web_view->AddWebResourceRequestedFilterWithRequestSourceKinds(pattern.c_str(), context, sources);
+
+            platform->content_rules.emplace_back(std::move(pattern), std::regex{impl::content_pattern(wildcard), std::regex::optimize});
+        }
+    }
+
     void impl::set_dev_tools(bool enabled) // NOLINT(*-function-const)
     {
         platform->settings->put_AreDevToolsEnabled(enabled);
@@ -345,11 +427,90 @@ namespace saucer
     void impl::reset_bounds() // NOLINT(*-function-const)
     {
         platform->bounds.reset();
+        place_surfaces();
     }
 
     void impl::set_bounds(saucer::bounds bounds) // NOLINT(*-function-const)
     {
         platform->bounds.emplace(bounds);
+        place_surfaces();
+    }
+
+    void impl::add_surface(void *handle, layer position) // NOLINT(*-function-const)
+    {
+        auto *const hwnd = static_cast<HWND>(handle);
+
+        ShowWindow(hwnd, SW_HIDE);
+
+        SetParent(hwnd, window->native<false>()->platform->hwnd.get());
+        SetWindowLongPtrW(hwnd, GWL_STYLE, (GetWindowLongPtrW(hwnd, GWL_STYLE) & ~WS_POPUP) | WS_CHILD | WS_CLIPSIBLINGS);
+
+        // The controller hosts its content in a child window of its own, siblings are ordered relative to it
+        SetWindowPos(hwnd, position == layer::below ? HWND_BOTTOM : HWND_TOP, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE);
+    }
+
+    void impl::remove_surface(void *handle) // NOLINT(*-function-const)
+    {
+        auto *const hwnd = static_cast<HWND>(handle);
+
+        ShowWindow(hwnd, SW_HIDE);
+        SetParent(hwnd, nullptr);
+    }
+
+    void impl::move_surface(void *handle, std::optional<saucer::bounds> bounds) // NOLINT(*-function-const)
+    {
+        auto *const hwnd = static_cast<HWND>(handle);
+
+        if (!bounds.has_value())
+        {
+            ShowWindow(hwnd, SW_HIDE);
+            return;
+        }
+
+        const auto *const parent_window = window->native<false>()->platform.get();
+        const auto origin               = platform->bounds.value_or({});
+
+        const auto [x, y] = parent_window->scale<mode::add>({.w = origin.x + bounds->x, .h = origin.y + bounds->y});
+        const auto [w, h] = parent_window->scale<mode::add>({.w = bounds->w, .h = bounds->h});
+
+        SetWindowPos(hwnd, nullptr, x, y, w, h, SWP_NOZORDER | SWP_NOACTIVATE | SWP_SHOWWINDOW);
+    }
+
+    void impl::suspend(bool value)
+    {
+        if (value)
+        {
+            auto done = [](HRESULT, BOOL)
+            {
+                return S_OK;
+            };
+
+            platform->controller->put_IsVisible(false);
+            platform->web_view->TrySuspend(Callback<ICoreWebView2TrySuspendCompletedHandler>(done).Get());
+
+            return;
+        }
+
+        platform->web_view->Resume();
+        platform->controller->put_IsVisible(!window->minimized());
+
+        if (!platform->dom_loaded)
+        {
+            return;
+        }
+
+        for (const auto &script : std::exchange(platform->pending, {}))
+        {
+            execute(script);
+        }
+    }
+
+    void impl::set_memory_target(memory_target target) // NOLINT(*-function-const)
+    {
+        const auto level = target == memory_target::low ? COREWEBVIEW2_MEMORY_USAGE_TARGET_LEVEL_LOW  //
+                                                        : COREWEBVIEW2_MEMORY_USAGE_TARGET_LEVEL_NORMAL;
+
+        platform->web_view->put_MemoryUsageTargetLevel(level);
     }
 
     void impl::back() // NOLINT(*-function-const)
@@ -369,13 +530,269 @@ namespace saucer
 
     void impl::execute(cstring_view code) // NOLINT(*-function-const)
     {
-        if (!platform->dom_loaded)
+        if (!platform->dom_loaded || suspended)
         {
             platform->pending.emplace_back(code);
             return;
         }
 
-        platform->web_view->ExecuteScript(utils::widen(code).c_str(), nullptr);
+        // The conversion buffer is kept around, recurring scripts then transcode without allocating
+        utils::widen(code, platform->widened);
+        platform->web_view->ExecuteScript(platform->widened.c_str(), nullptr);
+    }
+
+    void impl::evaluate_raw(cstring_view code, coco::promise<result<std::string>> promise) // NOLINT(*-function-const)
+    {
+        auto shared = std::make_shared<coco::promise<result<std::string>>>(std::move(promise));
+
+        auto completed = [shared](HRESULT status, LPCWSTR json)
+        {
+            if (!SUCCEEDED(status))
+            {
+                shared->set_value(err(status));
+                return S_OK;
+            }
+
+            shared->set_value(utils::narrow(json));
+
+            return S_OK;
+        };
+
+        platform->web_view->ExecuteScript(utils::widen(code).c_str(), Callback<ScriptExecuted>(completed).Get());
+    }
+
+    void impl::capture(std::optional<saucer::size> bounds, coco::promise<result<icon>> promise) // NOLINT(*-function-const)
+    {
+        auto shared = std::make_shared<coco::promise<result<icon>>>(std::move(promise));
+
+        ComPtr<IStream> stream;
+
+        if (auto status = CreateStreamOnHGlobal(nullptr, TRUE, &stream); !SUCCEEDED(status))
+        {
+            shared->set_value(err(status));
+            return;
+        }
+
+        auto completed = [shared, bounds, stream](HRESULT status)
+        {
+            if (!SUCCEEDED(status))
+            {
+                shared->set_value(err(status));
+                return S_OK;
+            }
+
+            stream->Seek({}, STREAM_SEEK_SET, nullptr);
+            auto bitmap = std::shared_ptr<Gdiplus::Bitmap>(Gdiplus::Bitmap::FromStream(stream.Get()));
+
+            if (!bounds.has_value())
+            {
+                shared->set_value(icon{icon::impl{std::move(bitmap)}});
+                return S_OK;
+            }
+
+            auto scale = [shared, bounds = *bounds, bitmap = std::move(bitmap)]
+            {
+                const auto source = saucer::size{.w = static_cast<int>(bitmap->GetWidth()), .h = static_cast<int>(bitmap->GetHeight())};
+                const auto [w, h] = impl::fit(source, bounds);
+
+                auto rtn = std::make_shared<Gdiplus::Bitmap>(w, h, PixelFormat32bppPARGB);
+
+                Gdiplus::Graphics graphics{rtn.get()};
+                graphics.SetInterpolationMode(Gdiplus::InterpolationModeHighQualityBicubic);
+                graphics.DrawImage(bitmap.get(), 0, 0, w, h);
+
+                shared->set_value(icon{icon::impl{std::move(rtn)}});
+            };
+
+            utils::pool::shared().submit(std::move(scale));
+
+            return S_OK;
+        };
+
+        platform->web_view->CapturePreview(COREWEBVIEW2_CAPTURE_PREVIEW_IMAGE_FORMAT_PNG, stream.Get(),
+                                           Callback<PreviewCaptured>(completed).Get());
+    }
+
+    void impl::memory_stats(coco::promise<memory_usage> promise) // NOLINT(*-function-const)
+    {
+        auto shared = std::make_shared<coco::promise<memory_usage>>(std::move(promise));
+        auto usage  = memory_usage{.engine = native::engine_memory(platform->web_view.Get())};
+
+        auto completed = [shared, usage](HRESULT status, LPCWSTR json) mutable
+        {
+            std::size_t heap{};
+
+            if (SUCCEEDED(status) && std::swscanf(json, L"%zu", &heap) == 1)
+            {
+                usage.heap = heap;
+            }
+
+            shared->set_value(usage);
+
+            return S_OK;
+        };
+
+        const auto code = utils::widen(scripts::heap_script);
+        platform->web_view->ExecuteScript(code.c_str(), Callback<ScriptExecuted>(completed).Get());
+    }
+
+    void impl::devtools_protocol(const std::string &method, const std::string &params,
+                                 coco::promise<result<std::string>> promise) // NOLINT(*-function-const)
+    {
+        auto shared = std::make_shared<coco::promise<result<std::string>>>(std::move(promise));
+
+        auto completed = [shared](HRESULT status, LPCWSTR json)
+        {
+            if (!SUCCEEDED(status))
+            {
+                shared->set_value(err(status));
+                return S_OK;
+            }
+
+            shared->set_value(utils::narrow(json));
+
+            return S_OK;
+        };
+
+        platform->web_view->CallDevToolsProtocolMethod(utils::widen(method).c_str(), utils::widen(params).c_str(),
+                                                       Callback<ProtocolCalled>(completed).Get());
+    }
+
+    void impl::set_cookies(std::vector<cookie> cookies, coco::promise<result<>> promise) // NOLINT(*-function-const)
+    {
+        ComPtr<ICoreWebView2CookieManager> manager;
+
+        if (auto status = platform->web_view->get_CookieManager(&manager); !SUCCEEDED(status))
+        {
+            promise.set_value(err(status));
+            return;
+        }
+
+        // The cookie manager only queues the cookies, they are written by the browser process in the background
+        for (const auto &cookie : cookies)
+        {
+            ComPtr<ICoreWebView2Cookie> native;
+
+            const auto name   = utils::widen(cookie.name);
+            const auto value  = utils::widen(cookie.value);
+            const auto domain = utils::widen(cookie.domain);
+            const auto path   = utils::widen(cookie.path);
+
+            if (auto status = manager->CreateCookie(name.c_str(), value.c_str(), domain.c_str(), path.c_str(), &native); !SUCCEEDED(status))
+            {
+                promise.set_value(err(status));
+                return;
+            }
+
+            if (cookie.expires.has_value())
+            {
+                const auto seconds = std::chrono::duration<double>{cookie.expires->time_since_epoch()};
+                native->put_Expires(seconds.count());
+            }
+
+            native->put_IsSecure(cookie.secure);
+            native->put_IsHttpOnly(cookie.http_only);
+
+            if (auto status = manager->AddOrUpdateCookie(native.Get()); !SUCCEEDED(status))
+            {
+                promise.set_value(err(status));
+                return;
+            }
+        }
+
+        promise.set_value({});
+    }
+
+    void impl::clear_data(const site_data &data, coco::promise<result<>> promise) // NOLINT(*-function-const)
+    {
+        auto shared = std::make_shared<coco::promise<result<>>>(std::move(promise));
+
+        if (data.origin.has_value())
+        {
+            std::vector<std::string_view> types;
+
+            if (data.cookies)
+            {
+                types.emplace_back("cookies");
+            }
+
+            if (data.storage)
+            {
+                types.insert(types.end(), {"local_storage", "indexeddb", "websql", "file_systems", "service_workers"});
+            }
+
+            if (data.cache)
+            {
+                types.emplace_back("cache_storage");
+            }
+
+            if (types.empty())
+            {
+                shared->set_value({});
+                return;
+            }
+
+            if (data.origin->find_first_of(R"("\)") != std::string::npos)
+            {
+                shared->set_value(err(std::errc::invalid_argument));
+                return;
+            }
+
+            auto completed = [shared](HRESULT status, LPCWSTR)
+            {
+                shared->set_value(SUCCEEDED(status) ? result<>{} : err(status));
+                return S_OK;
+            };
+
+            // The HTTP cache is not partitioned by origin on WebView2, only the Cache API storage of the origin can be dropped
+            const auto joined = types | std::views::join_with(',') | std::ranges::to<std::string>();
+            const auto params = std::format(R"({{"origin":"{}","storageTypes":"{}"}})", *data.origin, joined);
+
+            platform->web_view->CallDevToolsProtocolMethod(L"Storage.clearDataForOrigin", utils::widen(params).c_str(),
+                                                           Callback<ProtocolCalled>(completed).Get());
+
+            return;
+        }
+
+        ComPtr<ICoreWebView2Profile> profile;
+        ComPtr<ICoreWebView2Profile2> profile2;
+
+        if (auto status = platform->web_view->get_Profile(&profile); !SUCCEEDED(status) || !SUCCEEDED(status = profile.As(&profile2)))
+        {
+            shared->set_value(err(status));
+            return;
+        }
+
+        auto kinds = 0;
+
+        if (data.cookies)
+        {
+            kinds |= COREWEBVIEW2_BROWSING_DATA_KINDS_COOKIES;
+        }
+
+        if (data.storage)
+        {
+            kinds |= COREWEBVIEW2_BROWSING_DATA_KINDS_ALL_DOM_STORAGE;
+        }
+
+        if (data.cache)
+        {
+            kinds |= COREWEBVIEW2_BROWSING_DATA_KINDS_DISK_CACHE;
+        }
+
+        if (kinds == 0)
+        {
+            shared->set_value({});
+            return;
+        }
+
+        auto completed = [shared](HRESULT status)
+        {
+            shared->set_value(SUCCEEDED(status) ? result<>{} : err(status));
+            return S_OK;
+        };
+
+        profile2->ClearBrowsingData(static_cast<COREWEBVIEW2_BROWSING_DATA_KINDS>(kinds), Callback<BrowsingDataCleared>(completed).Get());
     }
 
     std::size_t impl::inject(const script &raw)
@@ -385,6 +802,8 @@ namespace saucer
         auto script   = wv2_script{raw};
         const auto id = platform->id_counter++;
 
+        // WebView2 has no isolated worlds, scripts that request one still run in the page's world
+
         if (script.no_frames)
         {
             script.code = std::format(R"js(
@@ -448,32 +867,32 @@ namespace saucer
 
     void impl::handle_scheme(const std::string &name, scheme::resolver &&resolver) // NOLINT(*-function-const)
     {
-        if (platform->schemes.contains(name))
+        if (!platform->schemes.try_emplace(name, std::move(resolver)).second)
         {
             return;
         }
 
-        platform->schemes.emplace(name, std::move(resolver));
-
-        const auto pattern = utils::widen(std::format("{}*", name));
+        if (platform->stream_schemes.contains(name))
+        {
+            return;
+        }
 
-        platform->web_view->AddWebResourceRequestedFilterWithRequestSourceKinds(pattern.c_str(), COREWEBVIEW2_WEB_RESOURCE_CONTEXT_ALL,
-                                                                                COREWEBVIEW2_WEB_RESOURCE_REQUEST_SOURCE_KINDS_ALL);
+        platform->filter(name, true);
     }
 
     void impl::handle_stream_scheme(const std::string &name, scheme::stream_resolver &&resolver) // NOLINT(*-function-const)
     {
-        if (platform->stream_schemes.contains(name))
+        if (!platform->stream_schemes.try_emplace(name, std::move(resolver)).second)
         {
             return;
         }
 
-        platform->stream_schemes.emplace(name, std::move(resolver));
-
-        const auto pattern = utils::widen(std::format("{}*", name));
+        if (platform->schemes.contains(name))
+        {
+            return;
+        }
 
-        platform->web_view->AddWebResourceRequestedFilterWithRequestSourceKinds(pattern.c_str(), COREWEBVIEW2_WEB_RESOURCE_CONTEXT_ALL,
-                                                                                COREWEBVIEW2_WEB_RESOURCE_REQUEST_SOURCE_KINDS_ALL);
+        platform->filter(name, true);
     }
 
     void impl::remove_scheme(const std::string &name) // NOLINT(*-function-const)
@@ -485,12 +904,14 @@ namespace saucer
             return;
         }
 
-        const auto pattern = utils::widen(std::format("{}*", name));
+        platform->schemes.erase(it);
 
-        platform->web_view->RemoveWebResourceRequestedFilterWithRequestSourceKinds(pattern.c_str(), COREWEBVIEW2_WEB_RESOURCE_CONTEXT_ALL,
-                                                                                   COREWEBVIEW2_WEB_RESOURCE_REQUEST_SOURCE_KINDS_ALL);
+        if (platform->stream_schemes.contains(name))
+        {
+            return;
+        }
 
-        platform->schemes.erase(it);
+        platform->filter(name, false);
     }
 
     void impl::remove_stream_scheme(const std::string &name) // NOLINT(*-function-const)
@@ -502,12 +923,14 @@ namespace saucer
             return;
         }
 
-        const auto pattern = utils::widen(std::format("{}*", name));
+        platform->stream_schemes.erase(it);
 
-        platform->web_view->RemoveWebResourceRequestedFilterWithRequestSourceKinds(pattern.c_str(), COREWEBVIEW2_WEB_RESOURCE_CONTEXT_ALL,
-                                                                                   COREWEBVIEW2_WEB_RESOURCE_REQUEST_SOURCE_KINDS_ALL);
+        if (platform->schemes.contains(name))
+        {
+            return;
+        }
 
-        platform->stream_schemes.erase(it);
+        platform->filter(name, false);
     }
 
     void impl::register_scheme(const std::string &name)
@@ -542,18 +965,107 @@ namespace saucer
         assert(false);
     }
 
-    std::string impl::ready_script()
+    void impl::prewarm(const application::options &opts)
     {
-        return "";
+        auto id           = utils::widen(opts.id.value());
+        auto storage_path = native::default_user_folder(id);
+
+        if (!storage_path.has_value())
+        {
+            return;
+        }
+
+        register_scheme("saucer");
+
+        auto state = std::make_shared<prewarmed_environment>(storage_path->wstring());
+
+        auto completed = [state](HRESULT, ICoreWebView2Environment *environment)
+        {
+            state->ready       = true;
+            state->environment = environment;
+            return S_OK;
+        };
+
+        auto env_options = native::env_options();
+        env_options->put_AdditionalBrowserArguments(L"");
+
+        const auto callback = Callback<EnvironmentCompleted>(completed);
+
+        if (!SUCCEEDED(CreateCoreWebView2EnvironmentWithOptions(nullptr, state->storage_path.c_str(), env_options.Get(), callback.Get())))
+        {
+            return;
+        }
+
+        native::prewarmed = std::move(state);
     }
 
-    std::string impl::creation_script()
+    result<shared_buffer> impl::create_buffer(std::size_t size) // NOLINT(*-function-const)
+    {
+        ComPtr<ICoreWebView2Environment> environment;
+
+        if (auto status = platform->web_view->get_Environment(&environment); !SUCCEEDED(status))
+        {
+            return err(status);
+        }
+
+        ComPtr<ICoreWebView2Environment12> factory;
+
+        if (auto status = environment.As(&factory); !SUCCEEDED(status))
+        {
+            return err(status);
+        }
+
+        ComPtr<ICoreWebView2SharedBuffer> buffer;
+
+        if (auto status = factory->CreateSharedBuffer(size, &buffer); !SUCCEEDED(status))
+        {
+            return err(status);
+        }
+
+        BYTE *data{};
+
+        if (auto status = buffer->get_Buffer(&data); !SUCCEEDED(status))
+        {
+            return err(status);
+        }
+
+        auto rtn    = std::make_shared<shared_buffer::impl>();
+        rtn->data   = {data, size};
+        rtn->handle = std::shared_ptr<void>{buffer.Get(), [buffer](void *) { buffer->Close(); }};
+
+        return shared_buffer{std::move(rtn)};
+    }
+
+    void impl::share(const shared_buffer &buffer, std::string_view topic) // NOLINT(*-function-const)
+    {
+        auto *native = static_cast<ICoreWebView2SharedBuffer *>(buffer.native()->handle.get());
+
+        if (!native)
+        {
+            return share_fallback(buffer, topic);
+        }
+
+        const auto data = utils::widen(std::format(R"({{"saucer:topic":{}}})", topic));
+        platform->web_view->PostSharedBufferToScript(native, COREWEBVIEW2_SHARED_BUFFER_ACCESS_READ_WRITE, data.c_str());
+    }
+
+    const std::string &impl::ready_script()
+    {
+        static const std::string script{};
+        return script;
+    }
+
+    const std::string &impl::creation_script()
     {
         static const auto script = std::format(scripts::ipc_script, R"js(
             message: async (message) =>
             {
                 window.chrome.webview.postMessage(message);
-            }
+            },
+            attach: window.chrome.webview.postMessageWithAdditionalObjects ? async (message, files) =>
+            {
+                window.chrome.webview.postMessageWithAdditionalObjects(message, files);
+            } : null,
         )js");
 
         return script;
@@ -9,6 +9,7 @@
 #include "wv2.navigation.impl.hpp"
 
 #include <cassert>
+#include <algorithm>
 
 #include <format>
 #include <ranges>
@@ -16,8 +17,8 @@
 #include <winerror.h>
 
 #include <windows.h>
+#include <psapi.h>
 #include <gdiplus.h>
-#include <shlwapi.h>
 
 namespace saucer
 {
@@ -50,6 +51,13 @@ namespace saucer
                 .deferral = std::move(deferral),
             });
 
+            if (self->remembered(*req))
+            {
+                return S_OK;
+            }
+
+            req->native<false>()->decided = self->recorder(*req);
+
             auto fire = [req](impl *self)
             {
                 self->events.get<event::permission>().fire(req).find(status::handled);
@@ -71,6 +79,11 @@ namespace saucer
     {
     }
 
+    template <>
+    void native::setup<event::process_gone>(impl *)
+    {
+    }
+
     template <>
     void native::setup<event::dom_ready>(impl *)
     {
@@ -138,9 +151,7 @@ namespace saucer
 
         auto handler = [self](auto...)
         {
-            auto title = self->page_title();
-            self->parent->post(utils::defer(self->platform->lease, [title](impl *self) { self->events.get<event::title>().fire(title); }));
-
+            self->title_changed();
             return S_OK;
         };
 
@@ -150,6 +161,11 @@ namespace saucer
         event.on_clear([this, token] { web_view->remove_DocumentTitleChanged(token); });
     }
 
+    template <>
+    void native::setup<event::timing>(impl *)
+    {
+    }
+
     template <>
     void native::setup<event::load>(impl *self)
     {
@@ -179,7 +195,19 @@ namespace saucer
 
     ComPtr<ICoreWebView2EnvironmentOptions> native::env_options()
     {
-        static auto instance = Make<CoreWebView2EnvironmentOptions>();
+        static auto instance = []
+        {
+            auto rtn = Make<CoreWebView2EnvironmentOptions>();
+
+            // Other processes that use the same user data folder (and options) attach to our browser process instead of spawning one
+            if (ComPtr<ICoreWebView2EnvironmentOptions2> options; SUCCEEDED(rtn.As(&options)))
+            {
+                options->put_ExclusiveUserDataFolderAccess(false);
+            }
+
+            return rtn;
+        }();
+
         return instance;
     }
 
@@ -197,18 +225,54 @@ namespace saucer
 
     result<ComPtr<ICoreWebView2Environment>> native::create_environment(application *parent, const environment_options &options)
     {
+        const auto &[storage_path, arguments, opts, session] = options;
+
+        if (auto joined = session ? sessions.find(*session) : nullptr; joined)
+        {
+            return *joined;
+        }
+
+        auto key = std::make_pair(storage_path, arguments);
+
+        auto remember = [&](ComPtr<ICoreWebView2Environment> environment)
+        {
+            environments.try_emplace(std::move(key), environment);
+            return environment;
+        };
+
+        // Webviews that agree on their user data folder and browser arguments can share one environment, and thus one browser process
+        if (auto it = environments.find(key); it != environments.end())
+        {
+            return remember(it->second);
+        }
+
         ComPtr<ICoreWebView2Environment> rtn{};
 
+        if (prewarmed && prewarmed->storage_path == storage_path && arguments.empty())
+        {
+            auto state = std::exchange(prewarmed, nullptr);
+
+            while (!state->ready)
+            {
+                parent->native<false>()->platform->iteration();
+            }
+
+            rtn = std::move(state->environment);
+        }
+
+        if (rtn)
+        {
+            return remember(std::move(rtn));
+        }
+
         auto completed = [&rtn](auto, auto *environment)
         {
             rtn = environment;
             return S_OK;
         };
 
-        const auto &[storage_path, opts] = options;
-        const auto callback              = Callback<EnvironmentCompleted>(completed);
-
-        auto status = CreateCoreWebView2EnvironmentWithOptions(nullptr, storage_path.c_str(), opts, callback.Get());
+        const auto callback = Callback<EnvironmentCompleted>(completed);
+        auto status         = CreateCoreWebView2EnvironmentWithOptions(nullptr, storage_path.c_str(), opts, callback.Get());
 
         if (!SUCCEEDED(status))
         {
@@ -220,7 +284,7 @@ namespace saucer
             parent->native<false>()->platform->iteration();
         }
 
-        return rtn;
+        return remember(std::move(rtn));
     }
 
     result<ComPtr<ICoreWebView2Controller>> native::create_controller(application *parent, HWND hwnd, ICoreWebView2Environment *env)
@@ -248,20 +312,121 @@ namespace saucer
         return rtn;
     }
 
+    std::optional<std::size_t> native::engine_memory(ICoreWebView2 *web_view)
+    {
+        ComPtr<ICoreWebView2Environment> environment;
+
+        if (!SUCCEEDED(web_view->get_Environment(&environment)))
+        {
+            return std::nullopt;
+        }
+
+        ComPtr<ICoreWebView2Environment8> processes;
+        ComPtr<ICoreWebView2ProcessInfoCollection> infos;
+
+        if (!SUCCEEDED(environment.As(&processes)) || !SUCCEEDED(processes->GetProcessInfos(&infos)))
+        {
+            return std::nullopt;
+        }
+
+        UINT count{};
+        infos->get_Count(&count);
+
+        // The browser and its helpers are shared by every webview in the environment, so this is the footprint of the whole engine
+        std::size_t rtn{};
+
+        for (auto i = 0u; count > i; i++)
+        {
+            ComPtr<ICoreWebView2ProcessInfo> info;
+            INT32 pid{};
+
+            if (!SUCCEEDED(infos->GetValueAtIndex(i, &info)) || !SUCCEEDED(info->get_ProcessId(&pid)))
+            {
+                continue;
+            }
+
+            utils::process_handle handle = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, false, static_cast<DWORD>(pid));
+            PROCESS_MEMORY_COUNTERS counters{};
+
+            if (!handle.get() || !GetProcessMemoryInfo(handle.get(), &counters, sizeof(counters)))
+            {
+                continue;
+            }
+
+            rtn += counters.WorkingSetSize;
+        }
+
+        return rtn;
+    }
+
+    std::vector<fs::path> native::attached(ICoreWebView2WebMessageReceivedEventArgs *args)
+    {
+        ComPtr<ICoreWebView2WebMessageReceivedEventArgs2> extended;
+        ComPtr<ICoreWebView2ObjectCollectionView> objects;
+
+        if (!SUCCEEDED(ComPtr<ICoreWebView2WebMessageReceivedEventArgs>{args}.As(&extended)) ||
+            !SUCCEEDED(extended->get_AdditionalObjects(&objects)) || !objects)
+        {
+            return {};
+        }
+
+        UINT32 count{};
+
+        if (!SUCCEEDED(objects->get_Count(&count)))
+        {
+            return {};
+        }
+
+        std::vector<fs::path> rtn;
+        rtn.reserve(count);
+
+        for (UINT32 i = 0; count > i; i++)
+        {
+            ComPtr<IUnknown> object;
+            utils::string_handle path;
+
+            if (!SUCCEEDED(objects->GetValueAtIndex(i, &object)) || !object)
+            {
+                return {};
+            }
+
+            // `File` objects and `FileSystemHandle`s are both backed by a file on disk, only its path is handed over
+            if (ComPtr<ICoreWebView2File> file; SUCCEEDED(object.As(&file)) && SUCCEEDED(file->get_Path(&path.reset())))
+            {
+                rtn.emplace_back(path.get());
+                continue;
+            }
+
+            if (ComPtr<ICoreWebView2FileSystemHandle> handle; SUCCEEDED(object.As(&handle)) && SUCCEEDED(handle->get_Path(&path.reset())))
+            {
+                rtn.emplace_back(path.get());
+                continue;
+            }
+
+            return {};
+        }
+
+        return rtn;
+    }
+
     HRESULT native::on_message(impl *self, ICoreWebView2 *, ICoreWebView2WebMessageReceivedEventArgs *args)
     {
         utils::string_handle raw;
 
-        if (auto status = args->TryGetWebMessageAsString(&raw.reset()); !SUCCEEDED(status))
+        if (!SUCCEEDED(args->TryGetWebMessageAsString(&raw.reset())))
         {
-            return status;
+            if (auto status = args->get_WebMessageAsJson(&raw.reset()); !SUCCEEDED(status))
+            {
+                return status;
+            }
         }
 
         auto message = utils::narrow(raw.get());
+        auto files   = native::attached(args);
 
-        auto fire = [message = std::move(message)](impl *self)
+        auto fire = [message = std::move(message), files = std::move(files)](impl *self) mutable
         {
-            self->events.get<event::message>().fire(message).find(status::handled);
+            self->dispatch(message, std::move(files));
         };
 
         self->parent->post(utils::defer(self->platform->lease, fire));
@@ -269,6 +434,23 @@ namespace saucer
         return S_OK;
     }
 
+    void native::filter(const std::string &scheme, bool enabled) const
+    {
+        static constexpr auto context = COREWEBVIEW2_WEB_RESOURCE_CONTEXT_ALL;
+        static constexpr auto sources = COREWEBVIEW2_WEB_RESOURCE_REQUEST_SOURCE_KINDS_ALL;
+
+        // Anchoring on the scheme separator keeps schemes that merely share a prefix (e.g. "app" and "apps") out of the handler
+        const auto pattern = utils::widen(std::format("{}:*", scheme));
+
+        if (enabled)
+        {
+            web_view->AddWebResourceRequestedFilterWithRequestSourceKinds(pattern.c_str(), context, sources);
+            return;
+        }
+
+        web_view->RemoveWebResourceRequestedFilterWithRequestSourceKinds(pattern.c_str(), context, sources);
+    }
+
     HRESULT native::on_resource(impl *self, ICoreWebView2 *, ICoreWebView2WebResourceRequestedEventArgs *args)
     {
         ComPtr<ICoreWebView2WebResourceRequest> request;
@@ -285,7 +467,24 @@ namespace saucer
             return status;
         }
 
-        auto parsed = url::parse(utils::narrow(raw.get()));
+        const auto uri = utils::narrow(raw.get());
+
+        if (std::ranges::any_of(self->platform->content_rules, [&uri](const auto &rule) { return std::regex_match(uri, rule.second); }))
+        {
+            ComPtr<ICoreWebView2Environment> environment;
+
+            if (auto status = self->platform->web_view->get_Environment(&environment); !SUCCEEDED(status))
+            {
+                return status;
+            }
+
+            ComPtr<ICoreWebView2WebResourceResponse> response;
+            environment->CreateWebResourceResponse(nullptr, 403, L"Blocked", L"", &response);
+
+            return args->put_Response(response.Get());
+        }
+
+        auto parsed = url::parse(uri);
 
         if (!parsed.has_value())
         {
@@ -313,12 +512,11 @@ namespace saucer
             self->execute(script.code);
         }
 
-        for (const auto &pending : self->platform->pending)
+        for (const auto &script : std::exchange(self->platform->pending, {}))
         {
-            self->execute(pending);
+            self->execute(script);
         }
 
-        self->platform->pending.clear();
         self->parent->post(utils::defer(self->platform->lease, [](impl *self) { self->events.get<event::dom_ready>().fire(); }));
 
         return S_OK;
@@ -338,7 +536,7 @@ namespace saucer
             .request = args,
         }};
 
-        if (self->events.get<event::navigate>().fire(nav).find(policy::block))
+        if (self->blocked(nav))
         {
             args->put_Cancel(true);
         }
@@ -346,6 +544,49 @@ namespace saucer
         return S_OK;
     }
 
+    HRESULT native::on_failed(impl *self, ICoreWebView2 *, ICoreWebView2ProcessFailedEventArgs *args)
+    {
+        COREWEBVIEW2_PROCESS_FAILED_KIND kind{};
+
+        if (auto status = args->get_ProcessFailedKind(&kind); !SUCCEEDED(status))
+        {
+            return status;
+        }
+
+        // Helper processes (GPU, utility, ...) are restarted by WebView2 itself
+        const auto browser  = kind == COREWEBVIEW2_PROCESS_FAILED_KIND_BROWSER_PROCESS_EXITED;
+        const auto renderer = kind == COREWEBVIEW2_PROCESS_FAILED_KIND_RENDER_PROCESS_EXITED ||
+                              kind == COREWEBVIEW2_PROCESS_FAILED_KIND_FRAME_RENDER_PROCESS_EXITED;
+
+        if (!browser && !renderer)
+        {
+            return S_OK;
+        }
+
+        auto reason       = termination::crashed;
+        const auto failed = ComPtr<ICoreWebView2ProcessFailedEventArgs>{args};
+
+        if (ComPtr<ICoreWebView2ProcessFailedEventArgs2> detailed; SUCCEEDED(failed.As(&detailed)))
+        {
+            COREWEBVIEW2_PROCESS_FAILED_REASON failure{};
+            detailed->get_Reason(&failure);
+
+            if (failure == COREWEBVIEW2_PROCESS_FAILED_REASON_OUT_OF_MEMORY)
+            {
+                reason = termination::memory;
+            }
+            else if (failure == COREWEBVIEW2_PROCESS_FAILED_REASON_TERMINATED)
+            {
+                reason = termination::killed;
+            }
+        }
+
+        // A lost browser process takes the controller with it, there is nothing left to reload
+        self->process_gone(reason, !browser);
+
+        return S_OK;
+    }
+
     HRESULT native::on_favicon(impl *self, ICoreWebView2 *, IUnknown *)
     {
         auto callback = [self](auto, auto *stream)
@@ -394,7 +635,7 @@ namespace saucer
                 .request = args,
             }};
 
-            self->events.get<event::navigate>().fire(nav).find(policy::block);
+            self->blocked(nav);
             deferral->Complete();
         };
 
@@ -423,13 +664,6 @@ namespace saucer
             return status;
         }
 
-        ComPtr<IStream> content;
-
-        if (auto status = opts.request->get_Content(&content); !SUCCEEDED(status))
-        {
-            return status;
-        }
-
         if (stream_scheme != stream_schemes.end())
         {
             auto writer_impl = std::make_shared<scheme::stream_writer::impl>();
@@ -440,7 +674,7 @@ namespace saucer
             writer_impl->buffer.Attach(new scheme::stream_buffer());
 
             auto writer = scheme::stream_writer{writer_impl};
-            auto req    = scheme::request{{.request = opts.request, .body = content}};
+            auto req    = scheme::request{scheme::request::impl::from(opts.request.Get())};
 
             stream_scheme->second(std::move(req), std::move(writer));
 
@@ -455,12 +689,11 @@ namespace saucer
             return S_OK;
         }
 
-        auto resolve = [environment, deferral, request = opts.raw](const scheme::response &response)
+        auto resolve = [environment, deferral, request = opts.raw](scheme::response response)
         {
-            const auto *raw = reinterpret_cast<const BYTE *>(response.data.data());
-            const auto size = static_cast<const UINT>(response.data.size());
+            ComPtr<IStream> buffer;
+            buffer.Attach(new scheme::stash_stream{std::make_shared<const stash>(std::move(response.data))});
 
-            ComPtr<IStream> buffer            = SHCreateMemStream(raw, size);
             std::vector<std::wstring> headers = {std::format(L"Content-Type: {}", utils::widen(response.mime))};
 
             for (const auto &[name, value] : response.headers)
@@ -518,7 +751,7 @@ namespace saucer
 
         auto &resolver = scheme->second;
 
-        auto req      = scheme::request{{.request = opts.request, .body = content}};
+        auto req      = scheme::request{scheme::request::impl::from(opts.request.Get())};
         auto executor = scheme::executor{forward(std::move(resolve)), forward(std::move(reject))};
 
         resolver(std::move(req), std::move(executor));
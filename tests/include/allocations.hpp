@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace saucer::tests::allocations
+{
+    inline std::atomic_size_t counter{0};
+    inline thread_local std::size_t local{0};
+
+    inline std::size_t count()
+    {
+        return counter.load(std::memory_order_relaxed);
+    }
+
+    // Only counts what the calling thread allocated, unaffected by whatever the event loop does meanwhile
+    inline std::size_t count_local()
+    {
+        return local;
+    }
+
+    inline constexpr bool enabled()
+    {
+#ifdef SAUCER_TESTS_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    struct budget
+    {
+        std::size_t limit;
+        std::size_t calls{1};
+
+      public:
+        std::size_t start{count()};
+
+      public:
+        [[nodiscard]] std::size_t used() const
+        {
+            return count() - start;
+        }
+
+        [[nodiscard]] bool kept() const
+        {
+            // The counter is process wide, so the budget is spread over many calls to average out unrelated allocations
+            return !enabled() || used() <= limit * calls;
+        }
+    };
+} // namespace saucer::tests::allocations
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "runner.hpp"
+#include "allocations.hpp"
 
 #include <boost/ut.hpp>
 #include <saucer/smartview.hpp>
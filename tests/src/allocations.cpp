@@ -0,0 +1,35 @@
+#include "allocations.hpp"
+
+#ifdef SAUCER_TESTS_ALLOCATIONS
+
+#include <new>
+#include <cstdlib>
+
+void *operator new(std::size_t size)
+{
+    saucer::tests::allocations::counter.fetch_add(1, std::memory_order_relaxed);
+    ++saucer::tests::allocations::local;
+
+    if (auto *rtn = std::malloc(size == 0 ? 1 : size); rtn)
+    {
+        return rtn;
+    }
+
+#ifdef __cpp_exceptions
+    throw std::bad_alloc{};
+#else
+    std::abort();
+#endif
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+#endif
@@ -0,0 +1,104 @@
+#include "test.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace boost::ut;
+using namespace saucer::tests;
+
+suite<"application"> application_suite = []
+{
+#if !defined(SAUCER_QT) && defined(SAUCER_TESTS_ALLOCATIONS)
+    "post/allocations"_test_async = [](saucer::window &window)
+    {
+        static constexpr auto warmup     = 100;
+        static constexpr auto iterations = 10'000;
+
+        auto roundtrip = [&](int i)
+        {
+            window.set_resizable(i % 2 == 0);
+            return window.resizable() == (i % 2 == 0);
+        };
+
+        for (auto i = 0; warmup > i; ++i)
+        {
+            roundtrip(i);
+        }
+
+        const auto before = allocations::count_local();
+        const auto start  = std::chrono::steady_clock::now();
+
+        auto matches = 0;
+
+        for (auto i = 0; iterations > i; ++i)
+        {
+            matches += roundtrip(i);
+        }
+
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        const auto count   = allocations::count_local() - before;
+
+        log << std::format("{} set/get roundtrips in {}, {} allocations", iterations,
+                           std::chrono::duration_cast<std::chrono::microseconds>(elapsed), count);
+
+        expect(eq(matches, iterations));
+        expect(eq(count, 0uz));
+    };
+#endif
+
+    "submit"_test_async = [](saucer::window &)
+    {
+        static constexpr auto count = 64uz;
+
+        std::atomic_size_t done{0};
+        std::atomic_bool off_thread{true};
+
+        for (auto i = 0uz; count > i; ++i)
+        {
+            g_application->submit(
+                [&]
+                {
+                    off_thread = off_thread && !g_application->thread_safe();
+                    ++done;
+                });
+        }
+
+        saucer::tests::wait_for([&] { return done == count; });
+
+        expect(eq(done.load(), count));
+        expect(off_thread);
+        expect(ge(g_application->concurrency(), 1uz));
+    };
+
+    "timers"_test_async = [](saucer::window &)
+    {
+        using namespace std::chrono_literals;
+
+        std::atomic_bool fired{false};
+        std::atomic_bool cancelled{false};
+        std::atomic_size_t ticks{0};
+
+        g_application->schedule(50ms, [&] { fired = g_application->thread_safe(); });
+        const auto never = g_application->schedule(50ms, [&] { cancelled = true; });
+        g_application->cancel(never);
+
+        // Repeating timers cancelling themselves from their own callback must not fire again
+        std::atomic_size_t id{0};
+        id = g_application->every(10ms,
+                                  [&]
+                                  {
+                                      if (++ticks == 3)
+                                      {
+                                          g_application->cancel(id);
+                                      }
+                                  });
+
+        saucer::tests::wait_for([&] { return fired && ticks >= 3; });
+        std::this_thread::sleep_for(100ms);
+
+        expect(fired);
+        expect(not cancelled);
+        expect(eq(ticks.load(), 3uz));
+    };
+};
@@ -0,0 +1,96 @@
+#include "test.hpp"
+
+#ifdef SAUCER_TESTS_BEVE
+
+#include <saucer/serializers/beve/beve.hpp>
+
+#include <map>
+#include <limits>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+using namespace boost::ut;
+using namespace saucer::tests;
+
+namespace
+{
+    using serializer = saucer::serializers::beve::serializer;
+    using smartview  = saucer::basic_smartview<serializer>;
+
+    // Arguments are written as BEVE and decoded by the page, the results come back as JSON
+    template <typename T>
+    bool roundtrip(smartview &webview, const T &value)
+    {
+        return webview.evaluate<T>("{}", value).get() == value;
+    }
+} // namespace
+
+suite<"beve"> beve_suite = []
+{
+    "numbers"_test_async = [](saucer::window &)
+    {
+        auto webview = smartview::create({.window = make<saucer::window>{}()}).value();
+        webview.set_url("https://codeberg.org/saucer/saucer");
+
+        expect(roundtrip(webview, std::numeric_limits<std::int8_t>::min()));
+        expect(roundtrip(webview, std::numeric_limits<std::uint8_t>::max()));
+        expect(roundtrip(webview, std::numeric_limits<std::int16_t>::min()));
+        expect(roundtrip(webview, std::numeric_limits<std::uint16_t>::max()));
+        expect(roundtrip(webview, std::numeric_limits<std::int32_t>::min()));
+        expect(roundtrip(webview, std::numeric_limits<std::uint32_t>::max()));
+
+        // Numbers in JavaScript are doubles, 64-bit integers only survive within their 53-bit mantissa
+        expect(roundtrip(webview, -(std::int64_t{1} << 53)));
+        expect(roundtrip(webview, std::uint64_t{1} << 53));
+
+        expect(roundtrip(webview, 0.5f));
+        expect(roundtrip(webview, -1234.5678));
+        expect(roundtrip(webview, std::vector<std::uint16_t>{0, 1, 65535}));
+        expect(roundtrip(webview, std::vector<double>{-0.25, 0, 1e300}));
+    };
+
+    "strings"_test_async = [](saucer::window &)
+    {
+        auto webview = smartview::create({.window = make<saucer::window>{}()}).value();
+        webview.set_url("https://codeberg.org/saucer/saucer");
+
+        expect(roundtrip(webview, std::string{}));
+        expect(roundtrip(webview, std::string{R"(quotes " and \ backslashes)"}));
+        expect(roundtrip(webview, std::string{"multi-byte: äöü ✓ 🍽"}));
+        expect(roundtrip(webview, std::string(300, 'x')));
+        expect(roundtrip(webview, std::vector<std::string>{"a", "", "c"}));
+    };
+
+    "nested"_test_async = [](saucer::window &)
+    {
+        auto webview = smartview::create({.window = make<saucer::window>{}()}).value();
+        webview.set_url("https://codeberg.org/saucer/saucer");
+
+        expect(roundtrip(webview, std::vector<bool>{true, false, true, true, false, false, true, false, true}));
+        expect(roundtrip(webview, std::vector<std::vector<int>>{{1, 2}, {}, {-3}}));
+        expect(roundtrip(webview, std::vector<std::vector<std::string>>{{"a"}, {"b", "c"}}));
+        expect(roundtrip(webview, std::map<std::string, std::vector<double>>{{"a", {1.5}}, {"b", {}}}));
+    };
+
+    "unsupported"_test_async = [](saucer::window &)
+    {
+        auto webview = smartview::create({.window = make<saucer::window>{}()}).value();
+        webview.set_url("https://codeberg.org/saucer/saucer");
+
+        // A signed 128-bit integer, which has no lossless JavaScript counterpart
+        auto payload = std::string{"\x89"};
+        payload.append(16, '\0');
+
+        std::string encoded;
+        saucer::serializers::beve::detail::encode(payload, encoded);
+
+        // The argument itself goes through the decoder first and hands the crafted payload over as a plain string
+        auto decoded = webview.evaluate<std::string>(
+            R"((() => {{ try {{ saucer.internal.beve({}); return "decoded"; }} catch {{ return "rejected"; }} }})())", encoded);
+
+        expect(decoded.get() == "rejected");
+    };
+};
+
+#endif
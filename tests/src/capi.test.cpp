@@ -0,0 +1,197 @@
+#include "test.hpp"
+#include "utils.hpp"
+
+#include <saucer/capi.h>
+
+#include <span>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <string_view>
+
+using namespace boost::ut;
+using namespace saucer::tests;
+
+namespace
+{
+    struct context
+    {
+        saucer_webview *handle;
+
+      public:
+        std::mutex mutex;
+        std::vector<std::string> messages;
+        std::vector<std::uint64_t> requests;
+
+      public:
+        [[nodiscard]] bool received(std::string_view expected)
+        {
+            std::lock_guard lock{mutex};
+            return std::ranges::find(messages, expected) != messages.end();
+        }
+    };
+
+    saucer_slice slice(std::string_view value)
+    {
+        return {.data = value.data(), .size = value.size()};
+    }
+} // namespace
+
+suite<"capi"> capi_suite = []
+{
+    static constexpr auto duration = std::chrono::seconds(10);
+
+    "batching"_test_async = [](saucer::webview &webview)
+    {
+        static constexpr std::string_view page = R"html(
+                <!DOCTYPE html>
+                <html>
+                    <head>
+                        <script>
+                            saucer.internal.send({ capi: true }).then(value => saucer.internal.message(`settled:${value}`));
+                        </script>
+                    </head>
+                </html>
+            )html";
+
+        auto state   = context{};
+        state.handle = saucer_webview_wrap(webview);
+
+        auto on_messages = [](void *user, const saucer_slice *messages, std::size_t count)
+        {
+            auto &state = *static_cast<context *>(user);
+            std::lock_guard lock{state.mutex};
+
+            for (const auto &message : std::span{messages, count})
+            {
+                state.messages.emplace_back(message.data, message.size);
+            }
+        };
+
+        auto on_requests = [](void *user, const saucer_scheme_request *requests, std::size_t count)
+        {
+            auto &state = *static_cast<context *>(user);
+            std::vector<saucer_scheme_response> responses;
+
+            for (const auto &request : std::span{requests, count})
+            {
+                responses.push_back({.id = request.id, .status = 200, .mime = slice("text/html"), .data = slice(page)});
+            }
+
+            saucer_scheme_respond(state.handle, responses.data(), responses.size());
+        };
+
+        saucer_webview_on_messages(state.handle, on_messages, &state);
+        saucer_webview_handle_scheme(state.handle, slice("test"), on_requests, &state);
+
+        webview.set_url(saucer::url::make({.scheme = "test", .host = "host", .path = "/capi.html"}));
+
+        std::uint64_t id{};
+
+        auto sent = [&]
+        {
+            std::lock_guard lock{state.mutex};
+
+            auto it = std::ranges::find_if(state.messages, [](const auto &message) { return message.contains(R"("capi":true)"); });
+
+            if (it == state.messages.end())
+            {
+                return false;
+            }
+
+            // The bridge appends the id of the pending promise to the payload
+            const auto start = it->find(R"("id":)");
+            id               = std::stoull(it->substr(start + 5));
+
+            return true;
+        };
+
+        expect(saucer::tests::wait_for(sent, duration));
+
+        const auto replies = std::array{saucer_reply{.id = id, .resolved = true, .value = slice("42")}};
+        saucer_webview_settle(state.handle, replies.data(), replies.size());
+
+        saucer::tests::wait_for([&] { return state.received("settled:42"); }, duration);
+        expect(state.received("settled:42"));
+
+        const auto scripts = std::array{slice(R"(saucer.internal.message("first"))"), slice(R"(saucer.internal.message("second"))")};
+        saucer_webview_execute(state.handle, scripts.data(), scripts.size());
+
+        saucer::tests::wait_for([&] { return state.received("first") && state.received("second"); }, duration);
+
+        expect(state.received("first"));
+        expect(state.received("second"));
+
+        saucer_webview_release(state.handle);
+    };
+
+    "release"_test_async = [](saucer::webview &webview)
+    {
+        static constexpr std::string_view page = R"html(
+                <!DOCTYPE html>
+                <html>
+                    <head>
+                        <script>
+                            fetch("test://host/pending")
+                                .then(response => response.ok ? "answered" : "failed", () => "failed")
+                                .then(result => saucer.internal.message(result));
+                        </script>
+                    </head>
+                </html>
+            )html";
+
+        auto state   = context{};
+        state.handle = saucer_webview_wrap(webview);
+
+        std::atomic_bool failed{false};
+
+        webview.on<saucer::webview::event::message>(
+            [&](auto value)
+            {
+                failed = value == "failed";
+                return saucer::status::unhandled;
+            });
+
+        // Only the page itself is answered, the fetch it issues is left pending until the handle goes away
+        auto on_requests = [](void *user, const saucer_scheme_request *requests, std::size_t count)
+        {
+            auto &state = *static_cast<context *>(user);
+            std::vector<saucer_scheme_response> responses;
+
+            for (const auto &request : std::span{requests, count})
+            {
+                if (std::string_view{request.url.data, request.url.size}.ends_with("/pending"))
+                {
+                    std::lock_guard lock{state.mutex};
+                    state.requests.emplace_back(request.id);
+
+                    continue;
+                }
+
+                responses.push_back({.id = request.id, .status = 200, .mime = slice("text/html"), .data = slice(page)});
+            }
+
+            saucer_scheme_respond(state.handle, responses.data(), responses.size());
+        };
+
+        saucer_webview_handle_scheme(state.handle, slice("test"), on_requests, &state);
+        webview.set_url(saucer::url::make({.scheme = "test", .host = "host", .path = "/release.html"}));
+
+        auto pending = [&]
+        {
+            std::lock_guard lock{state.mutex};
+            return !state.requests.empty();
+        };
+
+        expect(saucer::tests::wait_for(pending, duration));
+
+        saucer_webview_release(state.handle);
+
+        saucer::tests::wait_for([&] { return failed.load(); }, duration);
+        expect(failed.load());
+    };
+};
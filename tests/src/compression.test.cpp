@@ -0,0 +1,228 @@
+#include "test.hpp"
+#include "utils.hpp"
+
+#ifdef SAUCER_TESTS_COMPRESSION
+
+#include <atomic>
+#include <format>
+#include <random>
+#include <string>
+#include <optional>
+#include <algorithm>
+#include <string_view>
+
+#include <zlib.h>
+
+using namespace boost::ut;
+using namespace saucer::tests;
+
+namespace
+{
+    struct codec
+    {
+        std::atomic_size_t compressed{0};
+        std::atomic_size_t decompressed{0};
+
+      public:
+        saucer::ipc_compression options(std::size_t threshold)
+        {
+            auto compress = [this](std::string_view value)
+            {
+                compressed++;
+                return pack(value);
+            };
+
+            auto decompress = [this](std::string_view value)
+            {
+                decompressed++;
+                return unpack(value);
+            };
+
+            return {.compress = compress, .decompress = decompress, .threshold = threshold};
+        }
+
+      public:
+        static std::string pack(std::string_view value)
+        {
+            auto size = compressBound(static_cast<uLong>(value.size()));
+            auto rtn  = std::string(size, '\0');
+
+            compress2(reinterpret_cast<Bytef *>(rtn.data()), &size, reinterpret_cast<const Bytef *>(value.data()),
+                      static_cast<uLong>(value.size()), Z_BEST_SPEED);
+
+            rtn.resize(size);
+
+            return rtn;
+        }
+
+        static std::optional<std::string> unpack(std::string_view value)
+        {
+            z_stream stream{};
+
+            if (inflateInit(&stream) != Z_OK)
+            {
+                return std::nullopt;
+            }
+
+            stream.next_in  = reinterpret_cast<Bytef *>(const_cast<char *>(value.data()));
+            stream.avail_in = static_cast<uInt>(value.size());
+
+            std::string rtn;
+            char buffer[16 * 1024];
+
+            auto status = Z_OK;
+
+            while (status == Z_OK)
+            {
+                stream.next_out  = reinterpret_cast<Bytef *>(buffer);
+                stream.avail_out = sizeof(buffer);
+
+                status = inflate(&stream, Z_NO_FLUSH);
+                rtn.append(buffer, sizeof(buffer) - stream.avail_out);
+            }
+
+            inflateEnd(&stream);
+
+            if (status != Z_STREAM_END)
+            {
+                return std::nullopt;
+            }
+
+            return rtn;
+        }
+    };
+
+    // Printable characters except for quotes and backslashes, which leaves deflate nothing to gain once base64 is accounted for
+    std::string noise(std::size_t length)
+    {
+        static constexpr std::string_view alphabet =
+            "#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[]^_`abcdefghijklmnopqrstuvwxyz{|}~ !";
+
+        auto dist = std::uniform_int_distribution<std::size_t>{0, alphabet.size() - 1};
+        auto rtn  = std::string(length, ' ');
+
+        std::ranges::generate(rtn, [&] { return alphabet[dist(random_engine())]; });
+
+        return rtn;
+    }
+
+    // Counts the compressed replies the current document receives
+    bool count_inflates(saucer::smartview &webview)
+    {
+        return webview
+            .evaluate<bool>(R"((() => {{
+                const original           = saucer.internal.inflate;
+                saucer.internal.inflated = 0;
+                saucer.internal.inflate  = (...args) => (saucer.internal.inflated++, original(...args));
+                return true;
+            }})())")
+            .get()
+            .value_or(false);
+    }
+
+    std::size_t inflated(saucer::smartview &webview)
+    {
+        return webview.evaluate<std::size_t>("saucer.internal.inflated").get().value_or(0);
+    }
+} // namespace
+
+suite<"compression"> compression_suite = []
+{
+    static constexpr auto threshold = 1024uz;
+    static constexpr auto size      = 64uz * 1024;
+
+    "compression/outbound"_test_async = [](saucer::smartview &webview)
+    {
+        codec state;
+
+        webview.set_compression(state.options(threshold));
+        webview.set_url("https://codeberg.org/saucer/saucer");
+
+        webview.expose("large", [] { return std::string(size, 'x'); });
+        webview.expose("small", [] { return std::string(threshold / 2, 'x'); });
+
+        expect(count_inflates(webview));
+
+        expect(eq(webview.evaluate<std::size_t>("(await saucer.exposed.small()).length").get().value_or(0), threshold / 2));
+        expect(eq(inflated(webview), 0uz));
+
+        expect(eq(webview.evaluate<std::size_t>("(await saucer.exposed.large()).length").get().value_or(0), size));
+        expect(eq(inflated(webview), 1uz));
+        expect(state.compressed.load() >= 1uz);
+
+        webview.set_compression(std::nullopt);
+    };
+
+    "compression/inbound"_test_async = [](saucer::smartview &webview)
+    {
+        codec state;
+
+        webview.set_compression(state.options(threshold));
+        webview.set_url("https://codeberg.org/saucer/saucer");
+
+        webview.expose("length", [](const std::string &value) { return value.size(); });
+
+        expect(eq(webview.evaluate<std::size_t>("await saucer.exposed.length('y'.repeat({}))", size).get().value_or(0), size));
+        expect(state.decompressed.load() >= 1uz);
+
+        webview.set_compression(std::nullopt);
+    };
+
+    "compression/incompressible"_test_async = [](saucer::smartview &webview)
+    {
+        codec state;
+
+        webview.set_compression(state.options(threshold));
+        webview.set_url("https://codeberg.org/saucer/saucer");
+
+        static const auto payload = noise(size);
+        webview.expose("noise", [] { return payload; });
+
+        expect(count_inflates(webview));
+
+        // The codec is asked, but what it produces is larger than the payload, so the payload goes out as it is
+        expect(webview.evaluate<bool>("(await saucer.exposed.noise()) === {}", payload).get().value_or(false));
+        expect(state.compressed.load() >= 1uz);
+        expect(eq(inflated(webview), 0uz));
+
+        webview.set_compression(std::nullopt);
+    };
+
+    "compression/navigation"_test_async = [](saucer::smartview &webview)
+    {
+        codec state;
+
+        // The second document cannot inflate, replies to it must not stay compressed because the first one could
+        const auto id = webview.inject({
+            .code   = "if (location.search === '?plain') { window.CompressionStream = undefined; }",
+            .run_at = saucer::script::time::creation,
+        });
+
+        webview.set_compression(state.options(threshold));
+        webview.expose("large", [] { return std::string(size, 'x'); });
+
+        auto navigate = [&](std::string_view search)
+        {
+            webview.set_url(std::format("https://codeberg.org/saucer/saucer{}", search));
+            return saucer::tests::wait_for([&] { return webview.evaluate<std::string>("location.search").get() == search; },
+                                           std::chrono::seconds(10));
+        };
+
+        expect(navigate("?compressed"));
+        expect(count_inflates(webview));
+
+        expect(eq(webview.evaluate<std::size_t>("(await saucer.exposed.large()).length").get().value_or(0), size));
+        expect(eq(inflated(webview), 1uz));
+
+        expect(navigate("?plain"));
+        expect(count_inflates(webview));
+
+        expect(eq(webview.evaluate<std::size_t>("(await saucer.exposed.large()).length").get().value_or(0), size));
+        expect(eq(inflated(webview), 0uz));
+
+        webview.set_compression(std::nullopt);
+        webview.uninject(id);
+    };
+};
+
+#endif
@@ -0,0 +1,130 @@
+#include "test.hpp"
+
+#include <saucer/header_list.hpp>
+
+#include <format>
+#include <string>
+#include <utility>
+#include <string_view>
+
+using namespace boost::ut;
+using namespace saucer::tests;
+
+namespace
+{
+    using saucer::scheme::header_list;
+
+    // More entries than fit inline, so the list has to move them to the heap
+    header_list spilled(std::size_t count)
+    {
+        header_list rtn;
+
+        for (auto i = 0uz; count > i; i++)
+        {
+            rtn.emplace(std::format("X-Header-{}", i), std::format("value-{}", i));
+        }
+
+        return rtn;
+    }
+
+    bool complete(const header_list &list, std::size_t count)
+    {
+        if (list.size() != count)
+        {
+            return false;
+        }
+
+        for (auto i = 0uz; count > i; i++)
+        {
+            const auto it = list.find(std::format("x-header-{}", i));
+
+            if (it == list.end() || it->value != std::format("value-{}", i))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+} // namespace
+
+suite<"header_list"> header_list_suite = []
+{
+    "header_list/literals"_test_async = [](saucer::window &)
+    {
+        auto list = header_list{{"Content-Type", "text/html"}};
+        list.emplace("Vary", std::string{"Origin"});
+
+        expect(eq(list.size(), 2uz));
+        expect(not list.begin()->name.owned());
+        expect((list.begin() + 1)->value.owned());
+
+        expect(eq(std::string_view{list.find("vary")->value.c_str()}, std::string_view{"Origin"}));
+    };
+
+    "header_list/case"_test_async = [](saucer::window &)
+    {
+        header_list list;
+
+        expect(list.emplace("Content-Type", "text/html"));
+        expect(not list.emplace("content-type", "text/plain"));
+
+        expect(list.find("CONTENT-TYPE") != list.end());
+        expect(list.find("content-length") == list.end());
+
+        list.insert_or_assign("CONTENT-type", "application/json");
+
+        expect(eq(list.size(), 1uz));
+        expect(list.begin()->name == "Content-Type");
+        expect(list.begin()->value == "application/json");
+    };
+
+    "header_list/spill"_test_async = [](saucer::window &)
+    {
+        auto list = spilled(20);
+        expect(complete(list, 20));
+
+        // The first entry was inline before the list spilled, it has to be found (and replaced) after the move
+        list.insert_or_assign("x-header-0", "replaced");
+
+        expect(eq(list.size(), 20uz));
+        expect(list.find("X-HEADER-0")->value == "replaced");
+        expect(not list.emplace("x-header-19", "duplicate"));
+    };
+
+    "header_list/copy"_test_async = [](saucer::window &)
+    {
+        const auto original = spilled(12);
+
+        auto copy = original;
+        expect(complete(copy, 12));
+        expect(complete(original, 12));
+
+        copy.insert_or_assign("X-Header-3", "changed");
+        expect(original.find("X-Header-3")->value == "value-3");
+
+        header_list assigned;
+        assigned = original;
+
+        expect(complete(assigned, 12));
+    };
+
+    "header_list/move"_test_async = [](saucer::window &)
+    {
+        auto original = spilled(12);
+        auto moved    = std::move(original);
+
+        expect(complete(moved, 12));
+        expect(original.empty()); // NOLINT(*-use-after-move)
+
+        header_list assigned;
+        assigned = std::move(moved);
+
+        expect(complete(assigned, 12));
+        expect(moved.empty()); // NOLINT(*-use-after-move)
+
+        // Moved-from lists stay usable
+        moved.emplace("X-Reused", "yes");
+        expect(eq(moved.size(), 1uz));
+    };
+};
@@ -0,0 +1,152 @@
+#include "test.hpp"
+#include "utils.hpp"
+
+#include "instance.hpp"
+
+#include <mutex>
+#include <atomic>
+#include <format>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <string_view>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cstring>
+#include <unistd.h>
+#include <sys/un.h>
+#include <sys/socket.h>
+#endif
+
+using namespace boost::ut;
+using namespace saucer::tests;
+
+namespace
+{
+    std::string unique(std::string_view prefix)
+    {
+        static std::atomic_size_t counter{0};
+
+#ifdef _WIN32
+        const auto pid = static_cast<std::uint64_t>(GetCurrentProcessId());
+#else
+        const auto pid = static_cast<std::uint64_t>(getpid());
+#endif
+
+        return std::format("saucer-tests-{}-{:x}-{:x}", prefix, pid, counter++);
+    }
+
+    struct received
+    {
+        std::mutex mutex;
+        std::vector<std::vector<std::string>> launches;
+
+      public:
+        [[nodiscard]] std::size_t size()
+        {
+            std::lock_guard lock{mutex};
+            return launches.size();
+        }
+    };
+} // namespace
+
+suite<"instance"> instance_suite = []
+{
+    using saucer::utils::single_instance;
+
+    static constexpr auto duration = std::chrono::seconds(5);
+
+    "forward"_test_async = [](saucer::window &)
+    {
+        const auto id = unique("f");
+
+        received state;
+
+        auto instance = single_instance::listen(id,
+                                                [&](auto args)
+                                                {
+                                                    std::lock_guard lock{state.mutex};
+                                                    state.launches.emplace_back(std::move(args));
+                                                });
+
+        expect(instance != nullptr);
+
+        if (!instance)
+        {
+            return;
+        }
+
+        // The endpoint is taken, a second listener must neither succeed nor disturb the first one
+        expect(single_instance::listen(id, [](auto) {}) == nullptr);
+
+        expect(single_instance::forward(id, {"app", "--open", "file.txt"}));
+        expect(single_instance::forward(id, {}));
+
+        saucer::tests::wait_for([&] { return state.size() == 2; }, duration);
+
+        std::lock_guard lock{state.mutex};
+
+        expect(eq(state.launches.size(), 2uz));
+        expect(state.launches.size() == 2 && state.launches[0] == std::vector<std::string>{"app", "--open", "file.txt"});
+        expect(state.launches.size() == 2 && state.launches[1].empty());
+    };
+
+    "forward/none"_test_async = [](saucer::window &)
+    {
+        const auto id = unique("n");
+
+        expect(not single_instance::forward(id, {"app"}));
+
+        {
+            auto instance = single_instance::listen(id, [](auto) {});
+            expect(instance != nullptr);
+        }
+
+        // Once the instance is gone the endpoint is free again
+        expect(not single_instance::forward(id, {"app"}));
+        expect(single_instance::listen(id, [](auto) {}) != nullptr);
+    };
+
+#ifndef _WIN32
+    "stale"_test_async = [](saucer::window &)
+    {
+        const auto id       = unique("s");
+        const auto endpoint = single_instance::endpoint(id);
+
+        // Plays the part of an instance that crashed, its socket is left behind but nobody listens on it anymore
+        {
+            const auto fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+            sockaddr_un addr{};
+            addr.sun_family = AF_UNIX;
+
+            const auto used = std::min(endpoint.size(), sizeof(addr.sun_path) - 1);
+            std::memcpy(addr.sun_path, endpoint.data(), used);
+
+            const auto size = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + used);
+            expect(bind(fd, reinterpret_cast<const sockaddr *>(&addr), size) == 0);
+
+            close(fd);
+        }
+
+        received state;
+
+        auto instance = single_instance::listen(id,
+                                                [&](auto args)
+                                                {
+                                                    std::lock_guard lock{state.mutex};
+                                                    state.launches.emplace_back(std::move(args));
+                                                });
+
+        expect(instance != nullptr);
+        expect(single_instance::forward(id, {"reclaimed"}));
+
+        saucer::tests::wait_for([&] { return state.size() == 1; }, duration);
+        expect(eq(state.size(), 1uz));
+    };
+#endif
+};
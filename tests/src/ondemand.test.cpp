@@ -0,0 +1,145 @@
+#include "test.hpp"
+
+#ifdef SAUCER_TESTS_ONDEMAND
+
+#include <saucer/serializers/ondemand/ondemand.hpp>
+
+#include <map>
+#include <array>
+#include <tuple>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <variant>
+#include <optional>
+
+using namespace boost::ut;
+using namespace saucer::tests;
+
+namespace
+{
+    using serializer    = saucer::serializers::ondemand::serializer;
+    using document      = saucer::serializers::ondemand::document;
+    using function_data = saucer::serializers::ondemand::function_data;
+    using result_data   = saucer::serializers::ondemand::result_data;
+    using smartview     = saucer::basic_smartview<serializer>;
+
+    template <typename T>
+    const T *parsed(const serializer::parse_result &result)
+    {
+        using base = std::conditional_t<std::derived_from<T, saucer::function_data>, saucer::function_data, saucer::result_data>;
+
+        auto *rtn = std::get_if<std::unique_ptr<base>>(&result);
+        return rtn ? static_cast<const T *>(rtn->get()) : nullptr;
+    }
+} // namespace
+
+suite<"ondemand"> ondemand_suite = []
+{
+    "envelope"_test_async = [](saucer::window &)
+    {
+        const auto instance = serializer{};
+
+        auto call     = instance.parse(R"({"saucer:call":true,"id":3,"name":"add","params":[1,2]})");
+        const auto *f = parsed<function_data>(call);
+
+        expect(f != nullptr);
+        expect(f && f->id == 3 && std::get<std::string>(f->name) == "add");
+        expect(f && f->raw() == "[1,2]");
+        expect(f && serializer::read<std::tuple<int, int>>(*f) == std::tuple{1, 2});
+
+        auto indexed  = instance.parse(R"({"saucer:call":true,"id":4,"name":7,"params":[]})");
+        const auto *i = parsed<function_data>(indexed);
+
+        expect(i && std::get<std::size_t>(i->name) == 7);
+
+        auto resolve  = instance.parse(R"({"saucer:resolve":true,"id":5,"exception":true,"result":"boom"})");
+        const auto *r = parsed<result_data>(resolve);
+
+        expect(r && r->id == 5 && r->exception);
+        expect(r && serializer::read<std::string>(*r) == "boom");
+
+        // Messages without an id (or payload) could never be answered and are not ours
+        expect(std::holds_alternative<std::monostate>(instance.parse(R"({"saucer:call":true,"name":"add","params":[]})")));
+        expect(std::holds_alternative<std::monostate>(instance.parse(R"({"saucer:call":true,"id":1,"name":"add"})")));
+        expect(std::holds_alternative<std::monostate>(instance.parse(R"({"saucer:resolve":true,"exception":false,"result":1})")));
+        expect(std::holds_alternative<std::monostate>(instance.parse(R"({"saucer:call":true,"id":-1,"name":"add","params":[]})")));
+        expect(std::holds_alternative<std::monostate>(instance.parse(R"("dom_loaded")")));
+    };
+
+    "document"_test_async = [](saucer::window &)
+    {
+        const auto value = document{R"({"a":{"b":[1,2,3]},"c":"text","d":null})"};
+
+        expect(not value.empty());
+        expect(value.contains("/a/b/1"));
+        expect(not value.contains("/a/x"));
+
+        expect(value.at<std::vector<int>>("/a/b") == std::vector{1, 2, 3});
+        expect(value.at<int>("/a/b/2") == 3);
+        expect(value.at<std::string>("/c") == "text");
+        expect(value.at<std::optional<int>>("/d") == std::optional<int>{});
+
+        // Lookups may happen in any order, every one of them starts over
+        expect(value.at<std::string>("/c") == "text");
+        expect(not value.at<int>("/c").has_value());
+
+        auto nested = value.at<document>("/a");
+        expect(nested.has_value() && nested->raw() == R"({"b":[1,2,3]})");
+        expect(nested.has_value() && nested->at<int>("/b/0") == 1);
+
+        using map = std::map<std::string, document>;
+        auto all  = value.as<map>();
+
+        expect(all.has_value() && all->size() == 3uz);
+        expect(not document{}.as<int>().has_value());
+    };
+
+    "writers"_test_async = [](saucer::window &)
+    {
+        expect(eq(serializer::write(true), std::string{"true"}));
+        expect(eq(serializer::write(-42), std::string{"-42"}));
+        expect(eq(serializer::write(0.5), std::string{"0.5"}));
+        expect(eq(serializer::write(std::numeric_limits<double>::infinity()), std::string{"null"}));
+        expect(eq(serializer::write(std::string{"a\"b\\c\n\x01"}), std::string{R"("a\"b\\c\n\u0001")"}));
+        expect(eq(serializer::write(std::optional<int>{}), std::string{"null"}));
+        expect(eq(serializer::write(std::vector<bool>{true, false}), std::string{"[true,false]"}));
+        expect(eq(serializer::write(std::map<std::string, int>{{"a", 1}, {"b", 2}}), std::string{R"({"a":1,"b":2})"}));
+        expect(eq(serializer::write(std::tuple{1, "two", nullptr}), std::string{R"([1,"two",null])"}));
+        expect(eq(serializer::write(document{R"({"raw":true})"}), std::string{R"({"raw":true})"}));
+
+        expect(serializer::read<std::vector<bool>>("[true,false,true]") == std::vector<bool>{true, false, true});
+        expect(serializer::read<std::array<int, 2>>("[1,2]") == std::array{1, 2});
+        expect(not serializer::read<std::array<int, 2>>("[1,2,3]").has_value());
+        expect(not serializer::read<std::uint8_t>("256").has_value());
+        expect(not serializer::read<int>("1 2").has_value());
+    };
+
+    "page"_test_async = [](saucer::window &)
+    {
+        auto webview = smartview::create({.window = make<saucer::window>{}()}).value();
+        webview.set_url("https://codeberg.org/saucer/saucer");
+
+        webview.expose("flags", [](std::vector<bool> flags) { return flags.size(); });
+        webview.expose("sum", [](std::map<std::string, int> values) { return values["a"] + values["b"]; });
+        webview.expose("pick", [](const document &value) { return value.at<std::string>("/nested/name").value_or(""); });
+        webview.expose("echo", [](std::optional<std::string> value) { return std::tuple{value.has_value(), value.value_or("")}; });
+
+        expect(eq(webview.evaluate<std::size_t>("await saucer.exposed.flags({})", std::vector<bool>{true, false, true}).get().value_or(0),
+                  3uz));
+        expect(eq(webview.evaluate<int>("await saucer.exposed.sum({{ a: 1, b: 2 }})").get().value_or(0), 3));
+        expect(webview.evaluate<std::string>(R"(await saucer.exposed.pick({{ nested: {{ name: "saucer" }} }}))").get() == "saucer");
+
+        using echoed = std::tuple<bool, std::string>;
+
+        expect(webview.evaluate<echoed>("await saucer.exposed.echo({})", std::string{"value"}).get() == echoed{true, "value"});
+        expect(webview.evaluate<echoed>("await saucer.exposed.echo(null)").get() == echoed{false, ""});
+
+        auto mismatch = webview.evaluate<int>("await saucer.exposed.sum(1).then(() => 0, () => 1)").get();
+        expect(eq(mismatch.value_or(0), 1));
+    };
+};
+
+#endif
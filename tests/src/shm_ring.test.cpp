@@ -0,0 +1,199 @@
+#include "test.hpp"
+
+#include "shm_ring.hpp"
+
+#include <format>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <semaphore.h>
+#endif
+
+using namespace boost::ut;
+using namespace saucer::tests;
+
+namespace
+{
+    // Mirrors the layout at the start of the mapping, the tests play the part of a misbehaving peer
+    struct layout
+    {
+        std::atomic<std::uint64_t> head;
+        std::atomic<std::uint64_t> tail;
+        std::atomic<std::uint32_t> closed;
+
+      public:
+        std::uint64_t capacity;
+    };
+
+    std::string unique(std::string_view prefix)
+    {
+        static std::atomic_size_t counter{0};
+
+#ifdef _WIN32
+        const auto pid = static_cast<std::uint64_t>(GetCurrentProcessId());
+#else
+        const auto pid = static_cast<std::uint64_t>(getpid());
+#endif
+
+        return std::format("st{}{:x}-{:x}", prefix, pid, counter++);
+    }
+
+    // Hands out a frame that claims to be longer than what was actually written
+    void forge(const std::string &name, std::size_t capacity, std::uint32_t length)
+    {
+#ifdef _WIN32
+        const auto wide = std::wstring{L"Local\\"} + std::wstring{name.begin(), name.end()};
+        auto *mapping   = OpenFileMappingW(FILE_MAP_ALL_ACCESS, false, wide.c_str());
+        auto *mapped    = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+#else
+        const auto fd = shm_open(("/" + name).c_str(), O_RDWR, 0600);
+        auto *mapped  = mmap(nullptr, sizeof(layout) + capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+#endif
+
+        auto *shared    = static_cast<layout *>(mapped);
+        const auto head = shared->head.load();
+
+        std::memcpy(reinterpret_cast<std::uint8_t *>(shared) + sizeof(layout) + (head % capacity), &length, sizeof(length));
+        shared->head.store(head + sizeof(length));
+
+#ifdef _WIN32
+        UnmapViewOfFile(mapped);
+        CloseHandle(mapping);
+#else
+        munmap(mapped, sizeof(layout) + capacity);
+        close(fd);
+#endif
+    }
+} // namespace
+
+suite<"shm_ring"> shm_ring_suite = []
+{
+    "roundtrip"_test_async = [](saucer::window &)
+    {
+        const auto name = unique("r");
+
+        auto producer = saucer::utils::shm_ring::create(name, 64);
+        auto consumer = saucer::utils::shm_ring::open(name);
+
+        expect(producer != nullptr);
+        expect(consumer != nullptr);
+
+        if (!producer || !consumer)
+        {
+            return;
+        }
+
+        // Enough messages to wrap around a few times, including frames that straddle the end of the buffer
+        static constexpr auto count = 100;
+
+        std::atomic_size_t matched{0};
+
+        auto read = [&]
+        {
+            for (auto i = 0; count > i; ++i)
+            {
+                matched += consumer->pop() == std::format("message-{}", i);
+            }
+        };
+
+        std::thread reader{read};
+        auto pushed = 0;
+
+        for (auto i = 0; count > i; ++i)
+        {
+            pushed += producer->push(std::format("message-{}", i), std::chrono::seconds{5});
+        }
+
+        reader.join();
+
+        expect(eq(pushed, count));
+        expect(eq(matched.load(), static_cast<std::size_t>(count)));
+
+        expect(not producer->push(std::string(64, 'x')));
+
+        producer->close();
+        expect(not consumer->pop().has_value());
+        expect(not producer->push("closed"));
+    };
+
+    "full"_test_async = [](saucer::window &)
+    {
+        const auto name = unique("f");
+        auto producer   = saucer::utils::shm_ring::create(name, 32);
+
+        expect(producer != nullptr);
+
+        if (!producer)
+        {
+            return;
+        }
+
+        expect(producer->push(std::string(24, 'x')));
+
+        // Nobody consumes, the push has to give up instead of waiting forever
+        const auto start = std::chrono::steady_clock::now();
+
+        expect(not producer->push(std::string(8, 'x'), std::chrono::milliseconds{50}));
+        expect(std::chrono::steady_clock::now() - start < std::chrono::seconds{5});
+    };
+
+    "corrupt"_test_async = [](saucer::window &)
+    {
+        const auto name = unique("c");
+
+        auto producer = saucer::utils::shm_ring::create(name, 64);
+        auto consumer = saucer::utils::shm_ring::open(name);
+
+        expect(producer != nullptr);
+        expect(consumer != nullptr);
+
+        if (!producer || !consumer)
+        {
+            return;
+        }
+
+        expect(producer->push("valid"));
+        expect(consumer->pop() == std::optional<std::string>{"valid"});
+
+        forge(name, 64, 1024);
+
+        expect(not consumer->pop().has_value());
+        expect(not producer->push("after"));
+    };
+
+#ifndef _WIN32
+    "taken"_test_async = [](saucer::window &)
+    {
+        const auto name      = unique("t");
+        const auto semaphore = "/" + name + "s";
+
+        // Somebody else already holds the semaphore, creating the ring fails half-way and must not take it down with it
+        auto *foreign = sem_open(semaphore.c_str(), O_CREAT | O_EXCL, 0600, 0);
+        expect(foreign != SEM_FAILED);
+
+        expect(saucer::utils::shm_ring::create(name, 64) == nullptr);
+
+        auto *reopened = sem_open(semaphore.c_str(), 0);
+        expect(reopened != SEM_FAILED);
+
+        // What the failed attempt did create itself is cleaned up again
+        expect(shm_open(("/" + name).c_str(), O_RDWR, 0600) < 0);
+
+        sem_close(reopened);
+        sem_close(foreign);
+        sem_unlink(semaphore.c_str());
+    };
+#endif
+};
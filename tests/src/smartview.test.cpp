@@ -1,6 +1,14 @@
 #include "test.hpp"
 #include "utils.hpp"
 
+#include <saucer/replay.hpp>
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
 using namespace boost::ut;
 using namespace saucer::tests;
 
@@ -47,9 +55,9 @@ suite<"smartview"> smartview_suite = []
         expect(webview.evaluate<std::string>("await saucer.exposed.test3({}).then(() => {{}}, err => err)", -10).get() == "negative");
 
         webview.expose("test4",
-                       [](int value, const saucer::executor<int, std::string> &exec)
+                       [](int value, saucer::executor<int, std::string> exec)
                        {
-                           std::thread thread{[=]
+                           std::thread thread{[value, exec = std::move(exec)]
                                               {
                                                   const auto &[resolve, reject] = exec;
 
@@ -84,4 +92,556 @@ suite<"smartview"> smartview_suite = []
         expect(webview.evaluate<std::string>("await saucer.exposed.test5().then(() => {{}}, err => err)").get() == "Oh no!");
 #endif
     };
+
+    "expose/buffers"_test_async = [](saucer::smartview &webview)
+    {
+        webview.set_url("https://codeberg.org/saucer/saucer");
+
+        webview.expose("sum",
+                       [](const saucer::stash &data, int offset)
+                       {
+                           auto rtn = offset;
+
+                           for (const auto *it = data.data(); it != data.data() + data.size(); ++it)
+                           {
+                               rtn += *it;
+                           }
+
+                           return rtn;
+                       });
+
+        expect(eq(webview.evaluate<int>("await saucer.exposed.sum(new Uint8Array([1, 2, 3]), 4)").get().value_or(0), 10));
+        expect(eq(webview.evaluate<int>("await saucer.exposed.sum(new Uint8Array(0), 1)").get().value_or(0), 1));
+
+        auto mismatch = webview.evaluate<std::string>("await saucer.exposed.sum(1, 4).then(() => {{}}, err => err)").get();
+        expect(mismatch.has_value() && mismatch->contains("binary"));
+
+        webview.expose("average",
+                       [](std::span<const float> samples)
+                       {
+                           auto rtn = 0.f;
+
+                           for (const auto sample : samples)
+                           {
+                               rtn += sample;
+                           }
+
+                           return samples.empty() ? 0.f : rtn / static_cast<float>(samples.size());
+                       });
+
+        expect(eq(webview.evaluate<float>("await saucer.exposed.average(new Float32Array([1, 2, 3]))").get().value_or(0), 2.f));
+
+        auto unaligned =
+            webview.evaluate<std::string>("await saucer.exposed.average(new Uint8Array(3)).then(() => {{}}, err => err)").get();
+        expect(unaligned.has_value() && unaligned->contains("typed array"));
+
+        static constexpr auto forged = R"js(
+            fetch("saucer://message/", {{ method: "POST", body: "\0\0{{}}\0" }}).then(response => response.ok, () => false)
+        )js";
+
+        expect(webview.evaluate<bool>(forged).get() == false);
+    };
+
+    "expose/channel"_test_async = [](saucer::smartview &webview)
+    {
+        webview.set_url("https://codeberg.org/saucer/saucer");
+
+        webview.expose("count",
+                       [](int limit, saucer::channel<int> channel)
+                       {
+                           for (auto i = 0; limit > i; i++)
+                           {
+                               std::ignore = channel.push(i);
+                           }
+
+                           channel.close();
+                       });
+
+        webview.expose("broken",
+                       [](saucer::channel<int> channel)
+                       {
+                           std::ignore = channel.push(1);
+                           channel.reject("Oh no!");
+                       });
+
+        static constexpr auto collect = R"js(
+            (async () => {{
+                const rtn = [];
+
+                try
+                {{
+                    for await (const value of await {})
+                    {{
+                        rtn.push(value);
+                    }}
+                }} catch (e)
+                {{
+                    rtn.push(e);
+                }}
+
+                return JSON.stringify(rtn);
+            }})()
+        )js";
+
+        expect(webview.evaluate<std::string>(collect, saucer::unquoted("saucer.exposed.count(3)")).get() == "[0,1,2]");
+        expect(webview.evaluate<std::string>(collect, saucer::unquoted("saucer.exposed.broken()")).get() == R"([1,"Oh no!"])");
+    };
+
+    "evaluate/cached"_test_async = [](saucer::smartview &webview)
+    {
+        webview.set_url("https://codeberg.org/saucer/saucer");
+
+        auto config = saucer::cached<std::vector<int>>{{1, 2, 3}};
+
+        expect(eq(webview.evaluate<std::size_t>("{}.length", config).get().value_or(0), 3uz));
+        expect(eq(webview.evaluate<std::size_t>("{}.length", config).get().value_or(0), 3uz));
+
+        config.modify([](auto &value) { value.emplace_back(4); });
+
+        expect(eq(config.version(), 1uz));
+        expect(eq(webview.evaluate<std::size_t>("{}.length", config).get().value_or(0), 4uz));
+    };
+
+    "expose/batch"_test_async = [](saucer::smartview &webview)
+    {
+        webview.set_url("https://codeberg.org/saucer/saucer");
+
+        std::atomic_size_t calls{0};
+
+        webview.expose("square",
+                       [&calls](int value)
+                       {
+                           calls++;
+                           return value * value;
+                       });
+
+        static constexpr auto code = R"js(
+            Promise.all(saucer.batch(() => [1, 2, 3, 4].map(value => saucer.exposed.square(value)))).then(JSON.stringify)
+        )js";
+
+        expect(webview.evaluate<std::string>(code).get() == "[1,4,9,16]");
+        expect(calls.load() == 4);
+    };
+
+    "emit"_test_async = [](saucer::smartview &webview)
+    {
+        webview.set_url("https://codeberg.org/saucer/saucer");
+
+        expect(not webview.subscribed("ping"));
+        std::ignore = webview.evaluate<int>("(window.pings = [], saucer.subscribe('ping', value => window.pings.push(value)), 0)").get();
+        expect(webview.subscribed("ping"));
+
+        webview.emit("ping", 1);
+        webview.emit("pong", 2);
+        webview.emit("ping", 3);
+
+        auto received = [&webview]
+        {
+            return webview.evaluate<std::string>("JSON.stringify(window.pings)").get() == "[1,3]";
+        };
+
+        expect(saucer::tests::wait_for(received));
+    };
+
+    "state"_test_async = [](saucer::smartview &webview)
+    {
+        webview.set_state(42);
+        webview.set_url("https://codeberg.org/saucer/saucer");
+
+        expect(eq(webview.evaluate<int>("saucer.state").get().value_or(0), 42));
+
+        webview.set_state(1337);
+        expect(eq(webview.evaluate<int>("saucer.state").get().value_or(0), 1337));
+
+        webview.clear_state();
+        expect(webview.evaluate<bool>("saucer.state === undefined").get().value_or(false));
+    };
+
+    "expose/launch"_test_async = [](saucer::smartview &webview)
+    {
+        webview.set_url("https://codeberg.org/saucer/saucer");
+
+        auto thread_safe = []
+        {
+            return g_application->thread_safe();
+        };
+
+        webview.expose("sync", thread_safe);
+        webview.expose("pool", thread_safe, saucer::launch::pool);
+        webview.expose("strand", thread_safe, saucer::launch::strand);
+
+        expect(webview.evaluate<bool>("await saucer.exposed.sync()").get().value_or(false));
+        expect(not webview.evaluate<bool>("await saucer.exposed.pool()").get().value_or(true));
+        expect(not webview.evaluate<bool>("await saucer.exposed.strand()").get().value_or(true));
+
+        webview.expose(
+            "schedule",
+            [](saucer::executor<bool> exec) -> coco::task<void>
+            {
+                const auto before = g_application->thread_safe();
+                co_await g_application->schedule();
+
+                exec.resolve(!before && g_application->thread_safe());
+            },
+            saucer::launch::pool);
+
+        expect(webview.evaluate<bool>("await saucer.exposed.schedule()").get().value_or(false));
+    };
+
+    "evaluate/limits"_test_async = [](saucer::smartview &webview)
+    {
+        webview.set_url("https://codeberg.org/saucer/saucer");
+
+        webview.set_evaluation_timeout(std::chrono::milliseconds(500));
+        expect(not webview.evaluate<int>("new Promise(() => {{}})").get().has_value());
+        expect(webview.pending_evaluations() == 0);
+
+        webview.set_evaluation_timeout(std::nullopt);
+        webview.set_evaluation_limit(0);
+        expect(not webview.evaluate<int>("10 + 5").get().has_value());
+
+        webview.set_evaluation_limit(std::nullopt);
+        expect(webview.evaluate<int>("10 + 5").get() == 15);
+    };
+
+    "expose/slots"_test_async = [](saucer::smartview &webview)
+    {
+        std::atomic_size_t handled{0};
+
+        webview.set_url("https://codeberg.org/saucer/saucer");
+        webview.expose("identity",
+                       [&](int value)
+                       {
+                           handled++;
+                           return value;
+                       });
+
+        // Every call of a round is pending at once, each round has to start from and leave behind an empty table
+        static constexpr auto rounds = R"js(await (async () =>
+        {{
+            const calls  = 2000;
+            const rounds = 5;
+
+            let peak  = 0;
+            let stale = 0;
+
+            for (let round = 0; round < rounds; round++)
+            {{
+                stale += saucer.internal.rpc.size;
+
+                const pending = Array.from({{ length: calls }}, (_, i) => saucer.exposed.identity(i));
+                peak          = Math.max(peak, saucer.internal.rpc.size);
+
+                await Promise.all(pending);
+            }}
+
+            return [saucer.internal.rpc.size, stale, peak];
+        }})())js";
+
+        auto res = webview.evaluate<std::tuple<int, int, int>>(rounds).get();
+
+        expect(res.has_value());
+        expect(res.has_value() && std::get<0>(*res) == 0);
+        expect(res.has_value() && std::get<1>(*res) == 0);
+        expect(res.has_value() && std::get<2>(*res) == 2000);
+        expect(eq(handled.load(), 10000uz));
+    };
+
+    "metrics"_test_async = [](saucer::smartview &webview)
+    {
+        webview.set_url("https://codeberg.org/saucer/saucer");
+        webview.expose("metrics", [](int value) { return value; });
+
+        const auto before = webview.parent().parent().metrics();
+        expect(eq(webview.evaluate<int>("await saucer.exposed.metrics({})", 5).get().value_or(0), 5));
+        const auto after = webview.parent().parent().metrics();
+
+        expect(after.exposed_calls > before.exposed_calls);
+        expect(after.call_latency.count > before.call_latency.count);
+        expect(after.scheme_requests >= before.scheme_requests);
+    };
+
+    "record/replay"_test_async = [](saucer::smartview &webview)
+    {
+        webview.set_url("https://codeberg.org/saucer/saucer");
+        webview.expose("double", [](int value) { return value * 2; });
+
+        std::mutex mutex;
+        std::vector<saucer::ipc_record> records;
+
+        webview.set_ipc_recorder(
+            [&](const saucer::ipc_record &record)
+            {
+                std::lock_guard lock{mutex};
+                records.emplace_back(record);
+            });
+
+        expect(eq(webview.evaluate<int>("(await saucer.exposed.double(1)) + (await saucer.exposed.double(2))").get().value_or(0), 6));
+        webview.set_ipc_recorder({});
+
+        auto harness = saucer::replay{};
+        harness.expose("double", [](int value) { return value * 2; });
+
+        std::lock_guard lock{mutex};
+        const auto stats = harness.run(records);
+
+        expect(eq(stats.calls, 2uz));
+        expect(eq(stats.resolved, 2uz));
+        expect(eq(stats.rejected, 0uz));
+    };
+
+    "fallback"_test_async = [](saucer::smartview &webview)
+    {
+        webview.set_url("https://codeberg.org/saucer/saucer");
+        webview.expose("local", [] { return 1; });
+
+        std::atomic_size_t forwarded{0};
+
+        webview.set_ipc_fallback(
+            [&](std::string_view, saucer::serializer_core::executor executor)
+            {
+                forwarded++;
+                executor.resolve("41");
+            });
+
+        expect(eq(webview.evaluate<int>("(await saucer.exposed.local()) + (await saucer.exposed.remote())").get().value_or(0), 42));
+        expect(eq(forwarded.load(), 1uz));
+
+        static constexpr auto batched = "(await Promise.all(saucer.batch(() => [saucer.exposed.remote(), saucer.exposed.remote()]))).join()";
+        expect(webview.evaluate<std::string>(batched).get() == "41,41");
+        expect(eq(forwarded.load(), 3uz));
+
+        // Buffers cannot travel along with the forwarded message, the call has to fail instead of hanging
+        auto attached = webview.evaluate<std::string>("await saucer.exposed.remote(new Uint8Array([1])).then(() => '', err => err)").get();
+        expect(attached.has_value() && attached->contains("attachments"));
+        expect(eq(forwarded.load(), 3uz));
+
+        webview.set_ipc_fallback({});
+        expect(not webview.evaluate<int>("await saucer.exposed.remote()").get().has_value());
+    };
+
+    "prepare"_test_async = [](saucer::smartview &webview)
+    {
+        webview.set_url("https://codeberg.org/saucer/saucer");
+
+        const auto add = webview.prepare("(a, b) => a + b");
+
+        expect(eq(webview.invoke<int>(add, 1, 2).get().value_or(0), 3));
+        expect(webview.invoke<std::string>(add, "C++", "23").get() == "C++23");
+
+        webview.reload();
+        expect(eq(webview.invoke<int>(add, 20, 22).get().value_or(0), 42));
+
+        webview.unprepare(add);
+
+        auto missing = webview.invoke<int>(add, 1, 2).get();
+        expect(not missing.has_value());
+    };
+
+    "abort"_test_async = [](saucer::smartview &webview)
+    {
+        static constexpr auto code = R"js(
+            (async () =>
+            {{
+                const controller = new AbortController();
+                const pending    = saucer.call("hang", [], {{ signal: controller.signal }});
+
+                await saucer.exposed.ready();
+                controller.abort("aborted");
+
+                return await pending.catch(reason => reason);
+            }})()
+        )js";
+
+        std::optional<saucer::executor<int>> hanging;
+
+        webview.set_url("https://codeberg.org/saucer/saucer");
+        webview.expose("ready", [] {});
+        webview.expose("hang", [&hanging](saucer::executor<int> exec) { hanging.emplace(std::move(exec)); });
+
+        expect(webview.evaluate<std::string>(code).get() == "aborted");
+        saucer::tests::wait_for([&] { return hanging.has_value() && hanging->cancelled(); });
+
+        expect(hanging.has_value() && hanging->cancelled());
+    };
+
+    "expose/memoize"_test_async = [](saucer::smartview &webview)
+    {
+        std::atomic_size_t calls{0};
+
+        webview.set_url("https://codeberg.org/saucer/saucer");
+        auto square = [&calls](int value)
+        {
+            calls++;
+            return value * value;
+        };
+
+        webview.expose("square", square, saucer::memoize{.capacity = 2});
+
+        expect(eq(webview.evaluate<int>("await saucer.exposed.square(3)").get().value_or(0), 9));
+        expect(eq(webview.evaluate<int>("await saucer.exposed.square(3)").get().value_or(0), 9));
+        expect(eq(calls.load(), 1uz));
+
+        expect(eq(webview.evaluate<int>("await saucer.exposed.square(4)").get().value_or(0), 16));
+        expect(eq(webview.evaluate<int>("await saucer.exposed.square(5)").get().value_or(0), 25));
+        expect(eq(webview.evaluate<int>("await saucer.exposed.square(3)").get().value_or(0), 9));
+        expect(eq(calls.load(), 4uz));
+    };
+
+    "expose/priority"_test_async = [](saucer::smartview &webview)
+    {
+        webview.set_url("https://codeberg.org/saucer/saucer");
+
+        webview.expose("bulk", [](int value) { return value; }, saucer::launch::sync, saucer::priority::background);
+        webview.expose("click", [](int value) { return value; }, saucer::launch::pool, saucer::priority::interactive);
+
+        static constexpr auto code = R"js(
+            (async () =>
+            {{
+                const order = [];
+
+                const bulk  = saucer.call("bulk", [1], {{ priority: "background" }}).then(() => order.push("bulk"));
+                const click = saucer.call("click", [2], {{ priority: "interactive" }}).then(() => order.push("click"));
+
+                await Promise.all([bulk, click]);
+                return order.join(",");
+            }})()
+        )js";
+
+        expect(webview.evaluate<std::string>(code).get() == "click,bulk");
+    };
+
+    "expose/limit"_test_async = [](saucer::smartview &webview)
+    {
+        std::atomic_size_t calls{0};
+
+        auto count = [&calls](int value)
+        {
+            calls++;
+            return value;
+        };
+
+        webview.set_url("https://codeberg.org/saucer/saucer");
+
+        webview.expose("debounced", count, saucer::rate_limit{.mode = saucer::limit::debounce, .interval = std::chrono::milliseconds(50)});
+        webview.expose("coalesced", count, saucer::rate_limit{.mode = saucer::limit::coalesce});
+
+        static constexpr auto debounced = "(await Promise.all([1, 2, 3].map(value => saucer.exposed.debounced(value)))).join()";
+        expect(webview.evaluate<std::string>(debounced).get() == "3,3,3");
+        expect(eq(calls.load(), 1uz));
+
+        static constexpr auto coalesced = "(await Promise.all([1, 1, 2].map(value => saucer.exposed.coalesced(value)))).join()";
+        expect(webview.evaluate<std::string>(coalesced).get() == "1,1,2");
+        expect(eq(calls.load(), 3uz));
+    };
+
+    "expose/concurrency"_test_async = [](saucer::smartview &webview)
+    {
+        std::atomic_size_t active{0};
+        std::atomic_size_t peak{0};
+
+        auto work = [&active, &peak](int value)
+        {
+            const auto current = ++active;
+            peak.store(std::max(peak.load(), current));
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            active--;
+
+            return value;
+        };
+
+        webview.set_url("https://codeberg.org/saucer/saucer");
+        webview.expose("work", work, saucer::concurrency{.limit = 2});
+
+        static constexpr auto code = "(await Promise.all([1, 2, 3, 4, 5, 6].map(value => saucer.exposed.work(value)))).join()";
+
+        expect(webview.evaluate<std::string>(code).get() == "1,2,3,4,5,6");
+        expect(peak.load() <= 2uz);
+    };
+
+    "expose/worker"_test_async = [](saucer::smartview &webview)
+    {
+        webview.set_url("https://codeberg.org/saucer/saucer");
+        webview.expose("add", [](int a, int b) { return a + b; }, saucer::launch::pool);
+
+        static constexpr auto code = R"js(
+            (async () =>
+            {{
+                const source = "saucer.exposed.add(1, 2).then(value => postMessage(value))";
+                const worker = new saucer.Worker(URL.createObjectURL(new Blob([source])));
+
+                return new Promise(resolve => worker.onmessage = ({{ data }}) => resolve(data));
+            }})()
+        )js";
+
+        expect(eq(webview.evaluate<int>(code).get().value_or(0), 3));
+    };
+
+    "expose/chunked"_test_async = [](saucer::smartview &webview)
+    {
+        webview.set_url("https://codeberg.org/saucer/saucer");
+        webview.expose("huge", [](std::size_t size) { return std::string(size, '\n') + "\"ä\\"; });
+
+        static constexpr auto code = R"js(
+            (async () =>
+            {{
+                const value = await saucer.exposed.huge({});
+                return value.length === {} + 3 && value.endsWith('"ä\\');
+            }})()
+        )js";
+
+        const auto size = 3uz * 1024 * 1024;
+        expect(webview.evaluate<bool>(code, size, size).get().value_or(false));
+    };
+
+    "broadcast"_test_async = [](saucer::smartview &webview)
+    {
+        webview.set_url("https://codeberg.org/saucer/saucer");
+        expect(eq(webview.evaluate<int>("1").get().value_or(0), 1));
+
+        const auto webviews = std::array{&webview};
+        saucer::smartview::broadcast(webviews, "window.broadcasted = {}", std::vector<int>{1, 2});
+
+        expect(webview.evaluate<std::vector<int>>("window.broadcasted").get() == std::vector<int>{1, 2});
+    };
+
+    "allocations/call"_test_async = [](saucer::smartview &webview)
+    {
+        static constexpr auto calls = 200;
+
+        webview.set_url("https://codeberg.org/saucer/saucer");
+        webview.expose("noop", [](int value) { return value; });
+
+        expect(eq(webview.evaluate<int>("await saucer.exposed.noop({})", 1).get().value_or(0), 1));
+
+        static constexpr auto code = "(async () => {{ for (let i = 0; i < {}; i++) await saucer.exposed.noop(i); return 1; }})()";
+
+        const auto budget = allocations::budget{.limit = 64, .calls = calls};
+        const auto result = webview.evaluate<int>(code, calls);
+
+        expect(eq(result.get().value_or(0), 1));
+        expect(budget.kept()) << budget.used();
+    };
+
+    "patch"_test_async = [](saucer::smartview &webview)
+    {
+        bool ready{false};
+        webview.on<saucer::webview::event::dom_ready>([&] { ready = true; });
+
+        webview.set_html("<!DOCTYPE html><html><body><ul id='list'><li>a</li><li>b</li></ul></body></html>");
+        saucer::tests::wait_for([&] { return ready; });
+
+        webview.patch(saucer::dom_patch{"list"}.insert(0, "<li>c</li>").text(2, "d").remove(1).attribute(0, "class", "first"));
+
+        auto list = [&]
+        {
+            return webview.evaluate<std::string>("[...document.querySelectorAll('#list li')].map(li => li.textContent).join()").get();
+        };
+
+        saucer::tests::wait_for([&] { return list().value_or("") == "c,d"; });
+
+        expect(eq(list().value_or(""), std::string{"c,d"}));
+        expect(eq(webview.evaluate<std::string>("document.querySelector('#list li').className").get().value_or(""), std::string{"first"}));
+    };
 };
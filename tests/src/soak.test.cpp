@@ -0,0 +1,211 @@
+#include "test.hpp"
+#include "utils.hpp"
+
+#ifdef SAUCER_TESTS_SOAK
+
+#include <vector>
+#include <cstdlib>
+#include <fstream>
+#include <algorithm>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace boost::ut;
+using namespace saucer::tests;
+
+namespace
+{
+    constexpr auto batch     = 10'000uz;
+    constexpr auto duration  = std::chrono::seconds(10);
+    constexpr auto threshold = 64uz * 1024 * 1024;
+
+    std::size_t iterations()
+    {
+        const auto *value = std::getenv("SAUCER_SOAK_ITERATIONS");
+
+        if (!value)
+        {
+            return 1'000'000;
+        }
+
+        return std::max(std::strtoull(value, nullptr, 10), static_cast<unsigned long long>(batch));
+    }
+
+    std::size_t resident()
+    {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters{};
+
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        {
+            return 0;
+        }
+
+        return counters.WorkingSetSize;
+#elif defined(__APPLE__)
+        mach_task_basic_info info{};
+        mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+
+        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+        {
+            return 0;
+        }
+
+        return info.resident_size;
+#else
+        std::size_t size{}, pages{};
+
+        if (!(std::ifstream{"/proc/self/statm"} >> size >> pages))
+        {
+            return 0;
+        }
+
+        return pages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+    }
+
+    // Only Chromium based backends report their heap, the others yield zero and skip the check
+    std::size_t heap_size(saucer::smartview &webview)
+    {
+        return webview.evaluate<std::size_t>("performance.memory?.usedJSHeapSize ?? 0").get().value_or(0);
+    }
+
+    struct growth
+    {
+        std::size_t native;
+        std::size_t heap;
+
+      public:
+        growth(saucer::smartview &webview) : native(resident()), heap(heap_size(webview)) {}
+
+      public:
+        [[nodiscard]] bool kept(saucer::smartview &webview) const
+        {
+            const auto native_now = resident();
+            const auto heap_now   = heap_size(webview);
+
+            const auto native_ok = native_now <= native || native_now - native <= threshold;
+            const auto heap_ok   = heap_now <= heap || heap_now - heap <= threshold;
+
+            return native_ok && heap_ok;
+        }
+    };
+
+    template <typename Callback>
+    void soak(saucer::smartview &webview, Callback &&callback)
+    {
+        const auto total = iterations();
+
+        // The first batch warms up caches and pools, only growth past that point counts
+        callback(batch);
+
+        const auto start = growth{webview};
+
+        for (auto done = batch; total > done; done += batch)
+        {
+            callback(std::min(batch, total - done));
+        }
+
+        expect(start.kept(webview)) << "memory grew by more than" << threshold << "bytes";
+    }
+} // namespace
+
+suite<"soak"> soak_suite = []
+{
+    "soak/call"_test_async = [](saucer::smartview &webview)
+    {
+        static constexpr auto code = R"js(
+            (async () =>
+            {{
+                const calls = Array.from({{ length: {} }}, (_, i) => saucer.exposed.echo(i));
+                return (await Promise.all(calls)).length;
+            }})()
+        )js";
+
+        webview.set_url("https://codeberg.org/saucer/saucer");
+        webview.expose("echo", [](std::size_t value) { return value; });
+
+        soak(webview, [&](std::size_t count) { expect(eq(webview.evaluate<std::size_t>(code, count).get().value_or(0), count)); });
+
+        expect(eq(webview.evaluate<std::size_t>("saucer.internal.rpc.size").get().value_or(1), 0uz));
+    };
+
+    "soak/evaluate"_test_async = [](saucer::smartview &webview)
+    {
+        webview.set_url("https://codeberg.org/saucer/saucer");
+
+        soak(webview,
+             [&](std::size_t count)
+             {
+                 std::vector<decltype(webview.evaluate<std::size_t>("{}", count))> pending;
+                 pending.reserve(count);
+
+                 for (auto i = 0uz; count > i; i++)
+                 {
+                     pending.emplace_back(webview.evaluate<std::size_t>("{}", i));
+                 }
+
+                 for (auto &future : pending)
+                 {
+                     std::ignore = future.get();
+                 }
+             });
+    };
+
+    "soak/scheme"_test_async = [](saucer::smartview &webview)
+    {
+        static constexpr std::string_view page = R"html(<!DOCTYPE html><html><body>Soak</body></html>)html";
+        static constexpr std::string_view blob = "blob";
+
+        static constexpr auto code = R"js(
+            (async () =>
+            {{
+                for (let i = 0; i < {}; i++)
+                {{
+                    await (await fetch("test://host/blob", {{ cache: "no-store" }})).text();
+                }}
+
+                return 1;
+            }})()
+        )js";
+
+        webview.handle_scheme("test",
+                              [](const saucer::scheme::request &req)
+                              {
+                                  return saucer::scheme::response{
+                                      .data   = saucer::stash::view_str(req.url().path() == "/blob" ? blob : page),
+                                      .mime   = "text/html",
+                                      .status = 200,
+                                  };
+                              });
+
+        webview.set_url(saucer::url::make({.scheme = "test", .host = "host", .path = "/index.html"}));
+        saucer::tests::wait_for([&] { return webview.evaluate<int>("1").get().value_or(0) == 1; }, duration);
+
+        soak(webview, [&](std::size_t count) { expect(eq(webview.evaluate<int>(code, count).get().value_or(0), 1)); });
+
+        webview.remove_scheme("test");
+
+        auto stream = [](const saucer::scheme::request &, saucer::scheme::stream_writer writer)
+        {
+            writer.start({.mime = "text/plain"});
+            std::ignore = writer.write(saucer::stash::view_str(blob));
+            writer.finish();
+        };
+
+        webview.handle_stream_scheme("test", stream);
+
+        soak(webview, [&](std::size_t count) { expect(eq(webview.evaluate<int>(code, count).get().value_or(0), 1)); });
+
+        webview.remove_scheme("test");
+    };
+};
+
+#endif
@@ -1,6 +1,12 @@
 #include "test.hpp"
 #include "utils.hpp"
 
+#include <array>
+#include <atomic>
+#include <thread>
+#include <fstream>
+#include <filesystem>
+
 using namespace boost::ut;
 using namespace saucer::tests;
 
@@ -36,6 +42,13 @@ suite<"webview"> webview_suite = []
         expect(url.scheme() == "https");
         expect(url.host() == "codeberg.org");
         expect(url.path() == "/saucer/saucer");
+
+        auto view = saucer::url_view::parse(url);
+        expect(view.has_value());
+
+        expect(view->scheme() == "https");
+        expect(view->host() == "codeberg.org");
+        expect(view->path() == "/saucer/saucer");
     };
 
     "page_title"_test_async = [](saucer::webview &webview)
@@ -93,6 +106,90 @@ suite<"webview"> webview_suite = []
         expect(webview.background() == green);
     };
 
+    "capture"_test_async = [](saucer::webview &webview)
+    {
+        bool ready{false};
+        webview.on<dom_ready>([&] { ready = true; });
+
+        webview.set_html("<!DOCTYPE html><html><body style='background: green'></body></html>");
+        saucer::tests::wait_for([&] { return ready; }, duration);
+
+        auto full = webview.capture().get();
+        expect(full.has_value() and not full->empty());
+
+        auto thumbnail = webview.capture(saucer::size{.w = 64, .h = 64}).get();
+        expect(thumbnail.has_value() and not thumbnail->empty());
+    };
+
+    "memory_stats"_test_async = [](saucer::webview &webview)
+    {
+        webview.set_url("https://codeberg.org/saucer/saucer");
+
+        auto usage = webview.memory_stats().get();
+
+#if defined(SAUCER_QT) || defined(SAUCER_WEBVIEW2)
+        saucer::tests::wait_for([&] { return (usage = webview.memory_stats().get()).heap.has_value(); }, duration);
+
+        expect(usage.engine.value_or(0) > 0);
+        expect(usage.heap.value_or(0) > 0);
+#else
+        expect(not usage.heap.has_value());
+#endif
+    };
+
+    "cookies"_test_async = [](saucer::webview &webview)
+    {
+        auto set = webview.set_cookies({{.name = "saucer", .value = "cookie", .domain = "codeberg.org"}}).get();
+        expect(set.has_value());
+
+        bool ready{false};
+        webview.on<dom_ready>([&] { ready = true; });
+
+        webview.set_url("https://codeberg.org");
+        saucer::tests::wait_for([&] { return ready; }, duration);
+
+        auto cookies = webview.evaluate<std::string>("document.cookie").get();
+        expect(cookies.value_or("").contains("saucer=cookie"));
+
+        auto cleared = webview.clear_data({.storage = false, .cache = false}).get();
+        expect(cleared.has_value());
+    };
+
+    "headless"_test_async = [](saucer::webview &)
+    {
+        auto window = saucer::window::create(g_application).value();
+        auto worker = saucer::webview::create({.window = window, .headless = true});
+
+        expect(worker.has_value());
+
+        worker->set_html("<!DOCTYPE html><html><body></body></html>");
+        window->show();
+
+        saucer::tests::wait_for([&] { return worker->evaluate<int>("1 + 1").get().value_or(0) == 2; }, duration);
+
+        expect(eq(worker->evaluate<int>("1 + 1").get().value_or(0), 2));
+
+        worker->destroy().get();
+        window->destroy().get();
+    };
+
+    "large_html"_test_async = [](saucer::webview &webview)
+    {
+        bool ready{false};
+        webview.on<dom_ready>([&] { ready = true; });
+
+        static constexpr auto size = 4uz * 1024 * 1024;
+
+        auto html = std::string{"<!DOCTYPE html><html><body><pre id='text'>"};
+        html.append(size, 'a').append("</pre></body></html>");
+
+        webview.set_html(html);
+        saucer::tests::wait_for([&] { return ready; }, duration);
+
+        auto length = webview.evaluate<std::size_t>("document.getElementById('text').textContent.length").get();
+        expect(eq(length.value_or(0), size));
+    };
+
     "execute"_test_async = [](saucer::webview &webview)
     {
         auto url = webview.url();
@@ -108,6 +205,28 @@ suite<"webview"> webview_suite = []
         expect(webview.url().host() == "codeberg.org");
     };
 
+    "execute/queued"_test_async = [](saucer::webview &webview)
+    {
+        std::atomic_bool declared{false};
+
+        webview.on<message>(
+            [&](auto value)
+            {
+                declared = declared || value == "declared:queued";
+                return saucer::status::unhandled;
+            });
+
+        webview.set_url("https://codeberg.org/saucer/saucer");
+
+        // Queued before the DOM is ready, top-level declarations have to stay visible to the scripts after them
+        webview.execute("let queued = 'queued'");
+        webview.execute("class Queued {}");
+        webview.execute("saucer.internal.message(`declared:${typeof Queued === 'function' ? queued : 'missing'}`)");
+
+        saucer::tests::wait_for([&] { return declared.load(); }, duration);
+        expect(declared.load());
+    };
+
     "inject"_test_async = [](saucer::webview &webview)
     {
         std::set<std::string> messages;
@@ -160,6 +279,39 @@ suite<"webview"> webview_suite = []
         expect(not messages.contains("permanent"));
     };
 
+    "inject/world"_test_async = [](saucer::webview &webview)
+    {
+        std::set<std::string> messages;
+        webview.on<message>(
+            [&](auto value)
+            {
+                messages.emplace(std::move(value));
+                return saucer::status::unhandled;
+            });
+
+        webview.inject({
+            .code   = "window.isolated = true",
+            .world  = "saucer-test",
+            .run_at = saucer::script::time::creation,
+        });
+
+        webview.inject({
+            .code   = "saucer.internal.message(window.isolated ? 'shared' : 'isolated')",
+            .run_at = saucer::script::time::ready,
+        });
+
+        webview.set_url("https://codeberg.org/saucer/saucer");
+        saucer::tests::wait_for([&] { return !messages.empty(); }, duration);
+
+#ifndef SAUCER_WEBVIEW2
+        expect(messages.contains("isolated"));
+#else
+        expect(messages.contains("shared"));
+#endif
+
+        webview.uninject();
+    };
+
     "embed"_test_async = [](saucer::webview &webview)
     {
         static constexpr auto duration  = std::chrono::seconds(3);
@@ -227,6 +379,183 @@ suite<"webview"> webview_suite = []
         expect(not embedded);
     };
 
+    "embed/store"_test_async = [](saucer::webview &webview)
+    {
+        static constexpr auto duration = std::chrono::seconds(3);
+
+        bool embedded{false};
+
+        webview.on<message>(
+            [&](auto value)
+            {
+                if (value != "stored")
+                {
+                    return saucer::status::unhandled;
+                }
+
+                embedded = true;
+                return saucer::status::handled;
+            });
+
+        static constexpr std::string_view page = R"html(
+                <!DOCTYPE html>
+                <html>
+                    <head>
+                        <script>
+                            saucer.internal.message("stored");
+                        </script>
+                    </head>
+                </html>
+            )html";
+
+        auto store = saucer::asset_store{};
+        store.embed({{"/store.html", saucer::embedded_file{.content = saucer::stash::view_str(page), .mime = "text/html"}}});
+
+        expect(store.size() == 1);
+
+        webview.mount(store);
+        webview.serve("/store.html");
+        saucer::tests::wait_for([&] { return embedded; }, duration);
+
+        expect(embedded);
+
+        embedded = false;
+        webview.unmount(store);
+
+        webview.reload();
+        saucer::tests::wait_for([&] { return embedded; }, duration);
+
+        expect(not embedded);
+    };
+
+    "embed/range"_test_async = [](saucer::webview &webview)
+    {
+        static constexpr auto duration = std::chrono::seconds(3);
+
+        std::string response;
+        webview.on<message>(
+            [&](auto value)
+            {
+                response = std::move(value);
+                return saucer::status::unhandled;
+            });
+
+        static constexpr std::string_view page = R"html(
+                <!DOCTYPE html>
+                <html>
+                    <head>
+                        <script>
+                            (async () => {
+                                const response = await fetch("/data.txt", { headers: { Range: "bytes=2-5" } });
+                                saucer.internal.message(`${response.status}:${await response.text()}`);
+                            })();
+                        </script>
+                    </head>
+                </html>
+            )html";
+
+        webview.embed({
+            {"/range.html", saucer::embedded_file{.content = saucer::stash::view_str(page), .mime = "text/html"}},
+            {"/data.txt", saucer::embedded_file{.content = saucer::stash::view_str("0123456789"), .mime = "text/plain"}},
+        });
+
+        webview.serve("/range.html");
+        saucer::tests::wait_for([&] { return !response.empty(); }, duration);
+
+        expect(response == "206:2345") << response;
+    };
+
+    "embed/directory"_test_async = [](saucer::webview &webview)
+    {
+        static constexpr auto duration = std::chrono::seconds(3);
+
+        bool embedded{false};
+        webview.on<message>(
+            [&](auto value)
+            {
+                embedded = value == "directory";
+                return saucer::status::unhandled;
+            });
+
+        const auto root = std::filesystem::temp_directory_path() / "saucer-directory";
+        std::filesystem::create_directories(root);
+
+        std::ofstream{root / "index.html"} << R"html(
+                <!DOCTYPE html>
+                <html>
+                    <head>
+                        <script>
+                            saucer.internal.message("directory");
+                        </script>
+                    </head>
+                </html>
+            )html";
+
+        webview.embed(root);
+        webview.serve("/index.html");
+        saucer::tests::wait_for([&] { return embedded; }, duration);
+
+        expect(embedded);
+
+        webview.unembed();
+        std::filesystem::remove_all(root);
+    };
+
+    "serve_directory"_test_async = [](saucer::webview &webview)
+    {
+        static constexpr auto duration = std::chrono::seconds(3);
+
+        const auto root = std::filesystem::temp_directory_path() / "saucer-serve-directory";
+        std::filesystem::create_directories(root);
+
+        std::ofstream{root / "index.html"} << R"html(
+                <!DOCTYPE html>
+                <html>
+                    <head>
+                        <title>Served</title>
+                    </head>
+                </html>
+            )html";
+
+        webview.serve_directory(root);
+        saucer::tests::wait_for([&] { return webview.page_title() == "Served"; }, duration);
+
+        expect(eq(webview.page_title(), std::string{"Served"}));
+
+        std::filesystem::remove_all(root);
+    };
+
+    "embed/bundle"_test_async = [](saucer::webview &webview)
+    {
+        static constexpr auto duration = std::chrono::seconds(3);
+
+        bool embedded{false};
+        webview.on<message>(
+            [&](auto value)
+            {
+                embedded = value == "bundle";
+                return saucer::status::unhandled;
+            });
+
+        static constexpr std::string_view blob = R"html(<script>saucer.internal.message("bundle");</script>)html";
+
+        static constexpr auto files = std::array{
+            saucer::bundled_file{.path = "/bundle.html", .offset = 0, .size = blob.size(), .mime = "text/html"},
+        };
+
+        webview.embed(saucer::embedded_bundle{
+            .blob  = {reinterpret_cast<const std::uint8_t *>(blob.data()), blob.size()},
+            .files = files,
+        });
+
+        webview.serve("/bundle.html");
+        saucer::tests::wait_for([&] { return embedded; }, duration);
+
+        expect(embedded);
+
+        webview.unembed();
+    };
+
     "scheme"_test_async = [](saucer::webview &webview)
     {
         static constexpr auto duration  = std::chrono::seconds(3);
@@ -288,4 +617,391 @@ suite<"webview"> webview_suite = []
 
         expect(not scheme);
     };
+
+    "scheme/pool"_test_async = [](saucer::webview &webview)
+    {
+        static constexpr auto duration = std::chrono::seconds(3);
+
+        bool scheme{false};
+        webview.on<message>(
+            [&](auto value)
+            {
+                scheme = value == "pool";
+                return saucer::status::unhandled;
+            });
+
+        static constexpr std::string_view page = R"html(
+                <!DOCTYPE html>
+                <html>
+                    <head>
+                        <script>
+                            saucer.internal.message("pool");
+                        </script>
+                    </head>
+                </html>
+            )html";
+
+        const auto main = std::this_thread::get_id();
+        std::atomic<bool> offloaded{false};
+        std::atomic<bool> readable{false};
+
+        webview.handle_scheme(
+            "test",
+            [&](const saucer::scheme::request &req)
+            {
+                offloaded = std::this_thread::get_id() != main;
+                readable  = req.url().path() == "/pool.html" && req.method() == "GET";
+                return saucer::scheme::response{.data = saucer::stash::view_str(page), .mime = "text/html"};
+            },
+            saucer::launch::pool);
+
+        webview.set_url(saucer::url::make({.scheme = "test", .host = "host", .path = "/pool.html"}));
+        saucer::tests::wait_for([&] { return scheme; }, duration);
+
+        expect(scheme);
+        expect(offloaded);
+        expect(readable);
+
+        webview.remove_scheme("test");
+    };
+
+    "scheme/router"_test_async = [](saucer::webview &webview)
+    {
+        static constexpr auto duration = std::chrono::seconds(3);
+
+        std::string routed;
+        webview.on<message>(
+            [&](auto value)
+            {
+                routed = value;
+                return saucer::status::unhandled;
+            });
+
+        static constexpr std::string_view page = R"html(
+                <!DOCTYPE html>
+                <html>
+                    <head>
+                        <script>
+                            saucer.internal.message("router");
+                        </script>
+                    </head>
+                </html>
+            )html";
+
+        auto respond = [](const saucer::scheme::request &)
+        {
+            return saucer::scheme::response{.data = saucer::stash::view_str(page), .mime = "text/html"};
+        };
+
+        auto reject = [](const saucer::scheme::request &) -> std::expected<saucer::scheme::response, saucer::scheme::error>
+        {
+            return std::unexpected{saucer::scheme::error::denied};
+        };
+
+        auto router = saucer::scheme::router{};
+
+        router.add("GET", "/pages/:name", respond);
+        router.add("GET", "/pages/secret", reject);
+        router.fallback(reject);
+
+        webview.handle_scheme("test", router);
+
+        webview.set_url(saucer::url::make({.scheme = "test", .host = "host", .path = "/pages/index"}));
+        saucer::tests::wait_for([&] { return routed == "router"; }, duration);
+
+        expect(routed == "router");
+
+        webview.remove_scheme("test");
+    };
+
+    "scheme/events"_test_async = [](saucer::webview &webview)
+    {
+        static constexpr auto duration = std::chrono::seconds(3);
+
+        static constexpr std::string_view page = R"html(<!DOCTYPE html><html><body>Events</body></html>)html";
+
+        static constexpr auto code = R"js(
+            (async () =>
+            {{
+                const response = await fetch("test://host/events");
+                const reader   = response.body.getReader();
+                const decoder  = new TextDecoder();
+
+                let text = "";
+
+                while (!text.includes("data: world\n\n"))
+                {{
+                    const {{ value, done }} = await reader.read();
+
+                    if (done)
+                    {{
+                        break;
+                    }}
+
+                    text += decoder.decode(value, {{ stream: true }});
+                }}
+
+                return text;
+            }})()
+        )js";
+
+        webview.handle_scheme("test",
+                              [](const saucer::scheme::request &)
+                              { return saucer::scheme::response{.data = saucer::stash::view_str(page), .mime = "text/html"}; });
+
+        webview.set_url(saucer::url::make({.scheme = "test", .host = "host", .path = "/index.html"}));
+        saucer::tests::wait_for([&] { return webview.evaluate<int>("1").get().value_or(0) == 1; }, duration);
+
+        webview.remove_scheme("test");
+
+        auto events = saucer::scheme::event_stream{{.retry = std::nullopt}};
+        webview.handle_stream_scheme("test", events);
+
+        auto received = webview.evaluate<std::string>(code);
+        saucer::tests::wait_for([&] { return events.clients() == 1; }, duration);
+
+        events.publish({.data = "hello\nworld", .type = "greeting"});
+
+        expect(eq(received.get().value_or(""), std::string{"event: greeting\ndata: hello\ndata: world\n\n"}));
+
+        events.close();
+        webview.remove_stream_scheme("test");
+    };
+
+    "scheme/multi_writer"_test_async = [](saucer::webview &webview)
+    {
+        static constexpr auto duration = std::chrono::seconds(3);
+        static constexpr auto chunks   = 64uz;
+
+        static constexpr std::string_view page = R"html(<!DOCTYPE html><html><body>Multi</body></html>)html";
+
+        webview.handle_scheme("test",
+                              [](const saucer::scheme::request &)
+                              { return saucer::scheme::response{.data = saucer::stash::view_str(page), .mime = "text/html"}; });
+
+        webview.set_url(saucer::url::make({.scheme = "test", .host = "host", .path = "/index.html"}));
+        saucer::tests::wait_for([&] { return webview.evaluate<int>("1").get().value_or(0) == 1; }, duration);
+
+        webview.remove_scheme("test");
+
+        auto stream = [](const saucer::scheme::request &, saucer::scheme::stream_writer writer)
+        {
+            auto multi = saucer::scheme::multi_writer{std::move(writer), {.mime = "text/plain"}};
+            auto first = multi.reserve(chunks);
+
+            auto producer = [multi, first](std::size_t offset)
+            {
+                // Every producer walks its share backwards, so chunks arrive out of order
+                for (auto i = chunks - 1 - offset; i < chunks; i -= 4)
+                {
+                    std::ignore = multi.write(first + i, saucer::stash::from_str(std::to_string(i % 10)));
+                }
+            };
+
+            auto run = [multi, producer]
+            {
+                {
+                    auto workers = std::array{std::jthread{producer, 0uz}, std::jthread{producer, 1uz}, //
+                                              std::jthread{producer, 2uz}, std::jthread{producer, 3uz}};
+                }
+
+                multi.finish();
+            };
+
+            std::thread{std::move(run)}.detach();
+        };
+
+        webview.handle_stream_scheme("test", stream);
+
+        auto expected = std::string{};
+
+        for (auto i = 0uz; chunks > i; i++)
+        {
+            expected += std::to_string(i % 10);
+        }
+
+        auto text = webview.evaluate<std::string>(R"js(fetch("test://host/multi").then(response => response.text()))js").get();
+        expect(eq(text.value_or(""), expected));
+
+        webview.remove_stream_scheme("test");
+    };
+
+    "scheme/stream_views"_test_async = [](saucer::webview &webview)
+    {
+        static constexpr auto duration = std::chrono::seconds(3);
+        static constexpr auto chunks   = 32uz;
+
+        static constexpr std::string_view page = R"html(<!DOCTYPE html><html><body>Views</body></html>)html";
+
+        webview.handle_scheme("test",
+                              [](const saucer::scheme::request &)
+                              { return saucer::scheme::response{.data = saucer::stash::view_str(page), .mime = "text/html"}; });
+
+        webview.set_url(saucer::url::make({.scheme = "test", .host = "host", .path = "/index.html"}));
+        saucer::tests::wait_for([&] { return webview.evaluate<int>("1").get().value_or(0) == 1; }, duration);
+
+        webview.remove_scheme("test");
+
+        auto stream = [](const saucer::scheme::request &, saucer::scheme::stream_writer writer)
+        {
+            auto run = [writer = std::move(writer)]() mutable
+            {
+                writer.start({.mime = "text/plain"});
+
+                for (auto i = 0uz; chunks > i; i++)
+                {
+                    // The buffer is overwritten right after the write, the writer must not keep referring to it
+                    auto buffer = std::to_string(i % 10);
+                    std::ignore = writer.write(saucer::stash::view_str(buffer));
+                    buffer.assign(buffer.size(), 'x');
+                }
+
+                writer.finish();
+            };
+
+            std::thread{std::move(run)}.detach();
+        };
+
+        webview.handle_stream_scheme("test", stream);
+
+        auto expected = std::string{};
+
+        for (auto i = 0uz; chunks > i; i++)
+        {
+            expected += std::to_string(i % 10);
+        }
+
+        auto text = webview.evaluate<std::string>(R"js(fetch("test://host/views").then(response => response.text()))js").get();
+        expect(eq(text.value_or(""), expected));
+
+        webview.remove_stream_scheme("test");
+    };
+
+    "channel"_test_async = [](saucer::webview &webview)
+    {
+        static constexpr auto code = R"js(
+            new Promise(resolve =>
+            {{
+                const channel = saucer.channel("echo");
+                const values  = [];
+
+                channel.onmessage = (buffer) =>
+                {{
+                    values.push(...new Uint8Array(buffer));
+
+                    if (values.length === 3)
+                    {{
+                        resolve(values.join(","));
+                    }}
+                }};
+
+                channel.send(new Uint8Array([1, 2]));
+                channel.send(new Uint8Array([3]));
+            }})
+        )js";
+
+        webview.set_url("https://codeberg.org/saucer/saucer");
+
+        expect(not webview.open_channel("not valid").has_value());
+
+        auto channel = webview.open_channel("echo");
+        expect(channel.has_value());
+
+        channel->on_receive([channel = *channel](saucer::stash frame) { expect(channel.send(std::move(frame))); });
+
+        expect(eq(webview.evaluate<std::string>(code).get().value_or(""), std::string{"1,2,3"}));
+
+        channel->close();
+        expect(not channel->send(saucer::stash::from_str("closed")));
+    };
+
+    "allocations/execute"_test_async = [](saucer::webview &webview)
+    {
+        static constexpr auto calls = 200uz;
+
+        std::atomic_size_t received{0};
+        webview.on<message>(
+            [&](auto value)
+            {
+                if (value != "executed")
+                {
+                    return saucer::status::unhandled;
+                }
+
+                received++;
+                return saucer::status::handled;
+            });
+
+        std::atomic_bool loaded{false};
+        webview.on<load>([&](auto value) { loaded = loaded || value == saucer::state::finished; });
+
+        webview.set_url("https://codeberg.org/saucer/saucer");
+        saucer::tests::wait_for([&] { return loaded.load(); }, duration);
+
+        const auto budget = allocations::budget{.limit = 32, .calls = calls};
+
+        for (auto i = 0uz; calls > i; i++)
+        {
+            webview.execute("saucer.internal.message('executed')");
+        }
+
+        saucer::tests::wait_for([&] { return received == calls; }, duration);
+
+        expect(received == calls);
+        expect(budget.kept()) << budget.used();
+    };
+
+    "allocations/scheme"_test_async = [](saucer::webview &webview)
+    {
+        static constexpr auto requests = 100;
+
+        static constexpr std::string_view page = R"html(
+                <!DOCTYPE html>
+                <html>
+                    <head>
+                        <script>
+                            (async () =>
+                            {
+                                for (let i = 0; i < 100; i++)
+                                {
+                                    await fetch("test://host/blob", { cache: "no-store" });
+                                }
+
+                                saucer.internal.message("fetched");
+                            })();
+                        </script>
+                    </head>
+                </html>
+            )html";
+
+        static constexpr std::string_view blob = "blob";
+
+        bool fetched{false};
+        webview.on<message>(
+            [&](auto value)
+            {
+                fetched = value == "fetched";
+                return saucer::status::unhandled;
+            });
+
+        webview.handle_scheme("test",
+                              [](const saucer::scheme::request &req)
+                              {
+                                  return saucer::scheme::response{
+                                      .data   = saucer::stash::view_str(req.url().path() == "/blob" ? blob : page),
+                                      .mime   = "text/html",
+                                      .status = 200,
+                                  };
+                              });
+
+        const auto budget = allocations::budget{.limit = 128, .calls = requests};
+
+        webview.set_url(saucer::url::make({.scheme = "test", .host = "host", .path = "/index.html"}));
+        saucer::tests::wait_for([&] { return fetched; }, duration);
+
+        expect(fetched);
+        expect(budget.kept()) << budget.used();
+
+        webview.remove_scheme("test");
+    };
 };
@@ -163,4 +163,31 @@ suite<"window"> window_suite = []
         expect(window.position() == saucer::position{.x = 200, .y = 300});
     };
 #endif
+
+    "destroy"_test_async = [](saucer::window &)
+    {
+        auto window = saucer::window::create(g_application).value();
+        window->show();
+
+        auto future = window->destroy();
+        future.get();
+
+        expect(not window->visible());
+        window->destroy().get();
+    };
+
+    "create_async"_test_async = [](saucer::window &)
+    {
+        auto first  = saucer::window::create_async(g_application);
+        auto second = saucer::window::create_async(g_application, {.title = "second"});
+
+        auto window = first.get().value();
+        auto other  = second.get().value();
+
+        expect(window != other);
+        expect(other->title() == "second");
+
+        window->destroy().get();
+        other->destroy().get();
+    };
 };